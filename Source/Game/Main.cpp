@@ -17,11 +17,35 @@
 #include "Game/Game.h"
 #include "Light/RotatingPointLight.h"
 #include "Model/Model.h"
+#include "Profiler/Profiler.h"
 #include "Renderer/Skybox.h"
 #include "Scene/Scene.h"
+#include "Scene/SceneGenerator.h"
 #include "Scene/Voxel.h"
 #include "Shader/SkyMapVertexShader.h"
 
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getCommandLineOption
+  Summary:  Returns the value following an option of the command line
+  Args:     const std::wstring& commandLine
+              Command line
+            PCWSTR pszOption
+              Option including the trailing space, such as L"-trace "
+  Returns:  std::wstring
+              Value of the option, empty if the option is missing
+-----------------------------------------------------------------F-F*/
+static std::wstring getCommandLineOption(_In_ const std::wstring& commandLine, _In_ PCWSTR pszOption)
+{
+    size_t uOption = commandLine.find(pszOption);
+    if (uOption == std::wstring::npos)
+    {
+        return std::wstring();
+    }
+
+    size_t uValue = uOption + wcslen(pszOption);
+    return commandLine.substr(uValue, commandLine.find(L' ', uValue) - uValue);
+}
+
 /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
   Function: wWinMain
   Summary:  Entry point to the program. Initializes everything and
@@ -43,7 +67,6 @@
 INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ INT nCmdShow)
 {
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
 
     std::unique_ptr<library::Game> game = std::make_unique<library::Game>(L"Game Graphics Programming Assignment 3: Cube Mapping");
 
@@ -265,6 +288,40 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+
+    // "-generate <cubes>,<models>,<voxel map size>,<lights> [-seed <seed>] [-model <file>]" replaces the content of the
+    // scene with synthetic content placed at random, the same seed always generates the same scene
+    std::wstring commandLine(lpCmdLine);
+    std::wstring generateCounts = getCommandLineOption(commandLine, L"-generate ");
+    std::wstring generateSeed = getCommandLineOption(commandLine, L"-seed ");
+    std::wstring generateModel = getCommandLineOption(commandLine, L"-model ");
+    BOOL bGenerateScene = !generateCounts.empty();
+    if (bGenerateScene)
+    {
+        SceneGeneratorDesc generatorDesc =
+        {
+            .uNumCubes = 0u,
+            .uNumModels = 0u,
+            .uVoxelMapSize = 0u,
+            .uNumPointLights = 0u,
+            .uSeed = generateSeed.empty() ? 1u : static_cast<UINT>(_wtoi(generateSeed.c_str())),
+            .extent = 50.0f,
+            .modelFilePath = generateModel.empty() ? std::filesystem::path(L"Content/Nanosuit/nanosuit.obj") : std::filesystem::path(generateModel),
+            .pszCubeShaderName = L"PhongShader",
+            .pszModelShaderName = L"PhongShader"
+        };
+        if (swscanf_s(generateCounts.c_str(), L"%u,%u,%u,%u", &generatorDesc.uNumCubes, &generatorDesc.uNumModels, &generatorDesc.uVoxelMapSize, &generatorDesc.uNumPointLights) != 4)
+        {
+            return 0;
+        }
+
+        SceneGenerator generator(generatorDesc);
+        if (FAILED(generator.Generate(mainScene)))
+        {
+            return 0;
+        }
+    }
+
     if (FAILED(mainScene->SetVertexShaderOfVoxel(L"VoxelShader")))
     {
         return 0;
@@ -285,57 +342,101 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
 
-    XMFLOAT4 color;
-    XMStoreFloat4(&color, Colors::Orange);
+    // hand-placed content, replaced by the generated content
+    if (!bGenerateScene)
+    {
+        XMFLOAT4 color;
+        XMStoreFloat4(&color, Colors::Orange);
 
 
-    std::shared_ptr<library::PointLight> directionalLight = std::make_shared<library::PointLight>(
-        XMFLOAT4(0.f, 30.f, 0.f, 1.0f),
-        color,
-        30.0f
-        );
+        std::shared_ptr<library::PointLight> directionalLight = std::make_shared<library::PointLight>(
+            XMFLOAT4(0.f, 30.f, 0.f, 1.0f),
+            color,
+            30.0f
+            );
     
-    if (FAILED(mainScene->AddPointLight(0, directionalLight)))
-    {
-        return 0;
+        if (FAILED(mainScene->AddPointLight(directionalLight)))
+        {
+            return 0;
+        }
+
+        std::shared_ptr<Cube> pointLight = std::make_shared<Cube>(color);
+        pointLight->Translate(XMVectorSet(0.0f, 15.0f,-10.0f, 0.0f));
+        pointLight->Scale(5.0f, 5.0f, 5.0f);
+        if (FAILED(mainScene->AddRenderable(L"PointLight", pointLight)))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetVertexShaderOfRenderable(L"PointLight", L"EnvironmentMapShader")))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetPixelShaderOfRenderable(L"PointLight", L"EnvironmentMapShader")))
+        {
+            return 0;
+        }
+
+
+        XMStoreFloat4(&color, Colors::White);
+        std::shared_ptr<RotatingPointLight> rotatingDirectionalLight = std::make_shared<RotatingPointLight>(
+            XMFLOAT4(0.0f, 30.0f, -50.0f, 1.0f),
+            color,
+            30.0f
+            );
+        if (FAILED(mainScene->AddPointLight(rotatingDirectionalLight)))
+        {
+            return 0;
+        }
     }
 
-    std::shared_ptr<Cube> pointLight = std::make_shared<Cube>(color);
-    pointLight->Translate(XMVectorSet(0.0f, 15.0f,-10.0f, 0.0f));
-    pointLight->Scale(5.0f, 5.0f, 5.0f);
-    if (FAILED(mainScene->AddRenderable(L"PointLight", pointLight)))
+    if (FAILED(game->GetRenderer()->AddScene(L"VoxelMap", mainScene)))
     {
         return 0;
     }
-    if (FAILED(mainScene->SetVertexShaderOfRenderable(L"PointLight", L"EnvironmentMapShader")))
+
+    if (FAILED(game->GetRenderer()->SetMainScene(L"VoxelMap")))
     {
         return 0;
     }
-    if (FAILED(mainScene->SetPixelShaderOfRenderable(L"PointLight", L"EnvironmentMapShader")))
+    game->GetRenderer()->SetDepthPrepass(TRUE);
+
+    // "-dynamic-resolution <target ms>" scales the resolution of the main pass to hold the target frame time
+    std::wstring dynamicResolutionTarget = getCommandLineOption(commandLine, L"-dynamic-resolution ");
+    if (!dynamicResolutionTarget.empty())
     {
-        return 0;
+        std::shared_ptr<library::VertexShader> upscaleVertexShader = std::make_shared<library::VertexShader>(L"Shaders/UpscaleShaders.fxh", "VSUpscale", "vs_5_0");
+        std::shared_ptr<library::PixelShader> upscalePixelShader = std::make_shared<library::PixelShader>(L"Shaders/UpscaleShaders.fxh", "PSUpscale", "ps_5_0");
+        game->GetRenderer()->SetUpscaleShaders(upscaleVertexShader, upscalePixelShader);
+        game->GetRenderer()->SetDynamicResolution(TRUE, static_cast<FLOAT>(_wtof(dynamicResolutionTarget.c_str())) / 1000.0f);
     }
 
-
-    XMStoreFloat4(&color, Colors::White);
-    std::shared_ptr<RotatingPointLight> rotatingDirectionalLight = std::make_shared<RotatingPointLight>(
-        XMFLOAT4(0.0f, 30.0f, -50.0f, 1.0f),
-        color,
-        30.0f
-        );
-    if (FAILED(mainScene->AddPointLight(1, rotatingDirectionalLight)))
+    // "-capture <file>" records the commands of the first frame for the capture analyzer
+    std::wstring captureFileName = getCommandLineOption(commandLine, L"-capture ");
+    if (!captureFileName.empty())
     {
-        return 0;
+        game->GetRenderer()->CaptureFrame(captureFileName.c_str());
     }
 
-    if (FAILED(game->GetRenderer()->AddScene(L"VoxelMap", mainScene)))
+    // "-trace <file>" writes the profiled scopes as a Chrome trace on exit, builds without LIBRARY_PROFILING write no scopes
+    std::wstring traceFileName = getCommandLineOption(commandLine, L"-trace ");
+
+    // "-record-path <file>" writes the camera input of the session into a camera path file on exit
+    std::wstring recordPathFileName = getCommandLineOption(commandLine, L"-record-path ");
+    if (!recordPathFileName.empty())
     {
-        return 0;
+        game->RecordCameraPath(recordPathFileName.c_str());
     }
 
-    if (FAILED(game->GetRenderer()->SetMainScene(L"VoxelMap")))
+    // "-benchmark <camera path> [-frames <count>] [-csv <file>]" renders the frames along the path in a hidden window
+    // with a fixed time step and writes the frame times instead of running the game
+    std::wstring benchmarkPathFileName = getCommandLineOption(commandLine, L"-benchmark ");
+    std::wstring benchmarkFrames = getCommandLineOption(commandLine, L"-frames ");
+    std::wstring benchmarkResultFileName = getCommandLineOption(commandLine, L"-csv ");
+    constexpr const FLOAT BENCHMARK_DELTA_TIME = 1.0f / 60.0f;
+    UINT uBenchmarkFrames = benchmarkFrames.empty() ? 1000u : static_cast<UINT>(_wtoi(benchmarkFrames.c_str()));
+    if (benchmarkResultFileName.empty())
     {
-        return 0;
+        benchmarkResultFileName = L"Benchmark.csv";
     }
 
     /*
@@ -355,56 +456,85 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     */
 
     
-    // nanosuit model
-    std::shared_ptr<library::Model> nanosuit = std::make_shared<library::Model>(L"Content/Nanosuit/nanosuit.obj");
-
-    if (FAILED(mainScene->AddModel(L"Nanosuit", nanosuit)))
-    {
-        return 0;
-    }
-    if (FAILED(mainScene->SetVertexShaderOfModel(L"Nanosuit", L"PhongShader")))
+    if (!bGenerateScene)
     {
-        return 0;
-    }
-    if (FAILED(mainScene->SetPixelShaderOfModel(L"Nanosuit", L"PhongShader")))
-    {
-        return 0;
-    }
+        // nanosuit model
+        std::shared_ptr<library::Model> nanosuit = std::make_shared<library::Model>(L"Content/Nanosuit/nanosuit.obj");
+        // The shadow pass reads the positions of the nanosuit as 16-bit integers
+        nanosuit->SetQuantizedPositions(TRUE);
+
+        if (FAILED(mainScene->AddModel(L"Nanosuit", nanosuit)))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetVertexShaderOfModel(L"Nanosuit", L"PhongShader")))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetPixelShaderOfModel(L"Nanosuit", L"PhongShader")))
+        {
+            return 0;
+        }
 
-    // floor
-    XMFLOAT4 white;
-    XMStoreFloat4(&white, Colors::White);
+        // floor
+        XMFLOAT4 white;
+        XMStoreFloat4(&white, Colors::White);
 
-    const auto floor = std::make_shared<Cube>(white);
-    floor->Scale(50.f, 0.2f, 50.f);
-    if (FAILED(mainScene->AddRenderable(L"Floor", floor)))
-    {
-        return 0;
+        const auto floor = std::make_shared<Cube>(white);
+        floor->Scale(50.f, 0.2f, 50.f);
+        floor->SetStatic(TRUE);
+        if (FAILED(mainScene->AddRenderable(L"Floor", floor)))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetVertexShaderOfRenderable(L"Floor", L"PhongShader")))
+        {
+            return 0;
+        }
+        if (FAILED(mainScene->SetPixelShaderOfRenderable(L"Floor", L"PhongShader")))
+        {
+            return 0;
+        }
+
+        const auto floorMaterial = std::make_shared<library::Material>(L"FloorMat");
+        floorMaterial->pDiffuse = std::make_shared<library::Texture>("Content/plane.jpg");
+        if (FAILED(mainScene->AddMaterial(floorMaterial)))
+        {
+            return 0;
+        }
+        floor->AddMaterial(floorMaterial);
     }
-    if (FAILED(mainScene->SetVertexShaderOfRenderable(L"Floor", L"PhongShader")))
+    
+
+    // initialize
+    if (FAILED(game->Initialize(hInstance, benchmarkPathFileName.empty() ? nCmdShow : SW_HIDE)))
     {
         return 0;
     }
-    if (FAILED(mainScene->SetPixelShaderOfRenderable(L"Floor", L"PhongShader")))
+
+    // run
+    INT iExitCode = 0;
+    if (!benchmarkPathFileName.empty())
     {
-        return 0;
+        library::CameraPath cameraPath;
+        if (FAILED(cameraPath.Load(benchmarkPathFileName.c_str())))
+        {
+            return 1;
+        }
+        if (FAILED(game->RunBenchmark(cameraPath, uBenchmarkFrames, BENCHMARK_DELTA_TIME, benchmarkResultFileName.c_str())))
+        {
+            iExitCode = 1;
+        }
     }
-
-    const auto floorMaterial = std::make_shared<library::Material>(L"FloorMat");
-    floorMaterial->pDiffuse = std::make_shared<library::Texture>("Content/plane.jpg");
-    if (FAILED(mainScene->AddMaterial(floorMaterial)))
+    else
     {
-        return 0;
+        iExitCode = game->Run();
     }
-    floor->AddMaterial(floorMaterial);
-    
 
-    // initialize
-    if (FAILED(game->Initialize(hInstance, nCmdShow)))
+    if (!traceFileName.empty() && FAILED(library::Profiler::WriteChromeTrace(traceFileName.c_str())))
     {
-        return 0;
+        OutputDebugString(L"Failed to write the profiler trace\n");
     }
 
-    // run
-    return game->Run();
+    return iExitCode;
 }
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "Scene/SceneGenerator.h"
+
+#include <string>
+
+#include "Cube/Cube.h"
+#include "Light/PointLight.h"
+#include "Model/Model.h"
+#include "Scene/Voxel.h"
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::SceneGenerator
+
+  Summary:  Constructor
+
+  Args:     const SceneGeneratorDesc& desc
+              Content to generate
+
+  Modifies: [m_desc, m_uRandomState].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SceneGenerator::SceneGenerator(_In_ const SceneGeneratorDesc& desc) :
+    m_desc(desc),
+    m_uRandomState(desc.uSeed != 0u ? desc.uSeed : 1u)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::Generate
+
+  Summary:  Adds the cubes, models, voxels and point lights of the
+            description to the scene. Every point light slot of the
+            scene is filled, because the renderer initializes all of
+            them; slots beyond the requested count get black lights
+
+  Args:     const std::shared_ptr<library::Scene>& scene
+              Scene to fill
+
+  Modifies: [m_uRandomState].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT SceneGenerator::Generate(_In_ const std::shared_ptr<library::Scene>& scene)
+{
+    HRESULT hr = generateCubes(scene);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    hr = generateModels(scene);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    hr = generateVoxels(scene);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    return generatePointLights(scene);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::generateCubes
+
+  Summary:  Adds cubes of random color, size and orientation
+
+  Args:     const std::shared_ptr<library::Scene>& scene
+              Scene to fill
+
+  Modifies: [m_uRandomState].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT SceneGenerator::generateCubes(_In_ const std::shared_ptr<library::Scene>& scene)
+{
+    for (UINT i = 0u; i < m_desc.uNumCubes; ++i)
+    {
+        XMFLOAT4 color(getRandom(0.0f, 1.0f), getRandom(0.0f, 1.0f), getRandom(0.0f, 1.0f), 1.0f);
+        std::shared_ptr<Cube> cube = std::make_shared<Cube>(color);
+
+        FLOAT scale = getRandom(0.5f, 2.0f);
+        cube->Scale(scale, scale, scale);
+        cube->RotateY(getRandom(0.0f, XM_2PI));
+        cube->Translate(XMVectorSet(getRandom(-m_desc.extent, m_desc.extent), getRandom(scale, m_desc.extent * 0.25f), getRandom(-m_desc.extent, m_desc.extent), 0.0f));
+
+        std::wstring szName = L"GeneratedCube" + std::to_wstring(i);
+        HRESULT hr = scene->AddRenderable(szName.c_str(), cube);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = scene->SetVertexShaderOfRenderable(szName.c_str(), m_desc.pszCubeShaderName);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = scene->SetPixelShaderOfRenderable(szName.c_str(), m_desc.pszCubeShaderName);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::generateModels
+
+  Summary:  Adds copies of the model on the ground at random places
+            and headings. Every copy loads the model file again, so
+            memory grows with the number of copies as it would with
+            distinct models
+
+  Args:     const std::shared_ptr<library::Scene>& scene
+              Scene to fill
+
+  Modifies: [m_uRandomState].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT SceneGenerator::generateModels(_In_ const std::shared_ptr<library::Scene>& scene)
+{
+    for (UINT i = 0u; i < m_desc.uNumModels; ++i)
+    {
+        std::shared_ptr<library::Model> model = std::make_shared<library::Model>(m_desc.modelFilePath);
+        model->RotateY(getRandom(0.0f, XM_2PI));
+        model->Translate(XMVectorSet(getRandom(-m_desc.extent, m_desc.extent), 0.0f, getRandom(-m_desc.extent, m_desc.extent), 0.0f));
+
+        std::wstring szName = L"GeneratedModel" + std::to_wstring(i);
+        HRESULT hr = scene->AddModel(szName.c_str(), model);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = scene->SetVertexShaderOfModel(szName.c_str(), m_desc.pszModelShaderName);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = scene->SetPixelShaderOfModel(szName.c_str(), m_desc.pszModelShaderName);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::generateVoxels
+
+  Summary:  Adds a square voxel height map of the given size, read
+            from Perlin noise at a random offset. The map is size
+            columns wide and deep and at most a quarter of that high,
+            split into four voxels by the height of the blocks, so
+            the number of blocks grows with the cube of the size
+
+  Args:     const std::shared_ptr<library::Scene>& scene
+              Scene to fill
+
+  Modifies: [m_uRandomState].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT SceneGenerator::generateVoxels(_In_ const std::shared_ptr<library::Scene>& scene)
+{
+    if (m_desc.uVoxelMapSize == 0u)
+    {
+        return S_OK;
+    }
+
+    const XMFLOAT4 aColors[] =
+    {
+        XMFLOAT4(0.0f,      0.0f,   0.666f, 1.0f),  // OCEAN
+        XMFLOAT4(1.0f,      0.666f, 0.0f,   1.0f),  // SAND
+        XMFLOAT4(0.0f,      0.666f, 0.0f,   1.0f),  // GRASSLAND
+        XMFLOAT4(1.0f,      1.0f,   1.0f,   1.0f),  // SNOW
+    };
+    constexpr const UINT NUM_BANDS = ARRAYSIZE(aColors);
+
+    UINT uMaxHeight = m_desc.uVoxelMapSize / 4u > 0u ? m_desc.uVoxelMapSize / 4u : 1u;
+    FLOAT offsetX = getRandom(0.0f, 1024.0f);
+    FLOAT offsetZ = getRandom(0.0f, 1024.0f);
+    FLOAT halfSize = static_cast<FLOAT>(m_desc.uVoxelMapSize) / 2.0f;
+
+    std::vector<library::InstanceData> aInstanceData[NUM_BANDS];
+    for (UINT z = 0u; z < m_desc.uVoxelMapSize; ++z)
+    {
+        for (UINT x = 0u; x < m_desc.uVoxelMapSize; ++x)
+        {
+            FLOAT height = library::Scene::GetPerlin2d(static_cast<FLOAT>(x) + offsetX, static_cast<FLOAT>(z) + offsetZ, 0.1f, 4u);
+            UINT uHeight = 1u + static_cast<UINT>(height * static_cast<FLOAT>(uMaxHeight - 1u));
+            for (UINT y = 0u; y < uHeight; ++y)
+            {
+                UINT uBand = y * NUM_BANDS / uMaxHeight;
+                aInstanceData[uBand < NUM_BANDS ? uBand : NUM_BANDS - 1u].push_back(
+                    library::InstanceData
+                    {
+                        .Transformation = XMMatrixTranslation(
+                            2.0f * (static_cast<FLOAT>(x) - halfSize),
+                            2.0f * (static_cast<FLOAT>(y) - static_cast<FLOAT>(uMaxHeight)),
+                            2.0f * (static_cast<FLOAT>(z) - halfSize)
+                        )
+                    }
+                );
+            }
+        }
+    }
+
+    for (UINT i = 0u; i < NUM_BANDS; ++i)
+    {
+        if (aInstanceData[i].empty())
+        {
+            continue;
+        }
+
+        HRESULT hr = scene->AddVoxel(std::make_shared<library::Voxel>(std::move(aInstanceData[i]), aColors[i]));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::generatePointLights
+
+  Summary:  Adds the requested point lights with random colors. The
+            first light casts the shadow, so it is placed high above
+            the scene and reaches all of it; the others are placed
+            near the ground with a short attenuation distance, as the
+            local lights of a level. A black first light that adds
+            nothing to the shading is added when no light is requested
+
+  Args:     const std::shared_ptr<library::Scene>& scene
+              Scene to fill
+
+  Modifies: [m_uRandomState].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT SceneGenerator::generatePointLights(_In_ const std::shared_ptr<library::Scene>& scene)
+{
+    UINT uNumPointLights = m_desc.uNumPointLights > 0u ? m_desc.uNumPointLights : 1u;
+    for (UINT i = 0u; i < uNumPointLights; ++i)
+    {
+        FLOAT minHeight = i == 0u ? m_desc.extent * 0.25f : 0.0f;
+        FLOAT maxHeight = i == 0u ? m_desc.extent * 0.5f : m_desc.extent * 0.1f;
+        XMFLOAT4 position(getRandom(-m_desc.extent, m_desc.extent), getRandom(minHeight, maxHeight), getRandom(-m_desc.extent, m_desc.extent), 1.0f);
+        XMFLOAT4 color(0.0f, 0.0f, 0.0f, 1.0f);
+        if (i < m_desc.uNumPointLights)
+        {
+            color = XMFLOAT4(getRandom(0.5f, 1.0f), getRandom(0.5f, 1.0f), getRandom(0.5f, 1.0f), 1.0f);
+        }
+
+        FLOAT attenuationDistance = i == 0u ? m_desc.extent : m_desc.extent * 0.2f;
+        HRESULT hr = scene->AddPointLight(std::make_shared<library::PointLight>(position, color, attenuationDistance));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   SceneGenerator::getRandom
+
+  Summary:  Returns the next number of a 32-bit xorshift sequence
+            scaled into a range. The standard distributions are not
+            used because their results differ between implementations
+
+  Args:     FLOAT min
+              Smallest value
+            FLOAT max
+              Largest value
+
+  Modifies: [m_uRandomState].
+
+  Returns:  FLOAT
+              Random value in [min, max)
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FLOAT SceneGenerator::getRandom(_In_ FLOAT min, _In_ FLOAT max)
+{
+    m_uRandomState ^= m_uRandomState << 13u;
+    m_uRandomState ^= m_uRandomState >> 17u;
+    m_uRandomState ^= m_uRandomState << 5u;
+
+    return min + (max - min) * static_cast<FLOAT>(m_uRandomState >> 8u) / 16777216.0f;
+}
@@ -0,0 +1,76 @@
+/*+===================================================================
+  File:      SCENEGENERATOR.H
+
+  Summary:   SceneGenerator header file contains declarations of
+             SceneGenerator class that fills a scene with synthetic
+             content for scaling studies.
+
+  Classes: SceneGenerator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/Scene.h"
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+    Struct:   SceneGeneratorDesc
+
+    Summary:  Amount of every kind of content to generate and the
+              shaders to draw it with. The shaders must already be
+              added to the scene
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct SceneGeneratorDesc
+{
+    UINT uNumCubes;
+    UINT uNumModels;
+    UINT uVoxelMapSize;
+    UINT uNumPointLights;
+    UINT uSeed;
+    FLOAT extent;
+    std::filesystem::path modelFilePath;
+    PCWSTR pszCubeShaderName;
+    PCWSTR pszModelShaderName;
+};
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    SceneGenerator
+
+  Summary:  Places cubes, copies of a model, a voxel height map and
+            point lights at random inside a square around the origin.
+            Placement only depends on the seed, so the same
+            description generates the same scene on every run and
+            every machine
+
+  Methods:  Generate
+              Adds the generated content to a scene
+            SceneGenerator
+              Constructor.
+            ~SceneGenerator
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class SceneGenerator final
+{
+public:
+    SceneGenerator(_In_ const SceneGeneratorDesc& desc);
+    SceneGenerator(const SceneGenerator& other) = delete;
+    SceneGenerator(SceneGenerator&& other) = delete;
+    SceneGenerator& operator=(const SceneGenerator& other) = delete;
+    SceneGenerator& operator=(SceneGenerator&& other) = delete;
+    ~SceneGenerator() = default;
+
+    HRESULT Generate(_In_ const std::shared_ptr<library::Scene>& scene);
+
+private:
+    HRESULT generateCubes(_In_ const std::shared_ptr<library::Scene>& scene);
+    HRESULT generateModels(_In_ const std::shared_ptr<library::Scene>& scene);
+    HRESULT generateVoxels(_In_ const std::shared_ptr<library::Scene>& scene);
+    HRESULT generatePointLights(_In_ const std::shared_ptr<library::Scene>& scene);
+    FLOAT getRandom(_In_ FLOAT min, _In_ FLOAT max);
+
+private:
+    SceneGeneratorDesc m_desc;
+    UINT m_uRandomState;
+};
@@ -11,15 +11,8 @@
 ===================================================================+*/
 #pragma once
 
-#ifndef  UNICODE
-#define UNICODE
-#endif // ! UNICODE
+#include "CoreCommon.h"
 
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif // ! WIN32_LEAN_AND_MEAN
-
-#include <windows.h>
 #include <wincodec.h>
 #include <wrl.h>
 
@@ -35,22 +28,11 @@
 #include <stdlib.h>
 #include <crtdbg.h>
 
-#include <cassert>
-#include <filesystem>
-#include <memory>
-#include <string>
-#include <unordered_map>
-#include <unordered_set>
-#include <vector>
-
 #include "Resource.h"
 
 constexpr LPCWSTR PSZ_COURSE_TITLE = L"Game Graphics Programming";
 
 using namespace Microsoft::WRL;
-using namespace DirectX;
-
-#define ASSIMP_LOAD_FLAGS (aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ConvertToLeftHanded | aiProcess_CalcTangentSpace)
 
 namespace library
 {
@@ -79,29 +61,4 @@ namespace library
         LONG X;
         LONG Y;
     };
-
-    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
-        Enum:     eBlockType
-
-        Summary:  Enumeration of block types
-    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
-    enum class eBlockType : CHAR
-    {
-        GRASSLAND = 21,
-        SNOW,
-        OCEAN,
-        SAND,
-        SCORCHED,
-        BARE,
-        TUNDRA,
-        TEMPERATE_DESERT,
-        SHRUBLAND,
-        TAIGA,
-        TEMPERATE_DECIDUOUS_FOREST,
-        TEMPERATE_RAIN_FOREST,
-        SUBTROPICAL_DESERT,
-        TROPICAL_SEASONAL_FOREST,
-        TROPICAL_RAIN_FOREST,
-        COUNT,
-    };
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*+===================================================================
+  File:      CORECOMMON.H
+
+  Summary:   Common header file of the parts of the Library that only
+             use DirectXMath and the standard library, so they also
+             build without the Windows and Direct3D headers. Off
+             Windows it declares the Windows types and status codes
+             they use, and DirectXMath needs a sal.h on the include
+             path.
+
+  Functions:
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#ifndef  UNICODE
+#define UNICODE
+#endif // ! UNICODE
+
+#if defined(_WIN32)
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // ! WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#else
+
+#include <cstdint>
+#include <cstring>
+
+#include <sal.h>
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef char CHAR;
+typedef int16_t SHORT;
+typedef uint16_t WORD;
+typedef uint16_t UINT16;
+typedef int32_t INT;
+typedef uint32_t UINT;
+typedef uint32_t DWORD;
+typedef int32_t LONG;
+typedef int64_t LONGLONG;
+typedef uint64_t UINT64;
+typedef float FLOAT;
+typedef double DOUBLE;
+typedef const char* PCSTR;
+typedef const wchar_t* PCWSTR;
+typedef int32_t HRESULT;
+
+#define TRUE 1
+#define FALSE 0
+
+#define S_OK ((HRESULT)0L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+#define ARRAYSIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define ZeroMemory(pDestination, length) std::memset((pDestination), 0, (length))
+#define UNREFERENCED_PARAMETER(parameter) ((void)(parameter))
+
+#endif // _WIN32
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+#include <cassert>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace DirectX;
+
+#define ASSIMP_LOAD_FLAGS (aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ConvertToLeftHanded | aiProcess_CalcTangentSpace)
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eBlockType
+
+        Summary:  Enumeration of block types
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eBlockType : CHAR
+    {
+        GRASSLAND = 21,
+        SNOW,
+        OCEAN,
+        SAND,
+        SCORCHED,
+        BARE,
+        TUNDRA,
+        TEMPERATE_DESERT,
+        SHRUBLAND,
+        TAIGA,
+        TEMPERATE_DECIDUOUS_FOREST,
+        TEMPERATE_RAIN_FOREST,
+        SUBTROPICAL_DESERT,
+        TROPICAL_SEASONAL_FOREST,
+        TROPICAL_RAIN_FOREST,
+        COUNT,
+    };
+}
@@ -0,0 +1,179 @@
+#include "Game/CameraPath.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::CameraPath
+
+      Summary:  Constructor
+
+      Modifies: [m_aFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CameraPath::CameraPath() :
+        m_aFrames()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::Load
+
+      Summary:  Reads the frames from a camera path file, replacing the
+                current frames
+
+      Args:     PCWSTR pszFileName
+                  Path of the camera path file
+
+      Modifies: [m_aFrames].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the file can not be read or a
+                  line is malformed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT CameraPath::Load(_In_ PCWSTR pszFileName)
+    {
+        std::ifstream file{ std::filesystem::path(pszFileName) };
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        m_aFrames.clear();
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            INT aDirections[6] = {};
+            CameraPathFrame frame = {};
+            for (INT& iDirection : aDirections)
+            {
+                stream >> iDirection;
+            }
+            stream >> frame.mouseRelativeMovement.X >> frame.mouseRelativeMovement.Y;
+            if (!stream)
+            {
+                return E_FAIL;
+            }
+
+            frame.directions =
+            {
+                .bFront = aDirections[0] != 0,
+                .bLeft = aDirections[1] != 0,
+                .bBack = aDirections[2] != 0,
+                .bRight = aDirections[3] != 0,
+                .bUp = aDirections[4] != 0,
+                .bDown = aDirections[5] != 0
+            };
+            m_aFrames.push_back(frame);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::Save
+
+      Summary:  Writes the frames to a camera path file
+
+      Args:     PCWSTR pszFileName
+                  Path of the camera path file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT CameraPath::Save(_In_ PCWSTR pszFileName) const
+    {
+        std::ofstream file(std::filesystem::path(pszFileName), std::ios::trunc);
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        file << "# front left back right up down mouseX mouseY\n";
+        for (const CameraPathFrame& frame : m_aFrames)
+        {
+            file << (frame.directions.bFront ? 1 : 0) << ' '
+                << (frame.directions.bLeft ? 1 : 0) << ' '
+                << (frame.directions.bBack ? 1 : 0) << ' '
+                << (frame.directions.bRight ? 1 : 0) << ' '
+                << (frame.directions.bUp ? 1 : 0) << ' '
+                << (frame.directions.bDown ? 1 : 0) << ' '
+                << frame.mouseRelativeMovement.X << ' '
+                << frame.mouseRelativeMovement.Y << '\n';
+        }
+
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::AddFrame
+
+      Summary:  Appends the camera input of a frame
+
+      Args:     const DirectionsInput& directions
+                  Keyboard movement of the frame
+                const MouseRelativeMovement& mouseRelativeMovement
+                  Mouse movement of the frame
+
+      Modifies: [m_aFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CameraPath::AddFrame(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement)
+    {
+        m_aFrames.push_back(
+            {
+                .directions = directions,
+                .mouseRelativeMovement = mouseRelativeMovement
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::GetNumFrames
+
+      Summary:  Returns the number of frames
+
+      Returns:  UINT
+                  Number of frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CameraPath::GetNumFrames() const
+    {
+        return static_cast<UINT>(m_aFrames.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CameraPath::GetFrame
+
+      Summary:  Returns the camera input of a frame. The path loops, so
+                a benchmark may run longer than the recorded path; an
+                empty path returns no input
+
+      Args:     UINT uFrame
+                  Index of the frame
+
+      Returns:  const CameraPathFrame&
+                  Camera input of the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const CameraPathFrame& CameraPath::GetFrame(_In_ UINT uFrame) const
+    {
+        static const CameraPathFrame NO_INPUT = {};
+        if (m_aFrames.empty())
+        {
+            return NO_INPUT;
+        }
+
+        return m_aFrames[uFrame % m_aFrames.size()];
+    }
+}
@@ -0,0 +1,75 @@
+/*+===================================================================
+  File:      CAMERAPATH.H
+
+  Summary:   CameraPath header file contains declarations of CameraPath
+             class that stores the camera input of every frame, so a
+             benchmark replays the same camera movement every run.
+
+  Classes: CameraPath
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   CameraPathFrame
+
+        Summary:  Camera input of one frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CameraPathFrame
+    {
+        DirectionsInput directions;
+        MouseRelativeMovement mouseRelativeMovement;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CameraPath
+
+      Summary:  Camera input of consecutive frames, read from and
+                written to a text file with one frame per line:
+
+                  front left back right up down mouseX mouseY
+
+                The direction flags are 0 or 1, the mouse movement is
+                in raw input units. Lines starting with '#' are ignored
+
+      Methods:  Load
+                  Reads the frames from a file
+                Save
+                  Writes the frames to a file
+                AddFrame
+                  Appends the input of a frame
+                GetNumFrames
+                  Returns the number of frames
+                GetFrame
+                  Returns the input of a frame, looping the path
+                CameraPath
+                  Constructor.
+                ~CameraPath
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CameraPath final
+    {
+    public:
+        CameraPath();
+        CameraPath(const CameraPath& other) = delete;
+        CameraPath(CameraPath&& other) = delete;
+        CameraPath& operator=(const CameraPath& other) = delete;
+        CameraPath& operator=(CameraPath&& other) = delete;
+        ~CameraPath() = default;
+
+        HRESULT Load(_In_ PCWSTR pszFileName);
+        HRESULT Save(_In_ PCWSTR pszFileName) const;
+
+        void AddFrame(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement);
+        UINT GetNumFrames() const;
+        const CameraPathFrame& GetFrame(_In_ UINT uFrame) const;
+
+    private:
+        std::vector<CameraPathFrame> m_aFrames;
+    };
+}
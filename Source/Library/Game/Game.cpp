@@ -1,5 +1,12 @@
 #include "Game/Game.h"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <psapi.h>
+
+#include "Profiler/Profiler.h"
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -10,12 +17,15 @@ namespace library
       Args:     PCWSTR pszGameName
                   Name of the game
 
-      Modifies: [m_pszGameName, m_mainWindow, m_renderer].
+      Modifies: [m_pszGameName, m_mainWindow, m_renderer,
+                 m_recordedCameraPath, m_szCameraPathFileName].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Game::Game(_In_ PCWSTR pszGameName) :
         m_pszGameName(pszGameName),
         m_mainWindow(std::make_unique<MainWindow>()),
-        m_renderer(std::make_unique<Renderer>())
+        m_renderer(std::make_unique<Renderer>()),
+        m_recordedCameraPath(),
+        m_szCameraPathFileName()
     { }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Game::Initialize
@@ -49,7 +59,10 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Game::Run
 
-      Summary:  Runs the game loop
+      Summary:  Runs the game loop, recording the camera input when
+                RecordCameraPath was called before
+
+      Modifies: [m_recordedCameraPath].
 
       Returns:  INT
                   Status code to return to the operating system
@@ -66,29 +79,153 @@ namespace library
             
             if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
             {
+                PROFILE_SCOPE("Game", "Message");
                 TranslateMessage(&msg);
                 DispatchMessage(&msg);
                 
             }
             else
             {
+                PROFILE_SCOPE("Game", "Frame");
                 QueryPerformanceCounter(&EndingTime);
                 elapsedTime = (EndingTime.QuadPart - StartingTime.QuadPart) / (FLOAT)Frequency.QuadPart;
-                m_renderer->HandleInput(
-                    m_mainWindow->GetDirections(),
-                    m_mainWindow->GetMouseRelativeMovement(),
-                    elapsedTime
-                );
-                m_mainWindow->ResetMouseMovement();
-                m_renderer->Update(elapsedTime); 
+                {
+                    PROFILE_SCOPE("Game", "Input");
+                    if (!m_szCameraPathFileName.empty())
+                    {
+                        m_recordedCameraPath.AddFrame(m_mainWindow->GetDirections(), m_mainWindow->GetMouseRelativeMovement());
+                    }
+                    m_renderer->HandleInput(
+                        m_mainWindow->GetDirections(),
+                        m_mainWindow->GetMouseRelativeMovement(),
+                        elapsedTime
+                    );
+                    m_mainWindow->ResetMouseMovement();
+                }
+                {
+                    PROFILE_SCOPE("Game", "Update");
+                    m_renderer->Update(elapsedTime);
+                }
                 QueryPerformanceCounter(&StartingTime);
                 m_renderer->Render();
             }
         }
 
+        if (!m_szCameraPathFileName.empty() && FAILED(m_recordedCameraPath.Save(m_szCameraPathFileName.c_str())))
+        {
+            OutputDebugString(L"Failed to write the camera path\n");
+        }
+
         return static_cast<INT>(msg.wParam);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Game::RunBenchmark
+
+      Summary:  Renders a fixed number of frames with a fixed time step,
+                feeding the camera the input of the camera path instead
+                of the window, so every run renders the same frames.
+                The CPU time of Update and Render of every frame and
+                their 50th, 95th and 99th percentiles are written to a
+                CSV file, with the shadow draws submitted and skipped
+                per frame and the lookups and hit rate of the pose
+                cache of the main scene
+
+      Args:     const CameraPath& cameraPath
+                  Camera input of the frames, looped if shorter
+                UINT uNumFrames
+                  Number of frames to render
+                FLOAT deltaTime
+                  Time step of every frame in seconds
+                PCWSTR pszResultFileName
+                  Path of the CSV file
+
+      Returns:  HRESULT
+                  Status code, E_ABORT if the window was closed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Game::RunBenchmark(_In_ const CameraPath& cameraPath, _In_ UINT uNumFrames, _In_ FLOAT deltaTime, _In_ PCWSTR pszResultFileName)
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        DOUBLE millisecondsPerTick = 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+
+        std::vector<DOUBLE> aUpdateTimes;
+        std::vector<DOUBLE> aRenderTimes;
+        aUpdateTimes.reserve(uNumFrames);
+        aRenderTimes.reserve(uNumFrames);
+        UINT64 uNumShadowDraws = 0u;
+        UINT64 uNumSkippedShadowDraws = 0u;
+        std::shared_ptr<Scene> mainScene = m_renderer->GetMainSceneOrNull();
+        PoseCacheStatistics poseCacheStart = mainScene ? mainScene->GetPoseCache().GetStatistics() : PoseCacheStatistics{};
+
+        MSG msg = { 0 };
+        for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+        {
+            while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+            {
+                if (msg.message == WM_QUIT)
+                {
+                    return E_ABORT;
+                }
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+
+            const CameraPathFrame& frame = cameraPath.GetFrame(uFrame);
+
+            LARGE_INTEGER updateStart, renderStart, renderEnd;
+            QueryPerformanceCounter(&updateStart);
+            m_renderer->HandleInput(frame.directions, frame.mouseRelativeMovement, deltaTime);
+            m_renderer->Update(deltaTime);
+            QueryPerformanceCounter(&renderStart);
+            m_renderer->Render();
+            QueryPerformanceCounter(&renderEnd);
+
+            aUpdateTimes.push_back(static_cast<DOUBLE>(renderStart.QuadPart - updateStart.QuadPart) * millisecondsPerTick);
+            aRenderTimes.push_back(static_cast<DOUBLE>(renderEnd.QuadPart - renderStart.QuadPart) * millisecondsPerTick);
+
+            for (const RenderPassStatistics& pass : m_renderer->GetStatistics().GetLastFrame().aPasses)
+            {
+                if (pass.szName == L"Shadow")
+                {
+                    uNumShadowDraws += pass.uNumDraws;
+                    uNumSkippedShadowDraws += pass.uNumSkippedDraws;
+                }
+            }
+        }
+
+        PoseCacheStatistics poseCacheEnd = mainScene ? mainScene->GetPoseCache().GetStatistics() : PoseCacheStatistics{};
+        UINT64 uNumPoseCacheHits = poseCacheEnd.uNumHits - poseCacheStart.uNumHits;
+        UINT64 uNumPoseCacheLookups = uNumPoseCacheHits + poseCacheEnd.uNumMisses - poseCacheStart.uNumMisses;
+
+        const DOUBLE numFrames = static_cast<DOUBLE>(uNumFrames > 0u ? uNumFrames : 1u);
+        return writeBenchmarkResults(
+            pszResultFileName,
+            aUpdateTimes,
+            aRenderTimes,
+            static_cast<DOUBLE>(uNumShadowDraws) / numFrames,
+            static_cast<DOUBLE>(uNumSkippedShadowDraws) / numFrames,
+            static_cast<DOUBLE>(uNumPoseCacheLookups) / numFrames,
+            uNumPoseCacheLookups > 0u ? static_cast<DOUBLE>(uNumPoseCacheHits) / static_cast<DOUBLE>(uNumPoseCacheLookups) : 0.0
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Game::RecordCameraPath
+
+      Summary:  Records the camera input of every frame of Run, and
+                writes it into a camera path file when Run returns
+
+      Args:     PCWSTR pszFileName
+                  Path of the camera path file
+
+      Modifies: [m_szCameraPathFileName].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Game::RecordCameraPath(_In_ PCWSTR pszFileName)
+    {
+        m_szCameraPathFileName = pszFileName;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Game::GetGameName
 
@@ -125,4 +262,115 @@ namespace library
     std::unique_ptr<Renderer>& Game::GetRenderer() {
         return  m_renderer;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Game::getPercentile
+
+      Summary:  Returns the nearest-rank percentile of the values
+
+      Args:     std::vector<DOUBLE> aValues
+                  Values, sorted in place of the copy
+                DOUBLE percentile
+                  Percentile between 0 and 100
+
+      Returns:  DOUBLE
+                  Smallest value that is not less than the given
+                  percentage of the values, 0 if there are none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DOUBLE Game::getPercentile(_In_ std::vector<DOUBLE> aValues, _In_ DOUBLE percentile)
+    {
+        if (aValues.empty())
+        {
+            return 0.0;
+        }
+
+        std::sort(aValues.begin(), aValues.end());
+        size_t uRank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<DOUBLE>(aValues.size())));
+        return aValues[uRank > 0u ? uRank - 1u : 0u];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Game::writeBenchmarkResults
+
+      Summary:  Writes the CPU times of every frame in milliseconds,
+                followed by rows named p50, p95 and p99 holding the
+                percentiles of each column, rows named shadow_draws and
+                shadow_draws_skipped holding the draws of the shadow
+                pass per frame, rows named pose_cache_lookups and
+                pose_cache_hit_rate holding the lookups of the pose
+                cache per frame and the fraction that hit, and rows
+                named peak_working_set_mb and private_mb holding the
+                memory of the process
+
+      Args:     PCWSTR pszFileName
+                  Path of the CSV file
+                const std::vector<DOUBLE>& aUpdateTimes
+                  Time of Update of every frame
+                const std::vector<DOUBLE>& aRenderTimes
+                  Time of Render of every frame
+                DOUBLE shadowDraws
+                  Draws submitted by the shadow pass per frame
+                DOUBLE skippedShadowDraws
+                  Draws of culled and cached shadow casters the shadow
+                  pass skipped per frame
+                DOUBLE poseCacheLookups
+                  Models looking up the pose cache per frame
+                DOUBLE poseCacheHitRate
+                  Fraction of the lookups sharing the pose of another
+                  model
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Game::writeBenchmarkResults(_In_ PCWSTR pszFileName, _In_ const std::vector<DOUBLE>& aUpdateTimes, _In_ const std::vector<DOUBLE>& aRenderTimes, _In_ DOUBLE shadowDraws, _In_ DOUBLE skippedShadowDraws, _In_ DOUBLE poseCacheLookups, _In_ DOUBLE poseCacheHitRate)
+    {
+        std::ofstream file(std::filesystem::path(pszFileName), std::ios::trunc);
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        std::vector<DOUBLE> aFrameTimes(aUpdateTimes.size());
+        for (size_t i = 0u; i < aUpdateTimes.size(); ++i)
+        {
+            aFrameTimes[i] = aUpdateTimes[i] + aRenderTimes[i];
+        }
+
+        file.setf(std::ios::fixed);
+        file.precision(4);
+        file << "frame,update_ms,render_ms,frame_ms\n";
+        for (size_t i = 0u; i < aFrameTimes.size(); ++i)
+        {
+            file << i << ',' << aUpdateTimes[i] << ',' << aRenderTimes[i] << ',' << aFrameTimes[i] << '\n';
+        }
+
+        constexpr const DOUBLE aPercentiles[] = { 50.0, 95.0, 99.0 };
+        for (DOUBLE percentile : aPercentiles)
+        {
+            file << 'p' << static_cast<UINT>(percentile) << ','
+                << getPercentile(aUpdateTimes, percentile) << ','
+                << getPercentile(aRenderTimes, percentile) << ','
+                << getPercentile(aFrameTimes, percentile) << '\n';
+        }
+
+        file << "shadow_draws," << shadowDraws << '\n'
+            << "shadow_draws_skipped," << skippedShadowDraws << '\n'
+            << "pose_cache_lookups," << poseCacheLookups << '\n'
+            << "pose_cache_hit_rate," << poseCacheHitRate << '\n';
+
+        PROCESS_MEMORY_COUNTERS_EX memoryCounters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&memoryCounters), sizeof(memoryCounters)))
+        {
+            constexpr const DOUBLE BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+            file << "peak_working_set_mb," << static_cast<DOUBLE>(memoryCounters.PeakWorkingSetSize) / BYTES_PER_MEGABYTE << '\n'
+                << "private_mb," << static_cast<DOUBLE>(memoryCounters.PrivateUsage) / BYTES_PER_MEGABYTE << '\n';
+        }
+
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
 }
@@ -13,6 +13,7 @@
 
 #include "Common.h"
 
+#include "Game/CameraPath.h"
 #include "Renderer/Renderer.h"
 #include "Window/MainWindow.h"
 
@@ -28,6 +29,11 @@ namespace library
                   Initializes the components of the game
                 Run
                   Runs the game loop
+                RunBenchmark
+                  Renders a number of frames along a camera path and
+                  writes the frame times
+                RecordCameraPath
+                  Records the camera input of Run into a file
                 GetGameName
                   Returns the name of the game
                 GetWindow
@@ -53,13 +59,21 @@ namespace library
 
         HRESULT Initialize(_In_ HINSTANCE hInstance, _In_ INT nCmdShow);
         INT Run();
+        HRESULT RunBenchmark(_In_ const CameraPath& cameraPath, _In_ UINT uNumFrames, _In_ FLOAT deltaTime, _In_ PCWSTR pszResultFileName);
+        void RecordCameraPath(_In_ PCWSTR pszFileName);
 
         PCWSTR GetGameName() const;
         std::unique_ptr<MainWindow>& GetWindow();
         std::unique_ptr<Renderer>& GetRenderer();
+    private:
+        static DOUBLE getPercentile(_In_ std::vector<DOUBLE> aValues, _In_ DOUBLE percentile);
+        static HRESULT writeBenchmarkResults(_In_ PCWSTR pszFileName, _In_ const std::vector<DOUBLE>& aUpdateTimes, _In_ const std::vector<DOUBLE>& aRenderTimes, _In_ DOUBLE shadowDraws, _In_ DOUBLE skippedShadowDraws, _In_ DOUBLE poseCacheLookups, _In_ DOUBLE poseCacheHitRate);
+
     private:
         PCWSTR m_pszGameName;
         std::unique_ptr<MainWindow> m_mainWindow;
         std::unique_ptr<Renderer> m_renderer;
+        CameraPath m_recordedCameraPath;
+        std::wstring m_szCameraPathFileName;
     };
 }
\ No newline at end of file
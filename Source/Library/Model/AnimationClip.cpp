@@ -0,0 +1,565 @@
+#include "Model/AnimationClip.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "assimp/scene.h"		// output data structure
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   findKey
+
+      Summary:  Finds the key right before a time with a binary search,
+                the last key but one past the last key
+
+      Args:     FLOAT timeTicks
+                  Animation time
+                const Key* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys, at least 2
+
+      Returns:  UINT
+                  Index of the key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class Key>
+    static UINT findKey(_In_ FLOAT timeTicks, _In_reads_(uNumKeys) const Key* aKeys, _In_ UINT uNumKeys)
+    {
+        const Key* pNextKey = std::upper_bound(aKeys + 1, aKeys + uNumKeys, timeTicks,
+            [](FLOAT time, const Key& key) { return time < static_cast<FLOAT>(key.mTime); });
+        UINT uKey = static_cast<UINT>(pNextKey - aKeys) - 1u;
+        return uKey < uNumKeys - 1u ? uKey : uNumKeys - 2u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   getKeyFactor
+
+      Summary:  Returns how far a time is between a key and the next
+
+      Args:     FLOAT timeTicks
+                  Animation time
+                const Key& key
+                  Key before the time
+                const Key& nextKey
+                  Key after the time
+
+      Returns:  FLOAT
+                  Factor from 0 to 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class Key>
+    static FLOAT getKeyFactor(_In_ FLOAT timeTicks, _In_ const Key& key, _In_ const Key& nextKey)
+    {
+        FLOAT t1 = static_cast<FLOAT>(key.mTime);
+        FLOAT t2 = static_cast<FLOAT>(nextKey.mTime);
+        FLOAT factor = (timeTicks - t1) / (t2 - t1);
+        return factor < 0.0f ? 0.0f : (factor > 1.0f ? 1.0f : factor);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   interpolateVectorKeys
+
+      Summary:  Interpolates translation or scaling keys linearly
+
+      Args:     FLOAT timeTicks
+                  Animation time
+                const aiVectorKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+
+      Returns:  aiVector3D
+                  Interpolated vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    static aiVector3D interpolateVectorKeys(_In_ FLOAT timeTicks, _In_reads_(uNumKeys) const aiVectorKey* aKeys, _In_ UINT uNumKeys)
+    {
+        if (uNumKeys == 1u)
+        {
+            return aKeys[0].mValue;
+        }
+
+        UINT uKey = findKey(timeTicks, aKeys, uNumKeys);
+        FLOAT factor = getKeyFactor(timeTicks, aKeys[uKey], aKeys[uKey + 1u]);
+        const aiVector3D& start = aKeys[uKey].mValue;
+        const aiVector3D& end = aKeys[uKey + 1u].mValue;
+        return start + factor * (end - start);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   interpolateQuaternionKeys
+
+      Summary:  Interpolates rotation keys spherically
+
+      Args:     FLOAT timeTicks
+                  Animation time
+                const aiQuatKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+
+      Returns:  aiQuaternion
+                  Interpolated unit quaternion
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    static aiQuaternion interpolateQuaternionKeys(_In_ FLOAT timeTicks, _In_reads_(uNumKeys) const aiQuatKey* aKeys, _In_ UINT uNumKeys)
+    {
+        if (uNumKeys == 1u)
+        {
+            return aKeys[0].mValue;
+        }
+
+        UINT uKey = findKey(timeTicks, aKeys, uNumKeys);
+        FLOAT factor = getKeyFactor(timeTicks, aKeys[uKey], aKeys[uKey + 1u]);
+        aiQuaternion rotation;
+        aiQuaternion::Interpolate(rotation, aKeys[uKey].mValue, aKeys[uKey + 1u].mValue, factor);
+        rotation.Normalize();
+        return rotation;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::AnimationClip
+
+      Summary:  Constructor, samples every channel of an animation at
+                evenly spaced times from its start to its end, and
+                measures the error of the samples halfway between them
+                and at every key
+
+      Args:     const aiAnimation* pAnimation
+                  Assimp animation to resample
+                FLOAT samplesPerSecond
+                  Smallest number of samples in a second of the clip
+
+      Modifies: [m_aTrackNames, m_uNumGroups, m_uNumSamples,
+                  m_duration, m_ticksPerSecond, m_samplesPerTick,
+                  m_maxTranslationError, m_maxRotationError,
+                  m_maxScalingError, m_aSamples].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationClip::AnimationClip(_In_ const aiAnimation* pAnimation, _In_ FLOAT samplesPerSecond) :
+        m_aTrackNames(),
+        m_uNumGroups((pAnimation->mNumChannels + 3u) / 4u),
+        m_uNumSamples(2u),
+        m_duration(static_cast<FLOAT>(pAnimation->mDuration)),
+        m_ticksPerSecond(static_cast<FLOAT>(pAnimation->mTicksPerSecond != 0.0 ? pAnimation->mTicksPerSecond : 25.0)),
+        m_samplesPerTick(0.0f),
+        m_maxTranslationError(0.0f),
+        m_maxRotationError(0.0f),
+        m_maxScalingError(0.0f),
+        m_aSamples()
+    {
+        assert(samplesPerSecond > 0.0f);
+
+        if (m_duration > 0.0f)
+        {
+            FLOAT numIntervals = std::ceil(m_duration / m_ticksPerSecond * samplesPerSecond);
+            m_uNumSamples = numIntervals > 1.0f ? static_cast<UINT>(numIntervals) + 1u : 2u;
+            m_samplesPerTick = static_cast<FLOAT>(m_uNumSamples - 1u) / m_duration;
+        }
+
+        // The padding tracks hold the identity, so normalizing their rotations never divides by zero
+        m_aSamples.resize(static_cast<size_t>(m_uNumSamples) * NUM_COMPONENTS * m_uNumGroups * 4u, 0.0f);
+        for (UINT uSample = 0u; uSample < m_uNumSamples; ++uSample)
+        {
+            for (UINT uTrack = pAnimation->mNumChannels; uTrack < m_uNumGroups * 4u; ++uTrack)
+            {
+                m_aSamples[getIndex(uSample, ROTATION_W, uTrack)] = 1.0f;
+                m_aSamples[getIndex(uSample, SCALING_X, uTrack)] = 1.0f;
+                m_aSamples[getIndex(uSample, SCALING_Y, uTrack)] = 1.0f;
+                m_aSamples[getIndex(uSample, SCALING_Z, uTrack)] = 1.0f;
+            }
+        }
+
+        m_aTrackNames.reserve(pAnimation->mNumChannels);
+        for (UINT uTrack = 0u; uTrack < pAnimation->mNumChannels; ++uTrack)
+        {
+            const aiNodeAnim* pChannel = pAnimation->mChannels[uTrack];
+            m_aTrackNames.push_back(pChannel->mNodeName.C_Str());
+
+            aiQuaternion previousRotation;
+            for (UINT uSample = 0u; uSample < m_uNumSamples; ++uSample)
+            {
+                FLOAT timeTicks = m_samplesPerTick > 0.0f ? static_cast<FLOAT>(uSample) / m_samplesPerTick : 0.0f;
+                aiVector3D translation = interpolateVectorKeys(timeTicks, pChannel->mPositionKeys, pChannel->mNumPositionKeys);
+                aiQuaternion rotation = interpolateQuaternionKeys(timeTicks, pChannel->mRotationKeys, pChannel->mNumRotationKeys);
+                aiVector3D scaling = interpolateVectorKeys(timeTicks, pChannel->mScalingKeys, pChannel->mNumScalingKeys);
+
+                // q and -q are the same rotation, the one nearer to the previous sample is linearly interpolated to it
+                if (uSample > 0u &&
+                    rotation.x * previousRotation.x + rotation.y * previousRotation.y + rotation.z * previousRotation.z + rotation.w * previousRotation.w < 0.0f)
+                {
+                    rotation = aiQuaternion(-rotation.w, -rotation.x, -rotation.y, -rotation.z);
+                }
+                previousRotation = rotation;
+
+                m_aSamples[getIndex(uSample, ROTATION_X, uTrack)] = rotation.x;
+                m_aSamples[getIndex(uSample, ROTATION_Y, uTrack)] = rotation.y;
+                m_aSamples[getIndex(uSample, ROTATION_Z, uTrack)] = rotation.z;
+                m_aSamples[getIndex(uSample, ROTATION_W, uTrack)] = rotation.w;
+                m_aSamples[getIndex(uSample, TRANSLATION_X, uTrack)] = translation.x;
+                m_aSamples[getIndex(uSample, TRANSLATION_Y, uTrack)] = translation.y;
+                m_aSamples[getIndex(uSample, TRANSLATION_Z, uTrack)] = translation.z;
+                m_aSamples[getIndex(uSample, SCALING_X, uTrack)] = scaling.x;
+                m_aSamples[getIndex(uSample, SCALING_Y, uTrack)] = scaling.y;
+                m_aSamples[getIndex(uSample, SCALING_Z, uTrack)] = scaling.z;
+            }
+        }
+
+        // The samples are exact at their own times, the error peaks between them and at the keys they cut off
+        std::vector<XMVECTOR> aPose(GetNumTracks() * 3u);
+        for (UINT uSample = 0u; uSample + 1u < m_uNumSamples && m_samplesPerTick > 0.0f; ++uSample)
+        {
+            measureError(pAnimation, (static_cast<FLOAT>(uSample) + 0.5f) / m_samplesPerTick, aPose);
+        }
+        // Channels usually share their key times, so every distinct time is measured once
+        std::vector<FLOAT> aKeyTimes;
+        for (UINT uTrack = 0u; uTrack < pAnimation->mNumChannels; ++uTrack)
+        {
+            const aiNodeAnim* pChannel = pAnimation->mChannels[uTrack];
+            for (UINT uKey = 0u; uKey < pChannel->mNumPositionKeys; ++uKey)
+            {
+                aKeyTimes.push_back(static_cast<FLOAT>(pChannel->mPositionKeys[uKey].mTime));
+            }
+            for (UINT uKey = 0u; uKey < pChannel->mNumRotationKeys; ++uKey)
+            {
+                aKeyTimes.push_back(static_cast<FLOAT>(pChannel->mRotationKeys[uKey].mTime));
+            }
+            for (UINT uKey = 0u; uKey < pChannel->mNumScalingKeys; ++uKey)
+            {
+                aKeyTimes.push_back(static_cast<FLOAT>(pChannel->mScalingKeys[uKey].mTime));
+            }
+        }
+        std::sort(aKeyTimes.begin(), aKeyTimes.end());
+        aKeyTimes.erase(std::unique(aKeyTimes.begin(), aKeyTimes.end()), aKeyTimes.end());
+        for (FLOAT keyTime : aKeyTimes)
+        {
+            measureError(pAnimation, keyTime, aPose);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::Sample
+
+      Summary:  Interpolates the two samples around a time, four tracks
+                at a time, and writes the local transform of every
+                track. Times outside the clip are clamped to it
+
+      Args:     FLOAT timeTicks
+                  Animation time in ticks
+                XMVECTOR* aTranslations
+                  Translation of every track
+                XMVECTOR* aRotations
+                  Rotation quaternion of every track
+                XMVECTOR* aScales
+                  Scaling of every track
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::Sample(
+        _In_ FLOAT timeTicks,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+    ) const
+    {
+        FLOAT position = timeTicks * m_samplesPerTick;
+        FLOAT lastSample = static_cast<FLOAT>(m_uNumSamples - 1u);
+        position = position < 0.0f ? 0.0f : (position > lastSample ? lastSample : position);
+        UINT uSample = static_cast<UINT>(position);
+        uSample = uSample < m_uNumSamples - 1u ? uSample : m_uNumSamples - 2u;
+        XMVECTOR factor = XMVectorReplicate(position - static_cast<FLOAT>(uSample));
+
+        const UINT uNumTracks = GetNumTracks();
+        for (UINT uGroup = 0u; uGroup < m_uNumGroups; ++uGroup)
+        {
+            XMVECTOR aComponents[NUM_COMPONENTS];
+            for (UINT i = 0u; i < NUM_COMPONENTS; ++i)
+            {
+                XMVECTOR start = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aSamples[getIndex(uSample, static_cast<eComponent>(i), uGroup * 4u)]));
+                XMVECTOR end = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aSamples[getIndex(uSample + 1u, static_cast<eComponent>(i), uGroup * 4u)]));
+                aComponents[i] = XMVectorLerpV(start, end, factor);
+            }
+
+            XMVECTOR lengthSquared = XMVectorMultiply(aComponents[ROTATION_X], aComponents[ROTATION_X]);
+            lengthSquared = XMVectorMultiplyAdd(aComponents[ROTATION_Y], aComponents[ROTATION_Y], lengthSquared);
+            lengthSquared = XMVectorMultiplyAdd(aComponents[ROTATION_Z], aComponents[ROTATION_Z], lengthSquared);
+            lengthSquared = XMVectorMultiplyAdd(aComponents[ROTATION_W], aComponents[ROTATION_W], lengthSquared);
+            XMVECTOR inverseLength = XMVectorReciprocalSqrt(lengthSquared);
+
+            // Each matrix holds one component per row, transposing it gives one track per row
+            XMMATRIX rotations = XMMatrixTranspose(XMMATRIX(
+                XMVectorMultiply(aComponents[ROTATION_X], inverseLength),
+                XMVectorMultiply(aComponents[ROTATION_Y], inverseLength),
+                XMVectorMultiply(aComponents[ROTATION_Z], inverseLength),
+                XMVectorMultiply(aComponents[ROTATION_W], inverseLength)));
+            XMMATRIX translations = XMMatrixTranspose(XMMATRIX(
+                aComponents[TRANSLATION_X], aComponents[TRANSLATION_Y], aComponents[TRANSLATION_Z], XMVectorZero()));
+            XMMATRIX scales = XMMatrixTranspose(XMMATRIX(
+                aComponents[SCALING_X], aComponents[SCALING_Y], aComponents[SCALING_Z], XMVectorZero()));
+
+            UINT uNumLanes = uNumTracks - uGroup * 4u < 4u ? uNumTracks - uGroup * 4u : 4u;
+            for (UINT uLane = 0u; uLane < uNumLanes; ++uLane)
+            {
+                aTranslations[uGroup * 4u + uLane] = translations.r[uLane];
+                aRotations[uGroup * 4u + uLane] = rotations.r[uLane];
+                aScales[uGroup * 4u + uLane] = scales.r[uLane];
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetSample
+
+      Summary:  Writes the stored transform of every track at a sample,
+                without interpolating
+
+      Args:     UINT uSample
+                  Index of the sample
+                XMVECTOR* aTranslations
+                  Translation of every track
+                XMVECTOR* aRotations
+                  Rotation quaternion of every track
+                XMVECTOR* aScales
+                  Scaling of every track
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::GetSample(
+        _In_ UINT uSample,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+    ) const
+    {
+        assert(uSample < m_uNumSamples);
+
+        for (UINT uTrack = 0u; uTrack < GetNumTracks(); ++uTrack)
+        {
+            aTranslations[uTrack] = XMVectorSet(
+                m_aSamples[getIndex(uSample, TRANSLATION_X, uTrack)],
+                m_aSamples[getIndex(uSample, TRANSLATION_Y, uTrack)],
+                m_aSamples[getIndex(uSample, TRANSLATION_Z, uTrack)],
+                0.0f);
+            aRotations[uTrack] = XMVectorSet(
+                m_aSamples[getIndex(uSample, ROTATION_X, uTrack)],
+                m_aSamples[getIndex(uSample, ROTATION_Y, uTrack)],
+                m_aSamples[getIndex(uSample, ROTATION_Z, uTrack)],
+                m_aSamples[getIndex(uSample, ROTATION_W, uTrack)]);
+            aScales[uTrack] = XMVectorSet(
+                m_aSamples[getIndex(uSample, SCALING_X, uTrack)],
+                m_aSamples[getIndex(uSample, SCALING_Y, uTrack)],
+                m_aSamples[getIndex(uSample, SCALING_Z, uTrack)],
+                0.0f);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::FindTrack
+
+      Summary:  Returns the track animating a node
+
+      Args:     PCSTR pszNodeName
+                  Name of the node
+
+      Returns:  UINT
+                  Index of the track, INVALID_TRACK if the node is not
+                  animated
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationClip::FindTrack(_In_ PCSTR pszNodeName) const
+    {
+        for (UINT uTrack = 0u; uTrack < GetNumTracks(); ++uTrack)
+        {
+            if (m_aTrackNames[uTrack] == pszNodeName)
+            {
+                return uTrack;
+            }
+        }
+
+        return INVALID_TRACK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetTrackName
+
+      Summary:  Returns the name of the node a track animates
+
+      Args:     UINT uTrack
+                  Index of the track
+
+      Returns:  const std::string&
+                  Name of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::string& AnimationClip::GetTrackName(_In_ UINT uTrack) const
+    {
+        assert(uTrack < GetNumTracks());
+        return m_aTrackNames[uTrack];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetNumTracks
+
+      Summary:  Returns the number of tracks, one per animated node
+
+      Returns:  UINT
+                  Number of tracks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationClip::GetNumTracks() const
+    {
+        return static_cast<UINT>(m_aTrackNames.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetNumSamples
+
+      Summary:  Returns the number of samples of every track, including
+                the samples at the start and at the end of the clip
+
+      Returns:  UINT
+                  Number of samples
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationClip::GetNumSamples() const
+    {
+        return m_uNumSamples;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetDuration
+
+      Summary:  Returns the length of the clip
+
+      Returns:  FLOAT
+                  Length in ticks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetDuration() const
+    {
+        return m_duration;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetTicksPerSecond
+
+      Summary:  Returns the ticks of the clip in a second, 25 when the
+                animation does not say
+
+      Returns:  FLOAT
+                  Ticks per second
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetTicksPerSecond() const
+    {
+        return m_ticksPerSecond;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetMaxTranslationError
+
+      Summary:  Returns the largest distance between a sampled and an
+                interpolated translation
+
+      Returns:  FLOAT
+                  Distance in the units of the model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetMaxTranslationError() const
+    {
+        return m_maxTranslationError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetMaxRotationError
+
+      Summary:  Returns the largest angle between a sampled and an
+                interpolated rotation
+
+      Returns:  FLOAT
+                  Angle in radians
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetMaxRotationError() const
+    {
+        return m_maxRotationError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetMaxScalingError
+
+      Summary:  Returns the largest distance between a sampled and an
+                interpolated scaling
+
+      Returns:  FLOAT
+                  Distance between the scaling vectors
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetMaxScalingError() const
+    {
+        return m_maxScalingError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetSizeInBytes
+
+      Summary:  Returns the size of the samples, including the padding
+                of the last four tracks
+
+      Returns:  size_t
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t AnimationClip::GetSizeInBytes() const
+    {
+        return m_aSamples.size() * sizeof(FLOAT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::getIndex
+
+      Summary:  Returns where a component of a track is stored. A
+                sample holds the components one after another, and a
+                component holds every track
+
+      Args:     UINT uSample
+                  Index of the sample
+                eComponent component
+                  Component of the transform
+                UINT uTrack
+                  Index of the track
+
+      Returns:  size_t
+                  Index into the samples
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t AnimationClip::getIndex(_In_ UINT uSample, _In_ eComponent component, _In_ UINT uTrack) const
+    {
+        return (static_cast<size_t>(uSample) * NUM_COMPONENTS + component) * m_uNumGroups * 4u + uTrack;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::measureError
+
+      Summary:  Samples the clip at a time and compares every track
+                with the interpolated keys of its channel
+
+      Args:     const aiAnimation* pAnimation
+                  Animation the clip was built from
+                FLOAT timeTicks
+                  Animation time
+                std::vector<XMVECTOR>& aPose
+                  Scratch memory for the translations, rotations and
+                  scales of every track
+
+      Modifies: [m_maxTranslationError, m_maxRotationError,
+                  m_maxScalingError].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::measureError(_In_ const aiAnimation* pAnimation, _In_ FLOAT timeTicks, _Inout_ std::vector<XMVECTOR>& aPose)
+    {
+        const UINT uNumTracks = GetNumTracks();
+        XMVECTOR* aTranslations = aPose.data();
+        XMVECTOR* aRotations = aTranslations + uNumTracks;
+        XMVECTOR* aScales = aRotations + uNumTracks;
+        Sample(timeTicks, aTranslations, aRotations, aScales);
+
+        for (UINT uTrack = 0u; uTrack < uNumTracks; ++uTrack)
+        {
+            const aiNodeAnim* pChannel = pAnimation->mChannels[uTrack];
+            aiVector3D translation = interpolateVectorKeys(timeTicks, pChannel->mPositionKeys, pChannel->mNumPositionKeys);
+            aiQuaternion rotation = interpolateQuaternionKeys(timeTicks, pChannel->mRotationKeys, pChannel->mNumRotationKeys);
+            aiVector3D scaling = interpolateVectorKeys(timeTicks, pChannel->mScalingKeys, pChannel->mNumScalingKeys);
+
+            FLOAT translationError = XMVectorGetX(XMVector3Length(XMVectorSubtract(aTranslations[uTrack], XMVectorSet(translation.x, translation.y, translation.z, 0.0f))));
+            FLOAT scalingError = XMVectorGetX(XMVector3Length(XMVectorSubtract(aScales[uTrack], XMVectorSet(scaling.x, scaling.y, scaling.z, 0.0f))));
+            FLOAT cosHalfAngle = std::fabs(XMVectorGetX(XMVector4Dot(aRotations[uTrack], XMVectorSet(rotation.x, rotation.y, rotation.z, rotation.w))));
+            FLOAT rotationError = 2.0f * std::acos(cosHalfAngle < 1.0f ? cosHalfAngle : 1.0f);
+
+            m_maxTranslationError = translationError > m_maxTranslationError ? translationError : m_maxTranslationError;
+            m_maxRotationError = rotationError > m_maxRotationError ? rotationError : m_maxRotationError;
+            m_maxScalingError = scalingError > m_maxScalingError ? scalingError : m_maxScalingError;
+        }
+    }
+}
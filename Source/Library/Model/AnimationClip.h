@@ -0,0 +1,138 @@
+/*+===================================================================
+  File:      ANIMATIONCLIP.H
+
+  Summary:   AnimationClip header file contains declarations of
+             AnimationClip class that resamples an assimp animation
+             into uniformly spaced samples for the runtime.
+
+  Classes: AnimationClip
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+struct aiAnimation;
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationClip
+
+      Summary:  Runtime clip of an animation. Every channel of the
+                animation becomes a track, and the tracks are sampled
+                at a fixed rate when the clip is built, with the same
+                interpolation of the keys Model used every frame. The
+                samples are stored structure of arrays, so one sample
+                holds the rotation x of every track next to each other,
+                then the rotation y, and so on, four tracks per vector.
+                Sampling the clip indexes the two samples around the
+                time and interpolates four tracks at once, translations
+                and scales linearly and rotations with a normalized
+                linear interpolation. Consecutive rotation samples are
+                kept in the same hemisphere when the clip is built, so
+                no sign test is needed. The clip measures how far its
+                samples are from the keys, which bounds the error of
+                the resampling. The clip does not touch Direct3D
+
+      Methods:  Sample
+                  Writes the transforms of every track at a time
+                GetSample
+                  Writes the transforms of every track at a sample
+                FindTrack
+                  Returns the track of a node
+                GetTrackName
+                  Returns the name of the node of a track
+                GetNumTracks
+                  Returns the number of tracks
+                GetNumSamples
+                  Returns the number of samples of every track
+                GetDuration
+                  Returns the length of the clip in ticks
+                GetTicksPerSecond
+                  Returns the ticks of the clip in a second
+                GetMaxTranslationError
+                  Returns the largest translation error
+                GetMaxRotationError
+                  Returns the largest rotation error
+                GetMaxScalingError
+                  Returns the largest scaling error
+                GetSizeInBytes
+                  Returns the size of the samples
+                AnimationClip
+                  Constructor.
+                ~AnimationClip
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationClip final
+    {
+    public:
+        static constexpr const UINT INVALID_TRACK = UINT_MAX;
+
+    public:
+        AnimationClip() = delete;
+        AnimationClip(_In_ const aiAnimation* pAnimation, _In_ FLOAT samplesPerSecond);
+        AnimationClip(const AnimationClip& other) = delete;
+        AnimationClip(AnimationClip&& other) = delete;
+        AnimationClip& operator=(const AnimationClip& other) = delete;
+        AnimationClip& operator=(AnimationClip&& other) = delete;
+        ~AnimationClip() = default;
+
+        void Sample(
+            _In_ FLOAT timeTicks,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+        ) const;
+        void GetSample(
+            _In_ UINT uSample,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+        ) const;
+
+        UINT FindTrack(_In_ PCSTR pszNodeName) const;
+        const std::string& GetTrackName(_In_ UINT uTrack) const;
+        UINT GetNumTracks() const;
+        UINT GetNumSamples() const;
+        FLOAT GetDuration() const;
+        FLOAT GetTicksPerSecond() const;
+        FLOAT GetMaxTranslationError() const;
+        FLOAT GetMaxRotationError() const;
+        FLOAT GetMaxScalingError() const;
+        size_t GetSizeInBytes() const;
+
+    private:
+        // Components of a sample, each holding one vector per four tracks
+        enum eComponent : UINT
+        {
+            ROTATION_X,
+            ROTATION_Y,
+            ROTATION_Z,
+            ROTATION_W,
+            TRANSLATION_X,
+            TRANSLATION_Y,
+            TRANSLATION_Z,
+            SCALING_X,
+            SCALING_Y,
+            SCALING_Z,
+            NUM_COMPONENTS
+        };
+
+        size_t getIndex(_In_ UINT uSample, _In_ eComponent component, _In_ UINT uTrack) const;
+        void measureError(_In_ const aiAnimation* pAnimation, _In_ FLOAT timeTicks, _Inout_ std::vector<XMVECTOR>& aPose);
+
+    private:
+        std::vector<std::string> m_aTrackNames;
+        UINT m_uNumGroups;
+        UINT m_uNumSamples;
+        FLOAT m_duration;
+        FLOAT m_ticksPerSecond;
+        FLOAT m_samplesPerTick;
+        FLOAT m_maxTranslationError;
+        FLOAT m_maxRotationError;
+        FLOAT m_maxScalingError;
+        std::vector<FLOAT> m_aSamples;
+    };
+}
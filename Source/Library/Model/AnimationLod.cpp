@@ -0,0 +1,153 @@
+#include "Model/AnimationLod.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::AnimationLodPolicy
+
+      Summary:  Constructor
+
+      Args:     const AnimationLodDesc& desc
+                  Bounds scale, coverage and limits of the levels
+
+      Modifies: [m_desc].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationLodPolicy::AnimationLodPolicy(_In_ const AnimationLodDesc& desc) :
+        m_desc(desc)
+    {
+        SetDesc(desc);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::SetDesc
+
+      Summary:  Replaces the bounds scale, the coverage and the limits
+                of the levels
+
+      Args:     const AnimationLodDesc& desc
+                  Bounds scale, coverage and limits of the levels
+
+      Modifies: [m_desc].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationLodPolicy::SetDesc(_In_ const AnimationLodDesc& desc)
+    {
+        assert(desc.boundsScale > 0.0f && desc.fullRateCoverage > 0.0f);
+
+        m_desc = desc;
+        m_desc.uMaxUpdateInterval = desc.uMaxUpdateInterval > 1u ? desc.uMaxUpdateInterval : 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::GetDesc
+
+      Summary:  Returns the bounds scale, the coverage and the limits of
+                the levels
+
+      Returns:  const AnimationLodDesc&
+                  Description of the policy
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationLodDesc& AnimationLodPolicy::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::Select
+
+      Summary:  Returns the level of detail of a model seen by a camera.
+                The model is visible when the bounding sphere of its
+                scaled bounds intersects the frustum of the camera
+
+      Args:     const BoundingBox& localBounds
+                  Bounds of the bind pose of the model
+                const XMMATRIX& world
+                  World matrix of the model
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Returns:  AnimationLod
+                  Level of detail of the model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationLod AnimationLodPolicy::Select(_In_ const BoundingBox& localBounds, _In_ const XMMATRIX& world, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection) const
+    {
+        BoundingBox bounds = localBounds;
+        XMStoreFloat3(&bounds.Extents, XMVectorScale(XMLoadFloat3(&localBounds.Extents), m_desc.boundsScale));
+
+        BoundingSphere localSphere;
+        BoundingSphere::CreateFromBoundingBox(localSphere, bounds);
+        BoundingSphere worldSphere;
+        localSphere.Transform(worldSphere, world);
+
+        BoundingFrustum frustum(projection);
+        frustum.Transform(frustum, XMMatrixInverse(nullptr, view));
+
+        return SelectFromCoverage(GetScreenCoverage(worldSphere, view, projection), frustum.Intersects(worldSphere) ? TRUE : FALSE);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::SelectFromCoverage
+
+      Summary:  Returns the level of detail for a coverage of the
+                screen. Every halving of the coverage below the full
+                rate coverage doubles the update interval and skips one
+                more level of leaf nodes, until both reach their
+                maximums
+
+      Args:     FLOAT coverage
+                  Height of the projected bounds over the height of
+                  the screen
+                BOOL bVisible
+                  Whether the model is in the frustum of the camera
+
+      Returns:  AnimationLod
+                  Level of detail of the model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationLod AnimationLodPolicy::SelectFromCoverage(_In_ FLOAT coverage, _In_ BOOL bVisible) const
+    {
+        AnimationLod lod = FULL_LOD;
+        lod.bVisible = bVisible;
+
+        FLOAT threshold = m_desc.fullRateCoverage;
+        while (coverage < threshold && (lod.uUpdateInterval < m_desc.uMaxUpdateInterval || lod.uSkippedLevels < m_desc.uMaxSkippedLevels))
+        {
+            threshold *= 0.5f;
+            lod.uUpdateInterval = lod.uUpdateInterval * 2u < m_desc.uMaxUpdateInterval ? lod.uUpdateInterval * 2u : m_desc.uMaxUpdateInterval;
+            lod.uSkippedLevels = lod.uSkippedLevels < m_desc.uMaxSkippedLevels ? lod.uSkippedLevels + 1u : m_desc.uMaxSkippedLevels;
+        }
+
+        return lod;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodPolicy::GetScreenCoverage
+
+      Summary:  Returns the height of a projected sphere over the height
+                of the screen, from the depth of its center in the view
+                and the vertical scale of the projection. A camera
+                inside the sphere is covered entirely
+
+      Args:     const BoundingSphere& worldSphere
+                  Sphere in world space
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Returns:  FLOAT
+                  Coverage between 0 and 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationLodPolicy::GetScreenCoverage(_In_ const BoundingSphere& worldSphere, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection)
+    {
+        FLOAT depth = XMVectorGetZ(XMVector3TransformCoord(XMLoadFloat3(&worldSphere.Center), view));
+        if (depth <= worldSphere.Radius)
+        {
+            return 1.0f;
+        }
+
+        // The projected radius over half the screen equals the projected diameter over the screen
+        FLOAT coverage = worldSphere.Radius * XMVectorGetY(projection.r[1]) / depth;
+        return coverage < 1.0f ? coverage : 1.0f;
+    }
+}
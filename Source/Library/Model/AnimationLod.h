@@ -0,0 +1,108 @@
+/*+===================================================================
+  File:      ANIMATIONLOD.H
+
+  Summary:   AnimationLod header file contains declarations of
+             AnimationLodPolicy class that picks how often and how much
+             of the skeleton of an animated model is evaluated from its
+             coverage of the screen and its visibility.
+
+  Classes: AnimationLodDesc, AnimationLod, AnimationLodPolicy
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   AnimationLodDesc
+
+        Summary:  Data structure that describes the animation levels of
+                  detail. The coverage is the height of the projected
+                  bounding sphere over the height of the screen. A model
+                  covering at least the full rate coverage is evaluated
+                  every frame, and every halving of its coverage below
+                  it doubles the update interval and skips one more
+                  level of leaf nodes, up to the maximums. The bounds
+                  of the bind pose are scaled by the bounds scale, since
+                  the animated pose leaves them
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLodDesc
+    {
+        FLOAT boundsScale;
+        FLOAT fullRateCoverage;
+        UINT uMaxUpdateInterval;
+        UINT uMaxSkippedLevels;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   AnimationLod
+
+        Summary:  Data structure that describes the animation level of
+                  detail of a model. The skeleton is evaluated once every
+                  update interval frames, the nodes up to the skipped
+                  levels above the leaves keep their bind transform, and
+                  a model that is not visible only advances its time
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLod
+    {
+        UINT uUpdateInterval;
+        UINT uSkippedLevels;
+        BOOL bVisible;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationLodPolicy
+
+      Summary:  Picks the animation level of detail of a model from the
+                bounds of its bind pose, its world matrix and a camera.
+                The bounding sphere of the scaled bounds is tested
+                against the frustum of the camera, and its projected
+                height gives the coverage of the screen. The policy
+                only reads matrices and bounds, so it can be checked
+                against given cameras without Direct3D
+
+      Methods:  SetDesc
+                  Replaces the description
+                GetDesc
+                  Returns the description
+                Select
+                  Returns the level of detail of a model seen by a
+                  camera
+                SelectFromCoverage
+                  Returns the level of detail for a coverage
+                GetScreenCoverage
+                  Returns the coverage of the screen by a sphere
+                AnimationLodPolicy
+                  Constructor.
+                ~AnimationLodPolicy
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationLodPolicy final
+    {
+    public:
+        static constexpr const AnimationLod FULL_LOD = { .uUpdateInterval = 1u, .uSkippedLevels = 0u, .bVisible = TRUE };
+
+    public:
+        AnimationLodPolicy() = delete;
+        explicit AnimationLodPolicy(_In_ const AnimationLodDesc& desc);
+        AnimationLodPolicy(const AnimationLodPolicy& other) = delete;
+        AnimationLodPolicy(AnimationLodPolicy&& other) = delete;
+        AnimationLodPolicy& operator=(const AnimationLodPolicy& other) = delete;
+        AnimationLodPolicy& operator=(AnimationLodPolicy&& other) = delete;
+        ~AnimationLodPolicy() = default;
+
+        void SetDesc(_In_ const AnimationLodDesc& desc);
+        const AnimationLodDesc& GetDesc() const;
+
+        AnimationLod Select(_In_ const BoundingBox& localBounds, _In_ const XMMATRIX& world, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection) const;
+        AnimationLod SelectFromCoverage(_In_ FLOAT coverage, _In_ BOOL bVisible) const;
+
+        static FLOAT GetScreenCoverage(_In_ const BoundingSphere& worldSphere, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+
+    private:
+        AnimationLodDesc m_desc;
+    };
+}
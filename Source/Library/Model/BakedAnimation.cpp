@@ -0,0 +1,319 @@
+#include "Model/BakedAnimation.h"
+
+#include "Model/CompressedAnimationClip.h"
+#include "Model/Skeleton.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::BakedAnimation
+
+      Summary:  Constructor, the animation starts without frames
+
+      Args:     FLOAT framesPerSecond
+                  Sampling rate of the clips
+
+      Modifies: [m_framesPerSecond, m_uNumBones, m_aClips,
+                 m_aBoneTransforms, m_buffer, m_shaderResourceView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BakedAnimation::BakedAnimation(_In_ FLOAT framesPerSecond) :
+        m_framesPerSecond(framesPerSecond),
+        m_uNumBones(0u),
+        m_aClips(),
+        m_aBoneTransforms(),
+        m_buffer(),
+        m_shaderResourceView()
+    {
+        assert(framesPerSecond > 0.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::Bake
+
+      Summary:  Samples every clip from its start to its end at the rate
+                of the animation, evaluates the skeleton at full detail
+                for every frame and packs the transposed bone transforms
+                of the frames one clip after another. The last frame of
+                a clip is sampled at its end, so a clip that does not
+                loop holds its last pose. Baking again replaces the
+                frames and releases the buffer
+
+      Args:     const Skeleton& skeleton
+                  Skeleton the clips animate
+                const std::vector<std::shared_ptr<CompressedAnimationClip>>& aClips
+                  Clips to bake
+                const std::vector<std::vector<UINT>>& aNodeTracks
+                  Track of every node for every clip, from
+                  Skeleton::MapTracks
+                const XMMATRIX& globalInverseTransform
+                  Inverse of the transform of the root node
+
+      Modifies: [m_uNumBones, m_aClips, m_aBoneTransforms, m_buffer,
+                 m_shaderResourceView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BakedAnimation::Bake(
+        _In_ const Skeleton& skeleton,
+        _In_ const std::vector<std::shared_ptr<CompressedAnimationClip>>& aClips,
+        _In_ const std::vector<std::vector<UINT>>& aNodeTracks,
+        _In_ const XMMATRIX& globalInverseTransform
+    )
+    {
+        assert(aNodeTracks.size() == aClips.size());
+
+        m_uNumBones = skeleton.GetNumBones();
+        m_aClips.clear();
+        m_buffer.Reset();
+        m_shaderResourceView.Reset();
+
+        UINT uNumFrames = 0u;
+        for (const std::shared_ptr<CompressedAnimationClip>& clip : aClips)
+        {
+            FLOAT duration = clip->GetDuration() > 0.0f ? clip->GetDuration() / clip->GetTicksPerSecond() : 0.0f;
+            UINT uNumClipFrames = static_cast<UINT>(std::ceil(duration * m_framesPerSecond)) + 1u;
+            m_aClips.push_back({ .uFirstFrame = uNumFrames, .uNumFrames = uNumClipFrames, .duration = duration });
+            uNumFrames += uNumClipFrames;
+        }
+        m_aBoneTransforms.assign(static_cast<size_t>(uNumFrames) * m_uNumBones, XMFLOAT4X4());
+
+        std::vector<XMVECTOR> aTranslations;
+        std::vector<XMVECTOR> aRotations;
+        std::vector<XMVECTOR> aScales;
+        std::vector<XMMATRIX> aGlobalTransforms(skeleton.GetNumNodes());
+        std::vector<XMMATRIX> aBoneTransforms(m_uNumBones);
+        for (UINT uClip = 0u; uClip < aClips.size(); ++uClip)
+        {
+            const CompressedAnimationClip& clip = *aClips[uClip];
+            const BakedAnimationClip& bakedClip = m_aClips[uClip];
+            aTranslations.resize(clip.GetNumTracks());
+            aRotations.resize(clip.GetNumTracks());
+            aScales.resize(clip.GetNumTracks());
+
+            for (UINT uFrame = 0u; uFrame < bakedClip.uNumFrames; ++uFrame)
+            {
+                FLOAT time = static_cast<FLOAT>(uFrame) / m_framesPerSecond;
+                time = time < bakedClip.duration ? time : bakedClip.duration;
+                clip.Sample(time * clip.GetTicksPerSecond(), aTranslations.data(), aRotations.data(), aScales.data());
+                skeleton.Evaluate(aNodeTracks[uClip].data(), aTranslations.data(), aRotations.data(), aScales.data(), 0u,
+                    globalInverseTransform, aGlobalTransforms.data(), aBoneTransforms.data());
+
+                XMFLOAT4X4* aFrameTransforms = &m_aBoneTransforms[static_cast<size_t>(GetFrameOffset(bakedClip.uFirstFrame + uFrame))];
+                for (UINT uBone = 0u; uBone < m_uNumBones; ++uBone)
+                {
+                    XMStoreFloat4x4(&aFrameTransforms[uBone], XMMatrixTranspose(aBoneTransforms[uBone]));
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::Initialize
+
+      Summary:  Creates the immutable structured buffer of the bone
+                transforms and its view, once for every model sharing
+                the animation
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+
+      Modifies: [m_buffer, m_shaderResourceView].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL before Bake
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT BakedAnimation::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        if (m_shaderResourceView)
+        {
+            return S_OK;
+        }
+
+        if (m_aBoneTransforms.empty() || GetSizeInBytes() > UINT_MAX)
+        {
+            return E_FAIL;
+        }
+
+        D3D11_BUFFER_DESC bd = {
+            .ByteWidth = static_cast<UINT>(GetSizeInBytes()),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0,
+            .MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+            .StructureByteStride = static_cast<UINT>(sizeof(XMFLOAT4X4))
+        };
+        D3D11_SUBRESOURCE_DATA initData = {
+            .pSysMem = m_aBoneTransforms.data(),
+            .SysMemPitch = 0,
+            .SysMemSlicePitch = 0
+        };
+        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_buffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {
+            .Format = DXGI_FORMAT_UNKNOWN,
+            .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+            .Buffer = { .FirstElement = 0u, .NumElements = static_cast<UINT>(m_aBoneTransforms.size()) }
+        };
+        return pDevice->CreateShaderResourceView(m_buffer.Get(), &srvDesc, m_shaderResourceView.ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetFrame
+
+      Summary:  Returns the frame of a clip nearest to a time, the last
+                frame past the end of the clip
+
+      Args:     UINT uClip
+                  Index of the clip
+                FLOAT time
+                  Time of the clip in seconds
+
+      Returns:  UINT
+                  Index of the frame in the packed frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BakedAnimation::GetFrame(_In_ UINT uClip, _In_ FLOAT time) const
+    {
+        assert(uClip < m_aClips.size());
+
+        const BakedAnimationClip& clip = m_aClips[uClip];
+        FLOAT frame = time * m_framesPerSecond + 0.5f;
+        UINT uFrame = frame > 0.0f ? static_cast<UINT>(frame) : 0u;
+        return clip.uFirstFrame + (uFrame < clip.uNumFrames ? uFrame : clip.uNumFrames - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetFrameOffset
+
+      Summary:  Returns the index of the first bone transform of a
+                frame, the value a model writes for the skinning shader
+
+      Args:     UINT uFrame
+                  Index of the frame in the packed frames
+
+      Returns:  UINT
+                  Index of the transform in the packed transforms
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BakedAnimation::GetFrameOffset(_In_ UINT uFrame) const
+    {
+        return uFrame * m_uNumBones;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetFrameTransforms
+
+      Summary:  Returns the transposed bone transforms of a frame
+
+      Args:     UINT uFrame
+                  Index of the frame in the packed frames
+
+      Returns:  const XMFLOAT4X4*
+                  Transforms, by bone
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4X4* BakedAnimation::GetFrameTransforms(_In_ UINT uFrame) const
+    {
+        assert(uFrame < GetNumFrames());
+
+        return m_aBoneTransforms.data() + GetFrameOffset(uFrame);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetClip
+
+      Summary:  Returns the frames of a clip
+
+      Args:     UINT uClip
+                  Index of the clip
+
+      Returns:  const BakedAnimationClip&
+                  First frame, number of frames and length of the clip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BakedAnimationClip& BakedAnimation::GetClip(_In_ UINT uClip) const
+    {
+        assert(uClip < m_aClips.size());
+
+        return m_aClips[uClip];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetFramesPerSecond
+
+      Summary:  Returns the rate the clips are sampled at
+
+      Returns:  FLOAT
+                  Frames in a second
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT BakedAnimation::GetFramesPerSecond() const
+    {
+        return m_framesPerSecond;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumClips
+
+      Summary:  Returns the number of baked clips
+
+      Returns:  UINT
+                  Number of clips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BakedAnimation::GetNumClips() const
+    {
+        return static_cast<UINT>(m_aClips.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumFrames
+
+      Summary:  Returns the number of frames of every clip together
+
+      Returns:  UINT
+                  Number of frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BakedAnimation::GetNumFrames() const
+    {
+        return m_aClips.empty() ? 0u : m_aClips.back().uFirstFrame + m_aClips.back().uNumFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumBones
+
+      Summary:  Returns the number of bone transforms of a frame
+
+      Returns:  UINT
+                  Number of bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BakedAnimation::GetNumBones() const
+    {
+        return m_uNumBones;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetSizeInBytes
+
+      Summary:  Returns the size of the packed bone transforms, which is
+                also the size of the structured buffer
+
+      Returns:  size_t
+                  Frames times bones times the size of a transform
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t BakedAnimation::GetSizeInBytes() const
+    {
+        return m_aBoneTransforms.size() * sizeof(XMFLOAT4X4);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetShaderResourceView
+
+      Summary:  Returns the view of the structured buffer
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  View, empty before Initialize
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& BakedAnimation::GetShaderResourceView()
+    {
+        return m_shaderResourceView;
+    }
+}
@@ -0,0 +1,120 @@
+/*+===================================================================
+  File:      BAKEDANIMATION.H
+
+  Summary:   BakedAnimation header file contains declarations of
+             BakedAnimation class that samples the clips of a skeleton
+             at a fixed rate into one packed buffer of bone transforms,
+             so a crowd is skinned by indexing frames instead of
+             evaluating the skeleton of every model.
+
+  Classes: BakedAnimationClip, BakedAnimation
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    class CompressedAnimationClip;
+    class Skeleton;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   BakedAnimationClip
+
+        Summary:  Data structure that locates the frames of a clip in the
+                  packed buffer, the first frame and the number of
+                  frames, the last one sampled at the end of the clip,
+                  and the length of the clip in seconds
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BakedAnimationClip
+    {
+        UINT uFirstFrame;
+        UINT uNumFrames;
+        FLOAT duration;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BakedAnimation
+
+      Summary:  Bone transforms of every clip of a skeleton, sampled at
+                a fixed rate when the model is loaded and packed frame
+                after frame into one array, transposed the way the
+                skinning constants are. A frame holds the final
+                transform of every bone, so a model playing a baked clip
+                only picks the frame of its time, and the skinning
+                shader reads its bones from the offset of the frame in
+                a structured buffer shared by every model of the
+                skeleton. Baking and the lookup of the frames do not
+                touch Direct3D, only Initialize creates the buffer
+
+      Methods:  Bake
+                  Samples the clips into frames
+                Initialize
+                  Creates the structured buffer of the frames
+                GetFrame
+                  Returns the frame of a clip nearest to a time
+                GetFrameOffset
+                  Returns the offset of the first bone of a frame
+                GetFrameTransforms
+                  Returns the bone transforms of a frame
+                GetClip
+                  Returns the frames of a clip
+                GetFramesPerSecond
+                  Returns the sampling rate
+                GetNumClips
+                  Returns the number of clips
+                GetNumFrames
+                  Returns the number of frames of every clip
+                GetNumBones
+                  Returns the number of bones of a frame
+                GetSizeInBytes
+                  Returns the size of the bone transforms
+                GetShaderResourceView
+                  Returns the view of the structured buffer
+                BakedAnimation
+                  Constructor.
+                ~BakedAnimation
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BakedAnimation final
+    {
+    public:
+        BakedAnimation() = delete;
+        explicit BakedAnimation(_In_ FLOAT framesPerSecond);
+        BakedAnimation(const BakedAnimation& other) = delete;
+        BakedAnimation(BakedAnimation&& other) = delete;
+        BakedAnimation& operator=(const BakedAnimation& other) = delete;
+        BakedAnimation& operator=(BakedAnimation&& other) = delete;
+        ~BakedAnimation() = default;
+
+        void Bake(
+            _In_ const Skeleton& skeleton,
+            _In_ const std::vector<std::shared_ptr<CompressedAnimationClip>>& aClips,
+            _In_ const std::vector<std::vector<UINT>>& aNodeTracks,
+            _In_ const XMMATRIX& globalInverseTransform
+        );
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+        UINT GetFrame(_In_ UINT uClip, _In_ FLOAT time) const;
+        UINT GetFrameOffset(_In_ UINT uFrame) const;
+        const XMFLOAT4X4* GetFrameTransforms(_In_ UINT uFrame) const;
+        const BakedAnimationClip& GetClip(_In_ UINT uClip) const;
+        FLOAT GetFramesPerSecond() const;
+        UINT GetNumClips() const;
+        UINT GetNumFrames() const;
+        UINT GetNumBones() const;
+        size_t GetSizeInBytes() const;
+
+        ComPtr<ID3D11ShaderResourceView>& GetShaderResourceView();
+
+    private:
+        FLOAT m_framesPerSecond;
+        UINT m_uNumBones;
+        std::vector<BakedAnimationClip> m_aClips;
+        std::vector<XMFLOAT4X4> m_aBoneTransforms;
+        ComPtr<ID3D11Buffer> m_buffer;
+        ComPtr<ID3D11ShaderResourceView> m_shaderResourceView;
+    };
+}
@@ -0,0 +1,768 @@
+#include "Model/CompressedAnimationClip.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Model/AnimationClip.h"
+#include "Model/Skeleton.h"
+
+namespace library
+{
+    static constexpr const FLOAT SQRT_2 = 1.41421356f;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   encodeRotation
+
+      Summary:  Packs a unit quaternion into 48 bits. The largest
+                component is dropped and made positive by negating the
+                quaternion, which is the same rotation, so the other
+                three lie between -1/sqrt(2) and 1/sqrt(2) and are
+                stored in 15 bits each after its 2 bit index
+
+      Args:     FXMVECTOR rotation
+                  Unit quaternion
+                UINT16* aValues
+                  Three packed values
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    static void encodeRotation(_In_ FXMVECTOR rotation, _Out_writes_(3) UINT16* aValues)
+    {
+        XMFLOAT4 components;
+        XMStoreFloat4(&components, rotation);
+        const FLOAT aComponents[4] = { components.x, components.y, components.z, components.w };
+
+        UINT uLargest = 0u;
+        for (UINT i = 1u; i < 4u; ++i)
+        {
+            if (std::fabs(aComponents[i]) > std::fabs(aComponents[uLargest]))
+            {
+                uLargest = i;
+            }
+        }
+        FLOAT scale = aComponents[uLargest] < 0.0f ? -SQRT_2 : SQRT_2;
+
+        UINT64 uBits = uLargest;
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            if (i != uLargest)
+            {
+                FLOAT quantized = std::round((aComponents[i] * scale * 0.5f + 0.5f) * 32767.0f);
+                uBits = (uBits << 15u) | static_cast<UINT64>(quantized < 0.0f ? 0.0f : (quantized > 32767.0f ? 32767.0f : quantized));
+            }
+        }
+
+        aValues[0] = static_cast<UINT16>(uBits >> 32u);
+        aValues[1] = static_cast<UINT16>(uBits >> 16u);
+        aValues[2] = static_cast<UINT16>(uBits);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   decodeRotation
+
+      Summary:  Unpacks a quaternion packed by encodeRotation, rebuilding
+                the dropped component from the unit length
+
+      Args:     const UINT16* aValues
+                  Three packed values
+
+      Returns:  XMVECTOR
+                  Unit quaternion
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    static XMVECTOR decodeRotation(_In_reads_(3) const UINT16* aValues)
+    {
+        UINT64 uBits = (static_cast<UINT64>(aValues[0]) << 32u) | (static_cast<UINT64>(aValues[1]) << 16u) | aValues[2];
+        UINT uLargest = static_cast<UINT>(uBits >> 45u) & 3u;
+
+        FLOAT aComponents[4];
+        FLOAT lengthSquared = 0.0f;
+        for (UINT i = 4u; i > 0u; --i)
+        {
+            if (i - 1u != uLargest)
+            {
+                aComponents[i - 1u] = (static_cast<FLOAT>(uBits & 0x7fffu) / 32767.0f * 2.0f - 1.0f) / SQRT_2;
+                lengthSquared += aComponents[i - 1u] * aComponents[i - 1u];
+                uBits >>= 15u;
+            }
+        }
+        aComponents[uLargest] = lengthSquared < 1.0f ? std::sqrt(1.0f - lengthSquared) : 0.0f;
+
+        return XMVectorSet(aComponents[0], aComponents[1], aComponents[2], aComponents[3]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::CompressedAnimationClip
+
+      Summary:  Constructor, compresses every channel of a clip within
+                the tolerance its node gets from the error budget, and
+                measures the error of the compressed clip
+
+      Args:     const AnimationClip& clip
+                  Resampled clip to compress
+                const Skeleton& skeleton
+                  Skeleton the clip animates
+                FLOAT errorBudget
+                  Largest distance a node may move, relative to the
+                  size of the skeleton
+
+      Modifies: [m_aTrackNames, m_uNumSamples, m_duration,
+                  m_ticksPerSecond, m_samplesPerTick,
+                  m_maxTranslationError, m_maxRotationError,
+                  m_maxScalingError, m_maxPositionError, m_aChannels,
+                  m_aKeySamples, m_aKeyValues].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CompressedAnimationClip::CompressedAnimationClip(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton, _In_ FLOAT errorBudget) :
+        m_aTrackNames(),
+        m_uNumSamples(clip.GetNumSamples()),
+        m_duration(clip.GetDuration()),
+        m_ticksPerSecond(clip.GetTicksPerSecond()),
+        m_samplesPerTick(clip.GetDuration() > 0.0f ? static_cast<FLOAT>(clip.GetNumSamples() - 1u) / clip.GetDuration() : 0.0f),
+        m_maxTranslationError(0.0f),
+        m_maxRotationError(0.0f),
+        m_maxScalingError(0.0f),
+        m_maxPositionError(0.0f),
+        m_aChannels(static_cast<size_t>(clip.GetNumTracks()) * NUM_CHANNELS),
+        m_aKeySamples(),
+        m_aKeyValues()
+    {
+        assert(m_uNumSamples <= 65536u);
+
+        const UINT uNumTracks = clip.GetNumTracks();
+        m_aTrackNames.reserve(uNumTracks);
+        for (UINT uTrack = 0u; uTrack < uNumTracks; ++uTrack)
+        {
+            m_aTrackNames.push_back(clip.GetTrackName(uTrack));
+        }
+
+        std::vector<XMVECTOR> aTranslations(static_cast<size_t>(m_uNumSamples) * uNumTracks);
+        std::vector<XMVECTOR> aRotations(aTranslations.size());
+        std::vector<XMVECTOR> aScales(aTranslations.size());
+        for (UINT uSample = 0u; uSample < m_uNumSamples; ++uSample)
+        {
+            size_t uOffset = static_cast<size_t>(uSample) * uNumTracks;
+            clip.GetSample(uSample, aTranslations.data() + uOffset, aRotations.data() + uOffset, aScales.data() + uOffset);
+        }
+
+        std::vector<XMFLOAT3> aTolerances;
+        getTolerances(clip, skeleton, errorBudget, aTolerances);
+        for (UINT uTrack = 0u; uTrack < uNumTracks; ++uTrack)
+        {
+            compressChannel(ROTATION, uTrack, aRotations, aTolerances[uTrack].x);
+            compressChannel(TRANSLATION, uTrack, aTranslations, aTolerances[uTrack].y);
+            compressChannel(SCALING, uTrack, aScales, aTolerances[uTrack].z);
+        }
+
+        measureError(clip, skeleton);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::Sample
+
+      Summary:  Interpolates the two keys around a time of every channel
+                and writes the local transform of every track. Times
+                outside the clip are clamped to it
+
+      Args:     FLOAT timeTicks
+                  Animation time in ticks
+                XMVECTOR* aTranslations
+                  Translation of every track
+                XMVECTOR* aRotations
+                  Rotation quaternion of every track
+                XMVECTOR* aScales
+                  Scaling of every track
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CompressedAnimationClip::Sample(
+        _In_ FLOAT timeTicks,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+        _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+    ) const
+    {
+        FLOAT position = timeTicks * m_samplesPerTick;
+        FLOAT lastSample = static_cast<FLOAT>(m_uNumSamples - 1u);
+        position = position < 0.0f ? 0.0f : (position > lastSample ? lastSample : position);
+
+        for (UINT uTrack = 0u; uTrack < GetNumTracks(); ++uTrack)
+        {
+            const Channel* aChannels = &m_aChannels[static_cast<size_t>(uTrack) * NUM_CHANNELS];
+            aRotations[uTrack] = sampleChannel(ROTATION, aChannels[ROTATION], position);
+            aTranslations[uTrack] = sampleChannel(TRANSLATION, aChannels[TRANSLATION], position);
+            aScales[uTrack] = sampleChannel(SCALING, aChannels[SCALING], position);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::FindTrack
+
+      Summary:  Returns the track animating a node
+
+      Args:     PCSTR pszNodeName
+                  Name of the node
+
+      Returns:  UINT
+                  Index of the track, AnimationClip::INVALID_TRACK if
+                  no track animates the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CompressedAnimationClip::FindTrack(_In_ PCSTR pszNodeName) const
+    {
+        for (UINT uTrack = 0u; uTrack < GetNumTracks(); ++uTrack)
+        {
+            if (m_aTrackNames[uTrack] == pszNodeName)
+            {
+                return uTrack;
+            }
+        }
+
+        return AnimationClip::INVALID_TRACK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetTrackName
+
+      Summary:  Returns the name of the node a track animates
+
+      Args:     UINT uTrack
+                  Index of the track
+
+      Returns:  const std::string&
+                  Name of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::string& CompressedAnimationClip::GetTrackName(_In_ UINT uTrack) const
+    {
+        return m_aTrackNames[uTrack];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetNumTracks
+
+      Summary:  Returns the number of tracks, the same as the source
+                clip
+
+      Returns:  UINT
+                  Number of tracks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CompressedAnimationClip::GetNumTracks() const
+    {
+        return static_cast<UINT>(m_aTrackNames.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetNumKeys
+
+      Summary:  Returns the number of keys kept by every channel
+
+      Returns:  UINT
+                  Number of keys
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CompressedAnimationClip::GetNumKeys() const
+    {
+        return static_cast<UINT>(m_aKeySamples.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetDuration
+
+      Summary:  Returns the length of the clip
+
+      Returns:  FLOAT
+                  Length in ticks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetDuration() const
+    {
+        return m_duration;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetTicksPerSecond
+
+      Summary:  Returns the ticks of the clip in a second
+
+      Returns:  FLOAT
+                  Ticks per second
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetTicksPerSecond() const
+    {
+        return m_ticksPerSecond;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetMaxTranslationError
+
+      Summary:  Returns the largest distance between a decompressed and
+                a source translation
+
+      Returns:  FLOAT
+                  Distance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetMaxTranslationError() const
+    {
+        return m_maxTranslationError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetMaxRotationError
+
+      Summary:  Returns the largest angle between a decompressed and a
+                source rotation
+
+      Returns:  FLOAT
+                  Angle in radians
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetMaxRotationError() const
+    {
+        return m_maxRotationError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetMaxScalingError
+
+      Summary:  Returns the largest distance between a decompressed and
+                a source scaling
+
+      Returns:  FLOAT
+                  Distance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetMaxScalingError() const
+    {
+        return m_maxScalingError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetMaxPositionError
+
+      Summary:  Returns the largest distance between a node posed by
+                the compressed clip and by the source clip, which adds
+                up the errors of the node and of its parents
+
+      Returns:  FLOAT
+                  Distance in the units of the model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::GetMaxPositionError() const
+    {
+        return m_maxPositionError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::GetSizeInBytes
+
+      Summary:  Returns the size of the channels and of the keys
+
+      Returns:  size_t
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t CompressedAnimationClip::GetSizeInBytes() const
+    {
+        return m_aChannels.size() * sizeof(Channel) + m_aKeySamples.size() * sizeof(UINT16) + m_aKeyValues.size() * sizeof(UINT16);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::encodeValue
+
+      Summary:  Packs the value of a key into three 16 bit values
+
+      Args:     eChannel type
+                  Channel the key belongs to
+                const Channel& channel
+                  Channel with the range of its translations or scales
+                FXMVECTOR value
+                  Value to pack
+                UINT16* aValues
+                  Three packed values
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CompressedAnimationClip::encodeValue(_In_ eChannel type, _In_ const Channel& channel, _In_ FXMVECTOR value, _Out_writes_(3) UINT16* aValues)
+    {
+        if (type == ROTATION)
+        {
+            encodeRotation(value, aValues);
+            return;
+        }
+
+        XMFLOAT3 components;
+        XMStoreFloat3(&components, value);
+        const FLOAT aComponents[3] = { components.x, components.y, components.z };
+        const FLOAT aMinimums[3] = { channel.minimum.x, channel.minimum.y, channel.minimum.z };
+        const FLOAT aExtents[3] = { channel.extent.x, channel.extent.y, channel.extent.z };
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            FLOAT quantized = aExtents[i] > 0.0f ? std::round((aComponents[i] - aMinimums[i]) / aExtents[i] * 65535.0f) : 0.0f;
+            aValues[i] = static_cast<UINT16>(quantized < 0.0f ? 0.0f : (quantized > 65535.0f ? 65535.0f : quantized));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::decodeValue
+
+      Summary:  Unpacks the value of a key packed by encodeValue
+
+      Args:     eChannel type
+                  Channel the key belongs to
+                const Channel& channel
+                  Channel with the range of its translations or scales
+                const UINT16* aValues
+                  Three packed values
+
+      Returns:  XMVECTOR
+                  Value of the key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR CompressedAnimationClip::decodeValue(_In_ eChannel type, _In_ const Channel& channel, _In_reads_(3) const UINT16* aValues)
+    {
+        if (type == ROTATION)
+        {
+            return decodeRotation(aValues);
+        }
+
+        XMVECTOR quantized = XMVectorSet(static_cast<FLOAT>(aValues[0]), static_cast<FLOAT>(aValues[1]), static_cast<FLOAT>(aValues[2]), 0.0f);
+        return XMVectorMultiplyAdd(quantized, XMVectorScale(XMLoadFloat3(&channel.extent), 1.0f / 65535.0f), XMLoadFloat3(&channel.minimum));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::getError
+
+      Summary:  Returns how far a value of a channel is from the value
+                it should have
+
+      Args:     eChannel type
+                  Channel of the values
+                FXMVECTOR value
+                  Value to measure
+                FXMVECTOR expected
+                  Value it should have
+
+      Returns:  FLOAT
+                  Angle in radians for rotations, distance otherwise
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CompressedAnimationClip::getError(_In_ eChannel type, _In_ FXMVECTOR value, _In_ FXMVECTOR expected)
+    {
+        if (type == ROTATION)
+        {
+            FLOAT cosHalfAngle = std::fabs(XMVectorGetX(XMVector4Dot(value, expected)));
+            return 2.0f * std::acos(cosHalfAngle < 1.0f ? cosHalfAngle : 1.0f);
+        }
+
+        return XMVectorGetX(XMVector3Length(XMVectorSubtract(value, expected)));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::interpolate
+
+      Summary:  Interpolates two keys of a channel, rotations with a
+                normalized linear interpolation along the shorter arc,
+                since packing a quaternion may negate it
+
+      Args:     eChannel type
+                  Channel of the keys
+                FXMVECTOR start
+                  Value of the key before
+                FXMVECTOR end
+                  Value of the key after
+                FLOAT factor
+                  Factor from 0 to 1
+
+      Returns:  XMVECTOR
+                  Interpolated value
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR CompressedAnimationClip::interpolate(_In_ eChannel type, _In_ FXMVECTOR start, _In_ FXMVECTOR end, _In_ FLOAT factor)
+    {
+        if (type == ROTATION)
+        {
+            XMVECTOR nearEnd = XMVectorSelect(end, XMVectorNegate(end), XMVectorLess(XMVector4Dot(start, end), XMVectorZero()));
+            return XMQuaternionNormalize(XMVectorLerp(start, nearEnd, factor));
+        }
+
+        return XMVectorLerp(start, end, factor);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::getTolerances
+
+      Summary:  Splits the error budget into a tolerance of every
+                channel. The budget of a node is divided by the number
+                of nodes on the longest chain through it, and its
+                rotation and scaling tolerances are divided by the
+                longest reach below it in the bind pose, at least the
+                average bone length, since the mesh around a leaf moves
+                with it too. A track animating several nodes takes the
+                smallest tolerance
+
+      Args:     const AnimationClip& clip
+                  Clip being compressed
+                const Skeleton& skeleton
+                  Skeleton the clip animates
+                FLOAT errorBudget
+                  Largest distance a node may move, relative to the
+                  size of the skeleton
+                std::vector<XMFLOAT3>& aTolerances
+                  Rotation, translation and scaling tolerance of every
+                  track
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CompressedAnimationClip::getTolerances(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton, _In_ FLOAT errorBudget, _Out_ std::vector<XMFLOAT3>& aTolerances) const
+    {
+        const UINT uNumNodes = skeleton.GetNumNodes();
+        std::vector<XMMATRIX> aGlobalTransforms(uNumNodes);
+        std::vector<XMMATRIX> aBoneTransforms(skeleton.GetNumBones());
+        skeleton.Evaluate(nullptr, nullptr, nullptr, nullptr, 0u, XMMatrixIdentity(), aGlobalTransforms.data(), aBoneTransforms.data());
+
+        std::vector<UINT> aDepths(uNumNodes, 1u);
+        for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+        {
+            UINT uParent = skeleton.GetParent(uNode);
+            aDepths[uNode] = uParent != Skeleton::INVALID_INDEX ? aDepths[uParent] + 1u : 1u;
+        }
+
+        // Children come after their parents, so walking backwards finishes every subtree before its root
+        std::vector<UINT> aHeights(uNumNodes, 1u);
+        std::vector<FLOAT> aReaches(uNumNodes, 0.0f);
+        FLOAT totalLength = 0.0f;
+        UINT uNumLengths = 0u;
+        for (UINT uNode = uNumNodes; uNode > 0u; --uNode)
+        {
+            UINT uParent = skeleton.GetParent(uNode - 1u);
+            if (uParent != Skeleton::INVALID_INDEX)
+            {
+                FLOAT length = XMVectorGetX(XMVector3Length(XMVectorSubtract(aGlobalTransforms[uNode - 1u].r[3], aGlobalTransforms[uParent].r[3])));
+                FLOAT reach = aReaches[uNode - 1u] + length;
+                aReaches[uParent] = reach > aReaches[uParent] ? reach : aReaches[uParent];
+                aHeights[uParent] = aHeights[uNode - 1u] + 1u > aHeights[uParent] ? aHeights[uNode - 1u] + 1u : aHeights[uParent];
+                if (length > 0.0f)
+                {
+                    totalLength += length;
+                    ++uNumLengths;
+                }
+            }
+        }
+
+        FLOAT size = 0.0f;
+        for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+        {
+            if (skeleton.GetParent(uNode) == Skeleton::INVALID_INDEX)
+            {
+                size = aReaches[uNode] > size ? aReaches[uNode] : size;
+            }
+        }
+        size = size > 0.0f ? size : 1.0f;
+        FLOAT minimumReach = uNumLengths > 0u ? totalLength / static_cast<FLOAT>(uNumLengths) : size;
+        FLOAT budget = errorBudget * size;
+
+        // Tracks animating no node move nothing, they only have to stay within the budget of the whole skeleton
+        aTolerances.assign(clip.GetNumTracks(), XMFLOAT3(budget / size, budget, budget / size));
+
+        std::vector<UINT> aNodeTracks;
+        skeleton.MapTracks(clip, aNodeTracks);
+        std::vector<BOOL> aMapped(clip.GetNumTracks(), FALSE);
+        for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+        {
+            UINT uTrack = aNodeTracks[uNode];
+            if (uTrack == AnimationClip::INVALID_TRACK)
+            {
+                continue;
+            }
+
+            FLOAT nodeBudget = budget / static_cast<FLOAT>(aDepths[uNode] + aHeights[uNode] - 1u);
+            FLOAT reach = aReaches[uNode] > minimumReach ? aReaches[uNode] : minimumReach;
+            XMFLOAT3 tolerance(nodeBudget / reach, nodeBudget, nodeBudget / reach);
+            if (aMapped[uTrack])
+            {
+                tolerance.x = tolerance.x < aTolerances[uTrack].x ? tolerance.x : aTolerances[uTrack].x;
+                tolerance.y = tolerance.y < aTolerances[uTrack].y ? tolerance.y : aTolerances[uTrack].y;
+                tolerance.z = tolerance.z < aTolerances[uTrack].z ? tolerance.z : aTolerances[uTrack].z;
+            }
+            aTolerances[uTrack] = tolerance;
+            aMapped[uTrack] = TRUE;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::compressChannel
+
+      Summary:  Keeps the first sample of a channel as a key, and only
+                that key when every sample is within the tolerance of
+                it. Otherwise every next key is the farthest sample, at
+                most MAX_KEY_SPAN away, that the samples in between can
+                be interpolated to from the previous key within the
+                tolerance. The keys are quantized before the samples
+                are compared, so the tolerance covers both errors
+
+      Args:     eChannel type
+                  Channel to compress
+                UINT uTrack
+                  Track of the channel
+                const std::vector<XMVECTOR>& aSamples
+                  Values of the channel of every track at every sample
+                FLOAT tolerance
+                  Largest error of a sample, an angle in radians for
+                  rotations and a distance otherwise
+
+      Modifies: [m_aChannels, m_aKeySamples, m_aKeyValues].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CompressedAnimationClip::compressChannel(_In_ eChannel type, _In_ UINT uTrack, _In_ const std::vector<XMVECTOR>& aSamples, _In_ FLOAT tolerance)
+    {
+        const size_t uNumTracks = GetNumTracks();
+        Channel channel =
+        {
+            .uFirstKey = static_cast<UINT>(m_aKeySamples.size()),
+            .uNumKeys = 0u,
+            .minimum = XMFLOAT3(0.0f, 0.0f, 0.0f),
+            .extent = XMFLOAT3(0.0f, 0.0f, 0.0f)
+        };
+
+        if (type != ROTATION)
+        {
+            XMVECTOR minimum = aSamples[uTrack];
+            XMVECTOR maximum = minimum;
+            for (UINT uSample = 1u; uSample < m_uNumSamples; ++uSample)
+            {
+                minimum = XMVectorMin(minimum, aSamples[uSample * uNumTracks + uTrack]);
+                maximum = XMVectorMax(maximum, aSamples[uSample * uNumTracks + uTrack]);
+            }
+            XMStoreFloat3(&channel.minimum, minimum);
+            XMStoreFloat3(&channel.extent, XMVectorSubtract(maximum, minimum));
+        }
+
+        UINT16 aValues[3];
+        UINT uKeySample = 0u;
+        encodeValue(type, channel, aSamples[uTrack], aValues);
+        m_aKeySamples.push_back(0u);
+        m_aKeyValues.insert(m_aKeyValues.end(), aValues, aValues + 3);
+        ++channel.uNumKeys;
+
+        XMVECTOR start = decodeValue(type, channel, aValues);
+        BOOL bConstant = TRUE;
+        for (UINT uSample = 1u; uSample < m_uNumSamples && bConstant; ++uSample)
+        {
+            bConstant = getError(type, start, aSamples[uSample * uNumTracks + uTrack]) <= tolerance;
+        }
+
+        while (!bConstant && uKeySample + 1u < m_uNumSamples)
+        {
+            UINT uLastSample = uKeySample + MAX_KEY_SPAN < m_uNumSamples - 1u ? uKeySample + MAX_KEY_SPAN : m_uNumSamples - 1u;
+            UINT uNextSample = uKeySample + 1u;
+            UINT16 aNextValues[3];
+            encodeValue(type, channel, aSamples[uNextSample * uNumTracks + uTrack], aNextValues);
+
+            // A key right after the previous one leaves nothing to interpolate, so it always fits
+            for (UINT uEndSample = uKeySample + 2u; uEndSample <= uLastSample; ++uEndSample)
+            {
+                UINT16 aEndValues[3];
+                encodeValue(type, channel, aSamples[uEndSample * uNumTracks + uTrack], aEndValues);
+                XMVECTOR end = decodeValue(type, channel, aEndValues);
+
+                BOOL bFits = TRUE;
+                for (UINT uSample = uKeySample + 1u; uSample < uEndSample && bFits; ++uSample)
+                {
+                    FLOAT factor = static_cast<FLOAT>(uSample - uKeySample) / static_cast<FLOAT>(uEndSample - uKeySample);
+                    bFits = getError(type, interpolate(type, start, end, factor), aSamples[uSample * uNumTracks + uTrack]) <= tolerance;
+                }
+                if (!bFits)
+                {
+                    break;
+                }
+
+                uNextSample = uEndSample;
+                std::copy(aEndValues, aEndValues + 3, aNextValues);
+            }
+
+            m_aKeySamples.push_back(static_cast<UINT16>(uNextSample));
+            m_aKeyValues.insert(m_aKeyValues.end(), aNextValues, aNextValues + 3);
+            ++channel.uNumKeys;
+            start = decodeValue(type, channel, aNextValues);
+            uKeySample = uNextSample;
+        }
+
+        m_aChannels[uTrack * NUM_CHANNELS + type] = channel;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::sampleChannel
+
+      Summary:  Finds the two keys of a channel around a position with a
+                binary search and interpolates them
+
+      Args:     eChannel type
+                  Channel to sample
+                const Channel& channel
+                  Keys of the channel
+                FLOAT position
+                  Position in samples, inside the clip
+
+      Returns:  XMVECTOR
+                  Value of the channel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR CompressedAnimationClip::sampleChannel(_In_ eChannel type, _In_ const Channel& channel, _In_ FLOAT position) const
+    {
+        const UINT16* aKeySamples = &m_aKeySamples[channel.uFirstKey];
+        const UINT16* aValues = &m_aKeyValues[static_cast<size_t>(channel.uFirstKey) * 3u];
+        if (channel.uNumKeys == 1u)
+        {
+            return decodeValue(type, channel, aValues);
+        }
+
+        const UINT16* pNextKey = std::upper_bound(aKeySamples + 1, aKeySamples + channel.uNumKeys, position,
+            [](FLOAT samplePosition, UINT16 uKeySample) { return samplePosition < static_cast<FLOAT>(uKeySample); });
+        UINT uKey = static_cast<UINT>(pNextKey - aKeySamples) - 1u;
+        uKey = uKey < channel.uNumKeys - 1u ? uKey : channel.uNumKeys - 2u;
+
+        FLOAT start = static_cast<FLOAT>(aKeySamples[uKey]);
+        FLOAT factor = (position - start) / (static_cast<FLOAT>(aKeySamples[uKey + 1u]) - start);
+        factor = factor < 0.0f ? 0.0f : (factor > 1.0f ? 1.0f : factor);
+
+        return interpolate(type, decodeValue(type, channel, aValues + uKey * 3u), decodeValue(type, channel, aValues + (uKey + 1u) * 3u), factor);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CompressedAnimationClip::measureError
+
+      Summary:  Compares the compressed clip with the source clip at
+                every sample, track by track and node by node
+
+      Args:     const AnimationClip& clip
+                  Source clip
+                const Skeleton& skeleton
+                  Skeleton the clip animates
+
+      Modifies: [m_maxTranslationError, m_maxRotationError,
+                  m_maxScalingError, m_maxPositionError].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CompressedAnimationClip::measureError(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton)
+    {
+        const UINT uNumTracks = GetNumTracks();
+        std::vector<XMVECTOR> aSourcePose(static_cast<size_t>(uNumTracks) * 3u);
+        std::vector<XMVECTOR> aPose(aSourcePose.size());
+        XMVECTOR* aSourceTranslations = aSourcePose.data();
+        XMVECTOR* aSourceRotations = aSourceTranslations + uNumTracks;
+        XMVECTOR* aSourceScales = aSourceRotations + uNumTracks;
+        XMVECTOR* aTranslations = aPose.data();
+        XMVECTOR* aRotations = aTranslations + uNumTracks;
+        XMVECTOR* aScales = aRotations + uNumTracks;
+
+        std::vector<UINT> aNodeTracks;
+        skeleton.MapTracks(clip, aNodeTracks);
+        std::vector<XMMATRIX> aSourceGlobalTransforms(skeleton.GetNumNodes());
+        std::vector<XMMATRIX> aGlobalTransforms(skeleton.GetNumNodes());
+        std::vector<XMMATRIX> aBoneTransforms(skeleton.GetNumBones());
+
+        for (UINT uSample = 0u; uSample < m_uNumSamples; ++uSample)
+        {
+            clip.GetSample(uSample, aSourceTranslations, aSourceRotations, aSourceScales);
+            for (UINT uTrack = 0u; uTrack < uNumTracks; ++uTrack)
+            {
+                const Channel* aChannels = &m_aChannels[static_cast<size_t>(uTrack) * NUM_CHANNELS];
+                aRotations[uTrack] = sampleChannel(ROTATION, aChannels[ROTATION], static_cast<FLOAT>(uSample));
+                aTranslations[uTrack] = sampleChannel(TRANSLATION, aChannels[TRANSLATION], static_cast<FLOAT>(uSample));
+                aScales[uTrack] = sampleChannel(SCALING, aChannels[SCALING], static_cast<FLOAT>(uSample));
+
+                FLOAT rotationError = getError(ROTATION, aRotations[uTrack], aSourceRotations[uTrack]);
+                FLOAT translationError = getError(TRANSLATION, aTranslations[uTrack], aSourceTranslations[uTrack]);
+                FLOAT scalingError = getError(SCALING, aScales[uTrack], aSourceScales[uTrack]);
+                m_maxRotationError = rotationError > m_maxRotationError ? rotationError : m_maxRotationError;
+                m_maxTranslationError = translationError > m_maxTranslationError ? translationError : m_maxTranslationError;
+                m_maxScalingError = scalingError > m_maxScalingError ? scalingError : m_maxScalingError;
+            }
+
+            skeleton.Evaluate(aNodeTracks.data(), aSourceTranslations, aSourceRotations, aSourceScales, 0u, XMMatrixIdentity(), aSourceGlobalTransforms.data(), aBoneTransforms.data());
+            skeleton.Evaluate(aNodeTracks.data(), aTranslations, aRotations, aScales, 0u, XMMatrixIdentity(), aGlobalTransforms.data(), aBoneTransforms.data());
+            for (UINT uNode = 0u; uNode < skeleton.GetNumNodes(); ++uNode)
+            {
+                FLOAT positionError = XMVectorGetX(XMVector3Length(XMVectorSubtract(aGlobalTransforms[uNode].r[3], aSourceGlobalTransforms[uNode].r[3])));
+                m_maxPositionError = positionError > m_maxPositionError ? positionError : m_maxPositionError;
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/*+===================================================================
+  File:      COMPRESSEDANIMATIONCLIP.H
+
+  Summary:   CompressedAnimationClip header file contains declarations
+             of CompressedAnimationClip class that stores a resampled
+             animation clip in quantized keys, dropping the samples
+             interpolation rebuilds within an error budget.
+
+  Classes: CompressedAnimationClip
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    class AnimationClip;
+    class Skeleton;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CompressedAnimationClip
+
+      Summary:  Runtime clip compressed from an AnimationClip. Every
+                track has a rotation, a translation and a scaling
+                channel, and every channel keeps only the samples its
+                neighbours can not be linearly interpolated to within
+                a tolerance. A key is eight bytes, the sample it was
+                taken at and three 16 bit values. Rotations store the
+                three smallest components of the quaternion in 15 bits
+                and which one was dropped in 2 bits, the dropped one
+                is rebuilt from the unit length. Translations and
+                scales store every component in 16 bits over the range
+                of the channel. The error budget is a distance relative
+                to the size of the skeleton. A node shares it with the
+                other nodes on the longest chain through it, since
+                their errors add up at the end of the chain, and a
+                rotation or a scaling error is multiplied by how far
+                the chain reaches below the node. Sampling finds the
+                two keys around the time of every channel with a binary
+                search. The clip measures how far its tracks and the
+                nodes of the skeleton are from the source clip at every
+                sample. The clip does not touch Direct3D
+
+      Methods:  Sample
+                  Writes the transforms of every track at a time
+                FindTrack
+                  Returns the track of a node
+                GetTrackName
+                  Returns the name of the node of a track
+                GetNumTracks
+                  Returns the number of tracks
+                GetNumKeys
+                  Returns the number of keys of every channel
+                GetDuration
+                  Returns the length of the clip in ticks
+                GetTicksPerSecond
+                  Returns the ticks of the clip in a second
+                GetMaxTranslationError
+                  Returns the largest translation error
+                GetMaxRotationError
+                  Returns the largest rotation error
+                GetMaxScalingError
+                  Returns the largest scaling error
+                GetMaxPositionError
+                  Returns the largest error of a node position
+                GetSizeInBytes
+                  Returns the size of the channels and the keys
+                CompressedAnimationClip
+                  Constructor.
+                ~CompressedAnimationClip
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CompressedAnimationClip final
+    {
+    public:
+        static constexpr const UINT MAX_KEY_SPAN = 255u;
+
+    public:
+        CompressedAnimationClip() = delete;
+        CompressedAnimationClip(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton, _In_ FLOAT errorBudget);
+        CompressedAnimationClip(const CompressedAnimationClip& other) = delete;
+        CompressedAnimationClip(CompressedAnimationClip&& other) = delete;
+        CompressedAnimationClip& operator=(const CompressedAnimationClip& other) = delete;
+        CompressedAnimationClip& operator=(CompressedAnimationClip&& other) = delete;
+        ~CompressedAnimationClip() = default;
+
+        void Sample(
+            _In_ FLOAT timeTicks,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aTranslations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aRotations,
+            _Out_writes_(GetNumTracks()) XMVECTOR* aScales
+        ) const;
+
+        UINT FindTrack(_In_ PCSTR pszNodeName) const;
+        const std::string& GetTrackName(_In_ UINT uTrack) const;
+        UINT GetNumTracks() const;
+        UINT GetNumKeys() const;
+        FLOAT GetDuration() const;
+        FLOAT GetTicksPerSecond() const;
+        FLOAT GetMaxTranslationError() const;
+        FLOAT GetMaxRotationError() const;
+        FLOAT GetMaxScalingError() const;
+        FLOAT GetMaxPositionError() const;
+        size_t GetSizeInBytes() const;
+
+    private:
+        // Channels of a track, each holding its own keys
+        enum eChannel : UINT
+        {
+            ROTATION,
+            TRANSLATION,
+            SCALING,
+            NUM_CHANNELS
+        };
+
+        struct Channel
+        {
+            UINT uFirstKey;
+            UINT uNumKeys;
+            XMFLOAT3 minimum;
+            XMFLOAT3 extent;
+        };
+
+        static void encodeValue(_In_ eChannel type, _In_ const Channel& channel, _In_ FXMVECTOR value, _Out_writes_(3) UINT16* aValues);
+        static XMVECTOR decodeValue(_In_ eChannel type, _In_ const Channel& channel, _In_reads_(3) const UINT16* aValues);
+        static FLOAT getError(_In_ eChannel type, _In_ FXMVECTOR value, _In_ FXMVECTOR expected);
+        static XMVECTOR interpolate(_In_ eChannel type, _In_ FXMVECTOR start, _In_ FXMVECTOR end, _In_ FLOAT factor);
+
+        void getTolerances(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton, _In_ FLOAT errorBudget, _Out_ std::vector<XMFLOAT3>& aTolerances) const;
+        void compressChannel(_In_ eChannel type, _In_ UINT uTrack, _In_ const std::vector<XMVECTOR>& aSamples, _In_ FLOAT tolerance);
+        XMVECTOR sampleChannel(_In_ eChannel type, _In_ const Channel& channel, _In_ FLOAT position) const;
+        void measureError(_In_ const AnimationClip& clip, _In_ const Skeleton& skeleton);
+
+    private:
+        std::vector<std::string> m_aTrackNames;
+        UINT m_uNumSamples;
+        FLOAT m_duration;
+        FLOAT m_ticksPerSecond;
+        FLOAT m_samplesPerTick;
+        FLOAT m_maxTranslationError;
+        FLOAT m_maxRotationError;
+        FLOAT m_maxScalingError;
+        FLOAT m_maxPositionError;
+        std::vector<Channel> m_aChannels;
+        std::vector<UINT16> m_aKeySamples;
+        std::vector<UINT16> m_aKeyValues;
+    };
+}
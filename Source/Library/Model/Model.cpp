@@ -1,9 +1,14 @@
 #include "Model/Model.h"
 
+#include "Profiler/Profiler.h"
+
 #include "assimp/Importer.hpp"	// C++ importer interface
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include <algorithm>
+#include <cmath>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -35,32 +40,8 @@ namespace library
         );
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   ConvertVector3dToFloat3
-
-      Summary:  Conver aiVector3D to XMFLOAT3
-
-      Returns:  XMFLOAT3
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    XMFLOAT3 ConvertVector3dToFloat3(_In_ const aiVector3D& vector)
-    {
-        return XMFLOAT3(vector.x, vector.y, vector.z);
-    }
-
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   ConvertQuaternionToVector
-
-      Summary:  Convert aiQuaternion to XMVECTOR
-
-      Returns:  XMVECTOR
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    XMVECTOR ConvertQuaternionToVector(_In_ const aiQuaternion& quaternion)
-    {
-        XMFLOAT4 float4 = XMFLOAT4(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
-        return XMLoadFloat4(&float4);
-    }
-
     std::unique_ptr<Assimp::Importer> Model::sm_pImporter = std::make_unique<Assimp::Importer>();
+    std::unordered_map<std::wstring, Model::SharedAnimations> Model::sm_sharedAnimations;
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Model
@@ -70,17 +51,25 @@ namespace library
       Args:     const std::filesystem::path& filePath
                   Path to the model to load
 
-      Modifies: [m_filePath, m_animationBuffer, m_skinningConstantBuffer,
-                 m_skinningConstantBuffer, m_aVertices, m_aAnimationData,
+      Modifies: [m_filePath, m_animationBuffer, m_bonePaletteBuffer,
+                 m_bonePaletteView, m_aVertices, m_aAnimationData,
                  m_aIndices, m_aBoneData, m_aBoneInfo, m_aTransforms,
                  m_aBoneInfo, m_aTransforms, m_boneNameToIndexMap,
-                 m_pScene, m_timeSinceLoaded, m_globalInverseTransform].
+                 m_aAnimationClips, m_aAnimationClipStatistics,
+                 m_aTrackTranslations, m_aTrackRotations,
+                 m_aTrackScales, m_skeleton, m_aNodeTracks,
+                 m_aGlobalTransforms, m_aReferencePoses,
+                 m_aAnimationLayers, m_pose, m_layerPose, m_animationLod,
+                 m_uFramesSinceEvaluation, m_uUpdatePhase, m_poseCache,
+                 m_bakedAnimation,
+                 m_pScene, m_globalInverseTransform].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Model::Model(_In_ const std::filesystem::path& filePath) :
         Renderable(XMFLOAT4(1.0, 1.0, 1.0, 1.0)),
         m_filePath(filePath),
         m_animationBuffer(nullptr),
-        m_skinningConstantBuffer(nullptr),
+        m_bonePaletteBuffer(nullptr),
+        m_bonePaletteView(nullptr),
         m_aVertices(),
         m_aAnimationData(),
         m_aIndices(),
@@ -88,8 +77,24 @@ namespace library
         m_aBoneInfo(),
         m_aTransforms(),
         m_boneNameToIndexMap(std::unordered_map<std::string, UINT>()),
+        m_aAnimationClips(),
+        m_aAnimationClipStatistics(),
+        m_aTrackTranslations(),
+        m_aTrackRotations(),
+        m_aTrackScales(),
+        m_skeleton(),
+        m_aNodeTracks(),
+        m_aGlobalTransforms(),
+        m_aReferencePoses(),
+        m_aAnimationLayers(),
+        m_pose(),
+        m_layerPose(),
+        m_animationLod(AnimationLodPolicy::FULL_LOD),
+        m_uFramesSinceEvaluation(UINT_MAX),
+        m_uUpdatePhase(0u),
+        m_poseCache(),
+        m_bakedAnimation(),
         m_pScene(),
-        m_timeSinceLoaded(0.0f),
         m_globalInverseTransform()
     {}
 
@@ -104,38 +109,22 @@ namespace library
                   The Direct3D context to set buffers
 
       Modifies: [m_pScene, m_globalInverseTransform, m_animationBuffer,
-                 m_skinningConstantBuffer].
+                 m_bonePaletteBuffer, m_bonePaletteView].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Model::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) {
-        HRESULT hr = S_OK;
-
-        // Create the buffers for the vertices attributes
-
-        m_pScene = sm_pImporter->ReadFile(
-            m_filePath.string().c_str(),
-            ASSIMP_LOAD_FLAGS
-        );
-
-        if (m_pScene)
+        HRESULT hr = loadScene();
+        if (FAILED(hr))
         {
-            XMMATRIX rootNodeTransform = ConvertMatrix(m_pScene->mRootNode->mTransformation);
-            XMVECTOR det = XMMatrixDeterminant(rootNodeTransform);
-            m_globalInverseTransform = XMMatrixInverse(&det, rootNodeTransform);
-            hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
-            if (FAILED(hr))
-                return hr;
+            return hr;
         }
-        else
+
+        // Create the buffers for the vertices attributes
+        hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
+        if (FAILED(hr))
         {
-            hr = E_FAIL;
-            OutputDebugString(L"Error parsing ");
-            OutputDebugString(m_filePath.c_str());
-            OutputDebugString(L": ");
-            OutputDebugStringA(sm_pImporter->GetErrorString());
-            OutputDebugString(L"\n");
             return hr;
         }
 
@@ -164,19 +153,36 @@ namespace library
         }
 
 
-        //create constat buffer
-        D3D11_BUFFER_DESC CBSkinningConstantBd = {
-            .ByteWidth = sizeof(CBSkinning),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0,
-            .MiscFlags = 0,
-            .StructureByteStride = 0
-        };
-        hr = pDevice->CreateBuffer(&CBSkinningConstantBd, nullptr, m_skinningConstantBuffer.GetAddressOf());
-        if (FAILED(hr))
+        // The bone palette only holds the bones of the model, 3 rows of every bone
+        if (!m_aTransforms.empty())
         {
-            return hr;
+            D3D11_BUFFER_DESC bonePaletteBd = {
+                .ByteWidth = static_cast<UINT>(sizeof(PackedBoneTransform) * m_aTransforms.size()),
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+                .CPUAccessFlags = 0,
+                .MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+                .StructureByteStride = sizeof(XMFLOAT4)
+            };
+            hr = pDevice->CreateBuffer(&bonePaletteBd, nullptr, m_bonePaletteBuffer.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC bonePaletteSrvDesc = {
+                .Format = DXGI_FORMAT_UNKNOWN,
+                .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+                .Buffer = {
+                    .FirstElement = 0u,
+                    .NumElements = static_cast<UINT>(m_aTransforms.size() * 3u)
+                }
+            };
+            hr = pDevice->CreateShaderResourceView(m_bonePaletteBuffer.Get(), &bonePaletteSrvDesc, m_bonePaletteView.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
         }
 
 
@@ -186,34 +192,473 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Update
 
-      Summary:  Update bone transformations
+      Summary:  Advances the animation layers and updates the bone
+                transformations from their clips, evaluated over the
+                flattened skeleton. Following the animation level of
+                detail, the bones are only updated once every update
+                interval frames and keep their last transforms between,
+                and a model that is not visible only advances its time.
+                A model is updated at once at its first update and when
+                it becomes visible again, and then continues at its
+                update phase, so the models sharing an interval are not
+                all updated in the same frame. A model playing baked
+                frames only advances its time, the skinning shader reads
+                its bones from the frame of the time
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
 
-      Modifies: [m_aTransforms].
+      Modifies: [m_aAnimationLayers, m_uFramesSinceEvaluation,
+                 m_aTrackTranslations, m_aTrackRotations,
+                 m_aTrackScales, m_pose, m_layerPose,
+                 m_aGlobalTransforms, m_aTransforms].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::Update(_In_ FLOAT deltaTime) {
-        m_timeSinceLoaded += deltaTime;
-
-        if (m_pScene->HasAnimations()) {
-            XMMATRIX identity = XMMatrixIdentity();
-            FLOAT ticksPerSecond =
-                static_cast<FLOAT>(m_pScene->mAnimations[0]->mTicksPerSecond
-                    != 0.0 ? m_pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
-            FLOAT timeInTicks = m_timeSinceLoaded * ticksPerSecond;
-            FLOAT animationTimeTicks = fmod(timeInTicks,
-                static_cast<FLOAT>(m_pScene->mAnimations[0]->mDuration));
-
-            if (m_pScene->mRootNode) {
-                readNodeHierarchy(animationTimeTicks, m_pScene->mRootNode, identity);
-                m_aTransforms.resize(m_aBoneInfo.size());
-                for (UINT i = 0; i < m_aTransforms.size(); i++)
-                {
-                    m_aTransforms[i] = m_aBoneInfo[i].FinalTransformation;
-                }
+        PROFILE_SCOPE("Model", "Update");
+
+        if (!m_aAnimationClips.empty()) {
+            advanceAnimations(deltaTime);
+
+            m_uFramesSinceEvaluation = m_uFramesSinceEvaluation < UINT_MAX ? m_uFramesSinceEvaluation + 1u : UINT_MAX;
+            if (!m_bakedAnimation && m_animationLod.bVisible && m_uFramesSinceEvaluation >= m_animationLod.uUpdateInterval)
+            {
+                // An update later than the interval, such as the first one, restarts the interval at the phase
+                m_uFramesSinceEvaluation = m_uFramesSinceEvaluation > m_animationLod.uUpdateInterval && m_animationLod.uUpdateInterval > 1u ?
+                    m_uUpdatePhase % m_animationLod.uUpdateInterval : 0u;
+                updateAnimations();
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::PlayAnimation
+
+      Summary:  Starts playing a clip on a layer, reusing the slot of a
+                stopped layer
+
+      Args:     const AnimationLayerDesc& desc
+                  Clip, time, speed, weight, looping and blending of
+                  the layer
+
+      Modifies: [m_aAnimationLayers].
+
+      Returns:  UINT
+                  Index of the layer, valid until the layer stops
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::PlayAnimation(_In_ const AnimationLayerDesc& desc)
+    {
+        assert(desc.uClip < m_aAnimationClips.size());
+
+        AnimationLayer layer =
+        {
+            .desc = desc,
+            .fadeTarget = desc.weight,
+            .fadeRate = 0.0f,
+            .bActive = TRUE
+        };
+        for (UINT uLayer = 0u; uLayer < m_aAnimationLayers.size(); ++uLayer)
+        {
+            if (!m_aAnimationLayers[uLayer].bActive)
+            {
+                m_aAnimationLayers[uLayer] = layer;
+                return uLayer;
             }
         }
+
+        m_aAnimationLayers.push_back(layer);
+        return static_cast<UINT>(m_aAnimationLayers.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::CrossfadeAnimation
+
+      Summary:  Fades a layer out and stops it, while a new layer fades
+                in from no weight to the weight of its description
+
+      Args:     UINT uLayer
+                  Index of the layer to fade out
+                const AnimationLayerDesc& desc
+                  Layer to fade in
+                FLOAT fadeDuration
+                  Length of the crossfade in seconds
+
+      Modifies: [m_aAnimationLayers].
+
+      Returns:  UINT
+                  Index of the new layer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::CrossfadeAnimation(_In_ UINT uLayer, _In_ const AnimationLayerDesc& desc, _In_ FLOAT fadeDuration)
+    {
+        FadeAnimation(uLayer, 0.0f, fadeDuration);
+
+        AnimationLayerDesc fadeInDesc = desc;
+        fadeInDesc.weight = 0.0f;
+        UINT uNewLayer = PlayAnimation(fadeInDesc);
+        FadeAnimation(uNewLayer, desc.weight, fadeDuration);
+
+        return uNewLayer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::FadeAnimation
+
+      Summary:  Moves the weight of a layer linearly to a target over a
+                duration. A layer faded to no weight stops
+
+      Args:     UINT uLayer
+                  Index of the layer
+                FLOAT targetWeight
+                  Weight at the end of the fade
+                FLOAT fadeDuration
+                  Length of the fade in seconds, 0 to set the weight
+
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::FadeAnimation(_In_ UINT uLayer, _In_ FLOAT targetWeight, _In_ FLOAT fadeDuration)
+    {
+        assert(IsAnimationPlaying(uLayer));
+
+        AnimationLayer& layer = m_aAnimationLayers[uLayer];
+        layer.fadeTarget = targetWeight;
+        if (fadeDuration > 0.0f && layer.desc.weight != targetWeight)
+        {
+            layer.fadeRate = std::fabs(targetWeight - layer.desc.weight) / fadeDuration;
+        }
+        else
+        {
+            layer.desc.weight = targetWeight;
+            layer.fadeRate = 0.0f;
+            layer.bActive = targetWeight > 0.0f;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::StopAnimation
+
+      Summary:  Stops a layer, its slot is reused by the next layer
+
+      Args:     UINT uLayer
+                  Index of the layer
+
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::StopAnimation(_In_ UINT uLayer)
+    {
+        assert(uLayer < m_aAnimationLayers.size());
+
+        m_aAnimationLayers[uLayer].bActive = FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetAnimationTime
+
+      Summary:  Sets the time of a layer
+
+      Args:     UINT uLayer
+                  Index of the layer
+                FLOAT time
+                  Time in the clip in seconds
+
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetAnimationTime(_In_ UINT uLayer, _In_ FLOAT time)
+    {
+        assert(IsAnimationPlaying(uLayer));
+
+        m_aAnimationLayers[uLayer].desc.time = time;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetAnimationSpeed
+
+      Summary:  Sets the speed of a layer
+
+      Args:     UINT uLayer
+                  Index of the layer
+                FLOAT speed
+                  Seconds of the clip played in a second, negative to
+                  play backward
+
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetAnimationSpeed(_In_ UINT uLayer, _In_ FLOAT speed)
+    {
+        assert(IsAnimationPlaying(uLayer));
+
+        m_aAnimationLayers[uLayer].desc.speed = speed;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetAnimationWeight
+
+      Summary:  Sets the weight of a layer, ending its fade
+
+      Args:     UINT uLayer
+                  Index of the layer
+                FLOAT weight
+                  Weight of the layer
+
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetAnimationWeight(_In_ UINT uLayer, _In_ FLOAT weight)
+    {
+        assert(IsAnimationPlaying(uLayer));
+
+        AnimationLayer& layer = m_aAnimationLayers[uLayer];
+        layer.desc.weight = weight;
+        layer.fadeTarget = weight;
+        layer.fadeRate = 0.0f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetAnimationLayer
+
+      Summary:  Returns the description of a layer, with its current
+                time and weight
+
+      Args:     UINT uLayer
+                  Index of the layer
+
+      Returns:  const AnimationLayerDesc&
+                  Description of the layer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationLayerDesc& Model::GetAnimationLayer(_In_ UINT uLayer) const
+    {
+        assert(uLayer < m_aAnimationLayers.size());
+
+        return m_aAnimationLayers[uLayer].desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::IsAnimationPlaying
+
+      Summary:  Returns whether a layer is playing
+
+      Args:     UINT uLayer
+                  Index of the layer
+
+      Returns:  BOOL
+                  Whether the layer is playing
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Model::IsAnimationPlaying(_In_ UINT uLayer) const
+    {
+        return uLayer < m_aAnimationLayers.size() && m_aAnimationLayers[uLayer].bActive;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetNumAnimations
+
+      Summary:  Returns the number of clips of the model
+
+      Returns:  UINT
+                  Number of clips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::GetNumAnimations() const
+    {
+        return static_cast<UINT>(m_aAnimationClips.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetAnimationClipStatistics
+
+      Summary:  Returns the size and the error of a clip, measured when
+                it was read from the model file
+
+      Args:     UINT uClip
+                  Index of the clip
+
+      Returns:  const AnimationClipStatistics&
+                  Statistics of the clip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationClipStatistics& Model::GetAnimationClipStatistics(_In_ UINT uClip) const
+    {
+        assert(uClip < m_aAnimationClipStatistics.size());
+        return m_aAnimationClipStatistics[uClip];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetAnimationLod
+
+      Summary:  Sets how often the bones are updated, how many levels
+                of leaf nodes keep their bind transform, and whether
+                the model is visible
+
+      Args:     const AnimationLod& lod
+                  Animation level of detail, from AnimationLodPolicy
+
+      Modifies: [m_animationLod].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetAnimationLod(_In_ const AnimationLod& lod)
+    {
+        m_animationLod = lod;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetUpdatePhase
+
+      Summary:  Sets the frame within the update interval the bones are
+                updated in, so models with different phases spread
+                their updates over the frames of the interval
+
+      Args:     UINT uPhase
+                  Update phase, such as the index of the model
+
+      Modifies: [m_uUpdatePhase].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetUpdatePhase(_In_ UINT uPhase)
+    {
+        m_uUpdatePhase = uPhase;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetAnimationLod
+
+      Summary:  Returns the animation level of detail
+
+      Returns:  const AnimationLod&
+                  Animation level of detail
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationLod& Model::GetAnimationLod() const
+    {
+        return m_animationLod;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetPoseCache
+
+      Summary:  Sets the cache sharing the bone transforms of the models
+                playing a single base layer, set by the scene the model
+                is added to. While the cache is enabled, the clip is
+                sampled at the time of the nearest step of the cache
+
+      Args:     const std::shared_ptr<PoseCache>& poseCache
+                  Pose cache, nullptr to evaluate every pose
+
+      Modifies: [m_poseCache].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetPoseCache(_In_ const std::shared_ptr<PoseCache>& poseCache)
+    {
+        m_poseCache = poseCache;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::BakeAnimations
+
+      Summary:  Bakes every clip of the model into frames of bone
+                transforms and plays them from the frames. The models
+                of the same file sharing the skeleton share the frames
+                baked at the same rate, so a crowd bakes and uploads
+                them once. The frames are drawn with a baked skinning
+                vertex shader
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer of the
+                  frames, nullptr to only bake them
+                FLOAT framesPerSecond
+                  Sampling rate of the clips
+
+      Modifies: [m_bakedAnimation].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the model is not animated
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::BakeAnimations(_In_opt_ ID3D11Device* pDevice, _In_ FLOAT framesPerSecond)
+    {
+        if (m_aAnimationClips.empty())
+        {
+            return E_FAIL;
+        }
+
+        SharedAnimations& shared = sm_sharedAnimations[m_filePath.wstring()];
+        std::shared_ptr<BakedAnimation> bakedAnimation = shared.bakedAnimation.lock();
+        BOOL bShared = shared.skeleton.lock() == m_skeleton;
+        if (!bShared || !bakedAnimation || bakedAnimation->GetFramesPerSecond() != framesPerSecond)
+        {
+            PROFILE_SCOPE("Model", "BakeAnimations");
+            bakedAnimation = std::make_shared<BakedAnimation>(framesPerSecond);
+            bakedAnimation->Bake(*m_skeleton, m_aAnimationClips, m_aNodeTracks, m_globalInverseTransform);
+            if (bShared)
+            {
+                shared.bakedAnimation = bakedAnimation;
+            }
+        }
+
+        if (pDevice)
+        {
+            HRESULT hr = bakedAnimation->Initialize(pDevice);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        SetBakedAnimation(bakedAnimation);
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetBakedAnimation
+
+      Summary:  Plays the clips from frames baked for the skeleton of
+                the model, or evaluates the skeleton again
+
+      Args:     const std::shared_ptr<BakedAnimation>& bakedAnimation
+                  Frames of the clips of the model, nullptr to evaluate
+                  the skeleton
+
+      Modifies: [m_bakedAnimation, m_uFramesSinceEvaluation].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetBakedAnimation(_In_ const std::shared_ptr<BakedAnimation>& bakedAnimation)
+    {
+        assert(!bakedAnimation || (bakedAnimation->GetNumClips() == m_aAnimationClips.size() && bakedAnimation->GetNumBones() == m_aTransforms.size()));
+
+        m_bakedAnimation = bakedAnimation;
+
+        // The bone transforms are stale after playing baked frames, so they are evaluated at the next update
+        m_uFramesSinceEvaluation = UINT_MAX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetBakedAnimation
+
+      Summary:  Returns the baked frames the model plays
+
+      Returns:  const std::shared_ptr<BakedAnimation>&
+                  Frames, nullptr when the skeleton is evaluated
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::shared_ptr<BakedAnimation>& Model::GetBakedAnimation() const
+    {
+        return m_bakedAnimation;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetBakedFrameOffset
+
+      Summary:  Returns the offset of the first bone of the baked frame
+                nearest to the time of the base layer with the most
+                weight, the only integer written for the model when its
+                crowd is drawn. Baked frames do not blend, the other
+                layers are ignored, and without a base layer the first
+                frame of the first clip is played
+
+      Returns:  UINT
+                  Index of the transform in the baked transforms
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::GetBakedFrameOffset() const
+    {
+        assert(m_bakedAnimation);
+
+        const AnimationLayer* pBaseLayer = nullptr;
+        for (const AnimationLayer& layer : m_aAnimationLayers)
+        {
+            if (layer.bActive && !layer.desc.bAdditive && layer.desc.weight > 0.0f && (!pBaseLayer || layer.desc.weight > pBaseLayer->desc.weight))
+            {
+                pBaseLayer = &layer;
+            }
+        }
+
+        UINT uFrame = pBaseLayer ? m_bakedAnimation->GetFrame(pBaseLayer->desc.uClip, pBaseLayer->desc.time) : m_bakedAnimation->GetFrame(0u, 0.0f);
+        return m_bakedAnimation->GetFrameOffset(uFrame);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -230,16 +675,31 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::GetSkinningConstantBuffer
+      Method:   Model::GetBonePaletteBuffer
 
-      Summary:  Returns the skinning constant buffer
+      Summary:  Returns the structured buffer of the bone palette, sized
+                to the bones of the model
 
       Returns:  ComPtr<ID3D11Buffer>&
+                  Buffer, nullptr for a model without bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11Buffer>& Model::GetBonePaletteBuffer()
+    {
+        return m_bonePaletteBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetBonePaletteView
+
+      Summary:  Returns the view of the bone palette the skinning shader
+                reads
 
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  View, nullptr for a model without bones
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11Buffer>& Model::GetSkinningConstantBuffer()
+    ComPtr<ID3D11ShaderResourceView>& Model::GetBonePaletteView()
     {
-        return m_skinningConstantBuffer;
+        return m_bonePaletteView;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -281,6 +741,43 @@ namespace library
         return m_aTransforms;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::FillBonePalette
+
+      Summary:  Writes the bone transforms of the last update into the
+                bone palette as the first 3 rows of their transpose.
+                The bone transforms are affine, so the last row of the
+                transpose is always (0, 0, 0, 1) and is left out. Only
+                the bones of the model are written, the palette is
+                uploaded up to them
+
+      Args:     PackedBoneTransform* aBonePalette
+                  Bone palette of at least the bones of the model
+
+      Returns:  UINT
+                  Number of bones written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::FillBonePalette(_Out_writes_to_(MAX_NUM_BONES, return) PackedBoneTransform* aBonePalette) const
+    {
+        assert(m_aTransforms.size() <= MAX_NUM_BONES);
+
+        for (size_t i = 0u; i < m_aTransforms.size(); ++i)
+        {
+            // The columns of the bone transform are gathered from the pairs of its rows
+            const XMMATRIX& transform = m_aTransforms[i];
+            XMVECTOR xy01 = XMVectorMergeXY(transform.r[0], transform.r[1]);
+            XMVECTOR xy23 = XMVectorMergeXY(transform.r[2], transform.r[3]);
+            XMVECTOR zw01 = XMVectorMergeZW(transform.r[0], transform.r[1]);
+            XMVECTOR zw23 = XMVectorMergeZW(transform.r[2], transform.r[3]);
+
+            XMStoreFloat4A(&aBonePalette[i].Rows[0], XMVectorPermute<XM_PERMUTE_0X, XM_PERMUTE_0Y, XM_PERMUTE_1X, XM_PERMUTE_1Y>(xy01, xy23));
+            XMStoreFloat4A(&aBonePalette[i].Rows[1], XMVectorPermute<XM_PERMUTE_0Z, XM_PERMUTE_0W, XM_PERMUTE_1Z, XM_PERMUTE_1W>(xy01, xy23));
+            XMStoreFloat4A(&aBonePalette[i].Rows[2], XMVectorPermute<XM_PERMUTE_0X, XM_PERMUTE_0Y, XM_PERMUTE_1X, XM_PERMUTE_1Y>(zw01, zw23));
+        }
+
+        return static_cast<UINT>(m_aTransforms.size());
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
         Method:   Model::GetBoneNameToIndexMap
 
@@ -295,146 +792,185 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::countVerticesAndIndices
-
-        Summary:  Fill the BasicMeshEntry information
+      Method:   Model::GetFilePath
 
-        Args:     UINT& uOutNumVertices
-                    Total number of vertices
-                  UINT& uOutNumIndices
-                    Total number of indices
-                  const aiScene* pScene
-                    Pointer to an assimp scene object that contains the
-                    mesh information
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene) {
-        for (UINT i = 0u; i < pScene->mNumMeshes; i++)
-        {
-            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
-            m_aMeshes[i].uBaseIndex = uOutNumIndices;
-            m_aMeshes[i].uBaseVertex = uOutNumVertices;
-            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
+      Summary:  Returns the path of the model file
 
-            uOutNumIndices += pScene->mMeshes[i]->mNumFaces * 3u;
-            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
-        }
+      Returns:  const std::filesystem::path&
+                  Path of the model file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::filesystem::path& Model::GetFilePath() const
+    {
+        return m_filePath;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findNodeAnimOrNull
+      Method:   Model::IsSkinned
 
-        Summary:  Find the aiNodeAnim with the givne node name in the given animation
+      Summary:  Returns whether the model has bones, skinned models have
+                their own bone transforms and cannot share a draw
 
-        Args:     const aiAnimation* pAnimation
-                    Pointer to an assimp animation object
-                  PCSTR pszNodeName
-                    Node name to find
-
-        Returns:  aiNodeAnim* or nullptr
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    const aiNodeAnim* Model::findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName)
+      Returns:  BOOL
+                  Whether the model has bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Model::IsSkinned() const
     {
-        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
-        {
-            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
-
-            if (strncmp(pNodeAnim->mNodeName.data, pszNodeName, pNodeAnim->mNodeName.length) == 0)
-            {
-                return pNodeAnim;
-            }
-        }
-
-        return nullptr;
+        return !m_aBoneInfo.empty();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findPosition
-
-        Summary:  Find the index of the position key right before the given animation time
-
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
-
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+      Method:   Model::addAnimation
+
+      Summary:  Resamples an assimp animation into a clip, so a frame
+                samples the clip instead of searching the keys, maps
+                the nodes of the skeleton to the tracks of the clip,
+                and compresses the clip within the error budget. Keeps
+                the first sample of the clip as the reference of the
+                additive layers playing it. Records the size and the
+                error of the resampled and of the compressed clip, and
+                how much smaller the compressed clip is than the assimp
+                keys, for GetAnimationClipStatistics
+
+      Args:     const aiAnimation* pAnimation
+                  Assimp animation
+
+      Modifies: [m_aAnimationClips, m_aAnimationClipStatistics,
+                 m_aNodeTracks, m_aReferencePoses,
+                 m_aTrackTranslations, m_aTrackRotations, m_aTrackScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::addAnimation(_In_ const aiAnimation* pAnimation)
     {
-        assert(pNodeAnim->mNumPositionKeys > 0);
+        AnimationClip clip(pAnimation, ANIMATION_SAMPLES_PER_SECOND);
+        std::shared_ptr<CompressedAnimationClip> compressedClip = std::make_shared<CompressedAnimationClip>(clip, *m_skeleton, ANIMATION_ERROR_BUDGET);
 
-        for (UINT i = 0; i < pNodeAnim->mNumPositionKeys - 1; ++i)
+        size_t uKeysSize = 0u;
+        for (UINT j = 0u; j < pAnimation->mNumChannels; ++j)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mPositionKeys[i + 1].mTime);
+            const aiNodeAnim* pChannel = pAnimation->mChannels[j];
+            uKeysSize += (pChannel->mNumPositionKeys + pChannel->mNumScalingKeys) * sizeof(aiVectorKey) + pChannel->mNumRotationKeys * sizeof(aiQuatKey);
+        }
 
-            if (animationTimeTicks < t)
+        m_aAnimationClipStatistics.push_back(
+            AnimationClipStatistics
             {
-                return i;
+                .uNumTracks = clip.GetNumTracks(),
+                .uNumSamples = clip.GetNumSamples(),
+                .uResampledSizeInBytes = clip.GetSizeInBytes(),
+                .maxResampledTranslationError = clip.GetMaxTranslationError(),
+                .maxResampledRotationError = clip.GetMaxRotationError(),
+                .maxResampledScalingError = clip.GetMaxScalingError(),
+                .uNumKeys = compressedClip->GetNumKeys(),
+                .uCompressedSizeInBytes = compressedClip->GetSizeInBytes(),
+                .uKeysSizeInBytes = uKeysSize,
+                .compressionRatio = static_cast<FLOAT>(uKeysSize) / static_cast<FLOAT>(compressedClip->GetSizeInBytes()),
+                .maxTranslationError = compressedClip->GetMaxTranslationError(),
+                .maxRotationError = compressedClip->GetMaxRotationError(),
+                .maxScalingError = compressedClip->GetMaxScalingError(),
+                .maxPositionError = compressedClip->GetMaxPositionError()
             }
+        );
+
+        m_aAnimationClips.push_back(compressedClip);
+        m_aNodeTracks.emplace_back();
+        m_skeleton->MapTracks(clip, m_aNodeTracks.back());
+
+        // The tracks of every clip are sampled into the same buffers
+        if (compressedClip->GetNumTracks() > m_aTrackTranslations.size())
+        {
+            m_aTrackTranslations.resize(compressedClip->GetNumTracks());
+            m_aTrackRotations.resize(compressedClip->GetNumTracks());
+            m_aTrackScales.resize(compressedClip->GetNumTracks());
         }
 
-        return 0u;
+        std::shared_ptr<Pose> referencePose = std::make_shared<Pose>();
+        referencePose->Resize(m_skeleton->GetNumNodes());
+        compressedClip->Sample(0.0f, m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data());
+        referencePose->SetTracks(*m_skeleton, m_aNodeTracks.back().data(), m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data());
+        m_aReferencePoses.push_back(referencePose);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findRotation
+      Method:   Model::advanceAnimations
 
-        Summary:  Find the index of the rotation key right before the given animation time
+      Summary:  Advances the time of every layer by its speed, wrapping
+                it around its clip when the layer loops and clamping it
+                to the clip otherwise, and moves the weight of every
+                fading layer toward its target. A layer faded to no
+                weight stops
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+      Modifies: [m_aAnimationLayers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::advanceAnimations(_In_ FLOAT deltaTime)
     {
-        assert(pNodeAnim->mNumRotationKeys > 0);
-
-        for (UINT i = 0u; i < pNodeAnim->mNumRotationKeys - 1; ++i)
+        for (AnimationLayer& layer : m_aAnimationLayers)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mRotationKeys[i + 1].mTime);
+            if (!layer.bActive)
+            {
+                continue;
+            }
 
-            if (animationTimeTicks < t)
+            const CompressedAnimationClip& clip = *m_aAnimationClips[layer.desc.uClip];
+            FLOAT duration = clip.GetDuration() / clip.GetTicksPerSecond();
+            FLOAT time = layer.desc.time + deltaTime * layer.desc.speed;
+            if (duration <= 0.0f)
             {
-                return i;
+                time = 0.0f;
             }
-        }
+            else if (layer.desc.bLoop)
+            {
+                time = std::fmod(time, duration);
+                time = time < 0.0f ? time + duration : time;
+            }
+            else
+            {
+                time = time < 0.0f ? 0.0f : time > duration ? duration : time;
+            }
+            layer.desc.time = time;
 
-        return 0u;
+            if (layer.fadeRate > 0.0f)
+            {
+                FLOAT step = layer.fadeRate * deltaTime;
+                if (std::fabs(layer.fadeTarget - layer.desc.weight) <= step)
+                {
+                    layer.desc.weight = layer.fadeTarget;
+                    layer.fadeRate = 0.0f;
+                    layer.bActive = layer.fadeTarget > 0.0f;
+                }
+                else
+                {
+                    layer.desc.weight += layer.fadeTarget > layer.desc.weight ? step : -step;
+                }
+            }
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findScaling
-
-        Summary:  Find the index of the scaling key right before the given animation time
+        Method:   Model::countVerticesAndIndices
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+        Summary:  Fill the BasicMeshEntry information
 
-        Returns:  UINT
-                    Index of the key
+        Args:     UINT& uOutNumVertices
+                    Total number of vertices
+                  UINT& uOutNumIndices
+                    Total number of indices
+                  const aiScene* pScene
+                    Pointer to an assimp scene object that contains the
+                    mesh information
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
-    {
-        assert(pNodeAnim->mNumScalingKeys > 0);
-
-        for (UINT i = 0u; i < pNodeAnim->mNumScalingKeys - 1; ++i)
+    void Model::countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene) {
+        for (UINT i = 0u; i < pScene->mNumMeshes; i++)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mScalingKeys[i + 1].mTime);
+            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
+            m_aMeshes[i].uBaseIndex = uOutNumIndices;
+            m_aMeshes[i].uBaseVertex = uOutNumVertices;
+            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
 
-            if (animationTimeTicks < t)
-            {
-                return i;
-            }
+            uOutNumIndices += pScene->mMeshes[i]->mNumFaces * 3u;
+            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
         }
-
-        return 0u;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -511,6 +1047,51 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initAnimations
+
+      Summary:  Adds a clip for every animation of a given assimp
+                scene and plays the first one looping on the first
+                layer
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+
+      Modifies: [m_aAnimationClips, m_aAnimationClipStatistics,
+                 m_aNodeTracks, m_aReferencePoses, m_aAnimationLayers,
+                 m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+                 m_pose, m_layerPose].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initAnimations(_In_ const aiScene* pScene)
+    {
+        m_aAnimationClips.clear();
+        m_aAnimationClipStatistics.clear();
+        m_aNodeTracks.clear();
+        m_aReferencePoses.clear();
+        m_aAnimationLayers.clear();
+        m_pose.Resize(m_skeleton->GetNumNodes());
+        m_layerPose.Resize(m_skeleton->GetNumNodes());
+        for (UINT i = 0u; i < pScene->mNumAnimations; ++i)
+        {
+            addAnimation(pScene->mAnimations[i]);
+        }
+
+        if (!m_aAnimationClips.empty())
+        {
+            PlayAnimation(
+                AnimationLayerDesc
+                {
+                    .uClip = 0u,
+                    .time = 0.0f,
+                    .speed = 1.0f,
+                    .weight = 1.0f,
+                    .bLoop = TRUE,
+                    .bAdditive = FALSE
+                }
+            );
+        }
+    }
+
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initFromScene
@@ -538,16 +1119,10 @@ namespace library
     {
         HRESULT hr = S_OK;
 
-        m_aMeshes.resize(pScene->mNumMeshes);
-
-        UINT uNumVertices = 0u;
-        UINT uNumIndices = 0u;
-
-        countVerticesAndIndices(uNumVertices, uNumIndices, pScene);
-
-        reserveSpace(uNumVertices, uNumIndices);
-
-        initAllMeshes(pScene);
+        initGeometry(pScene);
+        initSkeleton(pScene);
+        initAnimations(pScene);
+        shareAnimations(filePath);
 
         hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
         if (FAILED(hr))
@@ -555,17 +1130,6 @@ namespace library
             return hr;
         }
 
-        for (size_t i = 0; i < m_aVertices.size(); ++i)
-        {
-            m_aAnimationData.push_back(
-                AnimationData
-                {
-                    .aBoneIndices = XMUINT4(m_aBoneData.at(i).aBoneIds),
-                    .aBoneWeights = XMFLOAT4(m_aBoneData.at(i).aWeights)
-                }
-            );
-        }
-
         hr = initialize(pDevice, pImmediateContext);
         if (FAILED(hr))
         {
@@ -576,6 +1140,37 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initGeometry
+
+      Summary:  Reads the vertices, indices, bones and skinning data of
+                every mesh of an assimp scene, without touching Direct3D
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+
+      Modifies: [m_aMeshes, m_aVertices, m_aIndices, m_aBoneData,
+                 m_aBoneInfo, m_boneNameToIndexMap, m_aAnimationData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initGeometry(_In_ const aiScene* pScene)
+    {
+        m_aMeshes.resize(pScene->mNumMeshes);
+
+        UINT uNumVertices = 0u;
+        UINT uNumIndices = 0u;
+
+        countVerticesAndIndices(uNumVertices, uNumIndices, pScene);
+
+        reserveSpace(uNumVertices, uNumIndices);
+
+        initAllMeshes(pScene);
+
+        for (size_t i = 0; i < m_aVertices.size(); ++i)
+        {
+            m_aAnimationData.push_back(quantizeBoneData(m_aBoneData.at(i)));
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initMaterials
 
@@ -710,114 +1305,58 @@ namespace library
         }
         initMeshBones(uMeshIndex, pMesh);
     }
-    
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolatePosition
-
-      Summary:  Interpolate two keyframes to find translate vector
-
-      Args:     XMFLOAT3& outTranslate
-                  Translate vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
-    {
-        if (pNodeAnim->mNumPositionKeys == 1)
-        {
-            outTranslate = ConvertVector3dToFloat3(pNodeAnim->mPositionKeys[0].mValue);
-            return;
-        }
-
-        UINT uPositionIndex = findPosition(animationTimeTicks, pNodeAnim);
-        UINT uNextPositionIndex = uPositionIndex + 1u;
-        assert(uNextPositionIndex < pNodeAnim->mNumPositionKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uPositionIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uNextPositionIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mPositionKeys[uPositionIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mPositionKeys[uNextPositionIndex].mValue;
-        aiVector3D delta = end - start;
-        outTranslate = ConvertVector3dToFloat3(start + factor * delta);
-    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateRotation
+      Method:   Model::initSkeleton
 
-      Summary:  Interpolate two keyframes to find rotation vector
+      Summary:  Flattens the node hierarchy of a given assimp scene into
+                a skeleton, parents before children, and looks up the
+                bone of every node once, so a frame walks arrays instead
+                of the nodes and the names
+
+      Args:     const aiScene* pScene
+                  Assimp scene
 
-      Args:     XMVECTOR& outQuaternion
-                  Quaternion vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+      Modifies: [m_skeleton, m_aGlobalTransforms, m_aTransforms].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    void Model::initSkeleton(_In_ const aiScene* pScene)
     {
-        if (pNodeAnim->mNumPositionKeys == 1)
+        m_skeleton = std::make_shared<Skeleton>();
+
+        std::vector<std::pair<const aiNode*, UINT>> aStack;
+        if (pScene->mRootNode)
         {
-            outQuaternion = ConvertQuaternionToVector(pNodeAnim->mRotationKeys[0].mValue);
-            return;
+            aStack.push_back(std::make_pair(pScene->mRootNode, Skeleton::INVALID_INDEX));
         }
+        while (!aStack.empty())
+        {
+            const aiNode* pNode = aStack.back().first;
+            UINT uParent = aStack.back().second;
+            aStack.pop_back();
+
+            UINT uBone = Skeleton::INVALID_INDEX;
+            XMMATRIX boneOffset = XMMatrixIdentity();
+            auto it_bone = m_boneNameToIndexMap.find(pNode->mName.C_Str());
+            if (it_bone != m_boneNameToIndexMap.end())
+            {
+                uBone = it_bone->second;
+                boneOffset = m_aBoneInfo[uBone].OffsetMatrix;
+            }
 
-        UINT uRotationIndex = findRotation(animationTimeTicks, pNodeAnim);
-        UINT uNextRotationIndex = uRotationIndex + 1u;
-        assert(uNextRotationIndex < pNodeAnim->mNumRotationKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uRotationIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uNextRotationIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiQuaternion& start = pNodeAnim->mRotationKeys[uRotationIndex].mValue;
-        const aiQuaternion& end = pNodeAnim->mRotationKeys[uNextRotationIndex].mValue;
-        aiQuaternion temp;
-        aiQuaternion::Interpolate(temp, start, end, factor);
-        temp.Normalize();
-        outQuaternion = ConvertQuaternionToVector(temp);
-    }
-
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateScaling
-
-      Summary:  Interpolate two keyframes to find scaling vector
+            UINT uNode = m_skeleton->AddNode(pNode->mName.C_Str(), uParent, ConvertMatrix(pNode->mTransformation), uBone, boneOffset);
 
-      Args:     XMFLOAT3& outScale
-                  Scaling vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim) {
-        if (pNodeAnim->mNumScalingKeys == 1)
-        {
-            outScale = ConvertVector3dToFloat3(pNodeAnim->mScalingKeys[0].mValue);
-            return;
+            // Pushed in reverse, so the children are added in their order
+            for (UINT i = pNode->mNumChildren; i > 0u; --i)
+            {
+                aStack.push_back(std::make_pair(pNode->mChildren[i - 1u], uNode));
+            }
         }
 
-        UINT uScalingIndex = findScaling(animationTimeTicks, pNodeAnim);
-        UINT uNextScalingIndex = uScalingIndex + 1u;
-        assert(uNextScalingIndex < pNodeAnim->mNumScalingKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uScalingIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uNextScalingIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mScalingKeys[uScalingIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mScalingKeys[uNextScalingIndex].mValue;
-        aiVector3D delta = end - start;
-        outScale = ConvertVector3dToFloat3(start + factor * delta);
+        assert(m_skeleton->GetNumBones() <= m_aBoneInfo.size());
+        m_aGlobalTransforms.resize(m_skeleton->GetNumNodes());
+        m_aTransforms.assign(m_aBoneInfo.size(), XMMatrixIdentity());
     }
-
-
+    
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::loadDiffuseTexture
 
@@ -882,6 +1421,40 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadScene
+
+      Summary:  Reads the model file into an assimp scene
+
+      Modifies: [m_pScene, m_globalInverseTransform].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the file can not be parsed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::loadScene()
+    {
+        m_pScene = sm_pImporter->ReadFile(
+            m_filePath.string().c_str(),
+            ASSIMP_LOAD_FLAGS
+        );
+
+        if (!m_pScene)
+        {
+            OutputDebugString(L"Error parsing ");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L": ");
+            OutputDebugStringA(sm_pImporter->GetErrorString());
+            OutputDebugString(L"\n");
+            return E_FAIL;
+        }
+
+        XMMATRIX rootNodeTransform = ConvertMatrix(m_pScene->mRootNode->mTransformation);
+        XMVECTOR det = XMMatrixDeterminant(rootNodeTransform);
+        m_globalInverseTransform = XMMatrixInverse(&det, rootNodeTransform);
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
        Method:   Model::loadSpecularTexture
 
@@ -1043,48 +1616,49 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::readNodeHierarchy
-
-      Summary:  Calculate bone transformation of the given assimp node
-
-      Args:     FLOAT animationTimeTicks
-                  Animation time
-               const aiNode* pNode
-                  Pointer to an assimp node object
-                const XMMATRIX& parentTransform
-                  Parent transform in hierarchy
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform) {
-        const aiNodeAnim* pNodeAnim = findNodeAnimOrNull(m_pScene->mAnimations[0], pNode->mName.C_Str());
-        XMMATRIX nodeTransformation = ConvertMatrix(pNode->mTransformation);
-        if (pNodeAnim) {
-            XMFLOAT3 scalingMatrixFloat;
-            interpolateScaling(scalingMatrixFloat, animationTimeTicks, pNodeAnim);
-            XMMATRIX scalingMatrix = XMMatrixScaling(scalingMatrixFloat.x, scalingMatrixFloat.y, scalingMatrixFloat.z);
+      Method:   Model::quantizeBoneData
 
-            XMVECTOR rotationVector;
-            interpolateRotation(rotationVector, animationTimeTicks, pNodeAnim);
-            XMMATRIX rotationMatrix = XMMatrixRotationQuaternion(rotationVector);
+      Summary:  Packs the largest bone weights of a vertex kept during
+                the import into 8 bit bone indices and UNORM8 weights.
+                The weights are renormalized so they sum to 1, and the
+                rounding error lands on the largest weight, so the
+                quantized weights sum to exactly 255
 
-            XMFLOAT3 positionMatrixFloat;
-            interpolatePosition(positionMatrixFloat, animationTimeTicks, pNodeAnim);
-            XMMATRIX translationMatrix = XMMatrixTranslation(positionMatrixFloat.x, positionMatrixFloat.y, positionMatrixFloat.z);
+      Args:     const VertexBoneData& boneData
+                  Largest bone weights of the vertex
 
-            nodeTransformation = scalingMatrix * rotationMatrix * translationMatrix;
+      Returns:  AnimationData
+                  Quantized bone indices and weights, all zero for a
+                  vertex without bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationData Model::quantizeBoneData(_In_ const VertexBoneData& boneData)
+    {
+        AnimationData animationData = { .aBoneIndices = { 0u, }, .aBoneWeights = { 0u, } };
 
+        FLOAT totalWeight = 0.0f;
+        for (UINT i = 0u; i < boneData.uNumBones; ++i)
+        {
+            totalWeight += boneData.aWeights[i];
         }
-
-        XMMATRIX globalTransformation = nodeTransformation * parentTransform;
-        auto it_bone = m_boneNameToIndexMap.find(pNode->mName.C_Str());
-        if (it_bone != m_boneNameToIndexMap.end()) {
-            m_aBoneInfo[it_bone->second].FinalTransformation =
-                m_aBoneInfo[it_bone->second].OffsetMatrix * globalTransformation * m_globalInverseTransform;
+        if (totalWeight <= 0.0f)
+        {
+            return animationData;
         }
 
-        for (UINT i = 0; i < pNode->mNumChildren; ++i) {
-            readNodeHierarchy(animationTimeTicks, pNode->mChildren[i], globalTransformation);
+        UINT uLargest = 0u;
+        INT iQuantizedSum = 0;
+        for (UINT i = 0u; i < boneData.uNumBones; ++i)
+        {
+            assert(boneData.aBoneIds[i] < MAX_NUM_BONES);
+
+            animationData.aBoneIndices[i] = static_cast<BYTE>(boneData.aBoneIds[i]);
+            animationData.aBoneWeights[i] = static_cast<BYTE>(boneData.aWeights[i] / totalWeight * 255.0f + 0.5f);
+            iQuantizedSum += animationData.aBoneWeights[i];
+            uLargest = boneData.aWeights[i] > boneData.aWeights[uLargest] ? i : uLargest;
         }
+        animationData.aBoneWeights[uLargest] = static_cast<BYTE>(animationData.aBoneWeights[uLargest] + 255 - iQuantizedSum);
 
+        return animationData;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -1103,4 +1677,200 @@ namespace library
         m_aIndices.reserve(uNumIndices);
         m_aBoneData.resize(uNumVertices);
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::sampleAnimation
+
+      Summary:  Samples the clip of a layer at its time into a pose,
+                through the track buffers
+
+      Args:     const AnimationLayer& layer
+                  Layer to sample
+                Pose& pose
+                  Pose of every node of the skeleton
+
+      Modifies: [m_aTrackTranslations, m_aTrackRotations,
+                 m_aTrackScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::sampleAnimation(_In_ const AnimationLayer& layer, _Inout_ Pose& pose)
+    {
+        const CompressedAnimationClip& clip = *m_aAnimationClips[layer.desc.uClip];
+        clip.Sample(layer.desc.time * clip.GetTicksPerSecond(), m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data());
+        pose.SetTracks(*m_skeleton, m_aNodeTracks[layer.desc.uClip].data(), m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::shareAnimations
+
+      Summary:  Shares the skeleton and the clips of the models loaded
+                from the same file while one of them is alive, so the
+                pose cache finds the poses of the other copies under
+                the same skeleton and clip. The copies hold the same
+                data, the tracks mapped to the nodes stay valid
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the model
+
+      Modifies: [sm_sharedAnimations, m_skeleton, m_aAnimationClips].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::shareAnimations(_In_ const std::filesystem::path& filePath)
+    {
+        if (m_aAnimationClips.empty())
+        {
+            return;
+        }
+
+        SharedAnimations& shared = sm_sharedAnimations[filePath.wstring()];
+        std::shared_ptr<Skeleton> skeleton = shared.skeleton.lock();
+        if (skeleton && shared.aClips.size() == m_aAnimationClips.size())
+        {
+            assert(skeleton->GetNumNodes() == m_skeleton->GetNumNodes());
+
+            std::vector<std::shared_ptr<CompressedAnimationClip>> aClips;
+            for (const std::weak_ptr<CompressedAnimationClip>& clip : shared.aClips)
+            {
+                aClips.push_back(clip.lock());
+            }
+            if (std::find(aClips.begin(), aClips.end(), nullptr) == aClips.end())
+            {
+                m_skeleton = skeleton;
+                m_aAnimationClips = aClips;
+                return;
+            }
+        }
+
+        shared.skeleton = m_skeleton;
+        shared.aClips.assign(m_aAnimationClips.begin(), m_aAnimationClips.end());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::updateAnimations
+
+      Summary:  Updates the bone transformations from the layers with
+                weight. A single base layer evaluates the tracks of its
+                clip over the skeleton directly, or copies the bone
+                transforms another model evaluated for the same clip at
+                the same step of the pose cache, sampling the time of
+                the step when it has to evaluate them. Otherwise the base
+                layers are blended one after another, each by its
+                weight over the sum of the weights so far, which
+                averages them by their weights, starting from the bind
+                pose when there is none, and the additive layers are
+                added on top before the pose is evaluated. The nodes
+                the animation level of detail skips keep their bind
+                transform
+
+      Modifies: [m_aTrackTranslations, m_aTrackRotations,
+                 m_aTrackScales, m_pose, m_layerPose,
+                 m_aGlobalTransforms, m_aTransforms].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::updateAnimations()
+    {
+        UINT uNumBaseLayers = 0u;
+        UINT uBaseLayer = 0u;
+        BOOL bAdditive = FALSE;
+        for (UINT uLayer = 0u; uLayer < m_aAnimationLayers.size(); ++uLayer)
+        {
+            const AnimationLayer& layer = m_aAnimationLayers[uLayer];
+            if (!layer.bActive || layer.desc.weight <= 0.0f)
+            {
+                continue;
+            }
+
+            if (layer.desc.bAdditive)
+            {
+                bAdditive = TRUE;
+            }
+            else
+            {
+                ++uNumBaseLayers;
+                uBaseLayer = uLayer;
+            }
+        }
+
+        if (uNumBaseLayers == 1u && !bAdditive)
+        {
+            const AnimationLayer& layer = m_aAnimationLayers[uBaseLayer];
+            const CompressedAnimationClip& clip = *m_aAnimationClips[layer.desc.uClip];
+            BOOL bCached = m_poseCache && m_poseCache->IsEnabled();
+            PoseCacheKey key = {};
+            FLOAT time = layer.desc.time;
+            if (bCached)
+            {
+                key = { .pSkeleton = m_skeleton.get(), .pClip = &clip, .uTimeStep = m_poseCache->GetTimeStep(time), .uSkippedLevels = m_animationLod.uSkippedLevels };
+                std::shared_ptr<const std::vector<XMMATRIX>> aCachedTransforms = m_poseCache->Find(key);
+                if (aCachedTransforms)
+                {
+                    PROFILE_SCOPE("Model", "CopyCachedPose");
+                    assert(aCachedTransforms->size() == m_aTransforms.size());
+                    std::copy(aCachedTransforms->begin(), aCachedTransforms->end(), m_aTransforms.begin());
+                    return;
+                }
+                time = m_poseCache->GetStepTime(key.uTimeStep);
+            }
+
+            {
+                PROFILE_SCOPE("Model", "SampleClip");
+                clip.Sample(time * clip.GetTicksPerSecond(), m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data());
+            }
+
+            {
+                PROFILE_SCOPE("Model", "EvaluateSkeleton");
+                m_skeleton->Evaluate(m_aNodeTracks[layer.desc.uClip].data(), m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data(), m_animationLod.uSkippedLevels,
+                    m_globalInverseTransform, m_aGlobalTransforms.data(), m_aTransforms.data());
+            }
+
+            if (bCached)
+            {
+                m_poseCache->Insert(key, m_aTransforms);
+            }
+            return;
+        }
+
+        {
+            PROFILE_SCOPE("Model", "BlendLayers");
+            if (uNumBaseLayers == 0u)
+            {
+                m_pose.SetBindPose(*m_skeleton);
+            }
+
+            FLOAT totalWeight = 0.0f;
+            for (const AnimationLayer& layer : m_aAnimationLayers)
+            {
+                if (!layer.bActive || layer.desc.weight <= 0.0f || layer.desc.bAdditive)
+                {
+                    continue;
+                }
+
+                if (totalWeight > 0.0f)
+                {
+                    totalWeight += layer.desc.weight;
+                    sampleAnimation(layer, m_layerPose);
+                    m_pose.Blend(m_layerPose, layer.desc.weight / totalWeight);
+                }
+                else
+                {
+                    totalWeight = layer.desc.weight;
+                    sampleAnimation(layer, m_pose);
+                }
+            }
+
+            for (const AnimationLayer& layer : m_aAnimationLayers)
+            {
+                if (!layer.bActive || layer.desc.weight <= 0.0f || !layer.desc.bAdditive)
+                {
+                    continue;
+                }
+
+                sampleAnimation(layer, m_layerPose);
+                m_pose.AddAdditive(m_layerPose, *m_aReferencePoses[layer.desc.uClip], layer.desc.weight);
+            }
+        }
+
+        {
+            PROFILE_SCOPE("Model", "EvaluateSkeleton");
+            m_skeleton->EvaluatePose(m_pose.GetTranslations(), m_pose.GetRotations(), m_pose.GetScales(), m_animationLod.uSkippedLevels,
+                m_globalInverseTransform, m_aGlobalTransforms.data(), m_aTransforms.data());
+        }
+    }
 }
\ No newline at end of file
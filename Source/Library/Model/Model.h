@@ -5,26 +5,32 @@
              Model class used for the lab samples of Game
              Graphics Programming course.
 
-  Classes: Model
+  Classes: AnimationLayerDesc, AnimationClipStatistics, Model
 
   ?2022 Kyung Hee University
 ===================================================================+*/
 #pragma once
 
 #include "Common.h"
+#include "Model/AnimationClip.h"
+#include "Model/AnimationLod.h"
+#include "Model/BakedAnimation.h"
+#include "Model/CompressedAnimationClip.h"
+#include "Model/Pose.h"
+#include "Model/PoseCache.h"
+#include "Model/Skeleton.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
 
+struct aiAnimation;
 struct aiScene;
 struct aiMesh;
 struct aiMaterial;
-struct aiAnimation;
 struct aiBone;
 struct aiNode;
-struct aiNodeAnim;
 
 namespace Assimp
 {
@@ -33,6 +39,55 @@ namespace Assimp
 
 namespace library
 {
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   AnimationLayerDesc
+
+        Summary:  Data structure that describes a clip playing on a
+                  layer of a model. The time is in seconds and advances
+                  by the speed, wrapping around the clip when it loops
+                  and stopping at its ends otherwise. The base layers
+                  are averaged by their weights, then the additive
+                  layers add their difference from the first sample of
+                  their clip, scaled by their weights
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLayerDesc
+    {
+        UINT uClip;
+        FLOAT time;
+        FLOAT speed;
+        FLOAT weight;
+        BOOL bLoop;
+        BOOL bAdditive;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   AnimationClipStatistics
+
+        Summary:  Data structure that reports a clip read from the model
+                  file: the size and the largest error of its resampled
+                  tracks against the assimp keys, the size and the
+                  largest error of its compressed keys against the
+                  resampled tracks, and how many times smaller the
+                  compressed keys are than the assimp keys
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationClipStatistics
+    {
+        UINT uNumTracks;
+        UINT uNumSamples;
+        size_t uResampledSizeInBytes;
+        FLOAT maxResampledTranslationError;
+        FLOAT maxResampledRotationError;
+        FLOAT maxResampledScalingError;
+        UINT uNumKeys;
+        size_t uCompressedSizeInBytes;
+        size_t uKeysSizeInBytes;
+        FLOAT compressionRatio;
+        FLOAT maxTranslationError;
+        FLOAT maxRotationError;
+        FLOAT maxScalingError;
+        FLOAT maxPositionError;
+    };
+
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Model
 
@@ -43,6 +98,44 @@ namespace library
                 Update
                   Pure virtual function that updates the object each
                   frame
+                PlayAnimation
+                  Starts playing a clip on a new layer
+                CrossfadeAnimation
+                  Fades a layer out while a new layer fades in
+                FadeAnimation
+                  Moves the weight of a layer over a duration
+                StopAnimation
+                  Stops a layer
+                SetAnimationTime
+                  Sets the time of a layer
+                SetAnimationSpeed
+                  Sets the speed of a layer
+                SetAnimationWeight
+                  Sets the weight of a layer
+                GetAnimationLayer
+                  Returns the description of a layer
+                IsAnimationPlaying
+                  Returns whether a layer is playing
+                GetNumAnimations
+                  Returns the number of clips of the model
+                GetAnimationClipStatistics
+                  Returns the size and the error of a clip
+                SetAnimationLod
+                  Sets the animation level of detail
+                SetUpdatePhase
+                  Sets the frame of the interval the bones update in
+                GetAnimationLod
+                  Returns the animation level of detail
+                SetPoseCache
+                  Sets the cache sharing the poses of the models
+                BakeAnimations
+                  Bakes the clips into frames of bone transforms
+                SetBakedAnimation
+                  Plays the clips from baked frames
+                GetBakedAnimation
+                  Returns the baked frames the model plays
+                GetBakedFrameOffset
+                  Returns the offset of the baked frame of the model
                 GetVertexBuffer
                   Returns the vertex buffer
                 GetIndexBuffer
@@ -57,6 +150,17 @@ namespace library
                 GetNumIndices
                   Pure virtual function that returns the number of
                   indices
+                FillBonePalette
+                  Packs the bone transforms into 3x4 rows for the
+                  shader
+                GetBonePaletteBuffer
+                  Returns the structured buffer of the bone palette
+                GetBonePaletteView
+                  Returns the view of the bone palette
+                GetFilePath
+                  Returns the path of the model file
+                IsSkinned
+                  Returns whether the model has bones
                 Model
                   Constructor.
                 ~Model
@@ -76,14 +180,38 @@ namespace library
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
         virtual void Update(_In_ FLOAT deltaTime) override;
 
+        UINT PlayAnimation(_In_ const AnimationLayerDesc& desc);
+        UINT CrossfadeAnimation(_In_ UINT uLayer, _In_ const AnimationLayerDesc& desc, _In_ FLOAT fadeDuration);
+        void FadeAnimation(_In_ UINT uLayer, _In_ FLOAT targetWeight, _In_ FLOAT fadeDuration);
+        void StopAnimation(_In_ UINT uLayer);
+        void SetAnimationTime(_In_ UINT uLayer, _In_ FLOAT time);
+        void SetAnimationSpeed(_In_ UINT uLayer, _In_ FLOAT speed);
+        void SetAnimationWeight(_In_ UINT uLayer, _In_ FLOAT weight);
+        const AnimationLayerDesc& GetAnimationLayer(_In_ UINT uLayer) const;
+        BOOL IsAnimationPlaying(_In_ UINT uLayer) const;
+        UINT GetNumAnimations() const;
+        const AnimationClipStatistics& GetAnimationClipStatistics(_In_ UINT uClip) const;
+        void SetAnimationLod(_In_ const AnimationLod& lod);
+        void SetUpdatePhase(_In_ UINT uPhase);
+        const AnimationLod& GetAnimationLod() const;
+        void SetPoseCache(_In_ const std::shared_ptr<PoseCache>& poseCache);
+        HRESULT BakeAnimations(_In_opt_ ID3D11Device* pDevice, _In_ FLOAT framesPerSecond);
+        void SetBakedAnimation(_In_ const std::shared_ptr<BakedAnimation>& bakedAnimation);
+        const std::shared_ptr<BakedAnimation>& GetBakedAnimation() const;
+        UINT GetBakedFrameOffset() const;
+
         ComPtr<ID3D11Buffer>& GetAnimationBuffer();
-        ComPtr<ID3D11Buffer>& GetSkinningConstantBuffer();
+        ComPtr<ID3D11Buffer>& GetBonePaletteBuffer();
+        ComPtr<ID3D11ShaderResourceView>& GetBonePaletteView();
 
         virtual UINT GetNumVertices() const override;
         virtual UINT GetNumIndices() const override;
 
         std::vector<XMMATRIX>& GetBoneTransforms();
+        UINT FillBonePalette(_Out_writes_to_(MAX_NUM_BONES, return) PackedBoneTransform* aBonePalette) const;
         const std::unordered_map<std::string, UINT>& GetBoneNameToIndexMap() const;
+        const std::filesystem::path& GetFilePath() const;
+        BOOL IsSkinned() const;
 
     protected:
         struct VertexBoneData
@@ -99,16 +227,27 @@ namespace library
 
             void AddBoneData(_In_ UINT uBoneId, _In_ FLOAT weight)
             {
-                assert(uNumBones < ARRAYSIZE(aBoneIds));
+                // Once every slot is taken, a larger weight replaces the smallest one, so the largest weights are kept
+                UINT uSlot = uNumBones;
+                if (uNumBones == ARRAYSIZE(aBoneIds))
+                {
+                    uSlot = 0u;
+                    for (UINT i = 1u; i < uNumBones; ++i)
+                    {
+                        uSlot = aWeights[i] < aWeights[uSlot] ? i : uSlot;
+                    }
+                    if (weight <= aWeights[uSlot])
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    ++uNumBones;
+                }
 
-                aBoneIds[uNumBones] = uBoneId;
-                aWeights[uNumBones] = weight;
-
-                static CHAR szDebugMessage[256];
-                sprintf_s(szDebugMessage, "\t\t\tBone %d, weight: %f, index %u\n", uBoneId, weight, uNumBones);
-                OutputDebugStringA(szDebugMessage);
-
-                ++uNumBones;
+                aBoneIds[uSlot] = uBoneId;
+                aWeights[uSlot] = weight;
             }
 
             UINT aBoneIds[MAX_NUM_BONES_PER_VERTEX];
@@ -121,29 +260,42 @@ namespace library
             BoneInfo() = default;
             BoneInfo(const XMMATRIX& Offset)
                 : OffsetMatrix(Offset)
-                , FinalTransformation()
             {
             }
 
             XMMATRIX OffsetMatrix;
-            XMMATRIX FinalTransformation;
         };
 
+        struct AnimationLayer
+        {
+            AnimationLayerDesc desc;
+            FLOAT fadeTarget;
+            FLOAT fadeRate;
+            BOOL bActive;
+        };
+
+        struct SharedAnimations
+        {
+            std::weak_ptr<Skeleton> skeleton;
+            std::vector<std::weak_ptr<CompressedAnimationClip>> aClips;
+            std::weak_ptr<BakedAnimation> bakedAnimation;
+        };
+
+        void addAnimation(_In_ const aiAnimation* pAnimation);
+        void advanceAnimations(_In_ FLOAT deltaTime);
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
-        const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
-        UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
         UINT getBoneId(_In_ const aiBone* pBone);
         const virtual SimpleVertex* getVertices() const override;
         virtual const WORD* getIndices() const override;
         void initAllMeshes(_In_ const aiScene* pScene);
+        void initAnimations(_In_ const aiScene* pScene);
         HRESULT initFromScene(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
             _In_ const aiScene* pScene,
             _In_ const std::filesystem::path& filePath
         );
+        void initGeometry(_In_ const aiScene* pScene);
         HRESULT initMaterials(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -152,10 +304,8 @@ namespace library
         );
         void initMeshBones(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
         void initMeshSingleBone(_In_ UINT uBoneIndex, _In_ const aiBone* pBone);
+        void initSkeleton(_In_ const aiScene* pScene);
         virtual void initSingleMesh(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
-        void interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
         HRESULT loadDiffuseTexture(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -163,6 +313,7 @@ namespace library
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
+        HRESULT loadScene();
         HRESULT loadSpecularTexture(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -184,17 +335,25 @@ namespace library
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
-        void readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+        static AnimationData quantizeBoneData(_In_ const VertexBoneData& boneData);
         void reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices);
+        void sampleAnimation(_In_ const AnimationLayer& layer, _Inout_ Pose& pose);
+        void shareAnimations(_In_ const std::filesystem::path& filePath);
+        void updateAnimations();
 
     protected:
+        static constexpr const FLOAT ANIMATION_SAMPLES_PER_SECOND = 60.0f;
+        static constexpr const FLOAT ANIMATION_ERROR_BUDGET = 0.001f;
+
         static std::unique_ptr<Assimp::Importer> sm_pImporter;
+        static std::unordered_map<std::wstring, SharedAnimations> sm_sharedAnimations;
 
     protected:
         std::filesystem::path m_filePath;
 
         ComPtr<ID3D11Buffer> m_animationBuffer;
-        ComPtr<ID3D11Buffer> m_skinningConstantBuffer;
+        ComPtr<ID3D11Buffer> m_bonePaletteBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_bonePaletteView;
 
         std::vector<SimpleVertex> m_aVertices;
         std::vector<AnimationData> m_aAnimationData;
@@ -203,11 +362,26 @@ namespace library
         std::vector<BoneInfo> m_aBoneInfo;
         std::vector<XMMATRIX> m_aTransforms;
         std::unordered_map<std::string, UINT> m_boneNameToIndexMap;
+        std::vector<std::shared_ptr<CompressedAnimationClip>> m_aAnimationClips;
+        std::vector<AnimationClipStatistics> m_aAnimationClipStatistics;
+        std::vector<XMVECTOR> m_aTrackTranslations;
+        std::vector<XMVECTOR> m_aTrackRotations;
+        std::vector<XMVECTOR> m_aTrackScales;
+        std::shared_ptr<Skeleton> m_skeleton;
+        std::vector<std::vector<UINT>> m_aNodeTracks;
+        std::vector<XMMATRIX> m_aGlobalTransforms;
+        std::vector<std::shared_ptr<Pose>> m_aReferencePoses;
+        std::vector<AnimationLayer> m_aAnimationLayers;
+        Pose m_pose;
+        Pose m_layerPose;
+        AnimationLod m_animationLod;
+        UINT m_uFramesSinceEvaluation;
+        UINT m_uUpdatePhase;
+        std::shared_ptr<PoseCache> m_poseCache;
+        std::shared_ptr<BakedAnimation> m_bakedAnimation;
 
         const aiScene* m_pScene;
 
-        float m_timeSinceLoaded;
-
         XMMATRIX m_globalInverseTransform;
 
         //BYTE m_padding[8];
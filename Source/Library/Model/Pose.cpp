@@ -0,0 +1,227 @@
+#include "Model/Pose.h"
+
+#include "Model/AnimationClip.h"
+#include "Model/Skeleton.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::Pose
+
+      Summary:  Constructor, the pose starts without nodes
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Pose::Pose() :
+        m_aTranslations(),
+        m_aRotations(),
+        m_aScales()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::Resize
+
+      Summary:  Sets the number of nodes, once when the skeleton is
+                known instead of every frame
+
+      Args:     UINT uNumNodes
+                  Number of nodes of the skeleton
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Pose::Resize(_In_ UINT uNumNodes)
+    {
+        m_aTranslations.resize(uNumNodes);
+        m_aRotations.resize(uNumNodes);
+        m_aScales.resize(uNumNodes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::SetBindPose
+
+      Summary:  Sets the bind pose of every node of a skeleton
+
+      Args:     const Skeleton& skeleton
+                  Skeleton of the pose
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Pose::SetBindPose(_In_ const Skeleton& skeleton)
+    {
+        assert(skeleton.GetNumNodes() == GetNumNodes());
+
+        skeleton.GetBindPose(m_aTranslations.data(), m_aRotations.data(), m_aScales.data());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::SetTracks
+
+      Summary:  Sets the transforms of the nodes animated by the tracks
+                of a clip, and the bind pose of the other nodes
+
+      Args:     const Skeleton& skeleton
+                  Skeleton of the pose
+                const UINT* aNodeTracks
+                  Track of every node from Skeleton::MapTracks
+                const XMVECTOR* aTranslations
+                  Translation of every track
+                const XMVECTOR* aRotations
+                  Rotation quaternion of every track
+                const XMVECTOR* aScales
+                  Scaling of every track
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Pose::SetTracks(
+        _In_ const Skeleton& skeleton,
+        _In_reads_(GetNumNodes()) const UINT* aNodeTracks,
+        _In_ const XMVECTOR* aTranslations,
+        _In_ const XMVECTOR* aRotations,
+        _In_ const XMVECTOR* aScales
+    )
+    {
+        SetBindPose(skeleton);
+
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            UINT uTrack = aNodeTracks[uNode];
+            if (uTrack != AnimationClip::INVALID_TRACK)
+            {
+                m_aTranslations[uNode] = aTranslations[uTrack];
+                m_aRotations[uNode] = aRotations[uTrack];
+                m_aScales[uNode] = aScales[uTrack];
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::Blend
+
+      Summary:  Interpolates every node toward another pose, the
+                translations and scales linearly and the rotations
+                with a normalized linear interpolation. q and -q are
+                the same rotation, the one nearer to the pose is used
+                so the interpolation takes the shorter arc. Blending
+                several poses one after another, each by its weight
+                over the sum of the weights so far, averages them by
+                their weights
+
+      Args:     const Pose& other
+                  Pose to interpolate toward, of the same skeleton
+                FLOAT factor
+                  0 keeps the pose, 1 copies the other pose
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Pose::Blend(_In_ const Pose& other, _In_ FLOAT factor)
+    {
+        assert(other.GetNumNodes() == GetNumNodes());
+
+        const XMVECTOR factors = XMVectorReplicate(factor);
+        const XMVECTOR zero = XMVectorZero();
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            m_aTranslations[uNode] = XMVectorMultiplyAdd(XMVectorSubtract(other.m_aTranslations[uNode], m_aTranslations[uNode]), factors, m_aTranslations[uNode]);
+            m_aScales[uNode] = XMVectorMultiplyAdd(XMVectorSubtract(other.m_aScales[uNode], m_aScales[uNode]), factors, m_aScales[uNode]);
+
+            XMVECTOR rotation = other.m_aRotations[uNode];
+            rotation = XMVectorSelect(rotation, XMVectorNegate(rotation), XMVectorLess(XMVector4Dot(m_aRotations[uNode], rotation), zero));
+            m_aRotations[uNode] = XMQuaternionNormalize(XMVectorMultiplyAdd(XMVectorSubtract(rotation, m_aRotations[uNode]), factors, m_aRotations[uNode]));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::AddAdditive
+
+      Summary:  Adds the difference of an additive pose from its
+                reference pose to every node, scaled by a weight. The
+                translation difference is added, the scaling ratio
+                multiplied, and the rotation from the reference to the
+                additive pose, interpolated from the identity by the
+                weight, is applied before the rotation of the pose
+
+      Args:     const Pose& additive
+                  Additive pose, of the same skeleton
+                const Pose& reference
+                  Pose the additive pose is relative to
+                FLOAT weight
+                  0 keeps the pose, 1 adds the whole difference
+
+      Modifies: [m_aTranslations, m_aRotations, m_aScales].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Pose::AddAdditive(_In_ const Pose& additive, _In_ const Pose& reference, _In_ FLOAT weight)
+    {
+        assert(additive.GetNumNodes() == GetNumNodes() && reference.GetNumNodes() == GetNumNodes());
+
+        const XMVECTOR weights = XMVectorReplicate(weight);
+        const XMVECTOR one = XMVectorSplatOne();
+        const XMVECTOR identity = XMQuaternionIdentity();
+        const XMVECTOR zero = XMVectorZero();
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            XMVECTOR translation = XMVectorSubtract(additive.m_aTranslations[uNode], reference.m_aTranslations[uNode]);
+            m_aTranslations[uNode] = XMVectorMultiplyAdd(translation, weights, m_aTranslations[uNode]);
+
+            XMVECTOR scaling = XMVectorDivide(additive.m_aScales[uNode], reference.m_aScales[uNode]);
+            m_aScales[uNode] = XMVectorMultiply(m_aScales[uNode], XMVectorMultiplyAdd(XMVectorSubtract(scaling, one), weights, one));
+
+            XMVECTOR rotation = XMQuaternionMultiply(additive.m_aRotations[uNode], XMQuaternionInverse(reference.m_aRotations[uNode]));
+            rotation = XMVectorSelect(rotation, XMVectorNegate(rotation), XMVectorLess(XMVectorSplatW(rotation), zero));
+            rotation = XMQuaternionNormalize(XMVectorMultiplyAdd(XMVectorSubtract(rotation, identity), weights, identity));
+            m_aRotations[uNode] = XMQuaternionMultiply(rotation, m_aRotations[uNode]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::GetTranslations
+
+      Summary:  Returns the translation of every node
+
+      Returns:  const XMVECTOR*
+                  Translations, by node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMVECTOR* Pose::GetTranslations() const
+    {
+        return m_aTranslations.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::GetRotations
+
+      Summary:  Returns the rotation quaternion of every node
+
+      Returns:  const XMVECTOR*
+                  Rotations, by node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMVECTOR* Pose::GetRotations() const
+    {
+        return m_aRotations.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::GetScales
+
+      Summary:  Returns the scaling of every node
+
+      Returns:  const XMVECTOR*
+                  Scales, by node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMVECTOR* Pose::GetScales() const
+    {
+        return m_aScales.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Pose::GetNumNodes
+
+      Summary:  Returns the number of nodes
+
+      Returns:  UINT
+                  Number of nodes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Pose::GetNumNodes() const
+    {
+        return static_cast<UINT>(m_aRotations.size());
+    }
+}
@@ -0,0 +1,90 @@
+/*+===================================================================
+  File:      POSE.H
+
+  Summary:   Pose header file contains declarations of Pose class that
+             stores the local transforms of every node of a skeleton
+             in flat buffers and blends them.
+
+  Classes: Pose
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    class Skeleton;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Pose
+
+      Summary:  Local transforms of the nodes of a skeleton, stored by
+                node in three flat buffers of translations, rotations
+                and scales, so blending walks the buffers in one loop
+                with no call per node. A pose is set from the tracks of
+                a clip, the nodes the clip does not animate taking the
+                bind pose. Blending interpolates translations and
+                scales linearly and rotations with a normalized linear
+                interpolation along the shorter arc. An additive pose
+                applies its difference from a reference pose, scaled by
+                a weight, on top of the pose. The pose does not touch
+                Direct3D
+
+      Methods:  Resize
+                  Sets the number of nodes
+                SetBindPose
+                  Sets the bind pose of a skeleton
+                SetTracks
+                  Sets the transforms of the tracks of a clip
+                Blend
+                  Interpolates toward another pose
+                AddAdditive
+                  Adds the difference of a pose from a reference
+                GetTranslations
+                  Returns the translation of every node
+                GetRotations
+                  Returns the rotation of every node
+                GetScales
+                  Returns the scaling of every node
+                GetNumNodes
+                  Returns the number of nodes
+                Pose
+                  Constructor.
+                ~Pose
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Pose final
+    {
+    public:
+        Pose();
+        Pose(const Pose& other) = delete;
+        Pose(Pose&& other) = delete;
+        Pose& operator=(const Pose& other) = delete;
+        Pose& operator=(Pose&& other) = delete;
+        ~Pose() = default;
+
+        void Resize(_In_ UINT uNumNodes);
+        void SetBindPose(_In_ const Skeleton& skeleton);
+        void SetTracks(
+            _In_ const Skeleton& skeleton,
+            _In_reads_(GetNumNodes()) const UINT* aNodeTracks,
+            _In_ const XMVECTOR* aTranslations,
+            _In_ const XMVECTOR* aRotations,
+            _In_ const XMVECTOR* aScales
+        );
+        void Blend(_In_ const Pose& other, _In_ FLOAT factor);
+        void AddAdditive(_In_ const Pose& additive, _In_ const Pose& reference, _In_ FLOAT weight);
+
+        const XMVECTOR* GetTranslations() const;
+        const XMVECTOR* GetRotations() const;
+        const XMVECTOR* GetScales() const;
+        UINT GetNumNodes() const;
+
+    private:
+        std::vector<XMVECTOR> m_aTranslations;
+        std::vector<XMVECTOR> m_aRotations;
+        std::vector<XMVECTOR> m_aScales;
+    };
+}
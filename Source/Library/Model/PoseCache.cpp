@@ -0,0 +1,263 @@
+#include "Model/PoseCache.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::PoseCache
+
+      Summary:  Constructor, the cache starts without entries
+
+      Args:     FLOAT timeTolerance
+                  Time step of the keys in seconds, 0 to disable the
+                  cache
+
+      Modifies: [m_mutex, m_entries, m_timeTolerance, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PoseCache::PoseCache(_In_ FLOAT timeTolerance) :
+        m_mutex(),
+        m_entries(),
+        m_timeTolerance(timeTolerance > 0.0f ? timeTolerance : 0.0f),
+        m_statistics{ .uNumHits = 0u, .uNumMisses = 0u, .uNumEvictions = 0u, .uNumEntries = 0u }
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::SetTimeTolerance
+
+      Summary:  Sets the time step of the keys and evicts every entry,
+                whose steps no longer match
+
+      Args:     FLOAT timeTolerance
+                  Time step of the keys in seconds, 0 to disable the
+                  cache
+
+      Modifies: [m_entries, m_timeTolerance, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PoseCache::SetTimeTolerance(_In_ FLOAT timeTolerance)
+    {
+        Clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_timeTolerance = timeTolerance > 0.0f ? timeTolerance : 0.0f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::GetTimeTolerance
+
+      Summary:  Returns the time step of the keys
+
+      Returns:  FLOAT
+                  Time step in seconds, 0 when the cache is disabled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PoseCache::GetTimeTolerance() const
+    {
+        return m_timeTolerance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::IsEnabled
+
+      Summary:  Returns whether the cache shares poses
+
+      Returns:  BOOL
+                  Whether the time tolerance is above 0
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL PoseCache::IsEnabled() const
+    {
+        return m_timeTolerance > 0.0f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::GetTimeStep
+
+      Summary:  Returns the nearest step of a time, so the times of the
+                models sharing a step are at most half the tolerance
+                away from it
+
+      Args:     FLOAT time
+                  Time of a clip in seconds, not negative
+
+      Returns:  UINT
+                  Index of the step
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT PoseCache::GetTimeStep(_In_ FLOAT time) const
+    {
+        assert(IsEnabled() && time >= 0.0f);
+
+        return static_cast<UINT>(std::floor(time / m_timeTolerance + 0.5f));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::GetStepTime
+
+      Summary:  Returns the time a step is sampled at
+
+      Args:     UINT uTimeStep
+                  Index of the step
+
+      Returns:  FLOAT
+                  Time in seconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PoseCache::GetStepTime(_In_ UINT uTimeStep) const
+    {
+        return static_cast<FLOAT>(uTimeStep) * m_timeTolerance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::Find
+
+      Summary:  Returns the bone transforms of a key and counts a
+                reference to its entry for the frame
+
+      Args:     const PoseCacheKey& key
+                  Skeleton, clip, step and skipped levels of the pose
+
+      Modifies: [m_entries, m_statistics].
+
+      Returns:  std::shared_ptr<const std::vector<XMMATRIX>>
+                  Bone transforms, nullptr if no model evaluated the
+                  key since the last frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<const std::vector<XMMATRIX>> PoseCache::Find(_In_ const PoseCacheKey& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it_entry = m_entries.find(key);
+        if (it_entry == m_entries.end())
+        {
+            ++m_statistics.uNumMisses;
+            return nullptr;
+        }
+
+        ++m_statistics.uNumHits;
+        ++it_entry->second.uNumReferences;
+        return it_entry->second.aBoneTransforms;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::Insert
+
+      Summary:  Adds the bone transforms evaluated for a key after Find
+                missed it. When another thread added the key in between,
+                its transforms are kept, they are the same since both
+                sampled the time of the step
+
+      Args:     const PoseCacheKey& key
+                  Skeleton, clip, step and skipped levels of the pose
+                const std::vector<XMMATRIX>& aBoneTransforms
+                  Bone transforms evaluated at the time of the step
+
+      Modifies: [m_entries, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PoseCache::Insert(_In_ const PoseCacheKey& key, _In_ const std::vector<XMMATRIX>& aBoneTransforms)
+    {
+        // The copy is made before locking, so the other threads only wait for the insertion
+        std::shared_ptr<const std::vector<XMMATRIX>> aCopy = std::make_shared<const std::vector<XMMATRIX>>(aBoneTransforms);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it_entry, bInserted] = m_entries.try_emplace(key, Entry{ .aBoneTransforms = aCopy, .uNumReferences = 0u });
+        ++it_entry->second.uNumReferences;
+        m_statistics.uNumEntries = static_cast<UINT>(m_entries.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::BeginFrame
+
+      Summary:  Evicts the entries no model referenced during the last
+                frame and starts counting the references of the frame.
+                Entries of paused or slow clips stay while they are
+                used. Transforms still held by a caller outlive their
+                eviction through their reference count
+
+      Modifies: [m_entries, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PoseCache::BeginFrame()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto it_entry = m_entries.begin(); it_entry != m_entries.end();)
+        {
+            if (it_entry->second.uNumReferences == 0u)
+            {
+                it_entry = m_entries.erase(it_entry);
+                ++m_statistics.uNumEvictions;
+            }
+            else
+            {
+                it_entry->second.uNumReferences = 0u;
+                ++it_entry;
+            }
+        }
+        m_statistics.uNumEntries = static_cast<UINT>(m_entries.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::Clear
+
+      Summary:  Evicts every entry
+
+      Modifies: [m_entries, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PoseCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_statistics.uNumEvictions += m_entries.size();
+        m_entries.clear();
+        m_statistics.uNumEntries = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::GetStatistics
+
+      Summary:  Returns the hits, misses and evictions since the cache
+                was created, and the number of entries
+
+      Returns:  PoseCacheStatistics
+                  Counts of the lookups
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PoseCacheStatistics PoseCache::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_statistics;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::GetHitRate
+
+      Summary:  Returns the fraction of the lookups that found the pose
+                of another model
+
+      Returns:  FLOAT
+                  Hits over lookups, 0 without lookups
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PoseCache::GetHitRate() const
+    {
+        PoseCacheStatistics statistics = GetStatistics();
+        UINT64 uNumLookups = statistics.uNumHits + statistics.uNumMisses;
+
+        return uNumLookups > 0u ? static_cast<FLOAT>(static_cast<DOUBLE>(statistics.uNumHits) / static_cast<DOUBLE>(uNumLookups)) : 0.0f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PoseCache::KeyHash::operator()
+
+      Summary:  Mixes the members of a key into a hash
+
+      Args:     const PoseCacheKey& key
+                  Key to hash
+
+      Returns:  size_t
+                  Hash of the key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t PoseCache::KeyHash::operator()(const PoseCacheKey& key) const
+    {
+        size_t uHash = std::hash<const void*>()(key.pSkeleton);
+        uHash = uHash * 31u + std::hash<const void*>()(key.pClip);
+        uHash = uHash * 31u + key.uTimeStep;
+        return uHash * 31u + key.uSkippedLevels;
+    }
+}
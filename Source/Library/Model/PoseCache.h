@@ -0,0 +1,149 @@
+/*+===================================================================
+  File:      POSECACHE.H
+
+  Summary:   PoseCache header file contains declarations of PoseCache
+             class that shares the bone transforms evaluated for a clip
+             at a time between the models playing it.
+
+  Classes: PoseCacheKey, PoseCacheStatistics, PoseCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include <mutex>
+
+namespace library
+{
+    class CompressedAnimationClip;
+    class Skeleton;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   PoseCacheKey
+
+        Summary:  Data structure that identifies a pose of the cache, the
+                  skeleton and the clip evaluated, the time of the clip
+                  in steps of the time tolerance of the cache, and the
+                  levels of leaf nodes the animation level of detail
+                  skipped
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PoseCacheKey
+    {
+        const Skeleton* pSkeleton;
+        const CompressedAnimationClip* pClip;
+        UINT uTimeStep;
+        UINT uSkippedLevels;
+
+        bool operator==(const PoseCacheKey& other) const = default;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   PoseCacheStatistics
+
+        Summary:  Data structure that counts the lookups of the cache
+                  since it was created. A hit copies the bone transforms
+                  of another model, a miss evaluates the skeleton and
+                  adds its pose to the cache
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PoseCacheStatistics
+    {
+        UINT64 uNumHits;
+        UINT64 uNumMisses;
+        UINT64 uNumEvictions;
+        UINT uNumEntries;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PoseCache
+
+      Summary:  Bone transforms evaluated by the models of a scene for a
+                clip at a time, shared with the models playing the same
+                clip of the same skeleton within the time tolerance, so
+                a crowd evaluates about one skeleton per distinct phase
+                instead of one per model. Only the models playing a
+                single base layer use the cache, the models blending
+                several layers or adding additive ones evaluate their
+                pose every update. Models using the cache sample their
+                clip at the time of the nearest step even on a miss, so
+                the transforms do not depend on which model evaluated
+                them first, and their clip advances in steps of the time
+                tolerance, 1/120 s in a scene, instead of continuously.
+                Every entry is reference counted and counts the models
+                that used it during the frame, and BeginFrame evicts
+                the entries no model used during the last frame. Lookups
+                and insertions lock the cache, so the models may be
+                updated on several threads
+
+      Methods:  SetTimeTolerance
+                  Sets the time step of the keys, 0 to disable the cache
+                GetTimeTolerance
+                  Returns the time step of the keys
+                IsEnabled
+                  Returns whether the cache shares poses
+                GetTimeStep
+                  Returns the step of a time
+                GetStepTime
+                  Returns the time of a step
+                Find
+                  Returns the bone transforms of a key
+                Insert
+                  Adds the bone transforms of a key
+                BeginFrame
+                  Evicts the entries unused during the last frame
+                Clear
+                  Evicts every entry
+                GetStatistics
+                  Returns the counts of the lookups
+                GetHitRate
+                  Returns the fraction of the lookups that hit
+                PoseCache
+                  Constructor.
+                ~PoseCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PoseCache final
+    {
+    public:
+        PoseCache() = delete;
+        explicit PoseCache(_In_ FLOAT timeTolerance);
+        PoseCache(const PoseCache& other) = delete;
+        PoseCache(PoseCache&& other) = delete;
+        PoseCache& operator=(const PoseCache& other) = delete;
+        PoseCache& operator=(PoseCache&& other) = delete;
+        ~PoseCache() = default;
+
+        void SetTimeTolerance(_In_ FLOAT timeTolerance);
+        FLOAT GetTimeTolerance() const;
+        BOOL IsEnabled() const;
+        UINT GetTimeStep(_In_ FLOAT time) const;
+        FLOAT GetStepTime(_In_ UINT uTimeStep) const;
+
+        std::shared_ptr<const std::vector<XMMATRIX>> Find(_In_ const PoseCacheKey& key);
+        void Insert(_In_ const PoseCacheKey& key, _In_ const std::vector<XMMATRIX>& aBoneTransforms);
+        void BeginFrame();
+        void Clear();
+
+        PoseCacheStatistics GetStatistics() const;
+        FLOAT GetHitRate() const;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<const std::vector<XMMATRIX>> aBoneTransforms;
+            UINT uNumReferences;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const PoseCacheKey& key) const;
+        };
+
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<PoseCacheKey, Entry, KeyHash> m_entries;
+        FLOAT m_timeTolerance;
+        PoseCacheStatistics m_statistics;
+    };
+}
@@ -0,0 +1,405 @@
+#include "Model/Skeleton.h"
+
+#include "Model/AnimationClip.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::Skeleton
+
+      Summary:  Constructor, the skeleton starts without nodes
+
+      Modifies: [m_aNodeNames, m_aParents, m_aBones, m_aHeights,
+                  m_aLocalTransforms, m_aBoneOffsets, m_aBindTranslations,
+                  m_aBindRotations, m_aBindScales, m_uNumBones].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Skeleton::Skeleton() :
+        m_aNodeNames(),
+        m_aParents(),
+        m_aBones(),
+        m_aHeights(),
+        m_aLocalTransforms(),
+        m_aBoneOffsets(),
+        m_aBindTranslations(),
+        m_aBindRotations(),
+        m_aBindScales(),
+        m_uNumBones(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::AddNode
+
+      Summary:  Appends a node, whose parent has to be added before it.
+                The node is a leaf, and the heights of its ancestors
+                grow to fit it
+
+      Args:     PCSTR pszName
+                  Name of the node, matching the channels of the clips
+                UINT uParent
+                  Index of the parent, INVALID_INDEX for a root
+                const XMMATRIX& localTransform
+                  Transform relative to the parent when no track
+                  animates the node
+                UINT uBone
+                  Index of the bone the node drives, INVALID_INDEX for
+                  none
+                const XMMATRIX& boneOffset
+                  Transform from the mesh space to the space of the
+                  bone, unused without a bone
+
+      Modifies: [m_aNodeNames, m_aParents, m_aBones, m_aHeights,
+                  m_aLocalTransforms, m_aBoneOffsets, m_aBindTranslations,
+                  m_aBindRotations, m_aBindScales, m_uNumBones].
+
+      Returns:  UINT
+                  Index of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::AddNode(_In_ PCSTR pszName, _In_ UINT uParent, _In_ const XMMATRIX& localTransform, _In_ UINT uBone, _In_ const XMMATRIX& boneOffset)
+    {
+        assert(uParent == INVALID_INDEX || uParent < GetNumNodes());
+
+        m_aNodeNames.push_back(pszName);
+        m_aParents.push_back(uParent);
+        m_aBones.push_back(uBone);
+        m_aHeights.push_back(0u);
+        for (UINT uAncestor = uParent, uHeight = 1u; uAncestor != INVALID_INDEX && m_aHeights[uAncestor] < uHeight; uAncestor = m_aParents[uAncestor], ++uHeight)
+        {
+            m_aHeights[uAncestor] = uHeight;
+        }
+        m_aLocalTransforms.push_back(localTransform);
+        m_aBoneOffsets.push_back(uBone != INVALID_INDEX ? boneOffset : XMMatrixIdentity());
+
+        XMVECTOR scaling, rotation, translation;
+        if (!XMMatrixDecompose(&scaling, &rotation, &translation, localTransform))
+        {
+            scaling = XMVectorSplatOne();
+            rotation = XMQuaternionIdentity();
+            translation = localTransform.r[3];
+        }
+        m_aBindTranslations.push_back(translation);
+        m_aBindRotations.push_back(rotation);
+        m_aBindScales.push_back(scaling);
+        if (uBone != INVALID_INDEX && uBone >= m_uNumBones)
+        {
+            m_uNumBones = uBone + 1u;
+        }
+
+        return GetNumNodes() - 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::MapTracks
+
+      Summary:  Finds the track of a clip animating every node by name,
+                once when the clip is bound instead of every frame
+
+      Args:     const AnimationClip& clip
+                  Clip to bind
+                std::vector<UINT>& aNodeTracks
+                  Track of every node, AnimationClip::INVALID_TRACK for
+                  the nodes the clip does not animate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Skeleton::MapTracks(_In_ const AnimationClip& clip, _Out_ std::vector<UINT>& aNodeTracks) const
+    {
+        aNodeTracks.resize(GetNumNodes());
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            aNodeTracks[uNode] = clip.FindTrack(m_aNodeNames[uNode].c_str());
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::Evaluate
+
+      Summary:  Computes the global transform of every node, parents
+                first, and the final transform of every bone. An
+                animated node builds its local transform from the
+                scaling, rotation and translation of its track, the
+                other nodes and the nodes lower than the skipped levels
+                keep their bind transform
+
+      Args:     const UINT* aNodeTracks
+                  Track of every node from MapTracks, nullptr for the
+                  bind pose
+                const XMVECTOR* aTranslations
+                  Translation of every track
+                const XMVECTOR* aRotations
+                  Rotation quaternion of every track
+                const XMVECTOR* aScales
+                  Scaling of every track
+                UINT uSkippedLevels
+                  Number of levels above the leaves keeping their bind
+                  transform, 0 to animate every node
+                const XMMATRIX& globalInverseTransform
+                  Inverse of the transform of the root of the model
+                XMMATRIX* aGlobalTransforms
+                  Global transform of every node
+                XMMATRIX* aBoneTransforms
+                  Final transform of every bone driven by a node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Skeleton::Evaluate(
+        _In_reads_opt_(GetNumNodes()) const UINT* aNodeTracks,
+        _In_opt_ const XMVECTOR* aTranslations,
+        _In_opt_ const XMVECTOR* aRotations,
+        _In_opt_ const XMVECTOR* aScales,
+        _In_ UINT uSkippedLevels,
+        _In_ const XMMATRIX& globalInverseTransform,
+        _Out_writes_(GetNumNodes()) XMMATRIX* aGlobalTransforms,
+        _Out_writes_(GetNumBones()) XMMATRIX* aBoneTransforms
+    ) const
+    {
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            UINT uTrack = aNodeTracks && m_aHeights[uNode] >= uSkippedLevels ? aNodeTracks[uNode] : AnimationClip::INVALID_TRACK;
+
+            accumulateNode(uNode,
+                uTrack != AnimationClip::INVALID_TRACK ? composeTransform(aTranslations[uTrack], aRotations[uTrack], aScales[uTrack]) : m_aLocalTransforms[uNode],
+                globalInverseTransform, aGlobalTransforms, aBoneTransforms);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::EvaluatePose
+
+      Summary:  Computes the global transform of every node, parents
+                first, and the final transform of every bone from a
+                pose holding the local transform of every node. The
+                nodes lower than the skipped levels keep their bind
+                transform
+
+      Args:     const XMVECTOR* aTranslations
+                  Translation of every node
+                const XMVECTOR* aRotations
+                  Rotation quaternion of every node
+                const XMVECTOR* aScales
+                  Scaling of every node
+                UINT uSkippedLevels
+                  Number of levels above the leaves keeping their bind
+                  transform, 0 to animate every node
+                const XMMATRIX& globalInverseTransform
+                  Inverse of the transform of the root of the model
+                XMMATRIX* aGlobalTransforms
+                  Global transform of every node
+                XMMATRIX* aBoneTransforms
+                  Final transform of every bone driven by a node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Skeleton::EvaluatePose(
+        _In_reads_(GetNumNodes()) const XMVECTOR* aTranslations,
+        _In_reads_(GetNumNodes()) const XMVECTOR* aRotations,
+        _In_reads_(GetNumNodes()) const XMVECTOR* aScales,
+        _In_ UINT uSkippedLevels,
+        _In_ const XMMATRIX& globalInverseTransform,
+        _Out_writes_(GetNumNodes()) XMMATRIX* aGlobalTransforms,
+        _Out_writes_(GetNumBones()) XMMATRIX* aBoneTransforms
+    ) const
+    {
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            accumulateNode(uNode,
+                m_aHeights[uNode] >= uSkippedLevels ? composeTransform(aTranslations[uNode], aRotations[uNode], aScales[uNode]) : m_aLocalTransforms[uNode],
+                globalInverseTransform, aGlobalTransforms, aBoneTransforms);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetBindPose
+
+      Summary:  Writes the scaling, rotation and translation of the bind
+                transform of every node
+
+      Args:     XMVECTOR* aTranslations
+                  Translation of every node
+                XMVECTOR* aRotations
+                  Rotation quaternion of every node
+                XMVECTOR* aScales
+                  Scaling of every node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Skeleton::GetBindPose(
+        _Out_writes_(GetNumNodes()) XMVECTOR* aTranslations,
+        _Out_writes_(GetNumNodes()) XMVECTOR* aRotations,
+        _Out_writes_(GetNumNodes()) XMVECTOR* aScales
+    ) const
+    {
+        std::copy(m_aBindTranslations.begin(), m_aBindTranslations.end(), aTranslations);
+        std::copy(m_aBindRotations.begin(), m_aBindRotations.end(), aRotations);
+        std::copy(m_aBindScales.begin(), m_aBindScales.end(), aScales);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::FindNode
+
+      Summary:  Returns the node with a name
+
+      Args:     PCSTR pszName
+                  Name of the node
+
+      Returns:  UINT
+                  Index of the first node with the name, INVALID_INDEX
+                  if no node has it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::FindNode(_In_ PCSTR pszName) const
+    {
+        for (UINT uNode = 0u; uNode < GetNumNodes(); ++uNode)
+        {
+            if (m_aNodeNames[uNode] == pszName)
+            {
+                return uNode;
+            }
+        }
+
+        return INVALID_INDEX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetNodeName
+
+      Summary:  Returns the name of a node
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  const std::string&
+                  Name of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::string& Skeleton::GetNodeName(_In_ UINT uNode) const
+    {
+        return m_aNodeNames[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetParent
+
+      Summary:  Returns the parent of a node
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  UINT
+                  Index of the parent, smaller than the index of the
+                  node, INVALID_INDEX for a root
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::GetParent(_In_ UINT uNode) const
+    {
+        return m_aParents[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetBone
+
+      Summary:  Returns the bone a node drives
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  UINT
+                  Index of the bone, INVALID_INDEX for none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::GetBone(_In_ UINT uNode) const
+    {
+        return m_aBones[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetHeight
+
+      Summary:  Returns the number of levels between a node and its
+                deepest leaf
+
+      Args:     UINT uNode
+                  Index of the node
+
+      Returns:  UINT
+                  Height of the node, 0 for a leaf
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::GetHeight(_In_ UINT uNode) const
+    {
+        return m_aHeights[uNode];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetNumNodes
+
+      Summary:  Returns the number of nodes
+
+      Returns:  UINT
+                  Number of nodes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::GetNumNodes() const
+    {
+        return static_cast<UINT>(m_aParents.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::GetNumBones
+
+      Summary:  Returns the number of bones, one more than the largest
+                bone driven by a node
+
+      Returns:  UINT
+                  Number of bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Skeleton::GetNumBones() const
+    {
+        return m_uNumBones;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::composeTransform
+
+      Summary:  Builds a local transform from a scaling, a rotation and
+                a translation, the rows of the rotation scaled and the
+                translation put in the last row, the same as S * R * T
+
+      Args:     FXMVECTOR translation
+                  Translation
+                FXMVECTOR rotation
+                  Rotation quaternion
+                FXMVECTOR scaling
+                  Scaling
+
+      Returns:  XMMATRIX
+                  Local transform
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMMATRIX Skeleton::composeTransform(_In_ FXMVECTOR translation, _In_ FXMVECTOR rotation, _In_ FXMVECTOR scaling)
+    {
+        XMMATRIX transform = XMMatrixRotationQuaternion(rotation);
+        transform.r[0] = XMVectorMultiply(transform.r[0], XMVectorSplatX(scaling));
+        transform.r[1] = XMVectorMultiply(transform.r[1], XMVectorSplatY(scaling));
+        transform.r[2] = XMVectorMultiply(transform.r[2], XMVectorSplatZ(scaling));
+        transform.r[3] = XMVectorSelect(g_XMIdentityR3, translation, g_XMSelect1110);
+        return transform;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skeleton::accumulateNode
+
+      Summary:  Multiplies the local transform of a node with the global
+                transform of its parent, computed before it, and writes
+                the final transform of the bone the node drives
+
+      Args:     UINT uNode
+                  Index of the node
+                const XMMATRIX& localTransform
+                  Transform of the node relative to its parent
+                const XMMATRIX& globalInverseTransform
+                  Inverse of the transform of the root of the model
+                XMMATRIX* aGlobalTransforms
+                  Global transform of every node
+                XMMATRIX* aBoneTransforms
+                  Final transform of every bone driven by a node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Skeleton::accumulateNode(_In_ UINT uNode, _In_ const XMMATRIX& localTransform, _In_ const XMMATRIX& globalInverseTransform, _Inout_ XMMATRIX* aGlobalTransforms, _Inout_ XMMATRIX* aBoneTransforms) const
+    {
+        UINT uParent = m_aParents[uNode];
+        aGlobalTransforms[uNode] = uParent != INVALID_INDEX ? XMMatrixMultiply(localTransform, aGlobalTransforms[uParent]) : localTransform;
+
+        UINT uBone = m_aBones[uNode];
+        if (uBone != INVALID_INDEX)
+        {
+            aBoneTransforms[uBone] = XMMatrixMultiply(XMMatrixMultiply(m_aBoneOffsets[uNode], aGlobalTransforms[uNode]), globalInverseTransform);
+        }
+    }
+}
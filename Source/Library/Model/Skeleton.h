@@ -0,0 +1,138 @@
+/*+===================================================================
+  File:      SKELETON.H
+
+  Summary:   Skeleton header file contains declarations of Skeleton
+             class that stores the node hierarchy of a model as flat
+             arrays and evaluates its pose in one pass.
+
+  Classes: Skeleton
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    class AnimationClip;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Skeleton
+
+      Summary:  Node hierarchy of a model flattened into arrays. Nodes
+                are added parents first, so every node comes after its
+                parent and is stored by the index of the parent, its
+                transform relative to the parent, and the bone it
+                drives with the offset of that bone. The names of the
+                nodes are only looked up when a clip is bound to the
+                skeleton, which maps every node to the track of the
+                clip that animates it. Evaluating a pose then walks the
+                arrays once from the root, multiplying each local
+                transform with the global transform of its parent,
+                already computed. A pose blended from several clips is
+                stored per node instead of per track, and nodes no clip
+                animates take the bind pose, the bind transform split
+                into its scaling, rotation and translation. Every node
+                also stores its height, the number of levels down to
+                its deepest leaf, so a distant model can skip the
+                tracks of the leaves, such as the fingers, and keep
+                their bind transform. The skeleton does not touch
+                Direct3D
+
+      Methods:  AddNode
+                  Appends a node after its parent
+                MapTracks
+                  Maps every node to the track of a clip animating it
+                Evaluate
+                  Computes the bone transforms of the tracks of a clip
+                EvaluatePose
+                  Computes the bone transforms of a pose of the nodes
+                GetBindPose
+                  Writes the bind pose of every node
+                FindNode
+                  Returns the node with a name
+                GetNodeName
+                  Returns the name of a node
+                GetParent
+                  Returns the parent of a node
+                GetBone
+                  Returns the bone a node drives
+                GetHeight
+                  Returns the number of levels below a node
+                GetNumNodes
+                  Returns the number of nodes
+                GetNumBones
+                  Returns the number of bones driven by the nodes
+                Skeleton
+                  Constructor.
+                ~Skeleton
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Skeleton final
+    {
+    public:
+        static constexpr const UINT INVALID_INDEX = UINT_MAX;
+
+    public:
+        Skeleton();
+        Skeleton(const Skeleton& other) = delete;
+        Skeleton(Skeleton&& other) = delete;
+        Skeleton& operator=(const Skeleton& other) = delete;
+        Skeleton& operator=(Skeleton&& other) = delete;
+        ~Skeleton() = default;
+
+        UINT AddNode(_In_ PCSTR pszName, _In_ UINT uParent, _In_ const XMMATRIX& localTransform, _In_ UINT uBone, _In_ const XMMATRIX& boneOffset);
+        void MapTracks(_In_ const AnimationClip& clip, _Out_ std::vector<UINT>& aNodeTracks) const;
+
+        void Evaluate(
+            _In_reads_opt_(GetNumNodes()) const UINT* aNodeTracks,
+            _In_opt_ const XMVECTOR* aTranslations,
+            _In_opt_ const XMVECTOR* aRotations,
+            _In_opt_ const XMVECTOR* aScales,
+            _In_ UINT uSkippedLevels,
+            _In_ const XMMATRIX& globalInverseTransform,
+            _Out_writes_(GetNumNodes()) XMMATRIX* aGlobalTransforms,
+            _Out_writes_(GetNumBones()) XMMATRIX* aBoneTransforms
+        ) const;
+        void EvaluatePose(
+            _In_reads_(GetNumNodes()) const XMVECTOR* aTranslations,
+            _In_reads_(GetNumNodes()) const XMVECTOR* aRotations,
+            _In_reads_(GetNumNodes()) const XMVECTOR* aScales,
+            _In_ UINT uSkippedLevels,
+            _In_ const XMMATRIX& globalInverseTransform,
+            _Out_writes_(GetNumNodes()) XMMATRIX* aGlobalTransforms,
+            _Out_writes_(GetNumBones()) XMMATRIX* aBoneTransforms
+        ) const;
+        void GetBindPose(
+            _Out_writes_(GetNumNodes()) XMVECTOR* aTranslations,
+            _Out_writes_(GetNumNodes()) XMVECTOR* aRotations,
+            _Out_writes_(GetNumNodes()) XMVECTOR* aScales
+        ) const;
+
+        UINT FindNode(_In_ PCSTR pszName) const;
+        const std::string& GetNodeName(_In_ UINT uNode) const;
+        UINT GetParent(_In_ UINT uNode) const;
+        UINT GetBone(_In_ UINT uNode) const;
+        UINT GetHeight(_In_ UINT uNode) const;
+        UINT GetNumNodes() const;
+        UINT GetNumBones() const;
+
+    private:
+        static XMMATRIX composeTransform(_In_ FXMVECTOR translation, _In_ FXMVECTOR rotation, _In_ FXMVECTOR scaling);
+
+        void accumulateNode(_In_ UINT uNode, _In_ const XMMATRIX& localTransform, _In_ const XMMATRIX& globalInverseTransform, _Inout_ XMMATRIX* aGlobalTransforms, _Inout_ XMMATRIX* aBoneTransforms) const;
+
+    private:
+        std::vector<std::string> m_aNodeNames;
+        std::vector<UINT> m_aParents;
+        std::vector<UINT> m_aBones;
+        std::vector<UINT> m_aHeights;
+        std::vector<XMMATRIX> m_aLocalTransforms;
+        std::vector<XMMATRIX> m_aBoneOffsets;
+        std::vector<XMVECTOR> m_aBindTranslations;
+        std::vector<XMVECTOR> m_aBindRotations;
+        std::vector<XMVECTOR> m_aBindScales;
+        UINT m_uNumBones;
+    };
+}
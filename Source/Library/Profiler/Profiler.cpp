@@ -0,0 +1,232 @@
+#include "Profiler/Profiler.h"
+
+#include <fstream>
+#include <intrin.h>
+
+namespace library
+{
+    std::mutex Profiler::sm_threadBuffersMutex;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> Profiler::sm_aThreadBuffers;
+    thread_local ProfileThreadBuffer* Profiler::sm_pThreadBuffer = nullptr;
+    const UINT64 Profiler::sm_ullOriginTimestamp = __rdtsc();
+    const LONGLONG Profiler::sm_llOriginCounter = Profiler::readPerformanceCounter();
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::GetTimestamp
+
+      Summary:  Returns the time stamp counter, which is much cheaper to
+                read than the performance counter
+
+      Returns:  UINT64
+                  Current time stamp
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Profiler::GetTimestamp()
+    {
+        return __rdtsc();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::RecordEvent
+
+      Summary:  Adds a timed scope to the ring of the calling thread,
+                overwriting its oldest event when the ring is full
+
+      Args:     PCSTR pszCategory
+                  Category of the scope, must be a string literal
+                PCSTR pszName
+                  Name of the scope, must be a string literal
+                UINT64 ullBegin
+                  Time stamp when the scope began
+                UINT64 ullEnd
+                  Time stamp when the scope ended
+
+      Modifies: [sm_pThreadBuffer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::RecordEvent(_In_ PCSTR pszCategory, _In_ PCSTR pszName, _In_ UINT64 ullBegin, _In_ UINT64 ullEnd)
+    {
+        if (!sm_pThreadBuffer)
+        {
+            sm_pThreadBuffer = registerThread();
+        }
+
+        UINT64 uNumEvents = sm_pThreadBuffer->uNumEvents.load(std::memory_order_relaxed);
+        sm_pThreadBuffer->aEvents[uNumEvents & (EVENTS_PER_THREAD - 1u)] =
+        {
+            .pszCategory = pszCategory,
+            .pszName = pszName,
+            .ullBegin = ullBegin,
+            .ullEnd = ullEnd
+        };
+        sm_pThreadBuffer->uNumEvents.store(uNumEvents + 1u, std::memory_order_release);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::GetThreadEvents
+
+      Summary:  Copies the events in the ring of the calling thread,
+                oldest first
+
+      Args:     std::vector<ProfileEvent>& aEvents
+                  Receives the events, empty if the thread recorded none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::GetThreadEvents(_Out_ std::vector<ProfileEvent>& aEvents)
+    {
+        aEvents.clear();
+        if (sm_pThreadBuffer)
+        {
+            copyEvents(*sm_pThreadBuffer, aEvents);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::WriteChromeTrace
+
+      Summary:  Writes the events in the rings of every thread as a
+                Chrome trace, which chrome://tracing and Perfetto open.
+                Other threads should be idle while the trace is written,
+                or their oldest events may be overwritten while read
+
+      Args:     PCWSTR pszFileName
+                  Path of the trace file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Profiler::WriteChromeTrace(_In_ PCWSTR pszFileName)
+    {
+        std::ofstream file(std::filesystem::path(pszFileName), std::ios::trunc);
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        // Time stamp ticks per microsecond, measured over the whole run
+        LARGE_INTEGER frequency = {};
+        QueryPerformanceFrequency(&frequency);
+        UINT64 ullTimestamp = __rdtsc();
+        LONGLONG llCounter = readPerformanceCounter();
+        double dElapsedMicroseconds = static_cast<double>(llCounter - sm_llOriginCounter) * 1000000.0 / static_cast<double>(frequency.QuadPart);
+        double dTicksPerMicrosecond = dElapsedMicroseconds > 0.0 ? static_cast<double>(ullTimestamp - sm_ullOriginTimestamp) / dElapsedMicroseconds : 1.0;
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        file.setf(std::ios::fixed);
+        file.precision(3);
+
+        BOOL bFirstEvent = TRUE;
+        std::vector<ProfileEvent> aEvents;
+        std::lock_guard<std::mutex> lock(sm_threadBuffersMutex);
+        for (const std::unique_ptr<ProfileThreadBuffer>& threadBuffer : sm_aThreadBuffers)
+        {
+            copyEvents(*threadBuffer, aEvents);
+            for (const ProfileEvent& event : aEvents)
+            {
+                file << (bFirstEvent ? "\n" : ",\n")
+                    << "{\"name\":\"" << event.pszName
+                    << "\",\"cat\":\"" << event.pszCategory
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->dwThreadId
+                    << ",\"ts\":" << static_cast<double>(event.ullBegin - sm_ullOriginTimestamp) / dTicksPerMicrosecond
+                    << ",\"dur\":" << static_cast<double>(event.ullEnd - event.ullBegin) / dTicksPerMicrosecond
+                    << '}';
+                bFirstEvent = FALSE;
+            }
+        }
+        file << "\n]}\n";
+
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::registerThread
+
+      Summary:  Creates the ring of the calling thread. This is the only
+                place a lock is taken, once per thread
+
+      Modifies: [sm_aThreadBuffers].
+
+      Returns:  ProfileThreadBuffer*
+                  Ring of the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfileThreadBuffer* Profiler::registerThread()
+    {
+        std::unique_ptr<ProfileThreadBuffer> threadBuffer = std::make_unique<ProfileThreadBuffer>();
+        threadBuffer->dwThreadId = GetCurrentThreadId();
+        threadBuffer->aEvents = std::make_unique<ProfileEvent[]>(EVENTS_PER_THREAD);
+        threadBuffer->uNumEvents.store(0u, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(sm_threadBuffersMutex);
+        sm_aThreadBuffers.push_back(std::move(threadBuffer));
+        return sm_aThreadBuffers.back().get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::copyEvents
+
+      Summary:  Copies the complete events of a ring, oldest first. Only
+                the last EVENTS_PER_THREAD events are still in the ring
+
+      Args:     const ProfileThreadBuffer& threadBuffer
+                  Ring to copy the events of
+                std::vector<ProfileEvent>& aEvents
+                  Receives the events
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Profiler::copyEvents(_In_ const ProfileThreadBuffer& threadBuffer, _Out_ std::vector<ProfileEvent>& aEvents)
+    {
+        UINT64 uNumEvents = threadBuffer.uNumEvents.load(std::memory_order_acquire);
+        UINT64 uFirstEvent = uNumEvents > EVENTS_PER_THREAD ? uNumEvents - EVENTS_PER_THREAD : 0u;
+        aEvents.clear();
+        aEvents.reserve(static_cast<size_t>(uNumEvents - uFirstEvent));
+        for (UINT64 i = uFirstEvent; i < uNumEvents; ++i)
+        {
+            aEvents.push_back(threadBuffer.aEvents[i & (EVENTS_PER_THREAD - 1u)]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Profiler::readPerformanceCounter
+
+      Summary:  Returns the current value of the performance counter
+
+      Returns:  LONGLONG
+                  Performance counter
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LONGLONG Profiler::readPerformanceCounter()
+    {
+        LARGE_INTEGER counter = {};
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ProfileScope::ProfileScope
+
+      Summary:  Constructor, starts timing the scope
+
+      Args:     PCSTR pszCategory
+                  Category of the scope, must be a string literal
+                PCSTR pszName
+                  Name of the scope, must be a string literal
+
+      Modifies: [m_pszCategory, m_pszName, m_ullBegin].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfileScope::ProfileScope(_In_ PCSTR pszCategory, _In_ PCSTR pszName) :
+        m_pszCategory(pszCategory),
+        m_pszName(pszName),
+        m_ullBegin(Profiler::GetTimestamp())
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ProfileScope::~ProfileScope
+
+      Summary:  Destructor, records the timed scope
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ProfileScope::~ProfileScope()
+    {
+        Profiler::RecordEvent(m_pszCategory, m_pszName, m_ullBegin, Profiler::GetTimestamp());
+    }
+}
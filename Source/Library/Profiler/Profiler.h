@@ -0,0 +1,142 @@
+/*+===================================================================
+  File:      PROFILER.H
+
+  Summary:   Profiler header file contains declarations of Profiler
+             class that collects scoped CPU timings of every thread and
+             exports them as a Chrome trace, and of ProfileScope class
+             that times a scope.
+
+             Scopes are timed with PROFILE_SCOPE, which compiles to
+             nothing unless LIBRARY_PROFILING is defined. The Debug
+             configuration of the Library project defines it, and the
+             Release configuration defines it when the LibraryProfiling
+             property is true, so optimized builds can be profiled:
+               msbuild Build.sln -p:Configuration=Release
+                                 -p:LibraryProfiling=true
+
+  Classes: Profiler, ProfileScope
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include <atomic>
+#include <mutex>
+
+#if defined(LIBRARY_PROFILING)
+#define PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+#define PROFILE_SCOPE(pszCategory, pszName) library::ProfileScope PROFILE_CONCATENATE(profileScope, __LINE__)(pszCategory, pszName)
+#else
+#define PROFILE_SCOPE(pszCategory, pszName) ((void)0)
+#endif
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ProfileEvent
+
+        Summary:  One timed scope, the names are string literals so
+                  recording an event does not copy them
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfileEvent
+    {
+        PCSTR pszCategory;
+        PCSTR pszName;
+        UINT64 ullBegin;
+        UINT64 ullEnd;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ProfileThreadBuffer
+
+        Summary:  Ring of the latest events of one thread. Only the
+                  owning thread writes events, the exporter reads
+                  uNumEvents to know which events are complete
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ProfileThreadBuffer
+    {
+        DWORD dwThreadId;
+        std::unique_ptr<ProfileEvent[]> aEvents;
+        std::atomic<UINT64> uNumEvents;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Profiler
+
+      Summary:  Collects the timed scopes of every thread into rings
+                owned by the threads, so recording never takes a lock.
+                Time is read from the time stamp counter, which is
+                converted to microseconds against the performance
+                counter when the trace is written
+
+      Methods:  GetTimestamp
+                  Returns the current time stamp
+                RecordEvent
+                  Adds a timed scope to the ring of the calling thread
+                GetThreadEvents
+                  Returns the events in the ring of the calling thread
+                WriteChromeTrace
+                  Writes the recorded events as a Chrome trace
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Profiler final
+    {
+    public:
+        static constexpr const UINT64 EVENTS_PER_THREAD = 1ull << 16u;
+
+    public:
+        Profiler() = delete;
+        Profiler(const Profiler& other) = delete;
+        Profiler(Profiler&& other) = delete;
+        Profiler& operator=(const Profiler& other) = delete;
+        Profiler& operator=(Profiler&& other) = delete;
+        ~Profiler() = delete;
+
+        static UINT64 GetTimestamp();
+        static void RecordEvent(_In_ PCSTR pszCategory, _In_ PCSTR pszName, _In_ UINT64 ullBegin, _In_ UINT64 ullEnd);
+        static void GetThreadEvents(_Out_ std::vector<ProfileEvent>& aEvents);
+        static HRESULT WriteChromeTrace(_In_ PCWSTR pszFileName);
+
+    private:
+        static ProfileThreadBuffer* registerThread();
+        static void copyEvents(_In_ const ProfileThreadBuffer& threadBuffer, _Out_ std::vector<ProfileEvent>& aEvents);
+        static LONGLONG readPerformanceCounter();
+
+    private:
+        static std::mutex sm_threadBuffersMutex;
+        static std::vector<std::unique_ptr<ProfileThreadBuffer>> sm_aThreadBuffers;
+        static thread_local ProfileThreadBuffer* sm_pThreadBuffer;
+        static const UINT64 sm_ullOriginTimestamp;
+        static const LONGLONG sm_llOriginCounter;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ProfileScope
+
+      Summary:  Times its own lifetime and records it into the profiler.
+                Use PROFILE_SCOPE rather than this class, so the timing
+                is compiled out of builds without LIBRARY_PROFILING
+
+      Methods:  ProfileScope
+                  Constructor.
+                ~ProfileScope
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ProfileScope final
+    {
+    public:
+        ProfileScope(_In_ PCSTR pszCategory, _In_ PCSTR pszName);
+        ProfileScope(const ProfileScope& other) = delete;
+        ProfileScope(ProfileScope&& other) = delete;
+        ProfileScope& operator=(const ProfileScope& other) = delete;
+        ProfileScope& operator=(ProfileScope&& other) = delete;
+        ~ProfileScope();
+
+    private:
+        PCSTR m_pszCategory;
+        PCSTR m_pszName;
+        UINT64 m_ullBegin;
+    };
+}
@@ -0,0 +1,119 @@
+/*+===================================================================
+  File:      CAPTUREFORMAT.H
+
+  Summary:   CaptureFormat header file contains the layout of the frame
+             capture files written by FrameCapture and read by the
+             capture analyzer. The header only depends on the standard
+             library, so the analyzer builds without the Windows SDK.
+
+  Classes: CaptureFileHeader, CaptureCommand
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+namespace library
+{
+    /*--------------------------------------------------------------------
+      Frame capture file layout, every value is little endian:
+
+        CaptureFileHeader
+        uNumNames times:
+            uint32_t uLength, followed by uLength bytes of UTF-8 text
+        uNumCommands times:
+            CaptureCommand
+
+      Name 0 is always the empty string. Objects and passes refer to
+      the names by index.
+    --------------------------------------------------------------------*/
+    constexpr const uint32_t CAPTURE_FILE_MAGIC = 0x5041434Bu; // "KCAP"
+    constexpr const uint32_t CAPTURE_FILE_VERSION = 1u;
+    constexpr const uint32_t CAPTURE_INVALID_OBJECT = 0xFFFFFFFFu;
+
+    enum class eCaptureCommandType : uint8_t
+    {
+        BEGIN_PASS = 0,
+        SET_VERTEX_BUFFER,
+        SET_INDEX_BUFFER,
+        SET_INPUT_LAYOUT,
+        SET_PRIMITIVE_TOPOLOGY,
+        SET_VERTEX_SHADER,
+        SET_PIXEL_SHADER,
+        SET_VS_CONSTANT_BUFFER,
+        SET_PS_CONSTANT_BUFFER,
+        SET_PS_SHADER_RESOURCE,
+        SET_PS_SAMPLER,
+        SET_RENDER_TARGETS,
+        SET_DEPTH_STENCIL_STATE,
+        SET_VIEWPORT,
+        CLEAR_RENDER_TARGET,
+        CLEAR_DEPTH_STENCIL,
+        UPDATE_SUBRESOURCE,
+        MAP,
+        DRAW_INDEXED,
+        DRAW_INDEXED_INSTANCED,
+        DRAW,
+        SET_BLEND_STATE,
+        COPY_SUBRESOURCE_REGION,
+        SET_VS_SHADER_RESOURCE,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   CaptureFileHeader
+
+        Summary:  First bytes of a frame capture file
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CaptureFileHeader
+    {
+        uint32_t uMagic;
+        uint32_t uVersion;
+        uint32_t uNumNames;
+        uint32_t uNumCommands;
+    };
+    static_assert(sizeof(CaptureFileHeader) == 16u, "The capture file header must not be padded");
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   CaptureCommand
+
+        Summary:  One recorded call of the device context. The meaning
+                  of the fields depends on the type:
+
+                  BEGIN_PASS              uName = pass
+                  SET_VERTEX_BUFFER       uSlot, uObject, uArg0 = stride,
+                                          uArg1 = offset
+                  SET_*_CONSTANT_BUFFER,
+                  SET_*_SHADER_RESOURCE,
+                  SET_PS_SAMPLER          uSlot, uObject
+                  SET_RENDER_TARGETS      uObject = first render target,
+                                          uArg0 = depth stencil object,
+                                          uArg1 = number of render targets
+                  SET_PRIMITIVE_TOPOLOGY  uArg0 = topology
+                  SET_VIEWPORT            uArg0 = number of viewports
+                  UPDATE_SUBRESOURCE, MAP uObject, uArg0 = bytes uploaded
+                  DRAW_INDEXED*           uArg0 = index count,
+                                          uArg1 = instance count
+                  DRAW                    uArg0 = vertex count,
+                                          uArg1 = 1
+                  COPY_SUBRESOURCE_REGION uObject = destination,
+                                          uArg0 = source object,
+                                          uArg1 = destination x
+                  other SET_* and CLEAR_* uObject
+
+                  uObject identifies the Direct3D object within the
+                  capture, uName is the index of its name
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CaptureCommand
+    {
+        eCaptureCommandType type;
+        uint8_t uSlot;
+        uint16_t uReserved;
+        uint32_t uObject;
+        uint32_t uName;
+        uint32_t uArg0;
+        uint32_t uArg1;
+    };
+    static_assert(sizeof(CaptureCommand) == 20u, "The capture command must not be padded");
+}
@@ -0,0 +1,536 @@
+#include "Renderer/CommandContext.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::CommandContext
+
+      Summary:  Constructor
+
+      Modifies: [m_immediateContext, m_frameCapture, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CommandContext::CommandContext() :
+        m_immediateContext(nullptr),
+        m_frameCapture(),
+        m_statistics()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::Initialize
+
+      Summary:  Sets the immediate context the calls are forwarded to
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The Direct3D immediate context
+
+      Modifies: [m_immediateContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::Initialize(_In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        m_immediateContext = pImmediateContext;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::GetFrameCapture
+
+      Summary:  Returns the frame capture the calls are recorded into
+
+      Returns:  FrameCapture&
+                  Frame capture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FrameCapture& CommandContext::GetFrameCapture()
+    {
+        return m_frameCapture;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::GetStatistics
+
+      Summary:  Returns the statistics the calls are counted into
+
+      Returns:  const RenderStatistics&
+                  Render statistics
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderStatistics& CommandContext::GetStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::BeginFrame
+
+      Summary:  Marks the start of a frame
+
+      Modifies: [m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::BeginFrame()
+    {
+        m_statistics.BeginFrame();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::EndFrame
+
+      Summary:  Marks the end of a frame, adding its statistics to the
+                history
+
+      Modifies: [m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::EndFrame()
+    {
+        m_statistics.EndFrame();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::BeginPass
+
+      Summary:  Marks the start of a render pass, every following call
+                belongs to this pass
+
+      Args:     PCWSTR pszName
+                  Name of the pass
+
+      Modifies: [m_frameCapture, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::BeginPass(_In_ PCWSTR pszName)
+    {
+        m_statistics.BeginPass(pszName);
+        m_frameCapture.BeginPass(pszName);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::RecordSkippedDraws
+
+      Summary:  Counts draw calls the current pass did not submit since
+                their result was culled or already cached
+
+      Args:     UINT uNumDraws
+                  Number of skipped draw calls
+
+      Modifies: [m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::RecordSkippedDraws(_In_ UINT uNumDraws)
+    {
+        m_statistics.RecordSkippedDraws(uNumDraws);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::IASetVertexBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetVertexBuffers and
+                records one command per bound buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* puStrides, _In_reads_(uNumBuffers) const UINT* puOffsets)
+    {
+        m_immediateContext->IASetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+        m_statistics.RecordStateChanges(eStateCategory::INPUT_ASSEMBLER, uNumBuffers);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumBuffers; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_VERTEX_BUFFER, uStartSlot + i, ppVertexBuffers[i], puStrides[i], puOffsets[i]);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::IASetIndexBuffer
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetIndexBuffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        m_immediateContext->IASetIndexBuffer(pIndexBuffer, format, uOffset);
+        m_statistics.RecordStateChanges(eStateCategory::INPUT_ASSEMBLER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_INDEX_BUFFER, 0u, pIndexBuffer, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::IASetInputLayout
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetInputLayout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_immediateContext->IASetInputLayout(pInputLayout);
+        m_statistics.RecordStateChanges(eStateCategory::INPUT_ASSEMBLER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_INPUT_LAYOUT, 0u, pInputLayout, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::IASetPrimitiveTopology
+
+      Summary:  Forwards to ID3D11DeviceContext::IASetPrimitiveTopology
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_immediateContext->IASetPrimitiveTopology(topology);
+        m_statistics.RecordStateChanges(eStateCategory::INPUT_ASSEMBLER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_PRIMITIVE_TOPOLOGY, 0u, nullptr, static_cast<UINT>(topology), 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::VSSetShader
+
+      Summary:  Forwards to ID3D11DeviceContext::VSSetShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        m_immediateContext->VSSetShader(pVertexShader, ppClassInstances, uNumClassInstances);
+        m_statistics.RecordStateChanges(eStateCategory::SHADER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_VERTEX_SHADER, 0u, pVertexShader, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::VSSetConstantBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::VSSetConstantBuffers and
+                records one command per bound buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        m_statistics.RecordStateChanges(eStateCategory::CONSTANT_BUFFER, uNumBuffers);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumBuffers; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_VS_CONSTANT_BUFFER, uStartSlot + i, ppConstantBuffers[i], 0u, 0u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::VSSetShaderResources
+
+      Summary:  Forwards to ID3D11DeviceContext::VSSetShaderResources and
+                records one command per bound view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_immediateContext->VSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+        m_statistics.RecordStateChanges(eStateCategory::SHADER_RESOURCE, uNumViews);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumViews; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_VS_SHADER_RESOURCE, uStartSlot + i, ppShaderResourceViews[i], 0u, 0u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::PSSetShader
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        m_immediateContext->PSSetShader(pPixelShader, ppClassInstances, uNumClassInstances);
+        m_statistics.RecordStateChanges(eStateCategory::SHADER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_PIXEL_SHADER, 0u, pPixelShader, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::PSSetConstantBuffers
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetConstantBuffers and
+                records one command per bound buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        m_statistics.RecordStateChanges(eStateCategory::CONSTANT_BUFFER, uNumBuffers);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumBuffers; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_PS_CONSTANT_BUFFER, uStartSlot + i, ppConstantBuffers[i], 0u, 0u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::PSSetShaderResources
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShaderResources and
+                records one command per bound view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_immediateContext->PSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+        m_statistics.RecordStateChanges(eStateCategory::SHADER_RESOURCE, uNumViews);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumViews; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_PS_SHADER_RESOURCE, uStartSlot + i, ppShaderResourceViews[i], 0u, 0u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::PSSetSamplers
+
+      Summary:  Forwards to ID3D11DeviceContext::PSSetSamplers and
+                records one command per bound sampler
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        m_immediateContext->PSSetSamplers(uStartSlot, uNumSamplers, ppSamplers);
+        m_statistics.RecordStateChanges(eStateCategory::SAMPLER, uNumSamplers);
+        if (m_frameCapture.IsCapturing())
+        {
+            for (UINT i = 0u; i < uNumSamplers; ++i)
+            {
+                m_frameCapture.Record(eCaptureCommandType::SET_PS_SAMPLER, uStartSlot + i, ppSamplers[i], 0u, 0u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::RSSetViewports
+
+      Summary:  Forwards to ID3D11DeviceContext::RSSetViewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        m_immediateContext->RSSetViewports(uNumViewports, pViewports);
+        m_statistics.RecordStateChanges(eStateCategory::RASTERIZER, uNumViewports);
+        m_frameCapture.Record(eCaptureCommandType::SET_VIEWPORT, 0u, nullptr, uNumViewports, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::OMSetRenderTargets
+
+      Summary:  Forwards to ID3D11DeviceContext::OMSetRenderTargets
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_immediateContext->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+        m_statistics.RecordStateChanges(eStateCategory::OUTPUT_MERGER, 1u);
+        if (m_frameCapture.IsCapturing())
+        {
+            m_frameCapture.Record(
+                eCaptureCommandType::SET_RENDER_TARGETS,
+                0u,
+                uNumViews > 0u && ppRenderTargetViews ? ppRenderTargetViews[0] : nullptr,
+                m_frameCapture.GetObjectId(pDepthStencilView),
+                uNumViews
+            );
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::OMSetDepthStencilState
+
+      Summary:  Forwards to ID3D11DeviceContext::OMSetDepthStencilState
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef)
+    {
+        m_immediateContext->OMSetDepthStencilState(pDepthStencilState, uStencilRef);
+        m_statistics.RecordStateChanges(eStateCategory::OUTPUT_MERGER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_DEPTH_STENCIL_STATE, 0u, pDepthStencilState, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::OMSetBlendState
+
+      Summary:  Forwards to ID3D11DeviceContext::OMSetBlendState
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::OMSetBlendState(_In_opt_ ID3D11BlendState* pBlendState, _In_opt_ const FLOAT aBlendFactor[4], _In_ UINT uSampleMask)
+    {
+        m_immediateContext->OMSetBlendState(pBlendState, aBlendFactor, uSampleMask);
+        m_statistics.RecordStateChanges(eStateCategory::OUTPUT_MERGER, 1u);
+        m_frameCapture.Record(eCaptureCommandType::SET_BLEND_STATE, 0u, pBlendState, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::ClearRenderTargetView
+
+      Summary:  Forwards to ID3D11DeviceContext::ClearRenderTargetView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_immediateContext->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+        m_frameCapture.Record(eCaptureCommandType::CLEAR_RENDER_TARGET, 0u, pRenderTargetView, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::ClearDepthStencilView
+
+      Summary:  Forwards to ID3D11DeviceContext::ClearDepthStencilView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_immediateContext->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+        m_frameCapture.Record(eCaptureCommandType::CLEAR_DEPTH_STENCIL, 0u, pDepthStencilView, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::CopySubresourceRegion
+
+      Summary:  Forwards to ID3D11DeviceContext::CopySubresourceRegion
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::CopySubresourceRegion(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_ UINT uDstX, _In_ UINT uDstY, _In_ UINT uDstZ, _In_ ID3D11Resource* pSrcResource, _In_ UINT uSrcSubresource, _In_opt_ const D3D11_BOX* pSrcBox)
+    {
+        m_immediateContext->CopySubresourceRegion(pDstResource, uDstSubresource, uDstX, uDstY, uDstZ, pSrcResource, uSrcSubresource, pSrcBox);
+        if (m_frameCapture.IsCapturing())
+        {
+            m_frameCapture.Record(eCaptureCommandType::COPY_SUBRESOURCE_REGION, 0u, pDstResource, m_frameCapture.GetObjectId(pSrcResource), uDstX);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::UpdateSubresource
+
+      Summary:  Forwards to ID3D11DeviceContext::UpdateSubresource and
+                counts the number of uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch)
+    {
+        m_immediateContext->UpdateSubresource(pDstResource, uDstSubresource, pDstBox, pSrcData, uSrcRowPitch, uSrcDepthPitch);
+
+        UINT uBytes = getBufferSize(pDstResource, pDstBox);
+        if (isConstantBuffer(pDstResource))
+        {
+            m_statistics.RecordConstantBufferUpdate(uBytes);
+        }
+        else
+        {
+            m_statistics.RecordBufferUpload(uBytes);
+        }
+        m_frameCapture.Record(eCaptureCommandType::UPDATE_SUBRESOURCE, 0u, pDstResource, uBytes, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::Map
+
+      Summary:  Forwards to ID3D11DeviceContext::Map and counts the size
+                of the mapped buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT CommandContext::Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+    {
+        HRESULT hr = m_immediateContext->Map(pResource, uSubresource, mapType, uMapFlags, pMappedResource);
+        if (SUCCEEDED(hr))
+        {
+            // The whole mapped buffer is counted, the written range is unknown to the context
+            UINT uBytes = getBufferSize(pResource, nullptr);
+            if (isConstantBuffer(pResource))
+            {
+                m_statistics.RecordConstantBufferUpdate(uBytes);
+            }
+            else
+            {
+                m_statistics.RecordBufferUpload(uBytes);
+            }
+            m_frameCapture.Record(eCaptureCommandType::MAP, 0u, pResource, uBytes, 0u);
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::Unmap
+
+      Summary:  Forwards to ID3D11DeviceContext::Unmap
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource)
+    {
+        m_immediateContext->Unmap(pResource, uSubresource);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::Draw
+
+      Summary:  Forwards to ID3D11DeviceContext::Draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation)
+    {
+        m_immediateContext->Draw(uVertexCount, uStartVertexLocation);
+        m_statistics.RecordDraw(uVertexCount, 1u);
+        m_frameCapture.Record(eCaptureCommandType::DRAW, 0u, nullptr, uVertexCount, 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::DrawIndexed
+
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation)
+    {
+        m_immediateContext->DrawIndexed(uIndexCount, uStartIndexLocation, iBaseVertexLocation);
+        m_statistics.RecordDraw(uIndexCount, 1u);
+        m_frameCapture.Record(eCaptureCommandType::DRAW_INDEXED, 0u, nullptr, uIndexCount, 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::DrawIndexedInstanced
+
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexedInstanced
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandContext::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_immediateContext->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, iBaseVertexLocation, uStartInstanceLocation);
+        m_statistics.RecordDraw(uIndexCountPerInstance, uInstanceCount);
+        m_frameCapture.Record(eCaptureCommandType::DRAW_INDEXED_INSTANCED, 0u, nullptr, uIndexCountPerInstance, uInstanceCount);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::getBufferSize
+
+      Summary:  Returns the number of bytes written into a buffer
+
+      Args:     ID3D11Resource* pResource
+                  Resource that is written
+                const D3D11_BOX* pBox
+                  Written range, null for the whole resource
+
+      Returns:  UINT
+                  Bytes written, 0 for textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CommandContext::getBufferSize(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_BOX* pBox)
+    {
+        if (pBox)
+        {
+            return pBox->right - pBox->left;
+        }
+
+        D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+        pResource->GetType(&dimension);
+        if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+        {
+            return 0u;
+        }
+
+        D3D11_BUFFER_DESC desc = {};
+        static_cast<ID3D11Buffer*>(pResource)->GetDesc(&desc);
+        return desc.ByteWidth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandContext::isConstantBuffer
+
+      Summary:  Returns whether a resource is a constant buffer
+
+      Args:     ID3D11Resource* pResource
+                  Resource to check
+
+      Returns:  BOOL
+                  TRUE if the resource is bound as a constant buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL CommandContext::isConstantBuffer(_In_ ID3D11Resource* pResource)
+    {
+        D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+        pResource->GetType(&dimension);
+        if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+        {
+            return FALSE;
+        }
+
+        D3D11_BUFFER_DESC desc = {};
+        static_cast<ID3D11Buffer*>(pResource)->GetDesc(&desc);
+        return (desc.BindFlags & D3D11_BIND_CONSTANT_BUFFER) ? TRUE : FALSE;
+    }
+}
@@ -0,0 +1,110 @@
+/*+===================================================================
+  File:      COMMANDCONTEXT.H
+
+  Summary:   CommandContext header file contains declarations of
+             CommandContext class through which the renderer submits
+             its commands to the immediate context.
+
+  Classes: CommandContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/FrameCapture.h"
+#include "Renderer/RenderStatistics.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CommandContext
+
+      Summary:  Forwards the calls of the renderer to the immediate
+                context with the same arguments, counts them into the
+                render statistics, and records them into the frame
+                capture while a frame is being captured
+
+      Methods:  Initialize
+                  Sets the immediate context to forward the calls to
+                GetFrameCapture
+                  Returns the frame capture
+                GetStatistics
+                  Returns the render statistics
+                BeginFrame
+                  Marks the start of a frame
+                EndFrame
+                  Marks the end of a frame
+                BeginPass
+                  Marks the start of a render pass
+                RecordSkippedDraws
+                  Counts draws the pass did not need to submit
+                IASetVertexBuffers, IASetIndexBuffer, IASetInputLayout,
+                IASetPrimitiveTopology, VSSetShader, VSSetConstantBuffers,
+                VSSetShaderResources, PSSetShader, PSSetConstantBuffers,
+                PSSetShaderResources, PSSetSamplers, RSSetViewports, OMSetRenderTargets,
+                OMSetDepthStencilState, OMSetBlendState,
+                ClearRenderTargetView, ClearDepthStencilView,
+                CopySubresourceRegion, UpdateSubresource, Map, Unmap,
+                Draw, DrawIndexed, DrawIndexedInstanced
+                  Same as ID3D11DeviceContext
+                CommandContext
+                  Constructor.
+                ~CommandContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CommandContext final
+    {
+    public:
+        CommandContext();
+        CommandContext(const CommandContext& other) = delete;
+        CommandContext(CommandContext&& other) = delete;
+        CommandContext& operator=(const CommandContext& other) = delete;
+        CommandContext& operator=(CommandContext&& other) = delete;
+        ~CommandContext() = default;
+
+        void Initialize(_In_ ID3D11DeviceContext* pImmediateContext);
+        FrameCapture& GetFrameCapture();
+        const RenderStatistics& GetStatistics() const;
+
+        void BeginFrame();
+        void EndFrame();
+        void BeginPass(_In_ PCWSTR pszName);
+        void RecordSkippedDraws(_In_ UINT uNumDraws);
+
+        void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* puStrides, _In_reads_(uNumBuffers) const UINT* puOffsets);
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset);
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout);
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology);
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances);
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers);
+        void VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews);
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances);
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers);
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews);
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers);
+        void RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports);
+        void OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView);
+        void OMSetDepthStencilState(_In_opt_ ID3D11DepthStencilState* pDepthStencilState, _In_ UINT uStencilRef);
+        void OMSetBlendState(_In_opt_ ID3D11BlendState* pBlendState, _In_opt_ const FLOAT aBlendFactor[4], _In_ UINT uSampleMask);
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]);
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil);
+        void CopySubresourceRegion(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_ UINT uDstX, _In_ UINT uDstY, _In_ UINT uDstZ, _In_ ID3D11Resource* pSrcResource, _In_ UINT uSrcSubresource, _In_opt_ const D3D11_BOX* pSrcBox);
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch);
+        HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource);
+        void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource);
+        void Draw(_In_ UINT uVertexCount, _In_ UINT uStartVertexLocation);
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation);
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT iBaseVertexLocation, _In_ UINT uStartInstanceLocation);
+
+    private:
+        static UINT getBufferSize(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_BOX* pBox);
+        static BOOL isConstantBuffer(_In_ ID3D11Resource* pResource);
+
+    private:
+        ComPtr<ID3D11DeviceContext> m_immediateContext;
+        FrameCapture m_frameCapture;
+        RenderStatistics m_statistics;
+    };
+}
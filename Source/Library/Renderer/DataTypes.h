@@ -1,12 +1,12 @@
 #pragma once
 
-#include "Common.h"
+#include "CoreCommon.h"
 
 namespace library
 {
-#define NUM_LIGHTS (2)
 #define MAX_NUM_BONES (256)
-#define MAX_NUM_BONES_PER_VERTEX (16)
+#define MAX_NUM_BONES_PER_VERTEX (4)
+#define NUM_SHADOW_CASCADES (4)
 
 	struct SimpleVertex
 	{
@@ -15,15 +15,30 @@ namespace library
 		XMFLOAT3 Normal;
 	};
 
+	struct QuantizedPosition
+	{
+		SHORT x;
+		SHORT y;
+		SHORT z;
+		SHORT w;
+	};
+
 	struct InstanceData
 	{
 		XMMATRIX Transformation;
 	};
 
+	struct BakedInstanceData
+	{
+		XMMATRIX Transformation;
+		UINT uFrameOffset;
+		UINT aPadding[3];
+	};
+
 	struct AnimationData
 	{
-		XMUINT4 aBoneIndices;
-		XMFLOAT4 aBoneWeights;
+		BYTE aBoneIndices[MAX_NUM_BONES_PER_VERTEX];
+		BYTE aBoneWeights[MAX_NUM_BONES_PER_VERTEX];
 	};
 
 	struct NormalData
@@ -50,9 +65,9 @@ namespace library
 		BOOL HasNormalMap;
 	};
 
-	struct CBSkinning
+	struct PackedBoneTransform
 	{
-		XMMATRIX BoneTransforms[MAX_NUM_BONES];
+		XMFLOAT4A Rows[3];
 	};
 
 	struct StrPointLight
@@ -64,9 +79,12 @@ namespace library
 
 	struct CBLights
 	{
-		StrPointLight PointLights[NUM_LIGHTS];
-		XMMATRIX LightViews[NUM_LIGHTS];
-		XMMATRIX LightProjections[NUM_LIGHTS];
+		StrPointLight ShadowLight;
+		XMMATRIX LightView;
+		XMMATRIX CascadeProjections[NUM_SHADOW_CASCADES];
+		XMFLOAT4 CascadeBiases;
+		XMUINT4 NumClusters;
+		XMFLOAT4 ClusterSlices;
 	};
 
 	struct CBShadowMatrix
@@ -74,8 +92,15 @@ namespace library
 		XMMATRIX World;
 		XMMATRIX View;
 		XMMATRIX Projection;
+		XMFLOAT4 PositionScale;
+		XMFLOAT4 PositionOffset;
 		BOOL IsVoxel;
 	};
 
+	struct CBUpscale
+	{
+		XMFLOAT4 TexCoordScale;
+	};
+
 	
 }
\ No newline at end of file
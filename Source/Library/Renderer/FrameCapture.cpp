@@ -0,0 +1,288 @@
+#include "Renderer/FrameCapture.h"
+
+#include <fstream>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::FrameCapture
+
+      Summary:  Constructor
+
+      Modifies: [m_aCommands, m_aNames, m_objectIds, m_objectNames,
+                 m_bCapturing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FrameCapture::FrameCapture() :
+        m_aCommands(),
+        m_aNames(),
+        m_objectIds(),
+        m_objectNames(),
+        m_bCapturing(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::Begin
+
+      Summary:  Discards the previous capture and starts recording
+
+      Modifies: [m_aCommands, m_aNames, m_objectIds, m_objectNames,
+                 m_bCapturing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameCapture::Begin()
+    {
+        m_aCommands.clear();
+        m_aNames.clear();
+        m_objectIds.clear();
+        m_objectNames.clear();
+
+        // Name 0 is the name of every unnamed object
+        m_aNames.push_back(std::string());
+        m_bCapturing = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::End
+
+      Summary:  Stops recording and writes the names and commands into
+                a capture file
+
+      Args:     PCWSTR pszFileName
+                  Path of the capture file
+
+      Modifies: [m_bCapturing].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT FrameCapture::End(_In_ PCWSTR pszFileName)
+    {
+        m_bCapturing = FALSE;
+
+        std::ofstream file(std::filesystem::path(pszFileName), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        CaptureFileHeader header =
+        {
+            .uMagic = CAPTURE_FILE_MAGIC,
+            .uVersion = CAPTURE_FILE_VERSION,
+            .uNumNames = static_cast<uint32_t>(m_aNames.size()),
+            .uNumCommands = static_cast<uint32_t>(m_aCommands.size())
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const std::string& name : m_aNames)
+        {
+            uint32_t uLength = static_cast<uint32_t>(name.size());
+            file.write(reinterpret_cast<const char*>(&uLength), sizeof(uLength));
+            file.write(name.data(), uLength);
+        }
+
+        file.write(reinterpret_cast<const char*>(m_aCommands.data()), sizeof(CaptureCommand) * m_aCommands.size());
+
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::IsCapturing
+
+      Summary:  Returns whether a frame is being recorded
+
+      Returns:  BOOL
+                  Whether a frame is being recorded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL FrameCapture::IsCapturing() const
+    {
+        return m_bCapturing;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::SetObjectName
+
+      Summary:  Names a Direct3D object for the commands recorded after
+                this call. An object named twice keeps the first name,
+                so shared buffers are named after their first owner
+
+      Args:     const void* pObject
+                  Direct3D object to name
+                PCWSTR pszName
+                  Name of the object
+
+      Modifies: [m_aNames, m_objectNames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameCapture::SetObjectName(_In_opt_ const void* pObject, _In_ PCWSTR pszName)
+    {
+        if (!m_bCapturing || !pObject || m_objectNames.contains(pObject))
+        {
+            return;
+        }
+
+        m_objectNames[pObject] = addName(pszName);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::GetObjectId
+
+      Summary:  Returns the identifier of a Direct3D object, assigning
+                the next identifier to objects seen for the first time
+
+      Args:     const void* pObject
+                  Direct3D object, may be null
+
+      Modifies: [m_objectIds].
+
+      Returns:  UINT
+                  Identifier of the object, CAPTURE_INVALID_OBJECT for
+                  null
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameCapture::GetObjectId(_In_opt_ const void* pObject)
+    {
+        if (!pObject)
+        {
+            return CAPTURE_INVALID_OBJECT;
+        }
+
+        auto it = m_objectIds.find(pObject);
+        if (it != m_objectIds.end())
+        {
+            return it->second;
+        }
+
+        UINT uId = static_cast<UINT>(m_objectIds.size());
+        m_objectIds.emplace(pObject, uId);
+        return uId;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::BeginPass
+
+      Summary:  Records the start of a render pass. Every command until
+                the next pass belongs to this pass
+
+      Args:     PCWSTR pszName
+                  Name of the pass
+
+      Modifies: [m_aCommands, m_aNames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameCapture::BeginPass(_In_ PCWSTR pszName)
+    {
+        if (!m_bCapturing)
+        {
+            return;
+        }
+
+        m_aCommands.push_back(
+            {
+                .type = eCaptureCommandType::BEGIN_PASS,
+                .uSlot = 0u,
+                .uReserved = 0u,
+                .uObject = CAPTURE_INVALID_OBJECT,
+                .uName = addName(pszName),
+                .uArg0 = 0u,
+                .uArg1 = 0u
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::Record
+
+      Summary:  Records a call of the device context
+
+      Args:     eCaptureCommandType type
+                  Type of the call
+                UINT uSlot
+                  Slot the object is bound to
+                const void* pObject
+                  Direct3D object of the call, may be null
+                UINT uArg0
+                  First argument, see CaptureCommand
+                UINT uArg1
+                  Second argument, see CaptureCommand
+
+      Modifies: [m_aCommands, m_objectIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameCapture::Record(_In_ eCaptureCommandType type, _In_ UINT uSlot, _In_opt_ const void* pObject, _In_ UINT uArg0, _In_ UINT uArg1)
+    {
+        if (!m_bCapturing)
+        {
+            return;
+        }
+
+        auto itName = pObject ? m_objectNames.find(pObject) : m_objectNames.end();
+        m_aCommands.push_back(
+            {
+                .type = type,
+                .uSlot = static_cast<uint8_t>(uSlot),
+                .uReserved = 0u,
+                .uObject = GetObjectId(pObject),
+                .uName = itName != m_objectNames.end() ? itName->second : 0u,
+                .uArg0 = uArg0,
+                .uArg1 = uArg1
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::GetCommands
+
+      Summary:  Returns the recorded commands
+
+      Returns:  const std::vector<CaptureCommand>&
+                  Commands in submission order
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<CaptureCommand>& FrameCapture::GetCommands() const
+    {
+        return m_aCommands;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::GetNames
+
+      Summary:  Returns the recorded names
+
+      Returns:  const std::vector<std::string>&
+                  UTF-8 names indexed by CaptureCommand::uName
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<std::string>& FrameCapture::GetNames() const
+    {
+        return m_aNames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameCapture::addName
+
+      Summary:  Appends a name converted to UTF-8
+
+      Args:     PCWSTR pszName
+                  Name to append
+
+      Modifies: [m_aNames].
+
+      Returns:  UINT
+                  Index of the name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrameCapture::addName(_In_ PCWSTR pszName)
+    {
+        std::string name;
+        INT iLength = WideCharToMultiByte(CP_UTF8, 0, pszName, -1, nullptr, 0, nullptr, nullptr);
+        if (iLength > 1)
+        {
+            name.resize(static_cast<size_t>(iLength));
+            WideCharToMultiByte(CP_UTF8, 0, pszName, -1, name.data(), iLength, nullptr, nullptr);
+            // Drop the terminating null character written by the conversion
+            name.pop_back();
+        }
+
+        m_aNames.push_back(std::move(name));
+        return static_cast<UINT>(m_aNames.size() - 1u);
+    }
+}
@@ -0,0 +1,86 @@
+/*+===================================================================
+  File:      FRAMECAPTURE.H
+
+  Summary:   FrameCapture header file contains declarations of
+             FrameCapture class used to record the command stream of
+             a frame into a capture file.
+
+  Classes: FrameCapture
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/CaptureFormat.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    FrameCapture
+
+      Summary:  Records the calls of the device context between Begin
+                and End, and writes them into a capture file in the
+                format of CaptureFormat.h. Direct3D objects are given
+                an identifier the first time they are recorded, and
+                objects named with SetObjectName carry that name into
+                the file
+
+      Methods:  Begin
+                  Starts recording a frame
+                End
+                  Stops recording and writes the capture file
+                IsCapturing
+                  Returns whether a frame is being recorded
+                SetObjectName
+                  Names a Direct3D object in the capture
+                GetObjectId
+                  Returns the identifier of a Direct3D object
+                BeginPass
+                  Records the start of a render pass
+                Record
+                  Records a call of the device context
+                GetCommands
+                  Returns the recorded commands
+                GetNames
+                  Returns the recorded names
+                FrameCapture
+                  Constructor.
+                ~FrameCapture
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class FrameCapture final
+    {
+    public:
+        FrameCapture();
+        FrameCapture(const FrameCapture& other) = delete;
+        FrameCapture(FrameCapture&& other) = delete;
+        FrameCapture& operator=(const FrameCapture& other) = delete;
+        FrameCapture& operator=(FrameCapture&& other) = delete;
+        ~FrameCapture() = default;
+
+        void Begin();
+        HRESULT End(_In_ PCWSTR pszFileName);
+        BOOL IsCapturing() const;
+
+        void SetObjectName(_In_opt_ const void* pObject, _In_ PCWSTR pszName);
+        UINT GetObjectId(_In_opt_ const void* pObject);
+
+        void BeginPass(_In_ PCWSTR pszName);
+        void Record(_In_ eCaptureCommandType type, _In_ UINT uSlot, _In_opt_ const void* pObject, _In_ UINT uArg0, _In_ UINT uArg1);
+
+        const std::vector<CaptureCommand>& GetCommands() const;
+        const std::vector<std::string>& GetNames() const;
+
+    private:
+        UINT addName(_In_ PCWSTR pszName);
+
+    private:
+        std::vector<CaptureCommand> m_aCommands;
+        std::vector<std::string> m_aNames;
+        std::unordered_map<const void*, UINT> m_objectIds;
+        std::unordered_map<const void*, UINT> m_objectNames;
+        BOOL m_bCapturing;
+    };
+}
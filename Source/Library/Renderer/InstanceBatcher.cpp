@@ -0,0 +1,313 @@
+#include "Renderer/InstanceBatcher.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::InstanceBatcher
+
+      Summary:  Constructor
+
+      Modifies: [m_aEntries, m_aGroupEntries, m_aGroups, m_aInstances,
+                 m_aInstanceDepths, m_aSortOrder, m_aSortedInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    InstanceBatcher::InstanceBatcher() :
+        m_aEntries(),
+        m_aGroupEntries(),
+        m_aGroups(),
+        m_aInstances(),
+        m_aInstanceDepths(),
+        m_aSortOrder(),
+        m_aSortedInstances()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::Reset
+
+      Summary:  Removes every renderable, group and instance while
+                keeping the allocated memory for the next frame
+
+      Modifies: [m_aEntries, m_aGroupEntries, m_aGroups, m_aInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBatcher::Reset()
+    {
+        m_aEntries.clear();
+        m_aGroupEntries.clear();
+        m_aGroups.clear();
+        m_aInstances.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::AddRenderable
+
+      Summary:  Adds a renderable. Renderables share geometry when they
+                use the same vertex and index data, as the cubes do
+
+      Args:     PCWSTR pszName
+                  Name that orders the renderable, must outlive Build
+                Renderable& renderable
+                  Renderable to draw this frame
+
+      Modifies: [m_aEntries].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBatcher::AddRenderable(_In_ PCWSTR pszName, _In_ Renderable& renderable)
+    {
+        m_aEntries.push_back({ .pszName = pszName, .pRenderable = &renderable, .pModelPath = nullptr, .uGroup = 0u });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::AddModel
+
+      Summary:  Adds a model. Models share geometry when they are loaded
+                from the same file, the buffers of the first model of a
+                group are used to draw every instance
+
+      Args:     PCWSTR pszName
+                  Name that orders the model, must outlive Build
+                Model& model
+                  Model without skinning to draw this frame
+
+      Modifies: [m_aEntries].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBatcher::AddModel(_In_ PCWSTR pszName, _In_ Model& model)
+    {
+        m_aEntries.push_back({ .pszName = pszName, .pRenderable = &model, .pModelPath = &model.GetFilePath(), .uGroup = 0u });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::Build
+
+      Summary:  Orders the renderables by name, keeping the order in
+                which they were added for equal names, assigns each one
+                to the first compatible group and packs the world
+                matrices of every group contiguously. Groups are ordered
+                by their first renderable
+
+      Modifies: [m_aEntries, m_aGroupEntries, m_aGroups, m_aInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBatcher::Build()
+    {
+        std::stable_sort(m_aEntries.begin(), m_aEntries.end(),
+            [](const Entry& a, const Entry& b) { return wcscmp(a.pszName, b.pszName) < 0; });
+
+        m_aGroupEntries.clear();
+        m_aGroups.clear();
+        for (UINT i = 0u; i < m_aEntries.size(); ++i)
+        {
+            Entry& entry = m_aEntries[i];
+
+            UINT uGroup = 0u;
+            while (uGroup < m_aGroupEntries.size() && !isSameGroup(m_aEntries[m_aGroupEntries[uGroup]], entry))
+            {
+                ++uGroup;
+            }
+
+            if (uGroup == m_aGroupEntries.size())
+            {
+                m_aGroupEntries.push_back(i);
+                m_aGroups.push_back({ .pRenderable = entry.pRenderable, .uFirstInstance = 0u, .uNumInstances = 0u });
+            }
+
+            entry.uGroup = uGroup;
+            ++m_aGroups[uGroup].uNumInstances;
+        }
+
+        UINT uFirstInstance = 0u;
+        for (InstanceGroup& group : m_aGroups)
+        {
+            group.uFirstInstance = uFirstInstance;
+            uFirstInstance += group.uNumInstances;
+            group.uNumInstances = 0u;
+        }
+
+        m_aInstances.resize(uFirstInstance);
+        for (const Entry& entry : m_aEntries)
+        {
+            InstanceGroup& group = m_aGroups[entry.uGroup];
+            m_aInstances[group.uFirstInstance + group.uNumInstances].Transformation = entry.pRenderable->GetWorldMatrix();
+            ++group.uNumInstances;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::SortFrontToBack
+
+      Summary:  Orders the instances of every group by the view depth of
+                their origin, nearest first, then orders the groups by
+                their nearest instance so that depth testing rejects as
+                many hidden pixels as possible. Instances and groups at
+                the same depth keep their order. Must be called after
+                Build
+
+      Args:     const XMMATRIX& view
+                  View matrix of the camera
+
+      Modifies: [m_aGroups, m_aInstances, m_aInstanceDepths,
+                 m_aSortOrder, m_aSortedInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBatcher::SortFrontToBack(_In_ const XMMATRIX& view)
+    {
+        m_aInstanceDepths.resize(m_aInstances.size());
+        for (UINT i = 0u; i < m_aInstances.size(); ++i)
+        {
+            m_aInstanceDepths[i] = XMVectorGetZ(XMVector3Transform(m_aInstances[i].Transformation.r[3], view));
+        }
+
+        m_aSortOrder.resize(m_aInstances.size());
+        m_aSortedInstances.resize(m_aInstances.size());
+        for (const InstanceGroup& group : m_aGroups)
+        {
+            auto itFirst = m_aSortOrder.begin() + group.uFirstInstance;
+            auto itLast = itFirst + group.uNumInstances;
+            for (UINT i = group.uFirstInstance; i < group.uFirstInstance + group.uNumInstances; ++i)
+            {
+                m_aSortOrder[i] = i;
+            }
+
+            std::stable_sort(itFirst, itLast,
+                [this](UINT uLeft, UINT uRight) { return m_aInstanceDepths[uLeft] < m_aInstanceDepths[uRight]; });
+
+            for (UINT i = group.uFirstInstance; i < group.uFirstInstance + group.uNumInstances; ++i)
+            {
+                m_aSortedInstances[i] = m_aInstances[m_aSortOrder[i]];
+            }
+        }
+        m_aInstances.swap(m_aSortedInstances);
+
+        // The first instance of a sorted group is its nearest one
+        std::stable_sort(m_aGroups.begin(), m_aGroups.end(),
+            [this](const InstanceGroup& left, const InstanceGroup& right)
+            {
+                return m_aInstanceDepths[m_aSortOrder[left.uFirstInstance]] < m_aInstanceDepths[m_aSortOrder[right.uFirstInstance]];
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::GetGroups
+
+      Summary:  Returns the groups in draw order
+
+      Returns:  const std::vector<InstanceBatcher::InstanceGroup>&
+                  Groups
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<InstanceBatcher::InstanceGroup>& InstanceBatcher::GetGroups() const
+    {
+        return m_aGroups;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::GetInstances
+
+      Summary:  Returns the world matrices of every group, packed in
+                draw order
+
+      Returns:  const std::vector<InstanceData>&
+                  Instance data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<InstanceData>& InstanceBatcher::GetInstances() const
+    {
+        return m_aInstances;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::GetNumInstances
+
+      Summary:  Returns the number of packed instances
+
+      Returns:  UINT
+                  Number of instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstanceBatcher::GetNumInstances() const
+    {
+        return static_cast<UINT>(m_aInstances.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBatcher::isSameGroup
+
+      Summary:  Returns whether two renderables can be drawn by the
+                same instanced draw
+
+      Args:     const Entry& a
+                  First renderable
+                const Entry& b
+                  Second renderable
+
+      Returns:  BOOL
+                  Whether the renderables share geometry, materials,
+                  shaders, output color and normal map usage
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstanceBatcher::isSameGroup(_In_ const Entry& a, _In_ const Entry& b)
+    {
+        const Renderable& renderableA = *a.pRenderable;
+        const Renderable& renderableB = *b.pRenderable;
+
+        if (a.pModelPath || b.pModelPath)
+        {
+            if (!a.pModelPath || !b.pModelPath || *a.pModelPath != *b.pModelPath)
+            {
+                return FALSE;
+            }
+        }
+        else if (renderableA.getVertices() != renderableB.getVertices() || renderableA.getIndices() != renderableB.getIndices())
+        {
+            return FALSE;
+        }
+
+        if (renderableA.GetNumVertices() != renderableB.GetNumVertices() || renderableA.GetNumIndices() != renderableB.GetNumIndices())
+        {
+            return FALSE;
+        }
+
+        if (renderableA.m_vertexShader != renderableB.m_vertexShader || renderableA.m_pixelShader != renderableB.m_pixelShader)
+        {
+            return FALSE;
+        }
+
+        const XMFLOAT4& colorA = renderableA.GetOutputColor();
+        const XMFLOAT4& colorB = renderableB.GetOutputColor();
+        if (colorA.x != colorB.x || colorA.y != colorB.y || colorA.z != colorB.z || colorA.w != colorB.w)
+        {
+            return FALSE;
+        }
+
+        if (renderableA.HasNormalMap() != renderableB.HasNormalMap() || renderableA.HasTexture() != renderableB.HasTexture())
+        {
+            return FALSE;
+        }
+
+        if (renderableA.m_aMeshes.size() != renderableB.m_aMeshes.size())
+        {
+            return FALSE;
+        }
+
+        for (size_t i = 0u; i < renderableA.m_aMeshes.size(); ++i)
+        {
+            const Renderable::BasicMeshEntry& meshA = renderableA.m_aMeshes[i];
+            const Renderable::BasicMeshEntry& meshB = renderableB.m_aMeshes[i];
+            if (meshA.uNumIndices != meshB.uNumIndices || meshA.uBaseIndex != meshB.uBaseIndex || meshA.uBaseVertex != meshB.uBaseVertex)
+            {
+                return FALSE;
+            }
+
+            BOOL bHasMaterialA = meshA.uMaterialIndex < renderableA.m_aMaterials.size();
+            BOOL bHasMaterialB = meshB.uMaterialIndex < renderableB.m_aMaterials.size();
+            if (bHasMaterialA != bHasMaterialB)
+            {
+                return FALSE;
+            }
+
+            // Models loaded from the same file own equivalent copies of the same materials
+            if (bHasMaterialA && !a.pModelPath
+                && renderableA.m_aMaterials[meshA.uMaterialIndex] != renderableB.m_aMaterials[meshB.uMaterialIndex])
+            {
+                return FALSE;
+            }
+        }
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,105 @@
+/*+===================================================================
+  File:      INSTANCEBATCHER.H
+
+  Summary:   InstanceBatcher header file contains declarations of
+             InstanceBatcher class used to group renderables that are
+             drawn with the same mesh, materials and shaders into
+             instanced draws.
+
+  Classes: InstanceBatcher
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    InstanceBatcher
+
+      Summary:  Collects the renderables of a frame and groups the ones
+                that share geometry, materials, shaders, output color
+                and normal map usage. The world matrices of every group
+                are packed contiguously so that each group is drawn with
+                a single instanced draw. Renderables are ordered by
+                their names, so the groups and the instance order do not
+                depend on the iteration order of the scene containers.
+                Grouping does not touch Direct3D
+
+      Methods:  Reset
+                  Removes every renderable of the previous frame
+                AddRenderable
+                  Adds a renderable whose geometry is identified by its
+                  vertex data
+                AddModel
+                  Adds a model whose geometry is identified by its file
+                Build
+                  Groups the renderables and packs the instance data
+                SortFrontToBack
+                  Orders the instances and groups by view depth
+                GetGroups
+                  Returns the groups in draw order
+                GetInstances
+                  Returns the packed instance data
+                GetNumInstances
+                  Returns the number of packed instances
+                InstanceBatcher
+                  Constructor.
+                ~InstanceBatcher
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class InstanceBatcher final
+    {
+    public:
+        struct InstanceGroup
+        {
+            Renderable* pRenderable;
+            UINT uFirstInstance;
+            UINT uNumInstances;
+        };
+
+    public:
+        InstanceBatcher();
+        InstanceBatcher(const InstanceBatcher& other) = delete;
+        InstanceBatcher(InstanceBatcher&& other) = delete;
+        InstanceBatcher& operator=(const InstanceBatcher& other) = delete;
+        InstanceBatcher& operator=(InstanceBatcher&& other) = delete;
+        ~InstanceBatcher() = default;
+
+        void Reset();
+        void AddRenderable(_In_ PCWSTR pszName, _In_ Renderable& renderable);
+        void AddModel(_In_ PCWSTR pszName, _In_ Model& model);
+        void Build();
+        void SortFrontToBack(_In_ const XMMATRIX& view);
+
+        const std::vector<InstanceGroup>& GetGroups() const;
+        const std::vector<InstanceData>& GetInstances() const;
+        UINT GetNumInstances() const;
+
+    private:
+        struct Entry
+        {
+            PCWSTR pszName;
+            Renderable* pRenderable;
+            const std::filesystem::path* pModelPath;
+            UINT uGroup;
+        };
+
+        static BOOL isSameGroup(_In_ const Entry& a, _In_ const Entry& b);
+
+    private:
+        std::vector<Entry> m_aEntries;
+        std::vector<UINT> m_aGroupEntries;
+        std::vector<InstanceGroup> m_aGroups;
+        std::vector<InstanceData> m_aInstances;
+        std::vector<FLOAT> m_aInstanceDepths;
+        std::vector<UINT> m_aSortOrder;
+        std::vector<InstanceData> m_aSortedInstances;
+    };
+}
@@ -77,17 +77,31 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer, and grows the local bounds
+                to enclose every instance
 
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_localBounds].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT InstancedRenderable::initializeInstance(_In_ ID3D11Device* pDevice) {
+        // The instance transforms are applied before the world matrix, so the bounds of the mesh are merged over them
+        if (!m_aInstanceData.empty())
+        {
+            BoundingBox meshBounds = m_localBounds;
+            meshBounds.Transform(m_localBounds, m_aInstanceData[0].Transformation);
+            for (size_t i = 1u; i < m_aInstanceData.size(); ++i)
+            {
+                BoundingBox instanceBounds;
+                meshBounds.Transform(instanceBounds, m_aInstanceData[i].Transformation);
+                BoundingBox::CreateMerged(m_localBounds, m_localBounds, instanceBounds);
+            }
+        }
+
         //create instance buffer
         D3D11_BUFFER_DESC bd = {
             .ByteWidth = sizeof(InstanceData) * GetNumInstances(),
@@ -0,0 +1,328 @@
+#include "Renderer/LightClusterer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::LightClusterer
+
+      Summary:  Constructor
+
+      Args:     const LightClustererDesc& desc
+                  Size of the cluster grid
+
+      Modifies: [m_desc, m_uNumGroupsPerSlice, m_projection,
+                  m_sliceScale, m_sliceBias, m_aSliceDepths,
+                  m_aClusterBounds, m_aViewLights, m_aSlices,
+                  m_aClusterLights, m_aClusters, m_aLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LightClusterer::LightClusterer(_In_ const LightClustererDesc& desc) :
+        m_desc(desc),
+        m_uNumGroupsPerSlice((desc.uNumClustersX * desc.uNumClustersY + 3u) / 4u),
+        m_projection(),
+        m_sliceScale(0.0f),
+        m_sliceBias(0.0f),
+        m_aSliceDepths(),
+        m_aClusterBounds(),
+        m_aViewLights(),
+        m_aSlices(desc.uNumClustersZ),
+        m_aClusterLights(desc.uNumClustersX * desc.uNumClustersY * desc.uNumClustersZ),
+        m_aClusters(desc.uNumClustersX * desc.uNumClustersY * desc.uNumClustersZ),
+        m_aLightIndices()
+    {
+        std::iota(m_aSlices.begin(), m_aSlices.end(), 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetDesc
+
+      Summary:  Returns the description
+
+      Returns:  const LightClustererDesc&
+                  Size of the cluster grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const LightClustererDesc& LightClusterer::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetNumClusters
+
+      Summary:  Returns the number of clusters
+
+      Returns:  UINT
+                  Number of clusters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusterer::GetNumClusters() const
+    {
+        return static_cast<UINT>(m_aClusters.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::Build
+
+      Summary:  Moves the lights into view space and assigns every
+                light to the clusters its sphere overlaps. The light
+                indices of a cluster are in increasing order
+
+      Args:     const XMMATRIX& view
+                  View matrix
+                const XMMATRIX& projection
+                  Left handed perspective projection matrix with the
+                  depth from 0 to 1 and a finite far plane
+                const std::vector<XMFLOAT4>& aLightSpheres
+                  World space position of every light in xyz and its
+                  attenuation distance in w
+
+      Modifies: [m_projection, m_aViewLights, m_aClusterLights,
+                  m_aClusters, m_aLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusterer::Build(_In_ const XMMATRIX& view, _In_ const XMMATRIX& projection, _In_ const std::vector<XMFLOAT4>& aLightSpheres)
+    {
+        XMFLOAT4X4 projectionValues;
+        XMStoreFloat4x4(&projectionValues, projection);
+        if (m_aClusterBounds.empty() || memcmp(&projectionValues, &m_projection, sizeof(XMFLOAT4X4)) != 0)
+        {
+            m_projection = projectionValues;
+            updateClusterBounds(m_projection);
+        }
+
+        m_aViewLights.resize(aLightSpheres.size());
+        for (size_t i = 0u; i < aLightSpheres.size(); ++i)
+        {
+            XMVECTOR center = XMVector3TransformCoord(XMLoadFloat4(&aLightSpheres[i]), view);
+            XMStoreFloat4(&m_aViewLights[i], XMVectorSetW(center, aLightSpheres[i].w));
+        }
+
+        std::for_each(std::execution::par, m_aSlices.begin(), m_aSlices.end(), [this](UINT uSlice) { assignSlice(uSlice); });
+
+        UINT uOffset = 0u;
+        for (size_t i = 0u; i < m_aClusterLights.size(); ++i)
+        {
+            UINT uCount = static_cast<UINT>(m_aClusterLights[i].size());
+            m_aClusters[i] = XMUINT2(uOffset, uCount);
+            uOffset += uCount;
+        }
+
+        m_aLightIndices.resize(uOffset);
+        for (size_t i = 0u; i < m_aClusterLights.size(); ++i)
+        {
+            std::copy(m_aClusterLights[i].begin(), m_aClusterLights[i].end(), m_aLightIndices.begin() + m_aClusters[i].x);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetClusters
+
+      Summary:  Returns the offset into the light indices and the number
+                of lights of every cluster computed by the last Build
+
+      Returns:  const std::vector<XMUINT2>&
+                  Offset in x and count in y of every cluster
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<XMUINT2>& LightClusterer::GetClusters() const
+    {
+        return m_aClusters;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetLightIndices
+
+      Summary:  Returns the light indices of all clusters computed by
+                the last Build, one cluster after another
+
+      Returns:  const std::vector<UINT>&
+                  Indices into the lights passed to Build
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<UINT>& LightClusterer::GetLightIndices() const
+    {
+        return m_aLightIndices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetSliceScale
+
+      Summary:  Returns the scale of the slice lookup. The slice of a
+                view depth is floor(log(depth) * scale + bias), clamped
+                to the slices
+
+      Returns:  FLOAT
+                  Scale of the natural logarithm of the view depth
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT LightClusterer::GetSliceScale() const
+    {
+        return m_sliceScale;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::GetSliceBias
+
+      Summary:  Returns the bias of the slice lookup
+
+      Returns:  FLOAT
+                  Bias added to the scaled logarithm of the view depth
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT LightClusterer::GetSliceBias() const
+    {
+        return m_sliceBias;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::updateClusterBounds
+
+      Summary:  Computes the depth of every slice and the view space
+                bounding box of every cluster. The boxes of a slice are
+                stored four clusters at a time as the minimum x,
+                maximum x, minimum y and maximum y of the four; the
+                depth range is shared by the slice. Lanes past the last
+                cluster get empty boxes that no sphere overlaps
+
+      Args:     const XMFLOAT4X4& projection
+                  Perspective projection matrix
+
+      Modifies: [m_sliceScale, m_sliceBias, m_aSliceDepths,
+                  m_aClusterBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusterer::updateClusterBounds(_In_ const XMFLOAT4X4& projection)
+    {
+        assert(projection._34 == 1.0f);
+
+        FLOAT farDepth = projection._43 / (1.0f - projection._33);
+        FLOAT firstSliceDepth = m_desc.firstSliceDepth < farDepth * 0.5f ? m_desc.firstSliceDepth : farDepth * 0.5f;
+
+        m_aSliceDepths.resize(m_desc.uNumClustersZ + 1u);
+        m_aSliceDepths[0] = 0.0f;
+        if (m_desc.uNumClustersZ > 1u)
+        {
+            FLOAT depthRatio = farDepth / firstSliceDepth;
+            for (UINT i = 1u; i <= m_desc.uNumClustersZ; ++i)
+            {
+                m_aSliceDepths[i] = firstSliceDepth * std::pow(depthRatio, static_cast<FLOAT>(i - 1u) / static_cast<FLOAT>(m_desc.uNumClustersZ - 1u));
+            }
+            m_sliceScale = static_cast<FLOAT>(m_desc.uNumClustersZ - 1u) / std::log(depthRatio);
+            m_sliceBias = 1.0f - std::log(firstSliceDepth) * m_sliceScale;
+        }
+        else
+        {
+            m_aSliceDepths[1] = farDepth;
+            m_sliceScale = 0.0f;
+            m_sliceBias = 0.0f;
+        }
+
+        // A point at view depth z with normalized device x lies at (x - _31) * z / _11, the extremes of a cluster are at its near and far depth
+        m_aClusterBounds.resize(m_desc.uNumClustersZ * m_uNumGroupsPerSlice * 4u);
+        UINT uNumClustersPerSlice = m_desc.uNumClustersX * m_desc.uNumClustersY;
+        for (UINT uSlice = 0u; uSlice < m_desc.uNumClustersZ; ++uSlice)
+        {
+            FLOAT nearDepth = m_aSliceDepths[uSlice];
+            FLOAT farSliceDepth = m_aSliceDepths[uSlice + 1u];
+            for (UINT uGroup = 0u; uGroup < m_uNumGroupsPerSlice; ++uGroup)
+            {
+                XMFLOAT4 aBounds[4] =
+                {
+                    XMFLOAT4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX),
+                    XMFLOAT4(-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX),
+                    XMFLOAT4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX),
+                    XMFLOAT4(-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX)
+                };
+                for (UINT uLane = 0u; uLane < 4u; ++uLane)
+                {
+                    UINT uCluster = uGroup * 4u + uLane;
+                    if (uCluster >= uNumClustersPerSlice)
+                    {
+                        break;
+                    }
+
+                    UINT uX = uCluster % m_desc.uNumClustersX;
+                    UINT uY = uCluster / m_desc.uNumClustersX;
+                    FLOAT minNdcX = -1.0f + 2.0f * static_cast<FLOAT>(uX) / static_cast<FLOAT>(m_desc.uNumClustersX) - projection._31;
+                    FLOAT maxNdcX = -1.0f + 2.0f * static_cast<FLOAT>(uX + 1u) / static_cast<FLOAT>(m_desc.uNumClustersX) - projection._31;
+                    FLOAT minNdcY = 1.0f - 2.0f * static_cast<FLOAT>(uY + 1u) / static_cast<FLOAT>(m_desc.uNumClustersY) - projection._32;
+                    FLOAT maxNdcY = 1.0f - 2.0f * static_cast<FLOAT>(uY) / static_cast<FLOAT>(m_desc.uNumClustersY) - projection._32;
+
+                    (&aBounds[0].x)[uLane] = (minNdcX < 0.0f ? minNdcX * farSliceDepth : minNdcX * nearDepth) / projection._11;
+                    (&aBounds[1].x)[uLane] = (maxNdcX < 0.0f ? maxNdcX * nearDepth : maxNdcX * farSliceDepth) / projection._11;
+                    (&aBounds[2].x)[uLane] = (minNdcY < 0.0f ? minNdcY * farSliceDepth : minNdcY * nearDepth) / projection._22;
+                    (&aBounds[3].x)[uLane] = (maxNdcY < 0.0f ? maxNdcY * nearDepth : maxNdcY * farSliceDepth) / projection._22;
+                }
+
+                XMVECTOR* pBounds = &m_aClusterBounds[(uSlice * m_uNumGroupsPerSlice + uGroup) * 4u];
+                for (UINT i = 0u; i < 4u; ++i)
+                {
+                    pBounds[i] = XMLoadFloat4(&aBounds[i]);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterer::assignSlice
+
+      Summary:  Collects the lights of every cluster of a depth slice.
+                The depth distance of a sphere to the slice is shared by
+                all its clusters, so only the squared radius left over
+                from it is compared with the distance to the boxes in x
+                and y, four clusters at a time. Each slice only writes
+                the lists of its own clusters
+
+      Args:     UINT uSlice
+                  Index of the depth slice
+
+      Modifies: [m_aClusterLights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusterer::assignSlice(_In_ UINT uSlice)
+    {
+        UINT uNumClustersPerSlice = m_desc.uNumClustersX * m_desc.uNumClustersY;
+        UINT uFirstCluster = uSlice * uNumClustersPerSlice;
+        for (UINT i = 0u; i < uNumClustersPerSlice; ++i)
+        {
+            m_aClusterLights[uFirstCluster + i].clear();
+        }
+
+        FLOAT nearDepth = m_aSliceDepths[uSlice];
+        FLOAT farDepth = m_aSliceDepths[uSlice + 1u];
+        const XMVECTOR* pBounds = &m_aClusterBounds[uSlice * m_uNumGroupsPerSlice * 4u];
+        for (UINT uLight = 0u; uLight < m_aViewLights.size(); ++uLight)
+        {
+            const XMFLOAT4& light = m_aViewLights[uLight];
+            FLOAT depthDistance = light.z < nearDepth ? nearDepth - light.z : (light.z > farDepth ? light.z - farDepth : 0.0f);
+            FLOAT remainingRadiusSquared = light.w * light.w - depthDistance * depthDistance;
+            if (remainingRadiusSquared < 0.0f)
+            {
+                continue;
+            }
+
+            XMVECTOR centerX = XMVectorReplicate(light.x);
+            XMVECTOR centerY = XMVectorReplicate(light.y);
+            XMVECTOR radiusSquared = XMVectorReplicate(remainingRadiusSquared);
+            for (UINT uGroup = 0u; uGroup < m_uNumGroupsPerSlice; ++uGroup)
+            {
+                const XMVECTOR* pGroupBounds = pBounds + uGroup * 4u;
+                XMVECTOR distanceX = XMVectorMax(XMVectorMax(XMVectorSubtract(pGroupBounds[0], centerX), XMVectorSubtract(centerX, pGroupBounds[1])), XMVectorZero());
+                XMVECTOR distanceY = XMVectorMax(XMVectorMax(XMVectorSubtract(pGroupBounds[2], centerY), XMVectorSubtract(centerY, pGroupBounds[3])), XMVectorZero());
+                XMVECTOR overlaps = XMVectorLessOrEqual(XMVectorMultiplyAdd(distanceX, distanceX, XMVectorMultiply(distanceY, distanceY)), radiusSquared);
+                if (XMVector4EqualInt(overlaps, XMVectorFalseInt()))
+                {
+                    continue;
+                }
+
+                XMUINT4 lanes;
+                XMStoreUInt4(&lanes, overlaps);
+                const UINT* pLanes = &lanes.x;
+                for (UINT uLane = 0u; uLane < 4u; ++uLane)
+                {
+                    if (pLanes[uLane] != 0u)
+                    {
+                        m_aClusterLights[uFirstCluster + uGroup * 4u + uLane].push_back(uLight);
+                    }
+                }
+            }
+        }
+    }
+}
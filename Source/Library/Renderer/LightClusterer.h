@@ -0,0 +1,108 @@
+/*+===================================================================
+  File:      LIGHTCLUSTERER.H
+
+  Summary:   LightClusterer header file contains declarations of
+             LightClusterer class that assigns the point lights of a
+             view to the clusters of its frustum, so the pixel shaders
+             only loop over the lights that can reach a pixel.
+
+  Classes: LightClustererDesc, LightClusterer
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   LightClustererDesc
+
+        Summary:  Data structure that describes the cluster grid. The
+                  first depth slice reaches from the eye to the first
+                  slice depth, the other slices split the depth from
+                  there to the far plane exponentially, so clusters far
+                  from the eye are as deep as they are wide
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct LightClustererDesc
+    {
+        UINT uNumClustersX;
+        UINT uNumClustersY;
+        UINT uNumClustersZ;
+        FLOAT firstSliceDepth;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    LightClusterer
+
+      Summary:  Splits the frustum of a perspective view into a grid of
+                clusters and intersects the attenuation sphere of every
+                light with the view space bounding box of every cluster.
+                The bounds only change with the projection. The depth
+                slices are assigned in parallel, each slice tests four
+                clusters of a row at once. The result is a compact list
+                of light indices and the offset and count of every
+                cluster into it, ordered by slice, then row, then
+                column, with the rows counted from the top of the
+                screen. The clusterer does not touch Direct3D
+
+      Methods:  GetDesc
+                  Returns the description
+                GetNumClusters
+                  Returns the number of clusters
+                Build
+                  Assigns the lights to the clusters of a view
+                GetClusters
+                  Returns the offset and count of every cluster
+                GetLightIndices
+                  Returns the light indices of all clusters
+                GetSliceScale
+                  Returns the scale of the log depth to the slice
+                GetSliceBias
+                  Returns the bias of the log depth to the slice
+                LightClusterer
+                  Constructor.
+                ~LightClusterer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class LightClusterer final
+    {
+    public:
+        LightClusterer() = delete;
+        explicit LightClusterer(_In_ const LightClustererDesc& desc);
+        LightClusterer(const LightClusterer& other) = delete;
+        LightClusterer(LightClusterer&& other) = delete;
+        LightClusterer& operator=(const LightClusterer& other) = delete;
+        LightClusterer& operator=(LightClusterer&& other) = delete;
+        ~LightClusterer() = default;
+
+        const LightClustererDesc& GetDesc() const;
+        UINT GetNumClusters() const;
+
+        void Build(_In_ const XMMATRIX& view, _In_ const XMMATRIX& projection, _In_ const std::vector<XMFLOAT4>& aLightSpheres);
+
+        const std::vector<XMUINT2>& GetClusters() const;
+        const std::vector<UINT>& GetLightIndices() const;
+        FLOAT GetSliceScale() const;
+        FLOAT GetSliceBias() const;
+
+    private:
+        void updateClusterBounds(_In_ const XMFLOAT4X4& projection);
+        void assignSlice(_In_ UINT uSlice);
+
+    private:
+        LightClustererDesc m_desc;
+        UINT m_uNumGroupsPerSlice;
+        XMFLOAT4X4 m_projection;
+        FLOAT m_sliceScale;
+        FLOAT m_sliceBias;
+        std::vector<FLOAT> m_aSliceDepths;
+        std::vector<XMVECTOR> m_aClusterBounds;
+        std::vector<XMFLOAT4> m_aViewLights;
+        std::vector<UINT> m_aSlices;
+        std::vector<std::vector<UINT>> m_aClusterLights;
+        std::vector<XMUINT2> m_aClusters;
+        std::vector<UINT> m_aLightIndices;
+    };
+}
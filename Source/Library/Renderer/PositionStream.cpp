@@ -0,0 +1,249 @@
+#include "Renderer/PositionStream.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::PositionStream
+
+      Summary:  Constructor
+
+      Modifies: [m_vertexBuffer, m_aPositions, m_aQuantizedPositions,
+                 m_scale, m_offset, m_bQuantized].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PositionStream::PositionStream() :
+        m_vertexBuffer(nullptr),
+        m_aPositions(),
+        m_aQuantizedPositions(),
+        m_scale(1.0f, 1.0f, 1.0f, 0.0f),
+        m_offset(0.0f, 0.0f, 0.0f, 0.0f),
+        m_bQuantized(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::Extract
+
+      Summary:  Copies the positions of the vertices. Quantized
+                positions are mapped from the bounds of the vertices to
+                [-QUANTIZATION_RANGE, QUANTIZATION_RANGE], so the error
+                of each axis is at most the extent of the bounds divided
+                by 4 * QUANTIZATION_RANGE
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices to extract the positions of
+                UINT uNumVertices
+                  Number of vertices
+                BOOL bQuantize
+                  Whether to quantize the positions to 16 bits
+
+      Modifies: [m_aPositions, m_aQuantizedPositions, m_scale,
+                 m_offset, m_bQuantized].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PositionStream::Extract(_In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices, _In_ BOOL bQuantize)
+    {
+        m_aPositions.clear();
+        m_aQuantizedPositions.clear();
+        m_scale = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+        m_offset = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+        m_bQuantized = bQuantize;
+
+        if (!bQuantize)
+        {
+            m_aPositions.resize(uNumVertices);
+            for (UINT i = 0u; i < uNumVertices; ++i)
+            {
+                m_aPositions[i] = aVertices[i].Position;
+            }
+            return;
+        }
+
+        XMFLOAT3 minimum(FLT_MAX, FLT_MAX, FLT_MAX);
+        XMFLOAT3 maximum(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            const XMFLOAT3& position = aVertices[i].Position;
+            minimum.x = position.x < minimum.x ? position.x : minimum.x;
+            minimum.y = position.y < minimum.y ? position.y : minimum.y;
+            minimum.z = position.z < minimum.z ? position.z : minimum.z;
+            maximum.x = position.x > maximum.x ? position.x : maximum.x;
+            maximum.y = position.y > maximum.y ? position.y : maximum.y;
+            maximum.z = position.z > maximum.z ? position.z : maximum.z;
+        }
+
+        // A flat axis keeps a unit scale so the positions never divide by zero
+        FLOAT aMinimum[3] = { minimum.x, minimum.y, minimum.z };
+        FLOAT aMaximum[3] = { maximum.x, maximum.y, maximum.z };
+        FLOAT aScale[3] = { 1.0f, 1.0f, 1.0f };
+        FLOAT aOffset[3] = { 0.0f, 0.0f, 0.0f };
+        for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+        {
+            aOffset[uAxis] = (aMinimum[uAxis] + aMaximum[uAxis]) * 0.5f;
+            FLOAT halfExtent = (aMaximum[uAxis] - aMinimum[uAxis]) * 0.5f;
+            aScale[uAxis] = halfExtent > 0.0f ? halfExtent : 1.0f;
+        }
+        m_scale = XMFLOAT4(aScale[0], aScale[1], aScale[2], 0.0f);
+        m_offset = XMFLOAT4(aOffset[0], aOffset[1], aOffset[2], 0.0f);
+
+        auto quantize = [](FLOAT value, FLOAT offset, FLOAT scale) -> SHORT
+        {
+            FLOAT normalized = std::round((value - offset) / scale * static_cast<FLOAT>(QUANTIZATION_RANGE));
+            normalized = normalized > static_cast<FLOAT>(QUANTIZATION_RANGE) ? static_cast<FLOAT>(QUANTIZATION_RANGE) : normalized;
+            normalized = normalized < -static_cast<FLOAT>(QUANTIZATION_RANGE) ? -static_cast<FLOAT>(QUANTIZATION_RANGE) : normalized;
+            return static_cast<SHORT>(normalized);
+        };
+
+        m_aQuantizedPositions.resize(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            const XMFLOAT3& position = aVertices[i].Position;
+            m_aQuantizedPositions[i] = {
+                .x = quantize(position.x, aOffset[0], aScale[0]),
+                .y = quantize(position.y, aOffset[1], aScale[1]),
+                .z = quantize(position.z, aOffset[2], aScale[2]),
+                .w = QUANTIZATION_RANGE
+            };
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::Initialize
+
+      Summary:  Creates the vertex buffer of the extracted positions
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+
+      Modifies: [m_vertexBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT PositionStream::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        D3D11_BUFFER_DESC positionBd = {
+            .ByteWidth = GetStride() * GetNumPositions(),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0,
+            .MiscFlags = 0
+        };
+
+        D3D11_SUBRESOURCE_DATA positionInitData = {
+            .pSysMem = m_bQuantized ? static_cast<const void*>(m_aQuantizedPositions.data()) : static_cast<const void*>(m_aPositions.data()),
+            .SysMemPitch = 0,
+            .SysMemSlicePitch = 0
+        };
+
+        return pDevice->CreateBuffer(&positionBd, &positionInitData, m_vertexBuffer.ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetVertexBuffer
+
+      Summary:  Returns the vertex buffer of the positions
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Vertex buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11Buffer>& PositionStream::GetVertexBuffer()
+    {
+        return m_vertexBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetStride
+
+      Summary:  Returns the size of a position in the vertex buffer
+
+      Returns:  UINT
+                  Stride in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT PositionStream::GetStride() const
+    {
+        return m_bQuantized ? static_cast<UINT>(sizeof(QuantizedPosition)) : static_cast<UINT>(sizeof(XMFLOAT3));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetNumPositions
+
+      Summary:  Returns the number of positions
+
+      Returns:  UINT
+                  Number of positions
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT PositionStream::GetNumPositions() const
+    {
+        return static_cast<UINT>(m_bQuantized ? m_aQuantizedPositions.size() : m_aPositions.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::IsQuantized
+
+      Summary:  Returns whether the positions are quantized to 16 bits
+
+      Returns:  BOOL
+                  Whether the positions are quantized
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL PositionStream::IsQuantized() const
+    {
+        return m_bQuantized;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetScale
+
+      Summary:  Returns the scale applied to the normalized positions,
+                one for positions that are not quantized
+
+      Returns:  const XMFLOAT4&
+                  Scale of each axis
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& PositionStream::GetScale() const
+    {
+        return m_scale;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetOffset
+
+      Summary:  Returns the offset added to the scaled positions, zero
+                for positions that are not quantized
+
+      Returns:  const XMFLOAT4&
+                  Offset of each axis
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& PositionStream::GetOffset() const
+    {
+        return m_offset;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PositionStream::GetPosition
+
+      Summary:  Returns a position the way the vertex shader restores it
+
+      Args:     UINT uIndex
+                  Index of the position
+
+      Returns:  XMFLOAT3
+                  Position
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMFLOAT3 PositionStream::GetPosition(_In_ UINT uIndex) const
+    {
+        assert(uIndex < GetNumPositions());
+
+        if (!m_bQuantized)
+        {
+            return m_aPositions[uIndex];
+        }
+
+        const QuantizedPosition& position = m_aQuantizedPositions[uIndex];
+        return XMFLOAT3(
+            static_cast<FLOAT>(position.x) / static_cast<FLOAT>(QUANTIZATION_RANGE) * m_scale.x + m_offset.x,
+            static_cast<FLOAT>(position.y) / static_cast<FLOAT>(QUANTIZATION_RANGE) * m_scale.y + m_offset.y,
+            static_cast<FLOAT>(position.z) / static_cast<FLOAT>(QUANTIZATION_RANGE) * m_scale.z + m_offset.z
+        );
+    }
+}
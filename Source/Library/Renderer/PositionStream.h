@@ -0,0 +1,86 @@
+/*+===================================================================
+  File:      POSITIONSTREAM.H
+
+  Summary:   PositionStream header file contains declarations of
+             PositionStream class used to keep the positions of a
+             renderable in a tightly packed vertex stream for depth
+             only passes.
+
+  Classes: PositionStream
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PositionStream
+
+      Summary:  Position-only copy of the vertices of a renderable. The
+                positions are either stored as floats or quantized to
+                16-bit signed normalized integers relative to the
+                bounds of the renderable, in which case the scale and
+                offset returned by the stream restore them in the
+                vertex shader
+
+      Methods:  Extract
+                  Copies or quantizes the positions of the vertices
+                Initialize
+                  Creates the vertex buffer of the positions
+                GetVertexBuffer
+                  Returns the vertex buffer
+                GetStride
+                  Returns the size of a position in bytes
+                GetNumPositions
+                  Returns the number of positions
+                IsQuantized
+                  Returns whether the positions are quantized
+                GetScale
+                  Returns the scale that restores the positions
+                GetOffset
+                  Returns the offset that restores the positions
+                GetPosition
+                  Returns a restored position
+                PositionStream
+                  Constructor.
+                ~PositionStream
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PositionStream final
+    {
+    public:
+        static constexpr const SHORT QUANTIZATION_RANGE = 32767;
+
+    public:
+        PositionStream();
+        PositionStream(const PositionStream& other) = delete;
+        PositionStream(PositionStream&& other) = delete;
+        PositionStream& operator=(const PositionStream& other) = delete;
+        PositionStream& operator=(PositionStream&& other) = delete;
+        ~PositionStream() = default;
+
+        void Extract(_In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices, _In_ BOOL bQuantize);
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+        ComPtr<ID3D11Buffer>& GetVertexBuffer();
+        UINT GetStride() const;
+        UINT GetNumPositions() const;
+        BOOL IsQuantized() const;
+        const XMFLOAT4& GetScale() const;
+        const XMFLOAT4& GetOffset() const;
+        XMFLOAT3 GetPosition(_In_ UINT uIndex) const;
+
+    private:
+        ComPtr<ID3D11Buffer> m_vertexBuffer;
+        std::vector<XMFLOAT3> m_aPositions;
+        std::vector<QuantizedPosition> m_aQuantizedPositions;
+        XMFLOAT4 m_scale;
+        XMFLOAT4 m_offset;
+        BOOL m_bQuantized;
+    };
+}
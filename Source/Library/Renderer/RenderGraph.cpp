@@ -0,0 +1,920 @@
+#include "Renderer/RenderGraph.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::RenderGraph
+
+      Summary:  Constructor
+
+      Modifies: [m_aResources, m_aPasses, m_aCompiledPasses,
+                 m_aFinalUnbindSlots, m_aPhysicalTextures, m_bCompiled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderGraph::RenderGraph()
+        : m_aResources()
+        , m_aPasses()
+        , m_aCompiledPasses()
+        , m_aFinalUnbindSlots()
+        , m_aPhysicalTextures()
+        , m_bCompiled(FALSE)
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::Reset
+
+      Summary:  Removes every pass and resource so the graph can be
+                declared again
+
+      Modifies: [m_aResources, m_aPasses, m_aCompiledPasses,
+                 m_aFinalUnbindSlots, m_aPhysicalTextures, m_bCompiled].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderGraph::Reset()
+    {
+        m_aResources.clear();
+        m_aPasses.clear();
+        m_aCompiledPasses.clear();
+        m_aFinalUnbindSlots.clear();
+        m_aPhysicalTextures.clear();
+        m_bCompiled = FALSE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::CreateTexture
+
+      Summary:  Declares a transient texture. The graph decides which
+                physical texture backs it when compiling
+
+      Args:     PCWSTR pszName
+                  Name of the texture
+                const RenderGraphTextureDesc& desc
+                  Description of the texture
+
+      Modifies: [m_aResources, m_bCompiled].
+
+      Returns:  UINT
+                  Handle of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderGraph::CreateTexture(_In_ PCWSTR pszName, _In_ const RenderGraphTextureDesc& desc)
+    {
+        m_aResources.push_back(
+            {
+                .szName = pszName,
+                .desc = desc,
+                .bImported = FALSE,
+                .bOutput = FALSE,
+                .uFirstUse = INVALID_HANDLE,
+                .uLastUse = INVALID_HANDLE,
+                .uPhysical = INVALID_HANDLE
+            }
+        );
+        m_bCompiled = FALSE;
+
+        return static_cast<UINT>(m_aResources.size() - 1u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::ImportTexture
+
+      Summary:  Declares a texture that is owned outside of the graph,
+                such as the back buffer or the depth buffer
+
+      Args:     PCWSTR pszName
+                  Name of the texture
+                BOOL bIsOutput
+                  Whether the contents of the texture are consumed
+                  after the frame. Passes writing an output are never
+                  culled
+
+      Modifies: [m_aResources, m_bCompiled].
+
+      Returns:  UINT
+                  Handle of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderGraph::ImportTexture(_In_ PCWSTR pszName, _In_ BOOL bIsOutput)
+    {
+        m_aResources.push_back(
+            {
+                .szName = pszName,
+                .desc = {.uWidth = 0u, .uHeight = 0u, .format = DXGI_FORMAT_UNKNOWN },
+                .bImported = TRUE,
+                .bOutput = bIsOutput,
+                .uFirstUse = INVALID_HANDLE,
+                .uLastUse = INVALID_HANDLE,
+                .uPhysical = INVALID_HANDLE
+            }
+        );
+        m_bCompiled = FALSE;
+
+        return static_cast<UINT>(m_aResources.size() - 1u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::AddPass
+
+      Summary:  Declares a pass. A pass reads what the passes declared
+                before it wrote, so passes touching the same texture
+                must be declared in the order they should happen
+
+      Args:     PCWSTR pszName
+                  Name of the pass
+                std::function<void()> execute
+                  Records the draw calls of the pass
+
+      Modifies: [m_aPasses, m_bCompiled].
+
+      Returns:  UINT
+                  Handle of the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderGraph::AddPass(_In_ PCWSTR pszName, _In_ std::function<void()> execute)
+    {
+        m_aPasses.push_back(
+            {
+                .szName = pszName,
+                .execute = std::move(execute),
+                .aReads = {},
+                .aWrites = {},
+                .bCulled = FALSE
+            }
+        );
+        m_bCompiled = FALSE;
+
+        return static_cast<UINT>(m_aPasses.size() - 1u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::ReadTexture
+
+      Summary:  Declares that the pass binds the texture as a pixel
+                shader resource
+
+      Args:     UINT uPass
+                  Handle of the pass
+                UINT uResource
+                  Handle of the texture
+                UINT uShaderSlot
+                  Pixel shader slot the texture is bound to
+
+      Modifies: [m_aPasses, m_bCompiled].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::ReadTexture(_In_ UINT uPass, _In_ UINT uResource, _In_ UINT uShaderSlot)
+    {
+        if (uPass >= m_aPasses.size() || uResource >= m_aResources.size())
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aPasses[uPass].aReads.push_back({ .uResource = uResource, .uShaderSlot = uShaderSlot });
+        m_bCompiled = FALSE;
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::ReadDepthStencil
+
+      Summary:  Declares that the pass depth tests against the contents
+                the last earlier pass wrote into the texture instead of
+                clearing it. The texture is not bound as a shader
+                resource, so the pass may also write it
+
+      Args:     UINT uPass
+                  Handle of the pass
+                UINT uResource
+                  Handle of the depth stencil texture
+
+      Modifies: [m_aPasses, m_bCompiled].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::ReadDepthStencil(_In_ UINT uPass, _In_ UINT uResource)
+    {
+        return ReadTexture(uPass, uResource, INVALID_HANDLE);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::WriteTexture
+
+      Summary:  Declares that the pass binds the texture as a render
+                target or depth stencil
+
+      Args:     UINT uPass
+                  Handle of the pass
+                UINT uResource
+                  Handle of the texture
+
+      Modifies: [m_aPasses, m_bCompiled].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::WriteTexture(_In_ UINT uPass, _In_ UINT uResource)
+    {
+        if (uPass >= m_aPasses.size() || uResource >= m_aResources.size())
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aPasses[uPass].aWrites.push_back(uResource);
+        m_bCompiled = FALSE;
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::Compile
+
+      Summary:  Builds the dependencies between the passes, culls the
+                passes that do not contribute to an output, orders the
+                rest, aliases the transient textures and computes the
+                shader resource unbinds
+
+      Modifies: [m_aPasses, m_aResources, m_aCompiledPasses,
+                 m_aFinalUnbindSlots, m_aPhysicalTextures, m_bCompiled].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if a pass samples a texture
+                  it writes or a transient texture nothing wrote before,
+                  E_FAIL if the dependencies form a cycle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::Compile()
+    {
+        m_aCompiledPasses.clear();
+        m_aFinalUnbindSlots.clear();
+        m_aPhysicalTextures.clear();
+        m_bCompiled = FALSE;
+
+        // A texture cannot be bound as a shader resource and a render target at once
+        for (const Pass& pass : m_aPasses)
+        {
+            for (const TextureRead& read : pass.aReads)
+            {
+                if (read.uShaderSlot != INVALID_HANDLE && isWrittenBy(read.uResource, pass))
+                {
+                    return E_INVALIDARG;
+                }
+            }
+        }
+
+        const UINT uNumPasses = static_cast<UINT>(m_aPasses.size());
+
+        // Reads see every write declared before them, writes wait for the earlier reads and writes
+        std::vector<std::vector<UINT>> aSuccessors(uNumPasses);
+        std::vector<std::vector<UINT>> aProducers(uNumPasses);
+        for (UINT uResource = 0u; uResource < m_aResources.size(); ++uResource)
+        {
+            std::vector<UINT> aWriters;
+            std::vector<UINT> aReaders;
+            for (UINT uPass = 0u; uPass < uNumPasses; ++uPass)
+            {
+                const Pass& pass = m_aPasses[uPass];
+
+                auto itRead = std::find_if(pass.aReads.begin(), pass.aReads.end(),
+                    [uResource](const TextureRead& read)
+                    {
+                        return read.uResource == uResource;
+                    }
+                );
+                if (itRead != pass.aReads.end())
+                {
+                    if (aWriters.empty() && !m_aResources[uResource].bImported)
+                    {
+                        return E_INVALIDARG;
+                    }
+
+                    // Depth tests only see the depth of the last writer, earlier writers are overwritten
+                    size_t uFirstWriter = itRead->uShaderSlot == INVALID_HANDLE && !aWriters.empty() ? aWriters.size() - 1u : 0u;
+                    for (size_t i = uFirstWriter; i < aWriters.size(); ++i)
+                    {
+                        aSuccessors[aWriters[i]].push_back(uPass);
+                        aProducers[uPass].push_back(aWriters[i]);
+                    }
+                    aReaders.push_back(uPass);
+                }
+
+                if (isWrittenBy(uResource, pass))
+                {
+                    if (!aWriters.empty())
+                    {
+                        aSuccessors[aWriters.back()].push_back(uPass);
+                    }
+                    for (UINT uReader : aReaders)
+                    {
+                        // A pass depth testing against a texture it writes does not wait for itself
+                        if (uReader != uPass)
+                        {
+                            aSuccessors[uReader].push_back(uPass);
+                        }
+                    }
+                    aReaders.clear();
+                    aWriters.push_back(uPass);
+                }
+            }
+        }
+
+        HRESULT hr = cullPasses(aProducers);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = sortPasses(aSuccessors);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        computeLifetimes();
+        aliasTransientTextures();
+        computeUnbinds();
+
+        m_bCompiled = TRUE;
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::Execute
+
+      Summary:  Runs the compiled passes in order, unbinding shader
+                resources right before a pass renders into them
+
+      Args:     const std::function<void(UINT)>& beginPass
+                  Called with the index of each pass before it runs
+                const std::function<void(UINT)>& unbindShaderResource
+                  Unbinds the pixel shader resource of the given slot
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderGraph::Execute(_In_ const std::function<void(UINT)>& beginPass, _In_ const std::function<void(UINT)>& unbindShaderResource) const
+    {
+        for (const CompiledPass& compiledPass : m_aCompiledPasses)
+        {
+            beginPass(compiledPass.uPassIndex);
+
+            for (UINT uSlot : compiledPass.aUnbindSlots)
+            {
+                unbindShaderResource(uSlot);
+            }
+
+            if (m_aPasses[compiledPass.uPassIndex].execute)
+            {
+                m_aPasses[compiledPass.uPassIndex].execute();
+            }
+        }
+
+        for (UINT uSlot : m_aFinalUnbindSlots)
+        {
+            unbindShaderResource(uSlot);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::IsCompiled
+
+      Summary:  Returns whether the graph has been compiled since the
+                last declaration
+
+      Returns:  BOOL
+                  Whether the graph has been compiled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL RenderGraph::IsCompiled() const
+    {
+        return m_bCompiled;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::IsPassCulled
+
+      Summary:  Returns whether the pass was culled by the last
+                compilation
+
+      Args:     UINT uPass
+                  Handle of the pass
+
+      Returns:  BOOL
+                  Whether the pass was culled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL RenderGraph::IsPassCulled(_In_ UINT uPass) const
+    {
+        if (uPass >= m_aPasses.size())
+        {
+            return TRUE;
+        }
+
+        return m_aPasses[uPass].bCulled;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetCompiledPasses
+
+      Summary:  Returns the compiled passes in execution order
+
+      Returns:  const std::vector<CompiledPass>&
+                  Compiled passes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<RenderGraph::CompiledPass>& RenderGraph::GetCompiledPasses() const
+    {
+        return m_aCompiledPasses;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetFinalUnbindSlots
+
+      Summary:  Returns the slots still bound to graph textures after
+                the last pass, so the next frame may render into them
+
+      Returns:  const std::vector<UINT>&
+                  Pixel shader slots
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<UINT>& RenderGraph::GetFinalUnbindSlots() const
+    {
+        return m_aFinalUnbindSlots;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetPassName
+
+      Summary:  Returns the name of the pass
+
+      Args:     UINT uPass
+                  Handle of the pass
+
+      Returns:  PCWSTR
+                  Name of the pass, or nullptr if the handle is invalid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PCWSTR RenderGraph::GetPassName(_In_ UINT uPass) const
+    {
+        if (uPass >= m_aPasses.size())
+        {
+            return nullptr;
+        }
+
+        return m_aPasses[uPass].szName.c_str();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetNumPhysicalTextures
+
+      Summary:  Returns the number of textures that must be allocated
+                for the transient textures after aliasing
+
+      Returns:  UINT
+                  Number of physical textures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderGraph::GetNumPhysicalTextures() const
+    {
+        return static_cast<UINT>(m_aPhysicalTextures.size());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetPhysicalTextureDesc
+
+      Summary:  Returns the description of a physical texture
+
+      Args:     UINT uPhysical
+                  Index of the physical texture
+
+      Returns:  const RenderGraphTextureDesc&
+                  Description of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderGraphTextureDesc& RenderGraph::GetPhysicalTextureDesc(_In_ UINT uPhysical) const
+    {
+        assert(uPhysical < m_aPhysicalTextures.size());
+
+        return m_aPhysicalTextures[uPhysical];
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetPhysicalTextureIndex
+
+      Summary:  Returns the physical texture backing a transient texture
+
+      Args:     UINT uResource
+                  Handle of the texture
+
+      Returns:  UINT
+                  Index of the physical texture, INVALID_HANDLE if the
+                  texture is imported or unused by the compiled passes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderGraph::GetPhysicalTextureIndex(_In_ UINT uResource) const
+    {
+        if (uResource >= m_aResources.size())
+        {
+            return INVALID_HANDLE;
+        }
+
+        return m_aResources[uResource].uPhysical;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetTransientMemorySize
+
+      Summary:  Returns the bytes used by the physical textures
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RenderGraph::GetTransientMemorySize() const
+    {
+        UINT64 ullSize = 0ull;
+        for (const RenderGraphTextureDesc& desc : m_aPhysicalTextures)
+        {
+            ullSize += getTextureSize(desc);
+        }
+
+        return ullSize;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::GetUnaliasedTransientMemorySize
+
+      Summary:  Returns the bytes the used transient textures would take
+                if every one of them had its own texture
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RenderGraph::GetUnaliasedTransientMemorySize() const
+    {
+        UINT64 ullSize = 0ull;
+        for (const Resource& resource : m_aResources)
+        {
+            if (!resource.bImported && resource.uPhysical != INVALID_HANDLE)
+            {
+                ullSize += getTextureSize(resource.desc);
+            }
+        }
+
+        return ullSize;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::isWrittenBy
+
+      Summary:  Returns whether the pass writes the texture
+
+      Args:     UINT uResource
+                  Handle of the texture
+                const Pass& pass
+                  The pass
+
+      Returns:  BOOL
+                  Whether the pass writes the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL RenderGraph::isWrittenBy(_In_ UINT uResource, _In_ const Pass& pass) const
+    {
+        return std::find(pass.aWrites.begin(), pass.aWrites.end(), uResource) != pass.aWrites.end();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::cullPasses
+
+      Summary:  Keeps the passes writing an output and, transitively,
+                the passes producing what they read. Every other pass
+                is culled
+
+      Args:     const std::vector<std::vector<UINT>>& aProducers
+                  Passes writing the textures read by each pass
+
+      Modifies: [m_aPasses].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::cullPasses(_In_ const std::vector<std::vector<UINT>>& aProducers)
+    {
+        std::vector<UINT> aStack;
+        for (UINT uPass = 0u; uPass < m_aPasses.size(); ++uPass)
+        {
+            m_aPasses[uPass].bCulled = TRUE;
+
+            for (UINT uResource : m_aPasses[uPass].aWrites)
+            {
+                if (m_aResources[uResource].bOutput)
+                {
+                    aStack.push_back(uPass);
+                    break;
+                }
+            }
+        }
+
+        while (!aStack.empty())
+        {
+            UINT uPass = aStack.back();
+            aStack.pop_back();
+
+            if (!m_aPasses[uPass].bCulled)
+            {
+                continue;
+            }
+
+            m_aPasses[uPass].bCulled = FALSE;
+            for (UINT uProducer : aProducers[uPass])
+            {
+                aStack.push_back(uProducer);
+            }
+        }
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::sortPasses
+
+      Summary:  Orders the passes that were not culled so that every
+                pass runs after its dependencies. Ties are broken by
+                declaration order, which keeps the result stable
+
+      Args:     const std::vector<std::vector<UINT>>& aSuccessors
+                  Passes that must run after each pass
+
+      Modifies: [m_aCompiledPasses].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the dependencies form a cycle
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT RenderGraph::sortPasses(_In_ const std::vector<std::vector<UINT>>& aSuccessors)
+    {
+        const UINT uNumPasses = static_cast<UINT>(m_aPasses.size());
+
+        std::vector<UINT> aNumDependencies(uNumPasses, 0u);
+        UINT uNumLivePasses = 0u;
+        for (UINT uPass = 0u; uPass < uNumPasses; ++uPass)
+        {
+            if (m_aPasses[uPass].bCulled)
+            {
+                continue;
+            }
+
+            ++uNumLivePasses;
+            for (UINT uSuccessor : aSuccessors[uPass])
+            {
+                if (!m_aPasses[uSuccessor].bCulled)
+                {
+                    ++aNumDependencies[uSuccessor];
+                }
+            }
+        }
+
+        std::priority_queue<UINT, std::vector<UINT>, std::greater<UINT>> readyPasses;
+        for (UINT uPass = 0u; uPass < uNumPasses; ++uPass)
+        {
+            if (!m_aPasses[uPass].bCulled && aNumDependencies[uPass] == 0u)
+            {
+                readyPasses.push(uPass);
+            }
+        }
+
+        while (!readyPasses.empty())
+        {
+            UINT uPass = readyPasses.top();
+            readyPasses.pop();
+
+            m_aCompiledPasses.push_back({ .uPassIndex = uPass, .aUnbindSlots = {} });
+
+            for (UINT uSuccessor : aSuccessors[uPass])
+            {
+                if (!m_aPasses[uSuccessor].bCulled && --aNumDependencies[uSuccessor] == 0u)
+                {
+                    readyPasses.push(uSuccessor);
+                }
+            }
+        }
+
+        if (m_aCompiledPasses.size() != uNumLivePasses)
+        {
+            m_aCompiledPasses.clear();
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::computeLifetimes
+
+      Summary:  Finds the first and last compiled pass using each
+                texture
+
+      Modifies: [m_aResources].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderGraph::computeLifetimes()
+    {
+        for (Resource& resource : m_aResources)
+        {
+            resource.uFirstUse = INVALID_HANDLE;
+            resource.uLastUse = INVALID_HANDLE;
+            resource.uPhysical = INVALID_HANDLE;
+        }
+
+        for (UINT uOrder = 0u; uOrder < m_aCompiledPasses.size(); ++uOrder)
+        {
+            const Pass& pass = m_aPasses[m_aCompiledPasses[uOrder].uPassIndex];
+
+            auto use = [this, uOrder](UINT uResource)
+            {
+                Resource& resource = m_aResources[uResource];
+                if (resource.uFirstUse == INVALID_HANDLE)
+                {
+                    resource.uFirstUse = uOrder;
+                }
+                resource.uLastUse = uOrder;
+            };
+
+            for (const TextureRead& read : pass.aReads)
+            {
+                use(read.uResource);
+            }
+            for (UINT uResource : pass.aWrites)
+            {
+                use(uResource);
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::aliasTransientTextures
+
+      Summary:  Assigns a physical texture to every used transient
+                texture. A physical texture is reused when its
+                description matches and its previous user is done
+                before the new one starts
+
+      Modifies: [m_aResources, m_aPhysicalTextures].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderGraph::aliasTransientTextures()
+    {
+        std::vector<UINT> aTransients;
+        for (UINT uResource = 0u; uResource < m_aResources.size(); ++uResource)
+        {
+            if (!m_aResources[uResource].bImported && m_aResources[uResource].uFirstUse != INVALID_HANDLE)
+            {
+                aTransients.push_back(uResource);
+            }
+        }
+
+        std::stable_sort(aTransients.begin(), aTransients.end(),
+            [this](UINT uLeft, UINT uRight)
+            {
+                return m_aResources[uLeft].uFirstUse < m_aResources[uRight].uFirstUse;
+            }
+        );
+
+        std::vector<UINT> aPhysicalLastUse;
+        for (UINT uResource : aTransients)
+        {
+            Resource& resource = m_aResources[uResource];
+
+            for (UINT uPhysical = 0u; uPhysical < m_aPhysicalTextures.size(); ++uPhysical)
+            {
+                const RenderGraphTextureDesc& desc = m_aPhysicalTextures[uPhysical];
+                if (desc.uWidth == resource.desc.uWidth &&
+                    desc.uHeight == resource.desc.uHeight &&
+                    desc.format == resource.desc.format &&
+                    aPhysicalLastUse[uPhysical] < resource.uFirstUse)
+                {
+                    resource.uPhysical = uPhysical;
+                    break;
+                }
+            }
+
+            if (resource.uPhysical == INVALID_HANDLE)
+            {
+                resource.uPhysical = static_cast<UINT>(m_aPhysicalTextures.size());
+                m_aPhysicalTextures.push_back(resource.desc);
+                aPhysicalLastUse.push_back(resource.uLastUse);
+            }
+            else
+            {
+                aPhysicalLastUse[resource.uPhysical] = resource.uLastUse;
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::computeUnbinds
+
+      Summary:  Tracks which texture each pixel shader slot is bound to
+                while walking the compiled passes, and unbinds a slot
+                before a pass renders into the texture bound there.
+                Aliased textures are tracked by their physical texture
+
+      Modifies: [m_aCompiledPasses, m_aFinalUnbindSlots].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderGraph::computeUnbinds()
+    {
+        // Transient textures are identified by their physical texture, imported ones by their handle
+        auto getBindingKey = [this](UINT uResource) -> UINT64
+        {
+            const Resource& resource = m_aResources[uResource];
+            return resource.bImported ? (1ull << 32u) | uResource : resource.uPhysical;
+        };
+
+        std::unordered_map<UINT, UINT64> boundSlots;
+        for (CompiledPass& compiledPass : m_aCompiledPasses)
+        {
+            const Pass& pass = m_aPasses[compiledPass.uPassIndex];
+
+            for (UINT uResource : pass.aWrites)
+            {
+                UINT64 ullKey = getBindingKey(uResource);
+                for (auto it = boundSlots.begin(); it != boundSlots.end();)
+                {
+                    if (it->second == ullKey)
+                    {
+                        compiledPass.aUnbindSlots.push_back(it->first);
+                        it = boundSlots.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            std::sort(compiledPass.aUnbindSlots.begin(), compiledPass.aUnbindSlots.end());
+
+            for (const TextureRead& read : pass.aReads)
+            {
+                if (read.uShaderSlot != INVALID_HANDLE)
+                {
+                    boundSlots[read.uShaderSlot] = getBindingKey(read.uResource);
+                }
+            }
+        }
+
+        for (const auto& boundSlot : boundSlots)
+        {
+            m_aFinalUnbindSlots.push_back(boundSlot.first);
+        }
+        std::sort(m_aFinalUnbindSlots.begin(), m_aFinalUnbindSlots.end());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderGraph::getTextureSize
+
+      Summary:  Returns the size of a texture described by the desc
+
+      Args:     const RenderGraphTextureDesc& desc
+                  Description of the texture
+
+      Returns:  UINT64
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RenderGraph::getTextureSize(_In_ const RenderGraphTextureDesc& desc)
+    {
+        UINT64 ullBytesPerTexel = 4ull;
+        switch (desc.format)
+        {
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            ullBytesPerTexel = 16ull;
+            break;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+            ullBytesPerTexel = 8ull;
+            break;
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_R16_UNORM:
+            ullBytesPerTexel = 2ull;
+            break;
+        case DXGI_FORMAT_R8_UNORM:
+            ullBytesPerTexel = 1ull;
+            break;
+        default:
+            break;
+        }
+
+        return static_cast<UINT64>(desc.uWidth) * static_cast<UINT64>(desc.uHeight) * ullBytesPerTexel;
+    }
+}
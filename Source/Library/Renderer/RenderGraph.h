@@ -0,0 +1,175 @@
+/*+===================================================================
+  File:      RENDERGRAPH.H
+
+  Summary:   RenderGraph header file contains declarations of
+             RenderGraph class used to declare render passes with the
+             resources they read and write, and to compile them into
+             an executable order.
+
+  Classes: RenderGraph
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   RenderGraphTextureDesc
+
+        Summary:  Data structure that describes a transient texture of
+                  the render graph. Transient textures may only share
+                  memory when their descriptions are equal
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderGraphTextureDesc
+    {
+        UINT uWidth;
+        UINT uHeight;
+        DXGI_FORMAT format;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderGraph
+
+      Summary:  Collects render passes together with the textures they
+                read and write, and compiles them into a frame. The
+                compilation culls passes that do not contribute to an
+                output, orders the remaining passes by their
+                dependencies, computes where shader resources must be
+                unbound before a texture is used as a render target,
+                and aliases transient textures whose lifetimes do not
+                overlap. Compilation does not touch Direct3D
+
+      Methods:  Reset
+                  Removes every pass and resource
+                CreateTexture
+                  Declares a transient texture owned by the graph
+                ImportTexture
+                  Declares a texture owned outside of the graph
+                AddPass
+                  Declares a pass with its execute callback
+                ReadTexture
+                  Declares that a pass samples a texture
+                ReadDepthStencil
+                  Declares that a pass depth tests against a texture
+                WriteTexture
+                  Declares that a pass renders into a texture
+                Compile
+                  Culls, orders, aliases and computes unbinds
+                Execute
+                  Runs the compiled passes
+                IsCompiled
+                  Returns whether the graph has been compiled
+                IsPassCulled
+                  Returns whether the pass was culled
+                GetCompiledPasses
+                  Returns the compiled passes in execution order
+                GetFinalUnbindSlots
+                  Returns the slots unbound after the last pass
+                GetPassName
+                  Returns the name of the pass
+                GetNumPhysicalTextures
+                  Returns the number of textures to allocate
+                GetPhysicalTextureDesc
+                  Returns the description of a physical texture
+                GetPhysicalTextureIndex
+                  Returns the physical texture backing a resource
+                GetTransientMemorySize
+                  Returns the bytes of the aliased transient textures
+                GetUnaliasedTransientMemorySize
+                  Returns the bytes without aliasing
+                RenderGraph
+                  Constructor.
+                ~RenderGraph
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderGraph final
+    {
+    public:
+        static constexpr const UINT INVALID_HANDLE = 0xFFFFFFFFu;
+
+        struct CompiledPass
+        {
+            UINT uPassIndex;
+            std::vector<UINT> aUnbindSlots;
+        };
+
+    public:
+        RenderGraph();
+        RenderGraph(const RenderGraph& other) = delete;
+        RenderGraph(RenderGraph&& other) = delete;
+        RenderGraph& operator=(const RenderGraph& other) = delete;
+        RenderGraph& operator=(RenderGraph&& other) = delete;
+        ~RenderGraph() = default;
+
+        void Reset();
+
+        UINT CreateTexture(_In_ PCWSTR pszName, _In_ const RenderGraphTextureDesc& desc);
+        UINT ImportTexture(_In_ PCWSTR pszName, _In_ BOOL bIsOutput);
+        UINT AddPass(_In_ PCWSTR pszName, _In_ std::function<void()> execute);
+        HRESULT ReadTexture(_In_ UINT uPass, _In_ UINT uResource, _In_ UINT uShaderSlot);
+        HRESULT ReadDepthStencil(_In_ UINT uPass, _In_ UINT uResource);
+        HRESULT WriteTexture(_In_ UINT uPass, _In_ UINT uResource);
+
+        HRESULT Compile();
+        void Execute(_In_ const std::function<void(UINT)>& beginPass, _In_ const std::function<void(UINT)>& unbindShaderResource) const;
+
+        BOOL IsCompiled() const;
+        BOOL IsPassCulled(_In_ UINT uPass) const;
+        const std::vector<CompiledPass>& GetCompiledPasses() const;
+        const std::vector<UINT>& GetFinalUnbindSlots() const;
+        PCWSTR GetPassName(_In_ UINT uPass) const;
+
+        UINT GetNumPhysicalTextures() const;
+        const RenderGraphTextureDesc& GetPhysicalTextureDesc(_In_ UINT uPhysical) const;
+        UINT GetPhysicalTextureIndex(_In_ UINT uResource) const;
+        UINT64 GetTransientMemorySize() const;
+        UINT64 GetUnaliasedTransientMemorySize() const;
+
+    private:
+        struct Resource
+        {
+            std::wstring szName;
+            RenderGraphTextureDesc desc;
+            BOOL bImported;
+            BOOL bOutput;
+            UINT uFirstUse;
+            UINT uLastUse;
+            UINT uPhysical;
+        };
+
+        struct TextureRead
+        {
+            UINT uResource;
+            UINT uShaderSlot;
+        };
+
+        struct Pass
+        {
+            std::wstring szName;
+            std::function<void()> execute;
+            std::vector<TextureRead> aReads;
+            std::vector<UINT> aWrites;
+            BOOL bCulled;
+        };
+
+        BOOL isWrittenBy(_In_ UINT uResource, _In_ const Pass& pass) const;
+        HRESULT cullPasses(_In_ const std::vector<std::vector<UINT>>& aProducers);
+        HRESULT sortPasses(_In_ const std::vector<std::vector<UINT>>& aSuccessors);
+        void computeLifetimes();
+        void aliasTransientTextures();
+        void computeUnbinds();
+
+        static UINT64 getTextureSize(_In_ const RenderGraphTextureDesc& desc);
+
+    private:
+        std::vector<Resource> m_aResources;
+        std::vector<Pass> m_aPasses;
+        std::vector<CompiledPass> m_aCompiledPasses;
+        std::vector<UINT> m_aFinalUnbindSlots;
+        std::vector<RenderGraphTextureDesc> m_aPhysicalTextures;
+        BOOL m_bCompiled;
+    };
+}
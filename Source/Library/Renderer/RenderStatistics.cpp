@@ -0,0 +1,295 @@
+#include "Renderer/RenderStatistics.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RenderStatistics
+
+      Summary:  Constructor
+
+      Modifies: [m_currentFrame, m_uNumCurrentPasses, m_aHistory,
+                 m_uNextHistoryIndex, m_uNumFrames, m_uFrameIndex].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderStatistics::RenderStatistics() :
+        m_currentFrame(),
+        m_uNumCurrentPasses(0u),
+        m_aHistory(HISTORY_SIZE),
+        m_uNextHistoryIndex(0u),
+        m_uNumFrames(0u),
+        m_uFrameIndex(0u)
+    {
+        resetPass(m_currentFrame.total, L"Total");
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::BeginFrame
+
+      Summary:  Starts counting a frame
+
+      Modifies: [m_currentFrame, m_uNumCurrentPasses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::BeginFrame()
+    {
+        m_currentFrame.uFrameIndex = m_uFrameIndex;
+        m_uNumCurrentPasses = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::EndFrame
+
+      Summary:  Sums the passes of the counted frame and adds it to the
+                history, replacing the oldest frame when it is full.
+                The pass vectors of the history are reused, so a frame
+                with the same passes as before does not allocate
+
+      Modifies: [m_currentFrame, m_aHistory, m_uNextHistoryIndex,
+                 m_uNumFrames, m_uFrameIndex].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::EndFrame()
+    {
+        resetPass(m_currentFrame.total, L"Total");
+        for (UINT i = 0u; i < m_uNumCurrentPasses; ++i)
+        {
+            accumulatePass(m_currentFrame.total, m_currentFrame.aPasses[i]);
+        }
+
+        FrameStatistics& frame = m_aHistory[m_uNextHistoryIndex];
+        frame.uFrameIndex = m_currentFrame.uFrameIndex;
+        frame.aPasses.assign(m_currentFrame.aPasses.begin(), m_currentFrame.aPasses.begin() + m_uNumCurrentPasses);
+        frame.total = m_currentFrame.total;
+
+        m_uNextHistoryIndex = (m_uNextHistoryIndex + 1u) % HISTORY_SIZE;
+        m_uNumFrames = m_uNumFrames < HISTORY_SIZE ? m_uNumFrames + 1u : HISTORY_SIZE;
+        ++m_uFrameIndex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::BeginPass
+
+      Summary:  Starts counting a pass, the following work is counted
+                in this pass until the next one begins
+
+      Args:     PCWSTR pszName
+                  Name of the pass
+
+      Modifies: [m_currentFrame, m_uNumCurrentPasses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::BeginPass(_In_ PCWSTR pszName)
+    {
+        if (m_currentFrame.aPasses.size() <= m_uNumCurrentPasses)
+        {
+            m_currentFrame.aPasses.emplace_back();
+        }
+
+        resetPass(m_currentFrame.aPasses[m_uNumCurrentPasses], pszName);
+        ++m_uNumCurrentPasses;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RecordDraw
+
+      Summary:  Counts a triangle list draw call
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices, or vertices of a non-indexed draw,
+                  of each instance
+                UINT uInstanceCount
+                  Number of instances
+
+      Modifies: [m_currentFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::RecordDraw(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount)
+    {
+        RenderPassStatistics& pass = getCurrentPass();
+        pass.uNumDraws += 1u;
+        pass.uNumInstances += uInstanceCount;
+        pass.uNumTriangles += uIndexCountPerInstance / 3u * uInstanceCount;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RecordStateChanges
+
+      Summary:  Counts objects bound to the device context
+
+      Args:     eStateCategory category
+                  Category of the bound state
+                UINT uNumObjects
+                  Number of objects bound by the call
+
+      Modifies: [m_currentFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::RecordStateChanges(_In_ eStateCategory category, _In_ UINT uNumObjects)
+    {
+        getCurrentPass().aNumStateChanges[static_cast<size_t>(category)] += uNumObjects;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RecordConstantBufferUpdate
+
+      Summary:  Counts an upload into a constant buffer
+
+      Args:     UINT uBytes
+                  Number of uploaded bytes
+
+      Modifies: [m_currentFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::RecordConstantBufferUpdate(_In_ UINT uBytes)
+    {
+        RenderPassStatistics& pass = getCurrentPass();
+        pass.uNumConstantBufferUpdates += 1u;
+        pass.uConstantBufferBytes += uBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RecordBufferUpload
+
+      Summary:  Counts an upload into a buffer that is not a constant
+                buffer
+
+      Args:     UINT uBytes
+                  Number of uploaded bytes
+
+      Modifies: [m_currentFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::RecordBufferUpload(_In_ UINT uBytes)
+    {
+        RenderPassStatistics& pass = getCurrentPass();
+        pass.uNumBufferUploads += 1u;
+        pass.uBufferUploadBytes += uBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::RecordSkippedDraws
+
+      Summary:  Counts draw calls the current pass did not submit since
+                their result was culled or already cached
+
+      Args:     UINT uNumDraws
+                  Number of skipped draw calls
+
+      Modifies: [m_currentFrame].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::RecordSkippedDraws(_In_ UINT uNumDraws)
+    {
+        getCurrentPass().uNumSkippedDraws += uNumDraws;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::GetLastFrame
+
+      Summary:  Returns the statistics of the last completed frame
+
+      Returns:  const FrameStatistics&
+                  Statistics of the last frame, empty before the first
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const FrameStatistics& RenderStatistics::GetLastFrame() const
+    {
+        return GetFrame(0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::GetNumFrames
+
+      Summary:  Returns the number of frames in the history
+
+      Returns:  UINT
+                  Number of frames, at most HISTORY_SIZE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderStatistics::GetNumFrames() const
+    {
+        return m_uNumFrames;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::GetFrame
+
+      Summary:  Returns the statistics of a frame of the history
+
+      Args:     UINT uAge
+                  Number of frames completed after the requested one,
+                  0 for the last frame
+
+      Returns:  const FrameStatistics&
+                  Statistics of the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const FrameStatistics& RenderStatistics::GetFrame(_In_ UINT uAge) const
+    {
+        assert(uAge < HISTORY_SIZE);
+
+        return m_aHistory[(m_uNextHistoryIndex + HISTORY_SIZE - 1u - uAge) % HISTORY_SIZE];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::getCurrentPass
+
+      Summary:  Returns the pass being counted, beginning the "Frame"
+                pass when no pass began yet
+
+      Modifies: [m_currentFrame, m_uNumCurrentPasses].
+
+      Returns:  RenderPassStatistics&
+                  Pass being counted
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderPassStatistics& RenderStatistics::getCurrentPass()
+    {
+        if (m_uNumCurrentPasses == 0u)
+        {
+            BeginPass(L"Frame");
+        }
+
+        return m_currentFrame.aPasses[m_uNumCurrentPasses - 1u];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::resetPass
+
+      Summary:  Clears the counters of a pass and renames it
+
+      Args:     RenderPassStatistics& pass
+                  Pass to reset
+                PCWSTR pszName
+                  Name of the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::resetPass(_Inout_ RenderPassStatistics& pass, _In_ PCWSTR pszName)
+    {
+        pass.szName = pszName;
+        pass.uNumDraws = 0u;
+        pass.uNumInstances = 0u;
+        pass.uNumTriangles = 0u;
+        for (UINT& uNumStateChanges : pass.aNumStateChanges)
+        {
+            uNumStateChanges = 0u;
+        }
+        pass.uNumConstantBufferUpdates = 0u;
+        pass.uConstantBufferBytes = 0u;
+        pass.uNumBufferUploads = 0u;
+        pass.uBufferUploadBytes = 0u;
+        pass.uNumSkippedDraws = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderStatistics::accumulatePass
+
+      Summary:  Adds the counters of a pass to a total
+
+      Args:     RenderPassStatistics& total
+                  Counters to add to
+                const RenderPassStatistics& pass
+                  Counters to add
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderStatistics::accumulatePass(_Inout_ RenderPassStatistics& total, _In_ const RenderPassStatistics& pass)
+    {
+        total.uNumDraws += pass.uNumDraws;
+        total.uNumInstances += pass.uNumInstances;
+        total.uNumTriangles += pass.uNumTriangles;
+        for (size_t i = 0u; i < static_cast<size_t>(eStateCategory::COUNT); ++i)
+        {
+            total.aNumStateChanges[i] += pass.aNumStateChanges[i];
+        }
+        total.uNumConstantBufferUpdates += pass.uNumConstantBufferUpdates;
+        total.uConstantBufferBytes += pass.uConstantBufferBytes;
+        total.uNumBufferUploads += pass.uNumBufferUploads;
+        total.uBufferUploadBytes += pass.uBufferUploadBytes;
+        total.uNumSkippedDraws += pass.uNumSkippedDraws;
+    }
+}
@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      RENDERSTATISTICS.H
+
+  Summary:   RenderStatistics header file contains declarations of
+             RenderStatistics class used to count the work submitted
+             by the renderer every frame.
+
+  Classes: RenderStatistics
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    enum class eStateCategory : size_t
+    {
+        INPUT_ASSEMBLER = 0,
+        SHADER,
+        CONSTANT_BUFFER,
+        SHADER_RESOURCE,
+        SAMPLER,
+        RASTERIZER,
+        OUTPUT_MERGER,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   RenderPassStatistics
+
+        Summary:  Work submitted within one render pass. State changes
+                  are counted per bound object, so binding three vertex
+                  buffers at once counts three. Skipped draws are draws
+                  the pass did not need to submit, such as culled or
+                  cached shadow casters
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderPassStatistics
+    {
+        std::wstring szName;
+        UINT uNumDraws;
+        UINT uNumInstances;
+        UINT uNumTriangles;
+        UINT aNumStateChanges[static_cast<size_t>(eStateCategory::COUNT)];
+        UINT uNumConstantBufferUpdates;
+        UINT uConstantBufferBytes;
+        UINT uNumBufferUploads;
+        UINT uBufferUploadBytes;
+        UINT uNumSkippedDraws;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   FrameStatistics
+
+        Summary:  Work submitted within one frame, per pass and in total
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct FrameStatistics
+    {
+        UINT64 uFrameIndex;
+        std::vector<RenderPassStatistics> aPasses;
+        RenderPassStatistics total;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderStatistics
+
+      Summary:  Counts the draws, triangles, state changes and uploads
+                of every frame by pass, and keeps the statistics of the
+                last HISTORY_SIZE frames. Work submitted before the
+                first pass of a frame is counted in a pass named "Frame"
+
+      Methods:  BeginFrame
+                  Starts counting a frame
+                EndFrame
+                  Adds the counted frame to the history
+                BeginPass
+                  Starts counting a pass
+                RecordDraw
+                  Counts a draw call
+                RecordStateChanges
+                  Counts bound objects of a state category
+                RecordConstantBufferUpdate
+                  Counts a constant buffer upload
+                RecordBufferUpload
+                  Counts an upload into another buffer
+                RecordSkippedDraws
+                  Counts draws that were not submitted
+                GetLastFrame
+                  Returns the statistics of the last completed frame
+                GetNumFrames
+                  Returns the number of frames in the history
+                GetFrame
+                  Returns the statistics of a frame of the history
+                RenderStatistics
+                  Constructor.
+                ~RenderStatistics
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderStatistics final
+    {
+    public:
+        static constexpr const UINT HISTORY_SIZE = 240u;
+
+    public:
+        RenderStatistics();
+        RenderStatistics(const RenderStatistics& other) = delete;
+        RenderStatistics(RenderStatistics&& other) = delete;
+        RenderStatistics& operator=(const RenderStatistics& other) = delete;
+        RenderStatistics& operator=(RenderStatistics&& other) = delete;
+        ~RenderStatistics() = default;
+
+        void BeginFrame();
+        void EndFrame();
+        void BeginPass(_In_ PCWSTR pszName);
+
+        void RecordDraw(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount);
+        void RecordStateChanges(_In_ eStateCategory category, _In_ UINT uNumObjects);
+        void RecordConstantBufferUpdate(_In_ UINT uBytes);
+        void RecordBufferUpload(_In_ UINT uBytes);
+        void RecordSkippedDraws(_In_ UINT uNumDraws);
+
+        const FrameStatistics& GetLastFrame() const;
+        UINT GetNumFrames() const;
+        const FrameStatistics& GetFrame(_In_ UINT uAge) const;
+
+    private:
+        RenderPassStatistics& getCurrentPass();
+        static void resetPass(_Inout_ RenderPassStatistics& pass, _In_ PCWSTR pszName);
+        static void accumulatePass(_Inout_ RenderPassStatistics& total, _In_ const RenderPassStatistics& pass);
+
+    private:
+        FrameStatistics m_currentFrame;
+        UINT m_uNumCurrentPasses;
+        std::vector<FrameStatistics> m_aHistory;
+        UINT m_uNextHistoryIndex;
+        UINT m_uNumFrames;
+        UINT64 m_uFrameIndex;
+    };
+}
@@ -4,6 +4,7 @@
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include "Renderer/TangentSpace.h"
 #include "Texture/DDSTextureLoader.h"
 
 namespace library
@@ -18,15 +19,17 @@ namespace library
                   Default color to shader the renderable
 
       Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
-                 m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
-                 m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
-                 m_aNormalData].
+                 m_normalBuffer, m_positionStream, m_aMeshes, m_aMaterials,
+                 m_vertexShader, m_pixelShader, m_outputColor, m_world,
+                 m_bHasNormalMap, m_aNormalData, m_bIsStatic,
+                 m_bQuantizedPositions, m_localBounds].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Renderable::Renderable(_In_ const XMFLOAT4& outputColor) :
         m_vertexBuffer(nullptr),
         m_indexBuffer(nullptr),
         m_constantBuffer(nullptr),
         m_normalBuffer(nullptr),
+        m_positionStream(),
         m_aMeshes(),
         m_aMaterials(),
         m_aNormalData(),
@@ -35,14 +38,18 @@ namespace library
         m_outputColor(outputColor),
         m_padding(),
         m_world(XMMatrixIdentity()),
-        m_bHasNormalMap(false)
+        m_bHasNormalMap(false),
+        m_bIsStatic(FALSE),
+        m_bQuantizedPositions(FALSE),
+        m_localBounds()
     {}
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::initialize
 
-      Summary:  Initializes the buffers and the world matrix
+      Summary:  Initializes the buffers, the world matrix and the
+                local bounds used to cull the renderable
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
@@ -51,8 +58,8 @@ namespace library
                 PCWSTR pszTextureFileName
                   File name of the texture to usen
 
-      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
-                 m_constantBuffer].
+      Modifies: [m_vertexBuffer, m_positionStream, m_normalBuffer,
+                 m_indexBuffer, m_constantBuffer, m_localBounds].
 
       Returns:  HRESULT
                   Status code
@@ -84,6 +91,18 @@ namespace library
             return hr;
         }
 
+        if (GetNumVertices() > 0u)
+        {
+            BoundingBox::CreateFromPoints(m_localBounds, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+        }
+
+        //create position buffer used by the depth only passes
+        m_positionStream.Extract(getVertices(), GetNumVertices(), m_bQuantizedPositions);
+        hr = m_positionStream.Initialize(pDevice);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
         if (m_aNormalData.empty()) {
             calculateNormalMapVectors();
         }
@@ -255,6 +274,19 @@ namespace library
         return m_world;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetLocalBounds
+
+      Summary:  Returns the axis aligned bounds of the vertices before
+                the world matrix is applied
+
+      Returns:  const BoundingBox&
+                  Local bounds, empty before initialization
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingBox& Renderable::GetLocalBounds() const {
+        return m_localBounds;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetOutputColor
 
@@ -272,100 +304,15 @@ namespace library
       Method:   Renderable::calculateNormalMapVectors
 
       Summary:  Calculate tangent and bitangent vectors of every vertex
+                through TangentSpace
 
       Modifies: [m_aNormalData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::calculateNormalMapVectors() {
-        UINT uNumFaces = GetNumIndices() / 3;
-        const SimpleVertex* aVertices = getVertices();
-        const WORD* aIndices = getIndices();
-        
-        m_aNormalData.resize(GetNumVertices(), NormalData());
-
-        XMFLOAT3 tangent, bitangent;
-
-        for (int i = 0; i < uNumFaces; ++i) {
-            calculateTangentBitangent(aVertices[aIndices[i * 3]], aVertices[aIndices[i * 3 + 1]],
-                aVertices[aIndices[i * 3 + 2]], tangent, bitangent);
-
-            m_aNormalData[aIndices[i * 3]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3]].Bitangent = bitangent;
-
-            m_aNormalData[aIndices[i * 3+1]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3+1]].Bitangent = bitangent;
-
-            m_aNormalData[aIndices[i * 3+2]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3+2]].Bitangent = bitangent;
-        }
+        TangentSpace::CalculateNormalMapVectors(getVertices(), GetNumVertices(), getIndices(), GetNumIndices(), m_aNormalData);
     }
 
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderable::calculateTangentBitangent
-
-      Summary:  Calculate tangent/bitangent vectors of the given face
-
-      Args:     SimpleVertex& v1
-                  The first vertex of the face
-                SimpleVertex& v2
-                  The second vertex of the face
-                SimpleVertex& v3
-                  The third vertex of the face
-                XMFLOAT3& tangent
-                  Calculated tangent vector
-                XMFLOAT3& bitangent
-                  Calculated bitangent vector
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderable::calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent)
-    {
-        XMFLOAT3 vector1, vector2;
-        XMFLOAT2 tuVector, tvVector;
-
-        // Calculate the two vectors for this face.
-        vector1.x = v2.Position.x - v1.Position.x;
-        vector1.y = v2.Position.y - v1.Position.y;
-        vector1.z = v2.Position.z - v1.Position.z;
-
-        vector2.x = v3.Position.x - v1.Position.x;
-        vector2.y = v3.Position.y - v1.Position.y;
-        vector2.z = v3.Position.z - v1.Position.z;
-
-        // Calculate the tu and tv texture space vectors.
-        tuVector.x = v2.TexCoord.x - v1.TexCoord.x;
-        tvVector.x = v2.TexCoord.y - v1.TexCoord.y;
-
-        tuVector.y = v3.TexCoord.x - v1.TexCoord.x;
-        tvVector.y = v3.TexCoord.y - v1.TexCoord.y;
-
-        // Calculate the denominator of the tangent/binormal equation.
-        float den = 1.0f / (tuVector.x * tvVector.y - tuVector.y * tvVector.x);
-
-        // Calculate the cross products and multiply by the coefficient to get the tangent and binormal.
-        tangent.x = (tvVector.y * vector1.x - tvVector.x * vector2.x) * den;
-        tangent.y = (tvVector.y * vector1.y - tvVector.x * vector2.y) * den;
-        tangent.z = (tvVector.y * vector1.z - tvVector.x * vector2.z) * den;
-
-        bitangent.x = (tuVector.x * vector2.x - tuVector.y * vector1.x) * den;
-        bitangent.y = (tuVector.x * vector2.y - tuVector.y * vector1.y) * den;
-        bitangent.z = (tuVector.x * vector2.z - tuVector.y * vector1.z) * den;
-
-        // Calculate the length of this normal.
-        float length = sqrt((tangent.x * tangent.x) + (tangent.y * tangent.y) + (tangent.z * tangent.z));
-
-        // Normalize the normal and then store it
-        tangent.x = tangent.x / length;
-        tangent.y = tangent.y / length;
-        tangent.z = tangent.z / length;
-
-        // Calculate the length of this normal.
-        length = sqrt((bitangent.x * bitangent.x) + (bitangent.y * bitangent.y) + (bitangent.z * bitangent.z));
-
-        // Normalize the normal and then store it
-        bitangent.x = bitangent.x / length;
-        bitangent.y = bitangent.y / length;
-        bitangent.z = bitangent.z / length;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::HasTexture
 
@@ -563,6 +510,20 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetPositionStream
+
+      Summary:  Return the position-only vertex stream, used by the
+                passes that only write depth
+
+      Returns:  PositionStream&
+                  Position stream
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PositionStream& Renderable::GetPositionStream() {
+        return m_positionStream;
+    }
+
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetMaterial
 
@@ -618,4 +579,66 @@ namespace library
         return static_cast<UINT>(m_aMaterials.size());
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::SetStatic
+
+      Summary:  Marks whether the renderable never moves after the scene
+                is initialized. Static renderables are merged into the
+                static batches of the scene, so transforming them after
+                initialization has no visible effect
+
+      Args:     BOOL bIsStatic
+                  Whether the renderable is static
+
+      Modifies: [m_bIsStatic].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::SetStatic(_In_ BOOL bIsStatic)
+    {
+        m_bIsStatic = bIsStatic;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::IsStatic
+
+      Summary:  Returns whether the renderable is static
+
+      Returns:  BOOL
+                  Whether the renderable is static
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Renderable::IsStatic() const
+    {
+        return m_bIsStatic;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::SetQuantizedPositions
+
+      Summary:  Marks whether the position stream stores the positions
+                as 16-bit integers relative to the bounds of the
+                renderable instead of floats. Must be set before the
+                renderable is initialized
+
+      Args:     BOOL bQuantizedPositions
+                  Whether to quantize the position stream
+
+      Modifies: [m_bQuantizedPositions].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::SetQuantizedPositions(_In_ BOOL bQuantizedPositions)
+    {
+        m_bQuantizedPositions = bQuantizedPositions;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::HasQuantizedPositions
+
+      Summary:  Returns whether the position stream is quantized
+
+      Returns:  BOOL
+                  Whether the position stream is quantized
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Renderable::HasQuantizedPositions() const
+    {
+        return m_bQuantizedPositions;
+    }
+
 }
@@ -14,6 +14,7 @@
 #include "Common.h"
 
 #include "Renderer/DataTypes.h"
+#include "Renderer/PositionStream.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
@@ -37,14 +38,26 @@ namespace library
                   Returns the index buffer
                 GetConstantBuffer
                   Returns the constant buffer
+                GetPositionStream
+                  Returns the position-only vertex stream
                 GetWorldMatrix
                   Returns the world matrix
+                GetLocalBounds
+                  Returns the bounds of the vertices in local space
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
                 GetNumIndices
                   Pure virtual function that returns the number of
                   indices
+                SetStatic
+                  Marks whether the renderable never moves after load
+                IsStatic
+                  Returns whether the renderable is static
+                SetQuantizedPositions
+                  Marks whether the position stream is quantized
+                HasQuantizedPositions
+                  Returns whether the position stream is quantized
                 Renderable
                   Constructor.
                 ~Renderable
@@ -52,6 +65,9 @@ namespace library
     C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
     class Renderable
     {
+        friend class InstanceBatcher;
+        friend class StaticBatch;
+
     public:
         static constexpr const UINT INVALID_MATERIAL = (0xFFFFFFFF);
 
@@ -96,8 +112,10 @@ namespace library
         ComPtr<ID3D11Buffer>& GetIndexBuffer();
         ComPtr<ID3D11Buffer>& GetConstantBuffer();
         ComPtr<ID3D11Buffer>& GetNormalBuffer();
+        PositionStream& GetPositionStream();
 
         const XMMATRIX& GetWorldMatrix() const;
+        const BoundingBox& GetLocalBounds() const;
         const XMFLOAT4& GetOutputColor() const;
         BOOL HasTexture() const;
         const std::shared_ptr<Material>& GetMaterial(UINT uIndex) const;
@@ -117,6 +135,12 @@ namespace library
         UINT GetNumMaterials() const;
         BOOL HasNormalMap() const;
 
+        void SetStatic(_In_ BOOL bIsStatic);
+        BOOL IsStatic() const;
+
+        void SetQuantizedPositions(_In_ BOOL bQuantizedPositions);
+        BOOL HasQuantizedPositions() const;
+
     protected:
         const virtual SimpleVertex* getVertices() const = 0;
         virtual const WORD* getIndices() const = 0;
@@ -126,13 +150,13 @@ namespace library
         );
 
         void calculateNormalMapVectors();
-        void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
 
     protected:
         ComPtr<ID3D11Buffer> m_vertexBuffer;
         ComPtr<ID3D11Buffer> m_indexBuffer;
         ComPtr<ID3D11Buffer> m_constantBuffer;
         ComPtr<ID3D11Buffer> m_normalBuffer;
+        PositionStream m_positionStream;
 
         std::vector<BasicMeshEntry> m_aMeshes;
         std::vector<std::shared_ptr<Material>> m_aMaterials;
@@ -145,5 +169,8 @@ namespace library
         BYTE m_padding[8];
         XMMATRIX m_world;
         BOOL m_bHasNormalMap;
+        BOOL m_bIsStatic;
+        BOOL m_bQuantizedPositions;
+        BoundingBox m_localBounds;
     };
 }
\ No newline at end of file
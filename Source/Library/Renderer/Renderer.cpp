@@ -1,5 +1,9 @@
 ﻿#include "Renderer/Renderer.h"
 
+#include "Profiler/Profiler.h"
+
+#include <algorithm>
+
 namespace library
 {
 
@@ -13,8 +17,26 @@ namespace library
                   m_swapChain1, m_renderTargetView, m_depthStencil,
                   m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
                   m_pszMainSceneName, m_camera, m_projection, m_scenes
-                  m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
-                  m_shadowPixelShader].
+                  m_invalidTexture, m_shadowVertexShader, m_shadowPixelShader,
+                  m_uWidth, m_uHeight, m_renderGraph, m_aRenderGraphTextures,
+                  m_uShadowMapResource, m_bRenderGraphDirty, m_instanceBatcher,
+                  m_instanceBuffer, m_uInstanceBufferCapacity, m_pInstanceScene,
+                  m_uInstanceView, m_bDepthPrepass, m_depthLessEqualState,
+                  m_commandContext, m_szCaptureFileName, m_bDynamicResolution,
+                  m_resolutionGovernor, m_uSceneColorResource,
+                  m_uRenderWidth, m_uRenderHeight, m_counterFrequency,
+                  m_lastFrameCounter, m_upscaleVertexShader,
+                  m_upscalePixelShader, m_cbUpscale, m_viewSet,
+                  m_aViewItems, m_offscreenViews, m_animationLodPolicy,
+                  m_aBakedModels, m_aBakedInstances, m_bakedInstanceBuffer,
+                  m_uBakedInstanceBufferCapacity, m_lightClusterer,
+                  m_aLightSpheres, m_aClusteredLights, m_lightBuffer,
+                  m_lightClusterBuffer, m_lightIndexBuffer,
+                  m_shadowCascades, m_aShadowCasterCaches,
+                  m_aStaticShadowMaps, m_shadowDepthStencil,
+                  m_shadowDepthStencilView, m_staticShadowDepthStencil,
+                  m_staticShadowDepthStencilView, m_minBlendState,
+                  m_threadPool].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Renderer::Renderer()
         : m_driverType(D3D_DRIVER_TYPE_NULL),
@@ -37,10 +59,96 @@ namespace library
         m_projection(),
         m_scenes(),
         m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png")),
-        m_shadowMapTexture(),
         m_shadowVertexShader(),
-        m_shadowPixelShader()
-    {}
+        m_shadowPixelShader(),
+        m_uWidth(0u),
+        m_uHeight(0u),
+        m_renderGraph(),
+        m_aRenderGraphTextures(),
+        m_uShadowMapResource(RenderGraph::INVALID_HANDLE),
+        m_bRenderGraphDirty(TRUE),
+        m_instanceBatcher(),
+        m_instanceBuffer(nullptr),
+        m_uInstanceBufferCapacity(0u),
+        m_pInstanceScene(nullptr),
+        m_uInstanceView(MAIN_VIEW),
+        m_bDepthPrepass(FALSE),
+        m_depthLessEqualState(nullptr),
+        m_commandContext(),
+        m_szCaptureFileName(),
+        m_bDynamicResolution(FALSE),
+        m_resolutionGovernor(
+            {
+                .targetFrameTime = 1.0f / 60.0f,
+                .minScale = 0.5f,
+                .maxScale = 1.0f,
+                .scaleStep = 0.05f,
+                .proportionalGain = 0.3f,
+                .integralGain = 0.05f,
+                .hysteresis = 0.05f,
+                .uHistoryLength = 8u
+            }
+        ),
+        m_uSceneColorResource(RenderGraph::INVALID_HANDLE),
+        m_uRenderWidth(0u),
+        m_uRenderHeight(0u),
+        m_counterFrequency(),
+        m_lastFrameCounter(),
+        m_upscaleVertexShader(),
+        m_upscalePixelShader(),
+        m_cbUpscale(nullptr),
+        m_viewSet(),
+        m_aViewItems(),
+        m_offscreenViews(),
+        m_animationLodPolicy(
+            {
+                .boundsScale = 1.5f,
+                .fullRateCoverage = 0.25f,
+                .uMaxUpdateInterval = 4u,
+                .uMaxSkippedLevels = 2u
+            }
+        ),
+        m_aBakedModels(),
+        m_aBakedInstances(),
+        m_bakedInstanceBuffer(nullptr),
+        m_uBakedInstanceBufferCapacity(0u),
+        m_lightClusterer(
+            {
+                .uNumClustersX = 16u,
+                .uNumClustersY = 9u,
+                .uNumClustersZ = 24u,
+                .firstSliceDepth = 1.0f
+            }
+        ),
+        m_aLightSpheres(),
+        m_aClusteredLights(),
+        m_lightBuffer(),
+        m_lightClusterBuffer(),
+        m_lightIndexBuffer(),
+        m_shadowCascades(
+            {
+                .uNumCascades = NUM_SHADOW_CASCADES,
+                .uResolution = 1024u,
+                .shadowDistance = 200.0f,
+                .splitLambda = 0.75f
+            }
+        ),
+        m_aShadowCasterCaches(),
+        m_aStaticShadowMaps(),
+        m_shadowDepthStencil(nullptr),
+        m_shadowDepthStencilView(nullptr),
+        m_staticShadowDepthStencil(nullptr),
+        m_staticShadowDepthStencilView(nullptr),
+        m_minBlendState(nullptr),
+        m_threadPool(std::thread::hardware_concurrency() > 1u ? std::thread::hardware_concurrency() - 1u : 0u)
+    {
+        // The camera and the shadow cascades of the first light of the main scene are always culled
+        m_viewSet.AddView(L"Main");
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            m_viewSet.AddView((L"Shadow" + std::to_wstring(i)).c_str());
+        }
+    }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -55,7 +163,10 @@ namespace library
                   m_d3dDevice1, m_immediateContext1, m_swapChain1,
                   m_swapChain, m_renderTargetView, m_vertexShader,
                   m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_cbShadowMatrix, m_uWidth, m_uHeight, m_renderGraph,
+                  m_aRenderGraphTextures, m_depthLessEqualState,
+                  m_minBlendState, m_commandContext, m_uRenderWidth,
+                  m_uRenderHeight, m_counterFrequency, m_cbUpscale].
 
       Returns:  HRESULT
                   Status code
@@ -68,6 +179,11 @@ namespace library
         GetClientRect(hWnd, &rc);
         UINT uWidth = static_cast<UINT>(rc.right - rc.left);
         UINT uHeight = static_cast<UINT>(rc.bottom - rc.top);
+        m_uWidth = uWidth;
+        m_uHeight = uHeight;
+        m_uRenderWidth = uWidth;
+        m_uRenderHeight = uHeight;
+        QueryPerformanceFrequency(&m_counterFrequency);
 
         UINT uCreateDeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
 #if defined(DEBUG) || defined(_DEBUG)
@@ -114,6 +230,8 @@ namespace library
             return hr;
         }
 
+        m_commandContext.Initialize(m_immediateContext.Get());
+
         // Obtain DXGI factory from device (since we used nullptr for pAdapter above)
         ComPtr<IDXGIFactory1> dxgiFactory;
         {
@@ -235,6 +353,45 @@ namespace library
 
         m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
 
+        // The main pass keeps the depth of the depth prepass and passes the pixels that wrote it
+        D3D11_DEPTH_STENCIL_DESC depthLessEqualDesc =
+        {
+            .DepthEnable = TRUE,
+            .DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL,
+            .DepthFunc = D3D11_COMPARISON_LESS_EQUAL,
+            .StencilEnable = FALSE
+        };
+        hr = m_d3dDevice->CreateDepthStencilState(&depthLessEqualDesc, m_depthLessEqualState.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The dynamic shadow casters keep the nearest depth of the static shadow map they are composited over
+        D3D11_BLEND_DESC minBlendDesc =
+        {
+            .AlphaToCoverageEnable = FALSE,
+            .IndependentBlendEnable = FALSE,
+            .RenderTarget =
+            {
+                {
+                    .BlendEnable = TRUE,
+                    .SrcBlend = D3D11_BLEND_ONE,
+                    .DestBlend = D3D11_BLEND_ONE,
+                    .BlendOp = D3D11_BLEND_OP_MIN,
+                    .SrcBlendAlpha = D3D11_BLEND_ONE,
+                    .DestBlendAlpha = D3D11_BLEND_ONE,
+                    .BlendOpAlpha = D3D11_BLEND_OP_MIN,
+                    .RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL
+                }
+            }
+        };
+        hr = m_d3dDevice->CreateBlendState(&minBlendDesc, m_minBlendState.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
         // Setup the viewport
         D3D11_VIEWPORT vp =
         {
@@ -301,14 +458,42 @@ namespace library
             return hr;
         }
 
-        //Initialize m_shadowMapTexture
-        m_shadowMapTexture = std::make_shared<RenderTexture>(uWidth, uHeight);
-        hr = m_shadowMapTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        D3D11_BUFFER_DESC upscaleBD =
+        {
+            .ByteWidth = sizeof(CBUpscale),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0
+        };
+        hr = m_d3dDevice->CreateBuffer(&upscaleBD, nullptr, m_cbUpscale.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (m_upscaleVertexShader && m_upscalePixelShader)
+        {
+            hr = m_upscaleVertexShader->Initialize(m_d3dDevice.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = m_upscalePixelShader->Initialize(m_d3dDevice.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = buildRenderGraph();
         if (FAILED(hr))
+        {
             return hr;
+        }
 
         //Initialize pointlights
-        for (UINT i = 0; i < NUM_LIGHTS; i++) {
+        for (UINT i = 0; i < m_scenes[m_pszMainSceneName]->GetNumPointLights(); i++) {
             m_scenes[m_pszMainSceneName]->GetPointLight(i)->Initialize(uWidth, uHeight);
         }
 
@@ -383,6 +568,21 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetMainSceneOrNull
+
+      Summary:  Return the scene updated and rendered every frame
+
+      Returns:  std::shared_ptr<Scene>
+                  The shared pointer to the main scene, nullptr before
+                  SetMainScene
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<Scene> Renderer::GetMainSceneOrNull()
+    {
+        return m_pszMainSceneName ? GetSceneOrNull(m_pszMainSceneName) : nullptr;
+    }
+
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::SetMainScene
 
@@ -421,548 +621,2502 @@ namespace library
                 std::shared_ptr<PixelShader>
                   pixel shader
 
-      Modifies: [m_shadowVertexShader, m_shadowPixelShader].
+      Modifies: [m_shadowVertexShader, m_shadowPixelShader,
+                  m_bRenderGraphDirty, m_aShadowCasterCaches].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader)
     {
         m_shadowVertexShader = move(vertexShader);
         m_shadowPixelShader = move(pixelShader);
+        m_bRenderGraphDirty = TRUE;
+        for (ShadowCasterCache& shadowCasterCache : m_aShadowCasterCaches)
+        {
+            shadowCasterCache.Invalidate();
+        }
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::HandleInput
+      Method:   Renderer::SetDepthPrepass
 
-      Summary:  Handle user mouse input
+      Summary:  Enables or disables the depth prepass. The prepass
+                writes the depth of the opaque renderables and voxels
+                front to back before the main pass, so the pixel
+                shaders of the main pass only run for visible pixels
 
-      Args:     DirectionsInput& directions
-                MouseRelativeMovement& mouseRelativeMovement
-                FLOAT deltaTime
+      Args:     BOOL bDepthPrepass
+                  Whether to render the depth prepass
+
+      Modifies: [m_bDepthPrepass, m_bRenderGraphDirty].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime)
+    void Renderer::SetDepthPrepass(_In_ BOOL bDepthPrepass)
     {
-        m_camera.HandleInput(directions, mouseRelativeMovement, deltaTime);
+        if (m_bDepthPrepass != bDepthPrepass)
+        {
+            m_bDepthPrepass = bDepthPrepass;
+            m_bRenderGraphDirty = TRUE;
+        }
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::Update
+      Method:   Renderer::SetUpscaleShaders
 
-      Summary:  Update the renderables each frame
+      Summary:  Set the shaders that stretch the scene color rendered at
+                the render scale over the back buffer. They are
+                initialized by Initialize, so they must be set before
 
-      Args:     FLOAT deltaTime
-                  Time difference of a frame
+      Args:     std::shared_ptr<VertexShader>
+                  Full screen triangle vertex shader
+                std::shared_ptr<PixelShader>
+                  Pixel shader sampling the scene color
+
+      Modifies: [m_upscaleVertexShader, m_upscalePixelShader,
+                  m_bRenderGraphDirty].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::Update(_In_ FLOAT deltaTime)
+    void Renderer::SetUpscaleShaders(_In_ std::shared_ptr<VertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader)
     {
-        m_scenes[m_pszMainSceneName]->Update(deltaTime);
-
-        m_camera.Update(deltaTime);
+        m_upscaleVertexShader = move(vertexShader);
+        m_upscalePixelShader = move(pixelShader);
+        m_bRenderGraphDirty = TRUE;
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::Render
-
-      Summary:  Render the frame
+      Method:   Renderer::SetDynamicResolution
+
+      Summary:  Enables or disables the dynamic resolution. When enabled
+                and the upscale shaders are set, the depth prepass, main
+                and skybox passes render into a scene color texture at
+                the scale picked by the resolution governor from the
+                measured frame times, and an upscale pass stretches it
+                over the back buffer
+
+      Args:     BOOL bDynamicResolution
+                  Whether to scale the resolution of the main pass
+                FLOAT targetFrameTime
+                  Frame time in seconds the governor holds
+
+      Modifies: [m_bDynamicResolution, m_resolutionGovernor,
+                  m_lastFrameCounter, m_bRenderGraphDirty].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::Render() {
+    void Renderer::SetDynamicResolution(_In_ BOOL bDynamicResolution, _In_ FLOAT targetFrameTime)
+    {
+        ResolutionGovernorDesc desc = m_resolutionGovernor.GetDesc();
+        desc.targetFrameTime = targetFrameTime;
+        m_resolutionGovernor.SetDesc(desc);
+        m_lastFrameCounter.QuadPart = 0;
 
-        //1 passs~
-        //RenderSceneToTexture();
+        if (m_bDynamicResolution != bDynamicResolution)
+        {
+            m_bDynamicResolution = bDynamicResolution;
+            m_bRenderGraphDirty = TRUE;
+        }
+    }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::AddView
 
-        //clear back buffer
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
-        //clear the depth buffer
-        m_immediateContext->ClearDepthStencilView(
-            m_depthStencilView.Get(),
-            D3D11_CLEAR_DEPTH,
-            1.0f,
-            0);
+      Summary:  Adds a view, such as a split screen player or a face of
+                a cube map capture, that renders the scenes into its own
+                texture before the main pass. The view is culled with
+                the camera and the light of the frame and shares their
+                bounds updates. Only the main camera is presented
 
-        //create camera cojnstant buffer and update
+      Args:     PCWSTR pszViewName
+                  Unique name of the view
+                UINT uWidth
+                  Width of the texture of the view
+                UINT uHeight
+                  Height of the texture of the view
 
-        XMFLOAT4 cameraPosition = XMFLOAT4();
-        XMStoreFloat4(&cameraPosition, m_camera.GetEye());
-        CBChangeOnCameraMovement cbChangeOnCamera = {
-               .View = XMMatrixTranspose(m_camera.GetView()),
-               .CameraPosition = cameraPosition
-        };
-        m_immediateContext->UpdateSubresource(
-            m_camera.GetConstantBuffer().Get(),
-            0,
-            nullptr,
-            &cbChangeOnCamera,
-            0,
-            0
-        );
+      Modifies: [m_viewSet, m_offscreenViews, m_bRenderGraphDirty].
 
+      Returns:  HRESULT
+                  Status code, E_FAIL if the name is taken
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::AddView(_In_ PCWSTR pszViewName, _In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        if (uWidth == 0u || uHeight == 0u)
+        {
+            return E_INVALIDARG;
+        }
 
+        if (m_viewSet.AddView(pszViewName) == ViewSet::INVALID_VIEW)
+        {
+            return E_FAIL;
+        }
 
-        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++) {
-            
-            CBLights cbLight = {
-                .PointLights = {},
-                .LightViews = {},
-                .LightProjections = {},
-            };
-            for (int i = 0; i < NUM_LIGHTS; i++)
-            {
-                FLOAT attenuationDistance = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetAttenuationDistance();
-                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-                cbLight.PointLights[i] = {
-                    .Position = it_Scene->second->GetPointLight(i)->GetPosition(),
-                    .Color = it_Scene->second->GetPointLight(i)->GetColor(),
-                    .AttenuationDistance = XMFLOAT4(
-                    attenuationDistance,
-                    attenuationDistance,
-                    attenuationDistanceSquared,
-                    attenuationDistanceSquared)
-                };
-                cbLight.LightViews[i] = XMMatrixTranspose(it_Scene->second->GetPointLight(i)->GetViewMatrix());
-                cbLight.LightProjections[i] = XMMatrixTranspose(it_Scene->second->GetPointLight(i)->GetProjectionMatrix());
-            }
+        m_offscreenViews[pszViewName] = {
+            .texture = std::make_shared<RenderTexture>(uWidth, uHeight, DXGI_FORMAT_R8G8B8A8_UNORM),
+            .depthStencil = nullptr,
+            .depthStencilView = nullptr
+        };
+        m_bRenderGraphDirty = TRUE;
 
-            m_immediateContext->UpdateSubresource(
-                m_cbLights.Get(),
-                0,
-                nullptr,
-                &cbLight,
-                0,
-                0
-            );
+        return S_OK;
+    }
 
-            if (it_Scene->second->GetSkyBox() != nullptr)
-            {
-                std::shared_ptr<Skybox> skybox = it_Scene->second->GetSkyBox();
-                UINT it_Material = skybox->GetMesh(0).uMaterialIndex;
-                eTextureSamplerType textureSamplerType = skybox->GetMaterial(it_Material)->pDiffuse->GetSamplerType();
-                m_immediateContext->PSSetShaderResources(3u, 1u, skybox->GetMaterial(it_Material)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-            }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::RemoveView
+
+      Summary:  Removes a view added with AddView
 
-            //for each renderables
+      Args:     PCWSTR pszViewName
+                  Name of the view
 
-            for (auto it_renderable = it_Scene->second->GetRenderables().begin(); it_renderable != it_Scene->second->GetRenderables().end(); it_renderable++) {
-                //create renderable constant buffer and update
-                // 
-                //set the vertex buffer, index buffer, input layout
-                UINT uStride[2] = { sizeof(SimpleVertex), sizeof(NormalData) };
-                UINT uOffset[2] = { 0,0 };
-                ComPtr<ID3D11Buffer> vertexNormalBuffers[2] =
-                { it_renderable->second->GetVertexBuffer(), it_renderable->second->GetNormalBuffer() };
+      Modifies: [m_viewSet, m_offscreenViews, m_bRenderGraphDirty].
 
-                m_immediateContext->IASetVertexBuffers(
-                    0u,
-                    2u,
-                    vertexNormalBuffers->GetAddressOf(),
-                    uStride,
-                    uOffset
-                );
-                m_immediateContext->IASetIndexBuffer(it_renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+      Returns:  HRESULT
+                  Status code, E_FAIL if no view was added with the name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::RemoveView(_In_ PCWSTR pszViewName)
+    {
+        // The main and shadow views are not offscreen views, so they are never removed
+        if (m_offscreenViews.erase(pszViewName) == 0u)
+        {
+            return E_FAIL;
+        }
 
-                m_immediateContext->IASetInputLayout(it_renderable->second->GetVertexLayout().Get());
+        m_viewSet.RemoveView(pszViewName);
+        m_bRenderGraphDirty = TRUE;
 
-                //update constant buffer
-                CBChangesEveryFrame cb = {
-                    .World = XMMatrixTranspose(it_renderable->second->GetWorldMatrix()),
-                    .OutputColor = it_renderable->second->GetOutputColor(),
-                    .HasNormalMap = it_renderable->second->HasNormalMap()
-                };
-                m_immediateContext->UpdateSubresource(it_renderable->second->GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
-                //set shaders and constant buffers, shader resources, and samplers
-                m_immediateContext->VSSetShader(it_renderable->second->GetVertexShader().Get(), nullptr, 0u);
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, it_renderable->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, it_renderable->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(it_renderable->second->GetPixelShader().Get(), nullptr, 0u);
-
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-
-                if (it_renderable->second->HasTexture()) {
-                    for (UINT i = 0; i < it_renderable->second->GetNumMeshes(); i++) {
-                        UINT materialIndex = it_renderable->second->GetMesh(i).uMaterialIndex;
-
-                        eTextureSamplerType textureSamplerType = it_renderable->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-
-                        m_immediateContext->PSSetShaderResources(0, 1, it_renderable->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0, 1, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        if (it_renderable->second->HasNormalMap())
-                        {
-                            eTextureSamplerType textureSamplerType = it_renderable->second->GetMaterial(materialIndex)->pNormal->GetSamplerType();
-                            m_immediateContext->PSSetShaderResources(1, 1, it_renderable->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(1, 1, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-                        m_immediateContext->DrawIndexed(it_renderable->second->GetMesh(i).uNumIndices, it_renderable->second->GetMesh(i).uBaseIndex, it_renderable->second->GetMesh(i).uBaseVertex);
-
-                    }
-                }
-                else {
-                    m_immediateContext->DrawIndexed(it_renderable->second->GetNumIndices(), 0, 0);
-                }
-            }
+        return S_OK;
+    }
 
-            std::vector<std::shared_ptr<Voxel>> voxels = it_Scene->second->GetVoxels();
-            for (int i = 0; i < voxels.size(); i++) {
-                UINT strides[3] = { sizeof(SimpleVertex), sizeof(NormalData), sizeof(InstanceData) };
-                UINT offsets[3] = { 0, 0, 0 };
-                ComPtr<ID3D11Buffer> vertexInstanceBuffers[3] =
-                { voxels[i]->GetVertexBuffer(), voxels[i]->GetNormalBuffer(), voxels[i]->GetInstanceBuffer() };
-                m_immediateContext->IASetVertexBuffers(
-                    0u,
-                    3u,
-                    vertexInstanceBuffers->GetAddressOf(),
-                    strides,
-                    offsets
-                );
-                m_immediateContext->IASetIndexBuffer(voxels[i]->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-                m_immediateContext->IASetInputLayout(voxels[i]->GetVertexLayout().Get());
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetViewTransform
 
-                //update constant buffer
-                CBChangesEveryFrame cb = {
-                    .World = XMMatrixTranspose(voxels[i]->GetWorldMatrix()),
-                    .OutputColor = voxels[i]->GetOutputColor(),
-                    .HasNormalMap = voxels[i]->HasNormalMap()
-                };
-                m_immediateContext->UpdateSubresource(voxels[i]->GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
-                //set shaders and constant buffers, shader resources, and samplers
-                m_immediateContext->VSSetShader(voxels[i]->GetVertexShader().Get(), nullptr, 0u);
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, voxels[i]->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, voxels[i]->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(voxels[i]->GetPixelShader().Get(), nullptr, 0u);
-
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-
-                if (voxels[i]->HasTexture())
-                {
-                    eTextureSamplerType textureSamplerType = voxels[i]->GetMaterial(0)->pDiffuse->GetSamplerType();
-                    eTextureSamplerType textureSamplerTypeNormal = voxels[i]->GetMaterial(0)->pNormal->GetSamplerType();
-                    ComPtr<ID3D11ShaderResourceView> shaderResources[2] = { voxels[i]->GetMaterial(0)->pDiffuse->GetTextureResourceView(),
-                                                    voxels[i]->GetMaterial(0)->pNormal->GetTextureResourceView() };
-                    ComPtr<ID3D11SamplerState> samplerStates[2] = { Texture::s_samplers[static_cast<size_t>(textureSamplerType)],
-                                                   Texture::s_samplers[static_cast<size_t>(textureSamplerTypeNormal)] };
-                    m_immediateContext->PSSetShaderResources(0, 2, shaderResources->GetAddressOf());
-                    m_immediateContext->PSSetSamplers(0, 2, samplerStates->GetAddressOf());
-                    m_immediateContext->DrawIndexedInstanced(voxels[i]->GetNumIndices(), voxels[i]->GetNumInstances(), 0, 0, 0);
+      Summary:  Sets the matrices a view added with AddView is culled
+                and rendered with
 
-                }
-                else
-                {
-                    m_immediateContext->DrawIndexedInstanced(voxels[i]->GetNumIndices(), voxels[i]->GetNumInstances(), 0, 0, 0);
-                }
+      Args:     PCWSTR pszViewName
+                  Name of the view
+                const XMMATRIX& view
+                  View matrix
+                const XMMATRIX& projection
+                  Projection matrix
 
-            }
+      Modifies: [m_viewSet].
 
+      Returns:  HRESULT
+                  Status code, E_FAIL if no view was added with the name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::SetViewTransform(_In_ PCWSTR pszViewName, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection)
+    {
+        if (!m_offscreenViews.contains(pszViewName))
+        {
+            return E_FAIL;
+        }
 
-            for (auto it_model = it_Scene->second->GetModels().begin(); it_model != it_Scene->second->GetModels().end(); it_model++) {
-                //create renderable constant buffer and update
-                // 
-                //set the vertex buffer, index buffer, input layout
+        m_viewSet.SetViewTransform(m_viewSet.FindView(pszViewName), view, projection);
 
+        return S_OK;
+    }
 
-                UINT strides[3] = { static_cast<UINT>(sizeof(SimpleVertex)),static_cast<UINT>(sizeof(NormalData)), static_cast<UINT>(sizeof(AnimationData)) };
-                UINT offsets[3] = { 0, 0, 0 };
-                ComPtr<ID3D11Buffer> vertexAnimationBuffers[3] = { it_model->second->GetVertexBuffer(), it_model->second->GetNormalBuffer(), it_model->second->GetAnimationBuffer() };
 
-                m_immediateContext->IASetVertexBuffers(
-                    0u,
-                    3u,
-                    vertexAnimationBuffers->GetAddressOf(),
-                    strides,
-                    offsets
-                );
-                m_immediateContext->IASetIndexBuffer(it_model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-                m_immediateContext->IASetInputLayout(it_model->second->GetVertexLayout().Get());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetViewTextureOrNull
 
+      Summary:  Returns the texture a view added with AddView renders
+                into, to be sampled by later frames
 
+      Args:     PCWSTR pszViewName
+                  Name of the view
 
+      Returns:  std::shared_ptr<RenderTexture>
+                  The texture, or nullptr if there is no such view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<RenderTexture> Renderer::GetViewTextureOrNull(_In_ PCWSTR pszViewName) const
+    {
+        auto it_view = m_offscreenViews.find(pszViewName);
+        if (it_view == m_offscreenViews.end())
+        {
+            return nullptr;
+        }
 
-                //update constant buffer
-                CBChangesEveryFrame cb = {
-                    .World = XMMatrixTranspose(it_model->second->GetWorldMatrix()),
-                    .OutputColor = it_model->second->GetOutputColor(),
-                    .HasNormalMap = it_model->second->HasNormalMap()
-                };
-                m_immediateContext->UpdateSubresource(it_model->second->GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
+        return it_view->second.texture;
+    }
 
 
-                CBSkinning cbSk = {
-                    .BoneTransforms = {}
-                };
-                for (UINT i = 0; i < it_model->second->GetBoneTransforms().size(); i++) {
-                    cbSk.BoneTransforms[i] = XMMatrixTranspose(it_model->second->GetBoneTransforms()[i]);
-                }
-                m_immediateContext->UpdateSubresource(
-                    it_model->second->GetSkinningConstantBuffer().Get(),
-                    0,
-                    nullptr,
-                    &cbSk,
-                    0,
-                    0
-                );
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::CaptureFrame
 
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, it_model->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(4u, 1u, it_model->second->GetSkinningConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetShader(it_model->second->GetVertexShader().Get(), nullptr, 0);
-
-
-
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, it_model->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(it_model->second->GetPixelShader().Get(), nullptr, 0u);
-
-                m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-
-                if (it_model->second->HasTexture()) {
-                    for (UINT i = 0; i < it_model->second->GetNumMeshes(); i++) {
-                        UINT materialIndex = it_model->second->GetMesh(i).uMaterialIndex;
-                        if (it_model->second->GetMaterial(materialIndex)->pDiffuse)
-                        {
-                            eTextureSamplerType textureSamplerType = it_model->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                            m_immediateContext->PSSetShaderResources(0u, 1u, it_model->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-                        if (it_model->second->GetMaterial(materialIndex)->pNormal)
-                        {
-                            eTextureSamplerType textureSamplerType = it_model->second->GetMaterial(materialIndex)->pNormal->GetSamplerType();
-                            m_immediateContext->PSSetShaderResources(1u, 1u, it_model->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-                        m_immediateContext->DrawIndexed(it_model->second->GetMesh(i).uNumIndices, it_model->second->GetMesh(i).uBaseIndex, it_model->second->GetMesh(i).uBaseVertex);
-                    }
-                }
-                else {
-                    m_immediateContext->DrawIndexed(it_model->second->GetNumIndices(), 0, 0);
-                }
-            }
+      Summary:  Records every command of the next rendered frame into
+                a capture file that the capture analyzer reads
 
+      Args:     PCWSTR pszFileName
+                  Path of the capture file
 
-            
-            if (it_Scene->second->GetSkyBox() != nullptr)
-            {
-                std::shared_ptr<Skybox> skybox = it_Scene->second->GetSkyBox();
-                UINT uStride = sizeof(SimpleVertex);
-                UINT uOffset = 0u;
-                m_immediateContext->IASetVertexBuffers(0, 1, skybox->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-                m_immediateContext->IASetInputLayout(skybox->GetVertexLayout().Get());
-                m_immediateContext->IASetIndexBuffer(skybox->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+      Modifies: [m_szCaptureFileName].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::CaptureFrame(_In_ PCWSTR pszFileName)
+    {
+        m_szCaptureFileName = pszFileName;
+    }
 
-                CBChangesEveryFrame Skycb = {
-                    .World = XMMatrixTranspose(skybox->GetWorldMatrix() *XMMatrixTranslationFromVector(m_camera.GetEye())),
-                    .OutputColor = skybox->GetOutputColor(),
-                    .HasNormalMap = skybox->HasNormalMap(),
-                };
-                m_immediateContext->UpdateSubresource(skybox->GetConstantBuffer().Get(), 0, nullptr, &Skycb, 0, 0);
-                // set the shaders and constant buffers
-                m_immediateContext->VSSetShader(skybox->GetVertexShader().Get(), nullptr, 0);
-                m_immediateContext->VSSetConstantBuffers(0, 1, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1, 1, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2, 1, skybox->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetShader(skybox->GetPixelShader().Get(), nullptr, 0);
-                // for each mesh of the skybox
-                for (UINT i = 0; i < skybox->GetNumMeshes(); ++i)
-                {
-                    UINT Materialindex = skybox->GetMesh(i).uMaterialIndex;
-                    eTextureSamplerType textureSamplerType = skybox->GetMaterial(Materialindex)->pDiffuse->GetSamplerType();
-                    m_immediateContext->PSSetShaderResources(3u, 1u, skybox->GetMaterial(Materialindex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    // draw
-                    m_immediateContext->DrawIndexed(skybox->GetMesh(i).uNumIndices, skybox->GetMesh(i).uBaseIndex, skybox->GetMesh(i).uBaseVertex);
-                }
-            }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::HandleInput
 
-            m_swapChain->Present(0, 0);
-        }
+      Summary:  Handle user mouse input
 
+      Args:     DirectionsInput& directions
+                MouseRelativeMovement& mouseRelativeMovement
+                FLOAT deltaTime
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime)
+    {
+        m_camera.HandleInput(directions, mouseRelativeMovement, deltaTime);
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::RenderSceneToTexture
+      Method:   Renderer::Update
 
-      Summary:  Render scene to the texture
+      Summary:  Update the renderables each frame, animating the
+                skinned models on the thread pool of the renderer at
+                the level of detail picked from the camera and models
+                of the previous update
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::RenderSceneToTexture()
+    void Renderer::Update(_In_ FLOAT deltaTime)
     {
-        //Unbind current pixel shader resources
-        ID3D11ShaderResourceView* const pSRV[2] = { NULL, NULL };
-        m_immediateContext->PSSetShaderResources(0, 2, pSRV);
-        m_immediateContext->PSSetShaderResources(2, 1, pSRV);
-
-        //change the rendertarget to shadow maptexture
-        m_immediateContext->OMSetRenderTargets(1, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(),
-            m_depthStencilView.Get());
-
-        //clear the render target and depth stencil view
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-
-        //render renerable/voxels/models with shadow map shaders
-
-        for (auto it_renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin();
-            it_renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); it_renderable++) {
-            //create renderable constant buffer and update
-            // 
-            //set the vertex buffer, index buffer, input layout
-            UINT uStride[1] = { sizeof(SimpleVertex) };
-            UINT uOffset[1] = { 0 };
-
-            m_immediateContext->IASetVertexBuffers(
-                0u,
-                1u,
-                it_renderable->second->GetVertexBuffer().GetAddressOf(),
-                uStride,
-                uOffset
-            );
-            m_immediateContext->IASetIndexBuffer(it_renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+        m_scenes[m_pszMainSceneName]->Update(m_threadPool, deltaTime);
 
-            m_immediateContext->IASetInputLayout(it_renderable->second->GetVertexLayout().Get());
+        m_camera.Update(deltaTime);
+        updateAnimationLods();
+    }
 
-            //update constant buffer
-            CBShadowMatrix cb = {
-                .World = XMMatrixTranspose(it_renderable->second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = false
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0, nullptr, &cb, 0, 0);
-            //set shaders and constant buffers, shader resources, and samplers
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
-            for (UINT i = 0; i < it_renderable->second->GetNumMeshes(); i++)
-            {
-                m_immediateContext->DrawIndexed(
-                    it_renderable->second->GetMesh(i).uNumIndices,
-                    it_renderable->second->GetMesh(i).uBaseIndex,
-                    it_renderable->second->GetMesh(i).uBaseVertex
-                );
-            }
-        }
 
-        for (auto it_voxel = m_scenes[m_pszMainSceneName]->GetVoxels().begin();
-            it_voxel != m_scenes[m_pszMainSceneName]->GetVoxels().end(); it_voxel++)
-        {
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::Render
 
-            UINT strides[2] = { sizeof(SimpleVertex),  sizeof(InstanceData) };
-            UINT offsets[2] = { 0, 0 };
-            ComPtr<ID3D11Buffer> vertexInstanceBuffers[2] =
-            { it_voxel->get()->GetVertexBuffer(), it_voxel->get()->GetInstanceBuffer() };
-            m_immediateContext->IASetVertexBuffers(
-                0u,
-                1u,
-                vertexInstanceBuffers[0].GetAddressOf(),
-                &strides[0],
-                &offsets[0]
-            );
-            m_immediateContext->IASetVertexBuffers(2u, 1u, vertexInstanceBuffers[1].GetAddressOf(), &strides[1], &offsets[1]);
-            m_immediateContext->IASetIndexBuffer(it_voxel->get()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
-
-            //update constant buffer
-            CBShadowMatrix cb = {
-                .World = XMMatrixTranspose(it_voxel->get()->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = true,
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0, nullptr, &cb, 0, 0);
-            //set shaders and constant buffers, shader resources, and samplers
-
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
-
-            for (UINT i = 0u; i < it_voxel->get()->GetNumMeshes(); ++i)
-            {
-                // Render the triangles
-                m_immediateContext->DrawIndexedInstanced(
-                    it_voxel->get()->GetMesh(i).uNumIndices,
-                    it_voxel->get()->GetNumInstances(),
-                    it_voxel->get()->GetMesh(i).uBaseIndex,
-                    it_voxel->get()->GetMesh(i).uBaseVertex,
-                    0u
-                );
-            }
-        }
+      Summary:  Render the frame by executing the compiled render graph.
+                The work of the frame is counted into the render
+                statistics, and its commands are written into the
+                capture file when CaptureFrame was called before
 
-        for (auto it_model = m_scenes[m_pszMainSceneName]->GetModels().begin(); it_model != m_scenes[m_pszMainSceneName]->GetModels().end(); it_model++) {
-            //create renderable constant buffer and update
-            // 
-            //set the vertex buffer, index buffer, input layout
+      Modifies: [m_pInstanceScene, m_commandContext,
+                  m_szCaptureFileName, m_resolutionGovernor,
+                  m_uRenderWidth, m_uRenderHeight, m_lastFrameCounter,
+                  m_viewSet, m_aViewItems].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::Render()
+    {
+        PROFILE_SCOPE("Renderer", "Render");
 
+        if (m_bRenderGraphDirty)
+        {
+            if (FAILED(buildRenderGraph()))
+            {
+                OutputDebugString(L"Failed to build the render graph\n");
+                return;
+            }
+        }
 
-            UINT strides[1] = { static_cast<UINT>(sizeof(SimpleVertex)) };
-            UINT offsets[1] = { 0 };
-            ComPtr<ID3D11Buffer> vertexAnimationBuffers[1] = { it_model->second->GetVertexBuffer() };
+        updateRenderScale();
 
-            m_immediateContext->IASetVertexBuffers(
-                0u,
-                1u,
-                vertexAnimationBuffers->GetAddressOf(),
-                strides,
-                offsets
-            );
-            m_immediateContext->IASetIndexBuffer(it_model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-            m_immediateContext->IASetInputLayout(it_model->second->GetVertexLayout().Get());
+        if (!m_szCaptureFileName.empty())
+        {
+            m_commandContext.GetFrameCapture().Begin();
+            nameCaptureObjects();
+        }
+        m_commandContext.BeginFrame();
 
+        // Every view of the frame is culled once before any pass renders
+        updateViews();
 
-            //update constant buffer
-            CBShadowMatrix cb = {
-                .World = XMMatrixTranspose(it_model->second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = false
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0, nullptr, &cb, 0, 0);
+        //update the camera constant buffers, shared by the depth prepass and the main pass
+        updateCameraConstants(MAIN_VIEW);
 
+        // The renderables moved since the last frame, so the instances are batched again
+        m_pInstanceScene = nullptr;
 
+        m_renderGraph.Execute(
+            [this](UINT uPass)
+            {
+                m_commandContext.BeginPass(m_renderGraph.GetPassName(uPass));
+            },
+            [this](UINT uSlot)
+            {
+                ID3D11ShaderResourceView* const pNullShaderResourceView = nullptr;
+                m_commandContext.PSSetShaderResources(uSlot, 1u, &pNullShaderResourceView);
+            }
+        );
 
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+        m_commandContext.EndFrame();
 
-            for (UINT i = 0; i < it_model->second->GetNumMeshes(); i++)
+        if (m_commandContext.GetFrameCapture().IsCapturing())
+        {
+            if (FAILED(m_commandContext.GetFrameCapture().End(m_szCaptureFileName.c_str())))
             {
-                m_immediateContext->DrawIndexed
-                (it_model->second->GetMesh(i).uNumIndices,
-                    it_model->second->GetMesh(i).uBaseIndex,
-                    it_model->second->GetMesh(i).uBaseVertex);
+                OutputDebugString(L"Failed to write the frame capture\n");
             }
-
+            m_szCaptureFileName.clear();
         }
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+
+        PROFILE_SCOPE("Renderer", "Present");
+        m_swapChain->Present(0, 0);
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::GetDriverType
 
-      Summary:  Returns the Direct3D driver type
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderMainPass
 
-      Returns:  D3D_DRIVER_TYPE
-                  The Direct3D driver type used
+      Summary:  Render the renderables, voxels and models of every scene
+                onto the back buffer, or onto the scene color at the
+                render scale with the dynamic resolution. With the depth
+                prepass the depth buffer already holds the opaque
+                geometry, so it is kept and tested with less equal
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    D3D_DRIVER_TYPE Renderer::GetDriverType() const
+    void Renderer::renderMainPass()
     {
-        return m_driverType;
+        PROFILE_SCOPE("Renderer", "MainPass");
+
+        ID3D11RenderTargetView* pSceneRenderTargetView = getSceneRenderTargetView();
+        m_commandContext.OMSetRenderTargets(1u, &pSceneRenderTargetView, m_depthStencilView.Get());
+        setViewport(m_uRenderWidth, m_uRenderHeight);
+
+        //clear back buffer
+        m_commandContext.ClearRenderTargetView(pSceneRenderTargetView, Colors::MidnightBlue);
+        if (m_bDepthPrepass)
+        {
+            m_commandContext.OMSetDepthStencilState(m_depthLessEqualState.Get(), 0u);
+        }
+        else
+        {
+            //clear the depth buffer
+            m_commandContext.ClearDepthStencilView(
+                m_depthStencilView.Get(),
+                D3D11_CLEAR_DEPTH,
+                1.0f,
+                0);
+        }
+
+        bindShadowMap();
+        renderScenes(MAIN_VIEW);
+
+        m_commandContext.OMSetDepthStencilState(nullptr, 0u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderViewPass
+
+      Summary:  Render the scenes and skyboxes seen by a view added with
+                AddView into its texture, with its own depth buffer. The
+                camera constants are restored for the main view after
+
+      Args:     const std::wstring& szViewName
+                  Name of the view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderViewPass(_In_ const std::wstring& szViewName)
+    {
+        PROFILE_SCOPE("Renderer", "ViewPass");
+
+        auto it_view = m_offscreenViews.find(szViewName);
+        if (it_view == m_offscreenViews.end() || !it_view->second.depthStencilView)
+        {
+            return;
+        }
+
+        const OffscreenView& view = it_view->second;
+        UINT uView = m_viewSet.FindView(szViewName.c_str());
+
+        m_commandContext.OMSetRenderTargets(1u, view.texture->GetRenderTargetView().GetAddressOf(), view.depthStencilView.Get());
+        setViewport(view.texture->GetWidth(), view.texture->GetHeight());
+        m_commandContext.ClearRenderTargetView(view.texture->GetRenderTargetView().Get(), Colors::MidnightBlue);
+        m_commandContext.ClearDepthStencilView(view.depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+        bindShadowMap();
+        updateCameraConstants(uView);
+        renderScenes(uView);
+        renderSkyboxes(XMMatrixInverse(nullptr, m_viewSet.GetViewMatrix(uView)).r[3]);
+        updateCameraConstants(MAIN_VIEW);
+
+        ID3D11RenderTargetView* pSceneRenderTargetView = getSceneRenderTargetView();
+        m_commandContext.OMSetRenderTargets(1u, &pSceneRenderTargetView, m_depthStencilView.Get());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderScenes
+
+      Summary:  Render the renderables, voxels and models of every scene
+                that are visible in a view onto the bound render target.
+                The camera constant buffers must hold the view
+
+      Args:     UINT uView
+                  Index of the view in the view set
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderScenes(_In_ UINT uView)
+    {
+        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++) {
+            if (FAILED(updateLights(*it_Scene->second, uView)))
+            {
+                continue;
+            }
+
+            if (it_Scene->second->GetSkyBox() != nullptr)
+            {
+                std::shared_ptr<Skybox> skybox = it_Scene->second->GetSkyBox();
+                UINT it_Material = skybox->GetMesh(0).uMaterialIndex;
+                eTextureSamplerType textureSamplerType = skybox->GetMaterial(it_Material)->pDiffuse->GetSamplerType();
+                m_commandContext.PSSetShaderResources(3u, 1u, skybox->GetMaterial(it_Material)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                m_commandContext.PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+            }
+
+            // Renderables and models without skinning that share mesh, materials and shaders are drawn instanced
+            if (SUCCEEDED(prepareInstances(*it_Scene->second, uView)))
+            {
+                for (const InstanceBatcher::InstanceGroup& group : m_instanceBatcher.GetGroups())
+                {
+                    renderInstances(*group.pRenderable, group.uFirstInstance, group.uNumInstances, FALSE);
+                }
+            }
+            else
+            {
+                OutputDebugString(L"Failed to update the instance buffer\n");
+            }
+
+            // The visible items of the view are ordered front to back
+            for (UINT uItem : m_viewSet.GetVisibleItems(uView))
+            {
+                const ViewItem& item = m_aViewItems[uItem];
+                if (item.pScene == it_Scene->second.get() && item.type == eViewItemType::VOXEL)
+                {
+                    renderVoxel(*static_cast<Voxel*>(item.pRenderable), FALSE);
+                }
+            }
+
+            for (UINT uItem : m_viewSet.GetVisibleItems(uView))
+            {
+                const ViewItem& item = m_aViewItems[uItem];
+                if (item.pScene == it_Scene->second.get() && item.type == eViewItemType::SKINNED_MODEL && !static_cast<Model*>(item.pRenderable)->GetBakedAnimation())
+                {
+                    renderSkinnedModel(*static_cast<Model*>(item.pRenderable));
+                }
+            }
+
+            // Skinned models playing baked frames are drawn instanced, one crowd for every baked animation
+            renderBakedModels(*it_Scene->second, uView);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderSkinnedModel
+
+      Summary:  Render a skinned model onto the bound render target with
+                the bone transforms of its last update
+
+      Args:     Model& model
+                  Skinned model to render
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderSkinnedModel(_In_ Model& model)
+    {
+        //set the vertex buffer, index buffer, input layout
+        UINT strides[3] = { static_cast<UINT>(sizeof(SimpleVertex)),static_cast<UINT>(sizeof(NormalData)), static_cast<UINT>(sizeof(AnimationData)) };
+        UINT offsets[3] = { 0, 0, 0 };
+        ComPtr<ID3D11Buffer> vertexAnimationBuffers[3] = { model.GetVertexBuffer(), model.GetNormalBuffer(), model.GetAnimationBuffer() };
+
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            3u,
+            vertexAnimationBuffers->GetAddressOf(),
+            strides,
+            offsets
+        );
+        m_commandContext.IASetIndexBuffer(model.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+        m_commandContext.IASetInputLayout(model.GetVertexLayout().Get());
+
+        //update constant buffer
+        CBChangesEveryFrame cb = {
+            .World = XMMatrixTranspose(model.GetWorldMatrix()),
+            .OutputColor = model.GetOutputColor(),
+            .HasNormalMap = model.HasNormalMap()
+        };
+        m_commandContext.UpdateSubresource(model.GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
+
+        // The bone palette buffer is sized to the bones of the model, so only they are uploaded
+        if (model.GetBonePaletteBuffer())
+        {
+            PackedBoneTransform aBonePalette[MAX_NUM_BONES];
+            model.FillBonePalette(aBonePalette);
+            m_commandContext.UpdateSubresource(
+                model.GetBonePaletteBuffer().Get(),
+                0,
+                nullptr,
+                aBonePalette,
+                0,
+                0
+            );
+        }
+
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(2u, 1u, model.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetShaderResources(8u, 1u, model.GetBonePaletteView().GetAddressOf());
+        m_commandContext.VSSetShader(model.GetVertexShader().Get(), nullptr, 0);
+
+        m_commandContext.PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(2u, 1u, model.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_commandContext.PSSetShader(model.GetPixelShader().Get(), nullptr, 0u);
+
+        if (model.HasTexture()) {
+            for (UINT i = 0; i < model.GetNumMeshes(); i++) {
+                UINT materialIndex = model.GetMesh(i).uMaterialIndex;
+                if (model.GetMaterial(materialIndex)->pDiffuse)
+                {
+                    eTextureSamplerType textureSamplerType = model.GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(0u, 1u, model.GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (model.GetMaterial(materialIndex)->pNormal)
+                {
+                    eTextureSamplerType textureSamplerType = model.GetMaterial(materialIndex)->pNormal->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(1u, 1u, model.GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                m_commandContext.DrawIndexed(model.GetMesh(i).uNumIndices, model.GetMesh(i).uBaseIndex, model.GetMesh(i).uBaseVertex);
+            }
+        }
+        else {
+            m_commandContext.DrawIndexed(model.GetNumIndices(), 0, 0);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderBakedModels
+
+      Summary:  Render the skinned models of a scene playing baked frames
+                that are visible in a view onto the bound render target.
+                The models sharing a baked animation and a model file
+                form a crowd drawn with one instanced draw per mesh, and
+                every instance only carries its world matrix and the
+                offset of its baked frame, instead of the skinning
+                constants of a model
+
+      Args:     Scene& scene
+                  Scene to render
+                UINT uView
+                  Index of the view in the view set
+
+      Modifies: [m_aBakedModels, m_aBakedInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderBakedModels(_In_ Scene& scene, _In_ UINT uView)
+    {
+        m_aBakedModels.clear();
+        for (UINT uItem : m_viewSet.GetVisibleItems(uView))
+        {
+            const ViewItem& item = m_aViewItems[uItem];
+            if (item.pScene == &scene && item.type == eViewItemType::SKINNED_MODEL && static_cast<Model*>(item.pRenderable)->GetBakedAnimation())
+            {
+                m_aBakedModels.push_back(static_cast<Model*>(item.pRenderable));
+            }
+        }
+        if (m_aBakedModels.empty())
+        {
+            return;
+        }
+
+        PROFILE_SCOPE("Renderer", "BakedModels");
+
+        // The stable sort keeps the front to back order of the view within every crowd
+        std::stable_sort(m_aBakedModels.begin(), m_aBakedModels.end(),
+            [](const Model* pA, const Model* pB)
+            {
+                if (pA->GetBakedAnimation() != pB->GetBakedAnimation())
+                {
+                    return std::less<const BakedAnimation*>()(pA->GetBakedAnimation().get(), pB->GetBakedAnimation().get());
+                }
+                return pA->GetFilePath() < pB->GetFilePath();
+            }
+        );
+
+        m_aBakedInstances.resize(m_aBakedModels.size());
+        for (size_t i = 0u; i < m_aBakedModels.size(); ++i)
+        {
+            m_aBakedInstances[i] =
+            {
+                .Transformation = m_aBakedModels[i]->GetWorldMatrix(),
+                .uFrameOffset = m_aBakedModels[i]->GetBakedFrameOffset(),
+                .aPadding = { 0u, 0u, 0u }
+            };
+        }
+        if (FAILED(updateBakedInstanceBuffer()))
+        {
+            OutputDebugString(L"Failed to update the baked instance buffer\n");
+            return;
+        }
+
+        UINT uFirstInstance = 0u;
+        for (UINT i = 1u; i <= m_aBakedModels.size(); ++i)
+        {
+            if (i == m_aBakedModels.size() ||
+                m_aBakedModels[i]->GetBakedAnimation() != m_aBakedModels[uFirstInstance]->GetBakedAnimation() ||
+                m_aBakedModels[i]->GetFilePath() != m_aBakedModels[uFirstInstance]->GetFilePath())
+            {
+                renderBakedInstances(*m_aBakedModels[uFirstInstance], uFirstInstance, i - uFirstInstance);
+                uFirstInstance = i;
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderBakedInstances
+
+      Summary:  Render instances of a skinned model playing baked frames
+                onto the bound render target with its own shaders and
+                materials. The vertex shader must be a baked skinning
+                shader, which reads the world matrix and the frame
+                offset from the baked instance buffer and the bones from
+                the structured buffer of the baked animation
+
+      Args:     Model& model
+                  Model whose buffers, shaders, materials and baked
+                  animation are shared by every instance
+                UINT uFirstInstance
+                  Index of the first instance in the baked instance
+                  buffer
+                UINT uNumInstances
+                  Number of instances to render
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderBakedInstances(_In_ Model& model, _In_ UINT uFirstInstance, _In_ UINT uNumInstances)
+    {
+        //set the vertex buffer, animation buffer, baked instance buffer, index buffer, input layout
+        UINT uStride[3] = { sizeof(SimpleVertex), sizeof(AnimationData), sizeof(BakedInstanceData) };
+        UINT uOffset[3] = { 0, 0, 0 };
+        ComPtr<ID3D11Buffer> vertexAnimationInstanceBuffers[3] =
+        { model.GetVertexBuffer(), model.GetAnimationBuffer(), m_bakedInstanceBuffer };
+
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            3u,
+            vertexAnimationInstanceBuffers->GetAddressOf(),
+            uStride,
+            uOffset
+        );
+        m_commandContext.IASetIndexBuffer(model.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+        m_commandContext.IASetInputLayout(model.GetVertexLayout().Get());
+
+        //update constant buffer
+        CBChangesEveryFrame cb = {
+            .World = XMMatrixIdentity(),
+            .OutputColor = model.GetOutputColor(),
+            .HasNormalMap = model.HasNormalMap()
+        };
+        m_commandContext.UpdateSubresource(model.GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
+
+        m_commandContext.VSSetShader(model.GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(2u, 1u, model.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetShaderResources(7u, 1u, model.GetBakedAnimation()->GetShaderResourceView().GetAddressOf());
+
+        m_commandContext.PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(2u, 1u, model.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_commandContext.PSSetShader(model.GetPixelShader().Get(), nullptr, 0u);
+
+        if (model.HasTexture()) {
+            for (UINT i = 0; i < model.GetNumMeshes(); i++) {
+                UINT materialIndex = model.GetMesh(i).uMaterialIndex;
+                if (model.GetMaterial(materialIndex)->pDiffuse)
+                {
+                    eTextureSamplerType textureSamplerType = model.GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(0u, 1u, model.GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (model.GetMaterial(materialIndex)->pNormal)
+                {
+                    eTextureSamplerType textureSamplerType = model.GetMaterial(materialIndex)->pNormal->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(1u, 1u, model.GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                m_commandContext.DrawIndexedInstanced(
+                    model.GetMesh(i).uNumIndices,
+                    uNumInstances,
+                    model.GetMesh(i).uBaseIndex,
+                    model.GetMesh(i).uBaseVertex,
+                    uFirstInstance
+                );
+            }
+        }
+        else {
+            m_commandContext.DrawIndexedInstanced(model.GetNumIndices(), uNumInstances, 0, 0, uFirstInstance);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindShadowMap
+
+      Summary:  Bind the shadow map to the pixel shader slot 2, or unbind
+                the slot when the shadow pass was culled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindShadowMap()
+    {
+        // The shadow map only exists when the shadow pass survived the render graph compilation
+        std::shared_ptr<RenderTexture> shadowMapTexture = getRenderGraphTexture(m_uShadowMapResource);
+        if (shadowMapTexture)
+        {
+            m_commandContext.PSSetShaderResources(2u, 1u, shadowMapTexture->GetShaderResourceView().GetAddressOf());
+            m_commandContext.PSSetSamplers(2u, 1u, shadowMapTexture->GetSamplerState().GetAddressOf());
+        }
+        else
+        {
+            ID3D11ShaderResourceView* const pNullShaderResourceView = nullptr;
+            m_commandContext.PSSetShaderResources(2u, 1u, &pNullShaderResourceView);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderDepthPrepass
+
+      Summary:  Render the depth of the instanced renderables and voxels
+                of every scene that are visible from the camera front to
+                back without a pixel shader.
+                The colour pass vertex shaders are used, so the main
+                pass reproduces the exact same depth. Skinned models
+                write their depth in the main pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderDepthPrepass()
+    {
+        PROFILE_SCOPE("Renderer", "DepthPrepass");
+
+        m_commandContext.OMSetRenderTargets(0u, nullptr, m_depthStencilView.Get());
+        setViewport(m_uRenderWidth, m_uRenderHeight);
+        m_commandContext.ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++)
+        {
+            if (SUCCEEDED(prepareInstances(*it_Scene->second, MAIN_VIEW)))
+            {
+                for (const InstanceBatcher::InstanceGroup& group : m_instanceBatcher.GetGroups())
+                {
+                    renderInstances(*group.pRenderable, group.uFirstInstance, group.uNumInstances, TRUE);
+                }
+            }
+            else
+            {
+                OutputDebugString(L"Failed to update the instance buffer\n");
+            }
+
+            for (UINT uItem : m_viewSet.GetVisibleItems(MAIN_VIEW))
+            {
+                const ViewItem& item = m_aViewItems[uItem];
+                if (item.pScene == it_Scene->second.get() && item.type == eViewItemType::VOXEL)
+                {
+                    renderVoxel(*static_cast<Voxel*>(item.pRenderable), TRUE);
+                }
+            }
+        }
+
+        ID3D11RenderTargetView* pSceneRenderTargetView = getSceneRenderTargetView();
+        m_commandContext.OMSetRenderTargets(1u, &pSceneRenderTargetView, m_depthStencilView.Get());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderSkyboxPass
+
+      Summary:  Render the skybox of every scene onto the target of the
+                main pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderSkyboxPass()
+    {
+        PROFILE_SCOPE("Renderer", "SkyboxPass");
+
+        renderSkyboxes(m_camera.GetEye());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderSkyboxes
+
+      Summary:  Render the skybox of every scene centered on an eye onto
+                the bound render target
+
+      Args:     const XMVECTOR& eye
+                  Position of the eye of the view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderSkyboxes(_In_ const XMVECTOR& eye)
+    {
+        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++)
+        {
+            if (it_Scene->second->GetSkyBox() != nullptr)
+            {
+                std::shared_ptr<Skybox> skybox = it_Scene->second->GetSkyBox();
+                UINT uStride = sizeof(SimpleVertex);
+                UINT uOffset = 0u;
+                m_commandContext.IASetVertexBuffers(0, 1, skybox->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+                m_commandContext.IASetInputLayout(skybox->GetVertexLayout().Get());
+                m_commandContext.IASetIndexBuffer(skybox->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+
+                CBChangesEveryFrame Skycb = {
+                    .World = XMMatrixTranspose(skybox->GetWorldMatrix() *XMMatrixTranslationFromVector(eye)),
+                    .OutputColor = skybox->GetOutputColor(),
+                    .HasNormalMap = skybox->HasNormalMap(),
+                };
+                m_commandContext.UpdateSubresource(skybox->GetConstantBuffer().Get(), 0, nullptr, &Skycb, 0, 0);
+                // set the shaders and constant buffers
+                m_commandContext.VSSetShader(skybox->GetVertexShader().Get(), nullptr, 0);
+                m_commandContext.VSSetConstantBuffers(0, 1, m_camera.GetConstantBuffer().GetAddressOf());
+                m_commandContext.VSSetConstantBuffers(1, 1, m_cbChangeOnResize.GetAddressOf());
+                m_commandContext.VSSetConstantBuffers(2, 1, skybox->GetConstantBuffer().GetAddressOf());
+                m_commandContext.PSSetShader(skybox->GetPixelShader().Get(), nullptr, 0);
+                // for each mesh of the skybox
+                for (UINT i = 0; i < skybox->GetNumMeshes(); ++i)
+                {
+                    UINT Materialindex = skybox->GetMesh(i).uMaterialIndex;
+                    eTextureSamplerType textureSamplerType = skybox->GetMaterial(Materialindex)->pDiffuse->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(3u, 1u, skybox->GetMaterial(Materialindex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                    // draw
+                    m_commandContext.DrawIndexed(skybox->GetMesh(i).uNumIndices, skybox->GetMesh(i).uBaseIndex, skybox->GetMesh(i).uBaseVertex);
+                }
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderUpscalePass
+
+      Summary:  Stretch the rectangle of the scene color rendered at the
+                render scale over the back buffer with a full screen
+                triangle. The texture coordinates are clamped half a
+                texel inside the rectangle, so the bilinear filter does
+                not read the stale texels next to it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderUpscalePass()
+    {
+        PROFILE_SCOPE("Renderer", "UpscalePass");
+
+        std::shared_ptr<RenderTexture> sceneColorTexture = getRenderGraphTexture(m_uSceneColorResource);
+        if (!sceneColorTexture)
+        {
+            return;
+        }
+
+        m_commandContext.OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), nullptr);
+        setViewport(m_uWidth, m_uHeight);
+
+        FLOAT width = static_cast<FLOAT>(sceneColorTexture->GetWidth());
+        FLOAT height = static_cast<FLOAT>(sceneColorTexture->GetHeight());
+        CBUpscale cbUpscale =
+        {
+            .TexCoordScale = XMFLOAT4(
+                static_cast<FLOAT>(m_uRenderWidth) / width,
+                static_cast<FLOAT>(m_uRenderHeight) / height,
+                (static_cast<FLOAT>(m_uRenderWidth) - 0.5f) / width,
+                (static_cast<FLOAT>(m_uRenderHeight) - 0.5f) / height)
+        };
+        m_commandContext.UpdateSubresource(m_cbUpscale.Get(), 0u, nullptr, &cbUpscale, 0u, 0u);
+
+        // The full screen triangle is generated from the vertex IDs
+        m_commandContext.IASetInputLayout(nullptr);
+        m_commandContext.VSSetShader(m_upscaleVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.PSSetShader(m_upscalePixelShader->GetPixelShader().Get(), nullptr, 0u);
+        m_commandContext.PSSetConstantBuffers(0u, 1u, m_cbUpscale.GetAddressOf());
+        m_commandContext.PSSetShaderResources(0u, 1u, sceneColorTexture->GetShaderResourceView().GetAddressOf());
+        m_commandContext.PSSetSamplers(0u, 1u, sceneColorTexture->GetSamplerState().GetAddressOf());
+        m_commandContext.Draw(3u, 0u);
+
+        m_commandContext.OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::RenderSceneToTexture
+
+      Summary:  Render scene to the shadow map texture of the render
+                graph, which holds the cascades side by side. Casters
+                outside the frustum of a cascade are skipped for it.
+                The static casters of a cascade are rendered into its
+                static shadow map only when the cascade or one of them
+                moved, and the dynamic casters are composited over a
+                copy of it every frame. The draws the pass did not
+                submit are counted as skipped draws
+
+      Modifies: [m_aShadowCasterCaches, m_commandContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::RenderSceneToTexture()
+    {
+        PROFILE_SCOPE("Renderer", "ShadowPass");
+
+        // Shader resources bound to the shadow map are unbound by the render graph before this pass
+        std::shared_ptr<RenderTexture> shadowMapTexture = getRenderGraphTexture(m_uShadowMapResource);
+        if (!shadowMapTexture || !m_shadowDepthStencilView || !m_shadowVertexShader || !m_shadowPixelShader)
+        {
+            return;
+        }
+
+        //collect the static casters visible from every cascade of the first light of the main scene and count the culled draws
+        Scene* pMainScene = m_scenes[m_pszMainSceneName].get();
+        const UINT uResolution = m_shadowCascades.GetDesc().uResolution;
+        UINT uNumSkippedDraws = 0u;
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            UINT uNumStaticDraws = 0u;
+            m_aShadowCasterCaches[i].BeginFrame(m_viewSet.GetViewMatrix(SHADOW_VIEW + i), m_viewSet.GetProjectionMatrix(SHADOW_VIEW + i));
+            for (UINT uItem = 0u; uItem < static_cast<UINT>(m_aViewItems.size()); ++uItem)
+            {
+                const ViewItem& item = m_aViewItems[uItem];
+                if (item.pScene != pMainScene)
+                {
+                    continue;
+                }
+
+                if (!m_viewSet.IsVisible(SHADOW_VIEW + i, uItem))
+                {
+                    uNumSkippedDraws += item.pRenderable->GetNumMeshes();
+                }
+                else if (item.bStaticCaster)
+                {
+                    m_aShadowCasterCaches[i].AddStaticCaster(item.pRenderable, item.pRenderable->GetWorldMatrix());
+                    uNumStaticDraws += item.pRenderable->GetNumMeshes();
+                }
+            }
+
+            //render the static casters into the static shadow map of the cascade when the cached one is out of date
+            if (m_aShadowCasterCaches[i].EndFrame())
+            {
+                m_commandContext.OMSetRenderTargets(1, m_aStaticShadowMaps[i]->GetRenderTargetView().GetAddressOf(),
+                    m_staticShadowDepthStencilView.Get());
+                setViewport(uResolution, uResolution);
+                m_commandContext.ClearRenderTargetView(m_aStaticShadowMaps[i]->GetRenderTargetView().Get(), Colors::White);
+                m_commandContext.ClearDepthStencilView(m_staticShadowDepthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+                renderShadowCasters(TRUE, SHADOW_VIEW + i);
+            }
+            else
+            {
+                uNumSkippedDraws += uNumStaticDraws;
+            }
+        }
+
+        //change the rendertarget to shadow maptexture and copy the static shadow maps into their cascades
+        m_commandContext.OMSetRenderTargets(1, shadowMapTexture->GetRenderTargetView().GetAddressOf(),
+            m_shadowDepthStencilView.Get());
+        m_commandContext.ClearDepthStencilView(m_shadowDepthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            m_commandContext.CopySubresourceRegion(shadowMapTexture->GetTexture2D().Get(), 0u, i * uResolution, 0u, 0u,
+                m_aStaticShadowMaps[i]->GetTexture2D().Get(), 0u, nullptr);
+        }
+
+        //render the dynamic casters over the static shadow maps, keeping the nearest depth of both
+        m_commandContext.OMSetBlendState(m_minBlendState.Get(), nullptr, 0xFFFFFFFF);
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            D3D11_VIEWPORT vp =
+            {
+                .TopLeftX = static_cast<FLOAT>(i * uResolution),
+                .TopLeftY = 0.0f,
+                .Width = static_cast<FLOAT>(uResolution),
+                .Height = static_cast<FLOAT>(uResolution),
+                .MinDepth = 0.0f,
+                .MaxDepth = 1.0f,
+            };
+            m_commandContext.RSSetViewports(1u, &vp);
+            renderShadowCasters(FALSE, SHADOW_VIEW + i);
+        }
+        m_commandContext.OMSetBlendState(nullptr, nullptr, 0xFFFFFFFF);
+        m_commandContext.RecordSkippedDraws(uNumSkippedDraws);
+
+        ID3D11RenderTargetView* pSceneRenderTargetView = getSceneRenderTargetView();
+        m_commandContext.OMSetRenderTargets(1, &pSceneRenderTargetView, m_depthStencilView.Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderShadowCasters
+
+      Summary:  Render the static or the dynamic casters of the main
+                scene visible from a cascade of its first light onto
+                the bound render target
+
+      Args:     BOOL bStatic
+                  TRUE to render the static casters, FALSE to render
+                  the dynamic casters
+                UINT uView
+                  Index of the shadow view of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderShadowCasters(_In_ BOOL bStatic, _In_ UINT uView)
+    {
+        Scene* pMainScene = m_scenes[m_pszMainSceneName].get();
+        for (UINT uItem : m_viewSet.GetVisibleItems(uView))
+        {
+            const ViewItem& item = m_aViewItems[uItem];
+            if (item.pScene != pMainScene || item.bStaticCaster != bStatic)
+            {
+                continue;
+            }
+
+            if (item.type == eViewItemType::VOXEL)
+            {
+                renderVoxelToShadowMap(*static_cast<Voxel*>(item.pRenderable), uView);
+            }
+            else
+            {
+                renderRenderableToShadowMap(*item.pRenderable, uView);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderInstances
+
+      Summary:  Render instances of a renderable onto the bound render
+                target with its own shaders and materials. The world
+                matrices are read from the instance buffer, so the world
+                matrix of the constant buffer is the identity
+
+      Args:     Renderable& renderable
+                  Renderable whose buffers, shaders and materials are
+                  shared by every instance
+                UINT uFirstInstance
+                  Index of the first instance in the instance buffer
+                UINT uNumInstances
+                  Number of instances to render
+                BOOL bDepthOnly
+                  Whether to render only the depth, without a pixel
+                  shader and materials
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderInstances(_In_ Renderable& renderable, _In_ UINT uFirstInstance, _In_ UINT uNumInstances, _In_ BOOL bDepthOnly)
+    {
+        //set the vertex buffer, normal buffer, instance buffer, index buffer, input layout
+        UINT uStride[3] = { sizeof(SimpleVertex), sizeof(NormalData), sizeof(InstanceData) };
+        UINT uOffset[3] = { 0, 0, 0 };
+        ComPtr<ID3D11Buffer> vertexNormalInstanceBuffers[3] =
+        { renderable.GetVertexBuffer(), renderable.GetNormalBuffer(), m_instanceBuffer };
+
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            3u,
+            vertexNormalInstanceBuffers->GetAddressOf(),
+            uStride,
+            uOffset
+        );
+        m_commandContext.IASetIndexBuffer(renderable.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+
+        m_commandContext.IASetInputLayout(renderable.GetVertexLayout().Get());
+
+        //update constant buffer
+        CBChangesEveryFrame cb = {
+            .World = XMMatrixIdentity(),
+            .OutputColor = renderable.GetOutputColor(),
+            .HasNormalMap = renderable.HasNormalMap()
+        };
+        m_commandContext.UpdateSubresource(renderable.GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
+        //set shaders and constant buffers, shader resources, and samplers
+        m_commandContext.VSSetShader(renderable.GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(2u, 1u, renderable.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(2u, 1u, renderable.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_commandContext.PSSetShader(bDepthOnly ? nullptr : renderable.GetPixelShader().Get(), nullptr, 0u);
+
+        if (renderable.HasTexture()) {
+            for (UINT i = 0; i < renderable.GetNumMeshes(); i++) {
+                UINT materialIndex = renderable.GetMesh(i).uMaterialIndex;
+
+                if (!bDepthOnly && renderable.GetMaterial(materialIndex)->pDiffuse)
+                {
+                    eTextureSamplerType textureSamplerType = renderable.GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(0, 1, renderable.GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(0, 1, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                if (!bDepthOnly && renderable.GetMaterial(materialIndex)->pNormal)
+                {
+                    eTextureSamplerType textureSamplerType = renderable.GetMaterial(materialIndex)->pNormal->GetSamplerType();
+                    m_commandContext.PSSetShaderResources(1, 1, renderable.GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+                    m_commandContext.PSSetSamplers(1, 1, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                }
+                m_commandContext.DrawIndexedInstanced(
+                    renderable.GetMesh(i).uNumIndices,
+                    uNumInstances,
+                    renderable.GetMesh(i).uBaseIndex,
+                    renderable.GetMesh(i).uBaseVertex,
+                    uFirstInstance
+                );
+            }
+        }
+        else {
+            m_commandContext.DrawIndexedInstanced(renderable.GetNumIndices(), uNumInstances, 0, 0, uFirstInstance);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderVoxel
+
+      Summary:  Render the instances of a voxel onto the bound render
+                target
+
+      Args:     Voxel& voxel
+                  Voxel to render
+                BOOL bDepthOnly
+                  Whether to render only the depth, without a pixel
+                  shader and materials
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderVoxel(_In_ Voxel& voxel, _In_ BOOL bDepthOnly)
+    {
+        UINT strides[3] = { sizeof(SimpleVertex), sizeof(NormalData), sizeof(InstanceData) };
+        UINT offsets[3] = { 0, 0, 0 };
+        ComPtr<ID3D11Buffer> vertexInstanceBuffers[3] =
+        { voxel.GetVertexBuffer(), voxel.GetNormalBuffer(), voxel.GetInstanceBuffer() };
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            3u,
+            vertexInstanceBuffers->GetAddressOf(),
+            strides,
+            offsets
+        );
+        m_commandContext.IASetIndexBuffer(voxel.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+        m_commandContext.IASetInputLayout(voxel.GetVertexLayout().Get());
+
+
+        //update constant buffer
+        CBChangesEveryFrame cb = {
+            .World = XMMatrixTranspose(voxel.GetWorldMatrix()),
+            .OutputColor = voxel.GetOutputColor(),
+            .HasNormalMap = voxel.HasNormalMap()
+        };
+        m_commandContext.UpdateSubresource(voxel.GetConstantBuffer().Get(), 0, nullptr, &cb, 0, 0);
+        //set shaders and constant buffers, shader resources, and samplers
+        m_commandContext.VSSetShader(voxel.GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.VSSetConstantBuffers(2u, 1u, voxel.GetConstantBuffer().GetAddressOf());
+
+        if (bDepthOnly)
+        {
+            m_commandContext.PSSetShader(nullptr, nullptr, 0u);
+            m_commandContext.DrawIndexedInstanced(voxel.GetNumIndices(), voxel.GetNumInstances(), 0, 0, 0);
+            return;
+        }
+
+        m_commandContext.PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(2u, 1u, voxel.GetConstantBuffer().GetAddressOf());
+        m_commandContext.PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_commandContext.PSSetShader(voxel.GetPixelShader().Get(), nullptr, 0u);
+
+        if (voxel.HasTexture())
+        {
+            eTextureSamplerType textureSamplerType = voxel.GetMaterial(0)->pDiffuse->GetSamplerType();
+            eTextureSamplerType textureSamplerTypeNormal = voxel.GetMaterial(0)->pNormal->GetSamplerType();
+            ComPtr<ID3D11ShaderResourceView> shaderResources[2] = { voxel.GetMaterial(0)->pDiffuse->GetTextureResourceView(),
+                                            voxel.GetMaterial(0)->pNormal->GetTextureResourceView() };
+            ComPtr<ID3D11SamplerState> samplerStates[2] = { Texture::s_samplers[static_cast<size_t>(textureSamplerType)],
+                                           Texture::s_samplers[static_cast<size_t>(textureSamplerTypeNormal)] };
+            m_commandContext.PSSetShaderResources(0, 2, shaderResources->GetAddressOf());
+            m_commandContext.PSSetSamplers(0, 2, samplerStates->GetAddressOf());
+        }
+        m_commandContext.DrawIndexedInstanced(voxel.GetNumIndices(), voxel.GetNumInstances(), 0, 0, 0);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateViews
+
+      Summary:  Collects the renderables, static batches, models and
+                voxels of every scene into the view set once, points the
+                main view at the camera and the shadow views at the
+                cascades of the first light of the main scene, and culls
+                every view. The cascades are fitted to the camera and
+                the world bounds of the main scene, which skip skinned
+                models since they are unbounded. Static
+                renderables are drawn through the static batches of
+                their scene, and skinned models are never culled since
+                their animated pose leaves the bounds of the bind pose.
+                Static batches and voxels never move on their own, so
+                they are cached as static shadow casters
+
+      Modifies: [m_viewSet, m_aViewItems, m_shadowCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateViews()
+    {
+        PROFILE_SCOPE("Renderer", "UpdateViews");
+
+        m_viewSet.SetViewTransform(MAIN_VIEW, m_camera.GetView(), m_projection);
+
+        m_viewSet.ClearItems();
+        m_aViewItems.clear();
+        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++)
+        {
+            Scene* pScene = it_Scene->second.get();
+            for (auto it_renderable = pScene->GetRenderables().begin(); it_renderable != pScene->GetRenderables().end(); it_renderable++)
+            {
+                if (it_renderable->second->IsStatic())
+                {
+                    continue;
+                }
+
+                m_viewSet.AddItem(it_renderable->second->GetLocalBounds(), it_renderable->second->GetWorldMatrix());
+                m_aViewItems.push_back({ .pScene = pScene, .pszName = it_renderable->first.c_str(), .pRenderable = it_renderable->second.get(), .type = eViewItemType::RENDERABLE, .bStaticCaster = FALSE });
+            }
+
+            for (std::shared_ptr<StaticBatch>& staticBatch : pScene->GetStaticBatches())
+            {
+                m_viewSet.AddItem(staticBatch->GetLocalBounds(), staticBatch->GetWorldMatrix());
+                m_aViewItems.push_back({ .pScene = pScene, .pszName = L"", .pRenderable = staticBatch.get(), .type = eViewItemType::RENDERABLE, .bStaticCaster = TRUE });
+            }
+
+            for (auto it_model = pScene->GetModels().begin(); it_model != pScene->GetModels().end(); it_model++)
+            {
+                if (it_model->second->IsSkinned())
+                {
+                    m_viewSet.AddUnboundedItem(it_model->second->GetWorldMatrix());
+                    m_aViewItems.push_back({ .pScene = pScene, .pszName = it_model->first.c_str(), .pRenderable = it_model->second.get(), .type = eViewItemType::SKINNED_MODEL, .bStaticCaster = FALSE });
+                }
+                else
+                {
+                    m_viewSet.AddItem(it_model->second->GetLocalBounds(), it_model->second->GetWorldMatrix());
+                    m_aViewItems.push_back({ .pScene = pScene, .pszName = it_model->first.c_str(), .pRenderable = it_model->second.get(), .type = eViewItemType::MODEL, .bStaticCaster = FALSE });
+                }
+            }
+
+            for (std::shared_ptr<Voxel>& voxel : pScene->GetVoxels())
+            {
+                m_viewSet.AddItem(voxel->GetLocalBounds(), voxel->GetWorldMatrix());
+                m_aViewItems.push_back({ .pScene = pScene, .pszName = L"", .pRenderable = voxel.get(), .type = eViewItemType::VOXEL, .bStaticCaster = TRUE });
+            }
+        }
+
+        m_viewSet.TransformBounds();
+        if (m_pszMainSceneName && m_scenes.contains(m_pszMainSceneName) && m_scenes[m_pszMainSceneName]->GetNumPointLights() > 0u)
+        {
+            Scene* pMainScene = m_scenes[m_pszMainSceneName].get();
+            BoundingBox sceneBounds;
+            BOOL bHasBounds = FALSE;
+            for (UINT uItem = 0u; uItem < static_cast<UINT>(m_aViewItems.size()); ++uItem)
+            {
+                if (m_aViewItems[uItem].pScene != pMainScene || m_aViewItems[uItem].type == eViewItemType::SKINNED_MODEL)
+                {
+                    continue;
+                }
+
+                if (bHasBounds)
+                {
+                    BoundingBox::CreateMerged(sceneBounds, sceneBounds, m_viewSet.GetWorldBounds(uItem));
+                }
+                else
+                {
+                    sceneBounds = m_viewSet.GetWorldBounds(uItem);
+                    bHasBounds = TRUE;
+                }
+            }
+
+            // The light looks along the third column of its view matrix
+            const XMMATRIX& lightView = pMainScene->GetPointLight(0)->GetViewMatrix();
+            XMVECTOR lightDirection = XMVectorSetW(XMMatrixTranspose(lightView).r[2], 0.0f);
+            m_shadowCascades.Update(m_camera.GetView(), m_projection, lightDirection, sceneBounds);
+            for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+            {
+                m_viewSet.SetViewTransform(SHADOW_VIEW + i, m_shadowCascades.GetViewMatrix(), m_shadowCascades.GetProjectionMatrix(i));
+            }
+        }
+
+        m_viewSet.Cull();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateAnimationLods
+
+      Summary:  Picks the animation level of detail of every skinned
+                model of the main scene from the camera and the models
+                after both were updated, for the next update of the
+                scene. Skinned models are drawn unculled, so a
+                model outside the frustum only advances its time and
+                keeps its last pose, which the scaled bounds of the
+                policy keep out of sight
+
+      Modifies: [m_scenes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateAnimationLods()
+    {
+        PROFILE_SCOPE("Renderer", "UpdateAnimationLods");
+
+        for (auto it_model = m_scenes[m_pszMainSceneName]->GetModels().begin(); it_model != m_scenes[m_pszMainSceneName]->GetModels().end(); it_model++)
+        {
+            Model& model = *it_model->second;
+            if (model.IsSkinned())
+            {
+                model.SetAnimationLod(m_animationLodPolicy.Select(model.GetLocalBounds(), model.GetWorldMatrix(), m_camera.GetView(), m_projection));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateCameraConstants
+
+      Summary:  Uploads the view, eye and projection of a view into the
+                camera constant buffers read by the scene shaders
+
+      Args:     UINT uView
+                  Index of the view in the view set
+
+      Modifies: [m_commandContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateCameraConstants(_In_ UINT uView)
+    {
+        // The eye of an added view is the translation of its inverse view matrix
+        XMFLOAT4 cameraPosition = XMFLOAT4();
+        XMStoreFloat4(&cameraPosition, uView == MAIN_VIEW ? m_camera.GetEye() : XMMatrixInverse(nullptr, m_viewSet.GetViewMatrix(uView)).r[3]);
+        CBChangeOnCameraMovement cbChangeOnCamera = {
+               .View = XMMatrixTranspose(m_viewSet.GetViewMatrix(uView)),
+               .CameraPosition = cameraPosition
+        };
+        m_commandContext.UpdateSubresource(
+            m_camera.GetConstantBuffer().Get(),
+            0,
+            nullptr,
+            &cbChangeOnCamera,
+            0,
+            0
+        );
+
+        CBChangeOnResize cbChangeOnResize = {
+            .Projection = XMMatrixTranspose(m_viewSet.GetProjectionMatrix(uView))
+        };
+        m_commandContext.UpdateSubresource(m_cbChangeOnResize.Get(), 0, nullptr, &cbChangeOnResize, 0, 0);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateLights
+
+      Summary:  Uploads the lights of a scene as seen from a view. The
+                first light casts the shadow and goes into the light
+                constant buffer with the cascades of the shadow map,
+                which every pixel reads. The other
+                lights are assigned to the clusters of the view and
+                uploaded with the cluster lists into the structured
+                buffers at slots 4 to 6, so a pixel only loops over the
+                lights of its cluster
+
+      Args:     Scene& scene
+                  Scene whose lights are uploaded
+                UINT uView
+                  Index of the view in the view set
+
+      Modifies: [m_lightClusterer, m_aLightSpheres, m_aClusteredLights,
+                  m_lightBuffer, m_lightClusterBuffer, m_lightIndexBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::updateLights(_In_ Scene& scene, _In_ UINT uView)
+    {
+        PROFILE_SCOPE("Renderer", "UpdateLights");
+
+        CBLights cbLights = {
+            .ShadowLight = {},
+            .LightView = XMMatrixTranspose(m_shadowCascades.GetViewMatrix()),
+            .CascadeProjections = {},
+            .CascadeBiases = XMFLOAT4(),
+            .NumClusters = XMUINT4(m_lightClusterer.GetDesc().uNumClustersX, m_lightClusterer.GetDesc().uNumClustersY, m_lightClusterer.GetDesc().uNumClustersZ, 0u),
+            .ClusterSlices = XMFLOAT4()
+        };
+        FLOAT aCascadeBiases[NUM_SHADOW_CASCADES] = {};
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            cbLights.CascadeProjections[i] = XMMatrixTranspose(m_shadowCascades.GetProjectionMatrix(i));
+            aCascadeBiases[i] = m_shadowCascades.GetDepthBias(i);
+        }
+        cbLights.CascadeBiases = XMFLOAT4(aCascadeBiases);
+        m_aLightSpheres.clear();
+        m_aClusteredLights.clear();
+        for (UINT i = 0u; i < scene.GetNumPointLights(); ++i)
+        {
+            const PointLight& light = *scene.GetPointLight(i);
+            FLOAT attenuationDistance = light.GetAttenuationDistance();
+            FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
+            StrPointLight lightData = {
+                .Position = light.GetPosition(),
+                .Color = light.GetColor(),
+                .AttenuationDistance = XMFLOAT4(
+                attenuationDistance,
+                attenuationDistance,
+                attenuationDistanceSquared,
+                attenuationDistanceSquared)
+            };
+
+            if (i == 0u)
+            {
+                cbLights.ShadowLight = lightData;
+                continue;
+            }
+
+            m_aLightSpheres.push_back(XMFLOAT4(lightData.Position.x, lightData.Position.y, lightData.Position.z, attenuationDistance));
+            m_aClusteredLights.push_back(lightData);
+        }
+
+        m_lightClusterer.Build(m_viewSet.GetViewMatrix(uView), m_viewSet.GetProjectionMatrix(uView), m_aLightSpheres);
+        cbLights.ClusterSlices = XMFLOAT4(m_lightClusterer.GetSliceScale(), m_lightClusterer.GetSliceBias(), 0.0f, 0.0f);
+        m_commandContext.UpdateSubresource(m_cbLights.Get(), 0, nullptr, &cbLights, 0, 0);
+
+        HRESULT hr = updateStructuredBuffer(m_lightBuffer, sizeof(StrPointLight), static_cast<UINT>(m_aClusteredLights.size()), m_aClusteredLights.data());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = updateStructuredBuffer(m_lightClusterBuffer, sizeof(XMUINT2), m_lightClusterer.GetNumClusters(), m_lightClusterer.GetClusters().data());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = updateStructuredBuffer(m_lightIndexBuffer, sizeof(UINT), static_cast<UINT>(m_lightClusterer.GetLightIndices().size()), m_lightClusterer.GetLightIndices().data());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ID3D11ShaderResourceView* apLightViews[] = { m_lightBuffer.view.Get(), m_lightClusterBuffer.view.Get(), m_lightIndexBuffer.view.Get() };
+        m_commandContext.PSSetShaderResources(4u, ARRAYSIZE(apLightViews), apLightViews);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateStructuredBuffer
+
+      Summary:  Uploads elements into a dynamic structured buffer read
+                by the pixel shaders. The buffer and its view are
+                recreated with at least twice the capacity when the
+                elements do not fit, and hold at least one element since
+                a view of an empty buffer cannot be created
+
+      Args:     StructuredBuffer& buffer
+                  Buffer to upload into
+                UINT uStride
+                  Size of an element in bytes
+                UINT uNumElements
+                  Number of elements
+                const void* pData
+                  Elements to upload
+
+      Modifies: [buffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::updateStructuredBuffer(_Inout_ StructuredBuffer& buffer, _In_ UINT uStride, _In_ UINT uNumElements, _In_reads_bytes_(uStride * uNumElements) const void* pData)
+    {
+        if (!buffer.buffer || uNumElements > buffer.uCapacity)
+        {
+            UINT uCapacity = buffer.uCapacity * 2u > uNumElements ? buffer.uCapacity * 2u : uNumElements;
+            uCapacity = uCapacity > 0u ? uCapacity : 1u;
+            D3D11_BUFFER_DESC bd = {
+                .ByteWidth = uStride * uCapacity,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+                .MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+                .StructureByteStride = uStride
+            };
+
+            buffer.uCapacity = 0u;
+            buffer.view.Reset();
+            HRESULT hr = m_d3dDevice->CreateBuffer(&bd, nullptr, buffer.buffer.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {
+                .Format = DXGI_FORMAT_UNKNOWN,
+                .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+                .Buffer = { .FirstElement = 0u, .NumElements = uCapacity }
+            };
+            hr = m_d3dDevice->CreateShaderResourceView(buffer.buffer.Get(), &srvDesc, buffer.view.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            buffer.uCapacity = uCapacity;
+        }
+
+        if (uNumElements == 0u)
+        {
+            return S_OK;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+        HRESULT hr = m_commandContext.Map(buffer.buffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy(mappedSubresource.pData, pData, static_cast<size_t>(uStride) * uNumElements);
+        m_commandContext.Unmap(buffer.buffer.Get(), 0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::prepareInstances
+
+      Summary:  Batches the renderables, static batches and models
+                without skinning of a scene that are visible in a view
+                into instance groups sorted front to back, and uploads
+                their instance data. The batch is kept until another
+                scene or view is batched, so the depth prepass and the
+                main pass share it
+
+      Args:     Scene& scene
+                  Scene to batch
+                UINT uView
+                  Index of the view in the view set
+
+      Modifies: [m_instanceBatcher, m_pInstanceScene, m_uInstanceView].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::prepareInstances(_In_ Scene& scene, _In_ UINT uView)
+    {
+        PROFILE_SCOPE("Renderer", "PrepareInstances");
+
+        if (m_pInstanceScene == &scene && m_uInstanceView == uView)
+        {
+            return S_OK;
+        }
+        m_pInstanceScene = nullptr;
+
+        m_instanceBatcher.Reset();
+        for (UINT uItem : m_viewSet.GetVisibleItems(uView))
+        {
+            const ViewItem& item = m_aViewItems[uItem];
+            if (item.pScene != &scene)
+            {
+                continue;
+            }
+
+            if (item.type == eViewItemType::RENDERABLE)
+            {
+                m_instanceBatcher.AddRenderable(item.pszName, *item.pRenderable);
+            }
+            else if (item.type == eViewItemType::MODEL)
+            {
+                m_instanceBatcher.AddModel(item.pszName, *static_cast<Model*>(item.pRenderable));
+            }
+        }
+        m_instanceBatcher.Build();
+        m_instanceBatcher.SortFrontToBack(m_viewSet.GetViewMatrix(uView));
+
+        HRESULT hr = updateInstanceBuffer();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_pInstanceScene = &scene;
+        m_uInstanceView = uView;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateInstanceBuffer
+
+      Summary:  Uploads the instance data of the instance batcher,
+                growing the dynamic instance buffer when it is too small
+
+      Modifies: [m_instanceBuffer, m_uInstanceBufferCapacity].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::updateInstanceBuffer()
+    {
+        UINT uNumInstances = m_instanceBatcher.GetNumInstances();
+        if (uNumInstances == 0u)
+        {
+            return S_OK;
+        }
+
+        if (uNumInstances > m_uInstanceBufferCapacity)
+        {
+            UINT uCapacity = m_uInstanceBufferCapacity * 2u > uNumInstances ? m_uInstanceBufferCapacity * 2u : uNumInstances;
+            D3D11_BUFFER_DESC instanceBd = {
+                .ByteWidth = static_cast<UINT>(sizeof(InstanceData)) * uCapacity,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+                .MiscFlags = 0,
+                .StructureByteStride = 0
+            };
+
+            m_uInstanceBufferCapacity = 0u;
+            HRESULT hr = m_d3dDevice->CreateBuffer(&instanceBd, nullptr, m_instanceBuffer.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            m_uInstanceBufferCapacity = uCapacity;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+        HRESULT hr = m_commandContext.Map(m_instanceBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy(mappedSubresource.pData, m_instanceBatcher.GetInstances().data(), sizeof(InstanceData) * uNumInstances);
+        m_commandContext.Unmap(m_instanceBuffer.Get(), 0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateBakedInstanceBuffer
+
+      Summary:  Uploads the world matrices and frame offsets of the
+                models playing baked frames into the dynamic baked
+                instance buffer, recreated with at least twice the
+                capacity when they do not fit
+
+      Modifies: [m_bakedInstanceBuffer, m_uBakedInstanceBufferCapacity].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::updateBakedInstanceBuffer()
+    {
+        UINT uNumInstances = static_cast<UINT>(m_aBakedInstances.size());
+        if (uNumInstances == 0u)
+        {
+            return S_OK;
+        }
+
+        if (uNumInstances > m_uBakedInstanceBufferCapacity)
+        {
+            UINT uCapacity = m_uBakedInstanceBufferCapacity * 2u > uNumInstances ? m_uBakedInstanceBufferCapacity * 2u : uNumInstances;
+            D3D11_BUFFER_DESC instanceBd = {
+                .ByteWidth = static_cast<UINT>(sizeof(BakedInstanceData)) * uCapacity,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+                .MiscFlags = 0,
+                .StructureByteStride = 0
+            };
+
+            m_uBakedInstanceBufferCapacity = 0u;
+            HRESULT hr = m_d3dDevice->CreateBuffer(&instanceBd, nullptr, m_bakedInstanceBuffer.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            m_uBakedInstanceBufferCapacity = uCapacity;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+        HRESULT hr = m_commandContext.Map(m_bakedInstanceBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy(mappedSubresource.pData, m_aBakedInstances.data(), sizeof(BakedInstanceData) * uNumInstances);
+        m_commandContext.Unmap(m_bakedInstanceBuffer.Get(), 0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderRenderableToShadowMap
+
+      Summary:  Render a renderable into the shadow map from a cascade
+                of the first light of the main scene. Only the position
+                stream of the renderable is read
+
+      Args:     Renderable& renderable
+                  Renderable, static batch or model to render
+                UINT uView
+                  Index of the shadow view of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderRenderableToShadowMap(_In_ Renderable& renderable, _In_ UINT uView)
+    {
+        //set the position buffer, index buffer, input layout
+        PositionStream& positionStream = renderable.GetPositionStream();
+        UINT uStride[1] = { positionStream.GetStride() };
+        UINT uOffset[1] = { 0 };
+
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            1u,
+            positionStream.GetVertexBuffer().GetAddressOf(),
+            uStride,
+            uOffset
+        );
+        m_commandContext.IASetIndexBuffer(renderable.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+
+        m_commandContext.IASetInputLayout(positionStream.IsQuantized() ?
+            m_shadowVertexShader->GetQuantizedVertexLayout().Get() : m_shadowVertexShader->GetVertexLayout().Get());
+
+        //update constant buffer
+        CBShadowMatrix cb = {
+            .World = XMMatrixTranspose(renderable.GetWorldMatrix()),
+            .View = XMMatrixTranspose(m_viewSet.GetViewMatrix(uView)),
+            .Projection = XMMatrixTranspose(m_viewSet.GetProjectionMatrix(uView)),
+            .PositionScale = positionStream.GetScale(),
+            .PositionOffset = positionStream.GetOffset(),
+            .IsVoxel = false
+        };
+        m_commandContext.UpdateSubresource(m_cbShadowMatrix.Get(), 0, nullptr, &cb, 0, 0);
+        //set shaders and constant buffers, shader resources, and samplers
+        m_commandContext.VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+        m_commandContext.PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+        for (UINT i = 0; i < renderable.GetNumMeshes(); i++)
+        {
+            m_commandContext.DrawIndexed(
+                renderable.GetMesh(i).uNumIndices,
+                renderable.GetMesh(i).uBaseIndex,
+                renderable.GetMesh(i).uBaseVertex
+            );
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderVoxelToShadowMap
+
+      Summary:  Render every instance of a voxel into the shadow map from
+                a cascade of the first light of the main scene. Only the
+                position stream and the instance buffer of the voxel are
+                read
+
+      Args:     Voxel& voxel
+                  Voxel to render
+                UINT uView
+                  Index of the shadow view of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderVoxelToShadowMap(_In_ Voxel& voxel, _In_ UINT uView)
+    {
+        PositionStream& positionStream = voxel.GetPositionStream();
+        UINT strides[2] = { positionStream.GetStride(),  sizeof(InstanceData) };
+        UINT offsets[2] = { 0, 0 };
+        ComPtr<ID3D11Buffer> vertexInstanceBuffers[2] =
+        { positionStream.GetVertexBuffer(), voxel.GetInstanceBuffer() };
+        m_commandContext.IASetVertexBuffers(
+            0u,
+            1u,
+            vertexInstanceBuffers[0].GetAddressOf(),
+            &strides[0],
+            &offsets[0]
+        );
+        m_commandContext.IASetVertexBuffers(2u, 1u, vertexInstanceBuffers[1].GetAddressOf(), &strides[1], &offsets[1]);
+        m_commandContext.IASetIndexBuffer(voxel.GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+        m_commandContext.IASetInputLayout(positionStream.IsQuantized() ?
+            m_shadowVertexShader->GetQuantizedVertexLayout().Get() : m_shadowVertexShader->GetVertexLayout().Get());
+
+        //update constant buffer
+        CBShadowMatrix cb = {
+            .World = XMMatrixTranspose(voxel.GetWorldMatrix()),
+            .View = XMMatrixTranspose(m_viewSet.GetViewMatrix(uView)),
+            .Projection = XMMatrixTranspose(m_viewSet.GetProjectionMatrix(uView)),
+            .PositionScale = positionStream.GetScale(),
+            .PositionOffset = positionStream.GetOffset(),
+            .IsVoxel = true,
+        };
+        m_commandContext.UpdateSubresource(m_cbShadowMatrix.Get(), 0, nullptr, &cb, 0, 0);
+        //set shaders and constant buffers, shader resources, and samplers
+
+        m_commandContext.VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+        m_commandContext.VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+        m_commandContext.PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+
+        for (UINT i = 0u; i < voxel.GetNumMeshes(); ++i)
+        {
+            // Render the triangles
+            m_commandContext.DrawIndexedInstanced(
+                voxel.GetMesh(i).uNumIndices,
+                voxel.GetNumInstances(),
+                voxel.GetMesh(i).uBaseIndex,
+                voxel.GetMesh(i).uBaseVertex,
+                0u
+            );
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::nameCaptureObjects
+
+      Summary:  Names the buffers, shaders and textures of the renderer
+                and of every scene in the frame capture, so the capture
+                refers to them by the names of the scene
+
+      Modifies: [m_commandContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::nameCaptureObjects()
+    {
+        FrameCapture& frameCapture = m_commandContext.GetFrameCapture();
+
+        frameCapture.SetObjectName(m_renderTargetView.Get(), L"BackBuffer");
+        frameCapture.SetObjectName(m_depthStencilView.Get(), L"DepthStencil");
+        frameCapture.SetObjectName(m_camera.GetConstantBuffer().Get(), L"CBChangeOnCameraMovement");
+        frameCapture.SetObjectName(m_cbChangeOnResize.Get(), L"CBChangeOnResize");
+        frameCapture.SetObjectName(m_cbLights.Get(), L"CBLights");
+        frameCapture.SetObjectName(m_cbShadowMatrix.Get(), L"CBShadowMatrix");
+        frameCapture.SetObjectName(m_instanceBuffer.Get(), L"InstanceBuffer");
+        frameCapture.SetObjectName(m_lightBuffer.buffer.Get(), L"LightBuffer");
+        frameCapture.SetObjectName(m_lightBuffer.view.Get(), L"LightBuffer");
+        frameCapture.SetObjectName(m_lightClusterBuffer.buffer.Get(), L"LightClusterBuffer");
+        frameCapture.SetObjectName(m_lightClusterBuffer.view.Get(), L"LightClusterBuffer");
+        frameCapture.SetObjectName(m_lightIndexBuffer.buffer.Get(), L"LightIndexBuffer");
+        frameCapture.SetObjectName(m_lightIndexBuffer.view.Get(), L"LightIndexBuffer");
+        frameCapture.SetObjectName(m_depthLessEqualState.Get(), L"DepthLessEqual");
+
+        if (m_shadowVertexShader)
+        {
+            frameCapture.SetObjectName(m_shadowVertexShader->GetVertexShader().Get(), L"ShadowVertexShader");
+            frameCapture.SetObjectName(m_shadowVertexShader->GetVertexLayout().Get(), L"ShadowVertexShader.VertexLayout");
+            frameCapture.SetObjectName(m_shadowVertexShader->GetQuantizedVertexLayout().Get(), L"ShadowVertexShader.QuantizedVertexLayout");
+        }
+        if (m_shadowPixelShader)
+        {
+            frameCapture.SetObjectName(m_shadowPixelShader->GetPixelShader().Get(), L"ShadowPixelShader");
+        }
+
+        std::shared_ptr<RenderTexture> shadowMapTexture = getRenderGraphTexture(m_uShadowMapResource);
+        if (shadowMapTexture)
+        {
+            frameCapture.SetObjectName(shadowMapTexture->GetTexture2D().Get(), L"ShadowMap");
+            frameCapture.SetObjectName(shadowMapTexture->GetRenderTargetView().Get(), L"ShadowMap");
+            frameCapture.SetObjectName(shadowMapTexture->GetShaderResourceView().Get(), L"ShadowMap");
+        }
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            if (m_aStaticShadowMaps[i])
+            {
+                std::wstring szName = L"StaticShadowMap" + std::to_wstring(i);
+                frameCapture.SetObjectName(m_aStaticShadowMaps[i]->GetTexture2D().Get(), szName.c_str());
+                frameCapture.SetObjectName(m_aStaticShadowMaps[i]->GetRenderTargetView().Get(), szName.c_str());
+            }
+        }
+        frameCapture.SetObjectName(m_shadowDepthStencil.Get(), L"ShadowDepthStencil");
+        frameCapture.SetObjectName(m_shadowDepthStencilView.Get(), L"ShadowDepthStencil");
+        frameCapture.SetObjectName(m_staticShadowDepthStencil.Get(), L"StaticShadowDepthStencil");
+        frameCapture.SetObjectName(m_staticShadowDepthStencilView.Get(), L"StaticShadowDepthStencil");
+        frameCapture.SetObjectName(m_minBlendState.Get(), L"MinBlend");
+
+        frameCapture.SetObjectName(m_cbUpscale.Get(), L"CBUpscale");
+        if (m_upscaleVertexShader && m_upscalePixelShader)
+        {
+            frameCapture.SetObjectName(m_upscaleVertexShader->GetVertexShader().Get(), L"UpscaleVertexShader");
+            frameCapture.SetObjectName(m_upscalePixelShader->GetPixelShader().Get(), L"UpscalePixelShader");
+        }
+
+        std::shared_ptr<RenderTexture> sceneColorTexture = getRenderGraphTexture(m_uSceneColorResource);
+        if (sceneColorTexture)
+        {
+            frameCapture.SetObjectName(sceneColorTexture->GetRenderTargetView().Get(), L"SceneColor");
+            frameCapture.SetObjectName(sceneColorTexture->GetShaderResourceView().Get(), L"SceneColor");
+        }
+
+        for (auto it_view = m_offscreenViews.begin(); it_view != m_offscreenViews.end(); it_view++)
+        {
+            std::wstring name = L"View." + it_view->first;
+            frameCapture.SetObjectName(it_view->second.texture->GetRenderTargetView().Get(), name.c_str());
+            frameCapture.SetObjectName(it_view->second.texture->GetShaderResourceView().Get(), name.c_str());
+            frameCapture.SetObjectName(it_view->second.depthStencilView.Get(), (name + L".DepthStencil").c_str());
+        }
+
+        for (auto it_Scene = m_scenes.begin(); it_Scene != m_scenes.end(); it_Scene++)
+        {
+            for (auto it_shader = it_Scene->second->GetVertexShaders().begin(); it_shader != it_Scene->second->GetVertexShaders().end(); it_shader++)
+            {
+                frameCapture.SetObjectName(it_shader->second->GetVertexShader().Get(), it_shader->first.c_str());
+                frameCapture.SetObjectName(it_shader->second->GetVertexLayout().Get(), (it_shader->first + L".VertexLayout").c_str());
+            }
+
+            for (auto it_shader = it_Scene->second->GetPixelShaders().begin(); it_shader != it_Scene->second->GetPixelShaders().end(); it_shader++)
+            {
+                frameCapture.SetObjectName(it_shader->second->GetPixelShader().Get(), it_shader->first.c_str());
+            }
+
+            for (auto it_renderable = it_Scene->second->GetRenderables().begin(); it_renderable != it_Scene->second->GetRenderables().end(); it_renderable++)
+            {
+                nameRenderableForCapture(it_renderable->first, *it_renderable->second);
+            }
+
+            for (auto it_model = it_Scene->second->GetModels().begin(); it_model != it_Scene->second->GetModels().end(); it_model++)
+            {
+                nameRenderableForCapture(it_model->first, *it_model->second);
+                frameCapture.SetObjectName(it_model->second->GetAnimationBuffer().Get(), (it_model->first + L".AnimationBuffer").c_str());
+                frameCapture.SetObjectName(it_model->second->GetBonePaletteBuffer().Get(), (it_model->first + L".BonePalette").c_str());
+            }
+
+            for (size_t i = 0u; i < it_Scene->second->GetStaticBatches().size(); ++i)
+            {
+                nameRenderableForCapture(L"StaticBatch" + std::to_wstring(i), *it_Scene->second->GetStaticBatches()[i]);
+            }
+
+            for (size_t i = 0u; i < it_Scene->second->GetVoxels().size(); ++i)
+            {
+                std::wstring name = L"Voxel" + std::to_wstring(i);
+                nameRenderableForCapture(name, *it_Scene->second->GetVoxels()[i]);
+                frameCapture.SetObjectName(it_Scene->second->GetVoxels()[i]->GetInstanceBuffer().Get(), (name + L".InstanceBuffer").c_str());
+            }
+
+            if (it_Scene->second->GetSkyBox())
+            {
+                nameRenderableForCapture(L"Skybox", *it_Scene->second->GetSkyBox());
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::nameRenderableForCapture
+
+      Summary:  Names the buffers, shaders and material textures of a
+                renderable in the frame capture
+
+      Args:     const std::wstring& name
+                  Name of the renderable in its scene
+                Renderable& renderable
+                  Renderable to name the objects of
+
+      Modifies: [m_commandContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::nameRenderableForCapture(_In_ const std::wstring& name, _In_ Renderable& renderable)
+    {
+        FrameCapture& frameCapture = m_commandContext.GetFrameCapture();
+
+        frameCapture.SetObjectName(renderable.GetVertexBuffer().Get(), (name + L".VertexBuffer").c_str());
+        frameCapture.SetObjectName(renderable.GetNormalBuffer().Get(), (name + L".NormalBuffer").c_str());
+        frameCapture.SetObjectName(renderable.GetIndexBuffer().Get(), (name + L".IndexBuffer").c_str());
+        frameCapture.SetObjectName(renderable.GetConstantBuffer().Get(), (name + L".CBChangesEveryFrame").c_str());
+        frameCapture.SetObjectName(renderable.GetPositionStream().GetVertexBuffer().Get(), (name + L".PositionBuffer").c_str());
+        frameCapture.SetObjectName(renderable.GetVertexShader().Get(), (name + L".VertexShader").c_str());
+        frameCapture.SetObjectName(renderable.GetPixelShader().Get(), (name + L".PixelShader").c_str());
+        frameCapture.SetObjectName(renderable.GetVertexLayout().Get(), (name + L".VertexLayout").c_str());
+
+        for (UINT i = 0u; i < renderable.GetNumMaterials(); ++i)
+        {
+            const std::shared_ptr<Material>& material = renderable.GetMaterial(i);
+            if (!material)
+            {
+                continue;
+            }
+
+            if (material->pDiffuse)
+            {
+                frameCapture.SetObjectName(material->pDiffuse->GetTextureResourceView().Get(), (material->GetName() + L".Diffuse").c_str());
+            }
+            if (material->pNormal)
+            {
+                frameCapture.SetObjectName(material->pNormal->GetTextureResourceView().Get(), (material->GetName() + L".Normal").c_str());
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetDriverType
+
+      Summary:  Returns the Direct3D driver type
+
+      Returns:  D3D_DRIVER_TYPE
+                  The Direct3D driver type used
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D_DRIVER_TYPE Renderer::GetDriverType() const
+    {
+        return m_driverType;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetStatistics
+
+      Summary:  Returns the draws, triangles, state changes and uploads
+                of the recently rendered frames, broken down by the
+                passes of the render graph
+
+      Returns:  const RenderStatistics&
+                  Statistics of the recent frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderStatistics& Renderer::GetStatistics() const
+    {
+        return m_commandContext.GetStatistics();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderScale
+
+      Summary:  Returns the scale of the width and height the main pass
+                is rendered at
+
+      Returns:  FLOAT
+                  Render scale, 1 without the dynamic resolution
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT Renderer::GetRenderScale() const
+    {
+        return m_uWidth > 0u ? static_cast<FLOAT>(m_uRenderWidth) / static_cast<FLOAT>(m_uWidth) : 1.0f;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::buildRenderGraph
+
+      Summary:  Declares the shadow, added view, depth prepass, main,
+                skybox and upscale passes, compiles the render graph and
+                creates the textures it needs.
+                Textures of a previous compilation are reused when their
+                description did not change. The shadow map holds the
+                cascades side by side
+
+      Modifies: [m_renderGraph, m_aRenderGraphTextures,
+                  m_uShadowMapResource, m_uSceneColorResource,
+                  m_offscreenViews, m_aStaticShadowMaps,
+                  m_shadowDepthStencil, m_shadowDepthStencilView,
+                  m_staticShadowDepthStencil,
+                  m_staticShadowDepthStencilView,
+                  m_aShadowCasterCaches, m_bRenderGraphDirty].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::buildRenderGraph()
+    {
+        PROFILE_SCOPE("Renderer", "BuildRenderGraph");
+
+        HRESULT hr = S_OK;
+
+        m_renderGraph.Reset();
+
+        UINT uBackBuffer = m_renderGraph.ImportTexture(L"BackBuffer", TRUE);
+        UINT uDepthStencil = m_renderGraph.ImportTexture(L"DepthStencil", FALSE);
+        const RenderGraphTextureDesc shadowMapDesc =
+        {
+            .uWidth = m_shadowCascades.GetDesc().uResolution * NUM_SHADOW_CASCADES,
+            .uHeight = m_shadowCascades.GetDesc().uResolution,
+            .format = DXGI_FORMAT_R32G32B32A32_FLOAT
+        };
+        m_uShadowMapResource = m_renderGraph.CreateTexture(L"ShadowMap", shadowMapDesc);
+
+        // The scene color has the full size and the main pass renders into its top left rectangle at the render
+        // scale, so changing the scale never recreates the texture
+        m_uSceneColorResource = RenderGraph::INVALID_HANDLE;
+        UINT uSceneColor = uBackBuffer;
+        if (m_bDynamicResolution && m_upscaleVertexShader && m_upscalePixelShader)
+        {
+            m_uSceneColorResource = m_renderGraph.CreateTexture(
+                L"SceneColor",
+                {
+                    .uWidth = m_uWidth,
+                    .uHeight = m_uHeight,
+                    .format = DXGI_FORMAT_R8G8B8A8_UNORM
+                }
+            );
+            uSceneColor = m_uSceneColorResource;
+        }
+
+        // The shadow pass is culled unless the main pass samples the shadow map
+        UINT uShadowPass = m_renderGraph.AddPass(L"Shadow", [this]() { RenderSceneToTexture(); });
+        hr = m_renderGraph.WriteTexture(uShadowPass, m_uShadowMapResource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The added views render into their own textures, which are outputs of the graph so their passes are kept
+        for (auto it_view = m_offscreenViews.begin(); it_view != m_offscreenViews.end(); it_view++)
+        {
+            hr = initializeOffscreenView(it_view->second);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            std::wstring szViewName = it_view->first;
+            UINT uViewTexture = m_renderGraph.ImportTexture((L"View." + szViewName).c_str(), TRUE);
+            UINT uViewPass = m_renderGraph.AddPass((L"View." + szViewName).c_str(), [this, szViewName]() { renderViewPass(szViewName); });
+            hr = m_renderGraph.WriteTexture(uViewPass, uViewTexture);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            if (m_shadowVertexShader && m_shadowPixelShader)
+            {
+                hr = m_renderGraph.ReadTexture(uViewPass, m_uShadowMapResource, 2u);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+        }
+
+        if (m_bDepthPrepass)
+        {
+            UINT uDepthPrepass = m_renderGraph.AddPass(L"DepthPrepass", [this]() { renderDepthPrepass(); });
+            hr = m_renderGraph.WriteTexture(uDepthPrepass, uDepthStencil);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        UINT uMainPass = m_renderGraph.AddPass(L"Main", [this]() { renderMainPass(); });
+        hr = m_renderGraph.WriteTexture(uMainPass, uSceneColor);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The main pass keeps the depth of the depth prepass, so the prepass is never culled
+        if (m_bDepthPrepass)
+        {
+            hr = m_renderGraph.ReadDepthStencil(uMainPass, uDepthStencil);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = m_renderGraph.WriteTexture(uMainPass, uDepthStencil);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (m_shadowVertexShader && m_shadowPixelShader)
+        {
+            hr = m_renderGraph.ReadTexture(uMainPass, m_uShadowMapResource, 2u);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        UINT uSkyboxPass = m_renderGraph.AddPass(L"Skybox", [this]() { renderSkyboxPass(); });
+        hr = m_renderGraph.WriteTexture(uSkyboxPass, uSceneColor);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_renderGraph.WriteTexture(uSkyboxPass, uDepthStencil);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (m_uSceneColorResource != RenderGraph::INVALID_HANDLE)
+        {
+            UINT uUpscalePass = m_renderGraph.AddPass(L"Upscale", [this]() { renderUpscalePass(); });
+            hr = m_renderGraph.ReadTexture(uUpscalePass, m_uSceneColorResource, 0u);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = m_renderGraph.WriteTexture(uUpscalePass, uBackBuffer);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = m_renderGraph.Compile();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aRenderGraphTextures.resize(m_renderGraph.GetNumPhysicalTextures());
+        for (UINT i = 0u; i < m_renderGraph.GetNumPhysicalTextures(); ++i)
+        {
+            const RenderGraphTextureDesc& desc = m_renderGraph.GetPhysicalTextureDesc(i);
+            if (m_aRenderGraphTextures[i] &&
+                m_aRenderGraphTextures[i]->GetWidth() == desc.uWidth &&
+                m_aRenderGraphTextures[i]->GetHeight() == desc.uHeight &&
+                m_aRenderGraphTextures[i]->GetFormat() == desc.format)
+            {
+                continue;
+            }
+
+            m_aRenderGraphTextures[i] = std::make_shared<RenderTexture>(desc.uWidth, desc.uHeight, desc.format);
+            hr = m_aRenderGraphTextures[i]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = initializeShadowMaps(shadowMapDesc);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_bRenderGraphDirty = FALSE;
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::initializeShadowMaps
+
+      Summary:  Creates the static shadow map of every cascade and the
+                depth buffers of the shadow pass once the shadow shaders
+                are set. The static shadow maps live outside the render
+                graph since they are kept across frames. Depth buffers
+                must match the size of their render target, so the
+                static shadow maps and the shadow map get one each
+
+      Args:     const RenderGraphTextureDesc& shadowMapDesc
+                  Description of the shadow map of the render graph
+
+      Modifies: [m_aStaticShadowMaps, m_shadowDepthStencil,
+                  m_shadowDepthStencilView, m_staticShadowDepthStencil,
+                  m_staticShadowDepthStencilView, m_aShadowCasterCaches].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::initializeShadowMaps(_In_ const RenderGraphTextureDesc& shadowMapDesc)
+    {
+        const UINT uResolution = m_shadowCascades.GetDesc().uResolution;
+        if (!m_shadowVertexShader || !m_shadowPixelShader ||
+            (m_aStaticShadowMaps[0] &&
+                m_aStaticShadowMaps[0]->GetWidth() == uResolution &&
+                m_aStaticShadowMaps[0]->GetFormat() == shadowMapDesc.format))
+        {
+            return S_OK;
+        }
+
+        HRESULT hr = S_OK;
+        for (UINT i = 0u; i < NUM_SHADOW_CASCADES; ++i)
+        {
+            // The static shadow map of a cascade is copied into its region of the shadow map, so both have the same format
+            m_aStaticShadowMaps[i] = std::make_shared<RenderTexture>(uResolution, uResolution, shadowMapDesc.format);
+            hr = m_aStaticShadowMaps[i]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            m_aShadowCasterCaches[i].Invalidate();
+        }
+
+        auto createDepthStencil = [this](UINT uWidth, UINT uHeight, ComPtr<ID3D11Texture2D>& depthStencil, ComPtr<ID3D11DepthStencilView>& depthStencilView)
+        {
+            D3D11_TEXTURE2D_DESC descDepth =
+            {
+                .Width = uWidth,
+                .Height = uHeight,
+                .MipLevels = 1u,
+                .ArraySize = 1u,
+                .Format = DXGI_FORMAT_D24_UNORM_S8_UINT,
+                .SampleDesc = {.Count = 1u, .Quality = 0u },
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_DEPTH_STENCIL,
+                .CPUAccessFlags = 0u,
+                .MiscFlags = 0u
+            };
+            HRESULT hr = m_d3dDevice->CreateTexture2D(&descDepth, nullptr, depthStencil.ReleaseAndGetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            D3D11_DEPTH_STENCIL_VIEW_DESC descDSV =
+            {
+                .Format = descDepth.Format,
+                .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
+                .Texture2D = {.MipSlice = 0 }
+            };
+            return m_d3dDevice->CreateDepthStencilView(depthStencil.Get(), &descDSV, depthStencilView.ReleaseAndGetAddressOf());
+        };
+
+        hr = createDepthStencil(uResolution, uResolution, m_staticShadowDepthStencil, m_staticShadowDepthStencilView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return createDepthStencil(shadowMapDesc.uWidth, shadowMapDesc.uHeight, m_shadowDepthStencil, m_shadowDepthStencilView);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::initializeOffscreenView
+
+      Summary:  Creates the texture of an added view and a depth buffer
+                of the same size, once the device exists
+
+      Args:     OffscreenView& view
+                  View to initialize
+
+      Modifies: [m_offscreenViews].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::initializeOffscreenView(_Inout_ OffscreenView& view)
+    {
+        if (view.depthStencilView)
+        {
+            return S_OK;
+        }
+
+        HRESULT hr = view.texture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_TEXTURE2D_DESC descDepth =
+        {
+            .Width = view.texture->GetWidth(),
+            .Height = view.texture->GetHeight(),
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_D24_UNORM_S8_UINT,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_DEPTH_STENCIL,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        hr = m_d3dDevice->CreateTexture2D(&descDepth, nullptr, view.depthStencil.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_DEPTH_STENCIL_VIEW_DESC descDSV =
+        {
+            .Format = descDepth.Format,
+            .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
+            .Texture2D = {.MipSlice = 0 }
+        };
+        return m_d3dDevice->CreateDepthStencilView(view.depthStencil.Get(), &descDSV, view.depthStencilView.ReleaseAndGetAddressOf());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getRenderGraphTexture
+
+      Summary:  Returns the texture backing a transient texture of the
+                render graph
+
+      Args:     UINT uResource
+                  Handle of the render graph texture
+
+      Returns:  std::shared_ptr<RenderTexture>
+                  The texture, or nullptr if no compiled pass uses it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<RenderTexture> Renderer::getRenderGraphTexture(_In_ UINT uResource) const
+    {
+        UINT uPhysical = m_renderGraph.GetPhysicalTextureIndex(uResource);
+        if (uPhysical == RenderGraph::INVALID_HANDLE || uPhysical >= m_aRenderGraphTextures.size())
+        {
+            return nullptr;
+        }
+
+        return m_aRenderGraphTextures[uPhysical];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateRenderScale
+
+      Summary:  Feeds the time since the start of the previous frame to
+                the resolution governor and computes the size the main
+                pass renders at. The time includes the wait of Present,
+                so frames bound by the GPU lower the scale as well
+
+      Modifies: [m_resolutionGovernor, m_uRenderWidth, m_uRenderHeight,
+                  m_lastFrameCounter].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateRenderScale()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        FLOAT scale = 1.0f;
+        if (m_uSceneColorResource != RenderGraph::INVALID_HANDLE)
+        {
+            if (m_lastFrameCounter.QuadPart != 0)
+            {
+                m_resolutionGovernor.AddFrameTime(
+                    static_cast<FLOAT>(counter.QuadPart - m_lastFrameCounter.QuadPart) / static_cast<FLOAT>(m_counterFrequency.QuadPart));
+            }
+            scale = m_resolutionGovernor.GetScale();
+        }
+        m_lastFrameCounter = counter;
+
+        UINT uRenderWidth = static_cast<UINT>(static_cast<FLOAT>(m_uWidth) * scale + 0.5f);
+        UINT uRenderHeight = static_cast<UINT>(static_cast<FLOAT>(m_uHeight) * scale + 0.5f);
+        m_uRenderWidth = uRenderWidth > 0u ? uRenderWidth : 1u;
+        m_uRenderHeight = uRenderHeight > 0u ? uRenderHeight : 1u;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::setViewport
+
+      Summary:  Sets a viewport at the top left of the render target
+
+      Args:     UINT uWidth
+                  Width of the viewport
+                UINT uHeight
+                  Height of the viewport
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::setViewport(_In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        D3D11_VIEWPORT vp =
+        {
+            .TopLeftX = 0.0f,
+            .TopLeftY = 0.0f,
+            .Width = static_cast<FLOAT>(uWidth),
+            .Height = static_cast<FLOAT>(uHeight),
+            .MinDepth = 0.0f,
+            .MaxDepth = 1.0f,
+        };
+        m_commandContext.RSSetViewports(1u, &vp);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getSceneRenderTargetView
+
+      Summary:  Returns the render target of the main and skybox passes
+
+      Returns:  ID3D11RenderTargetView*
+                  Scene color with the dynamic resolution, otherwise
+                  the back buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11RenderTargetView* Renderer::getSceneRenderTargetView() const
+    {
+        std::shared_ptr<RenderTexture> sceneColorTexture = getRenderGraphTexture(m_uSceneColorResource);
+        if (sceneColorTexture)
+        {
+            return sceneColorTexture->GetRenderTargetView().Get();
+        }
+
+        return m_renderTargetView.Get();
     }
 }
\ No newline at end of file
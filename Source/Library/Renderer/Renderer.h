@@ -16,9 +16,18 @@
 #include "Camera/Camera.h"
 #include "Light/PointLight.h"
 #include "Model/Model.h"
+#include "Renderer/CommandContext.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/InstanceBatcher.h"
+#include "Renderer/LightClusterer.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderGraph.h"
+#include "Renderer/ResolutionGovernor.h"
+#include "Renderer/ShadowCascades.h"
+#include "Renderer/ShadowCasterCache.h"
+#include "Renderer/ViewSet.h"
 #include "Scene/Scene.h"
+#include "Thread/ThreadPool.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Window/MainWindow.h"
@@ -37,12 +46,36 @@ namespace library
                   Creates Direct3D device and swap chain
                 AddRenderable
                   Add a renderable object and initialize the object
+                GetMainSceneOrNull
+                  Returns the main scene
                 Update
                   Update the renderables each frame
                 Render
-                  Renders the frame
+                  Renders the frame by executing the render graph
+                RenderSceneToTexture
+                  Renders the shadow pass into the shadow map
+                SetDepthPrepass
+                  Enables or disables the depth prepass
+                SetUpscaleShaders
+                  Sets the shaders that upscale the scene color
+                SetDynamicResolution
+                  Enables or disables the dynamic resolution
+                GetRenderScale
+                  Returns the render scale of the main pass
+                AddView
+                  Adds a view rendered into its own texture
+                RemoveView
+                  Removes a view added with AddView
+                SetViewTransform
+                  Sets the view and projection of an added view
+                GetViewTextureOrNull
+                  Returns the texture an added view renders into
+                CaptureFrame
+                  Records the command stream of the next frame
                 GetDriverType
                   Returns the Direct3D driver type
+                GetStatistics
+                  Returns the statistics of the recent frames
                 Renderer
                   Constructor.
                 ~Renderer
@@ -62,8 +95,17 @@ namespace library
 
         HRESULT AddScene(_In_ PCWSTR pszSceneName, _In_ const std::shared_ptr<Scene>& scene);
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
+        std::shared_ptr<Scene> GetMainSceneOrNull();
         HRESULT SetMainScene(_In_ PCWSTR pszSceneName);
         void SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader);
+        void SetDepthPrepass(_In_ BOOL bDepthPrepass);
+        void SetUpscaleShaders(_In_ std::shared_ptr<VertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader);
+        void SetDynamicResolution(_In_ BOOL bDynamicResolution, _In_ FLOAT targetFrameTime);
+        HRESULT AddView(_In_ PCWSTR pszViewName, _In_ UINT uWidth, _In_ UINT uHeight);
+        HRESULT RemoveView(_In_ PCWSTR pszViewName);
+        HRESULT SetViewTransform(_In_ PCWSTR pszViewName, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+        std::shared_ptr<RenderTexture> GetViewTextureOrNull(_In_ PCWSTR pszViewName) const;
+        void CaptureFrame(_In_ PCWSTR pszFileName);
 
         void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
         void Update(_In_ FLOAT deltaTime);
@@ -71,6 +113,79 @@ namespace library
         void RenderSceneToTexture();
 
         D3D_DRIVER_TYPE GetDriverType() const;
+        const RenderStatistics& GetStatistics() const;
+        FLOAT GetRenderScale() const;
+
+    private:
+        static constexpr const UINT MAIN_VIEW = 0u;
+        static constexpr const UINT SHADOW_VIEW = 1u;
+        static_assert(NUM_SHADOW_CASCADES <= ShadowCascades::MAX_CASCADES, "The cascades do not fit the light constants");
+
+        enum class eViewItemType
+        {
+            RENDERABLE,
+            MODEL,
+            SKINNED_MODEL,
+            VOXEL
+        };
+
+        struct ViewItem
+        {
+            Scene* pScene;
+            PCWSTR pszName;
+            Renderable* pRenderable;
+            eViewItemType type;
+            BOOL bStaticCaster;
+        };
+
+        struct OffscreenView
+        {
+            std::shared_ptr<RenderTexture> texture;
+            ComPtr<ID3D11Texture2D> depthStencil;
+            ComPtr<ID3D11DepthStencilView> depthStencilView;
+        };
+
+        struct StructuredBuffer
+        {
+            ComPtr<ID3D11Buffer> buffer;
+            ComPtr<ID3D11ShaderResourceView> view;
+            UINT uCapacity;
+        };
+
+    private:
+        HRESULT buildRenderGraph();
+        HRESULT initializeOffscreenView(_Inout_ OffscreenView& view);
+        std::shared_ptr<RenderTexture> getRenderGraphTexture(_In_ UINT uResource) const;
+        void updateViews();
+        void updateAnimationLods();
+        void updateCameraConstants(_In_ UINT uView);
+        HRESULT updateLights(_In_ Scene& scene, _In_ UINT uView);
+        HRESULT updateStructuredBuffer(_Inout_ StructuredBuffer& buffer, _In_ UINT uStride, _In_ UINT uNumElements, _In_reads_bytes_(uStride * uNumElements) const void* pData);
+        HRESULT prepareInstances(_In_ Scene& scene, _In_ UINT uView);
+        HRESULT updateInstanceBuffer();
+        HRESULT updateBakedInstanceBuffer();
+        void renderDepthPrepass();
+        void renderMainPass();
+        void renderViewPass(_In_ const std::wstring& szViewName);
+        void renderScenes(_In_ UINT uView);
+        void renderSkyboxPass();
+        void renderSkyboxes(_In_ const XMVECTOR& eye);
+        void renderUpscalePass();
+        void bindShadowMap();
+        void updateRenderScale();
+        void setViewport(_In_ UINT uWidth, _In_ UINT uHeight);
+        ID3D11RenderTargetView* getSceneRenderTargetView() const;
+        void renderInstances(_In_ Renderable& renderable, _In_ UINT uFirstInstance, _In_ UINT uNumInstances, _In_ BOOL bDepthOnly);
+        void renderVoxel(_In_ Voxel& voxel, _In_ BOOL bDepthOnly);
+        void renderSkinnedModel(_In_ Model& model);
+        void renderBakedModels(_In_ Scene& scene, _In_ UINT uView);
+        void renderBakedInstances(_In_ Model& model, _In_ UINT uFirstInstance, _In_ UINT uNumInstances);
+        HRESULT initializeShadowMaps(_In_ const RenderGraphTextureDesc& shadowMapDesc);
+        void renderRenderableToShadowMap(_In_ Renderable& renderable, _In_ UINT uView);
+        void renderVoxelToShadowMap(_In_ Voxel& voxel, _In_ UINT uView);
+        void renderShadowCasters(_In_ BOOL bStatic, _In_ UINT uView);
+        void nameCaptureObjects();
+        void nameRenderableForCapture(_In_ const std::wstring& name, _In_ Renderable& renderable);
 
     private:
         D3D_DRIVER_TYPE m_driverType;
@@ -94,8 +209,64 @@ namespace library
 
         std::unordered_map<std::wstring, std::shared_ptr<Scene>> m_scenes;
         std::shared_ptr<Texture> m_invalidTexture;
-        std::shared_ptr<RenderTexture> m_shadowMapTexture;
         std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
         std::shared_ptr<PixelShader> m_shadowPixelShader;
+
+        UINT m_uWidth;
+        UINT m_uHeight;
+        RenderGraph m_renderGraph;
+        std::vector<std::shared_ptr<RenderTexture>> m_aRenderGraphTextures;
+        UINT m_uShadowMapResource;
+        BOOL m_bRenderGraphDirty;
+
+        InstanceBatcher m_instanceBatcher;
+        ComPtr<ID3D11Buffer> m_instanceBuffer;
+        UINT m_uInstanceBufferCapacity;
+        Scene* m_pInstanceScene;
+        UINT m_uInstanceView;
+
+        BOOL m_bDepthPrepass;
+        ComPtr<ID3D11DepthStencilState> m_depthLessEqualState;
+
+        CommandContext m_commandContext;
+        std::wstring m_szCaptureFileName;
+
+        BOOL m_bDynamicResolution;
+        ResolutionGovernor m_resolutionGovernor;
+        UINT m_uSceneColorResource;
+        UINT m_uRenderWidth;
+        UINT m_uRenderHeight;
+        LARGE_INTEGER m_counterFrequency;
+        LARGE_INTEGER m_lastFrameCounter;
+        std::shared_ptr<VertexShader> m_upscaleVertexShader;
+        std::shared_ptr<PixelShader> m_upscalePixelShader;
+        ComPtr<ID3D11Buffer> m_cbUpscale;
+
+        ViewSet m_viewSet;
+        std::vector<ViewItem> m_aViewItems;
+        std::unordered_map<std::wstring, OffscreenView> m_offscreenViews;
+        AnimationLodPolicy m_animationLodPolicy;
+        std::vector<Model*> m_aBakedModels;
+        std::vector<BakedInstanceData> m_aBakedInstances;
+        ComPtr<ID3D11Buffer> m_bakedInstanceBuffer;
+        UINT m_uBakedInstanceBufferCapacity;
+
+        LightClusterer m_lightClusterer;
+        std::vector<XMFLOAT4> m_aLightSpheres;
+        std::vector<StrPointLight> m_aClusteredLights;
+        StructuredBuffer m_lightBuffer;
+        StructuredBuffer m_lightClusterBuffer;
+        StructuredBuffer m_lightIndexBuffer;
+
+        ShadowCascades m_shadowCascades;
+        ShadowCasterCache m_aShadowCasterCaches[NUM_SHADOW_CASCADES];
+        std::shared_ptr<RenderTexture> m_aStaticShadowMaps[NUM_SHADOW_CASCADES];
+        ComPtr<ID3D11Texture2D> m_shadowDepthStencil;
+        ComPtr<ID3D11DepthStencilView> m_shadowDepthStencilView;
+        ComPtr<ID3D11Texture2D> m_staticShadowDepthStencil;
+        ComPtr<ID3D11DepthStencilView> m_staticShadowDepthStencilView;
+        ComPtr<ID3D11BlendState> m_minBlendState;
+
+        ThreadPool m_threadPool;
     };
 }
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "Renderer/ResolutionGovernor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::ResolutionGovernor
+
+      Summary:  Constructor
+
+      Args:     const ResolutionGovernorDesc& desc
+                  Target, bounds and gains of the governor
+
+      Modifies: [m_desc, m_aFrameTimes, m_uNumFrameTimes,
+                  m_uNextFrameTime, m_integral, m_scale,
+                  m_filteredFrameTime].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ResolutionGovernor::ResolutionGovernor(_In_ const ResolutionGovernorDesc& desc) :
+        m_desc(desc),
+        m_aFrameTimes(),
+        m_uNumFrameTimes(0u),
+        m_uNextFrameTime(0u),
+        m_integral(desc.maxScale),
+        m_scale(desc.maxScale),
+        m_filteredFrameTime(0.0f)
+    {
+        SetDesc(desc);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::SetDesc
+
+      Summary:  Replaces the target, bounds and gains, and restarts from
+                the maximum scale
+
+      Args:     const ResolutionGovernorDesc& desc
+                  Target, bounds and gains of the governor
+
+      Modifies: [m_desc, m_aFrameTimes, m_uNumFrameTimes,
+                  m_uNextFrameTime, m_integral, m_scale,
+                  m_filteredFrameTime].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ResolutionGovernor::SetDesc(_In_ const ResolutionGovernorDesc& desc)
+    {
+        assert(desc.targetFrameTime > 0.0f);
+        assert(desc.minScale > 0.0f && desc.minScale <= desc.maxScale);
+
+        m_desc = desc;
+        m_desc.uHistoryLength = std::max(desc.uHistoryLength, 1u);
+        m_aFrameTimes.assign(m_desc.uHistoryLength, 0.0f);
+
+        Reset();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::GetDesc
+
+      Summary:  Returns the target, bounds and gains of the governor
+
+      Returns:  const ResolutionGovernorDesc&
+                  Description of the governor
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ResolutionGovernorDesc& ResolutionGovernor::GetDesc() const
+    {
+        return m_desc;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::Reset
+
+      Summary:  Restores the maximum scale and clears the frame history
+                and the integral of the controller
+
+      Modifies: [m_uNumFrameTimes, m_uNextFrameTime, m_integral,
+                  m_scale, m_filteredFrameTime].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ResolutionGovernor::Reset()
+    {
+        m_uNumFrameTimes = 0u;
+        m_uNextFrameTime = 0u;
+        m_integral = m_desc.maxScale;
+        m_scale = m_desc.maxScale;
+        m_filteredFrameTime = 0.0f;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::AddFrameTime
+
+      Summary:  Adds the time of a frame to the history. Once the
+                history is full, the relative error of its median
+                against the target drives the PI controller. The
+                integral holds the scale the controller settles at and
+                is clamped to the bounds, so it does not wind up while
+                the scale sits at a bound
+
+      Args:     FLOAT frameTime
+                  Time of the frame in seconds
+
+      Modifies: [m_aFrameTimes, m_uNumFrameTimes, m_uNextFrameTime,
+                  m_integral, m_scale, m_filteredFrameTime].
+
+      Returns:  FLOAT
+                  Render scale of the next frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ResolutionGovernor::AddFrameTime(_In_ FLOAT frameTime)
+    {
+        if (!(frameTime > 0.0f))
+        {
+            return m_scale;
+        }
+
+        m_aFrameTimes[m_uNextFrameTime] = frameTime;
+        m_uNextFrameTime = (m_uNextFrameTime + 1u) % m_desc.uHistoryLength;
+        m_uNumFrameTimes = std::min(m_uNumFrameTimes + 1u, m_desc.uHistoryLength);
+        if (m_uNumFrameTimes < m_desc.uHistoryLength)
+        {
+            return m_scale;
+        }
+
+        // The median ignores single hitches such as shader compilation or paging
+        std::vector<FLOAT> aSortedFrameTimes(m_aFrameTimes);
+        std::nth_element(aSortedFrameTimes.begin(), aSortedFrameTimes.begin() + aSortedFrameTimes.size() / 2u, aSortedFrameTimes.end());
+        m_filteredFrameTime = aSortedFrameTimes[aSortedFrameTimes.size() / 2u];
+
+        // Positive when there is headroom to raise the scale
+        FLOAT error = (m_desc.targetFrameTime - m_filteredFrameTime) / m_desc.targetFrameTime;
+        if (std::fabs(error) <= m_desc.hysteresis)
+        {
+            return m_scale;
+        }
+
+        m_integral = std::clamp(m_integral + m_desc.integralGain * error, m_desc.minScale, m_desc.maxScale);
+        FLOAT scale = snapScale(m_integral + m_desc.proportionalGain * error);
+        if (scale != m_scale)
+        {
+            m_scale = scale;
+
+            // Frames of the old scale must not drive the next decision
+            m_uNumFrameTimes = 0u;
+            m_uNextFrameTime = 0u;
+        }
+
+        return m_scale;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::GetScale
+
+      Summary:  Returns the current render scale
+
+      Returns:  FLOAT
+                  Scale of the width and height of the main pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ResolutionGovernor::GetScale() const
+    {
+        return m_scale;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::GetFilteredFrameTime
+
+      Summary:  Returns the median frame time of the last full history
+
+      Returns:  FLOAT
+                  Frame time in seconds, 0 before the history filled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ResolutionGovernor::GetFilteredFrameTime() const
+    {
+        return m_filteredFrameTime;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ResolutionGovernor::snapScale
+
+      Summary:  Rounds a scale to the nearest step within the bounds
+
+      Args:     FLOAT scale
+                  Scale computed by the controller
+
+      Returns:  FLOAT
+                  Snapped scale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ResolutionGovernor::snapScale(_In_ FLOAT scale) const
+    {
+        if (m_desc.scaleStep > 0.0f)
+        {
+            scale = std::round(scale / m_desc.scaleStep) * m_desc.scaleStep;
+        }
+
+        return std::clamp(scale, m_desc.minScale, m_desc.maxScale);
+    }
+}
@@ -0,0 +1,99 @@
+/*+===================================================================
+  File:      RESOLUTIONGOVERNOR.H
+
+  Summary:   ResolutionGovernor header file contains declarations of
+             ResolutionGovernor class that picks the render scale of
+             the main pass from the recent frame times. The header only
+             depends on CoreCommon.h, so the governor can be replayed
+             against recorded frame times without Direct3D.
+
+  Classes: ResolutionGovernorDesc, ResolutionGovernor
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ResolutionGovernorDesc
+
+        Summary:  Data structure that describes the frame time target,
+                  the scale bounds and the controller gains. The errors
+                  fed to the controller are relative to the target, so
+                  the gains do not depend on the target frame time
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ResolutionGovernorDesc
+    {
+        FLOAT targetFrameTime;
+        FLOAT minScale;
+        FLOAT maxScale;
+        FLOAT scaleStep;
+        FLOAT proportionalGain;
+        FLOAT integralGain;
+        FLOAT hysteresis;
+        UINT uHistoryLength;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ResolutionGovernor
+
+      Summary:  PI controller of the render scale. The median of the
+                last frames is compared against the target, errors
+                inside the hysteresis band are ignored, and the scale
+                is snapped to steps so small corrections do not resize
+                the viewport every frame. After every change of the
+                scale the history is cleared, so only frames rendered
+                at the new scale drive the next decision
+
+      Methods:  SetDesc
+                  Replaces the description and resets the governor
+                GetDesc
+                  Returns the description
+                Reset
+                  Restores the maximum scale and clears the history
+                AddFrameTime
+                  Feeds the time of a frame and updates the scale
+                GetScale
+                  Returns the current render scale
+                GetFilteredFrameTime
+                  Returns the median of the frame history
+                ResolutionGovernor
+                  Constructor.
+                ~ResolutionGovernor
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ResolutionGovernor final
+    {
+    public:
+        ResolutionGovernor() = delete;
+        explicit ResolutionGovernor(_In_ const ResolutionGovernorDesc& desc);
+        ResolutionGovernor(const ResolutionGovernor& other) = delete;
+        ResolutionGovernor(ResolutionGovernor&& other) = delete;
+        ResolutionGovernor& operator=(const ResolutionGovernor& other) = delete;
+        ResolutionGovernor& operator=(ResolutionGovernor&& other) = delete;
+        ~ResolutionGovernor() = default;
+
+        void SetDesc(_In_ const ResolutionGovernorDesc& desc);
+        const ResolutionGovernorDesc& GetDesc() const;
+        void Reset();
+
+        FLOAT AddFrameTime(_In_ FLOAT frameTime);
+        FLOAT GetScale() const;
+        FLOAT GetFilteredFrameTime() const;
+
+    private:
+        FLOAT snapScale(_In_ FLOAT scale) const;
+
+    private:
+        ResolutionGovernorDesc m_desc;
+        std::vector<FLOAT> m_aFrameTimes;
+        UINT m_uNumFrameTimes;
+        UINT m_uNextFrameTime;
+        FLOAT m_integral;
+        FLOAT m_scale;
+        FLOAT m_filteredFrameTime;
+    };
+}
@@ -0,0 +1,268 @@
+#include "Renderer/ShadowCascades.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::ShadowCascades
+
+      Summary:  Constructor
+
+      Args:     const ShadowCascadesDesc& desc
+                  Number, resolution and split scheme of the cascades
+
+      Modifies: [m_desc, m_tanHalfFovX, m_tanHalfFovY, m_lightView,
+                  m_aProjections, m_aSplitDepths, m_aTexelSizes,
+                  m_aDepthBiases].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShadowCascades::ShadowCascades(_In_ const ShadowCascadesDesc& desc) :
+        m_desc(desc),
+        m_tanHalfFovX(1.0f),
+        m_tanHalfFovY(1.0f),
+        m_lightView(XMMatrixIdentity()),
+        m_aProjections{ XMMatrixIdentity(), XMMatrixIdentity(), XMMatrixIdentity(), XMMatrixIdentity() },
+        m_aSplitDepths{ 0.0f },
+        m_aTexelSizes{ 0.0f },
+        m_aDepthBiases{ 0.0f }
+    {
+        assert(desc.uNumCascades > 0u && desc.uNumCascades <= MAX_CASCADES);
+        assert(desc.uResolution > 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetDesc
+
+      Summary:  Returns the description
+
+      Returns:  const ShadowCascadesDesc&
+                  Number, resolution and split scheme of the cascades
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ShadowCascadesDesc& ShadowCascades::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::Update
+
+      Summary:  Splits the view depth of the camera from its near plane
+                to the shadow distance and fits every cascade
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const XMMATRIX& cameraProjection
+                  Left handed perspective projection matrix of the
+                  camera with the depth from 0 to 1
+                FXMVECTOR lightDirection
+                  World space direction the light shines in
+                const BoundingBox& sceneBounds
+                  World space bounds of the shadow casters and receivers
+
+      Modifies: [m_tanHalfFovX, m_tanHalfFovY, m_lightView,
+                  m_aProjections, m_aSplitDepths, m_aTexelSizes,
+                  m_aDepthBiases].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::Update(_In_ const XMMATRIX& cameraView, _In_ const XMMATRIX& cameraProjection, _In_ FXMVECTOR lightDirection, _In_ const BoundingBox& sceneBounds)
+    {
+        XMFLOAT4X4 projection;
+        XMStoreFloat4x4(&projection, cameraProjection);
+        m_tanHalfFovX = 1.0f / projection._11;
+        m_tanHalfFovY = 1.0f / projection._22;
+        FLOAT nearPlane = -projection._43 / projection._33;
+        FLOAT farPlane = projection._43 / (1.0f - projection._33);
+        FLOAT shadowFar = m_desc.shadowDistance < farPlane ? m_desc.shadowDistance : farPlane;
+
+        // The light view only rotates, so moving the camera moves the cascades by whole texels in light space
+        XMVECTOR direction = XMVector3Normalize(lightDirection);
+        XMVECTOR up = std::fabs(XMVectorGetY(direction)) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+        m_lightView = XMMatrixLookToLH(XMVectorZero(), direction, up);
+
+        BoundingBox lightBounds;
+        sceneBounds.Transform(lightBounds, m_lightView);
+        XMVECTOR sceneMin = XMLoadFloat3(&lightBounds.Center) - XMLoadFloat3(&lightBounds.Extents);
+        XMVECTOR sceneMax = XMLoadFloat3(&lightBounds.Center) + XMLoadFloat3(&lightBounds.Extents);
+
+        XMMATRIX cameraToLight = XMMatrixInverse(nullptr, cameraView) * m_lightView;
+        FLOAT splitNear = nearPlane;
+        for (UINT i = 0u; i < m_desc.uNumCascades; ++i)
+        {
+            FLOAT t = static_cast<FLOAT>(i + 1u) / static_cast<FLOAT>(m_desc.uNumCascades);
+            FLOAT logSplit = nearPlane * std::pow(shadowFar / nearPlane, t);
+            FLOAT uniformSplit = nearPlane + (shadowFar - nearPlane) * t;
+            FLOAT splitFar = m_desc.splitLambda * logSplit + (1.0f - m_desc.splitLambda) * uniformSplit;
+
+            fitCascade(i, splitNear, splitFar, cameraToLight, sceneMin, sceneMax);
+            m_aSplitDepths[i] = splitFar;
+            splitNear = splitFar;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetViewMatrix
+
+      Summary:  Returns the light view shared by the cascades
+
+      Returns:  const XMMATRIX&
+                  View matrix of the light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& ShadowCascades::GetViewMatrix() const
+    {
+        return m_lightView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetProjectionMatrix
+
+      Summary:  Returns the orthographic projection of a cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade, nearest first
+
+      Returns:  const XMMATRIX&
+                  Projection matrix of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& ShadowCascades::GetProjectionMatrix(_In_ UINT uCascade) const
+    {
+        assert(uCascade < m_desc.uNumCascades);
+        return m_aProjections[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetSplitDepth
+
+      Summary:  Returns the view depth of the camera a cascade ends at,
+                the next cascade starts there
+
+      Args:     UINT uCascade
+                  Index of the cascade, nearest first
+
+      Returns:  FLOAT
+                  View depth of the far end of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ShadowCascades::GetSplitDepth(_In_ UINT uCascade) const
+    {
+        assert(uCascade < m_desc.uNumCascades);
+        return m_aSplitDepths[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetTexelSize
+
+      Summary:  Returns the world space width of a shadow map texel of
+                a cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade, nearest first
+
+      Returns:  FLOAT
+                  Width of a texel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ShadowCascades::GetTexelSize(_In_ UINT uCascade) const
+    {
+        assert(uCascade < m_desc.uNumCascades);
+        return m_aTexelSizes[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::GetDepthBias
+
+      Summary:  Returns the bias added to the depth of a cascade before
+                it is compared, the depth a surface at 45 degrees to
+                the light changes by over one and a half texels
+
+      Args:     UINT uCascade
+                  Index of the cascade, nearest first
+
+      Returns:  FLOAT
+                  Depth bias in projected depth
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT ShadowCascades::GetDepthBias(_In_ UINT uCascade) const
+    {
+        assert(uCascade < m_desc.uNumCascades);
+        return m_aDepthBiases[uCascade];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCascades::fitCascade
+
+      Summary:  Fits the orthographic projection of a cascade to the
+                bounding sphere of its slice of the camera frustum
+
+      Args:     UINT uCascade
+                  Index of the cascade
+                FLOAT nearDepth
+                  View depth the slice starts at
+                FLOAT farDepth
+                  View depth the slice ends at
+                const XMMATRIX& cameraToLight
+                  Transform from the camera view to the light view
+                FXMVECTOR sceneMin
+                  Minimum of the scene bounds in the light view
+                FXMVECTOR sceneMax
+                  Maximum of the scene bounds in the light view
+
+      Modifies: [m_aProjections, m_aTexelSizes, m_aDepthBiases].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCascades::fitCascade(_In_ UINT uCascade, _In_ FLOAT nearDepth, _In_ FLOAT farDepth, _In_ const XMMATRIX& cameraToLight, _In_ FXMVECTOR sceneMin, _In_ FXMVECTOR sceneMax)
+    {
+        // The sphere through the corners of both ends of the slice, or around its far end when the slice is wider than
+        // deep. Its radius only depends on the projection, so turning the camera keeps the size of the cascade
+        FLOAT cornerSquared = m_tanHalfFovX * m_tanHalfFovX + m_tanHalfFovY * m_tanHalfFovY;
+        FLOAT centerDepth = 0.5f * (nearDepth + farDepth) * (1.0f + cornerSquared);
+        FLOAT radius = 0.0f;
+        if (centerDepth >= farDepth)
+        {
+            centerDepth = farDepth;
+            radius = farDepth * std::sqrt(cornerSquared);
+        }
+        else
+        {
+            radius = std::sqrt((farDepth - centerDepth) * (farDepth - centerDepth) + farDepth * farDepth * cornerSquared);
+        }
+
+        // A scene smaller than the sphere only needs the next power of two of its size, which stays the same while
+        // the scene changes a little
+        FLOAT width = 2.0f * radius;
+        XMFLOAT3 sceneSize;
+        XMStoreFloat3(&sceneSize, XMVectorSubtract(sceneMax, sceneMin));
+        FLOAT sceneWidth = sceneSize.x > sceneSize.y ? sceneSize.x : sceneSize.y;
+        if (sceneWidth > 0.0f)
+        {
+            FLOAT sceneWidthPow2 = std::exp2(std::ceil(std::log2(sceneWidth)));
+            width = sceneWidthPow2 < width ? sceneWidthPow2 : width;
+        }
+        FLOAT texelSize = width / static_cast<FLOAT>(m_desc.uResolution);
+
+        // Keep the cascade inside the scene on the axes the scene is larger, center it on the scene on the others
+        XMVECTOR halfWidth = XMVectorReplicate(0.5f * width);
+        XMVECTOR center = XMVector3TransformCoord(XMVectorSet(0.0f, 0.0f, centerDepth, 1.0f), cameraToLight);
+        XMVECTOR low = XMVectorAdd(sceneMin, halfWidth);
+        XMVECTOR high = XMVectorSubtract(sceneMax, halfWidth);
+        XMVECTOR sceneCenter = XMVectorScale(XMVectorAdd(sceneMin, sceneMax), 0.5f);
+        center = XMVectorSelect(sceneCenter, XMVectorMin(XMVectorMax(center, low), high), XMVectorLessOrEqual(low, high));
+
+        // Whole texels in light space, so the texels of the shadow map stay on the same world positions
+        XMVECTOR texel = XMVectorReplicate(texelSize);
+        XMVECTOR minCorner = XMVectorMultiply(XMVectorFloor(XMVectorDivide(XMVectorSubtract(center, halfWidth), texel)), texel);
+        XMVECTOR maxCorner = XMVectorAdd(minCorner, XMVectorReplicate(width));
+
+        FLOAT nearZ = XMVectorGetZ(sceneMin);
+        FLOAT farZ = XMVectorGetZ(sceneMax);
+        if (farZ - nearZ < texelSize)
+        {
+            farZ = nearZ + texelSize;
+        }
+
+        m_aProjections[uCascade] = XMMatrixOrthographicOffCenterLH(
+            XMVectorGetX(minCorner),
+            XMVectorGetX(maxCorner),
+            XMVectorGetY(minCorner),
+            XMVectorGetY(maxCorner),
+            nearZ,
+            farZ
+        );
+        m_aTexelSizes[uCascade] = texelSize;
+        m_aDepthBiases[uCascade] = 1.5f * texelSize / (farZ - nearZ);
+    }
+}
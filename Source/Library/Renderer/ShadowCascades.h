@@ -0,0 +1,109 @@
+/*+===================================================================
+  File:      SHADOWCASCADES.H
+
+  Summary:   ShadowCascades header file contains declarations of
+             ShadowCascades class that splits the camera frustum into
+             cascades and fits an orthographic shadow projection of a
+             directional light to each of them.
+
+  Classes: ShadowCascadesDesc, ShadowCascades
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ShadowCascadesDesc
+
+        Summary:  Data structure that describes the cascades. The split
+                  lambda blends the uniform split scheme, at 0, with the
+                  logarithmic one, at 1. Shadows end at the shadow
+                  distance or at the far plane of the camera, whichever
+                  is nearer
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ShadowCascadesDesc
+    {
+        UINT uNumCascades;
+        UINT uResolution;
+        FLOAT shadowDistance;
+        FLOAT splitLambda;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShadowCascades
+
+      Summary:  Splits the view depth of a perspective camera with the
+                practical split scheme and fits a square orthographic
+                projection to every slice. All cascades share one light
+                view that only rotates with the light direction. The
+                size of a cascade comes from the bounding sphere of its
+                slice, so it does not change when the camera turns, and
+                shrinks to the next power of two of the scene bounds
+                when the scene is smaller. The cascade is moved inside
+                the scene bounds so no texel covers empty space, and its
+                corner is snapped to whole texels so the shadow edges do
+                not shimmer when the camera moves. The depth range
+                covers the scene bounds, so casters between the light
+                and the slice are kept. The math does not touch Direct3D
+
+      Methods:  GetDesc
+                  Returns the description
+                Update
+                  Fits the cascades to a camera and a light
+                GetViewMatrix
+                  Returns the light view shared by the cascades
+                GetProjectionMatrix
+                  Returns the projection of a cascade
+                GetSplitDepth
+                  Returns the view depth a cascade ends at
+                GetTexelSize
+                  Returns the world size of a texel of a cascade
+                GetDepthBias
+                  Returns the depth bias of a cascade
+                ShadowCascades
+                  Constructor.
+                ~ShadowCascades
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShadowCascades final
+    {
+    public:
+        static constexpr const UINT MAX_CASCADES = 4u;
+
+    public:
+        ShadowCascades() = delete;
+        explicit ShadowCascades(_In_ const ShadowCascadesDesc& desc);
+        ShadowCascades(const ShadowCascades& other) = delete;
+        ShadowCascades(ShadowCascades&& other) = delete;
+        ShadowCascades& operator=(const ShadowCascades& other) = delete;
+        ShadowCascades& operator=(ShadowCascades&& other) = delete;
+        ~ShadowCascades() = default;
+
+        const ShadowCascadesDesc& GetDesc() const;
+
+        void Update(_In_ const XMMATRIX& cameraView, _In_ const XMMATRIX& cameraProjection, _In_ FXMVECTOR lightDirection, _In_ const BoundingBox& sceneBounds);
+
+        const XMMATRIX& GetViewMatrix() const;
+        const XMMATRIX& GetProjectionMatrix(_In_ UINT uCascade) const;
+        FLOAT GetSplitDepth(_In_ UINT uCascade) const;
+        FLOAT GetTexelSize(_In_ UINT uCascade) const;
+        FLOAT GetDepthBias(_In_ UINT uCascade) const;
+
+    private:
+        void fitCascade(_In_ UINT uCascade, _In_ FLOAT nearDepth, _In_ FLOAT farDepth, _In_ const XMMATRIX& cameraToLight, _In_ FXMVECTOR sceneMin, _In_ FXMVECTOR sceneMax);
+
+    private:
+        ShadowCascadesDesc m_desc;
+        FLOAT m_tanHalfFovX;
+        FLOAT m_tanHalfFovY;
+        XMMATRIX m_lightView;
+        XMMATRIX m_aProjections[MAX_CASCADES];
+        FLOAT m_aSplitDepths[MAX_CASCADES];
+        FLOAT m_aTexelSizes[MAX_CASCADES];
+        FLOAT m_aDepthBiases[MAX_CASCADES];
+    };
+}
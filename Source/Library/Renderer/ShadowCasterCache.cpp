@@ -0,0 +1,151 @@
+#include "Renderer/ShadowCasterCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::ShadowCasterCache
+
+      Summary:  Constructor, the first frame is always dirty
+
+      Modifies: [m_bValid, m_bDirty, m_lightView, m_lightProjection,
+                  m_cachedLightView, m_cachedLightProjection,
+                  m_aCasters, m_aCachedCasters].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShadowCasterCache::ShadowCasterCache() :
+        m_bValid(FALSE),
+        m_bDirty(TRUE),
+        m_lightView(),
+        m_lightProjection(),
+        m_cachedLightView(),
+        m_cachedLightProjection(),
+        m_aCasters(),
+        m_aCachedCasters()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::Invalidate
+
+      Summary:  Forgets the cached frame, so the next frame is dirty.
+                Used when the static shadow map itself was lost, such
+                as when it is recreated or the shadow shaders change
+
+      Modifies: [m_bValid, m_bDirty].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCasterCache::Invalidate()
+    {
+        m_bValid = FALSE;
+        m_bDirty = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::BeginFrame
+
+      Summary:  Starts collecting the static casters of a frame
+
+      Args:     const XMMATRIX& lightView
+                  View matrix of the light
+                const XMMATRIX& lightProjection
+                  Projection matrix of the light
+
+      Modifies: [m_lightView, m_lightProjection, m_aCasters].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCasterCache::BeginFrame(_In_ const XMMATRIX& lightView, _In_ const XMMATRIX& lightProjection)
+    {
+        XMStoreFloat4x4(&m_lightView, lightView);
+        XMStoreFloat4x4(&m_lightProjection, lightProjection);
+        m_aCasters.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::AddStaticCaster
+
+      Summary:  Adds a static caster inside the light frustum
+
+      Args:     const void* pCaster
+                  Object that identifies the caster across frames
+                const XMMATRIX& world
+                  World matrix of the caster
+
+      Modifies: [m_aCasters].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShadowCasterCache::AddStaticCaster(_In_ const void* pCaster, _In_ const XMMATRIX& world)
+    {
+        Caster caster = { .pCaster = pCaster, .world = XMFLOAT4X4() };
+        XMStoreFloat4x4(&caster.world, world);
+        m_aCasters.push_back(caster);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::EndFrame
+
+      Summary:  Compares the light matrices and the static casters of
+                the frame with the cached frame bit by bit. A dirty
+                frame becomes the cached frame, since the static
+                casters are rendered again in it
+
+      Modifies: [m_bValid, m_bDirty, m_cachedLightView,
+                  m_cachedLightProjection, m_aCasters,
+                  m_aCachedCasters].
+
+      Returns:  BOOL
+                  TRUE if the static casters must be rendered again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ShadowCasterCache::EndFrame()
+    {
+        // The visible casters come front to back, which may reorder casters at the same depth
+        std::sort(m_aCasters.begin(), m_aCasters.end(),
+            [](const Caster& a, const Caster& b) { return std::less<const void*>()(a.pCaster, b.pCaster); });
+
+        m_bDirty = !m_bValid ||
+            std::memcmp(&m_lightView, &m_cachedLightView, sizeof(XMFLOAT4X4)) != 0 ||
+            std::memcmp(&m_lightProjection, &m_cachedLightProjection, sizeof(XMFLOAT4X4)) != 0 ||
+            !std::equal(m_aCasters.begin(), m_aCasters.end(), m_aCachedCasters.begin(), m_aCachedCasters.end(),
+                [](const Caster& a, const Caster& b)
+                {
+                    return a.pCaster == b.pCaster && std::memcmp(&a.world, &b.world, sizeof(XMFLOAT4X4)) == 0;
+                });
+
+        if (m_bDirty)
+        {
+            m_cachedLightView = m_lightView;
+            m_cachedLightProjection = m_lightProjection;
+            m_aCachedCasters.swap(m_aCasters);
+            m_bValid = TRUE;
+        }
+
+        return m_bDirty;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::IsDirty
+
+      Summary:  Returns whether the static casters of the last ended
+                frame must be rendered again
+
+      Returns:  BOOL
+                  TRUE if the static shadow map is out of date
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ShadowCasterCache::IsDirty() const
+    {
+        return m_bDirty;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShadowCasterCache::GetNumStaticCasters
+
+      Summary:  Returns the number of static casters inside the light
+                frustum of the last ended frame
+
+      Returns:  UINT
+                  Number of static casters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShadowCasterCache::GetNumStaticCasters() const
+    {
+        return static_cast<UINT>(m_bDirty ? m_aCachedCasters.size() : m_aCasters.size());
+    }
+}
@@ -0,0 +1,83 @@
+/*+===================================================================
+  File:      SHADOWCASTERCACHE.H
+
+  Summary:   ShadowCasterCache header file contains declarations of
+             ShadowCasterCache class that decides when the static
+             shadow casters of a light have to be rendered again.
+
+  Classes: ShadowCasterCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShadowCasterCache
+
+      Summary:  Remembers the light matrices and the static casters
+                inside the light frustum of the frame the static shadow
+                map was rendered in. Every frame the visible static
+                casters are added again, and the static shadow map is
+                dirty when the light moved, a static caster moved, or a
+                static caster entered or left the light frustum. The
+                order the casters are added in does not matter. The
+                cache does not touch Direct3D
+
+      Methods:  Invalidate
+                  Forces the static casters to be rendered again
+                BeginFrame
+                  Starts collecting the static casters of a frame
+                AddStaticCaster
+                  Adds a static caster inside the light frustum
+                EndFrame
+                  Compares the frame with the cached one
+                IsDirty
+                  Returns whether the static casters must be rendered
+                GetNumStaticCasters
+                  Returns the number of static casters of the frame
+                ShadowCasterCache
+                  Constructor.
+                ~ShadowCasterCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShadowCasterCache final
+    {
+    public:
+        ShadowCasterCache();
+        ShadowCasterCache(const ShadowCasterCache& other) = delete;
+        ShadowCasterCache(ShadowCasterCache&& other) = delete;
+        ShadowCasterCache& operator=(const ShadowCasterCache& other) = delete;
+        ShadowCasterCache& operator=(ShadowCasterCache&& other) = delete;
+        ~ShadowCasterCache() = default;
+
+        void Invalidate();
+
+        void BeginFrame(_In_ const XMMATRIX& lightView, _In_ const XMMATRIX& lightProjection);
+        void AddStaticCaster(_In_ const void* pCaster, _In_ const XMMATRIX& world);
+        BOOL EndFrame();
+
+        BOOL IsDirty() const;
+        UINT GetNumStaticCasters() const;
+
+    private:
+        struct Caster
+        {
+            const void* pCaster;
+            XMFLOAT4X4 world;
+        };
+
+    private:
+        BOOL m_bValid;
+        BOOL m_bDirty;
+        XMFLOAT4X4 m_lightView;
+        XMFLOAT4X4 m_lightProjection;
+        XMFLOAT4X4 m_cachedLightView;
+        XMFLOAT4X4 m_cachedLightProjection;
+        std::vector<Caster> m_aCasters;
+        std::vector<Caster> m_aCachedCasters;
+    };
+}
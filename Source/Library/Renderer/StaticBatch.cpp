@@ -0,0 +1,461 @@
+#include "Renderer/StaticBatch.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::StaticBatch
+
+      Summary:  Constructor
+
+      Args:     const Renderable& prototype
+                  Renderable whose shaders, output color and normal map
+                  usage are shared by every source of the batch
+
+      Modifies: [m_aVertices, m_aIndices, m_aMaterialIndices,
+                 m_aSubRanges, m_uNumSources, m_bHasTexture, m_bBuilt,
+                 m_vertexShader, m_pixelShader, m_bHasNormalMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    StaticBatch::StaticBatch(_In_ const Renderable& prototype) :
+        Renderable(prototype.GetOutputColor()),
+        m_aVertices(),
+        m_aIndices(),
+        m_aMaterialIndices(),
+        m_aSubRanges(),
+        m_uNumSources(0u),
+        m_bHasTexture(prototype.HasTexture()),
+        m_bBuilt(FALSE)
+    {
+        m_vertexShader = prototype.m_vertexShader;
+        m_pixelShader = prototype.m_pixelShader;
+        m_bHasNormalMap = prototype.m_bHasNormalMap;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::Initialize
+
+      Summary:  Builds the batch if needed and creates its buffers
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_aIndices, m_aMeshes, m_aSubRanges, m_bBuilt].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StaticBatch::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        if (m_aVertices.empty())
+        {
+            return E_FAIL;
+        }
+
+        Build();
+
+        return initialize(pDevice, pImmediateContext);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::Update
+
+      Summary:  Does nothing, the geometry of a static batch is already
+                in world space
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StaticBatch::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::CanAppend
+
+      Summary:  Returns whether the renderable is drawn with the same
+                state as the batch and its vertices still fit into 16-bit
+                indices
+
+      Args:     const Renderable& source
+                  Renderable to append
+
+      Returns:  BOOL
+                  Whether the renderable can be appended
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StaticBatch::CanAppend(_In_ const Renderable& source) const
+    {
+        if (m_bBuilt)
+        {
+            return FALSE;
+        }
+
+        if (source.m_vertexShader != m_vertexShader || source.m_pixelShader != m_pixelShader)
+        {
+            return FALSE;
+        }
+
+        if (source.HasTexture() != m_bHasTexture || source.m_bHasNormalMap != m_bHasNormalMap)
+        {
+            return FALSE;
+        }
+
+        const XMFLOAT4& color = source.GetOutputColor();
+        if (color.x != m_outputColor.x || color.y != m_outputColor.y
+            || color.z != m_outputColor.z || color.w != m_outputColor.w)
+        {
+            return FALSE;
+        }
+
+        return m_aVertices.size() + source.GetNumVertices() <= MAX_NUM_VERTICES;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::Append
+
+      Summary:  Transforms the vertices of the renderable into world
+                space and appends its meshes to the index list of their
+                material. Positions are transformed by the world matrix,
+                normals by its inverse transpose and tangent frames by
+                its upper 3x3 part
+
+      Args:     const Renderable& source
+                  Initialized renderable to append
+
+      Modifies: [m_aVertices, m_aNormalData, m_aMaterialIndices,
+                 m_aMaterials, m_aSubRanges, m_uNumSources].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StaticBatch::Append(_In_ const Renderable& source)
+    {
+        if (!CanAppend(source))
+        {
+            return E_FAIL;
+        }
+
+        const SimpleVertex* pSourceVertices = source.getVertices();
+        const WORD* pSourceIndices = source.getIndices();
+        UINT uNumSourceVertices = source.GetNumVertices();
+        UINT uNumSourceIndices = source.GetNumIndices();
+
+        if (source.HasTexture() && source.m_aMeshes.empty())
+        {
+            return E_INVALIDARG;
+        }
+
+        for (const BasicMeshEntry& mesh : source.m_aMeshes)
+        {
+            if (mesh.uBaseIndex + mesh.uNumIndices > uNumSourceIndices)
+            {
+                return E_INVALIDARG;
+            }
+
+            if (source.HasTexture() && mesh.uMaterialIndex >= source.GetNumMaterials())
+            {
+                return E_INVALIDARG;
+            }
+        }
+
+        XMMATRIX world = source.GetWorldMatrix();
+        XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+        UINT uVertexOffset = static_cast<UINT>(m_aVertices.size());
+
+        m_aVertices.reserve(m_aVertices.size() + uNumSourceVertices);
+        m_aNormalData.reserve(m_aNormalData.size() + uNumSourceVertices);
+        for (UINT i = 0u; i < uNumSourceVertices; ++i)
+        {
+            SimpleVertex vertex = pSourceVertices[i];
+            XMStoreFloat3(&vertex.Position, XMVector3TransformCoord(XMLoadFloat3(&vertex.Position), world));
+            XMStoreFloat3(&vertex.Normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&vertex.Normal), normalMatrix)));
+            m_aVertices.push_back(vertex);
+
+            NormalData normalData = { .Tangent = XMFLOAT3(0.0f, 0.0f, 0.0f), .Bitangent = XMFLOAT3(0.0f, 0.0f, 0.0f) };
+            if (i < source.m_aNormalData.size())
+            {
+                XMStoreFloat3(&normalData.Tangent, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&source.m_aNormalData[i].Tangent), world)));
+                XMStoreFloat3(&normalData.Bitangent, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&source.m_aNormalData[i].Bitangent), world)));
+            }
+            m_aNormalData.push_back(normalData);
+        }
+
+        // An untextured source without meshes is drawn with all of its indices
+        std::vector<BasicMeshEntry> aSourceMeshes = source.m_aMeshes;
+        if (aSourceMeshes.empty())
+        {
+            BasicMeshEntry mesh;
+            mesh.uNumIndices = uNumSourceIndices;
+            aSourceMeshes.push_back(mesh);
+        }
+
+        for (const BasicMeshEntry& mesh : aSourceMeshes)
+        {
+            UINT uMaterialIndex = INVALID_MATERIAL;
+            UINT uBucket = 0u;
+            if (source.HasTexture())
+            {
+                uMaterialIndex = findOrAddMaterial(source.GetMaterial(mesh.uMaterialIndex));
+                uBucket = uMaterialIndex;
+            }
+            if (uBucket >= m_aMaterialIndices.size())
+            {
+                m_aMaterialIndices.resize(uBucket + 1u);
+            }
+
+            std::vector<WORD>& aBucket = m_aMaterialIndices[uBucket];
+            XMVECTOR boundsMin = XMVectorReplicate(FLT_MAX);
+            XMVECTOR boundsMax = XMVectorReplicate(-FLT_MAX);
+
+            SubRange subRange = {
+                .uSourceIndex = m_uNumSources,
+                .uBaseIndex = static_cast<UINT>(aBucket.size()),
+                .uNumIndices = mesh.uNumIndices,
+                .uMaterialIndex = uMaterialIndex,
+                .worldBounds = BoundingBox()
+            };
+
+            for (UINT i = 0u; i < mesh.uNumIndices; ++i)
+            {
+                UINT uVertex = uVertexOffset + mesh.uBaseVertex + pSourceIndices[mesh.uBaseIndex + i];
+                aBucket.push_back(static_cast<WORD>(uVertex));
+
+                XMVECTOR position = XMLoadFloat3(&m_aVertices[uVertex].Position);
+                boundsMin = XMVectorMin(boundsMin, position);
+                boundsMax = XMVectorMax(boundsMax, position);
+            }
+
+            if (mesh.uNumIndices > 0u)
+            {
+                BoundingBox::CreateFromPoints(subRange.worldBounds, boundsMin, boundsMax);
+            }
+            m_aSubRanges.push_back(subRange);
+        }
+
+        ++m_uNumSources;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::Build
+
+      Summary:  Concatenates the index lists of every material, in the
+                order the materials were first appended, and creates one
+                mesh per material. The sub-ranges are rebased onto the
+                final index buffer. Building twice does nothing
+
+      Modifies: [m_aIndices, m_aMaterialIndices, m_aMeshes,
+                 m_aSubRanges, m_bBuilt].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StaticBatch::Build()
+    {
+        if (m_bBuilt)
+        {
+            return;
+        }
+
+        std::vector<UINT> aBucketOffsets;
+        aBucketOffsets.reserve(m_aMaterialIndices.size());
+
+        m_aIndices.clear();
+        m_aMeshes.clear();
+        for (UINT uBucket = 0u; uBucket < m_aMaterialIndices.size(); ++uBucket)
+        {
+            aBucketOffsets.push_back(static_cast<UINT>(m_aIndices.size()));
+
+            BasicMeshEntry mesh;
+            mesh.uNumIndices = static_cast<UINT>(m_aMaterialIndices[uBucket].size());
+            mesh.uBaseVertex = 0u;
+            mesh.uBaseIndex = static_cast<UINT>(m_aIndices.size());
+            mesh.uMaterialIndex = m_bHasTexture ? uBucket : INVALID_MATERIAL;
+            m_aMeshes.push_back(mesh);
+
+            m_aIndices.insert(m_aIndices.end(), m_aMaterialIndices[uBucket].begin(), m_aMaterialIndices[uBucket].end());
+        }
+
+        for (SubRange& subRange : m_aSubRanges)
+        {
+            UINT uBucket = subRange.uMaterialIndex == INVALID_MATERIAL ? 0u : subRange.uMaterialIndex;
+            subRange.uBaseIndex += aBucketOffsets[uBucket];
+        }
+
+        m_aMaterialIndices.clear();
+        m_bBuilt = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::IsBuilt
+
+      Summary:  Returns whether the batch has been built
+
+      Returns:  BOOL
+                  Whether the batch has been built
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StaticBatch::IsBuilt() const
+    {
+        return m_bBuilt;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetNumVertices
+
+      Summary:  Returns the number of vertices
+
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT StaticBatch::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_aVertices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetNumIndices
+
+      Summary:  Returns the number of indices
+
+      Returns:  UINT
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT StaticBatch::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_aIndices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetVertex
+
+      Summary:  Returns a vertex transformed into world space
+
+      Args:     UINT uIndex
+                  Index of the vertex
+
+      Returns:  const SimpleVertex&
+                  Vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SimpleVertex& StaticBatch::GetVertex(_In_ UINT uIndex) const
+    {
+        assert(uIndex < m_aVertices.size());
+        return m_aVertices[uIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetIndex
+
+      Summary:  Returns an index of the built batch, where the indices
+                are grouped by material
+
+      Args:     UINT uIndex
+                  Position in the index buffer
+
+      Returns:  WORD
+                  Index of the vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD StaticBatch::GetIndex(_In_ UINT uIndex) const
+    {
+        assert(uIndex < m_aIndices.size());
+        return m_aIndices[uIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetNumSources
+
+      Summary:  Returns the number of appended renderables
+
+      Returns:  UINT
+                  Number of appended renderables
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT StaticBatch::GetNumSources() const
+    {
+        return m_uNumSources;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetNumSubRanges
+
+      Summary:  Returns the number of sub-ranges
+
+      Returns:  UINT
+                  Number of sub-ranges, one per appended source mesh
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT StaticBatch::GetNumSubRanges() const
+    {
+        return static_cast<UINT>(m_aSubRanges.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::GetSubRange
+
+      Summary:  Returns the index range and world bounds of a source
+                mesh. The base index is only final once the batch is
+                built
+
+      Args:     UINT uIndex
+                  Index of the sub-range
+
+      Returns:  const StaticBatch::SubRange&
+                  Sub-range
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const StaticBatch::SubRange& StaticBatch::GetSubRange(_In_ UINT uIndex) const
+    {
+        assert(uIndex < m_aSubRanges.size());
+        return m_aSubRanges[uIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::getVertices
+
+      Summary:  Returns the pointer to the world space vertices
+
+      Returns:  const SimpleVertex*
+                  Pointer to the vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SimpleVertex* StaticBatch::getVertices() const
+    {
+        return m_aVertices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::getIndices
+
+      Summary:  Returns the pointer to the indices grouped by material
+
+      Returns:  const WORD*
+                  Pointer to the indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const WORD* StaticBatch::getIndices() const
+    {
+        return m_aIndices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StaticBatch::findOrAddMaterial
+
+      Summary:  Returns the index of the material in the batch, adding
+                it when it is not used yet
+
+      Args:     const std::shared_ptr<Material>& material
+                  Material of a source mesh
+
+      Modifies: [m_aMaterials].
+
+      Returns:  UINT
+                  Index of the material
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT StaticBatch::findOrAddMaterial(_In_ const std::shared_ptr<Material>& material)
+    {
+        for (UINT i = 0u; i < m_aMaterials.size(); ++i)
+        {
+            if (m_aMaterials[i] == material)
+            {
+                return i;
+            }
+        }
+
+        AddMaterial(material);
+
+        return static_cast<UINT>(m_aMaterials.size() - 1u);
+    }
+}
@@ -0,0 +1,118 @@
+/*+===================================================================
+  File:      STATICBATCH.H
+
+  Summary:   StaticBatch header file contains declarations of
+             StaticBatch class used to merge static renderables that
+             share shaders into a single set of buffers.
+
+  Classes: StaticBatch
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    StaticBatch
+
+      Summary:  Renderable that owns the geometry of static renderables
+                transformed into world space. Every source must share
+                the shaders, output color and normal map usage of the
+                batch. Indices are grouped by material so the batch is
+                drawn with one draw call per material, and the range of
+                every source mesh is kept together with its world
+                bounds for culling
+
+      Methods:  Initialize
+                  Builds the batch and creates its buffers
+                Update
+                  Does nothing, static geometry never changes
+                CanAppend
+                  Returns whether the renderable fits into the batch
+                Append
+                  Transforms and appends the renderable to the batch
+                Build
+                  Groups the appended indices by material
+                IsBuilt
+                  Returns whether the batch has been built
+                GetNumVertices
+                  Returns the number of vertices
+                GetNumIndices
+                  Returns the number of indices
+                GetVertex
+                  Returns a world space vertex
+                GetIndex
+                  Returns an index grouped by material
+                GetNumSources
+                  Returns the number of appended renderables
+                GetNumSubRanges
+                  Returns the number of sub-ranges
+                GetSubRange
+                  Returns the sub-range of a source mesh
+                StaticBatch
+                  Constructor.
+                ~StaticBatch
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class StaticBatch final : public Renderable
+    {
+    public:
+        static constexpr const UINT MAX_NUM_VERTICES = 65536u;
+
+        struct SubRange
+        {
+            UINT uSourceIndex;
+            UINT uBaseIndex;
+            UINT uNumIndices;
+            UINT uMaterialIndex;
+            BoundingBox worldBounds;
+        };
+
+    public:
+        StaticBatch() = delete;
+        StaticBatch(_In_ const Renderable& prototype);
+        StaticBatch(const StaticBatch& other) = delete;
+        StaticBatch(StaticBatch&& other) = delete;
+        StaticBatch& operator=(const StaticBatch& other) = delete;
+        StaticBatch& operator=(StaticBatch&& other) = delete;
+        ~StaticBatch() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        BOOL CanAppend(_In_ const Renderable& source) const;
+        HRESULT Append(_In_ const Renderable& source);
+        void Build();
+        BOOL IsBuilt() const;
+
+        virtual UINT GetNumVertices() const override;
+        virtual UINT GetNumIndices() const override;
+        const SimpleVertex& GetVertex(_In_ UINT uIndex) const;
+        WORD GetIndex(_In_ UINT uIndex) const;
+        UINT GetNumSources() const;
+        UINT GetNumSubRanges() const;
+        const SubRange& GetSubRange(_In_ UINT uIndex) const;
+
+    protected:
+        virtual const SimpleVertex* getVertices() const override;
+        virtual const WORD* getIndices() const override;
+
+    private:
+        UINT findOrAddMaterial(_In_ const std::shared_ptr<Material>& material);
+
+    private:
+        std::vector<SimpleVertex> m_aVertices;
+        std::vector<WORD> m_aIndices;
+        std::vector<std::vector<WORD>> m_aMaterialIndices;
+        std::vector<SubRange> m_aSubRanges;
+        UINT m_uNumSources;
+        BOOL m_bHasTexture;
+        BOOL m_bBuilt;
+    };
+}
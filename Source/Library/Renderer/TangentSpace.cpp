@@ -0,0 +1,113 @@
+#include "Renderer/TangentSpace.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentSpace::CalculateNormalMapVectors
+
+      Summary:  Computes the tangent and bitangent of every face and
+                stores them in its three vertices, so a vertex shared by
+                several faces keeps the vectors of the last one
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices of the triangle list
+                UINT uNumVertices
+                  Number of vertices
+                const WORD* aIndices
+                  Indices of the triangle list, three per face
+                UINT uNumIndices
+                  Number of indices
+                std::vector<NormalData>& aNormalData
+                  Tangent and bitangent of every vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TangentSpace::CalculateNormalMapVectors(_In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices, _In_reads_(uNumIndices) const WORD* aIndices, _In_ UINT uNumIndices, _Out_ std::vector<NormalData>& aNormalData)
+    {
+        UINT uNumFaces = uNumIndices / 3;
+
+        aNormalData.resize(uNumVertices, NormalData());
+
+        XMFLOAT3 tangent, bitangent;
+
+        for (UINT i = 0; i < uNumFaces; ++i) {
+            CalculateTangentBitangent(aVertices[aIndices[i * 3]], aVertices[aIndices[i * 3 + 1]],
+                aVertices[aIndices[i * 3 + 2]], tangent, bitangent);
+
+            aNormalData[aIndices[i * 3]].Tangent = tangent;
+            aNormalData[aIndices[i * 3]].Bitangent = bitangent;
+
+            aNormalData[aIndices[i * 3 + 1]].Tangent = tangent;
+            aNormalData[aIndices[i * 3 + 1]].Bitangent = bitangent;
+
+            aNormalData[aIndices[i * 3 + 2]].Tangent = tangent;
+            aNormalData[aIndices[i * 3 + 2]].Bitangent = bitangent;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentSpace::CalculateTangentBitangent
+
+      Summary:  Calculate tangent/bitangent vectors of the given face
+
+      Args:     SimpleVertex& v1
+                  The first vertex of the face
+                SimpleVertex& v2
+                  The second vertex of the face
+                SimpleVertex& v3
+                  The third vertex of the face
+                XMFLOAT3& tangent
+                  Calculated tangent vector
+                XMFLOAT3& bitangent
+                  Calculated bitangent vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TangentSpace::CalculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent)
+    {
+        XMFLOAT3 vector1, vector2;
+        XMFLOAT2 tuVector, tvVector;
+
+        // Calculate the two vectors for this face.
+        vector1.x = v2.Position.x - v1.Position.x;
+        vector1.y = v2.Position.y - v1.Position.y;
+        vector1.z = v2.Position.z - v1.Position.z;
+
+        vector2.x = v3.Position.x - v1.Position.x;
+        vector2.y = v3.Position.y - v1.Position.y;
+        vector2.z = v3.Position.z - v1.Position.z;
+
+        // Calculate the tu and tv texture space vectors.
+        tuVector.x = v2.TexCoord.x - v1.TexCoord.x;
+        tvVector.x = v2.TexCoord.y - v1.TexCoord.y;
+
+        tuVector.y = v3.TexCoord.x - v1.TexCoord.x;
+        tvVector.y = v3.TexCoord.y - v1.TexCoord.y;
+
+        // Calculate the denominator of the tangent/binormal equation.
+        float den = 1.0f / (tuVector.x * tvVector.y - tuVector.y * tvVector.x);
+
+        // Calculate the cross products and multiply by the coefficient to get the tangent and binormal.
+        tangent.x = (tvVector.y * vector1.x - tvVector.x * vector2.x) * den;
+        tangent.y = (tvVector.y * vector1.y - tvVector.x * vector2.y) * den;
+        tangent.z = (tvVector.y * vector1.z - tvVector.x * vector2.z) * den;
+
+        bitangent.x = (tuVector.x * vector2.x - tuVector.y * vector1.x) * den;
+        bitangent.y = (tuVector.x * vector2.y - tuVector.y * vector1.y) * den;
+        bitangent.z = (tuVector.x * vector2.z - tuVector.y * vector1.z) * den;
+
+        // Calculate the length of this normal.
+        float length = std::sqrt((tangent.x * tangent.x) + (tangent.y * tangent.y) + (tangent.z * tangent.z));
+
+        // Normalize the normal and then store it
+        tangent.x = tangent.x / length;
+        tangent.y = tangent.y / length;
+        tangent.z = tangent.z / length;
+
+        // Calculate the length of this normal.
+        length = std::sqrt((bitangent.x * bitangent.x) + (bitangent.y * bitangent.y) + (bitangent.z * bitangent.z));
+
+        // Normalize the normal and then store it
+        bitangent.x = bitangent.x / length;
+        bitangent.y = bitangent.y / length;
+        bitangent.z = bitangent.z / length;
+    }
+}
@@ -0,0 +1,41 @@
+/*+===================================================================
+  File:      TANGENTSPACE.H
+
+  Summary:   TangentSpace header file contains declaration of
+             TangentSpace class that computes the tangent and bitangent
+             vectors the normal maps are sampled along.
+
+  Classes: TangentSpace
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TangentSpace
+
+      Summary:  Computes the tangent and bitangent of the faces of an
+                indexed triangle list from their positions and texture
+                coordinates. It only uses DirectXMath, so the normal map
+                vectors of a renderable are computed without a device
+
+      Methods:  CalculateNormalMapVectors
+                  Computes the tangent and bitangent of every vertex
+                CalculateTangentBitangent
+                  Computes the tangent and bitangent of a face
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TangentSpace final
+    {
+    public:
+        TangentSpace() = delete;
+
+        static void CalculateNormalMapVectors(_In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices, _In_reads_(uNumIndices) const WORD* aIndices, _In_ UINT uNumIndices, _Out_ std::vector<NormalData>& aNormalData);
+        static void CalculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
+    };
+}
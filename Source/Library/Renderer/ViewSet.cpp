@@ -0,0 +1,420 @@
+#include "Renderer/ViewSet.h"
+
+#include <algorithm>
+#include <execution>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::ViewSet
+
+      Summary:  Constructor
+
+      Modifies: [m_aViews, m_aItems, m_aWorldBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ViewSet::ViewSet() :
+        m_aViews(),
+        m_aItems(),
+        m_aWorldBounds()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::AddView
+
+      Summary:  Adds a view whose matrices are the identity until
+                SetViewTransform is called
+
+      Args:     PCWSTR pszName
+                  Unique name of the view
+
+      Modifies: [m_aViews].
+
+      Returns:  UINT
+                  Index of the view, INVALID_VIEW if the name is taken
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::AddView(_In_ PCWSTR pszName)
+    {
+        if (FindView(pszName) != INVALID_VIEW)
+        {
+            return INVALID_VIEW;
+        }
+
+        m_aViews.push_back(
+            {
+                .szName = pszName,
+                .viewMatrix = XMMatrixIdentity(),
+                .projectionMatrix = XMMatrixIdentity(),
+                .aPlanes = {},
+                .aVisibleItems = {},
+                .aDepths = {},
+                .aVisibility = {}
+            }
+        );
+        UINT uView = static_cast<UINT>(m_aViews.size() - 1u);
+        SetViewTransform(uView, XMMatrixIdentity(), XMMatrixIdentity());
+
+        return uView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::RemoveView
+
+      Summary:  Removes a view. The views added after it move down by
+                one index
+
+      Args:     PCWSTR pszName
+                  Name of the view
+
+      Modifies: [m_aViews].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if there is no such view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ViewSet::RemoveView(_In_ PCWSTR pszName)
+    {
+        UINT uView = FindView(pszName);
+        if (uView == INVALID_VIEW)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aViews.erase(m_aViews.begin() + uView);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::FindView
+
+      Summary:  Returns the index of a view
+
+      Args:     PCWSTR pszName
+                  Name of the view
+
+      Returns:  UINT
+                  Index of the view, INVALID_VIEW if there is none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::FindView(_In_ PCWSTR pszName) const
+    {
+        for (UINT i = 0u; i < m_aViews.size(); ++i)
+        {
+            if (m_aViews[i].szName == pszName)
+            {
+                return i;
+            }
+        }
+
+        return INVALID_VIEW;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetNumViews
+
+      Summary:  Returns the number of views
+
+      Returns:  UINT
+                  Number of views
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::GetNumViews() const
+    {
+        return static_cast<UINT>(m_aViews.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetViewName
+
+      Summary:  Returns the name of a view
+
+      Args:     UINT uView
+                  Index of the view
+
+      Returns:  const std::wstring&
+                  Name of the view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::wstring& ViewSet::GetViewName(_In_ UINT uView) const
+    {
+        return m_aViews[uView].szName;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::SetViewTransform
+
+      Summary:  Sets the matrices of a view and extracts the six planes
+                of its frustum from their product. The planes point
+                inside the frustum, and the extraction works for
+                perspective and orthographic projections alike
+
+      Args:     UINT uView
+                  Index of the view
+                const XMMATRIX& view
+                  View matrix
+                const XMMATRIX& projection
+                  Projection matrix with the depth from 0 to 1
+
+      Modifies: [m_aViews].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ViewSet::SetViewTransform(_In_ UINT uView, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection)
+    {
+        View& target = m_aViews[uView];
+        target.viewMatrix = view;
+        target.projectionMatrix = projection;
+
+        // The rows of the transpose are the columns of the view projection matrix
+        XMMATRIX columns = XMMatrixTranspose(view * projection);
+        target.aPlanes[0] = XMPlaneNormalize(columns.r[3] + columns.r[0]);
+        target.aPlanes[1] = XMPlaneNormalize(columns.r[3] - columns.r[0]);
+        target.aPlanes[2] = XMPlaneNormalize(columns.r[3] + columns.r[1]);
+        target.aPlanes[3] = XMPlaneNormalize(columns.r[3] - columns.r[1]);
+        target.aPlanes[4] = XMPlaneNormalize(columns.r[2]);
+        target.aPlanes[5] = XMPlaneNormalize(columns.r[3] - columns.r[2]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetViewMatrix
+
+      Summary:  Returns the view matrix of a view
+
+      Args:     UINT uView
+                  Index of the view
+
+      Returns:  const XMMATRIX&
+                  View matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& ViewSet::GetViewMatrix(_In_ UINT uView) const
+    {
+        return m_aViews[uView].viewMatrix;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetProjectionMatrix
+
+      Summary:  Returns the projection matrix of a view
+
+      Args:     UINT uView
+                  Index of the view
+
+      Returns:  const XMMATRIX&
+                  Projection matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& ViewSet::GetProjectionMatrix(_In_ UINT uView) const
+    {
+        return m_aViews[uView].projectionMatrix;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::ClearItems
+
+      Summary:  Removes every item while keeping the allocated memory
+                for the next frame
+
+      Modifies: [m_aItems, m_aWorldBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ViewSet::ClearItems()
+    {
+        m_aItems.clear();
+        m_aWorldBounds.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::AddItem
+
+      Summary:  Adds an item that is culled with its bounds
+
+      Args:     const BoundingBox& localBounds
+                  Bounds of the item in its local space
+                const XMMATRIX& world
+                  World matrix of the item
+
+      Modifies: [m_aItems].
+
+      Returns:  UINT
+                  Index of the item
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::AddItem(_In_ const BoundingBox& localBounds, _In_ const XMMATRIX& world)
+    {
+        m_aItems.push_back({ .localBounds = localBounds, .world = world, .bBounded = TRUE });
+
+        return static_cast<UINT>(m_aItems.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::AddUnboundedItem
+
+      Summary:  Adds an item that is visible in every view. Its origin
+                orders it among the visible items
+
+      Args:     const XMMATRIX& world
+                  World matrix of the item
+
+      Modifies: [m_aItems].
+
+      Returns:  UINT
+                  Index of the item
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::AddUnboundedItem(_In_ const XMMATRIX& world)
+    {
+        m_aItems.push_back({ .localBounds = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f)), .world = world, .bBounded = FALSE });
+
+        return static_cast<UINT>(m_aItems.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetNumItems
+
+      Summary:  Returns the number of items
+
+      Returns:  UINT
+                  Number of items added since ClearItems
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ViewSet::GetNumItems() const
+    {
+        return static_cast<UINT>(m_aItems.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::TransformBounds
+
+      Summary:  Transforms the bounds of every item into world space in
+                parallel. Views fitted to the items, such as shadow
+                cascades, read the world bounds before Cull, which does
+                not transform them again until an item is added
+
+      Modifies: [m_aWorldBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ViewSet::TransformBounds()
+    {
+        m_aWorldBounds.resize(m_aItems.size());
+        std::transform(std::execution::par, m_aItems.begin(), m_aItems.end(), m_aWorldBounds.begin(),
+            [](const Item& item)
+            {
+                BoundingBox worldBounds;
+                item.localBounds.Transform(worldBounds, item.world);
+                return worldBounds;
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::Cull
+
+      Summary:  Transforms the bounds of every item into world space
+                once unless TransformBounds already did, then culls and
+                sorts the items of every view in parallel. Each view
+                only writes its own lists
+
+      Modifies: [m_aViews, m_aWorldBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ViewSet::Cull()
+    {
+        if (m_aWorldBounds.size() != m_aItems.size())
+        {
+            TransformBounds();
+        }
+
+        std::for_each(std::execution::par, m_aViews.begin(), m_aViews.end(), [this](View& view) { cullView(view); });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetWorldBounds
+
+      Summary:  Returns the world space bounds of an item computed by
+                the last TransformBounds or Cull
+
+      Args:     UINT uItem
+                  Index of the item
+
+      Returns:  const BoundingBox&
+                  World space bounds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingBox& ViewSet::GetWorldBounds(_In_ UINT uItem) const
+    {
+        return m_aWorldBounds[uItem];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::GetVisibleItems
+
+      Summary:  Returns the items of a view that passed the last Cull,
+                nearest first
+
+      Args:     UINT uView
+                  Index of the view
+
+      Returns:  const std::vector<UINT>&
+                  Indices of the visible items
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<UINT>& ViewSet::GetVisibleItems(_In_ UINT uView) const
+    {
+        return m_aViews[uView].aVisibleItems;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::IsVisible
+
+      Summary:  Returns whether an item passed the last Cull of a view
+
+      Args:     UINT uView
+                  Index of the view
+                UINT uItem
+                  Index of the item
+
+      Returns:  BOOL
+                  Whether the item is visible
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ViewSet::IsVisible(_In_ UINT uView, _In_ UINT uItem) const
+    {
+        const std::vector<BYTE>& aVisibility = m_aViews[uView].aVisibility;
+
+        return uItem < aVisibility.size() && aVisibility[uItem] != 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ViewSet::cullView
+
+      Summary:  Tests the world bounds of every item against the planes
+                of a view. A box is outside when it lies entirely behind
+                one of the planes. The visible items are ordered by the
+                view depth of their center, keeping the item order for
+                equal depths
+
+      Args:     View& view
+                  View to cull
+
+      Modifies: [view].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ViewSet::cullView(_Inout_ View& view) const
+    {
+        view.aVisibleItems.clear();
+        view.aDepths.resize(m_aItems.size());
+        view.aVisibility.assign(m_aItems.size(), 0u);
+
+        for (UINT i = 0u; i < m_aItems.size(); ++i)
+        {
+            XMVECTOR center = XMLoadFloat3(&m_aWorldBounds[i].Center);
+            if (m_aItems[i].bBounded)
+            {
+                XMVECTOR extents = XMLoadFloat3(&m_aWorldBounds[i].Extents);
+                BOOL bOutside = FALSE;
+                for (UINT uPlane = 0u; uPlane < ARRAYSIZE(view.aPlanes) && !bOutside; ++uPlane)
+                {
+                    FLOAT distance = XMVectorGetX(XMPlaneDotCoord(view.aPlanes[uPlane], center));
+                    FLOAT radius = XMVectorGetX(XMVector3Dot(extents, XMVectorAbs(view.aPlanes[uPlane])));
+                    bOutside = distance + radius < 0.0f;
+                }
+
+                if (bOutside)
+                {
+                    continue;
+                }
+            }
+
+            view.aVisibility[i] = 1u;
+            view.aDepths[i] = XMVectorGetZ(XMVector3Transform(center, view.viewMatrix));
+            view.aVisibleItems.push_back(i);
+        }
+
+        std::stable_sort(view.aVisibleItems.begin(), view.aVisibleItems.end(),
+            [&view](UINT uLeft, UINT uRight) { return view.aDepths[uLeft] < view.aDepths[uRight]; });
+    }
+}
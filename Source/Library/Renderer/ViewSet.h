@@ -0,0 +1,135 @@
+/*+===================================================================
+  File:      VIEWSET.H
+
+  Summary:   ViewSet header file contains declarations of ViewSet class
+             used to cull the items of a frame against several views,
+             such as the camera, the shadow casting light, split screen
+             players and the faces of cube map captures.
+
+  Classes: ViewSet
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ViewSet
+
+      Summary:  Holds the views of a frame and the items drawn in them.
+                Every item is added once per frame with its local
+                bounds and world matrix. Culling first transforms the
+                bounds of every item into world space, which is shared
+                by all views, and then tests the items against the
+                frustum of every view in parallel. The visible items of
+                each view are ordered front to back. Items without
+                bounds, such as skinned models whose animated pose
+                leaves the bind pose bounds, are visible in every view.
+                Views are identified by their index, removing a view
+                moves the views added after it down by one. The view
+                set does not touch Direct3D
+
+      Methods:  AddView
+                  Adds a view with a unique name
+                RemoveView
+                  Removes a view
+                FindView
+                  Returns the index of a view
+                GetNumViews
+                  Returns the number of views
+                GetViewName
+                  Returns the name of a view
+                SetViewTransform
+                  Sets the view and projection matrices of a view
+                GetViewMatrix
+                  Returns the view matrix of a view
+                GetProjectionMatrix
+                  Returns the projection matrix of a view
+                ClearItems
+                  Removes every item of the previous frame
+                AddItem
+                  Adds an item culled with its bounds
+                AddUnboundedItem
+                  Adds an item that is never culled
+                GetNumItems
+                  Returns the number of items
+                TransformBounds
+                  Computes the world space bounds of every item
+                Cull
+                  Computes the visible items of every view
+                GetWorldBounds
+                  Returns the world space bounds of an item
+                GetVisibleItems
+                  Returns the visible items of a view front to back
+                IsVisible
+                  Returns whether an item is visible in a view
+                ViewSet
+                  Constructor.
+                ~ViewSet
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ViewSet final
+    {
+    public:
+        static constexpr const UINT INVALID_VIEW = (0xFFFFFFFF);
+
+    public:
+        ViewSet();
+        ViewSet(const ViewSet& other) = delete;
+        ViewSet(ViewSet&& other) = delete;
+        ViewSet& operator=(const ViewSet& other) = delete;
+        ViewSet& operator=(ViewSet&& other) = delete;
+        ~ViewSet() = default;
+
+        UINT AddView(_In_ PCWSTR pszName);
+        HRESULT RemoveView(_In_ PCWSTR pszName);
+        UINT FindView(_In_ PCWSTR pszName) const;
+        UINT GetNumViews() const;
+        const std::wstring& GetViewName(_In_ UINT uView) const;
+
+        void SetViewTransform(_In_ UINT uView, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+        const XMMATRIX& GetViewMatrix(_In_ UINT uView) const;
+        const XMMATRIX& GetProjectionMatrix(_In_ UINT uView) const;
+
+        void ClearItems();
+        UINT AddItem(_In_ const BoundingBox& localBounds, _In_ const XMMATRIX& world);
+        UINT AddUnboundedItem(_In_ const XMMATRIX& world);
+        UINT GetNumItems() const;
+
+        void TransformBounds();
+        void Cull();
+
+        const BoundingBox& GetWorldBounds(_In_ UINT uItem) const;
+        const std::vector<UINT>& GetVisibleItems(_In_ UINT uView) const;
+        BOOL IsVisible(_In_ UINT uView, _In_ UINT uItem) const;
+
+    private:
+        struct View
+        {
+            std::wstring szName;
+            XMMATRIX viewMatrix;
+            XMMATRIX projectionMatrix;
+            XMVECTOR aPlanes[6];
+            std::vector<UINT> aVisibleItems;
+            std::vector<FLOAT> aDepths;
+            std::vector<BYTE> aVisibility;
+        };
+
+        struct Item
+        {
+            BoundingBox localBounds;
+            XMMATRIX world;
+            BOOL bBounded;
+        };
+
+        void cullView(_Inout_ View& view) const;
+
+    private:
+        std::vector<View> m_aViews;
+        std::vector<Item> m_aItems;
+        std::vector<BoundingBox> m_aWorldBounds;
+    };
+}
@@ -0,0 +1,196 @@
+#include "Scene/HeightMap.h"
+
+#include <fstream>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::HeightMap
+
+      Summary:  Constructor
+
+      Modifies: [m_aColors, m_aaInstanceData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightMap::HeightMap() :
+        m_aColors(),
+        m_aaInstanceData()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::Read
+
+      Summary:  Reads the colors of the block types and stacks every
+                column of the file into blocks of its type, skipping
+                the words that are not numbers and the columns of an
+                unknown block type
+
+      Args:     const std::filesystem::path& filePath
+                  Path of the height map file
+
+      Modifies: [m_aColors, m_aaInstanceData].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the file can not be opened
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::Read(_In_ const std::filesystem::path& filePath)
+    {
+        m_aColors.clear();
+        m_aaInstanceData.clear();
+
+        std::ifstream inputFile;
+        inputFile.open(filePath.string());
+        if (!inputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        std::string trash;
+        UINT aDimension[4] = { 0u, };
+        UINT uDimensionIdx = 0u;
+        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
+        {
+            inputFile >> aDimension[uDimensionIdx];
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else
+            {
+                ++uDimensionIdx;
+            }
+        }
+
+        XMFLOAT4 color;
+        while (!inputFile.eof() && m_aColors.size() < aDimension[3])
+        {
+            inputFile >> color.x >> color.y >> color.z;
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else
+            {
+                color.w = 1.0f;
+                m_aColors.push_back(color);
+            }
+        }
+
+        m_aaInstanceData.resize(m_aColors.size());
+        for (std::vector<InstanceData>& aInstanceData : m_aaInstanceData)
+        {
+            aInstanceData.reserve(
+                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
+            );
+        }
+
+        UINT uDepthIdx = 0u;
+        UINT uWidthIdx = 0u;
+        CHAR voxelType;
+        FLOAT height;
+        while (!inputFile.eof())
+        {
+            inputFile >> voxelType >> height;
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
+            {
+                size_t uTypeIdx = static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND);
+                for (UINT heightIdx = 0; uTypeIdx < m_aaInstanceData.size() && heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
+                {
+                    m_aaInstanceData[uTypeIdx].push_back(
+                        InstanceData
+                        {
+                            .Transformation = XMMatrixTranslation(
+                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
+                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
+                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
+                                )
+                        }
+                    );
+                }
+                ++uWidthIdx;
+                if (uWidthIdx >= aDimension[0])
+                {
+                    uWidthIdx -= aDimension[0];
+                    ++uDepthIdx;
+
+                    if (uDepthIdx >= aDimension[2])
+                    {
+                        uDepthIdx -= aDimension[2];
+                    }
+                }
+            }
+        }
+
+        inputFile.close();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetColors
+
+      Summary:  Returns the color of every block type read
+
+      Returns:  const std::vector<XMFLOAT4>&
+                  Colors, in the order of the block types
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<XMFLOAT4>& HeightMap::GetColors() const
+    {
+        return m_aColors;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetInstanceData
+
+      Summary:  Returns the blocks of every block type read, which the
+                scene moves into its voxels
+
+      Returns:  std::vector<std::vector<InstanceData>>&
+                  Transformations of the blocks, a vector per color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::vector<InstanceData>>& HeightMap::GetInstanceData()
+    {
+        return m_aaInstanceData;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetNumInstances
+
+      Summary:  Returns the number of blocks of every block type
+
+      Returns:  size_t
+                  Number of blocks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t HeightMap::GetNumInstances() const
+    {
+        size_t uNumInstances = 0u;
+        for (const std::vector<InstanceData>& aInstanceData : m_aaInstanceData)
+        {
+            uNumInstances += aInstanceData.size();
+        }
+
+        return uNumInstances;
+    }
+}
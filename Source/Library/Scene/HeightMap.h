@@ -0,0 +1,63 @@
+/*+===================================================================
+  File:      HEIGHTMAP.H
+
+  Summary:   HeightMap header file contains declaration of HeightMap
+             class that reads the height map file of a scene into the
+             instances of its voxels.
+
+  Classes: HeightMap
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    HeightMap
+
+      Summary:  Reads a height map file: its width, height and depth,
+                the number of block types, a color per block type, then
+                a block type and a height for every column. Every column
+                is stacked into blocks of its type, and the blocks of a
+                type become the instances of a voxel of its color. It
+                creates no Direct3D objects
+
+      Methods:  Read
+                  Reads a height map file
+                GetColors
+                  Returns the color of every block type
+                GetInstanceData
+                  Returns the blocks of every block type
+                GetNumInstances
+                  Returns the number of blocks
+                HeightMap
+                  Constructor.
+                ~HeightMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class HeightMap final
+    {
+    public:
+        HeightMap();
+        HeightMap(const HeightMap& other) = delete;
+        HeightMap(HeightMap&& other) = delete;
+        HeightMap& operator=(const HeightMap& other) = delete;
+        HeightMap& operator=(HeightMap&& other) = delete;
+        ~HeightMap() = default;
+
+        HRESULT Read(_In_ const std::filesystem::path& filePath);
+
+        const std::vector<XMFLOAT4>& GetColors() const;
+        std::vector<std::vector<InstanceData>>& GetInstanceData();
+        size_t GetNumInstances() const;
+
+    private:
+        std::vector<XMFLOAT4> m_aColors;
+        std::vector<std::vector<InstanceData>> m_aaInstanceData;
+    };
+}
@@ -0,0 +1,77 @@
+#include "Scene/PerlinNoise.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::Get2d
+
+      Summary:  Sums octaves of noise, each of twice the frequency and
+                half the amplitude of the previous one
+
+      Args:     FLOAT x
+                  X coordinate of the point
+                FLOAT y
+                  Y coordinate of the point
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise between 0 and 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PerlinNoise::Get2d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth)
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0; i < uDepth; ++i)
+        {
+            div += 256.0f * amp;
+            fin += getNoise2d(xa, ya) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    FLOAT PerlinNoise::getNoise2(_In_ UINT x, _In_ UINT y)
+    {
+        UINT temp = ms_aHashes[y % 256u];
+
+        return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
+    }
+
+    FLOAT PerlinNoise::getNoise2d(_In_ FLOAT x, _In_ FLOAT y)
+    {
+        UINT uX = static_cast<UINT>(x);
+        UINT uY = static_cast<UINT>(y);
+        FLOAT xFrac = x - static_cast<FLOAT>(uX);
+        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+
+        UINT s = static_cast<UINT>(getNoise2(uX, uY));
+        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
+        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
+        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+
+        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
+        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+
+        return smoothLerp(low, high, yFrac);
+    }
+
+    FLOAT PerlinNoise::lerp(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT s)
+    {
+        return x + s * (y - x);
+    }
+
+    FLOAT PerlinNoise::smoothLerp(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT s)
+    {
+        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+    }
+}
@@ -1,159 +1,43 @@
 #include "Scene/Scene.h"
 
+#include <algorithm>
+
+#include "Profiler/Profiler.h"
+#include "Scene/HeightMap.h"
+#include "Scene/PerlinNoise.h"
 #include "Shader/SkyMapVertexShader.h"
 
 namespace library
 {
     FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
     {
-        FLOAT xa = x * frequency;
-        FLOAT ya = y * frequency;
-        FLOAT amp = 1.0f;
-        FLOAT fin = 0.0f;
-        FLOAT div = 0.0f;
-
-        for (UINT i = 0; i < uDepth; ++i)
-        {
-            div += 256.0f * amp;
-            fin += getNoise2d(xa, ya) * amp;
-            amp /= 2.0f;
-            xa *= 2.0f;
-            ya *= 2.0f;
-        }
-
-        return fin / div;
+        return PerlinNoise::Get2d(x, y, frequency, uDepth);
     }
 
     Scene::Scene(const std::filesystem::path& filePath)
         : m_filePath(filePath)
         , m_voxels()
         , m_renderables()
-        , m_aPointLights{ nullptr }
+        , m_aUpdatedModels()
+        , m_poseCache(std::make_shared<PoseCache>(POSE_CACHE_TIME_TOLERANCE))
+        , m_aPointLights()
         , m_vertexShaders()
         , m_pixelShaders()
         , m_materials()
         , m_skyBox()
     {
-        std::ifstream inputFile;
-        inputFile.open(m_filePath.string());
-
-        std::string trash;
-        UINT aDimension[4] = { 0u, };
-        UINT uDimensionIdx = 0u;
-        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
-        {
-            inputFile >> aDimension[uDimensionIdx];
-
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                ++uDimensionIdx;
-            }
-        }
-
-        UINT uColorIdx = 0u;
-        XMFLOAT4 color;
-        while (!inputFile.eof() && uColorIdx < aDimension[3])
-        {
-            inputFile >> color.x >> color.y >> color.z;
-
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
-                ++uColorIdx;
-            }
-        }
-
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
-        {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
-        }
-
-        UINT uDepthIdx = 0u;
-        UINT uWidthIdx = 0u;
-        CHAR voxelType;
-        FLOAT height;
-        while (!inputFile.eof())
-        {
-            inputFile >> voxelType >> height;
+        // A file that can not be read leaves the scene without voxels
+        HeightMap heightMap;
+        heightMap.Read(m_filePath);
 
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
-            {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
-                {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
-                        InstanceData
-                        {
-                            .Transformation = XMMatrixTranslation(
-                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
-                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
-                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
-                                )
-                        }
-                    );
-                }
-                ++uWidthIdx;
-                if (uWidthIdx >= aDimension[0])
-                {
-                    uWidthIdx -= aDimension[0];
-                    ++uDepthIdx;
-
-                    if (uDepthIdx >= aDimension[2])
-                    {
-                        uDepthIdx -= aDimension[2];
-                    }
-                }
-            }
-        }
-
-        inputFile.close();
-
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
+        const std::vector<XMFLOAT4>& aColors = heightMap.GetColors();
+        std::vector<std::vector<InstanceData>>& aaInstanceData = heightMap.GetInstanceData();
+        for (size_t uColorIdx = 0u; uColorIdx < aColors.size(); ++uColorIdx)
         {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
-            {
-                it = m_voxels.erase(it);
-            }
-            else
+            if (!aaInstanceData[uColorIdx].empty())
             {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
+                m_voxels.push_back(std::make_shared<Voxel>(std::move(aaInstanceData[uColorIdx]), aColors[uColorIdx]));
             }
-            ++uVoxelIdx;
         }
     }
 
@@ -161,7 +45,8 @@ namespace library
       Method:   Scene::Initialize
 
       Summary:  Initializes the voxels, shaders, renderables, models,
-                and skybox
+                and skybox, and merges the static renderables into
+                static batches
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
@@ -170,6 +55,8 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
     {
+        PROFILE_SCOPE("Scene", "Initialize");
+
         for (auto voxel : m_voxels)
         {
             HRESULT hr = voxel->Initialize(pDevice, pImmediateContext);
@@ -208,6 +95,7 @@ namespace library
 
         for (auto it = m_models.begin(); it != m_models.end(); ++it)
         {
+            PROFILE_SCOPE("Scene", "LoadModel");
             HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
@@ -222,6 +110,7 @@ namespace library
 
         for (auto it = m_materials.begin(); it != m_materials.end(); ++it)
         {
+            PROFILE_SCOPE("Scene", "LoadTextures");
             HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
@@ -238,7 +127,7 @@ namespace library
             }
         }
 
-        return S_OK;
+        return buildStaticBatches(pDevice, pImmediateContext);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -291,14 +180,17 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddModel
 
-      Summary:  Add a model object
+      Summary:  Add a model object, sharing its poses through the pose
+                cache of the scene. The index of the model is its update
+                phase, so the models of a level of detail update their
+                bones in turns
 
       Args:     PCWSTR pszModelName
                   Key of the renderable object
                 const std::shared_ptr<Model>& model
                   Shared pointer to the model object
 
-      Modifies: [m_models].
+      Modifies: [m_models, m_aUpdatedModels].
 
       Returns:  HRESULT
                   Status code.
@@ -311,6 +203,9 @@ namespace library
         }
 
         m_models[pszModelName] = pModel;
+        pModel->SetUpdatePhase(static_cast<UINT>(m_aUpdatedModels.size()));
+        m_aUpdatedModels.push_back(pModel);
+        pModel->SetPoseCache(m_poseCache);
 
         return S_OK;
     }
@@ -318,11 +213,11 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddPointLight
 
-      Summary:  Add a point light object
+      Summary:  Add a point light object. The first light added casts
+                the shadow and lights every pixel, the lights after it
+                only light the pixels inside their attenuation distance
 
-      Args:     size_t index
-                  Index of the point light
-                const std::shared_ptr<PointLight>& pointLight
+      Args:     const std::shared_ptr<PointLight>& pointLight
                   Shared pointer to the point light object
 
       Modifies: [m_aPointLights].
@@ -330,16 +225,16 @@ namespace library
       Returns:  HRESULT
                   Status code.
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Scene::AddPointLight(_In_ size_t index, _In_ const std::shared_ptr<PointLight>& pPointLight)
+    HRESULT Scene::AddPointLight(_In_ const std::shared_ptr<PointLight>& pPointLight)
     {
         HRESULT hr = S_OK;
 
-        if (index >= NUM_LIGHTS)
+        if (!pPointLight)
         {
             return E_FAIL;
         }
 
-        m_aPointLights[index] = pPointLight;
+        m_aPointLights.push_back(pPointLight);
 
         return hr;
     }
@@ -440,26 +335,39 @@ namespace library
       Method:   Scene::Update
 
       Summary:  Update the renderables, models, point lights, skybox
-                each frame
-
-      Args:     FLOAT deltaTime
+                each frame. Every model animates only its own pose and
+                bone transforms, so the models are updated in parallel
+                on the thread pool of the caller, a few models per job,
+                and the bone transforms are complete when the update
+                returns. The poses no model used during the last frame
+                are evicted from the pose cache first
+
+      Args:     ThreadPool& threadPool
+                  Pool running the model updates
+                FLOAT deltaTime
                   Time difference of a frame
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Scene::Update(_In_ FLOAT deltaTime)
+    void Scene::Update(_Inout_ ThreadPool& threadPool, _In_ FLOAT deltaTime)
     {
+        PROFILE_SCOPE("Scene", "Update");
+
         for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
         {
             it->second->Update(deltaTime);
         }
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        m_poseCache->BeginFrame();
+        threadPool.ParallelFor(static_cast<UINT>(m_aUpdatedModels.size()), MODELS_PER_JOB, [this, deltaTime](UINT uBegin, UINT uEnd)
         {
-            it->second->Update(deltaTime);
-        }
+            for (UINT i = uBegin; i < uEnd; ++i)
+            {
+                m_aUpdatedModels[i]->Update(deltaTime);
+            }
+        });
 
-        for (UINT lightIdx = 0; lightIdx < NUM_LIGHTS; ++lightIdx)
+        for (std::shared_ptr<PointLight>& pointLight : m_aPointLights)
         {
-            m_aPointLights[lightIdx]->Update(deltaTime);
+            pointLight->Update(deltaTime);
         }
 
         if (m_skyBox != nullptr)
@@ -508,6 +416,19 @@ namespace library
         return m_models;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPoseCache
+
+      Summary:  Returns the cache sharing the poses of the models
+
+      Returns:  PoseCache&
+                  Pose cache
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PoseCache& Scene::GetPoseCache()
+    {
+        return *m_poseCache;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetPointLight
 
@@ -521,11 +442,24 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     std::shared_ptr<PointLight>& Scene::GetPointLight(_In_ size_t index)
     {
-        assert(index < NUM_LIGHTS);
+        assert(index < m_aPointLights.size());
 
         return m_aPointLights[index];
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetNumPointLights
+
+      Summary:  Returns the number of point lights
+
+      Returns:  UINT
+                  Number of point lights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Scene::GetNumPointLights() const
+    {
+        return static_cast<UINT>(m_aPointLights.size());
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVertexShaders
 
@@ -559,6 +493,20 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetStaticBatches
+
+      Summary:  Returns the static batches built from the static
+                renderables
+
+      Returns:  std::vector<std::shared_ptr<StaticBatch>>&
+                  Static batches
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::shared_ptr<StaticBatch>>& Scene::GetStaticBatches()
+    {
+        return m_staticBatches;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetSkyBox
 
@@ -781,38 +729,74 @@ namespace library
         return S_OK;
     }
 
-    FLOAT Scene::getNoise2(UINT x, UINT y)
-    {
-        UINT temp = ms_aHashes[y % 256u];
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildStaticBatches
 
-        return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
-    }
+      Summary:  Merges the initialized static renderables into static
+                batches. Renderables are visited in the order of their
+                names so the batches are identical on every run, and
+                each one joins the first batch it is compatible with
 
-    FLOAT Scene::getNoise2d(FLOAT x, FLOAT y)
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_staticBatches, m_renderables].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::buildStaticBatches(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
     {
-        UINT uX = static_cast<UINT>(x);
-        UINT uY = static_cast<UINT>(y);
-        FLOAT xFrac = x - static_cast<FLOAT>(uX);
-        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+        m_staticBatches.clear();
 
-        UINT s = static_cast<UINT>(getNoise2(uX, uY));
-        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
-        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
-        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+        std::vector<std::wstring> aStaticNames;
+        for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
+        {
+            if (it->second->IsStatic())
+            {
+                aStaticNames.push_back(it->first);
+            }
+        }
+        std::sort(aStaticNames.begin(), aStaticNames.end());
 
-        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
-        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+        for (const std::wstring& szName : aStaticNames)
+        {
+            const std::shared_ptr<Renderable>& renderable = m_renderables[szName];
 
-        return smoothLerp(low, high, yFrac);
-    }
+            auto it = std::find_if(m_staticBatches.begin(), m_staticBatches.end(),
+                [&renderable](const std::shared_ptr<StaticBatch>& batch) { return batch->CanAppend(*renderable); });
+            if (it == m_staticBatches.end())
+            {
+                std::shared_ptr<StaticBatch> batch = std::make_shared<StaticBatch>(*renderable);
+                if (!batch->CanAppend(*renderable))
+                {
+                    // Too large for 16-bit indices, keep drawing it on its own
+                    renderable->SetStatic(FALSE);
+                    continue;
+                }
 
-    FLOAT Scene::lerp(FLOAT x, FLOAT y, FLOAT s)
-    {
-        return x + s * (y - x);
-    }
+                m_staticBatches.push_back(batch);
+                it = m_staticBatches.end() - 1;
+            }
 
-    FLOAT Scene::smoothLerp(FLOAT x, FLOAT y, FLOAT s)
-    {
-        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+            HRESULT hr = (*it)->Append(*renderable);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        for (std::shared_ptr<StaticBatch>& batch : m_staticBatches)
+        {
+            HRESULT hr = batch->Initialize(pDevice, pImmediateContext);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        return S_OK;
     }
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      BAKEDSKINNINGVERTEXSHADER.H
+
+  Summary:   BakedSkinningVertexShader header file contains
+             declarations of BakedSkinningVertexShader class that skins
+             instanced models from the frames of a baked animation.
+
+  Classes: BakedSkinningVertexShader
+
+  2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    class BakedSkinningVertexShader : public VertexShader
+    {
+    public:
+        BakedSkinningVertexShader() = delete;
+        BakedSkinningVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        BakedSkinningVertexShader(const BakedSkinningVertexShader& other) = delete;
+        BakedSkinningVertexShader(BakedSkinningVertexShader&& other) = delete;
+        BakedSkinningVertexShader& operator=(const BakedSkinningVertexShader& other) = delete;
+        BakedSkinningVertexShader& operator=(BakedSkinningVertexShader&& other) = delete;
+        virtual ~BakedSkinningVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+    };
+}
\ No newline at end of file
@@ -4,6 +4,7 @@ namespace library
 {
     ShadowVertexShader::ShadowVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel)
         : VertexShader(pszFileName, pszEntryPoint, pszShaderModel)
+        , m_quantizedVertexLayout(nullptr)
     {
     }
 
@@ -34,14 +35,14 @@ namespace library
             return hr;
         }
 
-        // Define the input layout
+        // Define the input layout, positions come from the position stream of the renderables
         D3D11_INPUT_ELEMENT_DESC aLayouts[] =
         {
             { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "INSTANCE_TRANSFORM", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "INSTANCE_TRANSFORM", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
         };
         UINT uNumElements = ARRAYSIZE(aLayouts);
 
@@ -52,6 +53,19 @@ namespace library
             return hr;
         }
 
+        // Quantized positions are normalized by the input assembler and restored by the shader
+        aLayouts[0].Format = DXGI_FORMAT_R16G16B16A16_SNORM;
+        hr = pDevice->CreateInputLayout(aLayouts, uNumElements, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_quantizedVertexLayout.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
         return hr;
     }
+
+    ComPtr<ID3D11InputLayout>& ShadowVertexShader::GetQuantizedVertexLayout()
+    {
+        return m_quantizedVertexLayout;
+    }
 }
\ No newline at end of file
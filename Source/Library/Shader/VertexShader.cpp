@@ -72,6 +72,7 @@ namespace library
 
         //m_immediateContext->IASetInputLayout(m_vertexLayout.Get());
 
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -7,12 +7,31 @@ namespace library
 
 	  Summary:  Constructor
 
-	  Modifies: [m_uWidth, m_uHeight, m_texture2D, m_renderTargetView,
-				 m_shaderResourceView, m_samplerClamp].
+	  Modifies: [m_uWidth, m_uHeight, m_format, m_texture2D,
+				 m_renderTargetView, m_shaderResourceView, m_samplerClamp].
 	M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 	RenderTexture::RenderTexture(_In_ UINT uWidth, _In_ UINT uHeight):
+		RenderTexture(uWidth, uHeight, DXGI_FORMAT_R32G32B32A32_FLOAT)
+	{}
+
+
+	/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+	  Method:   RenderTexture::RenderTexture
+
+	  Summary:  Constructor
+
+	  Args:     UINT uWidth
+				UINT uHeight
+				DXGI_FORMAT format
+				  Format of the texture and its views
+
+	  Modifies: [m_uWidth, m_uHeight, m_format, m_texture2D,
+				 m_renderTargetView, m_shaderResourceView, m_samplerClamp].
+	M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+	RenderTexture::RenderTexture(_In_ UINT uWidth, _In_ UINT uHeight, _In_ DXGI_FORMAT format):
 		m_uWidth(uWidth),
 		m_uHeight(uHeight),
+		m_format(format),
 		m_texture2D(nullptr),
 		m_renderTargetView(nullptr),
 		m_shaderResourceView(nullptr),
@@ -44,7 +63,7 @@ namespace library
 			.Height = m_uHeight,
 			.MipLevels = 1,
 			.ArraySize = 1,
-			.Format = DXGI_FORMAT_R32G32B32A32_FLOAT,
+			.Format = m_format,
 			.SampleDesc = {.Count = 1},
 			.Usage = D3D11_USAGE_DEFAULT,
 			.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE,
@@ -88,7 +107,10 @@ namespace library
 			.MaxLOD = D3D11_FLOAT32_MAX
 		};
 		hr = pDevice->CreateSamplerState(&sampDesc, m_samplerClamp.GetAddressOf());
-		
+		if (FAILED(hr))
+			return hr;
+
+		return S_OK;
 	}
 
 
@@ -112,4 +134,19 @@ namespace library
 		return m_samplerClamp;
 	}
 
+	UINT RenderTexture::GetWidth() const
+	{
+		return m_uWidth;
+	}
+
+	UINT RenderTexture::GetHeight() const
+	{
+		return m_uHeight;
+	}
+
+	DXGI_FORMAT RenderTexture::GetFormat() const
+	{
+		return m_format;
+	}
+
 }
\ No newline at end of file
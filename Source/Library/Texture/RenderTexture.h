@@ -19,6 +19,7 @@ namespace library
 	public:
 		RenderTexture() = delete;
 		RenderTexture(_In_ UINT uWidth, _In_ UINT uHeight);
+		RenderTexture(_In_ UINT uWidth, _In_ UINT uHeight, _In_ DXGI_FORMAT format);
 		RenderTexture(const RenderTexture& other) = delete;
 		RenderTexture(RenderTexture&& other) = delete;
 		RenderTexture& operator=(const RenderTexture& other) = delete;
@@ -31,10 +32,14 @@ namespace library
 		ComPtr<ID3D11RenderTargetView>& GetRenderTargetView();
 		ComPtr<ID3D11ShaderResourceView>& GetShaderResourceView();
 		ComPtr<ID3D11SamplerState>& GetSamplerState();
+		UINT GetWidth() const;
+		UINT GetHeight() const;
+		DXGI_FORMAT GetFormat() const;
 
 	private:
 		UINT m_uWidth;
 		UINT m_uHeight;
+		DXGI_FORMAT m_format;
 
 		ComPtr<ID3D11Texture2D> m_texture2D;
 		ComPtr<ID3D11RenderTargetView> m_renderTargetView;
@@ -0,0 +1,185 @@
+#include "Thread/ThreadPool.h"
+
+#include "Profiler/Profiler.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::ThreadPool
+
+      Summary:  Constructor, starts the worker threads
+
+      Args:     UINT uNumWorkers
+                  Number of worker threads, the calling thread of
+                  ParallelFor runs jobs too, so 0 runs every job on it
+
+      Modifies: [m_aWorkers, m_mutex, m_dispatched, m_finished, m_pJob,
+                 m_uNumItems, m_uItemsPerJob, m_uNextItem,
+                 m_uNumBusyWorkers, m_uDispatch, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ThreadPool::ThreadPool(_In_ UINT uNumWorkers) :
+        m_aWorkers(),
+        m_mutex(),
+        m_dispatched(),
+        m_finished(),
+        m_pJob(nullptr),
+        m_uNumItems(0u),
+        m_uItemsPerJob(1u),
+        m_uNextItem(0u),
+        m_uNumBusyWorkers(0u),
+        m_uDispatch(0u),
+        m_bStopping(FALSE)
+    {
+        m_aWorkers.reserve(uNumWorkers);
+        for (UINT i = 0u; i < uNumWorkers; ++i)
+        {
+            m_aWorkers.emplace_back(&ThreadPool::runWorker, this);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::~ThreadPool
+
+      Summary:  Destructor, wakes the worker threads to stop and waits
+                for them
+
+      Modifies: [m_aWorkers, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = TRUE;
+        }
+        m_dispatched.notify_all();
+
+        for (std::thread& worker : m_aWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::ParallelFor
+
+      Summary:  Splits the items into ranges and runs a job over every
+                range on the workers and the calling thread, then waits
+                for every worker to finish. A loop that fits in one
+                range runs on the calling thread without waking the
+                workers
+
+      Args:     UINT uNumItems
+                  Number of items
+                UINT uItemsPerJob
+                  Number of items of a range, the last range may be
+                  shorter
+                const std::function<void(UINT uBegin, UINT uEnd)>& job
+                  Job run over the items from uBegin to before uEnd
+
+      Modifies: [m_pJob, m_uNumItems, m_uItemsPerJob, m_uNextItem,
+                 m_uNumBusyWorkers, m_uDispatch].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::ParallelFor(_In_ UINT uNumItems, _In_ UINT uItemsPerJob, _In_ const std::function<void(UINT uBegin, UINT uEnd)>& job)
+    {
+        uItemsPerJob = uItemsPerJob > 0u ? uItemsPerJob : 1u;
+        if (uNumItems == 0u)
+        {
+            return;
+        }
+        if (m_aWorkers.empty() || uNumItems <= uItemsPerJob)
+        {
+            job(0u, uNumItems);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pJob = &job;
+            m_uNumItems = uNumItems;
+            m_uItemsPerJob = uItemsPerJob;
+            m_uNextItem.store(0u, std::memory_order_relaxed);
+            m_uNumBusyWorkers = static_cast<UINT>(m_aWorkers.size());
+            ++m_uDispatch;
+        }
+        m_dispatched.notify_all();
+
+        runJobs();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this] { return m_uNumBusyWorkers == 0u; });
+        m_pJob = nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::GetNumThreads
+
+      Summary:  Returns the number of threads running the jobs, the
+                workers and the calling thread
+
+      Returns:  UINT
+                  Number of threads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ThreadPool::GetNumThreads() const
+    {
+        return static_cast<UINT>(m_aWorkers.size()) + 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::runJobs
+
+      Summary:  Takes ranges of the items from the shared counter and
+                runs the job over them until no range is left
+
+      Modifies: [m_uNextItem].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::runJobs()
+    {
+        PROFILE_SCOPE("ThreadPool", "RunJobs");
+
+        for (;;)
+        {
+            UINT uBegin = m_uNextItem.fetch_add(m_uItemsPerJob, std::memory_order_relaxed);
+            if (uBegin >= m_uNumItems)
+            {
+                break;
+            }
+
+            UINT uEnd = m_uNumItems - uBegin > m_uItemsPerJob ? uBegin + m_uItemsPerJob : m_uNumItems;
+            (*m_pJob)(uBegin, uEnd);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::runWorker
+
+      Summary:  Loop of a worker thread, which sleeps until a loop is
+                dispatched, runs jobs until no range is left and tells
+                the calling thread when the last worker is done
+
+      Modifies: [m_uNumBusyWorkers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::runWorker()
+    {
+        UINT64 uDispatch = 0u;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_dispatched.wait(lock, [this, uDispatch] { return m_bStopping || m_uDispatch != uDispatch; });
+                if (m_bStopping)
+                {
+                    return;
+                }
+                uDispatch = m_uDispatch;
+            }
+
+            runJobs();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_uNumBusyWorkers == 0u)
+            {
+                m_finished.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*+===================================================================
+  File:      THREADPOOL.H
+
+  Summary:   ThreadPool header file contains declarations of ThreadPool
+             class that splits a loop into jobs run by worker threads
+             and the calling thread.
+
+  Classes: ThreadPool
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ThreadPool
+
+      Summary:  Worker threads that sleep until a loop is dispatched.
+                ParallelFor wakes every worker, and the workers and the
+                calling thread take ranges of the items from a shared
+                counter until none is left, so a thread that finishes
+                early takes more ranges. ParallelFor returns only once
+                every worker has finished, which is the sync point
+                after which the results of every range can be read
+                without a lock. Which thread runs a range changes from
+                call to call, so the jobs must not depend on it and
+                must not write the same data
+
+      Methods:  ParallelFor
+                  Runs a job over every range of items and waits
+                GetNumThreads
+                  Returns the number of threads running the jobs
+                ThreadPool
+                  Constructor.
+                ~ThreadPool
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ThreadPool final
+    {
+    public:
+        ThreadPool() = delete;
+        ThreadPool(_In_ UINT uNumWorkers);
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool(ThreadPool&& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        ThreadPool& operator=(ThreadPool&& other) = delete;
+        ~ThreadPool();
+
+        void ParallelFor(_In_ UINT uNumItems, _In_ UINT uItemsPerJob, _In_ const std::function<void(UINT uBegin, UINT uEnd)>& job);
+
+        UINT GetNumThreads() const;
+
+    private:
+        void runJobs();
+        void runWorker();
+
+    private:
+        std::vector<std::thread> m_aWorkers;
+        std::mutex m_mutex;
+        std::condition_variable m_dispatched;
+        std::condition_variable m_finished;
+        const std::function<void(UINT, UINT)>* m_pJob;
+        UINT m_uNumItems;
+        UINT m_uItemsPerJob;
+        std::atomic<UINT> m_uNextItem;
+        UINT m_uNumBusyWorkers;
+        UINT64 m_uDispatch;
+        BOOL m_bStopping;
+    };
+}
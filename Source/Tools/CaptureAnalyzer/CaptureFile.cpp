@@ -0,0 +1,107 @@
+#include "CaptureFile.h"
+
+#include <fstream>
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureFile::Load
+
+  Summary:  Reads the names and commands of a capture file. The file
+            is written on little endian machines, so it is read as is
+
+  Args:     const std::filesystem::path& filePath
+              Path of the capture file
+            std::string& error
+              Receives the reason when the file cannot be read
+
+  Modifies: [m_aNames, m_aCommands].
+
+  Returns:  bool
+              Whether the file was read
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CaptureFile::Load(const std::filesystem::path& filePath, std::string& error)
+{
+    m_aNames.clear();
+    m_aCommands.clear();
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        error = "cannot open " + filePath.string();
+        return false;
+    }
+
+    library::CaptureFileHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.uMagic != library::CAPTURE_FILE_MAGIC)
+    {
+        error = filePath.string() + " is not a frame capture";
+        return false;
+    }
+    if (header.uVersion != library::CAPTURE_FILE_VERSION)
+    {
+        error = filePath.string() + " has capture version " + std::to_string(header.uVersion) +
+            ", expected " + std::to_string(library::CAPTURE_FILE_VERSION);
+        return false;
+    }
+
+    m_aNames.resize(header.uNumNames);
+    for (std::string& name : m_aNames)
+    {
+        uint32_t uLength = 0u;
+        file.read(reinterpret_cast<char*>(&uLength), sizeof(uLength));
+        if (!file)
+        {
+            break;
+        }
+        name.resize(uLength);
+        file.read(name.data(), uLength);
+    }
+
+    m_aCommands.resize(header.uNumCommands);
+    file.read(reinterpret_cast<char*>(m_aCommands.data()), static_cast<std::streamsize>(sizeof(library::CaptureCommand) * m_aCommands.size()));
+    if (!file)
+    {
+        error = filePath.string() + " is truncated";
+        return false;
+    }
+
+    for (const library::CaptureCommand& command : m_aCommands)
+    {
+        if (command.type >= library::eCaptureCommandType::COUNT || command.uName >= m_aNames.size())
+        {
+            error = filePath.string() + " contains an invalid command";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureFile::GetCommands
+
+  Summary:  Returns the recorded commands
+
+  Returns:  const std::vector<library::CaptureCommand>&
+              Commands in submission order
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<library::CaptureCommand>& CaptureFile::GetCommands() const
+{
+    return m_aCommands;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureFile::GetName
+
+  Summary:  Returns a recorded name
+
+  Args:     uint32_t uName
+              Index of the name
+
+  Returns:  const std::string&
+              UTF-8 name, empty for unnamed objects
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::string& CaptureFile::GetName(uint32_t uName) const
+{
+    return m_aNames[uName];
+}
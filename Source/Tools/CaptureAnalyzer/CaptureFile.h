@@ -0,0 +1,54 @@
+/*+===================================================================
+  File:      CAPTUREFILE.H
+
+  Summary:   CaptureFile header file contains declarations of
+             CaptureFile class used to read the frame capture files
+             written by the renderer.
+
+  Classes: CaptureFile
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Renderer/CaptureFormat.h"
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    CaptureFile
+
+  Summary:  Names and commands of a frame capture file
+
+  Methods:  Load
+              Reads a capture file
+            GetCommands
+              Returns the recorded commands
+            GetName
+              Returns a recorded name
+            CaptureFile
+              Constructor.
+            ~CaptureFile
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class CaptureFile final
+{
+public:
+    CaptureFile() = default;
+    CaptureFile(const CaptureFile& other) = delete;
+    CaptureFile(CaptureFile&& other) = delete;
+    CaptureFile& operator=(const CaptureFile& other) = delete;
+    CaptureFile& operator=(CaptureFile&& other) = delete;
+    ~CaptureFile() = default;
+
+    bool Load(const std::filesystem::path& filePath, std::string& error);
+
+    const std::vector<library::CaptureCommand>& GetCommands() const;
+    const std::string& GetName(uint32_t uName) const;
+
+private:
+    std::vector<std::string> m_aNames;
+    std::vector<library::CaptureCommand> m_aCommands;
+};
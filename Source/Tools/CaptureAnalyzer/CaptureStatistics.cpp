@@ -0,0 +1,233 @@
+#include "CaptureStatistics.h"
+
+#include <map>
+#include <unordered_map>
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::CaptureStatistics
+
+  Summary:  Constructor
+
+  Modifies: [m_aPasses, m_total, m_aObjects].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+CaptureStatistics::CaptureStatistics() :
+    m_aPasses(),
+    m_total(CreatePassStatistics("Total")),
+    m_aObjects()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::Compute
+
+  Summary:  Replays the commands of a capture and counts them per pass
+            and per object. Commands recorded before the first pass
+            are counted in a pass named "Frame"
+
+  Args:     const CaptureFile& captureFile
+              Capture to count the commands of
+
+  Modifies: [m_aPasses, m_total, m_aObjects].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void CaptureStatistics::Compute(const CaptureFile& captureFile)
+{
+    using library::CaptureCommand;
+    using library::eCaptureCommandType;
+
+    m_aPasses.clear();
+    m_aObjects.clear();
+    m_total = CreatePassStatistics("Total");
+
+    // The binding point of a state change is its type and slot, the value is the object and its arguments
+    std::map<std::pair<eCaptureCommandType, uint8_t>, CaptureCommand> boundStates;
+    std::unordered_map<uint32_t, size_t> objectIndices;
+
+    auto getObject = [&](const CaptureCommand& command) -> ObjectStatistics*
+    {
+        if (command.uObject == library::CAPTURE_INVALID_OBJECT)
+        {
+            return nullptr;
+        }
+
+        auto it = objectIndices.find(command.uObject);
+        if (it == objectIndices.end())
+        {
+            const std::string& name = captureFile.GetName(command.uName);
+            it = objectIndices.emplace(command.uObject, m_aObjects.size()).first;
+            m_aObjects.push_back(createObjectStatistics(name.empty() ? "#" + std::to_string(command.uObject) : name));
+        }
+
+        return &m_aObjects[it->second];
+    };
+
+    for (const CaptureCommand& command : captureFile.GetCommands())
+    {
+        if (command.type == eCaptureCommandType::BEGIN_PASS)
+        {
+            m_aPasses.push_back(CreatePassStatistics(captureFile.GetName(command.uName)));
+            continue;
+        }
+
+        if (m_aPasses.empty())
+        {
+            m_aPasses.push_back(CreatePassStatistics("Frame"));
+        }
+        PassStatistics& pass = m_aPasses.back();
+        ObjectStatistics* pObject = getObject(command);
+
+        switch (command.type)
+        {
+        case eCaptureCommandType::DRAW_INDEXED:
+        case eCaptureCommandType::DRAW_INDEXED_INSTANCED:
+        case eCaptureCommandType::DRAW:
+            pass.uNumDraws += 1u;
+            pass.uNumInstances += command.uArg1;
+            pass.uNumTriangles += static_cast<uint64_t>(command.uArg0 / 3u) * command.uArg1;
+            break;
+
+        case eCaptureCommandType::UPDATE_SUBRESOURCE:
+        case eCaptureCommandType::MAP:
+            pass.uNumUploads += 1u;
+            pass.uUploadBytes += command.uArg0;
+            if (pObject)
+            {
+                pObject->uNumUploads += 1u;
+                pObject->uUploadBytes += command.uArg0;
+            }
+            break;
+
+        case eCaptureCommandType::CLEAR_RENDER_TARGET:
+        case eCaptureCommandType::CLEAR_DEPTH_STENCIL:
+        case eCaptureCommandType::COPY_SUBRESOURCE_REGION:
+            // A copy overwrites its destination region like a clear
+            pass.uNumClears += 1u;
+            break;
+
+        default:
+        {
+            pass.uNumStateChanges += 1u;
+            if (pObject)
+            {
+                pObject->uNumBinds += 1u;
+            }
+
+            auto key = std::make_pair(command.type, command.uSlot);
+            auto it = boundStates.find(key);
+            if (it != boundStates.end() &&
+                it->second.uObject == command.uObject &&
+                it->second.uArg0 == command.uArg0 &&
+                it->second.uArg1 == command.uArg1)
+            {
+                pass.uNumRedundantStateChanges += 1u;
+                if (pObject)
+                {
+                    pObject->uNumRedundantBinds += 1u;
+                }
+            }
+            boundStates[key] = command;
+            break;
+        }
+        }
+    }
+
+    for (const PassStatistics& pass : m_aPasses)
+    {
+        m_total.uNumDraws += pass.uNumDraws;
+        m_total.uNumInstances += pass.uNumInstances;
+        m_total.uNumTriangles += pass.uNumTriangles;
+        m_total.uNumStateChanges += pass.uNumStateChanges;
+        m_total.uNumRedundantStateChanges += pass.uNumRedundantStateChanges;
+        m_total.uNumUploads += pass.uNumUploads;
+        m_total.uUploadBytes += pass.uUploadBytes;
+        m_total.uNumClears += pass.uNumClears;
+    }
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::GetPasses
+
+  Summary:  Returns the counters of every pass
+
+  Returns:  const std::vector<PassStatistics>&
+              Counters in execution order
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<PassStatistics>& CaptureStatistics::GetPasses() const
+{
+    return m_aPasses;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::GetTotal
+
+  Summary:  Returns the counters of the whole frame
+
+  Returns:  const PassStatistics&
+              Sum of the counters of every pass
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const PassStatistics& CaptureStatistics::GetTotal() const
+{
+    return m_total;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::GetObjects
+
+  Summary:  Returns the counters of every object
+
+  Returns:  const std::vector<ObjectStatistics>&
+              Counters in order of the first use of the objects
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<ObjectStatistics>& CaptureStatistics::GetObjects() const
+{
+    return m_aObjects;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::CreatePassStatistics
+
+  Summary:  Returns the statistics of a pass without any command
+
+  Args:     const std::string& name
+              Name of the pass
+
+  Returns:  PassStatistics
+              Statistics with every count at zero
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+PassStatistics CaptureStatistics::CreatePassStatistics(const std::string& name)
+{
+    return
+    {
+        .name = name,
+        .uNumDraws = 0u,
+        .uNumInstances = 0u,
+        .uNumTriangles = 0u,
+        .uNumStateChanges = 0u,
+        .uNumRedundantStateChanges = 0u,
+        .uNumUploads = 0u,
+        .uUploadBytes = 0u,
+        .uNumClears = 0u
+    };
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   CaptureStatistics::createObjectStatistics
+
+  Summary:  Returns the statistics of an object that was never bound
+
+  Args:     const std::string& name
+              Name of the object
+
+  Returns:  ObjectStatistics
+              Statistics with every count at zero
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+ObjectStatistics CaptureStatistics::createObjectStatistics(const std::string& name)
+{
+    return
+    {
+        .name = name,
+        .uNumBinds = 0u,
+        .uNumRedundantBinds = 0u,
+        .uNumUploads = 0u,
+        .uUploadBytes = 0u
+    };
+}
@@ -0,0 +1,102 @@
+/*+===================================================================
+  File:      CAPTURESTATISTICS.H
+
+  Summary:   CaptureStatistics header file contains declarations of
+             CaptureStatistics class used to summarize the draws,
+             state changes and uploads of a frame capture.
+
+  Classes: CaptureStatistics
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CaptureFile.h"
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+    Struct:   PassStatistics
+
+    Summary:  Counters of the commands recorded within a render pass
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct PassStatistics
+{
+    std::string name;
+    uint64_t uNumDraws;
+    uint64_t uNumInstances;
+    uint64_t uNumTriangles;
+    uint64_t uNumStateChanges;
+    uint64_t uNumRedundantStateChanges;
+    uint64_t uNumUploads;
+    uint64_t uUploadBytes;
+    uint64_t uNumClears;
+};
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+    Struct:   ObjectStatistics
+
+    Summary:  Counters of the commands that refer to one Direct3D
+              object
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct ObjectStatistics
+{
+    std::string name;
+    uint64_t uNumBinds;
+    uint64_t uNumRedundantBinds;
+    uint64_t uNumUploads;
+    uint64_t uUploadBytes;
+};
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    CaptureStatistics
+
+  Summary:  Replays the commands of a capture and counts, for every
+            pass and object, the draws, state changes and uploads. A
+            state change is redundant when the binding point already
+            holds the same object, the state of the device context
+            carries over from pass to pass like it does on the GPU
+
+  Methods:  Compute
+              Counts the commands of a capture
+            GetPasses
+              Returns the counters of every pass
+            GetTotal
+              Returns the counters of the whole frame
+            GetObjects
+              Returns the counters of every object
+            CreatePassStatistics
+              Returns the counters of a pass without commands
+            CaptureStatistics
+              Constructor.
+            ~CaptureStatistics
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class CaptureStatistics final
+{
+public:
+    CaptureStatistics();
+    CaptureStatistics(const CaptureStatistics& other) = delete;
+    CaptureStatistics(CaptureStatistics&& other) = delete;
+    CaptureStatistics& operator=(const CaptureStatistics& other) = delete;
+    CaptureStatistics& operator=(CaptureStatistics&& other) = delete;
+    ~CaptureStatistics() = default;
+
+    void Compute(const CaptureFile& captureFile);
+
+    const std::vector<PassStatistics>& GetPasses() const;
+    const PassStatistics& GetTotal() const;
+    const std::vector<ObjectStatistics>& GetObjects() const;
+
+    static PassStatistics CreatePassStatistics(const std::string& name);
+
+private:
+    static ObjectStatistics createObjectStatistics(const std::string& name);
+
+private:
+    std::vector<PassStatistics> m_aPasses;
+    PassStatistics m_total;
+    std::vector<ObjectStatistics> m_aObjects;
+};
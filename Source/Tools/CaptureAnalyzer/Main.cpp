@@ -0,0 +1,332 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Command line analyzer of the frame captures written by
+             Renderer::CaptureFrame. Prints the draw, state change and
+             upload counters of every pass, compares two captures, or
+             lists the recorded commands.
+
+             The analyzer only uses the standard library, so it builds
+             on Linux as well:
+               g++ -std=c++20 -O2 -I../../Library *.cpp -o CaptureAnalyzer
+
+             Usage:
+               CaptureAnalyzer <capture>
+               CaptureAnalyzer --diff <baseline> <capture>
+               CaptureAnalyzer --dump <capture>
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "CaptureFile.h"
+#include "CaptureStatistics.h"
+
+namespace
+{
+    constexpr const size_t NUM_TOP_OBJECTS = 10u;
+
+    constexpr const char* COMMAND_TYPE_NAMES[] =
+    {
+        "BeginPass",
+        "SetVertexBuffer",
+        "SetIndexBuffer",
+        "SetInputLayout",
+        "SetPrimitiveTopology",
+        "SetVertexShader",
+        "SetPixelShader",
+        "SetVSConstantBuffer",
+        "SetPSConstantBuffer",
+        "SetPSShaderResource",
+        "SetPSSampler",
+        "SetRenderTargets",
+        "SetDepthStencilState",
+        "SetViewport",
+        "ClearRenderTarget",
+        "ClearDepthStencil",
+        "UpdateSubresource",
+        "Map",
+        "DrawIndexed",
+        "DrawIndexedInstanced",
+        "Draw",
+        "SetBlendState",
+        "CopySubresourceRegion",
+        "SetVSShaderResource",
+    };
+    static_assert(std::size(COMMAND_TYPE_NAMES) == static_cast<size_t>(library::eCaptureCommandType::COUNT),
+        "Every command type needs a name");
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: printPassHeader
+      Summary:  Prints the column names of the pass counters
+    -----------------------------------------------------------------F-F*/
+    void printPassHeader()
+    {
+        std::printf("%-16s %8s %10s %12s %8s %10s %8s %12s %7s\n",
+            "Pass", "Draws", "Instances", "Triangles", "States", "Redundant", "Uploads", "UploadBytes", "Clears");
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: printPass
+      Summary:  Prints the counters of a pass on one line
+      Args:     const PassStatistics& pass
+                  Counters to print
+    -----------------------------------------------------------------F-F*/
+    void printPass(const PassStatistics& pass)
+    {
+        std::printf("%-16s %8" PRIu64 " %10" PRIu64 " %12" PRIu64 " %8" PRIu64 " %10" PRIu64 " %8" PRIu64 " %12" PRIu64 " %7" PRIu64 "\n",
+            pass.name.c_str(), pass.uNumDraws, pass.uNumInstances, pass.uNumTriangles, pass.uNumStateChanges,
+            pass.uNumRedundantStateChanges, pass.uNumUploads, pass.uUploadBytes, pass.uNumClears);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: printDelta
+      Summary:  Prints the difference of the counters of two passes on
+                one line
+      Args:     const PassStatistics& baseline
+                  Counters of the baseline capture
+                const PassStatistics& pass
+                  Counters of the compared capture
+    -----------------------------------------------------------------F-F*/
+    void printDelta(const PassStatistics& baseline, const PassStatistics& pass)
+    {
+        auto delta = [](uint64_t uBaseline, uint64_t uValue)
+        {
+            return static_cast<int64_t>(uValue) - static_cast<int64_t>(uBaseline);
+        };
+
+        std::printf("%-16s %+8" PRId64 " %+10" PRId64 " %+12" PRId64 " %+8" PRId64 " %+10" PRId64 " %+8" PRId64 " %+12" PRId64 " %+7" PRId64 "\n",
+            pass.name.c_str(),
+            delta(baseline.uNumDraws, pass.uNumDraws),
+            delta(baseline.uNumInstances, pass.uNumInstances),
+            delta(baseline.uNumTriangles, pass.uNumTriangles),
+            delta(baseline.uNumStateChanges, pass.uNumStateChanges),
+            delta(baseline.uNumRedundantStateChanges, pass.uNumRedundantStateChanges),
+            delta(baseline.uNumUploads, pass.uNumUploads),
+            delta(baseline.uUploadBytes, pass.uUploadBytes),
+            delta(baseline.uNumClears, pass.uNumClears));
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: loadStatistics
+      Summary:  Reads a capture and counts its commands
+      Args:     const char* pszFileName
+                  Path of the capture
+                CaptureFile& captureFile
+                  Receives the capture
+                CaptureStatistics& statistics
+                  Receives the counters
+      Returns:  bool
+                  Whether the capture was read
+    -----------------------------------------------------------------F-F*/
+    bool loadStatistics(const char* pszFileName, CaptureFile& captureFile, CaptureStatistics& statistics)
+    {
+        std::string error;
+        if (!captureFile.Load(pszFileName, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return false;
+        }
+
+        statistics.Compute(captureFile);
+        return true;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: report
+      Summary:  Prints the counters of every pass and the objects with
+                the most uploaded bytes and redundant binds
+      Args:     const char* pszFileName
+                  Path of the capture
+      Returns:  int
+                  Exit code
+    -----------------------------------------------------------------F-F*/
+    int report(const char* pszFileName)
+    {
+        CaptureFile captureFile;
+        CaptureStatistics statistics;
+        if (!loadStatistics(pszFileName, captureFile, statistics))
+        {
+            return 1;
+        }
+
+        printPassHeader();
+        for (const PassStatistics& pass : statistics.GetPasses())
+        {
+            printPass(pass);
+        }
+        printPass(statistics.GetTotal());
+
+        std::vector<ObjectStatistics> aObjects = statistics.GetObjects();
+
+        std::printf("\nMost uploaded objects\n");
+        std::sort(aObjects.begin(), aObjects.end(),
+            [](const ObjectStatistics& a, const ObjectStatistics& b) { return a.uUploadBytes > b.uUploadBytes; });
+        for (size_t i = 0u; i < aObjects.size() && i < NUM_TOP_OBJECTS && aObjects[i].uUploadBytes > 0u; ++i)
+        {
+            std::printf("  %-48s %8" PRIu64 " uploads %12" PRIu64 " bytes\n",
+                aObjects[i].name.c_str(), aObjects[i].uNumUploads, aObjects[i].uUploadBytes);
+        }
+
+        std::printf("\nMost redundantly bound objects\n");
+        std::sort(aObjects.begin(), aObjects.end(),
+            [](const ObjectStatistics& a, const ObjectStatistics& b) { return a.uNumRedundantBinds > b.uNumRedundantBinds; });
+        for (size_t i = 0u; i < aObjects.size() && i < NUM_TOP_OBJECTS && aObjects[i].uNumRedundantBinds > 0u; ++i)
+        {
+            std::printf("  %-48s %8" PRIu64 " of %8" PRIu64 " binds\n",
+                aObjects[i].name.c_str(), aObjects[i].uNumRedundantBinds, aObjects[i].uNumBinds);
+        }
+
+        return 0;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: diff
+      Summary:  Prints the counters of two captures and their
+                difference for every pass. Passes are matched by name,
+                a pass missing from one capture counts as zero
+      Args:     const char* pszBaseline
+                  Path of the baseline capture
+                const char* pszFileName
+                  Path of the compared capture
+      Returns:  int
+                  Exit code
+    -----------------------------------------------------------------F-F*/
+    int diff(const char* pszBaseline, const char* pszFileName)
+    {
+        CaptureFile baselineFile;
+        CaptureStatistics baseline;
+        CaptureFile captureFile;
+        CaptureStatistics statistics;
+        if (!loadStatistics(pszBaseline, baselineFile, baseline) || !loadStatistics(pszFileName, captureFile, statistics))
+        {
+            return 1;
+        }
+
+        std::vector<std::string> aPassNames;
+        for (const std::vector<PassStatistics>* paPasses : { &baseline.GetPasses(), &statistics.GetPasses() })
+        {
+            for (const PassStatistics& pass : *paPasses)
+            {
+                if (std::find(aPassNames.begin(), aPassNames.end(), pass.name) == aPassNames.end())
+                {
+                    aPassNames.push_back(pass.name);
+                }
+            }
+        }
+
+        auto findPass = [](const CaptureStatistics& captureStatistics, const std::string& name)
+        {
+            for (const PassStatistics& pass : captureStatistics.GetPasses())
+            {
+                if (pass.name == name)
+                {
+                    return pass;
+                }
+            }
+            return CaptureStatistics::CreatePassStatistics(name);
+        };
+
+        std::printf("%s\n", pszBaseline);
+        printPassHeader();
+        for (const std::string& name : aPassNames)
+        {
+            printPass(findPass(baseline, name));
+        }
+        printPass(baseline.GetTotal());
+
+        std::printf("\n%s\n", pszFileName);
+        printPassHeader();
+        for (const std::string& name : aPassNames)
+        {
+            printPass(findPass(statistics, name));
+        }
+        printPass(statistics.GetTotal());
+
+        std::printf("\nDifference\n");
+        printPassHeader();
+        for (const std::string& name : aPassNames)
+        {
+            printDelta(findPass(baseline, name), findPass(statistics, name));
+        }
+        printDelta(baseline.GetTotal(), statistics.GetTotal());
+
+        return 0;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: dump
+      Summary:  Prints every recorded command on one line
+      Args:     const char* pszFileName
+                  Path of the capture
+      Returns:  int
+                  Exit code
+    -----------------------------------------------------------------F-F*/
+    int dump(const char* pszFileName)
+    {
+        CaptureFile captureFile;
+        std::string error;
+        if (!captureFile.Load(pszFileName, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+
+        for (const library::CaptureCommand& command : captureFile.GetCommands())
+        {
+            if (command.type == library::eCaptureCommandType::BEGIN_PASS)
+            {
+                std::printf("Pass %s\n", captureFile.GetName(command.uName).c_str());
+                continue;
+            }
+
+            std::string object = "-";
+            if (command.uObject != library::CAPTURE_INVALID_OBJECT)
+            {
+                object = captureFile.GetName(command.uName).empty() ? "#" + std::to_string(command.uObject) : captureFile.GetName(command.uName);
+            }
+            std::printf("  %-22s slot %2u %-48s %10u %10u\n",
+                COMMAND_TYPE_NAMES[static_cast<size_t>(command.type)], command.uSlot, object.c_str(), command.uArg0, command.uArg1);
+        }
+
+        return 0;
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+  Summary:  Entry point of the capture analyzer
+  Args:     int argc
+              Number of arguments
+            char* argv[]
+              Arguments
+  Returns:  int
+              Exit code
+-----------------------------------------------------------------F-F*/
+int main(int argc, char* argv[])
+{
+    if (argc == 2)
+    {
+        return report(argv[1]);
+    }
+    if (argc == 4 && std::strcmp(argv[1], "--diff") == 0)
+    {
+        return diff(argv[2], argv[3]);
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--dump") == 0)
+    {
+        return dump(argv[2]);
+    }
+
+    std::fprintf(stderr,
+        "Usage:\n"
+        "  %s <capture>\n"
+        "  %s --diff <baseline> <capture>\n"
+        "  %s --dump <capture>\n",
+        argv[0], argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,189 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::BenchmarkRunner
+
+  Summary:  Constructor
+
+  Args:     double minSeconds
+              Minimum time of one repetition
+            uint32_t uNumRepetitions
+              Number of timed repetitions of every benchmark
+
+  Modifies: [m_minSeconds, m_uNumRepetitions, m_aBenchmarks,
+             m_aResults].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BenchmarkRunner::BenchmarkRunner(double minSeconds, uint32_t uNumRepetitions) :
+    m_minSeconds(minSeconds),
+    m_uNumRepetitions(uNumRepetitions > 0u ? uNumRepetitions : 1u),
+    m_aBenchmarks(),
+    m_aResults()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::Register
+
+  Summary:  Adds a benchmark
+
+  Args:     const std::string& name
+              Name of the benchmark, "Class::Method/variant" by
+              convention
+            BenchmarkFunction function
+              Runs the kernel the given number of times
+
+  Modifies: [m_aBenchmarks].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkRunner::Register(const std::string& name, BenchmarkFunction function)
+{
+    m_aBenchmarks.push_back({ .name = name, .function = std::move(function) });
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::Run
+
+  Summary:  Runs the benchmarks whose names contain the filter and
+            prints their times as they finish. The iteration count
+            grows tenfold, scaled by the last time, until one
+            repetition lasts the minimum time
+
+  Args:     const std::string& filter
+              Part of the names to run, empty to run every benchmark
+
+  Modifies: [m_aResults].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkRunner::Run(const std::string& filter)
+{
+    m_aResults.clear();
+
+    std::printf("%-56s %14s %14s %14s %12s\n", "Benchmark", "Median ns", "Min ns", "Max ns", "Iterations");
+    for (const Benchmark& benchmark : m_aBenchmarks)
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        uint64_t uIterations = 1u;
+        double seconds = timeIterations(benchmark.function, uIterations);
+        while (seconds < m_minSeconds)
+        {
+            double scale = seconds > 0.0 ? 1.4 * m_minSeconds / seconds : 10.0;
+            uIterations = static_cast<uint64_t>(static_cast<double>(uIterations) * (scale < 10.0 ? scale : 10.0)) + 1u;
+            seconds = timeIterations(benchmark.function, uIterations);
+        }
+
+        std::vector<double> aNanoseconds(m_uNumRepetitions);
+        for (double& nanoseconds : aNanoseconds)
+        {
+            nanoseconds = timeIterations(benchmark.function, uIterations) * 1e9 / static_cast<double>(uIterations);
+        }
+        std::sort(aNanoseconds.begin(), aNanoseconds.end());
+
+        BenchmarkResult result =
+        {
+            .name = benchmark.name,
+            .uIterations = uIterations,
+            .medianNanoseconds = aNanoseconds[aNanoseconds.size() / 2u],
+            .minNanoseconds = aNanoseconds.front(),
+            .maxNanoseconds = aNanoseconds.back()
+        };
+        std::printf("%-56s %14.1f %14.1f %14.1f %12llu\n", result.name.c_str(), result.medianNanoseconds,
+            result.minNanoseconds, result.maxNanoseconds, static_cast<unsigned long long>(result.uIterations));
+        m_aResults.push_back(std::move(result));
+    }
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::GetResults
+
+  Summary:  Returns the results of the last run
+
+  Returns:  const std::vector<BenchmarkResult>&
+              Results in registration order
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<BenchmarkResult>& BenchmarkRunner::GetResults() const
+{
+    return m_aResults;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::WriteJson
+
+  Summary:  Writes the results of the last run as JSON, laid out like
+            the output of Google Benchmark so CompareBenchmarks.py and
+            other tools read either
+
+  Args:     const char* pszFileName
+              Path of the JSON file
+
+  Returns:  bool
+              Whether the file was written
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkRunner::WriteJson(const char* pszFileName) const
+{
+    std::ofstream file(pszFileName, std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char szDate[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::tm localTime = {};
+#if defined(_MSC_VER)
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
+    std::strftime(szDate, sizeof(szDate), "%Y-%m-%dT%H:%M:%S", &localTime);
+
+    file << "{\n  \"context\": {\n    \"date\": \"" << szDate
+        << "\",\n    \"min_time\": " << m_minSeconds
+        << ",\n    \"repetitions\": " << m_uNumRepetitions
+        << "\n  },\n  \"benchmarks\": [";
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (size_t i = 0u; i < m_aResults.size(); ++i)
+    {
+        const BenchmarkResult& result = m_aResults[i];
+        file << (i == 0u ? "\n" : ",\n")
+            << "    {\"name\": \"" << result.name
+            << "\", \"iterations\": " << result.uIterations
+            << ", \"real_time\": " << result.medianNanoseconds
+            << ", \"min_time\": " << result.minNanoseconds
+            << ", \"max_time\": " << result.maxNanoseconds
+            << ", \"time_unit\": \"ns\"}";
+    }
+    file << "\n  ]\n}\n";
+
+    return static_cast<bool>(file);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::timeIterations
+
+  Summary:  Times one call of a benchmark
+
+  Args:     const BenchmarkFunction& function
+              Benchmark to time
+            uint64_t uIterations
+              Number of iterations of the call
+
+  Returns:  double
+              Elapsed seconds
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+double BenchmarkRunner::timeIterations(const BenchmarkFunction& function, uint64_t uIterations)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    function(uIterations);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
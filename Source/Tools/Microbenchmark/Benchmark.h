@@ -0,0 +1,118 @@
+/*+===================================================================
+  File:      BENCHMARK.H
+
+  Summary:   Benchmark header file contains declarations of
+             BenchmarkRunner class that times registered kernels and
+             writes the results as JSON.
+
+  Classes: BenchmarkRunner
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+    Struct:   BenchmarkResult
+
+    Summary:  Time of one iteration of a benchmark in nanoseconds over
+              the repetitions of its run
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t uIterations;
+    double medianNanoseconds;
+    double minNanoseconds;
+    double maxNanoseconds;
+};
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    BenchmarkRunner
+
+  Summary:  Runs every registered benchmark a number of iterations
+            chosen so one repetition takes at least the minimum time,
+            then repeats it and keeps the median, fastest and slowest
+            time per iteration. A benchmark receives the number of
+            iterations and loops itself, so the timer is read only
+            around the whole loop
+
+  Methods:  Register
+              Adds a benchmark
+            Run
+              Runs the benchmarks whose names contain a filter
+            GetResults
+              Returns the results of the last run
+            WriteJson
+              Writes the results of the last run as JSON
+            KeepAlive
+              Keeps the compiler from removing a computed value
+            BenchmarkRunner
+              Constructor.
+            ~BenchmarkRunner
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class BenchmarkRunner final
+{
+public:
+    using BenchmarkFunction = std::function<void(uint64_t uIterations)>;
+
+public:
+    BenchmarkRunner(double minSeconds, uint32_t uNumRepetitions);
+    BenchmarkRunner(const BenchmarkRunner& other) = delete;
+    BenchmarkRunner(BenchmarkRunner&& other) = delete;
+    BenchmarkRunner& operator=(const BenchmarkRunner& other) = delete;
+    BenchmarkRunner& operator=(BenchmarkRunner&& other) = delete;
+    ~BenchmarkRunner() = default;
+
+    void Register(const std::string& name, BenchmarkFunction function);
+    void Run(const std::string& filter);
+    const std::vector<BenchmarkResult>& GetResults() const;
+    bool WriteJson(const char* pszFileName) const;
+
+    template <typename T>
+    static void KeepAlive(const T& value);
+
+private:
+    struct Benchmark
+    {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    static double timeIterations(const BenchmarkFunction& function, uint64_t uIterations);
+
+private:
+    double m_minSeconds;
+    uint32_t m_uNumRepetitions;
+    std::vector<Benchmark> m_aBenchmarks;
+    std::vector<BenchmarkResult> m_aResults;
+};
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkRunner::KeepAlive
+
+  Summary:  Makes the value observable, so the computation producing
+            it is not optimized away
+
+  Args:     const T& value
+              Value computed by the benchmark
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+template <typename T>
+void BenchmarkRunner::KeepAlive(const T& value)
+{
+#if defined(_MSC_VER)
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
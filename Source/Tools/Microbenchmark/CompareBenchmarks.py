@@ -0,0 +1,62 @@
+"""Compares the microbenchmark results of a change against a baseline.
+
+Reads two JSON files written by Microbenchmark (or by Google Benchmark) and prints, for every benchmark in
+both, the baseline and new time per call and their change. Exits with 1 when a benchmark got slower by more
+than the threshold, so the comparison can gate a change.
+
+    python CompareBenchmarks.py baseline.json change.json [--threshold 5]
+"""
+
+import argparse
+import json
+import sys
+
+NANOSECONDS_PER_UNIT = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def read_results(path):
+    with open(path) as file:
+        document = json.load(file)
+    results = {}
+    for benchmark in document["benchmarks"]:
+        # Google Benchmark also writes aggregate rows, the median is the one comparable to Microbenchmark
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "median":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        results[name] = benchmark["real_time"] * NANOSECONDS_PER_UNIT[benchmark.get("time_unit", "ns")]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="JSON results of the baseline")
+    parser.add_argument("change", help="JSON results of the change")
+    parser.add_argument("--threshold", type=float, default=5.0, help="slowdown in percent that fails the comparison")
+    args = parser.parse_args()
+
+    baseline = read_results(args.baseline)
+    change = read_results(args.change)
+
+    regressions = 0
+    print(f"{'Benchmark':<56} {'Baseline ns':>14} {'Change ns':>14} {'Change':>9}")
+    for name, baseline_time in baseline.items():
+        if name not in change:
+            print(f"{name:<56} {baseline_time:>14.1f} {'missing':>14}")
+            continue
+        change_time = change[name]
+        percent = (change_time - baseline_time) / baseline_time * 100.0 if baseline_time > 0.0 else 0.0
+        marker = ""
+        if percent > args.threshold:
+            marker = "  slower"
+            regressions += 1
+        elif percent < -args.threshold:
+            marker = "  faster"
+        print(f"{name:<56} {baseline_time:>14.1f} {change_time:>14.1f} {percent:>+8.1f}%{marker}")
+    for name in change.keys() - baseline.keys():
+        print(f"{name:<56} {'new':>14} {change[name]:>14.1f}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
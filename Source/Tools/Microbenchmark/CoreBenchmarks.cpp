@@ -0,0 +1,588 @@
+#include "CoreBenchmarks.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assimp/Importer.hpp"
+#include "assimp/postprocess.h"
+#include "assimp/scene.h"
+
+#include "Model/AnimationClip.h"
+#include "Model/AnimationLod.h"
+#include "Model/CompressedAnimationClip.h"
+#include "Model/Pose.h"
+#include "Model/Skeleton.h"
+#include "Renderer/LightClusterer.h"
+#include "Renderer/ShadowCascades.h"
+#include "Renderer/ShadowCasterCache.h"
+#include "Renderer/TangentSpace.h"
+#include "Renderer/ViewSet.h"
+#include "Scene/HeightMap.h"
+#include "Scene/PerlinNoise.h"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: convertMatrix
+  Summary:  Converts an assimp matrix to a DirectXMath matrix the way
+            the models do
+  Args:     const aiMatrix4x4& matrix
+              Assimp matrix
+  Returns:  XMMATRIX
+              Transposed matrix
+-----------------------------------------------------------------F-F*/
+static XMMATRIX convertMatrix(const aiMatrix4x4& matrix)
+{
+    return XMMATRIX(
+        matrix.a1, matrix.b1, matrix.c1, matrix.d1,
+        matrix.a2, matrix.b2, matrix.c2, matrix.d2,
+        matrix.a3, matrix.b3, matrix.c3, matrix.d3,
+        matrix.a4, matrix.b4, matrix.c4, matrix.d4
+    );
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createSkeleton
+  Summary:  Flattens the node hierarchy of a scene into a skeleton the
+            way a model does, numbering the bones in the order the
+            meshes first name them
+  Args:     const aiScene* pScene
+              Assimp scene
+  Returns:  std::shared_ptr<library::Skeleton>
+              Skeleton of the scene
+-----------------------------------------------------------------F-F*/
+static std::shared_ptr<library::Skeleton> createSkeleton(const aiScene* pScene)
+{
+    std::unordered_map<std::string, UINT> boneNameToIndexMap;
+    std::vector<XMMATRIX> aBoneOffsets;
+    for (UINT uMesh = 0u; uMesh < pScene->mNumMeshes; ++uMesh)
+    {
+        const aiMesh* pMesh = pScene->mMeshes[uMesh];
+        for (UINT uBone = 0u; uBone < pMesh->mNumBones; ++uBone)
+        {
+            const aiBone* pBone = pMesh->mBones[uBone];
+            if (boneNameToIndexMap.emplace(pBone->mName.C_Str(), static_cast<UINT>(aBoneOffsets.size())).second)
+            {
+                aBoneOffsets.push_back(convertMatrix(pBone->mOffsetMatrix));
+            }
+        }
+    }
+
+    std::shared_ptr<library::Skeleton> skeleton = std::make_shared<library::Skeleton>();
+    std::vector<std::pair<const aiNode*, UINT>> aStack;
+    if (pScene->mRootNode)
+    {
+        aStack.push_back(std::make_pair(pScene->mRootNode, library::Skeleton::INVALID_INDEX));
+    }
+    while (!aStack.empty())
+    {
+        const aiNode* pNode = aStack.back().first;
+        UINT uParent = aStack.back().second;
+        aStack.pop_back();
+
+        UINT uBone = library::Skeleton::INVALID_INDEX;
+        XMMATRIX boneOffset = XMMatrixIdentity();
+        auto it_bone = boneNameToIndexMap.find(pNode->mName.C_Str());
+        if (it_bone != boneNameToIndexMap.end())
+        {
+            uBone = it_bone->second;
+            boneOffset = aBoneOffsets[uBone];
+        }
+
+        UINT uNode = skeleton->AddNode(pNode->mName.C_Str(), uParent, convertMatrix(pNode->mTransformation), uBone, boneOffset);
+
+        // Pushed in reverse, so the children are added in their order
+        for (UINT i = pNode->mNumChildren; i > 0u; --i)
+        {
+            aStack.push_back(std::make_pair(pNode->mChildren[i - 1u], uNode));
+        }
+    }
+
+    return skeleton;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getAnimationTime
+  Summary:  Returns the animation time of an iteration, stepping an
+            irregular amount so consecutive iterations hit different
+            keys
+  Args:     uint64_t uIteration
+              Index of the iteration
+            FLOAT duration
+              Length of the animation in ticks
+  Returns:  FLOAT
+              Time in ticks within the animation
+-----------------------------------------------------------------F-F*/
+static FLOAT getAnimationTime(uint64_t uIteration, FLOAT duration)
+{
+    return duration > 0.0f ? std::fmod(static_cast<FLOAT>(uIteration % 4096u) * 0.37f, duration) : 0.0f;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: checkResamplingError
+  Summary:  Checks that the samples of a resampled clip are no further
+            from the keys of its animation than a hundredth of a unit
+            in translation, a hundredth of a radian in rotation and a
+            thousandth in scaling
+  Args:     const library::AnimationClip& clip
+              Resampled clip
+            PCSTR pszClipName
+              Name of the clip in the messages
+  Returns:  HRESULT
+              Status code, E_FAIL if an error is above its tolerance
+-----------------------------------------------------------------F-F*/
+static HRESULT checkResamplingError(const library::AnimationClip& clip, PCSTR pszClipName)
+{
+    constexpr const FLOAT MAX_TRANSLATION_ERROR = 0.01f;
+    constexpr const FLOAT MAX_ROTATION_ERROR = 0.01f;
+    constexpr const FLOAT MAX_SCALING_ERROR = 0.001f;
+
+    FLOAT translationError = clip.GetMaxTranslationError();
+    FLOAT rotationError = clip.GetMaxRotationError();
+    FLOAT scalingError = clip.GetMaxScalingError();
+    std::printf("%s resampled to %u samples is off its keys by at most %f in translation, %f radians in rotation and %f in scaling\n",
+        pszClipName, clip.GetNumSamples(), translationError, rotationError, scalingError);
+    if (translationError > MAX_TRANSLATION_ERROR || rotationError > MAX_ROTATION_ERROR || scalingError > MAX_SCALING_ERROR)
+    {
+        std::fprintf(stderr, "The resampled clip of %s is off its keys by more than %f in translation, %f radians in rotation or %f in scaling\n",
+            pszClipName, MAX_TRANSLATION_ERROR, MAX_ROTATION_ERROR, MAX_SCALING_ERROR);
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: writeHeightMap
+  Summary:  Writes a height map file in the format read by HeightMap,
+            with heights from Perlin noise
+  Args:     const std::filesystem::path& filePath
+              Path of the height map file
+            UINT uWidth
+              Number of columns along x
+            UINT uHeight
+              Largest number of blocks in a column
+            UINT uDepth
+              Number of columns along z
+  Returns:  HRESULT
+              Status code
+-----------------------------------------------------------------F-F*/
+static HRESULT writeHeightMap(const std::filesystem::path& filePath, UINT uWidth, UINT uHeight, UINT uDepth)
+{
+    constexpr const library::eBlockType aBlockTypes[] =
+    {
+        library::eBlockType::OCEAN,
+        library::eBlockType::SAND,
+        library::eBlockType::GRASSLAND,
+        library::eBlockType::SNOW,
+    };
+
+    std::ofstream file(filePath, std::ios::trunc);
+    if (!file)
+    {
+        return E_FAIL;
+    }
+
+    file << uWidth << ' ' << uHeight << ' ' << uDepth << ' ' << static_cast<UINT>(library::eBlockType::COUNT) - static_cast<UINT>(library::eBlockType::GRASSLAND) << '\n';
+    for (UINT i = static_cast<UINT>(library::eBlockType::GRASSLAND); i < static_cast<UINT>(library::eBlockType::COUNT); ++i)
+    {
+        file << "0.5 0.5 0.5\n";
+    }
+
+    for (UINT z = 0u; z < uDepth; ++z)
+    {
+        for (UINT x = 0u; x < uWidth; ++x)
+        {
+            FLOAT height = library::PerlinNoise::Get2d(static_cast<FLOAT>(x), static_cast<FLOAT>(z), 0.1f, 4u);
+            size_t uType = static_cast<size_t>(height * static_cast<FLOAT>(ARRAYSIZE(aBlockTypes)));
+            file << static_cast<CHAR>(aBlockTypes[uType < ARRAYSIZE(aBlockTypes) ? uType : ARRAYSIZE(aBlockTypes) - 1u]) << height << ' ';
+        }
+        file << '\n';
+    }
+
+    return file ? S_OK : E_FAIL;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createTerrainMesh
+  Summary:  Creates a triangle list of a square grid of quads lifted
+            by Perlin noise, with a texture coordinate per vertex
+            stretched over the grid, the way a textured terrain mesh
+            is laid out
+  Args:     UINT uNumQuads
+              Number of quads along each side, at most 255
+            std::vector<library::SimpleVertex>& aVertices
+              Vertices of the grid
+            std::vector<WORD>& aIndices
+              Indices of the grid, two faces per quad
+-----------------------------------------------------------------F-F*/
+static void createTerrainMesh(UINT uNumQuads, std::vector<library::SimpleVertex>& aVertices, std::vector<WORD>& aIndices)
+{
+    const UINT uNumSideVertices = uNumQuads + 1u;
+    aVertices.clear();
+    aVertices.reserve(static_cast<size_t>(uNumSideVertices) * uNumSideVertices);
+    for (UINT z = 0u; z < uNumSideVertices; ++z)
+    {
+        for (UINT x = 0u; x < uNumSideVertices; ++x)
+        {
+            aVertices.push_back(
+                library::SimpleVertex
+                {
+                    .Position = XMFLOAT3(static_cast<FLOAT>(x), 8.0f * library::PerlinNoise::Get2d(static_cast<FLOAT>(x), static_cast<FLOAT>(z), 0.1f, 4u), static_cast<FLOAT>(z)),
+                    .TexCoord = XMFLOAT2(static_cast<FLOAT>(x) / static_cast<FLOAT>(uNumQuads), static_cast<FLOAT>(z) / static_cast<FLOAT>(uNumQuads)),
+                    .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f)
+                }
+            );
+        }
+    }
+
+    aIndices.clear();
+    aIndices.reserve(static_cast<size_t>(uNumQuads) * uNumQuads * 6u);
+    for (UINT z = 0u; z < uNumQuads; ++z)
+    {
+        for (UINT x = 0u; x < uNumQuads; ++x)
+        {
+            WORD uCorner = static_cast<WORD>(z * uNumSideVertices + x);
+            WORD uNextRowCorner = static_cast<WORD>(uCorner + uNumSideVertices);
+            aIndices.insert(aIndices.end(), { uCorner, uNextRowCorner, static_cast<WORD>(uCorner + 1u) });
+            aIndices.insert(aIndices.end(), { static_cast<WORD>(uCorner + 1u), uNextRowCorner, static_cast<WORD>(uNextRowCorner + 1u) });
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterCoreBenchmarks
+  Summary:  Loads the data of the kernels that do not need Direct3D,
+            checks the resampling error of the BobLampClean clip and
+            registers a benchmark for every kernel:
+              the clip resampling, compression and sampling of the
+              resampled and the compressed clip of BobLampClean, the
+              blending of two of its poses, the animation level of
+              detail picked for a crowd of 1000 characters, the
+              culling of ViewSet against one and four views, the light
+              assignment of LightClusterer, the light frustum culling
+              and dirty tracking of ShadowCasterCache with a still and
+              a moving light, the cascade fitting of ShadowCascades
+              for a moving camera, the Perlin noise of the terrains,
+              the reading of a 64x32x64 height map, and the tangent
+              space of a generated terrain mesh and of one of its
+              faces
+  Args:     BenchmarkRunner& runner
+              Runner to register the benchmarks into
+            const std::filesystem::path& contentDirectory
+              Content directory of the game
+  Returns:  HRESULT
+              Status code, E_FAIL if the content can not be read,
+              the resampled clip of BobLampClean is off its keys or
+              the height map can not be written
+-----------------------------------------------------------------F-F*/
+HRESULT RegisterCoreBenchmarks(_Inout_ BenchmarkRunner& runner, _In_ const std::filesystem::path& contentDirectory)
+{
+    // The scene is kept by the benchmarks, which sample its animation after the importer is gone
+    std::shared_ptr<const aiScene> bobLampScene;
+    {
+        Assimp::Importer importer;
+        std::filesystem::path bobLampPath = contentDirectory / "BobLampClean" / "boblampclean.md5mesh";
+        if (!importer.ReadFile(bobLampPath.string().c_str(), ASSIMP_LOAD_FLAGS))
+        {
+            std::fprintf(stderr, "%s\n", importer.GetErrorString());
+            return E_FAIL;
+        }
+        bobLampScene.reset(importer.GetOrphanedScene());
+    }
+    if (!bobLampScene->HasAnimations() || !bobLampScene->mRootNode)
+    {
+        return E_FAIL;
+    }
+
+    const aiAnimation* pAnimation = bobLampScene->mAnimations[0];
+    FLOAT duration = static_cast<FLOAT>(pAnimation->mDuration);
+    std::shared_ptr<library::Skeleton> skeleton = createSkeleton(bobLampScene.get());
+    std::shared_ptr<library::AnimationClip> clip = std::make_shared<library::AnimationClip>(pAnimation, 60.0f);
+    HRESULT hr = checkResamplingError(*clip, "BobLampClean");
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    std::shared_ptr<library::CompressedAnimationClip> compressedClip = std::make_shared<library::CompressedAnimationClip>(*clip, *skeleton, 0.001f);
+    runner.Register("AnimationClip::AnimationClip/BobLampClean", [bobLampScene, pAnimation](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            library::AnimationClip resampledClip(pAnimation, 60.0f);
+            BenchmarkRunner::KeepAlive(resampledClip.GetMaxRotationError());
+        }
+    });
+    std::shared_ptr<std::vector<XMVECTOR>> aPose = std::make_shared<std::vector<XMVECTOR>>(clip->GetNumTracks() * 3u);
+    runner.Register("AnimationClip::Sample/BobLampClean", [clip, aPose, duration](uint64_t uIterations)
+    {
+        XMVECTOR* aTranslations = aPose->data();
+        XMVECTOR* aRotations = aTranslations + clip->GetNumTracks();
+        XMVECTOR* aScales = aRotations + clip->GetNumTracks();
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            clip->Sample(getAnimationTime(i, duration), aTranslations, aRotations, aScales);
+            BenchmarkRunner::KeepAlive(aRotations[0]);
+        }
+    });
+    runner.Register("CompressedAnimationClip::CompressedAnimationClip/BobLampClean", [clip, skeleton](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            library::CompressedAnimationClip builtClip(*clip, *skeleton, 0.001f);
+            BenchmarkRunner::KeepAlive(builtClip.GetMaxPositionError());
+        }
+    });
+    runner.Register("CompressedAnimationClip::Sample/BobLampClean", [compressedClip, aPose, duration](uint64_t uIterations)
+    {
+        XMVECTOR* aTranslations = aPose->data();
+        XMVECTOR* aRotations = aTranslations + compressedClip->GetNumTracks();
+        XMVECTOR* aScales = aRotations + compressedClip->GetNumTracks();
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            compressedClip->Sample(getAnimationTime(i, duration), aTranslations, aRotations, aScales);
+            BenchmarkRunner::KeepAlive(aRotations[0]);
+        }
+    });
+
+    // Two poses of the clip, a quarter of its length apart, blended the way two layers are
+    std::vector<UINT> aNodeTracks;
+    skeleton->MapTracks(*clip, aNodeTracks);
+    std::shared_ptr<library::Pose> pose = std::make_shared<library::Pose>();
+    std::shared_ptr<library::Pose> blendedPose = std::make_shared<library::Pose>();
+    library::Pose* apPoses[] = { pose.get(), blendedPose.get() };
+    for (UINT uPose = 0u; uPose < ARRAYSIZE(apPoses); ++uPose)
+    {
+        XMVECTOR* aTranslations = aPose->data();
+        XMVECTOR* aRotations = aTranslations + clip->GetNumTracks();
+        XMVECTOR* aScales = aRotations + clip->GetNumTracks();
+        clip->Sample(0.25f * duration * static_cast<FLOAT>(uPose), aTranslations, aRotations, aScales);
+        apPoses[uPose]->Resize(skeleton->GetNumNodes());
+        apPoses[uPose]->SetTracks(*skeleton, aNodeTracks.data(), aTranslations, aRotations, aScales);
+    }
+    runner.Register("Pose::Blend/BobLampClean", [pose, blendedPose](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            pose->Blend(*blendedPose, 0.5f);
+            BenchmarkRunner::KeepAlive(pose->GetRotations()[0]);
+        }
+    });
+
+    // The characters stand on a grid of 40 by 25 in front of a camera, the first rows behind it
+    constexpr const UINT NUM_CHARACTERS = 1000u;
+    const XMMATRIX crowdView = XMMatrixLookToLH(XMVectorSet(0.0f, 1.7f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    const XMMATRIX crowdProjection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+    const BoundingBox characterBounds(XMFLOAT3(0.0f, 0.9f, 0.0f), XMFLOAT3(0.4f, 0.9f, 0.4f));
+    std::shared_ptr<library::AnimationLodPolicy> lodPolicy = std::make_shared<library::AnimationLodPolicy>(
+        library::AnimationLodDesc
+        {
+            .boundsScale = 1.5f,
+            .fullRateCoverage = 0.25f,
+            .uMaxUpdateInterval = 4u,
+            .uMaxSkippedLevels = 2u
+        }
+    );
+    std::shared_ptr<std::vector<XMMATRIX>> aCharacterWorlds = std::make_shared<std::vector<XMMATRIX>>();
+    for (UINT i = 0u; i < NUM_CHARACTERS; ++i)
+    {
+        aCharacterWorlds->push_back(XMMatrixTranslation(2.0f * static_cast<FLOAT>(i % 40u) - 40.0f, 0.0f, 10.0f * static_cast<FLOAT>(i / 40u) - 40.0f));
+    }
+    runner.Register("AnimationLodPolicy::Select/1000Characters", [lodPolicy, aCharacterWorlds, characterBounds, crowdView, crowdProjection](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            UINT uNumVisible = 0u;
+            for (const XMMATRIX& world : *aCharacterWorlds)
+            {
+                uNumVisible += lodPolicy->Select(characterBounds, world, crowdView, crowdProjection).bVisible ? 1u : 0u;
+            }
+            BenchmarkRunner::KeepAlive(uNumVisible);
+        }
+    });
+
+    // 4096 unit voxels on a grid of 64 by 64, two units apart
+    constexpr const UINT NUM_VOXELS = 4096u;
+    std::shared_ptr<std::vector<XMMATRIX>> aVoxelWorlds = std::make_shared<std::vector<XMMATRIX>>();
+    for (UINT i = 0u; i < NUM_VOXELS; ++i)
+    {
+        aVoxelWorlds->push_back(XMMatrixTranslation(static_cast<FLOAT>(i % 64u) * 2.0f, 0.0f, static_cast<FLOAT>(i / 64u) * 2.0f));
+    }
+    const BoundingBox voxelBounds(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+    // The voxels are culled by the camera alone, then by the camera, a light and two split screen players that
+    // share the world bounds of the voxels
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+    const XMVECTOR aEyes[] =
+    {
+        XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f),
+        XMVectorSet(64.0f, 32.0f, 64.0f, 0.0f),
+        XMVectorSet(-8.0f, 4.0f, 64.0f, 0.0f),
+        XMVectorSet(128.0f, 4.0f, 64.0f, 0.0f),
+    };
+    for (UINT uNumViews : { 1u, static_cast<UINT>(ARRAYSIZE(aEyes)) })
+    {
+        std::shared_ptr<library::ViewSet> viewSet = std::make_shared<library::ViewSet>();
+        for (UINT i = 0u; i < uNumViews; ++i)
+        {
+            UINT uView = viewSet->AddView((L"View" + std::to_wstring(i)).c_str());
+            viewSet->SetViewTransform(uView, XMMatrixLookAtLH(aEyes[i], XMVectorSet(64.0f, 0.0f, 64.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)), projection);
+        }
+
+        runner.Register("ViewSet::Cull/4096Voxels" + std::to_string(uNumViews) + "Views", [aVoxelWorlds, viewSet, voxelBounds](uint64_t uIterations)
+        {
+            for (uint64_t i = 0u; i < uIterations; ++i)
+            {
+                viewSet->ClearItems();
+                for (const XMMATRIX& world : *aVoxelWorlds)
+                {
+                    viewSet->AddItem(voxelBounds, world);
+                }
+                viewSet->Cull();
+                BenchmarkRunner::KeepAlive(viewSet->GetVisibleItems(0u).size());
+            }
+        });
+    }
+
+    // 1024 lights spread over the voxels at different heights and distances, seen by the camera of the first view
+    constexpr const UINT NUM_LIGHTS = 1024u;
+    std::shared_ptr<std::vector<XMFLOAT4>> aLightSpheres = std::make_shared<std::vector<XMFLOAT4>>();
+    for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+    {
+        aLightSpheres->push_back(XMFLOAT4(static_cast<FLOAT>(i % 32u) * 4.0f, static_cast<FLOAT>(1u + i % 7u), static_cast<FLOAT>(i / 32u) * 4.0f, static_cast<FLOAT>(3u + i % 5u)));
+    }
+    std::shared_ptr<library::LightClusterer> lightClusterer = std::make_shared<library::LightClusterer>(
+        library::LightClustererDesc
+        {
+            .uNumClustersX = 16u,
+            .uNumClustersY = 9u,
+            .uNumClustersZ = 24u,
+            .firstSliceDepth = 1.0f
+        }
+    );
+    const XMMATRIX cameraView = XMMatrixLookAtLH(aEyes[0], XMVectorSet(64.0f, 0.0f, 64.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    runner.Register("LightClusterer::Build/1024Lights16x9x24", [aLightSpheres, lightClusterer, cameraView, projection](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            lightClusterer->Build(cameraView, projection, *aLightSpheres);
+            BenchmarkRunner::KeepAlive(lightClusterer->GetLightIndices().size());
+        }
+    });
+
+    // The voxels are culled by a light above them and added as static casters, the still light keeps the cache
+    // clean and the moving light makes every frame dirty
+    const XMMATRIX lightProjection = XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 0.01f, 1000.0f);
+    for (BOOL bMovingLight : { FALSE, TRUE })
+    {
+        std::shared_ptr<library::ViewSet> lightViewSet = std::make_shared<library::ViewSet>();
+        UINT uLightView = lightViewSet->AddView(L"Light");
+        std::shared_ptr<library::ShadowCasterCache> shadowCasterCache = std::make_shared<library::ShadowCasterCache>();
+        runner.Register(std::string("ShadowCasterCache::EndFrame/4096Voxels") + (bMovingLight ? "MovingLight" : "StillLight"),
+            [aVoxelWorlds, lightViewSet, uLightView, shadowCasterCache, voxelBounds, lightProjection, bMovingLight](uint64_t uIterations)
+        {
+            for (uint64_t i = 0u; i < uIterations; ++i)
+            {
+                const FLOAT lightX = bMovingLight ? static_cast<FLOAT>(i % 64u) : 32.0f;
+                const XMMATRIX lightView = XMMatrixLookAtLH(XMVectorSet(lightX, 48.0f, 32.0f, 0.0f), XMVectorSet(lightX, 0.0f, 33.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+                lightViewSet->SetViewTransform(uLightView, lightView, lightProjection);
+                lightViewSet->ClearItems();
+                for (const XMMATRIX& world : *aVoxelWorlds)
+                {
+                    lightViewSet->AddItem(voxelBounds, world);
+                }
+                lightViewSet->Cull();
+
+                shadowCasterCache->BeginFrame(lightView, lightProjection);
+                for (UINT uItem : lightViewSet->GetVisibleItems(uLightView))
+                {
+                    shadowCasterCache->AddStaticCaster(&(*aVoxelWorlds)[uItem], (*aVoxelWorlds)[uItem]);
+                }
+                BenchmarkRunner::KeepAlive(shadowCasterCache->EndFrame());
+            }
+        });
+    }
+
+    // The camera walks over the voxel field under a slanted sun, so every cascade is refitted and snapped
+    std::shared_ptr<library::ShadowCascades> shadowCascades = std::make_shared<library::ShadowCascades>(
+        library::ShadowCascadesDesc
+        {
+            .uNumCascades = 4u,
+            .uResolution = 1024u,
+            .shadowDistance = 200.0f,
+            .splitLambda = 0.75f
+        }
+    );
+    const BoundingBox sceneBounds(XMFLOAT3(32.0f, 0.5f, 32.0f), XMFLOAT3(32.0f, 0.5f, 32.0f));
+    runner.Register("ShadowCascades::Update/4Cascades", [shadowCascades, sceneBounds, projection](uint64_t uIterations)
+    {
+        const XMVECTOR lightDirection = XMVectorSet(0.3f, -1.0f, 0.4f, 0.0f);
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            const FLOAT cameraX = static_cast<FLOAT>(i % 64u);
+            const XMMATRIX cameraView = XMMatrixLookAtLH(XMVectorSet(cameraX, 4.0f, 0.0f, 0.0f), XMVectorSet(cameraX, 0.0f, 32.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+            shadowCascades->Update(cameraView, projection, lightDirection, sceneBounds);
+            BenchmarkRunner::KeepAlive(shadowCascades->GetTexelSize(3u));
+        }
+    });
+
+    runner.Register("PerlinNoise::Get2d", [](uint64_t uIterations)
+    {
+        FLOAT sum = 0.0f;
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            sum += library::PerlinNoise::Get2d(static_cast<FLOAT>(i & 255u), static_cast<FLOAT>((i >> 8u) & 255u), 0.1f, 4u);
+        }
+        BenchmarkRunner::KeepAlive(sum);
+    });
+
+    std::filesystem::path heightMapPath = std::filesystem::temp_directory_path() / "MicrobenchmarkHeightMap.txt";
+    hr = writeHeightMap(heightMapPath, 64u, 32u, 64u);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    std::shared_ptr<library::HeightMap> heightMap = std::make_shared<library::HeightMap>();
+    runner.Register("HeightMap::Read/64x32x64", [heightMapPath, heightMap](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            heightMap->Read(heightMapPath);
+            BenchmarkRunner::KeepAlive(heightMap->GetNumInstances());
+        }
+    });
+
+    // 128 by 128 quads keep the 16641 vertices addressable by the 16 bit indices of a renderable
+    std::shared_ptr<std::vector<library::SimpleVertex>> aTerrainVertices = std::make_shared<std::vector<library::SimpleVertex>>();
+    std::shared_ptr<std::vector<WORD>> aTerrainIndices = std::make_shared<std::vector<WORD>>();
+    createTerrainMesh(128u, *aTerrainVertices, *aTerrainIndices);
+    std::shared_ptr<std::vector<library::NormalData>> aNormalData = std::make_shared<std::vector<library::NormalData>>();
+    runner.Register("TangentSpace::CalculateNormalMapVectors/Terrain128x128", [aTerrainVertices, aTerrainIndices, aNormalData](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            library::TangentSpace::CalculateNormalMapVectors(aTerrainVertices->data(), static_cast<UINT>(aTerrainVertices->size()), aTerrainIndices->data(), static_cast<UINT>(aTerrainIndices->size()), *aNormalData);
+            BenchmarkRunner::KeepAlive(aNormalData->back());
+        }
+    });
+    runner.Register("TangentSpace::CalculateTangentBitangent/Terrain128x128", [aTerrainVertices, aTerrainIndices](uint64_t uIterations)
+    {
+        const library::SimpleVertex* aVertices = aTerrainVertices->data();
+        const WORD* aIndices = aTerrainIndices->data();
+        size_t uNumFaces = aTerrainIndices->size() / 3u;
+        XMFLOAT3 tangent, bitangent;
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            size_t uFace = static_cast<size_t>(i % uNumFaces) * 3u;
+            library::TangentSpace::CalculateTangentBitangent(aVertices[aIndices[uFace]], aVertices[aIndices[uFace + 1u]], aVertices[aIndices[uFace + 2u]], tangent, bitangent);
+            BenchmarkRunner::KeepAlive(tangent);
+            BenchmarkRunner::KeepAlive(bitangent);
+        }
+    });
+
+    return S_OK;
+}
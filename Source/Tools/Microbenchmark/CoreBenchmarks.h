@@ -0,0 +1,19 @@
+/*+===================================================================
+  File:      COREBENCHMARKS.H
+
+  Summary:   CoreBenchmarks header file contains the declaration of the
+             function registering the benchmarks of the engine kernels
+             that only need DirectXMath, assimp and the standard
+             library, so they also run off Windows.
+
+  Functions: RegisterCoreBenchmarks
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "CoreCommon.h"
+
+#include "Benchmark.h"
+
+HRESULT RegisterCoreBenchmarks(_Inout_ BenchmarkRunner& runner, _In_ const std::filesystem::path& contentDirectory);
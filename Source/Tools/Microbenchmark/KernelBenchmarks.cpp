@@ -0,0 +1,847 @@
+#include "KernelBenchmarks.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assimp/scene.h"
+
+#include "Profiler/Profiler.h"
+#include "Renderer/InstanceBatcher.h"
+#include "Renderer/PositionStream.h"
+#include "Scene/Voxel.h"
+#include "Thread/ThreadPool.h"
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::BenchmarkModel
+
+  Summary:  Constructor
+
+  Args:     const std::filesystem::path& filePath
+              Path of the model file
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BenchmarkModel::BenchmarkModel(_In_ const std::filesystem::path& filePath) :
+    Model(filePath),
+    m_scene()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::Load
+
+  Summary:  Reads the model file and its vertices, indices, bones,
+            skeleton and animation clips the way Initialize does, but
+            creates no Direct3D objects, and takes the scene from the
+            importer shared by the models
+
+  Modifies: [m_pScene, m_scene, m_globalInverseTransform, m_aMeshes,
+             m_aVertices, m_aIndices, m_aBoneData, m_aBoneInfo,
+             m_boneNameToIndexMap, m_aAnimationData, m_skeleton,
+             m_aGlobalTransforms, m_aTransforms, m_aAnimationClips,
+             m_aAnimationClipStatistics, m_aNodeTracks,
+             m_aReferencePoses, m_aAnimationLayers,
+             m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+             m_pose, m_layerPose].
+
+  Returns:  HRESULT
+              Status code
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT BenchmarkModel::Load()
+{
+    HRESULT hr = loadScene();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // The importer frees its scene when it reads the next file
+    m_scene.reset(sm_pImporter->GetOrphanedScene());
+
+    initGeometry(m_pScene);
+    initSkeleton(m_pScene);
+    initAnimations(m_pScene);
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::CreateRig
+
+  Summary:  Builds an assimp scene of a binary tree of nodes, each
+            driving a bone, and of clips rotating every node around
+            an axis of the clip, and reads its skeleton and clips the
+            way Load does. The first clip plays on the first layer
+
+  Args:     UINT uNumNodes
+              Number of nodes and bones
+            UINT uNumClips
+              Number of clips, one second long
+
+  Modifies: [m_globalInverseTransform, m_aBoneInfo,
+             m_boneNameToIndexMap, m_skeleton, m_aGlobalTransforms,
+             m_aTransforms, m_aAnimationClips, m_aAnimationClipStatistics,
+             m_aNodeTracks, m_aReferencePoses, m_aAnimationLayers,
+             m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+             m_pose, m_layerPose].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkModel::CreateRig(_In_ UINT uNumNodes, _In_ UINT uNumClips)
+{
+    constexpr const UINT NUM_KEYS = 31u;
+    const aiVector3D aAxes[] =
+    {
+        aiVector3D(1.0f, 0.0f, 0.0f),
+        aiVector3D(0.0f, 1.0f, 0.0f),
+        aiVector3D(0.0f, 0.0f, 1.0f),
+    };
+
+    std::unique_ptr<aiScene> pScene = std::make_unique<aiScene>();
+    std::vector<aiNode*> apNodes(uNumNodes);
+    for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+    {
+        std::string szName = "Bone" + std::to_string(uNode);
+        apNodes[uNode] = new aiNode(szName);
+        apNodes[uNode]->mTransformation.b4 = 0.1f;
+        m_boneNameToIndexMap[szName] = uNode;
+        m_aBoneInfo.push_back(BoneInfo(XMMatrixIdentity()));
+    }
+    for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+    {
+        UINT uFirstChild = uNode * 2u + 1u;
+        UINT uNumChildren = uFirstChild >= uNumNodes ? 0u : uFirstChild + 1u == uNumNodes ? 1u : 2u;
+        if (uNumChildren > 0u)
+        {
+            apNodes[uNode]->mNumChildren = uNumChildren;
+            apNodes[uNode]->mChildren = new aiNode*[uNumChildren];
+            for (UINT i = 0u; i < uNumChildren; ++i)
+            {
+                apNodes[uNode]->mChildren[i] = apNodes[uFirstChild + i];
+                apNodes[uFirstChild + i]->mParent = apNodes[uNode];
+            }
+        }
+    }
+    pScene->mRootNode = apNodes[0];
+
+    pScene->mNumAnimations = uNumClips;
+    pScene->mAnimations = new aiAnimation*[uNumClips];
+    for (UINT uClip = 0u; uClip < uNumClips; ++uClip)
+    {
+        aiAnimation* pAnimation = new aiAnimation();
+        pAnimation->mDuration = static_cast<double>(NUM_KEYS - 1u);
+        pAnimation->mTicksPerSecond = static_cast<double>(NUM_KEYS - 1u);
+        pAnimation->mNumChannels = uNumNodes;
+        pAnimation->mChannels = new aiNodeAnim*[uNumNodes];
+        for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+        {
+            aiNodeAnim* pChannel = new aiNodeAnim();
+            pChannel->mNodeName = apNodes[uNode]->mName;
+            pChannel->mNumPositionKeys = 1u;
+            pChannel->mPositionKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(0.0f, 0.1f, 0.0f)) };
+            pChannel->mNumScalingKeys = 1u;
+            pChannel->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+            pChannel->mNumRotationKeys = NUM_KEYS;
+            pChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+            for (UINT uKey = 0u; uKey < NUM_KEYS; ++uKey)
+            {
+                FLOAT angle = 0.5f * std::sin(XM_2PI * static_cast<FLOAT>(uKey) / static_cast<FLOAT>(NUM_KEYS - 1u) + static_cast<FLOAT>(uClip + uNode));
+                pChannel->mRotationKeys[uKey] = aiQuatKey(static_cast<double>(uKey), aiQuaternion(aAxes[(uClip + uNode) % ARRAYSIZE(aAxes)], angle));
+            }
+            pAnimation->mChannels[uNode] = pChannel;
+        }
+        pScene->mAnimations[uClip] = pAnimation;
+    }
+
+    m_globalInverseTransform = XMMatrixIdentity();
+    initSkeleton(pScene.get());
+    initAnimations(pScene.get());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::ShareRig
+
+  Summary:  Shares the skeleton and the clips of another model, the way
+            instances of the same character would, with its own layers
+            and bone transforms starting from the layers of the other
+            model
+
+  Args:     const BenchmarkModel& rig
+              Model made by CreateRig
+
+  Modifies: [m_globalInverseTransform, m_skeleton, m_aGlobalTransforms,
+             m_aTransforms, m_aAnimationClips, m_aAnimationClipStatistics,
+             m_aNodeTracks, m_aReferencePoses, m_aAnimationLayers,
+             m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+             m_pose, m_layerPose].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkModel::ShareRig(_In_ const BenchmarkModel& rig)
+{
+    m_globalInverseTransform = rig.m_globalInverseTransform;
+    m_skeleton = rig.m_skeleton;
+    m_aGlobalTransforms.resize(rig.m_aGlobalTransforms.size());
+    m_aTransforms.assign(rig.m_aTransforms.size(), XMMatrixIdentity());
+    m_aAnimationClips = rig.m_aAnimationClips;
+    m_aAnimationClipStatistics = rig.m_aAnimationClipStatistics;
+    m_aNodeTracks = rig.m_aNodeTracks;
+    m_aReferencePoses = rig.m_aReferencePoses;
+    m_aAnimationLayers = rig.m_aAnimationLayers;
+    m_aTrackTranslations.resize(rig.m_aTrackTranslations.size());
+    m_aTrackRotations.resize(rig.m_aTrackRotations.size());
+    m_aTrackScales.resize(rig.m_aTrackScales.size());
+    m_pose.Resize(m_skeleton->GetNumNodes());
+    m_layerPose.Resize(m_skeleton->GetNumNodes());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::ReadNodeHierarchy
+
+  Summary:  Computes the bone transforms of the tracks of the last
+            update by recursing through the assimp nodes, looking up
+            the track and the bone of every node by name, the way
+            Model did before the skeleton was flattened
+
+  Args:     const aiNode* pNode
+              Pointer to an assimp node object
+            const XMMATRIX& parentTransform
+              Parent transform in hierarchy
+
+  Modifies: [m_aTransforms].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkModel::ReadNodeHierarchy(_In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform)
+{
+    UINT uTrack = m_aAnimationClips.empty() ? library::AnimationClip::INVALID_TRACK : m_aAnimationClips[0]->FindTrack(pNode->mName.C_Str());
+    XMMATRIX nodeTransformation = XMMatrixTranspose(XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(&pNode->mTransformation)));
+    if (uTrack != library::AnimationClip::INVALID_TRACK)
+    {
+        XMMATRIX scalingMatrix = XMMatrixScalingFromVector(m_aTrackScales[uTrack]);
+        XMMATRIX rotationMatrix = XMMatrixRotationQuaternion(m_aTrackRotations[uTrack]);
+        XMMATRIX translationMatrix = XMMatrixTranslationFromVector(m_aTrackTranslations[uTrack]);
+
+        nodeTransformation = scalingMatrix * rotationMatrix * translationMatrix;
+    }
+
+    XMMATRIX globalTransformation = nodeTransformation * parentTransform;
+    auto it_bone = m_boneNameToIndexMap.find(pNode->mName.C_Str());
+    if (it_bone != m_boneNameToIndexMap.end())
+    {
+        m_aTransforms[it_bone->second] = m_aBoneInfo[it_bone->second].OffsetMatrix * globalTransformation * m_globalInverseTransform;
+    }
+
+    for (UINT i = 0; i < pNode->mNumChildren; ++i)
+    {
+        ReadNodeHierarchy(pNode->mChildren[i], globalTransformation);
+    }
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::EvaluateSkeleton
+
+  Summary:  Computes the bone transforms of the tracks of the last
+            update over the skeleton, the way Model::Update does, or
+            the bind pose when the model is not animated
+
+  Modifies: [m_aGlobalTransforms, m_aTransforms].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkModel::EvaluateSkeleton()
+{
+    m_skeleton->Evaluate(m_aNodeTracks.empty() ? nullptr : m_aNodeTracks[0].data(),
+        m_aTrackTranslations.data(), m_aTrackRotations.data(), m_aTrackScales.data(), 0u,
+        m_globalInverseTransform, m_aGlobalTransforms.data(), m_aTransforms.data());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::GetAnimation
+
+  Summary:  Returns the first animation of the model file
+
+  Returns:  const aiAnimation*
+              Animation, nullptr if the model is not animated
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const aiAnimation* BenchmarkModel::GetAnimation() const
+{
+    return m_pScene && m_pScene->HasAnimations() ? m_pScene->mAnimations[0] : nullptr;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::GetRootNode
+
+  Summary:  Returns the root node of the model file
+
+  Returns:  const aiNode*
+              Root node, nullptr before Load
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const aiNode* BenchmarkModel::GetRootNode() const
+{
+    return m_pScene ? m_pScene->mRootNode : nullptr;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   BenchmarkModel::GetMaxSkinningError
+
+  Summary:  Skins every vertex with the bone transforms of the last
+            update, once with every bone weight of the model file, the
+            way the vertices were skinned before the import pruned and
+            quantized the weights, and once with the animation data of
+            the model, and returns the largest distance between both
+
+  Returns:  FLOAT
+              Distance in model space, 0 before Load or without
+              bones
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FLOAT BenchmarkModel::GetMaxSkinningError() const
+{
+    if (!m_pScene || m_aTransforms.empty())
+    {
+        return 0.0f;
+    }
+
+    std::vector<XMVECTOR> aReferencePositions(m_aVertices.size(), XMVectorZero());
+    for (UINT uMesh = 0u; uMesh < m_pScene->mNumMeshes; ++uMesh)
+    {
+        const aiMesh* pMesh = m_pScene->mMeshes[uMesh];
+        for (UINT uBone = 0u; uBone < pMesh->mNumBones; ++uBone)
+        {
+            const aiBone* pBone = pMesh->mBones[uBone];
+            const XMMATRIX& boneTransform = m_aTransforms[m_boneNameToIndexMap.at(pBone->mName.C_Str())];
+            for (UINT i = 0u; i < pBone->mNumWeights; ++i)
+            {
+                UINT uVertex = m_aMeshes[uMesh].uBaseVertex + pBone->mWeights[i].mVertexId;
+                XMVECTOR position = XMVector3Transform(XMLoadFloat3(&m_aVertices[uVertex].Position), boneTransform);
+                aReferencePositions[uVertex] = XMVectorMultiplyAdd(XMVectorReplicate(pBone->mWeights[i].mWeight), position, aReferencePositions[uVertex]);
+            }
+        }
+    }
+
+    FLOAT maxError = 0.0f;
+    for (size_t uVertex = 0u; uVertex < m_aVertices.size(); ++uVertex)
+    {
+        XMVECTOR position = XMVectorZero();
+        for (UINT i = 0u; i < MAX_NUM_BONES_PER_VERTEX; ++i)
+        {
+            FLOAT weight = static_cast<FLOAT>(m_aAnimationData[uVertex].aBoneWeights[i]) / 255.0f;
+            XMVECTOR bonePosition = XMVector3Transform(XMLoadFloat3(&m_aVertices[uVertex].Position), m_aTransforms[m_aAnimationData[uVertex].aBoneIndices[i]]);
+            position = XMVectorMultiplyAdd(XMVectorReplicate(weight), bonePosition, position);
+        }
+
+        FLOAT error = XMVectorGetX(XMVector3Length(XMVectorSubtract(position, aReferencePositions[uVertex])));
+        maxError = error > maxError ? error : maxError;
+    }
+
+    return maxError;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: registerHierarchyBenchmarks
+  Summary:  Registers the recursive walk of the assimp nodes and the
+            pass over the flattened skeleton of a model, which compute
+            the same bone transforms
+  Args:     BenchmarkRunner& runner
+              Runner to register the benchmarks into
+            const std::shared_ptr<BenchmarkModel>& model
+              Loaded model
+            PCSTR pszModelName
+              Name of the model in the benchmark names
+-----------------------------------------------------------------F-F*/
+static void registerHierarchyBenchmarks(BenchmarkRunner& runner, const std::shared_ptr<BenchmarkModel>& model, PCSTR pszModelName)
+{
+    runner.Register(std::string("Model::readNodeHierarchy/") + pszModelName, [model](uint64_t uIterations)
+    {
+        XMMATRIX identity = XMMatrixIdentity();
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            model->ReadNodeHierarchy(model->GetRootNode(), identity);
+        }
+    });
+    runner.Register(std::string("Skeleton::Evaluate/") + pszModelName, [model](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            model->EvaluateSkeleton();
+        }
+    });
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createCharacters
+  Summary:  Creates characters sharing a rig, each blending its first
+            clip with another one from its own time
+  Args:     const BenchmarkModel& rig
+              Model made by CreateRig, with at least two clips
+            UINT uNumCharacters
+              Number of characters
+  Returns:  std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>>
+              Characters
+-----------------------------------------------------------------F-F*/
+static std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> createCharacters(const BenchmarkModel& rig, UINT uNumCharacters)
+{
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aCharacters = std::make_shared<std::vector<std::shared_ptr<BenchmarkModel>>>();
+    for (UINT i = 0u; i < uNumCharacters; ++i)
+    {
+        std::shared_ptr<BenchmarkModel> character = std::make_shared<BenchmarkModel>("Character");
+        character->ShareRig(rig);
+        character->SetAnimationTime(0u, 0.001f * static_cast<FLOAT>(i));
+        character->PlayAnimation(
+            library::AnimationLayerDesc
+            {
+                .uClip = 1u + i % (rig.GetNumAnimations() - 1u),
+                .time = 0.003f * static_cast<FLOAT>(i),
+                .speed = 1.0f,
+                .weight = 0.5f,
+                .bLoop = TRUE,
+                .bAdditive = FALSE
+            }
+        );
+        aCharacters->push_back(character);
+    }
+
+    return aCharacters;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createClipCharacters
+  Summary:  Creates characters sharing a rig, all playing its first
+            clip alone in 16 phases, each character a few
+            milliseconds off the phase of its group
+  Args:     const BenchmarkModel& rig
+              Model made by CreateRig
+            UINT uNumCharacters
+              Number of characters
+            const std::shared_ptr<library::PoseCache>& poseCache
+              Cache sharing the poses, nullptr to evaluate every pose
+  Returns:  std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>>
+              Characters
+-----------------------------------------------------------------F-F*/
+static std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> createClipCharacters(const BenchmarkModel& rig, UINT uNumCharacters, const std::shared_ptr<library::PoseCache>& poseCache)
+{
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aCharacters = std::make_shared<std::vector<std::shared_ptr<BenchmarkModel>>>();
+    for (UINT i = 0u; i < uNumCharacters; ++i)
+    {
+        std::shared_ptr<BenchmarkModel> character = std::make_shared<BenchmarkModel>("Character");
+        character->ShareRig(rig);
+        character->SetAnimationTime(0u, 0.125f * static_cast<FLOAT>(i % 16u) + 0.002f * static_cast<FLOAT>((i / 16u) % 3u));
+        character->SetPoseCache(poseCache);
+        aCharacters->push_back(character);
+    }
+
+    return aCharacters;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: updateCharacters
+  Summary:  Updates every character on a thread pool, a few
+            characters per job, the way Scene::Update does
+  Args:     library::ThreadPool& threadPool
+              Pool running the jobs
+            const std::vector<std::shared_ptr<BenchmarkModel>>& aCharacters
+              Characters to update
+            FLOAT deltaTime
+              Time difference of a frame
+-----------------------------------------------------------------F-F*/
+static void updateCharacters(library::ThreadPool& threadPool, const std::vector<std::shared_ptr<BenchmarkModel>>& aCharacters, FLOAT deltaTime)
+{
+    threadPool.ParallelFor(static_cast<UINT>(aCharacters.size()), 4u, [&aCharacters, deltaTime](UINT uBegin, UINT uEnd)
+    {
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            aCharacters[i]->Update(deltaTime);
+        }
+    });
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: checkSkinningError
+  Summary:  Checks that the pruned and quantized bone weights of a
+            model move none of its skinned vertices by more than a
+            hundredth of the half diagonal of its bind pose bounds
+  Args:     const BenchmarkModel& model
+              Loaded model, with the bone transforms of an update
+            PCSTR pszModelName
+              Name of the model in the messages
+  Returns:  HRESULT
+              Status code, E_FAIL if a vertex moves too far
+-----------------------------------------------------------------F-F*/
+static HRESULT checkSkinningError(const BenchmarkModel& model, PCSTR pszModelName)
+{
+    BoundingBox bounds;
+    BoundingBox::CreateFromPoints(bounds, model.GetNumVertices(), &model.getVertices()->Position, sizeof(library::SimpleVertex));
+    FLOAT tolerance = 0.01f * XMVectorGetX(XMVector3Length(XMLoadFloat3(&bounds.Extents)));
+
+    FLOAT maxError = model.GetMaxSkinningError();
+    std::printf("%s moves its skinned vertices by at most %f with 4 quantized bone weights per vertex\n", pszModelName, maxError);
+    if (maxError > tolerance)
+    {
+        std::fprintf(stderr, "The quantized bone weights of %s move a skinned vertex by %f, more than %f\n", pszModelName, maxError, tolerance);
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: fillFullSkinningConstants
+  Summary:  Transposes every bone transform into skinning constants of
+            MAX_NUM_BONES matrices and clears the unused bones, the way
+            the skinning constants were filled before the bone palette
+  Args:     const std::vector<XMMATRIX>& aBoneTransforms
+              Bone transforms of a model
+            XMMATRIX* aSkinningConstants
+              MAX_NUM_BONES matrices to fill
+-----------------------------------------------------------------F-F*/
+static void fillFullSkinningConstants(const std::vector<XMMATRIX>& aBoneTransforms, XMMATRIX* aSkinningConstants)
+{
+    for (size_t i = 0u; i < aBoneTransforms.size(); ++i)
+    {
+        aSkinningConstants[i] = XMMatrixTranspose(aBoneTransforms[i]);
+    }
+    ZeroMemory(aSkinningConstants + aBoneTransforms.size(), (MAX_NUM_BONES - aBoneTransforms.size()) * sizeof(XMMATRIX));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterKernelBenchmarks
+  Summary:  Loads the data of the kernels that need the Library
+            models and scenes and registers a benchmark for every
+            kernel:
+              the cost of an empty profiled zone, which has to stay
+              below 50 ns, the float and quantized position stream
+              extraction of the nanosuit, the recursive node hierarchy
+              and the flattened skeleton of BobLampClean, the packing
+              of its bone palette and the full skinning constants it
+              replaced, the node hierarchy and skeleton of the
+              cyborg when it can be read, after checking that the
+              pruned and quantized bone weights of both models skin
+              their vertices close to every weight of the model file,
+              the update of a generated
+              100 bone rig playing one clip, blending four clips and
+              adding an additive clip on three, the update of 1000
+              characters sharing the rig on one to every thread, the
+              update of characters playing one clip
+              with and without the pose cache, the update of a
+              crowd of them at full rate and at the animation level
+              of detail of a camera, the baking of the clips of the
+              rig, the update of characters playing baked frames, and the instance
+              generation of InstanceBatcher and its front-to-back
+              sort for a camera circling the voxels
+  Args:     BenchmarkRunner& runner
+              Runner to register the benchmarks into
+            const std::filesystem::path& contentDirectory
+              Content directory of the game
+  Returns:  HRESULT
+              Status code, E_FAIL if the content can not be read
+-----------------------------------------------------------------F-F*/
+HRESULT RegisterKernelBenchmarks(_Inout_ BenchmarkRunner& runner, _In_ const std::filesystem::path& contentDirectory)
+{
+    // The scope is used directly, so the zone is timed whether or not this build defines LIBRARY_PROFILING
+    runner.Register("ProfileScope/EmptyZone", [](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            library::ProfileScope profileScope("Microbenchmark", "EmptyZone");
+        }
+    });
+
+    std::shared_ptr<BenchmarkModel> nanosuit = std::make_shared<BenchmarkModel>(contentDirectory / "nanosuit" / "nanosuit.obj");
+    HRESULT hr = nanosuit->Load();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    std::shared_ptr<library::PositionStream> positionStream = std::make_shared<library::PositionStream>();
+    for (BOOL bQuantize : { FALSE, TRUE })
+    {
+        runner.Register(std::string("PositionStream::Extract/Nanosuit") + (bQuantize ? "Quantized" : "Float"), [nanosuit, positionStream, bQuantize](uint64_t uIterations)
+        {
+            for (uint64_t i = 0u; i < uIterations; ++i)
+            {
+                positionStream->Extract(nanosuit->getVertices(), nanosuit->GetNumVertices(), bQuantize);
+                BenchmarkRunner::KeepAlive(positionStream->GetOffset());
+            }
+        });
+    }
+
+    std::shared_ptr<BenchmarkModel> bobLamp = std::make_shared<BenchmarkModel>(contentDirectory / "BobLampClean" / "boblampclean.md5mesh");
+    hr = bobLamp->Load();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (!bobLamp->GetAnimation() || !bobLamp->GetRootNode())
+    {
+        return E_FAIL;
+    }
+
+    // The hierarchy is walked over the tracks of the last update
+    bobLamp->Update(0.1f);
+    registerHierarchyBenchmarks(runner, bobLamp, "BobLampClean");
+
+    // The bone weights were pruned to 4 and quantized when the model was read
+    hr = checkSkinningError(*bobLamp, "BobLampClean");
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // The bone palette is packed from the transforms of the last update, against the full skinning constants it replaced
+    std::shared_ptr<std::vector<library::PackedBoneTransform>> aBonePalette = std::make_shared<std::vector<library::PackedBoneTransform>>(MAX_NUM_BONES);
+    std::shared_ptr<std::vector<XMMATRIX>> aSkinningConstants = std::make_shared<std::vector<XMMATRIX>>(MAX_NUM_BONES);
+    std::printf(
+        "BobLampClean uploads %zu bytes of bone palette per model instead of %zu bytes of skinning constants\n",
+        bobLamp->GetBoneTransforms().size() * sizeof(library::PackedBoneTransform),
+        aSkinningConstants->size() * sizeof(XMMATRIX)
+    );
+    runner.Register("Model::FillBonePalette/BobLampClean", [bobLamp, aBonePalette](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            BenchmarkRunner::KeepAlive(bobLamp->FillBonePalette(aBonePalette->data()));
+            BenchmarkRunner::KeepAlive((*aBonePalette)[0]);
+        }
+    });
+    runner.Register("FillFullSkinningConstants/BobLampClean", [bobLamp, aSkinningConstants](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            fillFullSkinningConstants(bobLamp->GetBoneTransforms(), aSkinningConstants->data());
+            BenchmarkRunner::KeepAlive((*aSkinningConstants)[0]);
+        }
+    });
+
+    // The cyborg only ships as a Blender file, which needs an assimp built with the Blender importer
+    std::shared_ptr<BenchmarkModel> cyborg = std::make_shared<BenchmarkModel>(contentDirectory / "cyborg" / "cyborg.blend");
+    if (SUCCEEDED(cyborg->Load()))
+    {
+        cyborg->Update(0.1f);
+        registerHierarchyBenchmarks(runner, cyborg, "Cyborg");
+
+        hr = checkSkinningError(*cyborg, "Cyborg");
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+    else
+    {
+        std::fprintf(stderr, "Skipping the cyborg benchmarks, %s can not be read\n", cyborg->GetFilePath().string().c_str());
+    }
+
+    // A rig of 100 bones playing one clip, four clips blended, and three clips blended under an additive one
+    const std::pair<UINT, UINT> aLayerCounts[] = { { 1u, 0u }, { 4u, 0u }, { 3u, 1u } };
+    for (const std::pair<UINT, UINT>& layerCount : aLayerCounts)
+    {
+        std::shared_ptr<BenchmarkModel> rig = std::make_shared<BenchmarkModel>("Rig100Bones");
+        rig->CreateRig(100u, 4u);
+        for (UINT uClip = 1u; uClip < layerCount.first + layerCount.second; ++uClip)
+        {
+            rig->PlayAnimation(
+                library::AnimationLayerDesc
+                {
+                    .uClip = uClip,
+                    .time = 0.25f * static_cast<FLOAT>(uClip),
+                    .speed = 1.0f,
+                    .weight = 1.0f / static_cast<FLOAT>(uClip + 1u),
+                    .bLoop = TRUE,
+                    .bAdditive = uClip >= layerCount.first
+                }
+            );
+        }
+
+        std::string szName = "Model::Update/Rig100Bones" + std::to_string(layerCount.first) + (layerCount.first > 1u ? "Clips" : "Clip");
+        if (layerCount.second > 0u)
+        {
+            szName += std::to_string(layerCount.second) + "Additive";
+        }
+        runner.Register(szName, [rig](uint64_t uIterations)
+        {
+            for (uint64_t i = 0u; i < uIterations; ++i)
+            {
+                rig->Update(1.0f / 60.0f);
+                BenchmarkRunner::KeepAlive(rig->GetBoneTransforms()[0]);
+            }
+        });
+    }
+
+    // 1000 characters sharing a rig of 100 bones, updated on one thread to every thread. UnitTests checks that the
+    // threads do not change their bone transforms
+    constexpr const UINT NUM_CHARACTERS = 1000u;
+    const UINT uNumHardwareThreads = std::thread::hardware_concurrency() > 1u ? std::thread::hardware_concurrency() : 1u;
+    std::shared_ptr<BenchmarkModel> characterRig = std::make_shared<BenchmarkModel>("Rig100Bones");
+    characterRig->CreateRig(100u, 4u);
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aCharacters = createCharacters(*characterRig, NUM_CHARACTERS);
+    std::vector<UINT> aThreadCounts;
+    for (UINT uNumThreads = 1u; uNumThreads < uNumHardwareThreads; uNumThreads *= 2u)
+    {
+        aThreadCounts.push_back(uNumThreads);
+    }
+    aThreadCounts.push_back(uNumHardwareThreads);
+    for (UINT uNumThreads : aThreadCounts)
+    {
+        std::shared_ptr<library::ThreadPool> threadPool = std::make_shared<library::ThreadPool>(uNumThreads - 1u);
+        runner.Register("Model::Update/1000Characters" + std::to_string(uNumThreads) + "Threads", [threadPool, aCharacters](uint64_t uIterations)
+        {
+            for (uint64_t i = 0u; i < uIterations; ++i)
+            {
+                updateCharacters(*threadPool, *aCharacters, 1.0f / 60.0f);
+                BenchmarkRunner::KeepAlive(aCharacters->back()->GetBoneTransforms()[0]);
+            }
+        });
+    }
+
+    // 1000 characters playing one clip in 16 phases, evaluating every pose and sharing them through a pose cache
+    // like the models of a scene
+    std::shared_ptr<library::PoseCache> poseCache = std::make_shared<library::PoseCache>(1.0f / 120.0f);
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aCachedCharacters = createClipCharacters(*characterRig, NUM_CHARACTERS, poseCache);
+    std::shared_ptr<library::ThreadPool> clipThreadPool = std::make_shared<library::ThreadPool>(0u);
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aUncachedCharacters = createClipCharacters(*characterRig, NUM_CHARACTERS, nullptr);
+    runner.Register("Model::Update/1000CharactersOneClip", [clipThreadPool, aUncachedCharacters](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            updateCharacters(*clipThreadPool, *aUncachedCharacters, 1.0f / 60.0f);
+            BenchmarkRunner::KeepAlive(aUncachedCharacters->back()->GetBoneTransforms()[0]);
+        }
+    });
+    runner.Register("Model::Update/1000CharactersOneClipPoseCache", [clipThreadPool, poseCache, aCachedCharacters](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            poseCache->BeginFrame();
+            updateCharacters(*clipThreadPool, *aCachedCharacters, 1.0f / 60.0f);
+            BenchmarkRunner::KeepAlive(aCachedCharacters->back()->GetBoneTransforms()[0]);
+        }
+    });
+
+    // The characters stand on a grid of 40 by 25 in front of a camera, the first rows behind it, and are updated
+    // on one thread at full rate and at the animation level of detail the renderer picks for the camera, in the
+    // update phases Scene::AddModel gives them
+    const XMMATRIX crowdView = XMMatrixLookToLH(XMVectorSet(0.0f, 1.7f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    const XMMATRIX crowdProjection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+    const BoundingBox characterBounds(XMFLOAT3(0.0f, 0.9f, 0.0f), XMFLOAT3(0.4f, 0.9f, 0.4f));
+    library::AnimationLodPolicy lodPolicy(
+        {
+            .boundsScale = 1.5f,
+            .fullRateCoverage = 0.25f,
+            .uMaxUpdateInterval = 4u,
+            .uMaxSkippedLevels = 2u
+        }
+    );
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aCrowdCharacters = createCharacters(*characterRig, NUM_CHARACTERS);
+    for (UINT i = 0u; i < NUM_CHARACTERS; ++i)
+    {
+        XMMATRIX world = XMMatrixTranslation(2.0f * static_cast<FLOAT>(i % 40u) - 40.0f, 0.0f, 10.0f * static_cast<FLOAT>(i / 40u) - 40.0f);
+        (*aCrowdCharacters)[i]->SetAnimationLod(lodPolicy.Select(characterBounds, world, crowdView, crowdProjection));
+        (*aCrowdCharacters)[i]->SetUpdatePhase(i);
+    }
+    std::shared_ptr<library::ThreadPool> crowdThreadPool = std::make_shared<library::ThreadPool>(0u);
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aFullRateCharacters = createCharacters(*characterRig, NUM_CHARACTERS);
+    runner.Register("Model::Update/1000CharactersCrowdFullRate", [crowdThreadPool, aFullRateCharacters](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            updateCharacters(*crowdThreadPool, *aFullRateCharacters, 1.0f / 60.0f);
+            BenchmarkRunner::KeepAlive(aFullRateCharacters->back()->GetBoneTransforms()[0]);
+        }
+    });
+    runner.Register("Model::Update/1000CharactersCrowdLod", [crowdThreadPool, aCrowdCharacters](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            updateCharacters(*crowdThreadPool, *aCrowdCharacters, 1.0f / 60.0f);
+            BenchmarkRunner::KeepAlive(aCrowdCharacters->back()->GetBoneTransforms()[0]);
+        }
+    });
+
+    // The clips of the rig are baked at 60 frames per second. UnitTests checks the size of the frames and that they
+    // hold the bone transforms a model evaluates at their time
+    constexpr const FLOAT BAKED_FRAMES_PER_SECOND = 60.0f;
+    std::shared_ptr<BenchmarkModel> bakedRig = std::make_shared<BenchmarkModel>("Rig100Bones");
+    bakedRig->ShareRig(*characterRig);
+    hr = bakedRig->BakeAnimations(nullptr, BAKED_FRAMES_PER_SECOND);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    std::shared_ptr<library::BakedAnimation> bakedAnimation = bakedRig->GetBakedAnimation();
+    std::printf("Rig100Bones bakes %u frames into %zu bytes\n", bakedAnimation->GetNumFrames(), bakedAnimation->GetSizeInBytes());
+    runner.Register("Model::BakeAnimations/Rig100Bones4Clips", [bakedRig](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            bakedRig->BakeAnimations(nullptr, BAKED_FRAMES_PER_SECOND);
+            BenchmarkRunner::KeepAlive(bakedRig->GetBakedAnimation()->GetSizeInBytes());
+        }
+    });
+
+    // The characters playing one clip in 16 phases play its baked frames instead, and only write the frame offset
+    // of their instance
+    std::shared_ptr<std::vector<std::shared_ptr<BenchmarkModel>>> aBakedCharacters = createClipCharacters(*characterRig, NUM_CHARACTERS, nullptr);
+    for (const std::shared_ptr<BenchmarkModel>& character : *aBakedCharacters)
+    {
+        character->SetBakedAnimation(bakedAnimation);
+    }
+    std::shared_ptr<std::vector<UINT>> aFrameOffsets = std::make_shared<std::vector<UINT>>(NUM_CHARACTERS);
+    runner.Register("Model::Update/1000CharactersBaked", [clipThreadPool, aBakedCharacters, aFrameOffsets](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            updateCharacters(*clipThreadPool, *aBakedCharacters, 1.0f / 60.0f);
+            for (size_t j = 0u; j < aBakedCharacters->size(); ++j)
+            {
+                (*aFrameOffsets)[j] = (*aBakedCharacters)[j]->GetBakedFrameOffset();
+            }
+            BenchmarkRunner::KeepAlive(aFrameOffsets->back());
+        }
+    });
+
+    // 4096 voxels of four colors, grouped into four instanced draws
+    constexpr const UINT NUM_VOXELS = 4096u;
+    const XMFLOAT4 aColors[] =
+    {
+        XMFLOAT4(0.0f, 0.0f, 0.666f, 1.0f),
+        XMFLOAT4(1.0f, 0.666f, 0.0f, 1.0f),
+        XMFLOAT4(0.0f, 0.666f, 0.0f, 1.0f),
+        XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
+    };
+    std::shared_ptr<std::vector<std::shared_ptr<library::Voxel>>> aVoxels = std::make_shared<std::vector<std::shared_ptr<library::Voxel>>>();
+    std::shared_ptr<std::vector<std::wstring>> aVoxelNames = std::make_shared<std::vector<std::wstring>>();
+    for (UINT i = 0u; i < NUM_VOXELS; ++i)
+    {
+        std::shared_ptr<library::Voxel> voxel = std::make_shared<library::Voxel>(aColors[i % ARRAYSIZE(aColors)]);
+        voxel->Translate(XMVectorSet(static_cast<FLOAT>(i % 64u) * 2.0f, 0.0f, static_cast<FLOAT>(i / 64u) * 2.0f, 0.0f));
+        aVoxels->push_back(voxel);
+        aVoxelNames->push_back(L"Voxel" + std::to_wstring(i));
+    }
+    std::shared_ptr<library::InstanceBatcher> instanceBatcher = std::make_shared<library::InstanceBatcher>();
+    runner.Register("InstanceBatcher::Build/4096Voxels", [aVoxels, aVoxelNames, instanceBatcher](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            instanceBatcher->Reset();
+            for (size_t j = 0u; j < aVoxels->size(); ++j)
+            {
+                instanceBatcher->AddRenderable((*aVoxelNames)[j].c_str(), *(*aVoxels)[j]);
+            }
+            instanceBatcher->Build();
+            BenchmarkRunner::KeepAlive(instanceBatcher->GetNumInstances());
+        }
+    });
+
+    // The camera circles the voxels, so every sort reorders the instances of the previous one
+    std::shared_ptr<library::InstanceBatcher> sortedInstanceBatcher = std::make_shared<library::InstanceBatcher>();
+    for (size_t j = 0u; j < aVoxels->size(); ++j)
+    {
+        sortedInstanceBatcher->AddRenderable((*aVoxelNames)[j].c_str(), *(*aVoxels)[j]);
+    }
+    sortedInstanceBatcher->Build();
+    runner.Register("InstanceBatcher::SortFrontToBack/4096Voxels", [sortedInstanceBatcher](uint64_t uIterations)
+    {
+        for (uint64_t i = 0u; i < uIterations; ++i)
+        {
+            FLOAT angle = static_cast<FLOAT>(i % 8u) * XM_PIDIV4;
+            XMVECTOR eye = XMVectorSet(64.0f + 96.0f * std::cos(angle), 16.0f, 64.0f + 96.0f * std::sin(angle), 0.0f);
+            sortedInstanceBatcher->SortFrontToBack(XMMatrixLookAtLH(eye, XMVectorSet(64.0f, 0.0f, 64.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+            BenchmarkRunner::KeepAlive(sortedInstanceBatcher->GetGroups().front().uFirstInstance);
+        }
+    });
+
+    return S_OK;
+}
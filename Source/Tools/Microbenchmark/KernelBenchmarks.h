@@ -0,0 +1,82 @@
+/*+===================================================================
+  File:      KERNELBENCHMARKS.H
+
+  Summary:   KernelBenchmarks header file contains declarations of
+             BenchmarkModel class that exposes the CPU kernels of Model
+             to the benchmarks, and of the function registering the
+             benchmarks of the engine kernels that need the Windows
+             and Direct3D headers of the Library.
+
+  Classes: BenchmarkModel
+
+  Functions: RegisterKernelBenchmarks
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Benchmark.h"
+#include "Model/Model.h"
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    BenchmarkModel
+
+  Summary:  Model that loads its geometry, bones and animation without
+            a Direct3D device and makes the protected kernels of Model
+            and Renderable callable by the benchmarks. The model owns
+            its assimp scene, so loading another model does not free it.
+            A model can also be made of a generated rig instead of a
+            file
+
+  Methods:  Load
+              Reads the model file and its geometry
+            CreateRig
+              Builds a generated skeleton and clips
+            ShareRig
+              Plays the skeleton and clips of another model
+            ReadNodeHierarchy
+              Computes the bone transforms by recursing through the
+              assimp nodes, the path the skeleton replaced
+            EvaluateSkeleton
+              Computes the bone transforms over the skeleton
+            GetAnimation
+              Returns the first animation of the model file
+            GetRootNode
+              Returns the root node of the model file
+            GetMaxSkinningError
+              Returns the largest distance the pruning and
+              quantization of the bone weights moves a skinned vertex
+            BenchmarkModel
+              Constructor.
+            ~BenchmarkModel
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class BenchmarkModel final : public library::Model
+{
+public:
+    BenchmarkModel(_In_ const std::filesystem::path& filePath);
+    BenchmarkModel(const BenchmarkModel& other) = delete;
+    BenchmarkModel(BenchmarkModel&& other) = delete;
+    BenchmarkModel& operator=(const BenchmarkModel& other) = delete;
+    BenchmarkModel& operator=(BenchmarkModel&& other) = delete;
+    ~BenchmarkModel() = default;
+
+    HRESULT Load();
+    void CreateRig(_In_ UINT uNumNodes, _In_ UINT uNumClips);
+    void ShareRig(_In_ const BenchmarkModel& rig);
+    void ReadNodeHierarchy(_In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+    void EvaluateSkeleton();
+    const aiAnimation* GetAnimation() const;
+    const aiNode* GetRootNode() const;
+    FLOAT GetMaxSkinningError() const;
+
+    using library::Model::getIndices;
+    using library::Model::getVertices;
+
+private:
+    std::shared_ptr<const aiScene> m_scene;
+};
+
+HRESULT RegisterKernelBenchmarks(_Inout_ BenchmarkRunner& runner, _In_ const std::filesystem::path& contentDirectory);
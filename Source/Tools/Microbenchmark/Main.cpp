@@ -0,0 +1,116 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Command line microbenchmarks of the CPU kernels of the
+             engine. Every kernel runs until a repetition lasts the
+             minimum time, the median time per call is printed and
+             written as JSON, and CompareBenchmarks.py compares the
+             JSON of two runs.
+
+             The kernels are timed without a Direct3D device. The
+             kernels of CoreBenchmarks.cpp only include CoreCommon.h,
+             so they also build on Linux with DirectXMath, its sal.h
+             and assimp installed, for instance from vcpkg, and the
+             kernels of KernelBenchmarks.cpp, which need the models
+             and scenes of the Library, are left out. Add -ltbb when
+             the standard library runs the parallel algorithms on TBB:
+               g++ -std=c++20 -O2 -I<DirectXMath and sal.h> -I../../Library
+                 Main.cpp Benchmark.cpp CoreBenchmarks.cpp
+                 ../../Library/Model/{AnimationClip,AnimationLod,CompressedAnimationClip,Pose,Skeleton}.cpp
+                 ../../Library/Renderer/{LightClusterer,ShadowCascades,ShadowCasterCache,TangentSpace,ViewSet}.cpp
+                 ../../Library/Scene/{HeightMap,PerlinNoise}.cpp
+                 -lassimp -o Microbenchmark
+
+             Usage:
+               Microbenchmark [--filter <text>] [--json <file>]
+                              [--content <directory>]
+                              [--min-time <seconds>]
+                              [--repetitions <count>]
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Benchmark.h"
+#include "CoreBenchmarks.h"
+#if defined(_WIN32)
+#include "KernelBenchmarks.h"
+#endif
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+  Summary:  Parses the options, registers and runs the benchmarks and
+            writes their results
+  Args:     int argc
+              Number of arguments
+            char* argv[]
+              Arguments
+  Returns:  int
+              0 on success, 1 if the content can not be loaded or the
+              results can not be written
+-----------------------------------------------------------------F-F*/
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    const char* pszJsonFileName = "Microbenchmark.json";
+    std::filesystem::path contentDirectory = "../../Game/Content";
+    double minSeconds = 0.1;
+    uint32_t uNumRepetitions = 9u;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--filter") == 0)
+        {
+            filter = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--json") == 0)
+        {
+            pszJsonFileName = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--content") == 0)
+        {
+            contentDirectory = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0)
+        {
+            minSeconds = std::atof(argv[i + 1]);
+        }
+        else if (std::strcmp(argv[i], "--repetitions") == 0)
+        {
+            uNumRepetitions = static_cast<uint32_t>(std::atoi(argv[i + 1]));
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    BenchmarkRunner runner(minSeconds, uNumRepetitions);
+    HRESULT hr = RegisterCoreBenchmarks(runner, contentDirectory);
+#if defined(_WIN32)
+    if (SUCCEEDED(hr))
+    {
+        hr = RegisterKernelBenchmarks(runner, contentDirectory);
+    }
+#endif
+    if (FAILED(hr))
+    {
+        std::fprintf(stderr, "Failed to load the content in %s\n", contentDirectory.string().c_str());
+        return 1;
+    }
+
+    runner.Run(filter);
+
+    if (!runner.WriteJson(pszJsonFileName))
+    {
+        std::fprintf(stderr, "Failed to write %s\n", pszJsonFileName);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Command line replay of the resolution governor against
+             the frame times recorded by the benchmark mode of the
+             game. The recorded frames were rendered at full
+             resolution, so the time of a frame at a lower scale is
+             modelled as the recorded time with its pixel bound share
+             scaled by the pixel count. Prints how often the target is
+             missed with and without the governor, and optionally
+             writes the scale of every frame.
+
+             The governor only includes CoreCommon.h, so the replay
+             builds on Linux as well with DirectXMath and its sal.h:
+               g++ -std=c++20 -O2 -I<DirectXMath and sal.h>
+                   -I../../Library Main.cpp
+                   ../../Library/Renderer/ResolutionGovernor.cpp
+                   -o ResolutionReplay
+
+             Usage:
+               ResolutionReplay <benchmark csv> [--target-ms <ms>]
+                                [--pixel-share <0..1>]
+                                [--min-scale <scale>]
+                                [--csv <file>]
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Renderer/ResolutionGovernor.h"
+
+namespace
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: readFrameTimes
+      Summary:  Reads the frame_ms column of a benchmark CSV. The
+                percentile and memory rows at the end are skipped
+      Args:     const char* pszFileName
+                  Path of the CSV written by Game::RunBenchmark
+                std::vector<float>& aFrameTimes
+                  Receives the frame times in seconds
+      Returns:  bool
+                  Whether the file was read
+    -----------------------------------------------------------------F-F*/
+    bool readFrameTimes(const char* pszFileName, std::vector<float>& aFrameTimes)
+    {
+        std::ifstream file(pszFileName);
+        if (!file)
+        {
+            return false;
+        }
+
+        std::string line;
+        std::getline(file, line);
+        if (line.rfind("frame,", 0u) != 0u)
+        {
+            return false;
+        }
+
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] < '0' || line[0] > '9')
+            {
+                continue;
+            }
+
+            // frame,update_ms,render_ms,frame_ms
+            std::stringstream row(line);
+            std::vector<std::string> aColumns;
+            for (std::string column; std::getline(row, column, ',');)
+            {
+                aColumns.push_back(column);
+            }
+            if (aColumns.size() < 4u)
+            {
+                return false;
+            }
+            aFrameTimes.push_back(std::strtof(aColumns[3].c_str(), nullptr) / 1000.0f);
+        }
+
+        return !aFrameTimes.empty();
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: getPercentile
+      Summary:  Returns the nearest-rank percentile of the values
+      Args:     std::vector<float> aValues
+                  Values, copied to be sorted
+                float percentile
+                  Percentile between 0 and 100
+      Returns:  float
+                  Value at the percentile
+    -----------------------------------------------------------------F-F*/
+    float getPercentile(std::vector<float> aValues, float percentile)
+    {
+        std::sort(aValues.begin(), aValues.end());
+        size_t uRank = static_cast<size_t>(percentile / 100.0f * static_cast<float>(aValues.size()) + 0.5f);
+        return aValues[std::clamp<size_t>(uRank, 1u, aValues.size()) - 1u];
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+  Summary:  Replays the recorded frame times through the governor and
+            prints the misses of the target with and without it
+  Args:     int argc
+              Number of arguments
+            char* argv[]
+              Arguments
+  Returns:  int
+              0 on success, 1 if the options or files are invalid
+-----------------------------------------------------------------F-F*/
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: ResolutionReplay <benchmark csv> [--target-ms <ms>] [--pixel-share <0..1>] [--min-scale <scale>] [--csv <file>]\n");
+        return 1;
+    }
+
+    float targetMilliseconds = 1000.0f / 60.0f;
+    float pixelShare = 0.8f;
+    float minScale = 0.5f;
+    const char* pszOutputFileName = nullptr;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--target-ms") == 0)
+        {
+            targetMilliseconds = std::strtof(argv[i + 1], nullptr);
+        }
+        else if (std::strcmp(argv[i], "--pixel-share") == 0)
+        {
+            pixelShare = std::clamp(std::strtof(argv[i + 1], nullptr), 0.0f, 1.0f);
+        }
+        else if (std::strcmp(argv[i], "--min-scale") == 0)
+        {
+            minScale = std::clamp(std::strtof(argv[i + 1], nullptr), 0.1f, 1.0f);
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0)
+        {
+            pszOutputFileName = argv[i + 1];
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::vector<float> aRecordedFrameTimes;
+    if (!readFrameTimes(argv[1], aRecordedFrameTimes))
+    {
+        std::fprintf(stderr, "Failed to read the frame times of %s\n", argv[1]);
+        return 1;
+    }
+
+    library::ResolutionGovernor governor(
+        {
+            .targetFrameTime = targetMilliseconds / 1000.0f,
+            .minScale = minScale,
+            .maxScale = 1.0f,
+            .scaleStep = 0.05f,
+            .proportionalGain = 0.3f,
+            .integralGain = 0.05f,
+            .hysteresis = 0.05f,
+            .uHistoryLength = 8u
+        }
+    );
+
+    std::ofstream output;
+    if (pszOutputFileName)
+    {
+        output.open(pszOutputFileName, std::ios::trunc);
+        if (!output)
+        {
+            std::fprintf(stderr, "Failed to write %s\n", pszOutputFileName);
+            return 1;
+        }
+        output.setf(std::ios::fixed);
+        output.precision(4);
+        output << "frame,recorded_ms,scale,governed_ms\n";
+    }
+
+    std::vector<float> aGovernedFrameTimes(aRecordedFrameTimes.size());
+    uint32_t uNumScaleChanges = 0u;
+    double scaleSum = 0.0;
+    for (size_t i = 0u; i < aRecordedFrameTimes.size(); ++i)
+    {
+        float scale = governor.GetScale();
+        aGovernedFrameTimes[i] = aRecordedFrameTimes[i] * ((1.0f - pixelShare) + pixelShare * scale * scale);
+        scaleSum += scale;
+        if (governor.AddFrameTime(aGovernedFrameTimes[i]) != scale)
+        {
+            ++uNumScaleChanges;
+        }
+
+        if (output.is_open())
+        {
+            output << i << ',' << aRecordedFrameTimes[i] * 1000.0f << ',' << scale << ',' << aGovernedFrameTimes[i] * 1000.0f << '\n';
+        }
+    }
+
+    float targetFrameTime = targetMilliseconds / 1000.0f;
+    auto countMisses = [targetFrameTime](const std::vector<float>& aFrameTimes)
+    {
+        return std::count_if(aFrameTimes.begin(), aFrameTimes.end(), [targetFrameTime](float frameTime) { return frameTime > targetFrameTime; });
+    };
+
+    std::printf("%-12s %10s %10s %10s %8s\n", "", "p50 ms", "p95 ms", "p99 ms", "Misses");
+    std::printf("%-12s %10.3f %10.3f %10.3f %8td\n", "Recorded",
+        getPercentile(aRecordedFrameTimes, 50.0f) * 1000.0f, getPercentile(aRecordedFrameTimes, 95.0f) * 1000.0f,
+        getPercentile(aRecordedFrameTimes, 99.0f) * 1000.0f, countMisses(aRecordedFrameTimes));
+    std::printf("%-12s %10.3f %10.3f %10.3f %8td\n", "Governed",
+        getPercentile(aGovernedFrameTimes, 50.0f) * 1000.0f, getPercentile(aGovernedFrameTimes, 95.0f) * 1000.0f,
+        getPercentile(aGovernedFrameTimes, 99.0f) * 1000.0f, countMisses(aGovernedFrameTimes));
+    std::printf("\n%zu frames, mean scale %.3f, %u scale changes\n",
+        aRecordedFrameTimes.size(), scaleSum / static_cast<double>(aRecordedFrameTimes.size()), uNumScaleChanges);
+
+    return 0;
+}
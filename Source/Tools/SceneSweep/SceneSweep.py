@@ -0,0 +1,155 @@
+"""Sweeps one axis of the synthetic scene generator and summarizes the benchmark of every step.
+
+Every step runs the game once with "-generate <cubes>,<models>,<voxel map size>,<lights>" and "-benchmark",
+so each step starts from a fresh process and its memory is not polluted by the previous steps. The summary
+CSV has one row per step with the frame time percentiles, the shadow draws per frame, the pose cache lookups
+per frame and hit rate, the memory reported by the game, and the percentiles of the render time, the time the
+CPU takes to build and submit a frame.
+
+When matplotlib is installed, the sweep is also plotted next to the summary CSV: the frame build and frame
+times against the swept axis, and the memory against the swept axis. Without matplotlib only the CSV is written.
+--plot-only plots a summary CSV written before without running the game again.
+
+    python SceneSweep.py --game ../../x64/Release/Game.exe --game-dir ../../Game --axis cubes --values 0 100 1000 10000
+    python SceneSweep.py --plot-only SceneSweep.csv
+"""
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+
+AXES = ("cubes", "models", "voxels", "lights")
+SUMMARY_ROWS = ("p50", "p95", "p99", "shadow_draws", "shadow_draws_skipped", "pose_cache_lookups", "pose_cache_hit_rate",
+                "peak_working_set_mb", "private_mb", "p50_render", "p95_render", "p99_render")
+SUMMARY_COLUMNS = ("p50_frame_ms", "p95_frame_ms", "p99_frame_ms", "shadow_draws", "shadow_draws_skipped", "pose_cache_lookups",
+                   "pose_cache_hit_rate", "peak_working_set_mb", "private_mb", "p50_render_ms", "p95_render_ms", "p99_render_ms")
+
+
+def read_benchmark(path):
+    summary = {}
+    with open(path, newline="") as file:
+        for row in csv.reader(file):
+            if row and row[0] in SUMMARY_ROWS:
+                # Percentile rows hold update, render and frame time, draw, pose cache and memory rows hold a single value
+                summary[row[0]] = float(row[-1])
+                if len(row) == 4:
+                    summary[row[0] + "_render"] = float(row[2])
+    return summary
+
+
+def plot_summary(path, axis, rows):
+    try:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as pyplot
+    except ImportError:
+        print("matplotlib is not installed, the sweep is not plotted", file=sys.stderr)
+        return
+
+    values = [row[0] for row in rows]
+
+    def column(name):
+        index = 1 + SUMMARY_COLUMNS.index(name)
+        return [row[index] if row[index] != "" else float("nan") for row in rows]
+
+    figure, (time_axes, memory_axes) = pyplot.subplots(1, 2, figsize=(12, 4.5))
+    for percentile, style in (("p50", "o-"), ("p95", "s--"), ("p99", "^:")):
+        time_axes.plot(values, column(f"{percentile}_render_ms"), style, color="tab:blue", label=f"frame build {percentile}")
+        time_axes.plot(values, column(f"{percentile}_frame_ms"), style, color="tab:orange", label=f"frame {percentile}")
+    time_axes.set_ylabel("CPU time (ms)")
+    time_axes.set_title("Frame time")
+    memory_axes.plot(values, column("peak_working_set_mb"), "o-", label="peak working set")
+    memory_axes.plot(values, column("private_mb"), "s--", label="private")
+    memory_axes.set_ylabel("memory (MB)")
+    memory_axes.set_title("Memory")
+    for axes in (time_axes, memory_axes):
+        # Sweeps usually grow by orders of magnitude from 0, which a linear axis squeezes into one corner
+        positive = [value for value in values if value > 0]
+        if positive and max(positive) >= 100 * min(positive):
+            axes.set_xscale("symlog", linthresh=min(positive))
+        axes.set_xlabel(axis)
+        axes.grid(True, alpha=0.3)
+        axes.legend(fontsize="small")
+    figure.tight_layout()
+
+    plot = os.path.splitext(path)[0] + ".png"
+    figure.savefig(plot, dpi=120)
+    pyplot.close(figure)
+    print(f"plotted {plot}")
+
+
+def read_summary(path):
+    with open(path, newline="") as file:
+        reader = csv.reader(file)
+        header = next(reader)
+        rows = [[float(value) if value != "" else "" for value in row] for row in reader]
+    if tuple(header[1:]) != SUMMARY_COLUMNS:
+        raise ValueError(f"{path} is not a summary of this version of SceneSweep.py")
+    return header[0], rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--plot-only", metavar="SUMMARY", help="plot a summary CSV instead of running a sweep")
+    parser.add_argument("--game", help="path of Game.exe")
+    parser.add_argument("--game-dir", help="working directory of the game, holding Content and Shaders")
+    parser.add_argument("--axis", choices=AXES, help="generated content to sweep")
+    parser.add_argument("--values", type=int, nargs="+", help="amount of the swept content of every step")
+    parser.add_argument("--base", default="0,0,0,1", help="cubes,models,voxels,lights of the axes that are not swept")
+    parser.add_argument("--path", default="Content/Benchmark/Flythrough.path", help="camera path, relative to the game directory")
+    parser.add_argument("--frames", type=int, default=300, help="frames rendered by every step")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the generator")
+    parser.add_argument("--output", default="SceneSweep.csv", help="summary CSV")
+    args = parser.parse_args()
+
+    if args.plot_only:
+        axis, rows = read_summary(args.plot_only)
+        plot_summary(args.plot_only, axis, rows)
+        return 0
+    for name in ("game", "game_dir", "axis", "values"):
+        if getattr(args, name) is None:
+            parser.error(f"--{name.replace('_', '-')} is required to run a sweep")
+
+    base = [int(value) for value in args.base.split(",")]
+    if len(base) != len(AXES):
+        parser.error("--base needs one value per axis")
+
+    game = os.path.abspath(args.game)
+    rows = []
+    for value in args.values:
+        counts = list(base)
+        counts[AXES.index(args.axis)] = value
+        # The game splits its options at spaces, so the result is named relative to its working directory
+        result_name = f"SceneSweep_{args.axis}_{value}.csv"
+        result = os.path.join(args.game_dir, result_name)
+        if os.path.exists(result):
+            os.remove(result)
+        command = [
+            game,
+            "-generate", ",".join(str(count) for count in counts),
+            "-seed", str(args.seed),
+            "-benchmark", args.path,
+            "-frames", str(args.frames),
+            "-csv", result_name,
+        ]
+        print(" ".join(command), flush=True)
+        if subprocess.run(command, cwd=args.game_dir).returncode != 0 or not os.path.exists(result):
+            print(f"step {value} failed", file=sys.stderr)
+            return 1
+
+        summary = read_benchmark(result)
+        rows.append([value] + [summary.get(name, "") for name in SUMMARY_ROWS])
+
+    with open(args.output, "w", newline="") as file:
+        writer = csv.writer(file)
+        writer.writerow([args.axis] + list(SUMMARY_COLUMNS))
+        writer.writerows(rows)
+
+    plot_summary(args.output, args.axis, rows)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
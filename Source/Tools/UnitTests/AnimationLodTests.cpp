@@ -0,0 +1,185 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+
+#include "Model/AnimationLod.h"
+
+using library::AnimationLod;
+using library::AnimationLodDesc;
+using library::AnimationLodPolicy;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getDesc
+  Summary:  Returns the description the renderer uses
+  Returns:  AnimationLodDesc
+              Full rate down to a quarter of the screen, then up to an
+              interval of 4 frames and 2 skipped levels
+-----------------------------------------------------------------F-F*/
+static AnimationLodDesc getDesc()
+{
+    return
+    {
+        .boundsScale = 1.5f,
+        .fullRateCoverage = 0.25f,
+        .uMaxUpdateInterval = 4u,
+        .uMaxSkippedLevels = 2u
+    };
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isLod
+  Summary:  Returns whether a level of detail has the given values
+  Args:     const AnimationLod& lod
+              Level of detail to check
+            UINT uUpdateInterval
+              Expected update interval
+            UINT uSkippedLevels
+              Expected number of skipped levels
+            BOOL bVisible
+              Expected visibility
+  Returns:  bool
+              Whether every value matches
+-----------------------------------------------------------------F-F*/
+static bool isLod(const AnimationLod& lod, UINT uUpdateInterval, UINT uSkippedLevels, BOOL bVisible)
+{
+    return lod.uUpdateInterval == uUpdateInterval && lod.uSkippedLevels == uSkippedLevels && lod.bVisible == bVisible;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testHalvesCoveragePerLevel
+  Summary:  Checks that every halving of the coverage below the full
+            rate coverage doubles the update interval and skips one
+            more level until the maximums, and that each maximum stops
+            on its own
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testHalvesCoveragePerLevel(TestContext& context)
+{
+    AnimationLodPolicy policy(getDesc());
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(1.0f, TRUE), 1u, 0u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.25f, TRUE), 1u, 0u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.2f, TRUE), 2u, 1u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.125f, TRUE), 2u, 1u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.1f, TRUE), 4u, 2u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.001f, TRUE), 4u, 2u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.1f, FALSE), 4u, 2u, FALSE));
+
+    // The interval keeps doubling after the skipped levels stop, up to an interval that is not a power of two
+    policy.SetDesc({ .boundsScale = 1.5f, .fullRateCoverage = 0.25f, .uMaxUpdateInterval = 6u, .uMaxSkippedLevels = 1u });
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.1f, TRUE), 4u, 1u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.05f, TRUE), 6u, 1u, TRUE));
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.001f, TRUE), 6u, 1u, TRUE));
+
+    // An interval of 0 means every frame
+    policy.SetDesc({ .boundsScale = 1.5f, .fullRateCoverage = 0.25f, .uMaxUpdateInterval = 0u, .uMaxSkippedLevels = 0u });
+    TEST_CHECK(context, policy.GetDesc().uMaxUpdateInterval == 1u);
+    TEST_CHECK(context, isLod(policy.SelectFromCoverage(0.001f, TRUE), 1u, 0u, TRUE));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testSelectsByDistance
+  Summary:  Checks that a character in front of a camera gets the full
+            rate up close and coarser levels further away, and that
+            the coverage it is picked from is the projected height of
+            the bounding sphere of the scaled bounds
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testSelectsByDistance(TestContext& context)
+{
+    AnimationLodPolicy policy(getDesc());
+    const BoundingBox bounds(XMFLOAT3(0.0f, 0.9f, 0.0f), XMFLOAT3(0.4f, 0.9f, 0.4f));
+    const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0.0f, 0.9f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    // The scaled extents are 0.6, 1.35 and 0.6, so the sphere covers 1.5945 * 2.4142 / depth of the screen
+    const FLOAT radius = std::sqrt(0.6f * 0.6f + 1.35f * 1.35f + 0.6f * 0.6f);
+    BoundingSphere sphere(XMFLOAT3(0.0f, 0.9f, 10.0f), radius);
+    TEST_CHECK(context, std::abs(AnimationLodPolicy::GetScreenCoverage(sphere, view, projection) - radius * 2.4142136f / 10.0f) < 1e-4f);
+
+    struct Expectation
+    {
+        FLOAT depth;
+        UINT uUpdateInterval;
+        UINT uSkippedLevels;
+    };
+    const Expectation aExpectations[] =
+    {
+        { .depth = 5.0f, .uUpdateInterval = 1u, .uSkippedLevels = 0u },
+        { .depth = 15.0f, .uUpdateInterval = 1u, .uSkippedLevels = 0u },
+        { .depth = 20.0f, .uUpdateInterval = 2u, .uSkippedLevels = 1u },
+        { .depth = 30.0f, .uUpdateInterval = 2u, .uSkippedLevels = 1u },
+        { .depth = 40.0f, .uUpdateInterval = 4u, .uSkippedLevels = 2u },
+        { .depth = 500.0f, .uUpdateInterval = 4u, .uSkippedLevels = 2u }
+    };
+    for (const Expectation& expectation : aExpectations)
+    {
+        AnimationLod lod = policy.Select(bounds, XMMatrixTranslation(0.0f, 0.0f, expectation.depth), view, projection);
+        TEST_CHECK(context, isLod(lod, expectation.uUpdateInterval, expectation.uSkippedLevels, TRUE));
+    }
+
+    // Scaling the model scales its bounds with it
+    AnimationLod lod = policy.Select(bounds, XMMatrixScaling(2.0f, 2.0f, 2.0f) * XMMatrixTranslation(0.0f, -0.9f, 20.0f), view, projection);
+    TEST_CHECK(context, isLod(lod, 1u, 0u, TRUE));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testHidesModelsOutsideFrustum
+  Summary:  Checks that models behind the camera, beside its frustum
+            or beyond its far plane are not visible, while a model
+            whose scaled bounds still reach into the frustum is
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testHidesModelsOutsideFrustum(TestContext& context)
+{
+    AnimationLodPolicy policy(getDesc());
+    const BoundingBox bounds(XMFLOAT3(0.0f, 0.9f, 0.0f), XMFLOAT3(0.4f, 0.9f, 0.4f));
+    const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0.0f, 0.9f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    TEST_CHECK(context, !policy.Select(bounds, XMMatrixTranslation(0.0f, 0.0f, -20.0f), view, projection).bVisible);
+    TEST_CHECK(context, !policy.Select(bounds, XMMatrixTranslation(100.0f, 0.0f, 10.0f), view, projection).bVisible);
+    TEST_CHECK(context, !policy.Select(bounds, XMMatrixTranslation(0.0f, 0.0f, 200.0f), view, projection).bVisible);
+
+    // At a depth of 10 the frustum reaches 7.36 to the side, the sphere of radius 1.59 still reaches into it
+    TEST_CHECK(context, policy.Select(bounds, XMMatrixTranslation(8.5f, 0.0f, 10.0f), view, projection).bVisible);
+    TEST_CHECK(context, !policy.Select(bounds, XMMatrixTranslation(10.0f, 0.0f, 10.0f), view, projection).bVisible);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsFullLodInsideBounds
+  Summary:  Checks that a camera inside the scaled bounds of a model,
+            looking at it or away from it, gets the full level of
+            detail
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsFullLodInsideBounds(TestContext& context)
+{
+    AnimationLodPolicy policy(getDesc());
+    const BoundingBox bounds(XMFLOAT3(0.0f, 0.9f, 0.0f), XMFLOAT3(0.4f, 0.9f, 0.4f));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 100.0f);
+    const XMMATRIX world = XMMatrixTranslation(3.0f, 0.0f, 3.0f);
+
+    for (FLOAT direction : { 1.0f, -1.0f })
+    {
+        XMMATRIX view = XMMatrixLookToLH(XMVectorSet(3.0f, 0.9f, 3.2f, 1.0f), XMVectorSet(0.0f, 0.0f, direction, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        TEST_CHECK(context, isLod(policy.Select(bounds, world, view, projection), 1u, 0u, TRUE));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterAnimationLodTests
+  Summary:  Registers the tests of the animation level of detail policy
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterAnimationLodTests(TestRunner& runner)
+{
+    runner.Register("AnimationLodPolicy::SelectFromCoverage/HalvesCoveragePerLevel", testHalvesCoveragePerLevel);
+    runner.Register("AnimationLodPolicy::Select/SelectsByDistance", testSelectsByDistance);
+    runner.Register("AnimationLodPolicy::Select/HidesModelsOutsideFrustum", testHidesModelsOutsideFrustum);
+    runner.Register("AnimationLodPolicy::Select/KeepsFullLodInsideBounds", testKeepsFullLodInsideBounds);
+}
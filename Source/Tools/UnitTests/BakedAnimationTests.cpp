@@ -0,0 +1,133 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Model/BakedAnimation.h"
+#include "TestModel.h"
+
+using library::AnimationLayerDesc;
+using library::BakedAnimation;
+using library::BakedAnimationClip;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testSizesFrames
+  Summary:  Checks that every clip of one second is baked into a frame
+            per sample and a last frame at its end, packed after the
+            previous clip, that the frames take a matrix per bone, and
+            that a time picks the nearest frame of its clip
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testSizesFrames(TestContext& context)
+{
+    TestModel rig("Rig64Bones");
+    rig.CreateRig(64u, 4u);
+
+    for (FLOAT framesPerSecond : { 60.0f, 25.0f })
+    {
+        if (!TEST_CHECK(context, SUCCEEDED(rig.BakeAnimations(nullptr, framesPerSecond))))
+        {
+            return;
+        }
+        const std::shared_ptr<BakedAnimation>& bakedAnimation = rig.GetBakedAnimation();
+        const UINT uNumClipFrames = static_cast<UINT>(framesPerSecond) + 1u;
+        TEST_CHECK(context, bakedAnimation->GetFramesPerSecond() == framesPerSecond);
+        TEST_CHECK(context, bakedAnimation->GetNumClips() == 4u && bakedAnimation->GetNumBones() == 64u);
+        TEST_CHECK(context, bakedAnimation->GetNumFrames() == 4u * uNumClipFrames);
+        TEST_CHECK(context, bakedAnimation->GetSizeInBytes() == static_cast<size_t>(bakedAnimation->GetNumFrames()) * 64u * sizeof(XMFLOAT4X4));
+        for (UINT uClip = 0u; uClip < 4u; ++uClip)
+        {
+            const BakedAnimationClip& bakedClip = bakedAnimation->GetClip(uClip);
+            TEST_CHECK(context, bakedClip.uFirstFrame == uClip * uNumClipFrames && bakedClip.uNumFrames == uNumClipFrames);
+            TEST_CHECK(context, std::abs(bakedClip.duration - 1.0f) < 1e-6f);
+        }
+
+        // Times round to the nearest frame and stay within the clip
+        const FLOAT frameTime = 1.0f / framesPerSecond;
+        const UINT uFirstFrame = bakedAnimation->GetClip(2u).uFirstFrame;
+        TEST_CHECK(context, bakedAnimation->GetFrame(2u, -1.0f) == uFirstFrame);
+        TEST_CHECK(context, bakedAnimation->GetFrame(2u, 3.4f * frameTime) == uFirstFrame + 3u);
+        TEST_CHECK(context, bakedAnimation->GetFrame(2u, 3.6f * frameTime) == uFirstFrame + 4u);
+        TEST_CHECK(context, bakedAnimation->GetFrame(2u, 5.0f) == uFirstFrame + uNumClipFrames - 1u);
+        TEST_CHECK(context, bakedAnimation->GetFrameOffset(uFirstFrame + 3u) == (uFirstFrame + 3u) * 64u);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testHoldsEvaluatedTransforms
+  Summary:  Checks that every frame of every clip holds, transposed
+            for the shader, the bone transforms a model playing the
+            clip alone evaluates at the time of the frame, to the bit,
+            and that a model playing the baked frames points its
+            instance at the frame of its time
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testHoldsEvaluatedTransforms(TestContext& context)
+{
+    constexpr const FLOAT FRAMES_PER_SECOND = 60.0f;
+    TestModel rig("Rig64Bones");
+    rig.CreateRig(64u, 4u);
+    if (!TEST_CHECK(context, SUCCEEDED(rig.BakeAnimations(nullptr, FRAMES_PER_SECOND))))
+    {
+        return;
+    }
+    const std::shared_ptr<BakedAnimation>& bakedAnimation = rig.GetBakedAnimation();
+
+    for (UINT uClip = 0u; uClip < bakedAnimation->GetNumClips(); ++uClip)
+    {
+        // The clip plays alone and does not move, so an update evaluates it at the time that was set
+        TestModel liveRig("Rig64Bones");
+        liveRig.ShareRig(rig);
+        liveRig.StopAnimation(0u);
+        UINT uLayer = liveRig.PlayAnimation(
+            AnimationLayerDesc
+            {
+                .uClip = uClip,
+                .time = 0.0f,
+                .speed = 0.0f,
+                .weight = 1.0f,
+                .bLoop = FALSE,
+                .bAdditive = FALSE
+            }
+        );
+
+        const BakedAnimationClip& bakedClip = bakedAnimation->GetClip(uClip);
+        UINT uNumMismatches = 0u;
+        for (UINT uFrame = 0u; uFrame < bakedClip.uNumFrames; ++uFrame)
+        {
+            FLOAT time = static_cast<FLOAT>(uFrame) / FRAMES_PER_SECOND;
+            liveRig.SetAnimationTime(uLayer, time);
+            liveRig.Update(0.0f);
+
+            const std::vector<XMMATRIX>& aLiveTransforms = liveRig.GetBoneTransforms();
+            const XMFLOAT4X4* aBakedTransforms = bakedAnimation->GetFrameTransforms(bakedAnimation->GetFrame(uClip, time));
+            for (UINT uBone = 0u; uBone < bakedAnimation->GetNumBones(); ++uBone)
+            {
+                XMMATRIX bakedTransform = XMMatrixTranspose(XMLoadFloat4x4(&aBakedTransforms[uBone]));
+                uNumMismatches += std::memcmp(&bakedTransform, &aLiveTransforms[uBone], sizeof(XMMATRIX)) != 0 ? 1u : 0u;
+            }
+        }
+        TEST_CHECK(context, uNumMismatches == 0u);
+
+        liveRig.SetBakedAnimation(bakedAnimation);
+        liveRig.SetAnimationTime(uLayer, 0.5f);
+        liveRig.Update(0.0f);
+        TEST_CHECK(context, liveRig.GetBakedFrameOffset() == bakedAnimation->GetFrameOffset(bakedClip.uFirstFrame + 30u));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterBakedAnimationTests
+  Summary:  Registers the tests of the baked animation frames
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterBakedAnimationTests(TestRunner& runner)
+{
+    runner.Register("BakedAnimation::Bake/SizesFrames", testSizesFrames);
+    runner.Register("BakedAnimation::Bake/HoldsEvaluatedTransforms", testHoldsEvaluatedTransforms);
+}
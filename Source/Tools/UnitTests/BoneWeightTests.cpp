@@ -0,0 +1,168 @@
+#include "LibraryTests.h"
+
+#include <initializer_list>
+
+#include "TestModel.h"
+
+using library::AnimationData;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createBoneData
+  Summary:  Adds bone weights to the bone data of a vertex the way the
+            import does, bone after bone
+  Args:     std::initializer_list<FLOAT> weights
+              Weight of every bone, the bones numbered from 10 on
+  Returns:  TestModel::VertexBoneData
+              Bone data of the vertex
+-----------------------------------------------------------------F-F*/
+static TestModel::VertexBoneData createBoneData(std::initializer_list<FLOAT> weights)
+{
+    TestModel::VertexBoneData boneData;
+    UINT uBoneId = 10u;
+    for (FLOAT weight : weights)
+    {
+        boneData.AddBoneData(uBoneId++, weight);
+    }
+
+    return boneData;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: sumWeights
+  Summary:  Returns the sum of the quantized weights of a vertex
+  Args:     const AnimationData& animationData
+              Quantized bone indices and weights
+  Returns:  UINT
+              Sum of the weights
+-----------------------------------------------------------------F-F*/
+static UINT sumWeights(const AnimationData& animationData)
+{
+    UINT uSum = 0u;
+    for (BYTE uWeight : animationData.aBoneWeights)
+    {
+        uSum += uWeight;
+    }
+
+    return uSum;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testRenormalizesTo255
+  Summary:  Checks that the weights of a vertex quantize to a sum of
+            exactly 255 whatever they sum to, with the indices of their
+            bones, and that a vertex without bones quantizes to zeros
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testRenormalizesTo255(TestContext& context)
+{
+    const std::initializer_list<FLOAT> aaWeights[] =
+    {
+        { 1.0f },
+        { 0.5f, 0.5f },
+        { 0.1f, 0.1f, 0.1f },
+        { 0.3f, 0.3f, 0.3f, 0.1f },
+        { 0.7f, 0.2f, 0.05f, 0.05f },
+        { 2.0f, 1.0f, 1.0f },
+        { 0.001f, 0.002f, 0.003f, 0.004f },
+        { 0.97f, 0.01f, 0.01f, 0.01f }
+    };
+    for (const std::initializer_list<FLOAT>& weights : aaWeights)
+    {
+        AnimationData animationData = TestModel::quantizeBoneData(createBoneData(weights));
+        TEST_CHECK(context, sumWeights(animationData) == 255u);
+        for (UINT i = 0u; i < MAX_NUM_BONES_PER_VERTEX; ++i)
+        {
+            TEST_CHECK(context, animationData.aBoneIndices[i] == (i < weights.size() ? 10u + i : 0u));
+            TEST_CHECK(context, i < weights.size() || animationData.aBoneWeights[i] == 0u);
+        }
+    }
+
+    AnimationData animationData = TestModel::quantizeBoneData(TestModel::VertexBoneData());
+    TEST_CHECK(context, sumWeights(animationData) == 0u);
+    for (UINT i = 0u; i < MAX_NUM_BONES_PER_VERTEX; ++i)
+    {
+        TEST_CHECK(context, animationData.aBoneIndices[i] == 0u);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testRoundsOntoLargestWeight
+  Summary:  Checks that every weight but the largest is rounded to the
+            nearest 255th of the total, and that the largest weight
+            takes the rounding error of the others
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testRoundsOntoLargestWeight(TestContext& context)
+{
+    // 79.56 rounds up three times, so the first of the largest weights gives back 1. 38.25 rounds down three
+    // times, so the largest weight takes 1 more than its 140. 84.92 rounds up three times and 0.26 down to 0
+    struct Expectation
+    {
+        std::initializer_list<FLOAT> weights;
+        BYTE aBoneWeights[MAX_NUM_BONES_PER_VERTEX];
+    };
+    const Expectation aExpectations[] =
+    {
+        { .weights = { 0.312f, 0.312f, 0.312f, 0.064f }, .aBoneWeights = { 79u, 80u, 80u, 16u } },
+        { .weights = { 0.15f, 0.55f, 0.15f, 0.15f }, .aBoneWeights = { 38u, 141u, 38u, 38u } },
+        { .weights = { 0.333f, 0.333f, 0.333f, 0.001f }, .aBoneWeights = { 85u, 85u, 85u, 0u } },
+        { .weights = { 0.2f, 0.6f, 0.2f }, .aBoneWeights = { 51u, 153u, 51u, 0u } }
+    };
+    for (const Expectation& expectation : aExpectations)
+    {
+        AnimationData animationData = TestModel::quantizeBoneData(createBoneData(expectation.weights));
+        for (UINT i = 0u; i < MAX_NUM_BONES_PER_VERTEX; ++i)
+        {
+            TEST_CHECK(context, animationData.aBoneWeights[i] == expectation.aBoneWeights[i]);
+        }
+    }
+
+    // Ties for the largest weight go to the first bone
+    AnimationData animationData = TestModel::quantizeBoneData(createBoneData({ 0.25f, 0.25f, 0.25f, 0.25f }));
+    TEST_CHECK(context, animationData.aBoneWeights[0] == 63u && animationData.aBoneWeights[1] == 64u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testReplacesSmallestInfluence
+  Summary:  Checks that a vertex influenced by more bones than it
+            holds keeps the largest weights: a larger weight replaces
+            the smallest one held, a weight no larger than every held
+            one is dropped, and the kept weights quantize to 255
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testReplacesSmallestInfluence(TestContext& context)
+{
+    // Bone 14 is smaller than every held weight, bone 15 replaces bone 10 and bone 16 replaces bone 15
+    TestModel::VertexBoneData boneData = createBoneData({ 0.1f, 0.3f, 0.2f, 0.25f, 0.05f, 0.15f, 0.18f });
+    TEST_CHECK(context, boneData.uNumBones == MAX_NUM_BONES_PER_VERTEX);
+    TEST_CHECK(context, boneData.aBoneIds[0] == 16u && boneData.aBoneIds[1] == 11u && boneData.aBoneIds[2] == 12u && boneData.aBoneIds[3] == 13u);
+    TEST_CHECK(context, boneData.aWeights[0] == 0.18f);
+
+    // A weight equal to the smallest held one is dropped
+    boneData.AddBoneData(17u, 0.18f);
+    TEST_CHECK(context, boneData.aBoneIds[0] == 16u);
+
+    AnimationData animationData = TestModel::quantizeBoneData(boneData);
+    TEST_CHECK(context, sumWeights(animationData) == 255u);
+    TEST_CHECK(context, animationData.aBoneIndices[0] == 16u && animationData.aBoneIndices[1] == 11u);
+
+    // 0.18, 0.3, 0.2 and 0.25 of 0.93 are 49.35, 82.26, 54.84 and 68.55 255ths
+    TEST_CHECK(context, animationData.aBoneWeights[0] == 49u && animationData.aBoneWeights[1] == 82u && animationData.aBoneWeights[2] == 55u && animationData.aBoneWeights[3] == 69u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterBoneWeightTests
+  Summary:  Registers the tests of the pruning and quantization of the
+            bone weights of the vertices
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterBoneWeightTests(TestRunner& runner)
+{
+    runner.Register("Model::quantizeBoneData/RenormalizesTo255", testRenormalizesTo255);
+    runner.Register("Model::quantizeBoneData/RoundsOntoLargestWeight", testRoundsOntoLargestWeight);
+    runner.Register("Model::VertexBoneData::AddBoneData/ReplacesSmallestInfluence", testReplacesSmallestInfluence);
+}
@@ -0,0 +1,378 @@
+#include "LibraryTests.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <memory>
+#include <vector>
+
+#include "Model/Model.h"
+#include "Renderer/InstanceBatcher.h"
+#include "TestRenderable.h"
+
+using library::InstanceBatcher;
+using library::Material;
+using library::Model;
+using library::PixelShader;
+using library::Renderable;
+using library::SimpleVertex;
+using library::VertexShader;
+
+static const std::vector<SimpleVertex> CUBE_VERTICES =
+{
+    { .Position = XMFLOAT3(-1.0f, -1.0f, -1.0f), .TexCoord = XMFLOAT2(0.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+    { .Position = XMFLOAT3(1.0f, -1.0f, -1.0f), .TexCoord = XMFLOAT2(1.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+    { .Position = XMFLOAT3(1.0f, 1.0f, 1.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3(0.0f, 0.0f, 1.0f) },
+};
+static const std::vector<WORD> CUBE_INDICES = { 0u, 1u, 2u };
+static const std::vector<SimpleVertex> PLANE_VERTICES =
+{
+    { .Position = XMFLOAT3(-1.0f, 0.0f, -1.0f), .TexCoord = XMFLOAT2(0.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f) },
+    { .Position = XMFLOAT3(1.0f, 0.0f, -1.0f), .TexCoord = XMFLOAT2(1.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f) },
+    { .Position = XMFLOAT3(1.0f, 0.0f, 1.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f) },
+};
+static const std::vector<WORD> PLANE_INDICES = { 0u, 2u, 1u };
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    InstanceScene
+
+  Summary:  Renderables and models added to the batcher by the tests.
+            Every object is placed at the origin of its name, and the
+            objects are added out of name order
+
+            Name     Geometry  Vertex shader  Material  Group
+            Crate0   cube      shared         crate     0
+            Crate1   cube      shared         crate     0
+            Crate2   cube      shared         metal     1
+            Cube0    cube      shared         none      2
+            Cube1    cube      shared         none      2
+            Cube2    cube      shared         none      2
+            Cube3    cube      outlined       none      3
+            Plane0   plane     shared         none      4
+            Plane1   plane     shared         none      4
+            Rock0    Rock.obj  shared         none      5
+            Tree0    Tree.obj  shared         none      6
+            Tree1    Tree.obj  shared         none      6
+
+  Methods:  AddTo
+              Adds every object except the given ones to the batcher
+            GetPosition
+              Returns the origin of an object
+            Find
+              Returns the object of a name
+            InstanceScene
+              Constructor.
+            ~InstanceScene
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class InstanceScene final
+{
+public:
+    static constexpr const UINT NUM_OBJECTS = 12u;
+    static constexpr const PCWSTR NAMES[NUM_OBJECTS] =
+    {
+        L"Crate0", L"Crate1", L"Crate2", L"Cube0", L"Cube1", L"Cube2", L"Cube3", L"Plane0", L"Plane1", L"Rock0", L"Tree0", L"Tree1"
+    };
+
+public:
+    InstanceScene();
+    InstanceScene(const InstanceScene& other) = delete;
+    InstanceScene(InstanceScene&& other) = delete;
+    InstanceScene& operator=(const InstanceScene& other) = delete;
+    InstanceScene& operator=(InstanceScene&& other) = delete;
+    ~InstanceScene() = default;
+
+    void AddTo(_In_ InstanceBatcher& batcher, _In_ const std::vector<UINT>& aSkippedObjects) const;
+    static XMVECTOR GetPosition(_In_ UINT uObject);
+    Renderable* Find(_In_ UINT uObject) const;
+
+private:
+    std::shared_ptr<VertexShader> m_vertexShader;
+    std::shared_ptr<VertexShader> m_outlineVertexShader;
+    std::shared_ptr<PixelShader> m_pixelShader;
+    std::shared_ptr<Material> m_crateMaterial;
+    std::shared_ptr<Material> m_metalMaterial;
+    std::unique_ptr<TestRenderable> m_aRenderables[9];
+    std::unique_ptr<Model> m_aModels[3];
+};
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   InstanceScene::InstanceScene
+
+  Summary:  Constructor
+
+  Modifies: [m_vertexShader, m_outlineVertexShader, m_pixelShader,
+             m_crateMaterial, m_metalMaterial, m_aRenderables,
+             m_aModels].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+InstanceScene::InstanceScene() :
+    m_vertexShader(std::make_shared<VertexShader>(L"Shaders/Shaders.fxh", "VS", "vs_5_0")),
+    m_outlineVertexShader(std::make_shared<VertexShader>(L"Shaders/Outline.fxh", "VS", "vs_5_0")),
+    m_pixelShader(std::make_shared<PixelShader>(L"Shaders/Shaders.fxh", "PS", "ps_5_0")),
+    m_crateMaterial(std::make_shared<Material>(L"Crate")),
+    m_metalMaterial(std::make_shared<Material>(L"Metal")),
+    m_aRenderables(),
+    m_aModels()
+{
+    for (UINT i = 0u; i < ARRAYSIZE(m_aRenderables); ++i)
+    {
+        BOOL bIsPlane = i >= 7u;
+        m_aRenderables[i] = std::make_unique<TestRenderable>(bIsPlane ? PLANE_VERTICES : CUBE_VERTICES, bIsPlane ? PLANE_INDICES : CUBE_INDICES);
+        m_aRenderables[i]->SetVertexShader(i == 6u ? m_outlineVertexShader : m_vertexShader);
+        m_aRenderables[i]->SetPixelShader(m_pixelShader);
+        if (i < 3u)
+        {
+            m_aRenderables[i]->AddMaterial(i < 2u ? m_crateMaterial : m_metalMaterial);
+            m_aRenderables[i]->AddMesh(0u, 3u, 0u);
+        }
+        m_aRenderables[i]->Translate(GetPosition(i));
+    }
+
+    for (UINT i = 0u; i < ARRAYSIZE(m_aModels); ++i)
+    {
+        m_aModels[i] = std::make_unique<Model>(i == 0u ? L"Content/Rock.obj" : L"Content/Tree.obj");
+        m_aModels[i]->SetVertexShader(m_vertexShader);
+        m_aModels[i]->SetPixelShader(m_pixelShader);
+        m_aModels[i]->Translate(GetPosition(ARRAYSIZE(m_aRenderables) + i));
+    }
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   InstanceScene::AddTo
+
+  Summary:  Adds the objects to the batcher in reverse name order,
+            models first, leaving out the skipped ones
+
+  Args:     InstanceBatcher& batcher
+              Batcher to add the objects to
+            const std::vector<UINT>& aSkippedObjects
+              Objects removed from the scene
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void InstanceScene::AddTo(_In_ InstanceBatcher& batcher, _In_ const std::vector<UINT>& aSkippedObjects) const
+{
+    for (UINT i = NUM_OBJECTS; i-- > 0u;)
+    {
+        if (std::find(aSkippedObjects.begin(), aSkippedObjects.end(), i) != aSkippedObjects.end())
+        {
+            continue;
+        }
+
+        if (i >= ARRAYSIZE(m_aRenderables))
+        {
+            batcher.AddModel(NAMES[i], *m_aModels[i - ARRAYSIZE(m_aRenderables)]);
+        }
+        else
+        {
+            batcher.AddRenderable(NAMES[i], *m_aRenderables[i]);
+        }
+    }
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   InstanceScene::GetPosition
+
+  Summary:  Returns the origin of an object, every object at its own
+            x so an instance identifies its object
+
+  Args:     UINT uObject
+              Index of the object in name order
+
+  Returns:  XMVECTOR
+              Origin of the object
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+XMVECTOR InstanceScene::GetPosition(_In_ UINT uObject)
+{
+    return XMVectorSet(static_cast<FLOAT>(uObject) * 10.0f, 0.0f, 0.0f, 0.0f);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   InstanceScene::Find
+
+  Summary:  Returns the object of a name
+
+  Args:     UINT uObject
+              Index of the object in name order
+
+  Returns:  Renderable*
+              Object
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+Renderable* InstanceScene::Find(_In_ UINT uObject) const
+{
+    if (uObject >= ARRAYSIZE(m_aRenderables))
+    {
+        return m_aModels[uObject - ARRAYSIZE(m_aRenderables)].get();
+    }
+
+    return m_aRenderables[uObject].get();
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getInstanceObject
+  Summary:  Returns the object an instance was packed from
+  Args:     const library::InstanceData& instance
+              Packed instance
+  Returns:  UINT
+              Index of the object in name order
+-----------------------------------------------------------------F-F*/
+static UINT getInstanceObject(const library::InstanceData& instance)
+{
+    return static_cast<UINT>(XMVectorGetX(instance.Transformation.r[3]) / 10.0f + 0.5f);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: checkGroups
+  Summary:  Checks that the groups are the expected ones in order,
+            each drawn with the buffers of its first object, with
+            their instance ranges covering every instance once and
+            holding the expected objects in order
+  Args:     TestContext& context
+              Context of the checks
+            const InstanceScene& scene
+              Objects added to the batcher
+            const InstanceBatcher& batcher
+              Built batcher
+            const std::vector<std::vector<UINT>>& aExpectedGroups
+              Objects of every group in instance order
+-----------------------------------------------------------------F-F*/
+static void checkGroups(TestContext& context, const InstanceScene& scene, const InstanceBatcher& batcher, const std::vector<std::vector<UINT>>& aExpectedGroups)
+{
+    const std::vector<InstanceBatcher::InstanceGroup>& aGroups = batcher.GetGroups();
+    if (!TEST_CHECK(context, aGroups.size() == aExpectedGroups.size()))
+    {
+        return;
+    }
+
+    std::vector<UINT> aInstanceGroups(batcher.GetNumInstances(), static_cast<UINT>(aGroups.size()));
+    for (UINT uGroup = 0u; uGroup < aGroups.size(); ++uGroup)
+    {
+        const InstanceBatcher::InstanceGroup& group = aGroups[uGroup];
+        const std::vector<UINT>& aExpectedObjects = aExpectedGroups[uGroup];
+        if (!TEST_CHECK(context, group.uNumInstances == aExpectedObjects.size())
+            || !TEST_CHECK(context, group.uFirstInstance + group.uNumInstances <= batcher.GetNumInstances()))
+        {
+            return;
+        }
+
+        // A group is drawn with the buffers of its first object in name order
+        TEST_CHECK(context, group.pRenderable == scene.Find(*std::min_element(aExpectedObjects.begin(), aExpectedObjects.end())));
+        for (UINT i = 0u; i < group.uNumInstances; ++i)
+        {
+            TEST_CHECK(context, aInstanceGroups[group.uFirstInstance + i] == aGroups.size());
+            aInstanceGroups[group.uFirstInstance + i] = uGroup;
+            TEST_CHECK(context, getInstanceObject(batcher.GetInstances()[group.uFirstInstance + i]) == aExpectedObjects[i]);
+        }
+    }
+
+    TEST_CHECK(context, std::find(aInstanceGroups.begin(), aInstanceGroups.end(), static_cast<UINT>(aGroups.size())) == aInstanceGroups.end());
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: checkPackedInGroupOrder
+  Summary:  Checks that the instances of the groups follow each other
+            in group order
+  Args:     TestContext& context
+              Context of the checks
+            const InstanceBatcher& batcher
+              Built batcher
+-----------------------------------------------------------------F-F*/
+static void checkPackedInGroupOrder(TestContext& context, const InstanceBatcher& batcher)
+{
+    UINT uFirstInstance = 0u;
+    for (const InstanceBatcher::InstanceGroup& group : batcher.GetGroups())
+    {
+        TEST_CHECK(context, group.uFirstInstance == uFirstInstance);
+        uFirstInstance += group.uNumInstances;
+    }
+    TEST_CHECK(context, batcher.GetNumInstances() == uFirstInstance);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testGroupsSharedRenderables
+  Summary:  Checks that renderables and models are grouped only with
+            those sharing geometry, materials and shaders, and that
+            removing objects shrinks their groups and moves the group
+            onto the next object
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testGroupsSharedRenderables(TestContext& context)
+{
+    InstanceScene scene;
+    InstanceBatcher batcher;
+
+    scene.AddTo(batcher, {});
+    batcher.Build();
+    checkGroups(context, scene, batcher, { { 0u, 1u }, { 2u }, { 3u, 4u, 5u }, { 6u }, { 7u, 8u }, { 9u }, { 10u, 11u } });
+    checkPackedInGroupOrder(context, batcher);
+
+    // Cube1 and Tree0 are removed, Crate2 leaves with its group
+    batcher.Reset();
+    scene.AddTo(batcher, { 2u, 4u, 10u });
+    batcher.Build();
+    checkGroups(context, scene, batcher, { { 0u, 1u }, { 3u, 5u }, { 6u }, { 7u, 8u }, { 9u }, { 11u } });
+    checkPackedInGroupOrder(context, batcher);
+
+    // Every object is back
+    batcher.Reset();
+    scene.AddTo(batcher, {});
+    batcher.Build();
+    checkGroups(context, scene, batcher, { { 0u, 1u }, { 2u }, { 3u, 4u, 5u }, { 6u }, { 7u, 8u }, { 9u }, { 10u, 11u } });
+    checkPackedInGroupOrder(context, batcher);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testSortsFrontToBack
+  Summary:  Checks that the instances of every group are ordered by
+            view depth, nearest first, that the groups are ordered by
+            their nearest instance and that every group keeps its own
+            instances
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testSortsFrontToBack(TestContext& context)
+{
+    InstanceScene scene;
+    InstanceBatcher batcher;
+    scene.AddTo(batcher, {});
+    batcher.Build();
+
+    // The camera looks down -x from beyond the last object, so the objects later in name order are nearer
+    XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(200.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    batcher.SortFrontToBack(view);
+    checkGroups(context, scene, batcher, { { 11u, 10u }, { 9u }, { 8u, 7u }, { 6u }, { 5u, 4u, 3u }, { 2u }, { 1u, 0u } });
+
+    const std::vector<InstanceBatcher::InstanceGroup>& aGroups = batcher.GetGroups();
+    if (!TEST_CHECK(context, aGroups.size() == 7u))
+    {
+        return;
+    }
+
+    FLOAT previousGroupDepth = -FLT_MAX;
+    for (const InstanceBatcher::InstanceGroup& group : aGroups)
+    {
+        FLOAT previousDepth = -FLT_MAX;
+        for (UINT i = group.uFirstInstance; i < group.uFirstInstance + group.uNumInstances; ++i)
+        {
+            const library::InstanceData& instance = batcher.GetInstances()[i];
+            FLOAT depth = XMVectorGetZ(XMVector3Transform(instance.Transformation.r[3], view));
+            TEST_CHECK(context, depth >= previousDepth);
+            previousDepth = depth;
+        }
+
+        FLOAT groupDepth = XMVectorGetZ(XMVector3Transform(batcher.GetInstances()[group.uFirstInstance].Transformation.r[3], view));
+        TEST_CHECK(context, groupDepth >= previousGroupDepth);
+        previousGroupDepth = groupDepth;
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterInstanceBatcherTests
+  Summary:  Registers the tests of grouping renderables into instanced
+            draws
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterInstanceBatcherTests(TestRunner& runner)
+{
+    runner.Register("InstanceBatcher::Build/GroupsSharedRenderables", testGroupsSharedRenderables);
+    runner.Register("InstanceBatcher::SortFrontToBack/SortsFrontToBack", testSortsFrontToBack);
+}
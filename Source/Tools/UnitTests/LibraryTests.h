@@ -0,0 +1,34 @@
+/*+===================================================================
+  File:      LIBRARYTESTS.H
+
+  Summary:   LibraryTests header file contains declarations of the
+             functions registering the tests of the CPU code of the
+             Library.
+
+  Functions: RegisterRenderGraphTests, RegisterStaticBatchTests,
+             RegisterInstanceBatcherTests, RegisterPositionStreamTests,
+             RegisterViewSetTests, RegisterShadowCasterCacheTests,
+             RegisterShadowCascadesTests, RegisterAnimationLodTests,
+             RegisterResolutionGovernorTests, RegisterProfilerTests,
+             RegisterModelTests, RegisterBakedAnimationTests,
+             RegisterBoneWeightTests
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "UnitTest.h"
+
+void RegisterRenderGraphTests(TestRunner& runner);
+void RegisterStaticBatchTests(TestRunner& runner);
+void RegisterInstanceBatcherTests(TestRunner& runner);
+void RegisterPositionStreamTests(TestRunner& runner);
+void RegisterViewSetTests(TestRunner& runner);
+void RegisterShadowCasterCacheTests(TestRunner& runner);
+void RegisterShadowCascadesTests(TestRunner& runner);
+void RegisterAnimationLodTests(TestRunner& runner);
+void RegisterResolutionGovernorTests(TestRunner& runner);
+void RegisterProfilerTests(TestRunner& runner);
+void RegisterModelTests(TestRunner& runner);
+void RegisterBakedAnimationTests(TestRunner& runner);
+void RegisterBoneWeightTests(TestRunner& runner);
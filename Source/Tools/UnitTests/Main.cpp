@@ -0,0 +1,66 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Command line unit tests of the CPU code of the engine.
+             The tested classes run without a Direct3D device, so the
+             tests need no window and no GPU. Every test prints whether
+             it passed, a failed check prints its expression and
+             location, and the exit code is 1 when any test failed.
+
+             Usage:
+               UnitTests [--filter <text>]
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "LibraryTests.h"
+#include "UnitTest.h"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+  Summary:  Parses the options, registers and runs the tests
+  Args:     int argc
+              Number of arguments
+            char* argv[]
+              Arguments
+  Returns:  int
+              0 if every test passed, 1 otherwise
+-----------------------------------------------------------------F-F*/
+int main(int argc, char* argv[])
+{
+    std::string filter;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--filter") == 0)
+        {
+            filter = argv[i + 1];
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    TestRunner runner;
+    RegisterRenderGraphTests(runner);
+    RegisterStaticBatchTests(runner);
+    RegisterInstanceBatcherTests(runner);
+    RegisterPositionStreamTests(runner);
+    RegisterViewSetTests(runner);
+    RegisterShadowCasterCacheTests(runner);
+    RegisterShadowCascadesTests(runner);
+    RegisterAnimationLodTests(runner);
+    RegisterResolutionGovernorTests(runner);
+    RegisterProfilerTests(runner);
+    RegisterModelTests(runner);
+    RegisterBakedAnimationTests(runner);
+    RegisterBoneWeightTests(runner);
+
+    return runner.Run(filter) == 0u ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "assimp/scene.h"
+
+#include "Model/PoseCache.h"
+#include "Thread/ThreadPool.h"
+#include "TestModel.h"
+
+using library::AnimationClipStatistics;
+using library::AnimationLayerDesc;
+using library::PoseCache;
+using library::PoseCacheKey;
+using library::PoseCacheStatistics;
+using library::ThreadPool;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createCharacters
+  Summary:  Creates characters sharing a rig, each blending its first
+            clip with another one from its own time
+  Args:     const TestModel& rig
+              Model made by CreateRig, with at least two clips
+            UINT uNumCharacters
+              Number of characters
+  Returns:  std::vector<std::unique_ptr<TestModel>>
+              Characters
+-----------------------------------------------------------------F-F*/
+static std::vector<std::unique_ptr<TestModel>> createCharacters(const TestModel& rig, UINT uNumCharacters)
+{
+    std::vector<std::unique_ptr<TestModel>> aCharacters;
+    for (UINT i = 0u; i < uNumCharacters; ++i)
+    {
+        std::unique_ptr<TestModel> character = std::make_unique<TestModel>("Character");
+        character->ShareRig(rig);
+        character->SetAnimationTime(0u, 0.001f * static_cast<FLOAT>(i));
+        character->PlayAnimation(
+            AnimationLayerDesc
+            {
+                .uClip = 1u + i % (rig.GetNumAnimations() - 1u),
+                .time = 0.003f * static_cast<FLOAT>(i),
+                .speed = 1.0f,
+                .weight = 0.5f,
+                .bLoop = TRUE,
+                .bAdditive = FALSE
+            }
+        );
+        aCharacters.push_back(std::move(character));
+    }
+
+    return aCharacters;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createClipCharacters
+  Summary:  Creates characters sharing a rig, all playing its first
+            clip alone in 16 phases, each character a few
+            milliseconds off the phase of its group. Every run of 16
+            characters plays 4 of the phases, so the first 4 jobs of
+            4 characters look up the same poses at the same time
+  Args:     const TestModel& rig
+              Model made by CreateRig
+            UINT uNumCharacters
+              Number of characters
+            const std::shared_ptr<PoseCache>& poseCache
+              Cache sharing the poses, nullptr to evaluate every pose
+  Returns:  std::vector<std::unique_ptr<TestModel>>
+              Characters
+-----------------------------------------------------------------F-F*/
+static std::vector<std::unique_ptr<TestModel>> createClipCharacters(const TestModel& rig, UINT uNumCharacters, const std::shared_ptr<PoseCache>& poseCache)
+{
+    std::vector<std::unique_ptr<TestModel>> aCharacters;
+    for (UINT i = 0u; i < uNumCharacters; ++i)
+    {
+        std::unique_ptr<TestModel> character = std::make_unique<TestModel>("Character");
+        character->ShareRig(rig);
+        UINT uPhase = i % 4u + 4u * ((i / 16u) % 4u);
+        character->SetAnimationTime(0u, 0.125f * static_cast<FLOAT>(uPhase) + 0.002f * static_cast<FLOAT>((i / 4u) % 4u));
+        character->SetPoseCache(poseCache);
+        aCharacters.push_back(std::move(character));
+    }
+
+    return aCharacters;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: updateCharacters
+  Summary:  Runs a frame of the characters the way Scene::Update does:
+            begins the frame of the pose cache, then updates the
+            characters on a thread pool, a few characters per job
+  Args:     ThreadPool& threadPool
+              Pool running the jobs
+            PoseCache* pPoseCache
+              Cache of the characters, nullptr if they use none
+            const std::vector<std::unique_ptr<TestModel>>& aCharacters
+              Characters to update
+            FLOAT deltaTime
+              Time difference of a frame
+-----------------------------------------------------------------F-F*/
+static void updateCharacters(ThreadPool& threadPool, PoseCache* pPoseCache, const std::vector<std::unique_ptr<TestModel>>& aCharacters, FLOAT deltaTime)
+{
+    if (pPoseCache)
+    {
+        pPoseCache->BeginFrame();
+    }
+    threadPool.ParallelFor(static_cast<UINT>(aCharacters.size()), 4u, [&aCharacters, deltaTime](UINT uBegin, UINT uEnd)
+    {
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            aCharacters[i]->Update(deltaTime);
+        }
+    });
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: haveSameBoneTransforms
+  Summary:  Returns whether two sets of characters end with the same
+            bone transforms to the bit
+  Args:     const std::vector<std::unique_ptr<TestModel>>& aCharacters
+              Characters to compare
+            const std::vector<std::unique_ptr<TestModel>>& aOtherCharacters
+              Characters to compare them with
+  Returns:  bool
+              Whether every bone transform matches
+-----------------------------------------------------------------F-F*/
+static bool haveSameBoneTransforms(const std::vector<std::unique_ptr<TestModel>>& aCharacters, const std::vector<std::unique_ptr<TestModel>>& aOtherCharacters)
+{
+    for (size_t i = 0u; i < aCharacters.size(); ++i)
+    {
+        const std::vector<XMMATRIX>& aTransforms = aCharacters[i]->GetBoneTransforms();
+        const std::vector<XMMATRIX>& aOtherTransforms = aOtherCharacters[i]->GetBoneTransforms();
+        if (aTransforms.size() != aOtherTransforms.size() || std::memcmp(aTransforms.data(), aOtherTransforms.data(), aTransforms.size() * sizeof(XMMATRIX)) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testMatchesSerialUpdateOnThreads
+  Summary:  Checks that characters blending clips, and characters
+            sharing poses through a pose cache, end with the same bone
+            transforms to the bit whether a pool without workers or a
+            pool of several workers updates them, since every
+            character is updated by one job whichever thread runs it
+            and the cached poses only depend on their key
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testMatchesSerialUpdateOnThreads(TestContext& context)
+{
+    constexpr const UINT NUM_CHARACTERS = 256u;
+    TestModel rig("Rig64Bones");
+    rig.CreateRig(64u, 4u);
+
+    ThreadPool serialPool(0u);
+    ThreadPool parallelPool(3u);
+    TEST_CHECK(context, serialPool.GetNumThreads() == 1u && parallelPool.GetNumThreads() == 4u);
+
+    std::vector<std::unique_ptr<TestModel>> aSerialCharacters = createCharacters(rig, NUM_CHARACTERS);
+    std::vector<std::unique_ptr<TestModel>> aParallelCharacters = createCharacters(rig, NUM_CHARACTERS);
+    for (UINT uFrame = 0u; uFrame < 8u; ++uFrame)
+    {
+        updateCharacters(serialPool, nullptr, aSerialCharacters, 1.0f / 60.0f);
+        updateCharacters(parallelPool, nullptr, aParallelCharacters, 1.0f / 60.0f);
+    }
+    TEST_CHECK(context, haveSameBoneTransforms(aSerialCharacters, aParallelCharacters));
+
+    std::shared_ptr<PoseCache> serialPoseCache = std::make_shared<PoseCache>(1.0f / 120.0f);
+    std::shared_ptr<PoseCache> parallelPoseCache = std::make_shared<PoseCache>(1.0f / 120.0f);
+    aSerialCharacters = createClipCharacters(rig, NUM_CHARACTERS, serialPoseCache);
+    aParallelCharacters = createClipCharacters(rig, NUM_CHARACTERS, parallelPoseCache);
+    for (UINT uFrame = 0u; uFrame < 8u; ++uFrame)
+    {
+        updateCharacters(serialPool, serialPoseCache.get(), aSerialCharacters, 1.0f / 60.0f);
+        updateCharacters(parallelPool, parallelPoseCache.get(), aParallelCharacters, 1.0f / 60.0f);
+    }
+    TEST_CHECK(context, haveSameBoneTransforms(aSerialCharacters, aParallelCharacters));
+    TEST_CHECK(context, serialPoseCache->GetStatistics().uNumHits > 0u && parallelPoseCache->GetStatistics().uNumHits > 0u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testReportsClipStatistics
+  Summary:  Checks that every clip read reports its tracks, its
+            samples, the bytes of its assimp keys and how many times
+            smaller its compressed keys are, with errors within the
+            tolerances of the resampling and of the compression, and
+            that a model sharing the rig reports the same clips
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testReportsClipStatistics(TestContext& context)
+{
+    TestModel rig("Rig8Bones");
+    rig.CreateRig(8u, 2u);
+
+    // Every node has a position, a scaling and 31 rotation keys
+    const size_t uKeysSize = 8u * (2u * sizeof(aiVectorKey) + 31u * sizeof(aiQuatKey));
+    for (UINT uClip = 0u; uClip < rig.GetNumAnimations(); ++uClip)
+    {
+        const AnimationClipStatistics& statistics = rig.GetAnimationClipStatistics(uClip);
+        TEST_CHECK(context, statistics.uNumTracks == 8u && statistics.uNumSamples == 61u);
+        TEST_CHECK(context, statistics.uKeysSizeInBytes == uKeysSize);
+        TEST_CHECK(context, statistics.uResampledSizeInBytes > 0u && statistics.uCompressedSizeInBytes > 0u && statistics.uNumKeys > 0u);
+        TEST_CHECK(context, statistics.compressionRatio == static_cast<FLOAT>(uKeysSize) / static_cast<FLOAT>(statistics.uCompressedSizeInBytes));
+        TEST_CHECK(context, statistics.maxResampledTranslationError < 0.01f && statistics.maxResampledRotationError < 0.01f && statistics.maxResampledScalingError < 0.001f);
+        TEST_CHECK(context, std::isfinite(statistics.maxTranslationError) && std::isfinite(statistics.maxRotationError) && std::isfinite(statistics.maxScalingError) && std::isfinite(statistics.maxPositionError));
+    }
+
+    TestModel character("Character");
+    character.ShareRig(rig);
+    TEST_CHECK(context, std::memcmp(&character.GetAnimationClipStatistics(1u), &rig.GetAnimationClipStatistics(1u), sizeof(AnimationClipStatistics)) == 0);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createPoseTransforms
+  Summary:  Creates bone transforms to insert into a pose cache
+  Args:     FLOAT offset
+              Translation of the first bone, each next bone one unit
+              further
+  Returns:  std::vector<XMMATRIX>
+              Bone transforms of 4 bones
+-----------------------------------------------------------------F-F*/
+static std::vector<XMMATRIX> createPoseTransforms(FLOAT offset)
+{
+    std::vector<XMMATRIX> aTransforms;
+    for (UINT i = 0u; i < 4u; ++i)
+    {
+        aTransforms.push_back(XMMatrixTranslation(offset + static_cast<FLOAT>(i), 0.0f, 0.0f));
+    }
+
+    return aTransforms;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testCountsHitsAndMisses
+  Summary:  Checks that a lookup misses until the pose of its key is
+            inserted, then hits it, that the step and the skipped
+            levels are part of the key, and that characters playing a
+            clip alone share the pose of their step and sample the
+            clip at the time of the step even on a miss, while a
+            character blending layers never looks the cache up
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testCountsHitsAndMisses(TestContext& context)
+{
+    PoseCache poseCache(1.0f / 120.0f);
+    PoseCacheKey key = { .pSkeleton = nullptr, .pClip = nullptr, .uTimeStep = poseCache.GetTimeStep(0.5f), .uSkippedLevels = 0u };
+    TEST_CHECK(context, key.uTimeStep == 60u && poseCache.GetTimeStep(0.502f) == 60u && poseCache.GetTimeStep(0.505f) == 61u);
+
+    TEST_CHECK(context, !poseCache.Find(key));
+    std::vector<XMMATRIX> aTransforms = createPoseTransforms(1.0f);
+    poseCache.Insert(key, aTransforms);
+    std::shared_ptr<const std::vector<XMMATRIX>> aCachedTransforms = poseCache.Find(key);
+    TEST_CHECK(context, aCachedTransforms && aCachedTransforms->size() == aTransforms.size());
+    TEST_CHECK(context, aCachedTransforms && std::memcmp(aCachedTransforms->data(), aTransforms.data(), aTransforms.size() * sizeof(XMMATRIX)) == 0);
+    TEST_CHECK(context, !poseCache.Find(PoseCacheKey{ .pSkeleton = nullptr, .pClip = nullptr, .uTimeStep = 61u, .uSkippedLevels = 0u }));
+    TEST_CHECK(context, !poseCache.Find(PoseCacheKey{ .pSkeleton = nullptr, .pClip = nullptr, .uTimeStep = 60u, .uSkippedLevels = 1u }));
+
+    PoseCacheStatistics statistics = poseCache.GetStatistics();
+    TEST_CHECK(context, statistics.uNumHits == 1u && statistics.uNumMisses == 3u && statistics.uNumEvictions == 0u && statistics.uNumEntries == 1u);
+    TEST_CHECK(context, poseCache.GetHitRate() == 0.25f);
+
+    TestModel rig("Rig16Bones");
+    rig.CreateRig(16u, 2u);
+    std::shared_ptr<PoseCache> sharedPoseCache = std::make_shared<PoseCache>(1.0f / 120.0f);
+    std::vector<std::unique_ptr<TestModel>> aCharacters;
+    for (UINT i = 0u; i < 4u; ++i)
+    {
+        std::unique_ptr<TestModel> character = std::make_unique<TestModel>("Character");
+        character->ShareRig(rig);
+        character->SetAnimationTime(0u, 0.503f - 0.002f * static_cast<FLOAT>(i));
+        character->SetPoseCache(sharedPoseCache);
+        aCharacters.push_back(std::move(character));
+    }
+    sharedPoseCache->BeginFrame();
+    for (const std::unique_ptr<TestModel>& character : aCharacters)
+    {
+        character->Update(0.0f);
+    }
+    statistics = sharedPoseCache->GetStatistics();
+    TEST_CHECK(context, statistics.uNumHits == 3u && statistics.uNumMisses == 1u && statistics.uNumEntries == 1u);
+
+    // The character evaluating the pose sampled the time of the step, not its own time
+    FLOAT stepTime = sharedPoseCache->GetStepTime(sharedPoseCache->GetTimeStep(0.5f));
+    std::vector<std::unique_ptr<TestModel>> aReferences;
+    for (size_t i = 0u; i < aCharacters.size(); ++i)
+    {
+        std::unique_ptr<TestModel> reference = std::make_unique<TestModel>("Reference");
+        reference->ShareRig(rig);
+        reference->SetAnimationTime(0u, stepTime);
+        reference->Update(0.0f);
+        aReferences.push_back(std::move(reference));
+    }
+    TEST_CHECK(context, haveSameBoneTransforms(aCharacters, aReferences));
+
+    TestModel blending("Blending");
+    blending.ShareRig(rig);
+    blending.SetAnimationTime(0u, 0.5f);
+    blending.PlayAnimation(AnimationLayerDesc{ .uClip = 1u, .time = 0.5f, .speed = 1.0f, .weight = 0.5f, .bLoop = TRUE, .bAdditive = FALSE });
+    blending.SetPoseCache(sharedPoseCache);
+    blending.Update(0.0f);
+    PoseCacheStatistics blendingStatistics = sharedPoseCache->GetStatistics();
+    TEST_CHECK(context, blendingStatistics.uNumHits == statistics.uNumHits && blendingStatistics.uNumMisses == statistics.uNumMisses && blendingStatistics.uNumEntries == 1u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testEvictsUnusedEntries
+  Summary:  Checks that BeginFrame keeps the entries looked up or
+            inserted during the last frame and evicts the others, that
+            transforms held by a caller outlive their eviction, and
+            that Clear counts the entries it evicts
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testEvictsUnusedEntries(TestContext& context)
+{
+    PoseCache poseCache(1.0f / 120.0f);
+    PoseCacheKey usedKey = { .pSkeleton = nullptr, .pClip = nullptr, .uTimeStep = 1u, .uSkippedLevels = 0u };
+    PoseCacheKey unusedKey = { .pSkeleton = nullptr, .pClip = nullptr, .uTimeStep = 2u, .uSkippedLevels = 0u };
+    std::vector<XMMATRIX> aUnusedTransforms = createPoseTransforms(2.0f);
+    poseCache.Insert(usedKey, createPoseTransforms(1.0f));
+    poseCache.Insert(unusedKey, aUnusedTransforms);
+
+    // Both entries were inserted during the first frame
+    poseCache.BeginFrame();
+    PoseCacheStatistics statistics = poseCache.GetStatistics();
+    TEST_CHECK(context, statistics.uNumEntries == 2u && statistics.uNumEvictions == 0u);
+
+    std::shared_ptr<const std::vector<XMMATRIX>> aHeldTransforms = poseCache.Find(unusedKey);
+    TEST_CHECK(context, poseCache.Find(usedKey) != nullptr);
+    poseCache.BeginFrame();
+    TEST_CHECK(context, poseCache.Find(usedKey) != nullptr);
+    poseCache.BeginFrame();
+    statistics = poseCache.GetStatistics();
+    TEST_CHECK(context, statistics.uNumEntries == 1u && statistics.uNumEvictions == 1u);
+    TEST_CHECK(context, !poseCache.Find(unusedKey));
+    TEST_CHECK(context, aHeldTransforms && std::memcmp(aHeldTransforms->data(), aUnusedTransforms.data(), aUnusedTransforms.size() * sizeof(XMMATRIX)) == 0);
+
+    // Only the lookup of the evicted key happened during the last frame
+    poseCache.BeginFrame();
+    statistics = poseCache.GetStatistics();
+    TEST_CHECK(context, statistics.uNumEntries == 0u && statistics.uNumEvictions == 2u);
+
+    poseCache.Insert(usedKey, createPoseTransforms(1.0f));
+    poseCache.Insert(unusedKey, aUnusedTransforms);
+    poseCache.Clear();
+    statistics = poseCache.GetStatistics();
+    TEST_CHECK(context, statistics.uNumEntries == 0u && statistics.uNumEvictions == 4u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterModelTests
+  Summary:  Registers the tests of the animation of Model, of the
+            statistics of its clips and of the pose cache it shares
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterModelTests(TestRunner& runner)
+{
+    runner.Register("Model::Update/MatchesSerialUpdateOnThreads", testMatchesSerialUpdateOnThreads);
+    runner.Register("Model::GetAnimationClipStatistics/ReportsClipStatistics", testReportsClipStatistics);
+    runner.Register("PoseCache::Find/CountsHitsAndMisses", testCountsHitsAndMisses);
+    runner.Register("PoseCache::BeginFrame/EvictsUnusedEntries", testEvictsUnusedEntries);
+}
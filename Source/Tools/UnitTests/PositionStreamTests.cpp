@@ -0,0 +1,152 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include "Renderer/PositionStream.h"
+
+using library::PositionStream;
+using library::QuantizedPosition;
+using library::SimpleVertex;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createVertices
+  Summary:  Creates vertices spread irregularly over a box that is not
+            centered on the origin
+  Args:     UINT uNumVertices
+              Number of vertices
+  Returns:  std::vector<SimpleVertex>
+              Vertices, the first two on opposite corners of the box
+-----------------------------------------------------------------F-F*/
+static std::vector<SimpleVertex> createVertices(UINT uNumVertices)
+{
+    std::vector<SimpleVertex> aVertices(uNumVertices);
+    for (UINT i = 0u; i < uNumVertices; ++i)
+    {
+        FLOAT t = static_cast<FLOAT>(i);
+        aVertices[i] =
+        {
+            .Position = XMFLOAT3(-3.0f + 4.0f * std::fmod(t * 0.618034f, 1.0f), 15.0f * std::fmod(t * 0.414214f, 1.0f), 2.0f + 0.5f * std::fmod(t * 0.732051f, 1.0f)),
+            .TexCoord = XMFLOAT2(0.0f, 0.0f),
+            .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f)
+        };
+    }
+    aVertices[0].Position = XMFLOAT3(-3.0f, 0.0f, 2.0f);
+    aVertices[1].Position = XMFLOAT3(1.0f, 15.0f, 2.5f);
+
+    return aVertices;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testExtractsFloatPositions
+  Summary:  Checks that an unquantized stream copies the positions
+            unchanged with a unit scale and no offset
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testExtractsFloatPositions(TestContext& context)
+{
+    const std::vector<SimpleVertex> aVertices = createVertices(257u);
+    PositionStream positionStream;
+    positionStream.Extract(aVertices.data(), static_cast<UINT>(aVertices.size()), FALSE);
+
+    TEST_CHECK(context, !positionStream.IsQuantized());
+    TEST_CHECK(context, positionStream.GetStride() == sizeof(XMFLOAT3));
+    TEST_CHECK(context, positionStream.GetScale().x == 1.0f && positionStream.GetScale().y == 1.0f && positionStream.GetScale().z == 1.0f);
+    TEST_CHECK(context, positionStream.GetOffset().x == 0.0f && positionStream.GetOffset().y == 0.0f && positionStream.GetOffset().z == 0.0f);
+    if (!TEST_CHECK(context, positionStream.GetNumPositions() == aVertices.size()))
+    {
+        return;
+    }
+
+    for (UINT i = 0u; i < aVertices.size(); ++i)
+    {
+        XMFLOAT3 position = positionStream.GetPosition(i);
+        TEST_CHECK(context, position.x == aVertices[i].Position.x && position.y == aVertices[i].Position.y && position.z == aVertices[i].Position.z);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testQuantizesWithinHalfAStep
+  Summary:  Checks that a quantized stream maps the bounds of the
+            vertices onto the full 16-bit range and restores every
+            position within half a quantization step
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testQuantizesWithinHalfAStep(TestContext& context)
+{
+    const std::vector<SimpleVertex> aVertices = createVertices(257u);
+    PositionStream positionStream;
+    positionStream.Extract(aVertices.data(), static_cast<UINT>(aVertices.size()), TRUE);
+
+    TEST_CHECK(context, positionStream.IsQuantized());
+    TEST_CHECK(context, positionStream.GetStride() == sizeof(QuantizedPosition));
+    if (!TEST_CHECK(context, positionStream.GetNumPositions() == aVertices.size()))
+    {
+        return;
+    }
+
+    // The scale and offset are the half extent and center of the bounds
+    const XMFLOAT4& scale = positionStream.GetScale();
+    const XMFLOAT4& offset = positionStream.GetOffset();
+    TEST_CHECK(context, std::abs(scale.x - 2.0f) < 1e-5f && std::abs(scale.y - 7.5f) < 1e-5f && std::abs(scale.z - 0.25f) < 1e-5f);
+    TEST_CHECK(context, std::abs(offset.x + 1.0f) < 1e-5f && std::abs(offset.y - 7.5f) < 1e-5f && std::abs(offset.z - 2.25f) < 1e-5f);
+
+    const FLOAT aTolerances[3] =
+    {
+        scale.x * 0.5f / static_cast<FLOAT>(PositionStream::QUANTIZATION_RANGE) + 1e-6f,
+        scale.y * 0.5f / static_cast<FLOAT>(PositionStream::QUANTIZATION_RANGE) + 1e-6f,
+        scale.z * 0.5f / static_cast<FLOAT>(PositionStream::QUANTIZATION_RANGE) + 1e-6f
+    };
+    for (UINT i = 0u; i < aVertices.size(); ++i)
+    {
+        XMFLOAT3 position = positionStream.GetPosition(i);
+        const XMFLOAT3& original = aVertices[i].Position;
+        TEST_CHECK(context, std::abs(position.x - original.x) <= aTolerances[0]);
+        TEST_CHECK(context, std::abs(position.y - original.y) <= aTolerances[1]);
+        TEST_CHECK(context, std::abs(position.z - original.z) <= aTolerances[2]);
+    }
+
+    // The corners of the bounds land on the ends of the range
+    TEST_CHECK(context, std::abs(positionStream.GetPosition(0u).x + 3.0f) < 1e-5f && std::abs(positionStream.GetPosition(1u).y - 15.0f) < 1e-5f);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsUnitScaleOnFlatAxes
+  Summary:  Checks that an axis on which every vertex lies at the same
+            coordinate keeps a unit scale and restores it exactly
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsUnitScaleOnFlatAxes(TestContext& context)
+{
+    std::vector<SimpleVertex> aVertices = createVertices(64u);
+    for (SimpleVertex& vertex : aVertices)
+    {
+        vertex.Position.y = 4.0f;
+    }
+
+    PositionStream positionStream;
+    positionStream.Extract(aVertices.data(), static_cast<UINT>(aVertices.size()), TRUE);
+
+    TEST_CHECK(context, positionStream.GetScale().y == 1.0f);
+    TEST_CHECK(context, positionStream.GetOffset().y == 4.0f);
+    for (UINT i = 0u; i < positionStream.GetNumPositions(); ++i)
+    {
+        TEST_CHECK(context, positionStream.GetPosition(i).y == 4.0f);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterPositionStreamTests
+  Summary:  Registers the tests of the position-only vertex stream
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterPositionStreamTests(TestRunner& runner)
+{
+    runner.Register("PositionStream::Extract/ExtractsFloatPositions", testExtractsFloatPositions);
+    runner.Register("PositionStream::Extract/QuantizesWithinHalfAStep", testQuantizesWithinHalfAStep);
+    runner.Register("PositionStream::Extract/KeepsUnitScaleOnFlatAxes", testKeepsUnitScaleOnFlatAxes);
+}
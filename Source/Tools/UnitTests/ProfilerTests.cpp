@@ -0,0 +1,145 @@
+#include "LibraryTests.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Profiler/Profiler.h"
+
+using library::ProfileEvent;
+using library::Profiler;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: recordEvents
+  Summary:  Records events whose begin time stamps count up from a
+            first time stamp, each one tick long
+  Args:     PCSTR pszName
+              Name of the events
+            UINT64 ullFirstBegin
+              Begin time stamp of the first event
+            UINT64 uNumEvents
+              Number of events
+-----------------------------------------------------------------F-F*/
+static void recordEvents(PCSTR pszName, UINT64 ullFirstBegin, UINT64 uNumEvents)
+{
+    for (UINT64 i = 0u; i < uNumEvents; ++i)
+    {
+        Profiler::RecordEvent("Test", pszName, ullFirstBegin + i, ullFirstBegin + i + 1u);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isSequence
+  Summary:  Returns whether events have the given name and count up
+            from a first begin time stamp one tick at a time
+  Args:     const std::vector<ProfileEvent>& aEvents
+              Events to check
+            PCSTR pszName
+              Expected name of every event
+            UINT64 ullFirstBegin
+              Expected begin time stamp of the first event
+  Returns:  bool
+              Whether every event matches
+-----------------------------------------------------------------F-F*/
+static bool isSequence(const std::vector<ProfileEvent>& aEvents, PCSTR pszName, UINT64 ullFirstBegin)
+{
+    for (size_t i = 0u; i < aEvents.size(); ++i)
+    {
+        if (std::strcmp(aEvents[i].pszName, pszName) != 0 || aEvents[i].ullBegin != ullFirstBegin + i || aEvents[i].ullEnd != ullFirstBegin + i + 1u)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testWrapsAroundRing
+  Summary:  Checks that a thread keeps every event until its ring is
+            full, and then only its latest EVENTS_PER_THREAD events,
+            oldest first
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testWrapsAroundRing(TestContext& context)
+{
+    // A new thread starts with an empty ring
+    std::vector<ProfileEvent> aEmptyEvents;
+    std::vector<ProfileEvent> aPartialEvents;
+    std::vector<ProfileEvent> aFullEvents;
+    std::vector<ProfileEvent> aWrappedEvents;
+    std::thread thread([&]()
+        {
+            Profiler::GetThreadEvents(aEmptyEvents);
+            recordEvents("Ring", 0u, 3u);
+            Profiler::GetThreadEvents(aPartialEvents);
+            recordEvents("Ring", 3u, Profiler::EVENTS_PER_THREAD - 3u);
+            Profiler::GetThreadEvents(aFullEvents);
+            recordEvents("Ring", Profiler::EVENTS_PER_THREAD, 100u);
+            Profiler::GetThreadEvents(aWrappedEvents);
+        }
+    );
+    thread.join();
+
+    TEST_CHECK(context, aEmptyEvents.empty());
+    TEST_CHECK(context, aPartialEvents.size() == 3u && isSequence(aPartialEvents, "Ring", 0u));
+    TEST_CHECK(context, aFullEvents.size() == Profiler::EVENTS_PER_THREAD && isSequence(aFullEvents, "Ring", 0u));
+    TEST_CHECK(context, aWrappedEvents.size() == Profiler::EVENTS_PER_THREAD && isSequence(aWrappedEvents, "Ring", 100u));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsThreadsApart
+  Summary:  Checks that threads recording at the same time each find
+            exactly their own events in their ring
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsThreadsApart(TestContext& context)
+{
+    static constexpr const PCSTR NAMES[] = { "Thread0", "Thread1", "Thread2", "Thread3" };
+    constexpr const UINT NUM_THREADS = static_cast<UINT>(ARRAYSIZE(NAMES));
+
+    // The threads wait for each other, so their recording overlaps
+    std::atomic<UINT> uNumReadyThreads = 0u;
+    std::vector<std::vector<ProfileEvent>> aaEvents(NUM_THREADS);
+    std::vector<std::thread> aThreads;
+    for (UINT uThread = 0u; uThread < NUM_THREADS; ++uThread)
+    {
+        aThreads.emplace_back([&, uThread]()
+            {
+                uNumReadyThreads.fetch_add(1u);
+                while (uNumReadyThreads.load() < NUM_THREADS)
+                {
+                    std::this_thread::yield();
+                }
+                recordEvents(NAMES[uThread], uThread * 1000000ull, 10000u + uThread);
+                Profiler::GetThreadEvents(aaEvents[uThread]);
+            }
+        );
+    }
+    for (std::thread& thread : aThreads)
+    {
+        thread.join();
+    }
+
+    for (UINT uThread = 0u; uThread < NUM_THREADS; ++uThread)
+    {
+        TEST_CHECK(context, aaEvents[uThread].size() == 10000u + uThread);
+        TEST_CHECK(context, isSequence(aaEvents[uThread], NAMES[uThread], uThread * 1000000ull));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterProfilerTests
+  Summary:  Registers the tests of the per-thread event rings of the
+            profiler
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterProfilerTests(TestRunner& runner)
+{
+    runner.Register("Profiler::RecordEvent/WrapsAroundRing", testWrapsAroundRing);
+    runner.Register("Profiler::RecordEvent/KeepsThreadsApart", testKeepsThreadsApart);
+}
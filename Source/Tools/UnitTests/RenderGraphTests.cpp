@@ -0,0 +1,318 @@
+#include "LibraryTests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Renderer/RenderGraph.h"
+
+using library::RenderGraph;
+using library::RenderGraphTextureDesc;
+
+static constexpr const RenderGraphTextureDesc COLOR_DESC = { .uWidth = 1280u, .uHeight = 720u, .format = DXGI_FORMAT_R16G16B16A16_FLOAT };
+static constexpr const RenderGraphTextureDesc HALF_COLOR_DESC = { .uWidth = 640u, .uHeight = 360u, .format = DXGI_FORMAT_R16G16B16A16_FLOAT };
+static constexpr const RenderGraphTextureDesc DEPTH_DESC = { .uWidth = 1280u, .uHeight = 720u, .format = DXGI_FORMAT_R32_FLOAT };
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getCompiledPosition
+  Summary:  Returns the position of a pass in the compiled order
+  Args:     const RenderGraph& graph
+              Compiled graph
+            UINT uPass
+              Index of the pass
+  Returns:  size_t
+              Position of the pass, the number of compiled passes if
+              the pass was culled
+-----------------------------------------------------------------F-F*/
+static size_t getCompiledPosition(const RenderGraph& graph, UINT uPass)
+{
+    const std::vector<RenderGraph::CompiledPass>& aCompiledPasses = graph.GetCompiledPasses();
+    for (size_t i = 0u; i < aCompiledPasses.size(); ++i)
+    {
+        if (aCompiledPasses[i].uPassIndex == uPass)
+        {
+            return i;
+        }
+    }
+
+    return aCompiledPasses.size();
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testCullsPassesWithoutOutput
+  Summary:  Checks that passes are kept only when an output depends on
+            what they write, directly or through other passes
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testCullsPassesWithoutOutput(TestContext& context)
+{
+    RenderGraph graph;
+    UINT uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    UINT uHistory = graph.ImportTexture(L"History", FALSE);
+    UINT uShadow = graph.CreateTexture(L"Shadow", DEPTH_DESC);
+    UINT uDebug = graph.CreateTexture(L"Debug", COLOR_DESC);
+
+    UINT uShadowPass = graph.AddPass(L"Shadow", nullptr);
+    UINT uDebugPass = graph.AddPass(L"Debug", nullptr);
+    UINT uHistoryPass = graph.AddPass(L"History", nullptr);
+    UINT uMainPass = graph.AddPass(L"Main", nullptr);
+
+    graph.WriteTexture(uShadowPass, uShadow);
+    graph.WriteTexture(uDebugPass, uDebug);
+    graph.WriteTexture(uHistoryPass, uHistory);
+    graph.ReadTexture(uMainPass, uShadow, 0u);
+    graph.WriteTexture(uMainPass, uBackBuffer);
+
+    if (!TEST_CHECK(context, SUCCEEDED(graph.Compile())))
+    {
+        return;
+    }
+
+    TEST_CHECK(context, !graph.IsPassCulled(uShadowPass));
+    TEST_CHECK(context, !graph.IsPassCulled(uMainPass));
+    TEST_CHECK(context, graph.IsPassCulled(uDebugPass));
+    TEST_CHECK(context, graph.IsPassCulled(uHistoryPass));
+    TEST_CHECK(context, graph.GetCompiledPasses().size() == 2u);
+    TEST_CHECK(context, graph.GetPhysicalTextureIndex(uDebug) == RenderGraph::INVALID_HANDLE);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testOrdersPassesAfterTheirProducers
+  Summary:  Checks that every compiled pass runs after the passes
+            writing what it reads, and that the order is the
+            declaration order when it already satisfies them
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testOrdersPassesAfterTheirProducers(TestContext& context)
+{
+    RenderGraph graph;
+    UINT uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    UINT uDepth = graph.CreateTexture(L"Depth", DEPTH_DESC);
+    UINT uShadow = graph.CreateTexture(L"Shadow", DEPTH_DESC);
+    UINT uScene = graph.CreateTexture(L"Scene", COLOR_DESC);
+
+    UINT uShadowPass = graph.AddPass(L"Shadow", nullptr);
+    UINT uDepthPass = graph.AddPass(L"DepthPrepass", nullptr);
+    UINT uMainPass = graph.AddPass(L"Main", nullptr);
+    UINT uSkyPass = graph.AddPass(L"Sky", nullptr);
+    UINT uPostPass = graph.AddPass(L"Post", nullptr);
+
+    graph.WriteTexture(uShadowPass, uShadow);
+    graph.WriteTexture(uDepthPass, uDepth);
+    graph.ReadTexture(uMainPass, uShadow, 2u);
+    graph.ReadDepthStencil(uMainPass, uDepth);
+    graph.WriteTexture(uMainPass, uScene);
+    graph.ReadDepthStencil(uSkyPass, uDepth);
+    graph.WriteTexture(uSkyPass, uScene);
+    graph.ReadTexture(uPostPass, uScene, 0u);
+    graph.WriteTexture(uPostPass, uBackBuffer);
+
+    if (!TEST_CHECK(context, SUCCEEDED(graph.Compile())))
+    {
+        return;
+    }
+
+    TEST_CHECK(context, graph.GetCompiledPasses().size() == 5u);
+    TEST_CHECK(context, getCompiledPosition(graph, uShadowPass) < getCompiledPosition(graph, uMainPass));
+    TEST_CHECK(context, getCompiledPosition(graph, uDepthPass) < getCompiledPosition(graph, uMainPass));
+    TEST_CHECK(context, getCompiledPosition(graph, uMainPass) < getCompiledPosition(graph, uSkyPass));
+    TEST_CHECK(context, getCompiledPosition(graph, uSkyPass) < getCompiledPosition(graph, uPostPass));
+    for (size_t i = 0u; i < graph.GetCompiledPasses().size(); ++i)
+    {
+        TEST_CHECK(context, graph.GetCompiledPasses()[i].uPassIndex == i);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testUnbindsShaderResourcesBeforeWrites
+  Summary:  Checks that a slot is unbound right before a pass renders
+            into the texture bound to it, and that the slots still
+            bound after the last pass are unbound at the end
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testUnbindsShaderResourcesBeforeWrites(TestContext& context)
+{
+    RenderGraph graph;
+    UINT uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    UINT uColor = graph.CreateTexture(L"Color", COLOR_DESC);
+    UINT uBloom = graph.CreateTexture(L"Bloom", HALF_COLOR_DESC);
+
+    UINT uScenePass = graph.AddPass(L"Scene", nullptr);
+    UINT uBloomPass = graph.AddPass(L"Bloom", nullptr);
+    UINT uCompositePass = graph.AddPass(L"Composite", nullptr);
+    UINT uPresentPass = graph.AddPass(L"Present", nullptr);
+
+    graph.WriteTexture(uScenePass, uColor);
+    graph.ReadTexture(uBloomPass, uColor, 3u);
+    graph.WriteTexture(uBloomPass, uBloom);
+    graph.ReadTexture(uCompositePass, uBloom, 0u);
+    graph.WriteTexture(uCompositePass, uColor);
+    graph.ReadTexture(uPresentPass, uColor, 1u);
+    graph.WriteTexture(uPresentPass, uBackBuffer);
+
+    if (!TEST_CHECK(context, SUCCEEDED(graph.Compile())) || !TEST_CHECK(context, graph.GetCompiledPasses().size() == 4u))
+    {
+        return;
+    }
+
+    const std::vector<RenderGraph::CompiledPass>& aCompiledPasses = graph.GetCompiledPasses();
+    TEST_CHECK(context, aCompiledPasses[getCompiledPosition(graph, uScenePass)].aUnbindSlots.empty());
+    TEST_CHECK(context, aCompiledPasses[getCompiledPosition(graph, uBloomPass)].aUnbindSlots.empty());
+    TEST_CHECK(context, aCompiledPasses[getCompiledPosition(graph, uCompositePass)].aUnbindSlots == std::vector<UINT>({ 3u }));
+    TEST_CHECK(context, aCompiledPasses[getCompiledPosition(graph, uPresentPass)].aUnbindSlots.empty());
+    TEST_CHECK(context, graph.GetFinalUnbindSlots() == std::vector<UINT>({ 0u, 1u }));
+
+    std::vector<UINT> aUnboundSlots;
+    graph.Execute([](UINT) {}, [&aUnboundSlots](UINT uSlot) { aUnboundSlots.push_back(uSlot); });
+    TEST_CHECK(context, aUnboundSlots == std::vector<UINT>({ 3u, 0u, 1u }));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testRejectsReadBeforeWrite
+  Summary:  Checks that reading a transient texture no earlier pass
+            writes, or sampling a texture the same pass renders into,
+            fails to compile
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testRejectsReadBeforeWrite(TestContext& context)
+{
+    RenderGraph graph;
+    UINT uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    UINT uHistory = graph.ImportTexture(L"History", FALSE);
+    UINT uColor = graph.CreateTexture(L"Color", COLOR_DESC);
+
+    UINT uPostPass = graph.AddPass(L"Post", nullptr);
+    UINT uScenePass = graph.AddPass(L"Scene", nullptr);
+    graph.ReadTexture(uPostPass, uColor, 0u);
+    graph.ReadTexture(uPostPass, uHistory, 1u);
+    graph.WriteTexture(uPostPass, uBackBuffer);
+    graph.WriteTexture(uScenePass, uColor);
+
+    TEST_CHECK(context, graph.Compile() == E_INVALIDARG);
+    TEST_CHECK(context, !graph.IsCompiled());
+
+    graph.Reset();
+    uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    uHistory = graph.ImportTexture(L"History", FALSE);
+    uColor = graph.CreateTexture(L"Color", COLOR_DESC);
+
+    uScenePass = graph.AddPass(L"Scene", nullptr);
+    uPostPass = graph.AddPass(L"Post", nullptr);
+    graph.WriteTexture(uScenePass, uColor);
+    graph.ReadTexture(uPostPass, uColor, 0u);
+    graph.ReadTexture(uPostPass, uHistory, 1u);
+    graph.WriteTexture(uPostPass, uBackBuffer);
+
+    TEST_CHECK(context, SUCCEEDED(graph.Compile()));
+    TEST_CHECK(context, graph.IsCompiled());
+
+    graph.Reset();
+    uColor = graph.CreateTexture(L"Color", COLOR_DESC);
+    uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    uScenePass = graph.AddPass(L"Scene", nullptr);
+    uPostPass = graph.AddPass(L"Post", nullptr);
+    graph.WriteTexture(uScenePass, uColor);
+    graph.ReadTexture(uPostPass, uColor, 0u);
+    graph.WriteTexture(uPostPass, uColor);
+    graph.WriteTexture(uPostPass, uBackBuffer);
+
+    TEST_CHECK(context, graph.Compile() == E_INVALIDARG);
+    TEST_CHECK(context, !graph.IsCompiled());
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testAliasesOnlyDisjointEqualTextures
+  Summary:  Checks that transient textures share a physical texture
+            only when their descriptions are equal and their
+            lifetimes do not overlap
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testAliasesOnlyDisjointEqualTextures(TestContext& context)
+{
+    RenderGraph graph;
+    UINT uBackBuffer = graph.ImportTexture(L"BackBuffer", TRUE);
+    UINT uA = graph.CreateTexture(L"A", COLOR_DESC);
+    UINT uB = graph.CreateTexture(L"B", COLOR_DESC);
+    UINT uC = graph.CreateTexture(L"C", COLOR_DESC);
+    UINT uD = graph.CreateTexture(L"D", HALF_COLOR_DESC);
+    UINT uE = graph.CreateTexture(L"E", COLOR_DESC);
+
+    UINT aPasses[5] = {};
+    for (UINT i = 0u; i < 5u; ++i)
+    {
+        aPasses[i] = graph.AddPass(L"Pass", nullptr);
+    }
+
+    // A lives in passes 0-1, B in 1-2, C in 2-3, D in 3-4, E in 4-5
+    graph.WriteTexture(aPasses[0], uA);
+    graph.ReadTexture(aPasses[1], uA, 0u);
+    graph.WriteTexture(aPasses[1], uB);
+    graph.ReadTexture(aPasses[2], uB, 0u);
+    graph.WriteTexture(aPasses[2], uC);
+    graph.ReadTexture(aPasses[3], uC, 0u);
+    graph.WriteTexture(aPasses[3], uD);
+    graph.ReadTexture(aPasses[4], uD, 0u);
+    graph.WriteTexture(aPasses[4], uE);
+    UINT uPresentPass = graph.AddPass(L"Present", nullptr);
+    graph.ReadTexture(uPresentPass, uE, 0u);
+    graph.WriteTexture(uPresentPass, uBackBuffer);
+
+    if (!TEST_CHECK(context, SUCCEEDED(graph.Compile())))
+    {
+        return;
+    }
+
+    UINT uPhysicalA = graph.GetPhysicalTextureIndex(uA);
+    UINT uPhysicalB = graph.GetPhysicalTextureIndex(uB);
+    UINT uPhysicalC = graph.GetPhysicalTextureIndex(uC);
+    UINT uPhysicalD = graph.GetPhysicalTextureIndex(uD);
+    UINT uPhysicalE = graph.GetPhysicalTextureIndex(uE);
+
+    // Overlapping lifetimes never share
+    TEST_CHECK(context, uPhysicalA != uPhysicalB);
+    TEST_CHECK(context, uPhysicalB != uPhysicalC);
+    TEST_CHECK(context, uPhysicalD != uPhysicalE);
+
+    // Disjoint lifetimes with equal descriptions share
+    TEST_CHECK(context, uPhysicalC == uPhysicalA);
+    TEST_CHECK(context, uPhysicalE == uPhysicalA || uPhysicalE == uPhysicalB);
+
+    // A different description never shares
+    TEST_CHECK(context, uPhysicalD != uPhysicalA && uPhysicalD != uPhysicalB);
+
+    TEST_CHECK(context, graph.GetPhysicalTextureIndex(uBackBuffer) == RenderGraph::INVALID_HANDLE);
+    if (!TEST_CHECK(context, graph.GetNumPhysicalTextures() == 3u))
+    {
+        return;
+    }
+
+    const UINT aResources[] = { uA, uB, uC, uD, uE };
+    for (UINT uResource : aResources)
+    {
+        const RenderGraphTextureDesc& physicalDesc = graph.GetPhysicalTextureDesc(graph.GetPhysicalTextureIndex(uResource));
+        const RenderGraphTextureDesc& desc = uResource == uD ? HALF_COLOR_DESC : COLOR_DESC;
+        TEST_CHECK(context, physicalDesc.uWidth == desc.uWidth && physicalDesc.uHeight == desc.uHeight && physicalDesc.format == desc.format);
+    }
+
+    TEST_CHECK(context, graph.GetTransientMemorySize() == 2u * 1280u * 720u * 8u + 640u * 360u * 8u);
+    TEST_CHECK(context, graph.GetUnaliasedTransientMemorySize() == 4u * 1280u * 720u * 8u + 640u * 360u * 8u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterRenderGraphTests
+  Summary:  Registers the tests of the render graph compilation
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterRenderGraphTests(TestRunner& runner)
+{
+    runner.Register("RenderGraph::Compile/CullsPassesWithoutOutput", testCullsPassesWithoutOutput);
+    runner.Register("RenderGraph::Compile/OrdersPassesAfterTheirProducers", testOrdersPassesAfterTheirProducers);
+    runner.Register("RenderGraph::Compile/UnbindsShaderResourcesBeforeWrites", testUnbindsShaderResourcesBeforeWrites);
+    runner.Register("RenderGraph::Compile/RejectsReadBeforeWrite", testRejectsReadBeforeWrite);
+    runner.Register("RenderGraph::Compile/AliasesOnlyDisjointEqualTextures", testAliasesOnlyDisjointEqualTextures);
+}
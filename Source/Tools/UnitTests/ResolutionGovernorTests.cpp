@@ -0,0 +1,251 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include "Renderer/ResolutionGovernor.h"
+
+using library::ResolutionGovernor;
+using library::ResolutionGovernorDesc;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getDesc
+  Summary:  Returns the description the renderer and the replay tool
+            use, holding 60 frames per second
+  Returns:  ResolutionGovernorDesc
+              Scales from 0.5 to 1 in steps of 0.05 with a hysteresis
+              of 5 percent over 8 frames
+-----------------------------------------------------------------F-F*/
+static ResolutionGovernorDesc getDesc()
+{
+    return
+    {
+        .targetFrameTime = 1.0f / 60.0f,
+        .minScale = 0.5f,
+        .maxScale = 1.0f,
+        .scaleStep = 0.05f,
+        .proportionalGain = 0.3f,
+        .integralGain = 0.05f,
+        .hysteresis = 0.05f,
+        .uHistoryLength = 8u
+    };
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createTrace
+  Summary:  Creates a trace of full resolution frame times the way the
+            benchmark mode records them: a steady frame time with up to
+            3 percent of jitter and a hitch of three times the frame
+            time every 97 frames
+  Args:     UINT uNumFrames
+              Number of frames
+            FLOAT frameTime
+              Steady frame time in seconds
+  Returns:  std::vector<FLOAT>
+              Frame times in seconds
+-----------------------------------------------------------------F-F*/
+static std::vector<FLOAT> createTrace(UINT uNumFrames, FLOAT frameTime)
+{
+    static constexpr const FLOAT JITTER[] = { 0.0f, 0.021f, -0.013f, 0.03f, -0.027f, 0.008f, -0.004f, 0.017f, -0.03f, 0.011f, -0.019f };
+
+    std::vector<FLOAT> aFrameTimes(uNumFrames);
+    for (UINT i = 0u; i < uNumFrames; ++i)
+    {
+        aFrameTimes[i] = frameTime * (1.0f + JITTER[i % ARRAYSIZE(JITTER)]) * (i % 97u == 96u ? 3.0f : 1.0f);
+    }
+
+    return aFrameTimes;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: replayTrace
+  Summary:  Replays a trace through the governor the way the replay
+            tool does: the pixel bound share of every recorded frame
+            time is scaled by the pixel count of the current scale
+  Args:     ResolutionGovernor& governor
+              Governor to replay the trace through
+            const std::vector<FLOAT>& aRecordedFrameTimes
+              Frame times recorded at full resolution
+            FLOAT pixelShare
+              Share of the frame time that scales with the pixel count
+            std::vector<FLOAT>& aScales
+              Receives the scale every frame was rendered at
+  Returns:  std::vector<FLOAT>
+              Frame times at the scales of the governor
+-----------------------------------------------------------------F-F*/
+static std::vector<FLOAT> replayTrace(
+    ResolutionGovernor& governor,
+    const std::vector<FLOAT>& aRecordedFrameTimes,
+    FLOAT pixelShare,
+    std::vector<FLOAT>& aScales
+)
+{
+    std::vector<FLOAT> aFrameTimes(aRecordedFrameTimes.size());
+    aScales.resize(aRecordedFrameTimes.size());
+    for (size_t i = 0u; i < aRecordedFrameTimes.size(); ++i)
+    {
+        aScales[i] = governor.GetScale();
+        aFrameTimes[i] = aRecordedFrameTimes[i] * ((1.0f - pixelShare) + pixelShare * aScales[i] * aScales[i]);
+        governor.AddFrameTime(aFrameTimes[i]);
+    }
+
+    return aFrameTimes;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: countScaleChanges
+  Summary:  Counts how often the scale changes from one frame to the
+            next from a frame on
+  Args:     const std::vector<FLOAT>& aScales
+              Scales of the frames
+            size_t uFirstFrame
+              First frame to count from
+  Returns:  UINT
+              Number of changes
+-----------------------------------------------------------------F-F*/
+static UINT countScaleChanges(const std::vector<FLOAT>& aScales, size_t uFirstFrame)
+{
+    UINT uNumChanges = 0u;
+    for (size_t i = uFirstFrame + 1u; i < aScales.size(); ++i)
+    {
+        uNumChanges += aScales[i] != aScales[i - 1u] ? 1u : 0u;
+    }
+
+    return uNumChanges;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testConvergesToTarget
+  Summary:  Checks that a trace too slow at full resolution settles on
+            a scale whose median frame time is within the hysteresis of
+            the target, and that a trace which turns fast again brings
+            the full resolution back
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testConvergesToTarget(TestContext& context)
+{
+    const ResolutionGovernorDesc desc = getDesc();
+    ResolutionGovernor governor(desc);
+    TEST_CHECK(context, governor.GetScale() == 1.0f);
+
+    // 22 ms at full resolution with 80 percent pixel bound reaches 16.7 ms at a scale of 0.835
+    std::vector<FLOAT> aScales;
+    replayTrace(governor, createTrace(2000u, 0.022f), 0.8f, aScales);
+    TEST_CHECK(context, governor.GetScale() < 1.0f);
+    TEST_CHECK(context, std::abs(governor.GetFilteredFrameTime() - desc.targetFrameTime) <= desc.hysteresis * desc.targetFrameTime);
+    TEST_CHECK(context, countScaleChanges(aScales, 1000u) == 0u);
+
+    // Scales below 0.85 would leave more than the hysteresis of headroom
+    TEST_CHECK(context, std::abs(governor.GetScale() - 0.85f) < 1e-4f);
+
+    replayTrace(governor, createTrace(2000u, 0.012f), 0.8f, aScales);
+    TEST_CHECK(context, governor.GetScale() == 1.0f);
+    TEST_CHECK(context, countScaleChanges(aScales, 1000u) == 0u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testHysteresisStopsOscillation
+  Summary:  Checks that a trace whose target lies between two steps of
+            the scale keeps oscillating without a hysteresis band and
+            holds one scale with it, that a trace jittering around the
+            target never leaves the full resolution, and that scale
+            changes are at least a full history apart
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testHysteresisStopsOscillation(TestContext& context)
+{
+    const std::vector<FLOAT> aTrace = createTrace(3000u, 0.022f);
+    ResolutionGovernorDesc desc = getDesc();
+    std::vector<FLOAT> aScales;
+
+    desc.hysteresis = 0.0f;
+    ResolutionGovernor unbanded(desc);
+    replayTrace(unbanded, aTrace, 0.8f, aScales);
+    TEST_CHECK(context, countScaleChanges(aScales, 1000u) > 10u);
+
+    ResolutionGovernor governor(getDesc());
+    replayTrace(governor, aTrace, 0.8f, aScales);
+    TEST_CHECK(context, countScaleChanges(aScales, 1000u) == 0u);
+
+    // Frames of the previous scale never drive the next decision
+    size_t uLastChange = 0u;
+    for (size_t i = 1u; i < aScales.size(); ++i)
+    {
+        if (aScales[i] != aScales[i - 1u])
+        {
+            TEST_CHECK(context, i - uLastChange >= getDesc().uHistoryLength);
+            uLastChange = i;
+        }
+    }
+
+    // 1.5 percent under the target with 3 percent of jitter and hitches stays inside the band
+    governor.Reset();
+    replayTrace(governor, createTrace(2000u, 0.985f / 60.0f), 0.8f, aScales);
+    TEST_CHECK(context, countScaleChanges(aScales, 0u) == 0u);
+    TEST_CHECK(context, governor.GetScale() == 1.0f);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testClampsAndSnapsScale
+  Summary:  Checks that every scale is a step of the governor or one of
+            its bounds, that an overloaded trace stops at the minimum
+            scale and an idle one at the maximum, and that the integral
+            does not wind up at the minimum
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testClampsAndSnapsScale(TestContext& context)
+{
+    // A minimum that is not a step is only reached through the clamp
+    ResolutionGovernorDesc desc = getDesc();
+    desc.minScale = 0.52f;
+    ResolutionGovernor governor(desc);
+    std::vector<FLOAT> aScales;
+
+    std::vector<FLOAT> aTrace = createTrace(1000u, 0.05f);
+    std::vector<FLOAT> aIdleTrace = createTrace(1000u, 0.005f);
+    aTrace.insert(aTrace.end(), aIdleTrace.begin(), aIdleTrace.end());
+    replayTrace(governor, aTrace, 0.8f, aScales);
+
+    for (FLOAT scale : aScales)
+    {
+        FLOAT steps = scale / desc.scaleStep;
+        TEST_CHECK(context, scale == desc.minScale || std::abs(steps - std::round(steps)) < 1e-4f);
+        TEST_CHECK(context, scale >= desc.minScale && scale <= desc.maxScale);
+    }
+    TEST_CHECK(context, aScales[999] == desc.minScale);
+    TEST_CHECK(context, countScaleChanges(aScales, 500u) > 0u);
+    TEST_CHECK(context, aScales.back() == desc.maxScale);
+
+    // Leaving the minimum takes one history, not the time the integral spent below it
+    size_t uFirstRaise = 1000u;
+    while (uFirstRaise < aScales.size() && aScales[uFirstRaise] == desc.minScale)
+    {
+        ++uFirstRaise;
+    }
+    TEST_CHECK(context, uFirstRaise - 1000u <= 2u * desc.uHistoryLength);
+
+    // Frame times that are not positive are ignored
+    FLOAT scale = governor.GetScale();
+    for (UINT i = 0u; i < 2u * desc.uHistoryLength; ++i)
+    {
+        TEST_CHECK(context, governor.AddFrameTime(0.0f) == scale);
+        TEST_CHECK(context, governor.AddFrameTime(-1.0f) == scale);
+    }
+    TEST_CHECK(context, governor.GetScale() == scale);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterResolutionGovernorTests
+  Summary:  Registers the tests of the dynamic resolution governor
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterResolutionGovernorTests(TestRunner& runner)
+{
+    runner.Register("ResolutionGovernor::AddFrameTime/ConvergesToTarget", testConvergesToTarget);
+    runner.Register("ResolutionGovernor::AddFrameTime/HysteresisStopsOscillation", testHysteresisStopsOscillation);
+    runner.Register("ResolutionGovernor::AddFrameTime/ClampsAndSnapsScale", testClampsAndSnapsScale);
+}
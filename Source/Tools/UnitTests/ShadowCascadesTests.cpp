@@ -0,0 +1,175 @@
+#include "LibraryTests.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Renderer/ShadowCascades.h"
+
+using library::ShadowCascades;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getCameraProjection
+  Summary:  Returns the projection of the camera of the tests, 45
+            degrees high at 16:9 from 0.1 to 100 units
+  Returns:  XMMATRIX
+              Projection matrix of the camera
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getCameraProjection()
+{
+    return XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 100.0f);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getSceneBounds
+  Summary:  Returns scene bounds much larger than every cascade, so no
+            cascade is shrunk or moved to fit the scene
+  Returns:  BoundingBox
+              World space bounds of the scene
+-----------------------------------------------------------------F-F*/
+static BoundingBox getSceneBounds()
+{
+    return BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1000.0f, 1000.0f, 1000.0f));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testSplitsWithPracticalScheme
+  Summary:  Checks that the split depths blend the logarithmic and the
+            uniform split scheme by the split lambda, and that the
+            last one ends at the nearer of the shadow distance and the
+            far plane
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testSplitsWithPracticalScheme(TestContext& context)
+{
+    const FLOAT nearPlane = 0.1f;
+    const FLOAT aLambdas[] = { 0.0f, 0.5f, 0.75f, 1.0f };
+    const FLOAT aShadowDistances[] = { 50.0f, 500.0f };
+    for (FLOAT shadowDistance : aShadowDistances)
+    {
+        for (FLOAT lambda : aLambdas)
+        {
+            ShadowCascades shadowCascades({ .uNumCascades = 4u, .uResolution = 1024u, .shadowDistance = shadowDistance, .splitLambda = lambda });
+            shadowCascades.Update(XMMatrixIdentity(), getCameraProjection(), XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f), getSceneBounds());
+
+            const FLOAT shadowFar = shadowDistance < 100.0f ? shadowDistance : 100.0f;
+            for (UINT i = 0u; i < 4u; ++i)
+            {
+                FLOAT t = static_cast<FLOAT>(i + 1u) / 4.0f;
+                FLOAT expected = lambda * nearPlane * std::pow(shadowFar / nearPlane, t) + (1.0f - lambda) * (nearPlane + (shadowFar - nearPlane) * t);
+                TEST_CHECK(context, std::abs(shadowCascades.GetSplitDepth(i) - expected) <= 1e-4f * expected);
+            }
+            TEST_CHECK(context, std::abs(shadowCascades.GetSplitDepth(3u) - shadowFar) <= 1e-4f * shadowFar);
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testContainsFrustumSlices
+  Summary:  Checks that the projection of every cascade contains the
+            corners of its slice of a turned camera frustum under an
+            oblique light
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testContainsFrustumSlices(TestContext& context)
+{
+    ShadowCascades shadowCascades({ .uNumCascades = 4u, .uResolution = 1024u, .shadowDistance = 60.0f, .splitLambda = 0.75f });
+    const XMMATRIX cameraWorld = XMMatrixRotationRollPitchYaw(0.35f, 0.5f, 0.0f) * XMMatrixTranslation(12.0f, 8.0f, -30.0f);
+    const XMMATRIX cameraView = XMMatrixInverse(nullptr, cameraWorld);
+    const XMMATRIX cameraProjection = getCameraProjection();
+    shadowCascades.Update(cameraView, cameraProjection, XMVectorSet(1.0f, -2.0f, 0.5f, 0.0f), getSceneBounds());
+
+    XMFLOAT4X4 projection;
+    XMStoreFloat4x4(&projection, cameraProjection);
+    const FLOAT tanHalfFovX = 1.0f / projection._11;
+    const FLOAT tanHalfFovY = 1.0f / projection._22;
+
+    FLOAT splitNear = 0.1f;
+    for (UINT i = 0u; i < 4u; ++i)
+    {
+        const FLOAT splitFar = shadowCascades.GetSplitDepth(i);
+        const XMMATRIX worldToCascade = shadowCascades.GetViewMatrix() * shadowCascades.GetProjectionMatrix(i);
+        for (FLOAT depth : { splitNear, splitFar })
+        {
+            for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+            {
+                FLOAT x = (uCorner & 1u ? 1.0f : -1.0f) * depth * tanHalfFovX;
+                FLOAT y = (uCorner & 2u ? 1.0f : -1.0f) * depth * tanHalfFovY;
+                XMVECTOR corner = XMVector3TransformCoord(XMVectorSet(x, y, depth, 1.0f), cameraWorld);
+                XMFLOAT3 projected;
+                XMStoreFloat3(&projected, XMVector3TransformCoord(corner, worldToCascade));
+                TEST_CHECK(context, std::abs(projected.x) <= 1.0f && std::abs(projected.y) <= 1.0f);
+                TEST_CHECK(context, projected.z >= 0.0f && projected.z <= 1.0f);
+            }
+        }
+        splitNear = splitFar;
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsProjectionWithinATexel
+  Summary:  Checks that moving the camera less than a texel across the
+            light keeps the projections bit for bit once the cascade
+            snapped to a texel, and that the snap moves the cascade by
+            exactly one texel
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsProjectionWithinATexel(TestContext& context)
+{
+    // With the light straight down the x axis of the light view is the world x axis, so moving the camera along x
+    // moves every cascade center by the same distance in light space
+    const XMVECTOR lightDirection = XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f);
+    const XMMATRIX cameraRotation = XMMatrixRotationRollPitchYaw(0.3f, 0.8f, 0.0f);
+    const UINT uNumSteps = 8u;
+    ShadowCascades shadowCascades({ .uNumCascades = 4u, .uResolution = 1024u, .shadowDistance = 60.0f, .splitLambda = 0.75f });
+
+    for (UINT uCascade = 0u; uCascade < 4u; ++uCascade)
+    {
+        shadowCascades.Update(XMMatrixInverse(nullptr, cameraRotation), getCameraProjection(), lightDirection, getSceneBounds());
+        const FLOAT texelSize = shadowCascades.GetTexelSize(uCascade);
+        const FLOAT step = texelSize / static_cast<FLOAT>(uNumSteps);
+
+        // Projections of the cascade over two texels of camera movement in steps of an eighth of a texel
+        XMFLOAT4X4 aProjections[2u * uNumSteps + 1u];
+        for (UINT k = 0u; k <= 2u * uNumSteps; ++k)
+        {
+            XMMATRIX cameraWorld = cameraRotation * XMMatrixTranslation(static_cast<FLOAT>(k) * step, 0.0f, 0.0f);
+            shadowCascades.Update(XMMatrixInverse(nullptr, cameraWorld), getCameraProjection(), lightDirection, getSceneBounds());
+            XMStoreFloat4x4(&aProjections[k], shadowCascades.GetProjectionMatrix(uCascade));
+        }
+
+        auto getLeft = [&aProjections](UINT k) { return (-1.0f - aProjections[k]._41) / aProjections[k]._11; };
+        UINT uSnap = 1u;
+        while (uSnap <= uNumSteps && std::memcmp(&aProjections[uSnap], &aProjections[uSnap - 1u], sizeof(XMFLOAT4X4)) == 0)
+        {
+            ++uSnap;
+        }
+        if (!TEST_CHECK(context, uSnap <= uNumSteps))
+        {
+            return;
+        }
+        TEST_CHECK(context, std::abs(getLeft(uSnap) - getLeft(uSnap - 1u) - texelSize) <= 1e-3f * texelSize);
+        TEST_CHECK(context, aProjections[uSnap]._11 == aProjections[uSnap - 1u]._11 && aProjections[uSnap]._22 == aProjections[uSnap - 1u]._22);
+
+        // Every later position less than a texel away from the snap keeps the projection
+        for (UINT k = uSnap + 1u; k < uSnap + uNumSteps - 1u; ++k)
+        {
+            TEST_CHECK(context, std::memcmp(&aProjections[k], &aProjections[uSnap], sizeof(XMFLOAT4X4)) == 0);
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterShadowCascadesTests
+  Summary:  Registers the tests of the cascaded shadow map fitting
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterShadowCascadesTests(TestRunner& runner)
+{
+    runner.Register("ShadowCascades::Update/SplitsWithPracticalScheme", testSplitsWithPracticalScheme);
+    runner.Register("ShadowCascades::Update/ContainsFrustumSlices", testContainsFrustumSlices);
+    runner.Register("ShadowCascades::Update/KeepsProjectionWithinATexel", testKeepsProjectionWithinATexel);
+}
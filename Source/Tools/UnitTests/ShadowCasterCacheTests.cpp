@@ -0,0 +1,223 @@
+#include "LibraryTests.h"
+
+#include <vector>
+
+#include "Renderer/ShadowCasterCache.h"
+#include "Renderer/ViewSet.h"
+
+using library::ShadowCasterCache;
+using library::ViewSet;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getLightView
+  Summary:  Returns the view matrix of a light looking straight down
+            from 50 units above a point of the ground
+  Args:     FLOAT x
+              X coordinate of the point below the light
+  Returns:  XMMATRIX
+              View matrix of the light
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getLightView(FLOAT x)
+{
+    return XMMatrixLookToLH(XMVectorSet(x, 50.0f, 0.0f, 1.0f), XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: getLightProjection
+  Summary:  Returns an orthographic projection of the light covering a
+            square of the ground
+  Args:     FLOAT width
+              Width of the square
+  Returns:  XMMATRIX
+              Projection matrix of the light
+-----------------------------------------------------------------F-F*/
+static XMMATRIX getLightProjection(FLOAT width)
+{
+    return XMMatrixOrthographicLH(width, width, 1.0f, 100.0f);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: endFrame
+  Summary:  Runs one frame of the cache the way the shadow pass does:
+            culls the casters against the light frustum and adds the
+            visible ones in the given order
+  Args:     ShadowCasterCache& shadowCasterCache
+              Cache to run the frame of
+            const XMMATRIX& lightView
+              View matrix of the light
+            const XMMATRIX& lightProjection
+              Projection matrix of the light
+            const std::vector<XMMATRIX>& aWorlds
+              World matrices of the casters, whose addresses identify
+              the casters across frames
+            const std::vector<UINT>& aOrder
+              Order the casters are added in
+  Returns:  BOOL
+              Result of EndFrame
+-----------------------------------------------------------------F-F*/
+static BOOL endFrame(
+    ShadowCasterCache& shadowCasterCache,
+    const XMMATRIX& lightView,
+    const XMMATRIX& lightProjection,
+    const std::vector<XMMATRIX>& aWorlds,
+    const std::vector<UINT>& aOrder
+)
+{
+    ViewSet viewSet;
+    UINT uLight = viewSet.AddView(L"Light");
+    viewSet.SetViewTransform(uLight, lightView, lightProjection);
+    for (const XMMATRIX& world : aWorlds)
+    {
+        viewSet.AddItem(BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)), world);
+    }
+    viewSet.Cull();
+
+    shadowCasterCache.BeginFrame(lightView, lightProjection);
+    for (UINT uCaster : aOrder)
+    {
+        if (viewSet.IsVisible(uLight, uCaster))
+        {
+            shadowCasterCache.AddStaticCaster(&aWorlds[uCaster], aWorlds[uCaster]);
+        }
+    }
+
+    return shadowCasterCache.EndFrame();
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsStillFramesClean
+  Summary:  Checks that only the first frame is dirty while the light
+            and the casters stay where they are
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsStillFramesClean(TestContext& context)
+{
+    const std::vector<XMMATRIX> aWorlds =
+    {
+        XMMatrixTranslation(-10.0f, 0.0f, 0.0f),
+        XMMatrixTranslation(0.0f, 0.0f, 5.0f),
+        XMMatrixTranslation(10.0f, 2.0f, -5.0f)
+    };
+    const std::vector<UINT> aOrder = { 0u, 1u, 2u };
+    ShadowCasterCache shadowCasterCache;
+
+    TEST_CHECK(context, shadowCasterCache.IsDirty());
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    for (UINT uFrame = 0u; uFrame < 3u; ++uFrame)
+    {
+        TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+        TEST_CHECK(context, !shadowCasterCache.IsDirty());
+        TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 3u);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testDirtiesOnMovement
+  Summary:  Checks that a moved caster, a moved light, a changed light
+            projection, an added caster and Invalidate each make one
+            frame dirty, and the frame after it clean again
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testDirtiesOnMovement(TestContext& context)
+{
+    std::vector<XMMATRIX> aWorlds =
+    {
+        XMMatrixTranslation(-10.0f, 0.0f, 0.0f),
+        XMMatrixTranslation(0.0f, 0.0f, 5.0f),
+        XMMatrixTranslation(10.0f, 2.0f, -5.0f),
+        XMMatrixTranslation(5.0f, 0.0f, 5.0f)
+    };
+    std::vector<UINT> aOrder = { 0u, 1u, 2u };
+    ShadowCasterCache shadowCasterCache;
+    endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder);
+
+    aWorlds[1] = XMMatrixTranslation(0.0f, 0.0f, 5.5f);
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(40.0f), aWorlds, aOrder));
+
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+
+    aOrder.push_back(3u);
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+    TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 4u);
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+
+    shadowCasterCache.Invalidate();
+    TEST_CHECK(context, shadowCasterCache.IsDirty());
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(1.0f), getLightProjection(45.0f), aWorlds, aOrder));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testIgnoresCasterOrder
+  Summary:  Checks that adding the same casters in another order, as
+            the front to back sort may do, keeps the frame clean
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testIgnoresCasterOrder(TestContext& context)
+{
+    const std::vector<XMMATRIX> aWorlds =
+    {
+        XMMatrixTranslation(-10.0f, 0.0f, 0.0f),
+        XMMatrixTranslation(0.0f, 0.0f, 5.0f),
+        XMMatrixTranslation(10.0f, 2.0f, -5.0f),
+        XMMatrixTranslation(5.0f, 0.0f, 5.0f)
+    };
+    ShadowCasterCache shadowCasterCache;
+    endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, { 0u, 1u, 2u, 3u });
+
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, { 3u, 2u, 1u, 0u }));
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, { 2u, 0u, 3u, 1u }));
+    TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 4u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testCullsCastersOutsideLightFrustum
+  Summary:  Checks that a caster outside the light frustum is not
+            cached, so moving it keeps the frame clean until it enters
+            the frustum
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testCullsCastersOutsideLightFrustum(TestContext& context)
+{
+    std::vector<XMMATRIX> aWorlds =
+    {
+        XMMatrixTranslation(-10.0f, 0.0f, 0.0f),
+        XMMatrixTranslation(0.0f, 0.0f, 5.0f),
+        XMMatrixTranslation(100.0f, 0.0f, 0.0f)
+    };
+    const std::vector<UINT> aOrder = { 0u, 1u, 2u };
+    ShadowCasterCache shadowCasterCache;
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 2u);
+
+    aWorlds[2] = XMMatrixTranslation(200.0f, 0.0f, 0.0f);
+    TEST_CHECK(context, !endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 2u);
+
+    aWorlds[2] = XMMatrixTranslation(15.0f, 0.0f, 0.0f);
+    TEST_CHECK(context, endFrame(shadowCasterCache, getLightView(0.0f), getLightProjection(40.0f), aWorlds, aOrder));
+    TEST_CHECK(context, shadowCasterCache.GetNumStaticCasters() == 3u);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterShadowCasterCacheTests
+  Summary:  Registers the tests of the static shadow caster cache
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterShadowCasterCacheTests(TestRunner& runner)
+{
+    runner.Register("ShadowCasterCache::EndFrame/KeepsStillFramesClean", testKeepsStillFramesClean);
+    runner.Register("ShadowCasterCache::EndFrame/DirtiesOnMovement", testDirtiesOnMovement);
+    runner.Register("ShadowCasterCache::EndFrame/IgnoresCasterOrder", testIgnoresCasterOrder);
+    runner.Register("ShadowCasterCache::EndFrame/CullsCastersOutsideLightFrustum", testCullsCastersOutsideLightFrustum);
+}
@@ -0,0 +1,298 @@
+#include "LibraryTests.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Renderer/StaticBatch.h"
+#include "TestRenderable.h"
+
+using library::Material;
+using library::SimpleVertex;
+using library::StaticBatch;
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+    Struct:   StaticBatchScene
+
+    Summary:  Textured quads placed with different world matrices,
+              whose two triangles use different materials, merged by
+              the tests
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct StaticBatchScene
+{
+    std::shared_ptr<Material> aMaterials[3];
+    std::vector<std::unique_ptr<TestRenderable>> aSources;
+};
+
+static const std::vector<SimpleVertex> QUAD_VERTICES =
+{
+    { .Position = XMFLOAT3(-1.0f, -1.0f, 0.0f), .TexCoord = XMFLOAT2(0.0f, 1.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+    { .Position = XMFLOAT3(-1.0f, 1.0f, 0.0f), .TexCoord = XMFLOAT2(0.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+    { .Position = XMFLOAT3(1.0f, 1.0f, 0.0f), .TexCoord = XMFLOAT2(1.0f, 0.0f), .Normal = XMFLOAT3(0.0f, 0.6f, -0.8f) },
+    { .Position = XMFLOAT3(1.0f, -1.0f, 0.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3(0.6f, 0.0f, -0.8f) },
+};
+static const std::vector<WORD> QUAD_INDICES = { 0u, 1u, 2u, 0u, 2u, 3u };
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: createScene
+  Summary:  Creates three quads. The first draws its triangles with
+            materials 0 and 1 and is translated, the second draws both
+            triangles with material 1 and is rotated and scaled
+            unevenly, the third draws its triangles with materials 2
+            and 0 and is rotated and translated
+  Returns:  StaticBatchScene
+              Quads and their materials
+-----------------------------------------------------------------F-F*/
+static StaticBatchScene createScene()
+{
+    StaticBatchScene scene;
+    scene.aMaterials[0] = std::make_shared<Material>(L"Red");
+    scene.aMaterials[1] = std::make_shared<Material>(L"Blue");
+    scene.aMaterials[2] = std::make_shared<Material>(L"Green");
+
+    std::unique_ptr<TestRenderable> first = std::make_unique<TestRenderable>(QUAD_VERTICES, QUAD_INDICES);
+    first->AddMaterial(scene.aMaterials[0]);
+    first->AddMaterial(scene.aMaterials[1]);
+    first->AddMesh(0u, 3u, 0u);
+    first->AddMesh(3u, 3u, 1u);
+    first->Translate(XMVectorSet(1.0f, 2.0f, 3.0f, 0.0f));
+    scene.aSources.push_back(std::move(first));
+
+    std::unique_ptr<TestRenderable> second = std::make_unique<TestRenderable>(QUAD_VERTICES, QUAD_INDICES);
+    second->AddMaterial(scene.aMaterials[1]);
+    second->AddMesh(0u, 6u, 0u);
+    second->RotateY(XM_PIDIV2);
+    second->Scale(2.0f, 0.5f, 3.0f);
+    scene.aSources.push_back(std::move(second));
+
+    std::unique_ptr<TestRenderable> third = std::make_unique<TestRenderable>(QUAD_VERTICES, QUAD_INDICES);
+    third->AddMaterial(scene.aMaterials[2]);
+    third->AddMaterial(scene.aMaterials[0]);
+    third->AddMesh(0u, 3u, 0u);
+    third->AddMesh(3u, 3u, 1u);
+    third->RotateX(0.3f);
+    third->Translate(XMVectorSet(-5.0f, 0.0f, 7.0f, 0.0f));
+    scene.aSources.push_back(std::move(third));
+
+    return scene;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: mergeScene
+  Summary:  Appends every quad of the scene to the batch and builds it
+  Args:     const StaticBatchScene& scene
+              Quads to merge
+            StaticBatch& batch
+              Empty batch
+  Returns:  bool
+              Whether every quad was appended
+-----------------------------------------------------------------F-F*/
+static bool mergeScene(const StaticBatchScene& scene, StaticBatch& batch)
+{
+    for (const std::unique_ptr<TestRenderable>& source : scene.aSources)
+    {
+        if (FAILED(batch.Append(*source)))
+        {
+            return false;
+        }
+    }
+    batch.Build();
+
+    return true;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: isNear
+  Summary:  Returns whether two vectors are equal up to rounding
+  Args:     FXMVECTOR a
+              First vector
+            FXMVECTOR b
+              Second vector
+  Returns:  bool
+              Whether no component differs by more than 1e-5
+-----------------------------------------------------------------F-F*/
+static bool isNear(FXMVECTOR a, FXMVECTOR b)
+{
+    return XMVector3NearEqual(a, b, XMVectorReplicate(1e-5f));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testTransformsVerticesIntoWorldSpace
+  Summary:  Checks that every merged vertex is the source vertex
+            transformed by the world matrix of its source, with the
+            normal transformed by the inverse transpose
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testTransformsVerticesIntoWorldSpace(TestContext& context)
+{
+    StaticBatchScene scene = createScene();
+    StaticBatch batch(*scene.aSources[0]);
+    if (!TEST_CHECK(context, mergeScene(scene, batch)) || !TEST_CHECK(context, batch.GetNumVertices() == 12u))
+    {
+        return;
+    }
+
+    for (UINT uSource = 0u; uSource < scene.aSources.size(); ++uSource)
+    {
+        XMMATRIX world = scene.aSources[uSource]->GetWorldMatrix();
+        XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+        for (UINT i = 0u; i < QUAD_VERTICES.size(); ++i)
+        {
+            const SimpleVertex& original = QUAD_VERTICES[i];
+            const SimpleVertex& merged = batch.GetVertex(uSource * static_cast<UINT>(QUAD_VERTICES.size()) + i);
+
+            XMVECTOR expectedPosition = XMVector3TransformCoord(XMLoadFloat3(&original.Position), world);
+            XMVECTOR expectedNormal = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&original.Normal), normalMatrix));
+            TEST_CHECK(context, isNear(XMLoadFloat3(&merged.Position), expectedPosition));
+            TEST_CHECK(context, isNear(XMLoadFloat3(&merged.Normal), expectedNormal));
+            TEST_CHECK(context, merged.TexCoord.x == original.TexCoord.x && merged.TexCoord.y == original.TexCoord.y);
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testGroupsIndicesByMaterial
+  Summary:  Checks that the built batch has one mesh per material, in
+            the order the materials were first appended, and that every
+            sub-range lies inside the mesh of its material and indexes
+            the vertices of its source mesh
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testGroupsIndicesByMaterial(TestContext& context)
+{
+    StaticBatchScene scene = createScene();
+    StaticBatch batch(*scene.aSources[0]);
+    if (!TEST_CHECK(context, mergeScene(scene, batch)))
+    {
+        return;
+    }
+
+    TEST_CHECK(context, batch.IsBuilt());
+    TEST_CHECK(context, batch.GetNumSources() == 3u);
+    TEST_CHECK(context, batch.GetNumIndices() == 18u);
+    if (!TEST_CHECK(context, batch.GetNumMaterials() == 3u) || !TEST_CHECK(context, batch.GetNumMeshes() == 3u))
+    {
+        return;
+    }
+
+    // Red is used by the first and third quads, blue by the first and second, green by the third
+    const UINT aExpectedNumIndices[] = { 6u, 9u, 3u };
+    UINT uExpectedBaseIndex = 0u;
+    for (UINT uMaterial = 0u; uMaterial < 3u; ++uMaterial)
+    {
+        TEST_CHECK(context, batch.GetMaterial(uMaterial) == scene.aMaterials[uMaterial]);
+        TEST_CHECK(context, batch.GetMesh(uMaterial).uMaterialIndex == uMaterial);
+        TEST_CHECK(context, batch.GetMesh(uMaterial).uBaseIndex == uExpectedBaseIndex);
+        TEST_CHECK(context, batch.GetMesh(uMaterial).uNumIndices == aExpectedNumIndices[uMaterial]);
+        uExpectedBaseIndex += aExpectedNumIndices[uMaterial];
+    }
+
+    // One sub-range per source mesh, in append order
+    struct ExpectedSubRange
+    {
+        UINT uSourceIndex;
+        UINT uSourceBaseIndex;
+        UINT uNumIndices;
+        UINT uMaterialIndex;
+    };
+    const ExpectedSubRange aExpectedSubRanges[] =
+    {
+        { .uSourceIndex = 0u, .uSourceBaseIndex = 0u, .uNumIndices = 3u, .uMaterialIndex = 0u },
+        { .uSourceIndex = 0u, .uSourceBaseIndex = 3u, .uNumIndices = 3u, .uMaterialIndex = 1u },
+        { .uSourceIndex = 1u, .uSourceBaseIndex = 0u, .uNumIndices = 6u, .uMaterialIndex = 1u },
+        { .uSourceIndex = 2u, .uSourceBaseIndex = 0u, .uNumIndices = 3u, .uMaterialIndex = 2u },
+        { .uSourceIndex = 2u, .uSourceBaseIndex = 3u, .uNumIndices = 3u, .uMaterialIndex = 0u },
+    };
+    if (!TEST_CHECK(context, batch.GetNumSubRanges() == ARRAYSIZE(aExpectedSubRanges)))
+    {
+        return;
+    }
+
+    for (UINT uSubRange = 0u; uSubRange < ARRAYSIZE(aExpectedSubRanges); ++uSubRange)
+    {
+        const ExpectedSubRange& expected = aExpectedSubRanges[uSubRange];
+        const StaticBatch::SubRange& subRange = batch.GetSubRange(uSubRange);
+        TEST_CHECK(context, subRange.uSourceIndex == expected.uSourceIndex);
+        TEST_CHECK(context, subRange.uNumIndices == expected.uNumIndices);
+        if (!TEST_CHECK(context, subRange.uMaterialIndex == expected.uMaterialIndex))
+        {
+            continue;
+        }
+
+        const auto& mesh = batch.GetMesh(subRange.uMaterialIndex);
+        TEST_CHECK(context, subRange.uBaseIndex >= mesh.uBaseIndex);
+        TEST_CHECK(context, subRange.uBaseIndex + subRange.uNumIndices <= mesh.uBaseIndex + mesh.uNumIndices);
+
+        UINT uVertexOffset = expected.uSourceIndex * static_cast<UINT>(QUAD_VERTICES.size());
+        for (UINT i = 0u; i < subRange.uNumIndices; ++i)
+        {
+            WORD index = batch.GetIndex(subRange.uBaseIndex + i);
+            TEST_CHECK(context, index == uVertexOffset + QUAD_INDICES[expected.uSourceBaseIndex + i]);
+            TEST_CHECK(context, subRange.worldBounds.Contains(XMLoadFloat3(&batch.GetVertex(index).Position)) != DISJOINT);
+        }
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testMergesDeterministically
+  Summary:  Checks that merging the same sources twice gives the same
+            vertices, indices, meshes and sub-ranges
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testMergesDeterministically(TestContext& context)
+{
+    StaticBatchScene scene = createScene();
+    StaticBatch first(*scene.aSources[0]);
+    StaticBatch second(*scene.aSources[0]);
+    if (!TEST_CHECK(context, mergeScene(scene, first)) || !TEST_CHECK(context, mergeScene(scene, second)))
+    {
+        return;
+    }
+
+    if (!TEST_CHECK(context, first.GetNumVertices() == second.GetNumVertices())
+        || !TEST_CHECK(context, first.GetNumIndices() == second.GetNumIndices())
+        || !TEST_CHECK(context, first.GetNumMeshes() == second.GetNumMeshes())
+        || !TEST_CHECK(context, first.GetNumSubRanges() == second.GetNumSubRanges()))
+    {
+        return;
+    }
+
+    for (UINT i = 0u; i < first.GetNumVertices(); ++i)
+    {
+        TEST_CHECK(context, std::memcmp(&first.GetVertex(i), &second.GetVertex(i), sizeof(SimpleVertex)) == 0);
+    }
+    for (UINT i = 0u; i < first.GetNumIndices(); ++i)
+    {
+        TEST_CHECK(context, first.GetIndex(i) == second.GetIndex(i));
+    }
+    for (UINT i = 0u; i < first.GetNumMeshes(); ++i)
+    {
+        TEST_CHECK(context, first.GetMesh(i).uBaseIndex == second.GetMesh(i).uBaseIndex);
+        TEST_CHECK(context, first.GetMesh(i).uNumIndices == second.GetMesh(i).uNumIndices);
+        TEST_CHECK(context, first.GetMaterial(first.GetMesh(i).uMaterialIndex) == second.GetMaterial(second.GetMesh(i).uMaterialIndex));
+    }
+    for (UINT i = 0u; i < first.GetNumSubRanges(); ++i)
+    {
+        const StaticBatch::SubRange& a = first.GetSubRange(i);
+        const StaticBatch::SubRange& b = second.GetSubRange(i);
+        TEST_CHECK(context, a.uSourceIndex == b.uSourceIndex && a.uBaseIndex == b.uBaseIndex
+            && a.uNumIndices == b.uNumIndices && a.uMaterialIndex == b.uMaterialIndex);
+        TEST_CHECK(context, std::memcmp(&a.worldBounds, &b.worldBounds, sizeof(BoundingBox)) == 0);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterStaticBatchTests
+  Summary:  Registers the tests of merging static renderables
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterStaticBatchTests(TestRunner& runner)
+{
+    runner.Register("StaticBatch::Append/TransformsVerticesIntoWorldSpace", testTransformsVerticesIntoWorldSpace);
+    runner.Register("StaticBatch::Build/GroupsIndicesByMaterial", testGroupsIndicesByMaterial);
+    runner.Register("StaticBatch::Build/MergesDeterministically", testMergesDeterministically);
+}
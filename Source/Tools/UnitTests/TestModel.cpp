@@ -0,0 +1,148 @@
+#include "TestModel.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "assimp/scene.h"
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestModel::TestModel
+
+  Summary:  Constructor
+
+  Args:     const std::filesystem::path& filePath
+              Name of the model, no file is read
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TestModel::TestModel(_In_ const std::filesystem::path& filePath) :
+    Model(filePath)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestModel::CreateRig
+
+  Summary:  Builds an assimp scene of a binary tree of nodes, each
+            driving a bone, and of clips rotating every node around
+            an axis of the clip, and reads its skeleton and clips the
+            way Initialize does. The first clip plays on the first
+            layer
+
+  Args:     UINT uNumNodes
+              Number of nodes and bones
+            UINT uNumClips
+              Number of clips, one second long
+
+  Modifies: [m_globalInverseTransform, m_aBoneInfo,
+             m_boneNameToIndexMap, m_skeleton, m_aGlobalTransforms,
+             m_aTransforms, m_aAnimationClips, m_aAnimationClipStatistics,
+             m_aNodeTracks, m_aReferencePoses, m_aAnimationLayers,
+             m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+             m_pose, m_layerPose].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TestModel::CreateRig(_In_ UINT uNumNodes, _In_ UINT uNumClips)
+{
+    constexpr const UINT NUM_KEYS = 31u;
+    const aiVector3D aAxes[] =
+    {
+        aiVector3D(1.0f, 0.0f, 0.0f),
+        aiVector3D(0.0f, 1.0f, 0.0f),
+        aiVector3D(0.0f, 0.0f, 1.0f),
+    };
+
+    std::unique_ptr<aiScene> pScene = std::make_unique<aiScene>();
+    std::vector<aiNode*> apNodes(uNumNodes);
+    for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+    {
+        std::string szName = "Bone" + std::to_string(uNode);
+        apNodes[uNode] = new aiNode(szName);
+        apNodes[uNode]->mTransformation.b4 = 0.1f;
+        m_boneNameToIndexMap[szName] = uNode;
+        m_aBoneInfo.push_back(BoneInfo(XMMatrixIdentity()));
+    }
+    for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+    {
+        UINT uFirstChild = uNode * 2u + 1u;
+        UINT uNumChildren = uFirstChild >= uNumNodes ? 0u : uFirstChild + 1u == uNumNodes ? 1u : 2u;
+        if (uNumChildren > 0u)
+        {
+            apNodes[uNode]->mNumChildren = uNumChildren;
+            apNodes[uNode]->mChildren = new aiNode*[uNumChildren];
+            for (UINT i = 0u; i < uNumChildren; ++i)
+            {
+                apNodes[uNode]->mChildren[i] = apNodes[uFirstChild + i];
+                apNodes[uFirstChild + i]->mParent = apNodes[uNode];
+            }
+        }
+    }
+    pScene->mRootNode = apNodes[0];
+
+    pScene->mNumAnimations = uNumClips;
+    pScene->mAnimations = new aiAnimation*[uNumClips];
+    for (UINT uClip = 0u; uClip < uNumClips; ++uClip)
+    {
+        aiAnimation* pAnimation = new aiAnimation();
+        pAnimation->mDuration = static_cast<double>(NUM_KEYS - 1u);
+        pAnimation->mTicksPerSecond = static_cast<double>(NUM_KEYS - 1u);
+        pAnimation->mNumChannels = uNumNodes;
+        pAnimation->mChannels = new aiNodeAnim*[uNumNodes];
+        for (UINT uNode = 0u; uNode < uNumNodes; ++uNode)
+        {
+            aiNodeAnim* pChannel = new aiNodeAnim();
+            pChannel->mNodeName = apNodes[uNode]->mName;
+            pChannel->mNumPositionKeys = 1u;
+            pChannel->mPositionKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(0.0f, 0.1f, 0.0f)) };
+            pChannel->mNumScalingKeys = 1u;
+            pChannel->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+            pChannel->mNumRotationKeys = NUM_KEYS;
+            pChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+            for (UINT uKey = 0u; uKey < NUM_KEYS; ++uKey)
+            {
+                FLOAT angle = 0.5f * std::sin(XM_2PI * static_cast<FLOAT>(uKey) / static_cast<FLOAT>(NUM_KEYS - 1u) + static_cast<FLOAT>(uClip + uNode));
+                pChannel->mRotationKeys[uKey] = aiQuatKey(static_cast<double>(uKey), aiQuaternion(aAxes[(uClip + uNode) % ARRAYSIZE(aAxes)], angle));
+            }
+            pAnimation->mChannels[uNode] = pChannel;
+        }
+        pScene->mAnimations[uClip] = pAnimation;
+    }
+
+    m_globalInverseTransform = XMMatrixIdentity();
+    initSkeleton(pScene.get());
+    initAnimations(pScene.get());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestModel::ShareRig
+
+  Summary:  Shares the skeleton and the clips of another model, the way
+            instances of the same character would, with its own layers
+            and bone transforms starting from the layers of the other
+            model
+
+  Args:     const TestModel& rig
+              Model made by CreateRig
+
+  Modifies: [m_globalInverseTransform, m_skeleton, m_aGlobalTransforms,
+             m_aTransforms, m_aAnimationClips, m_aAnimationClipStatistics,
+             m_aNodeTracks, m_aReferencePoses, m_aAnimationLayers,
+             m_aTrackTranslations, m_aTrackRotations, m_aTrackScales,
+             m_pose, m_layerPose].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TestModel::ShareRig(_In_ const TestModel& rig)
+{
+    m_globalInverseTransform = rig.m_globalInverseTransform;
+    m_skeleton = rig.m_skeleton;
+    m_aGlobalTransforms.resize(rig.m_aGlobalTransforms.size());
+    m_aTransforms.assign(rig.m_aTransforms.size(), XMMatrixIdentity());
+    m_aAnimationClips = rig.m_aAnimationClips;
+    m_aAnimationClipStatistics = rig.m_aAnimationClipStatistics;
+    m_aNodeTracks = rig.m_aNodeTracks;
+    m_aReferencePoses = rig.m_aReferencePoses;
+    m_aAnimationLayers = rig.m_aAnimationLayers;
+    m_aTrackTranslations.resize(rig.m_aTrackTranslations.size());
+    m_aTrackRotations.resize(rig.m_aTrackRotations.size());
+    m_aTrackScales.resize(rig.m_aTrackScales.size());
+    m_pose.Resize(m_skeleton->GetNumNodes());
+    m_layerPose.Resize(m_skeleton->GetNumNodes());
+}
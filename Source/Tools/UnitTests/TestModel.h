@@ -0,0 +1,55 @@
+/*+===================================================================
+  File:      TESTMODEL.H
+
+  Summary:   TestModel header file contains declaration of TestModel
+             class, a model made of a generated rig that creates no
+             Direct3D objects.
+
+  Classes: TestModel
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    TestModel
+
+  Summary:  Model made of a generated skeleton and clips instead of a
+            model file, so the animation code of Model can be tested
+            without a device or content. Models sharing a rig play the
+            same skeleton and clips, as instances of a character do.
+            The packing of the bone weights of the import is made
+            callable by the tests
+
+  Methods:  CreateRig
+              Builds a generated skeleton and clips
+            ShareRig
+              Plays the skeleton and clips of another model
+            quantizeBoneData
+              Packs the bone weights of a vertex into bytes
+            TestModel
+              Constructor.
+            ~TestModel
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestModel final : public library::Model
+{
+public:
+    TestModel() = delete;
+    TestModel(_In_ const std::filesystem::path& filePath);
+    TestModel(const TestModel& other) = delete;
+    TestModel(TestModel&& other) = delete;
+    TestModel& operator=(const TestModel& other) = delete;
+    TestModel& operator=(TestModel&& other) = delete;
+    ~TestModel() = default;
+
+    void CreateRig(_In_ UINT uNumNodes, _In_ UINT uNumClips);
+    void ShareRig(_In_ const TestModel& rig);
+
+    using library::Model::VertexBoneData;
+    using library::Model::quantizeBoneData;
+};
@@ -0,0 +1,129 @@
+#include "TestRenderable.h"
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::TestRenderable
+
+  Summary:  Constructor
+
+  Args:     const std::vector<library::SimpleVertex>& aVertices
+              Vertices in local space, must outlive the renderable
+            const std::vector<WORD>& aIndices
+              Indices of the triangles, must outlive the renderable
+
+  Modifies: [m_paVertices, m_paIndices].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TestRenderable::TestRenderable(_In_ const std::vector<library::SimpleVertex>& aVertices, _In_ const std::vector<WORD>& aIndices) :
+    Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f)),
+    m_paVertices(&aVertices),
+    m_paIndices(&aIndices)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::Initialize
+
+  Summary:  Does nothing, the tests never draw
+
+  Args:     ID3D11Device* pDevice
+              Unused
+            ID3D11DeviceContext* pImmediateContext
+              Unused
+
+  Returns:  HRESULT
+              S_OK
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT TestRenderable::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+{
+    UNREFERENCED_PARAMETER(pDevice);
+    UNREFERENCED_PARAMETER(pImmediateContext);
+
+    return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::Update
+
+  Summary:  Does nothing
+
+  Args:     FLOAT deltaTime
+              Unused
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TestRenderable::Update(_In_ FLOAT deltaTime)
+{
+    UNREFERENCED_PARAMETER(deltaTime);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::AddMesh
+
+  Summary:  Adds a mesh covering a range of the indices
+
+  Args:     UINT uBaseIndex
+              First index of the mesh
+            UINT uNumIndices
+              Number of indices of the mesh
+            UINT uMaterialIndex
+              Index of the material, INVALID_MATERIAL for none
+
+  Modifies: [m_aMeshes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TestRenderable::AddMesh(_In_ UINT uBaseIndex, _In_ UINT uNumIndices, _In_ UINT uMaterialIndex)
+{
+    BasicMeshEntry mesh;
+    mesh.uNumIndices = uNumIndices;
+    mesh.uBaseIndex = uBaseIndex;
+    mesh.uMaterialIndex = uMaterialIndex;
+    m_aMeshes.push_back(mesh);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::GetNumVertices
+
+  Summary:  Returns the number of vertices
+
+  Returns:  UINT
+              Number of vertices
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+UINT TestRenderable::GetNumVertices() const
+{
+    return static_cast<UINT>(m_paVertices->size());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::GetNumIndices
+
+  Summary:  Returns the number of indices
+
+  Returns:  UINT
+              Number of indices
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+UINT TestRenderable::GetNumIndices() const
+{
+    return static_cast<UINT>(m_paIndices->size());
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::getVertices
+
+  Summary:  Returns the pointer to the vertices
+
+  Returns:  const library::SimpleVertex*
+              Pointer to the vertices
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const library::SimpleVertex* TestRenderable::getVertices() const
+{
+    return m_paVertices->data();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRenderable::getIndices
+
+  Summary:  Returns the pointer to the indices
+
+  Returns:  const WORD*
+              Pointer to the indices
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const WORD* TestRenderable::getIndices() const
+{
+    return m_paIndices->data();
+}
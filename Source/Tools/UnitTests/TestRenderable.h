@@ -0,0 +1,69 @@
+/*+===================================================================
+  File:      TESTRENDERABLE.H
+
+  Summary:   TestRenderable header file contains declaration of
+             TestRenderable class, a renderable drawing geometry owned
+             by the tests that creates no Direct3D objects.
+
+  Classes: TestRenderable
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <vector>
+
+#include "Renderer/Renderable.h"
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    TestRenderable
+
+  Summary:  Renderable drawing vertices and indices owned by the test,
+            so the CPU code consuming renderables can be tested
+            without a device. Renderables made from the same arrays
+            share geometry, as the cubes do
+
+  Methods:  Initialize
+              Does nothing, no buffers are created
+            Update
+              Does nothing
+            AddMesh
+              Adds a mesh drawn with one of the materials
+            GetNumVertices
+              Returns the number of vertices
+            GetNumIndices
+              Returns the number of indices
+            TestRenderable
+              Constructor.
+            ~TestRenderable
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestRenderable final : public library::Renderable
+{
+public:
+    TestRenderable() = delete;
+    TestRenderable(_In_ const std::vector<library::SimpleVertex>& aVertices, _In_ const std::vector<WORD>& aIndices);
+    TestRenderable(const TestRenderable& other) = delete;
+    TestRenderable(TestRenderable&& other) = delete;
+    TestRenderable& operator=(const TestRenderable& other) = delete;
+    TestRenderable& operator=(TestRenderable&& other) = delete;
+    ~TestRenderable() = default;
+
+    virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+    virtual void Update(_In_ FLOAT deltaTime) override;
+
+    void AddMesh(_In_ UINT uBaseIndex, _In_ UINT uNumIndices, _In_ UINT uMaterialIndex);
+
+    virtual UINT GetNumVertices() const override;
+    virtual UINT GetNumIndices() const override;
+
+protected:
+    virtual const library::SimpleVertex* getVertices() const override;
+    virtual const WORD* getIndices() const override;
+
+private:
+    const std::vector<library::SimpleVertex>* m_paVertices;
+    const std::vector<WORD>* m_paIndices;
+};
@@ -0,0 +1,128 @@
+#include "UnitTest.h"
+
+#include <cstdio>
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestContext::TestContext
+
+  Summary:  Constructor
+
+  Modifies: [m_uNumFailures].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TestContext::TestContext() :
+    m_uNumFailures(0u)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestContext::Check
+
+  Summary:  Records the result of a check, printing the expression
+            and its location when it failed
+
+  Args:     bool bCondition
+              Result of the check
+            const char* pszExpression
+              Checked expression
+            const char* pszFile
+              Source file of the check
+            int iLine
+              Line of the check
+
+  Modifies: [m_uNumFailures].
+
+  Returns:  bool
+              The result of the check, so a test can stop when later
+              checks depend on it
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TestContext::Check(bool bCondition, const char* pszExpression, const char* pszFile, int iLine)
+{
+    if (!bCondition)
+    {
+        std::fprintf(stderr, "%s(%d): check failed: %s\n", pszFile, iLine, pszExpression);
+        ++m_uNumFailures;
+    }
+
+    return bCondition;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestContext::GetNumFailures
+
+  Summary:  Returns the number of failed checks
+
+  Returns:  uint32_t
+              Number of failed checks
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+uint32_t TestContext::GetNumFailures() const
+{
+    return m_uNumFailures;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRunner::TestRunner
+
+  Summary:  Constructor
+
+  Modifies: [m_aTests].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TestRunner::TestRunner() :
+    m_aTests()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRunner::Register
+
+  Summary:  Adds a test
+
+  Args:     const std::string& name
+              Name of the test, "Class::Method/case" by convention
+            TestFunction function
+              Runs the test and checks its results on the context
+
+  Modifies: [m_aTests].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TestRunner::Register(const std::string& name, TestFunction function)
+{
+    m_aTests.push_back({ .name = name, .function = std::move(function) });
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+  Method:   TestRunner::Run
+
+  Summary:  Runs the tests whose names contain the filter and prints
+            whether each one passed
+
+  Args:     const std::string& filter
+              Part of the names to run, empty to run every test
+
+  Returns:  uint32_t
+              Number of tests that failed
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+uint32_t TestRunner::Run(const std::string& filter) const
+{
+    uint32_t uNumRun = 0u;
+    uint32_t uNumFailed = 0u;
+    for (const Test& test : m_aTests)
+    {
+        if (!filter.empty() && test.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        TestContext context;
+        test.function(context);
+
+        ++uNumRun;
+        if (context.GetNumFailures() > 0u)
+        {
+            ++uNumFailed;
+        }
+        std::printf("[%s] %s\n", context.GetNumFailures() > 0u ? "FAIL" : " OK ", test.name.c_str());
+    }
+
+    std::printf("%u of %u tests passed\n", uNumRun - uNumFailed, uNumRun);
+
+    return uNumFailed;
+}
@@ -0,0 +1,94 @@
+/*+===================================================================
+  File:      UNITTEST.H
+
+  Summary:   UnitTest header file contains declarations of TestContext
+             class that records the failed checks of one test, and of
+             TestRunner class that runs the registered tests.
+
+  Classes: TestContext, TestRunner
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    TestContext
+
+  Summary:  Counts the checks of one test that failed. A failed check
+            prints its expression and location and the test goes on,
+            so one run reports every broken expectation
+
+  Methods:  Check
+              Records the result of a check
+            GetNumFailures
+              Returns the number of failed checks
+            TestContext
+              Constructor.
+            ~TestContext
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestContext final
+{
+public:
+    TestContext();
+    TestContext(const TestContext& other) = delete;
+    TestContext(TestContext&& other) = delete;
+    TestContext& operator=(const TestContext& other) = delete;
+    TestContext& operator=(TestContext&& other) = delete;
+    ~TestContext() = default;
+
+    bool Check(bool bCondition, const char* pszExpression, const char* pszFile, int iLine);
+    uint32_t GetNumFailures() const;
+
+private:
+    uint32_t m_uNumFailures;
+};
+
+#define TEST_CHECK(context, condition) (context).Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+  Class:    TestRunner
+
+  Summary:  Runs every registered test whose name contains a filter
+            and prints whether it passed
+
+  Methods:  Register
+              Adds a test
+            Run
+              Runs the tests whose names contain a filter
+            TestRunner
+              Constructor.
+            ~TestRunner
+              Destructor.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestRunner final
+{
+public:
+    using TestFunction = std::function<void(TestContext& context)>;
+
+public:
+    TestRunner();
+    TestRunner(const TestRunner& other) = delete;
+    TestRunner(TestRunner&& other) = delete;
+    TestRunner& operator=(const TestRunner& other) = delete;
+    TestRunner& operator=(TestRunner&& other) = delete;
+    ~TestRunner() = default;
+
+    void Register(const std::string& name, TestFunction function);
+    uint32_t Run(const std::string& filter) const;
+
+private:
+    struct Test
+    {
+        std::string name;
+        TestFunction function;
+    };
+
+private:
+    std::vector<Test> m_aTests;
+};
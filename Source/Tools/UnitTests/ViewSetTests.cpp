@@ -0,0 +1,175 @@
+#include "LibraryTests.h"
+
+#include <vector>
+
+#include "Renderer/ViewSet.h"
+
+using library::ViewSet;
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: addView
+  Summary:  Adds a view with a square 90 degree perspective projection
+            reaching from 0.1 to 100 units
+  Args:     ViewSet& viewSet
+              View set to add the view to
+            PCWSTR pszName
+              Name of the view
+            FXMVECTOR eye
+              Position of the camera
+            FXMVECTOR direction
+              Direction the camera looks into
+  Returns:  UINT
+              Index of the view
+-----------------------------------------------------------------F-F*/
+static UINT addView(ViewSet& viewSet, PCWSTR pszName, FXMVECTOR eye, FXMVECTOR direction)
+{
+    UINT uView = viewSet.AddView(pszName);
+    viewSet.SetViewTransform(
+        uView,
+        XMMatrixLookToLH(eye, direction, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+        XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 0.1f, 100.0f)
+    );
+
+    return uView;
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: addBox
+  Summary:  Adds an item whose bounds are a unit cube around its origin
+  Args:     ViewSet& viewSet
+              View set to add the item to
+            const XMMATRIX& world
+              World matrix of the item
+  Returns:  UINT
+              Index of the item
+-----------------------------------------------------------------F-F*/
+static UINT addBox(ViewSet& viewSet, const XMMATRIX& world)
+{
+    return viewSet.AddItem(BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)), world);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testCullsItemsPerView
+  Summary:  Checks that every view keeps exactly the boxes inside its
+            frustum, nearest first, when the views share some boxes
+            and each sees some of its own
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testCullsItemsPerView(TestContext& context)
+{
+    ViewSet viewSet;
+    const XMVECTOR forward = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+    UINT uLeft = addView(viewSet, L"Left", XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), forward);
+    UINT uRight = addView(viewSet, L"Right", XMVectorSet(100.0f, 0.0f, 0.0f, 1.0f), forward);
+    UINT uBack = addView(viewSet, L"Back", XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorNegate(forward));
+    if (!TEST_CHECK(context, viewSet.GetNumViews() == 3u && uLeft == 0u && uRight == 1u && uBack == 2u))
+    {
+        return;
+    }
+
+    UINT uFarLeft = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, 10.0f));
+    UINT uNearLeft = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, 5.0f));
+    UINT uRightOnly = addBox(viewSet, XMMatrixTranslation(100.0f, 0.0f, 20.0f));
+    UINT uBehind = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, -10.0f));
+    UINT uShared = addBox(viewSet, XMMatrixTranslation(50.0f, 0.0f, 60.0f));
+    // Stretched from 50 to 250 units behind the origin, so it crosses the far plane of the back view
+    UINT uStretched = addBox(viewSet, XMMatrixScaling(1.0f, 1.0f, 100.0f) * XMMatrixTranslation(0.0f, 0.0f, -150.0f));
+    UINT uBeyondFar = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, 200.0f));
+    TEST_CHECK(context, viewSet.GetNumItems() == 7u);
+
+    viewSet.Cull();
+
+    const BoundingBox& stretchedBounds = viewSet.GetWorldBounds(uStretched);
+    TEST_CHECK(context, stretchedBounds.Center.z == -150.0f && stretchedBounds.Extents.z == 100.0f);
+
+    const std::vector<UINT> aExpectedLeft = { uNearLeft, uFarLeft, uShared };
+    const std::vector<UINT> aExpectedRight = { uRightOnly, uShared };
+    const std::vector<UINT> aExpectedBack = { uBehind, uStretched };
+    TEST_CHECK(context, viewSet.GetVisibleItems(uLeft) == aExpectedLeft);
+    TEST_CHECK(context, viewSet.GetVisibleItems(uRight) == aExpectedRight);
+    TEST_CHECK(context, viewSet.GetVisibleItems(uBack) == aExpectedBack);
+
+    for (UINT uView = 0u; uView < viewSet.GetNumViews(); ++uView)
+    {
+        TEST_CHECK(context, !viewSet.IsVisible(uView, uBeyondFar));
+    }
+    TEST_CHECK(context, viewSet.IsVisible(uLeft, uShared) && viewSet.IsVisible(uRight, uShared) && !viewSet.IsVisible(uBack, uShared));
+    TEST_CHECK(context, viewSet.IsVisible(uRight, uRightOnly) && !viewSet.IsVisible(uLeft, uRightOnly));
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsUnboundedItemsInEveryView
+  Summary:  Checks that unbounded items are visible in every view even
+            behind the camera or beyond the far plane, ordered among
+            the boxes by the depth of their origin
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsUnboundedItemsInEveryView(TestContext& context)
+{
+    ViewSet viewSet;
+    const XMVECTOR forward = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+    UINT uFront = addView(viewSet, L"Front", XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), forward);
+    UINT uBack = addView(viewSet, L"Back", XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorNegate(forward));
+
+    UINT uFrontBox = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, 10.0f));
+    UINT uFarAway = viewSet.AddUnboundedItem(XMMatrixTranslation(0.0f, 0.0f, 1000.0f));
+    UINT uBackBox = addBox(viewSet, XMMatrixTranslation(0.0f, 0.0f, -10.0f));
+    UINT uAtOrigin = viewSet.AddUnboundedItem(XMMatrixIdentity());
+
+    viewSet.Cull();
+
+    const std::vector<UINT> aExpectedFront = { uAtOrigin, uFrontBox, uFarAway };
+    const std::vector<UINT> aExpectedBack = { uFarAway, uAtOrigin, uBackBox };
+    TEST_CHECK(context, viewSet.GetVisibleItems(uFront) == aExpectedFront);
+    TEST_CHECK(context, viewSet.GetVisibleItems(uBack) == aExpectedBack);
+
+    // A view added later and items added after clearing see the unbounded items as well
+    UINT uSide = addView(viewSet, L"Side", XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f));
+    viewSet.ClearItems();
+    UINT uSky = viewSet.AddUnboundedItem(XMMatrixTranslation(0.0f, 500.0f, 0.0f));
+    UINT uHidden = addBox(viewSet, XMMatrixTranslation(0.0f, 500.0f, 0.0f));
+    viewSet.Cull();
+
+    for (UINT uView : { uFront, uBack, uSide })
+    {
+        const std::vector<UINT> aExpected = { uSky };
+        TEST_CHECK(context, viewSet.GetVisibleItems(uView) == aExpected);
+        TEST_CHECK(context, viewSet.IsVisible(uView, uSky) && !viewSet.IsVisible(uView, uHidden));
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: testKeepsViewNamesUnique
+  Summary:  Checks that a taken name is refused and that removing a
+            view moves the later views down by one index
+  Args:     TestContext& context
+              Context of the checks
+-----------------------------------------------------------------F-F*/
+static void testKeepsViewNamesUnique(TestContext& context)
+{
+    ViewSet viewSet;
+    TEST_CHECK(context, viewSet.AddView(L"Main") == 0u);
+    TEST_CHECK(context, viewSet.AddView(L"Shadow") == 1u);
+    TEST_CHECK(context, viewSet.AddView(L"Main") == ViewSet::INVALID_VIEW);
+    TEST_CHECK(context, viewSet.GetNumViews() == 2u);
+
+    TEST_CHECK(context, viewSet.RemoveView(L"Main") == S_OK);
+    TEST_CHECK(context, viewSet.RemoveView(L"Main") == E_INVALIDARG);
+    TEST_CHECK(context, viewSet.FindView(L"Shadow") == 0u && viewSet.GetViewName(0u) == L"Shadow");
+    TEST_CHECK(context, viewSet.FindView(L"Main") == ViewSet::INVALID_VIEW);
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: RegisterViewSetTests
+  Summary:  Registers the tests of the culling of several views
+  Args:     TestRunner& runner
+              Runner to register the tests into
+-----------------------------------------------------------------F-F*/
+void RegisterViewSetTests(TestRunner& runner)
+{
+    runner.Register("ViewSet::Cull/CullsItemsPerView", testCullsItemsPerView);
+    runner.Register("ViewSet::Cull/KeepsUnboundedItemsInEveryView", testKeepsUnboundedItemsInEveryView);
+    runner.Register("ViewSet::AddView/KeepsViewNamesUnique", testKeepsViewNamesUnique);
+}